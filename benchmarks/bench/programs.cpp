@@ -0,0 +1,183 @@
+#include "programs.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace arkoi;
+
+/**
+ * @brief Returns the indentation of the given nesting level.
+ */
+static std::string indent(const size_t level) {
+    return std::string(level * 4, ' ');
+}
+
+std::string bench::many_functions(const size_t count) {
+    std::ostringstream output;
+
+    output << "fun main() @u32:\n";
+    output << "    return function_" << count - 1 << "(1, 2)\n\n";
+
+    for (size_t index = 0; index < count; index++) {
+        output << "fun function_" << index << "(a @u32, b @u32) @u32:\n";
+        output << "    c @u32 = a * " << index + 3 << " + b\n";
+        output << "    if c > " << index * 7 << ":\n";
+        output << "        c = c - a\n";
+
+        // Every function calls its predecessor, thus the call graph is a single long chain.
+        if (index == 0) output << "    return c\n\n";
+        else output << "    return function_" << index - 1 << "(c, b + 1)\n\n";
+    }
+
+    return output.str();
+}
+
+std::string bench::deep_nesting(const size_t depth) {
+    std::ostringstream output;
+
+    output << "fun main() @u32:\n";
+    output << "    result @u32 = 0\n";
+
+    // Loops and branches alternate, every loop has its own counter.
+    for (size_t level = 0; level < depth; level++) {
+        const auto prefix = indent(level + 1);
+
+        if (level % 2 == 0) {
+            output << prefix << "counter_" << level << " @u32 = " << level + 2 << "\n";
+            output << prefix << "while counter_" << level << " != 0:\n";
+            output << prefix << "    counter_" << level << " = counter_" << level << " - 1\n";
+        } else {
+            output << prefix << "if result > " << level << ":\n";
+            output << prefix << "    result = result - " << level << "\n";
+            output << prefix << "else:\n";
+        }
+    }
+
+    output << indent(depth + 1) << "result = result + 1\n";
+
+    // Blocks may not end with a loop or branch, thus every level is closed by a statement of its own.
+    for (size_t level = depth; level-- > 0;) {
+        output << indent(level + 1) << "result = result + " << level << "\n";
+    }
+
+    output << "    return result\n";
+
+    return output.str();
+}
+
+std::string bench::straight_line(const size_t length) {
+    std::ostringstream output;
+
+    output << "fun main() @u32:\n";
+    output << "    return compute(3, 5)\n\n";
+
+    output << "fun compute(a @u32, b @u32) @u32:\n";
+    output << "    value_0 @u32 = a + b\n";
+
+    // Every value uses two earlier ones, thus many of them are live at once.
+    for (size_t index = 1; index < length; index++) {
+        const auto other = index / 2;
+        output << "    value_" << index << " @u32 = value_" << index - 1 << " * " << index % 7 + 2
+               << " + value_" << other << " - b\n";
+    }
+
+    output << "    return value_" << length - 1 << "\n";
+
+    return output.str();
+}
+
+std::string bench::wide_phis(const size_t width) {
+    static constexpr size_t VARIABLES = 8;
+
+    std::ostringstream output;
+
+    output << "fun main() @u32:\n";
+    output << "    return select(" << width / 2 << ")\n\n";
+
+    output << "fun select(n @u32) @u32:\n";
+    for (size_t variable = 0; variable < VARIABLES; variable++) {
+        output << "    value_" << variable << " @u32 = n\n";
+    }
+
+    for (size_t arm = 0; arm < width; arm++) {
+        output << "    " << (arm == 0 ? "if" : "else if") << " n == " << arm << ":\n";
+
+        for (size_t variable = 0; variable < VARIABLES; variable++) {
+            output << "        value_" << variable << " = n * " << arm + variable + 1 << "\n";
+        }
+    }
+
+    output << "    return value_0";
+    for (size_t variable = 1; variable < VARIABLES; variable++) output << " + value_" << variable;
+    output << "\n";
+
+    return output.str();
+}
+
+std::vector<bench::Program> bench::programs(const std::string& example_path) {
+    std::vector<Program> programs;
+
+    for (const size_t scale : { 10, 100, 1000 }) {
+        const auto suffix = "/" + std::to_string(scale);
+        programs.push_back({ "many_functions" + suffix, many_functions(scale) });
+        programs.push_back({ "straight_line" + suffix, straight_line(scale) });
+        programs.push_back({ "wide_phis" + suffix, wide_phis(scale) });
+    }
+
+    // The nesting is bounded by the recursion of the parser and the passes, thus it stays smaller.
+    for (const size_t depth : { 4, 16, 64 }) {
+        programs.push_back({ "deep_nesting/" + std::to_string(depth), deep_nesting(depth) });
+    }
+
+    std::vector<std::filesystem::path> examples;
+    if (std::filesystem::is_directory(example_path)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(example_path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".ark") examples.push_back(entry.path());
+        }
+    }
+
+    // The directory order isn't specified, sorting keeps the benchmark names in the same order between runs.
+    std::ranges::sort(examples);
+
+    for (const auto& path : examples) {
+        std::ostringstream contents;
+        contents << std::ifstream(path).rdbuf();
+
+        programs.push_back({ "example/" + path.stem().string(), contents.str() });
+    }
+
+    return programs;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
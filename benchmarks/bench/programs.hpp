@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace arkoi::bench {
+/**
+ * @brief A program compiled by the benchmarks.
+ */
+struct Program {
+    /// The name of the program, which becomes a part of the benchmark names.
+    std::string name;
+
+    /// The source code of the program.
+    std::string contents;
+};
+
+/**
+ * @brief Generates a program with @p count small functions, each of them calling the previous one.
+ *
+ * Stresses everything that scales with the amount of functions, e.g. the inliner and the cache.
+ */
+[[nodiscard]] std::string many_functions(size_t count);
+
+/**
+ * @brief Generates a single function whose loops and branches are nested @p depth levels deep.
+ *
+ * Stresses the dominator tree, the loop analysis and every pass walking the control flow.
+ */
+[[nodiscard]] std::string deep_nesting(size_t depth);
+
+/**
+ * @brief Generates a single block with @p length dependent arithmetic statements.
+ *
+ * Stresses the passes and the register allocator on many values that are live at once.
+ */
+[[nodiscard]] std::string straight_line(size_t length);
+
+/**
+ * @brief Generates a branch chain of @p width arms which all assign the same variables.
+ *
+ * The join block thus merges every variable with a phi of @p width incoming values.
+ */
+[[nodiscard]] std::string wide_phis(size_t width);
+
+/**
+ * @brief Returns the synthetic programs at several scales followed by the programs in @p example_path.
+ *
+ * @param example_path The directory holding one directory per example, each with a single `.ark` file.
+ * @return All programs, never empty.
+ */
+[[nodiscard]] std::vector<Program> programs(const std::string& example_path);
+} // namespace arkoi::bench
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
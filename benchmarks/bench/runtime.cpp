@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "arkoi_language/opt/pipeline.hpp"
+#include "arkoi_language/utils/driver.hpp"
+
+using namespace arkoi;
+
+namespace {
+/**
+ * @brief A backend configuration every kernel is compiled with.
+ */
+struct Configuration {
+    std::string name;
+    uint8_t level;
+    x86_64::AllocatorKind allocator;
+    bool integrated;
+};
+
+/**
+ * @brief Compiles, assembles and links the kernel into a temporary binary.
+ *
+ * @return The path of the binary, or an empty string if a stage failed, which is described in @p errors.
+ */
+std::string build(const std::filesystem::path& kernel, const Configuration& configuration, std::ostream& errors) {
+    const auto base_path = utils::generate_temp_path().string();
+    const auto asm_path = base_path + ".s";
+    const auto obj_path = base_path + ".o";
+    const auto bin_path = base_path + ".out";
+
+    const auto source = std::make_shared<pretty_diagnostics::FileSource>(kernel.string());
+    const auto pipeline = opt::Pipeline::level(configuration.level);
+
+    auto exit_code = 0;
+    if (configuration.integrated) {
+        std::ofstream obj_ostream(obj_path, std::ios::binary);
+        exit_code = utils::compile(
+            source, nullptr, nullptr, nullptr, &obj_ostream, nullptr, 1, configuration.allocator, errors, nullptr, { },
+            nullptr, pipeline
+        );
+    } else {
+        {
+            std::ofstream asm_ostream(asm_path);
+            exit_code = utils::compile(
+                source, nullptr, nullptr, &asm_ostream, nullptr, nullptr, 1, configuration.allocator, errors,
+                nullptr, { }, nullptr, pipeline
+            );
+        }
+
+        if (exit_code == 0) {
+            std::ofstream obj_ostream(obj_path);
+            exit_code = utils::assemble(asm_path, obj_ostream);
+            if (exit_code != 0) errors << "Failed to assemble the kernel." << std::endl;
+        }
+    }
+
+    if (exit_code == 0) {
+        std::ofstream bin_ostream(bin_path);
+        exit_code = utils::link({ obj_path }, bin_ostream);
+        if (exit_code != 0) errors << "Failed to link the kernel." << std::endl;
+    }
+
+    std::filesystem::remove(asm_path);
+    std::filesystem::remove(obj_path);
+
+    if (exit_code == 0) return bin_path;
+
+    std::filesystem::remove(bin_path);
+    return { };
+}
+
+/**
+ * @brief Runs the compiled kernel once per iteration and reports its wall time and cycles.
+ *
+ * Every kernel checks its own result and exits with 0 only if it is correct, thus a miscompilation
+ * fails the benchmark instead of being measured.
+ */
+void run(benchmark::State& state, const std::filesystem::path& kernel, const Configuration& configuration) {
+    std::ostringstream errors;
+    const auto binary = build(kernel, configuration, errors);
+    if (binary.empty()) {
+        state.SkipWithError(errors.str().c_str());
+        return;
+    }
+
+    // The exit code of every run is printed, which would be mixed into the results of the benchmark.
+    std::ostringstream silenced;
+    auto* const output = std::cout.rdbuf(silenced.rdbuf());
+
+    double cycles = 0;
+    auto counted = true;
+    for (auto _ : state) {
+        utils::RunStatistics statistics;
+        const auto exit_code = utils::run_binary(binary, &statistics);
+        if (exit_code != 0) {
+            state.SkipWithError("The kernel computed a wrong result.");
+            break;
+        }
+
+        state.SetIterationTime(std::chrono::duration<double>(statistics.wall).count());
+
+        counted = counted && statistics.cycles.has_value();
+        cycles += static_cast<double>(statistics.cycles.value_or(0));
+        silenced.str({ });
+    }
+
+    std::cout.rdbuf(output);
+    std::filesystem::remove(binary);
+
+    if (counted) state.counters["cycles"] = benchmark::Counter(cycles, benchmark::Counter::kAvgIterations);
+}
+} // namespace
+
+/**
+ * @brief Registers every kernel for every configuration and runs the benchmarks selected on the command line.
+ *
+ * Each kernel is run as often as Google Benchmark needs for a stable result, `--benchmark_repetitions`
+ * repeats that to get the variance. The results are written in any format of Google Benchmark,
+ * e.g. `--benchmark_out=runtime.json`, which is what regressions in the generated code are checked against.
+ */
+int main(int argc, char** argv) {
+    // Every optimization level with the default backend, and the highest level with every other backend.
+    std::vector<Configuration> configurations;
+    for (uint8_t level = 0; level <= opt::Pipeline::MAX_LEVEL; level++) {
+        configurations.push_back({ "O" + std::to_string(level), level, x86_64::AllocatorKind::GraphColoring, true });
+    }
+
+    constexpr auto max_level = opt::Pipeline::MAX_LEVEL;
+    configurations.push_back({ "O3-linear", max_level, x86_64::AllocatorKind::LinearScan, true });
+    configurations.push_back({ "O3-as", max_level, x86_64::AllocatorKind::GraphColoring, false });
+
+    std::vector<std::filesystem::path> kernels;
+    for (const auto& entry : std::filesystem::directory_iterator(KERNEL_PATH)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".ark") kernels.push_back(entry.path());
+    }
+
+    // The directory order isn't specified, sorting keeps the benchmark names in the same order between runs.
+    std::ranges::sort(kernels);
+
+    for (const auto& kernel : kernels) {
+        for (const auto& configuration : configurations) {
+            const auto name = kernel.stem().string() + "/" + configuration.name;
+            benchmark::RegisterBenchmark(name.c_str(), run, kernel, configuration)
+                ->UseManualTime()
+                ->Unit(benchmark::kMillisecond);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
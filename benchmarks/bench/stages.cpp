@@ -0,0 +1,226 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "arkoi_language/front/parser.hpp"
+#include "arkoi_language/front/scanner.hpp"
+#include "arkoi_language/sem/name_resolver.hpp"
+#include "arkoi_language/sem/type_resolver.hpp"
+#include "arkoi_language/utils/driver.hpp"
+#include "arkoi_language/utils/time_report.hpp"
+#include "arkoi_language/x86_64/encoder.hpp"
+
+#include "programs.hpp"
+
+using namespace arkoi;
+
+namespace {
+/**
+ * @brief A program written to a temporary file, which is removed again afterward.
+ */
+class SourceFile {
+public:
+    explicit SourceFile(const bench::Program& program) :
+        _path(utils::generate_temp_path().string() + ".ark") {
+        std::ofstream(_path) << program.contents;
+        _source = std::make_shared<pretty_diagnostics::FileSource>(_path);
+    }
+
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+
+    ~SourceFile() { std::filesystem::remove(_path); }
+
+    [[nodiscard]] auto& source() const { return _source; }
+
+private:
+    std::string _path;
+    std::shared_ptr<pretty_diagnostics::Source> _source;
+};
+
+/**
+ * @brief Parses the program, which is the input of every later stage.
+ */
+ast::Program parse(const std::shared_ptr<pretty_diagnostics::Source>& source, utils::Diagnostics& diagnostics) {
+    front::Scanner scanner(source, diagnostics);
+    return front::Parser(source, scanner, diagnostics).parse_program();
+}
+
+/**
+ * @brief Reports the throughput of the benchmark in bytes of source.
+ */
+void set_throughput(benchmark::State& state, const std::shared_ptr<pretty_diagnostics::Source>& source) {
+    const auto bytes = static_cast<int64_t>(source->contents().size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+}
+
+void scanner(benchmark::State& state, const bench::Program& program) {
+    const SourceFile file(program);
+
+    for (auto _ : state) {
+        utils::Diagnostics diagnostics;
+        front::Scanner scanner(file.source(), diagnostics);
+
+        auto tokens = scanner.tokenize();
+        benchmark::DoNotOptimize(tokens.data());
+    }
+
+    set_throughput(state, file.source());
+}
+
+void parser(benchmark::State& state, const bench::Program& program) {
+    const SourceFile file(program);
+
+    utils::Diagnostics diagnostics;
+    const auto tokens = front::Scanner(file.source(), diagnostics).tokenize();
+
+    for (auto _ : state) {
+        auto copy = tokens;
+        auto program_node = front::Parser(file.source(), std::move(copy), diagnostics).parse_program();
+        benchmark::DoNotOptimize(program_node.statements().data());
+    }
+
+    if (diagnostics.has_errors()) state.SkipWithError("The program has errors");
+    set_throughput(state, file.source());
+}
+
+void name_resolver(benchmark::State& state, const bench::Program& program) {
+    const SourceFile file(program);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        utils::Diagnostics diagnostics;
+        auto program_node = parse(file.source(), diagnostics);
+        state.ResumeTiming();
+
+        sem::NameResolver(diagnostics).visit(program_node);
+
+        if (diagnostics.has_errors()) state.SkipWithError("The program has errors");
+    }
+
+    set_throughput(state, file.source());
+}
+
+void type_resolver(benchmark::State& state, const bench::Program& program) {
+    const SourceFile file(program);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        utils::Diagnostics diagnostics;
+        auto program_node = parse(file.source(), diagnostics);
+        sem::NameResolver(diagnostics).visit(program_node);
+        state.ResumeTiming();
+
+        sem::TypeResolver(diagnostics).visit(program_node);
+
+        if (diagnostics.has_errors()) state.SkipWithError("The program has errors");
+    }
+
+    set_throughput(state, file.source());
+}
+
+/**
+ * @brief Compiles the program into machine code and reports every stage of the backend as a counter.
+ *
+ * The stages after the semantic analysis only run as one pipeline, thus their share is taken from the
+ * `utils::TimeReport` of the compilation. Every counter is the wall time of a stage in seconds per iteration.
+ */
+void compile(benchmark::State& state, const bench::Program& program, const x86_64::AllocatorKind allocator) {
+    const SourceFile file(program);
+
+    utils::TimeReport report;
+    for (auto _ : state) {
+        std::ostringstream errors;
+        x86_64::Encoder encoder;
+
+        const auto exit_code = utils::compile(
+            file.source(), nullptr, nullptr, nullptr, nullptr, &encoder, 1, allocator, errors, nullptr, { }, &report
+        );
+        if (exit_code != 0) {
+            state.SkipWithError(errors.str().c_str());
+            break;
+        }
+
+        benchmark::DoNotOptimize(encoder);
+    }
+
+    for (const auto& stage : report.stages()) {
+        const auto seconds = std::chrono::duration<double>(stage.wall).count();
+        state.counters[stage.name] = benchmark::Counter(seconds, benchmark::Counter::kAvgIterations);
+
+        for (const auto& [name, value] : stage.counters) {
+            const auto amount = static_cast<double>(value);
+            state.counters[stage.name + "." + name] = benchmark::Counter(amount, benchmark::Counter::kAvgIterations);
+        }
+    }
+
+    set_throughput(state, file.source());
+}
+} // namespace
+
+/**
+ * @brief Registers every stage for every program and runs the benchmarks selected on the command line.
+ *
+ * The results are written in any format of Google Benchmark, e.g. `--benchmark_format=json` or
+ * `--benchmark_out=results.json`, which is what regressions are checked against.
+ */
+int main(int argc, char** argv) {
+    const auto programs = bench::programs(EXAMPLE_PATH);
+
+    for (const auto& program : programs) {
+        const auto& name = program.name;
+
+        benchmark::RegisterBenchmark(("scanner/" + name).c_str(), scanner, program);
+        benchmark::RegisterBenchmark(("parser/" + name).c_str(), parser, program);
+        benchmark::RegisterBenchmark(("name_resolver/" + name).c_str(), name_resolver, program);
+        benchmark::RegisterBenchmark(("type_resolver/" + name).c_str(), type_resolver, program);
+        benchmark::RegisterBenchmark(
+            ("compile/graph/" + name).c_str(), compile, program, x86_64::AllocatorKind::GraphColoring
+        );
+        benchmark::RegisterBenchmark(
+            ("compile/linear/" + name).c_str(), compile, program, x86_64::AllocatorKind::LinearScan
+        );
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
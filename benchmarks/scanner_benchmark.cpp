@@ -0,0 +1,94 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "arkoi_language/front/scanner.hpp"
+#include "arkoi_language/front/token.hpp"
+
+using namespace arkoi;
+
+/**
+ * @brief Runs @p body @p iterations times and prints the average time of one iteration.
+ */
+template <typename Body>
+static void measure(const std::string& name, const size_t iterations, Body&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t iteration = 0; iteration < iterations; iteration++) body();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+    std::cout << name << ": " << nanoseconds << " ns" << std::endl;
+}
+
+int main(const int argc, const char* argv[]) {
+    const size_t lines = argc > 1 ? std::stoul(argv[1]) : 10000;
+
+    // Identifiers that share their first character and length with keywords are the worst case of the lookup.
+    const std::vector<std::string> words = {
+        "fun", "function", "u32", "u3", "value", "while", "whale", "if", "index", "return", "result", "s64", "sum",
+        "false", "flag", "bool", "buffer", "usize", "ssize", "else", "entry", "true", "total", "f64", "x",
+    };
+
+    size_t found = 0;
+    measure("lookup_keyword", 1000000, [&] {
+        for (const auto& word : words) found += front::Token::lookup_keyword(word).has_value();
+    });
+
+    const auto path = (std::filesystem::temp_directory_path() / "arkoi_scanner_benchmark.ark").string();
+    {
+        std::ofstream output(path);
+        for (size_t line = 0; line < lines; line++) {
+            output << "fun function_" << line << "(value @u32, index @u64) @bool:\n";
+            output << "    return value_" << line << " == index && result || flag != total\n";
+        }
+    }
+
+    const auto source = std::make_shared<pretty_diagnostics::FileSource>(path);
+    size_t tokens = 0;
+    measure("tokenize " + std::to_string(lines * 2) + " lines", 10, [&] {
+        utils::Diagnostics diagnostics;
+        front::Scanner scanner(source, diagnostics);
+        tokens += scanner.tokenize().size();
+    });
+
+    std::remove(path.c_str());
+
+    // Printing the results keeps the measured work from being optimized away.
+    std::cout << "keywords=" << found << " tokens=" << tokens << std::endl;
+    return 0;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -13,6 +13,7 @@ _start:
 .type main, @function
 main:
 	# ret 0
+	mov eax, 0
 	ret
 .size main, .-main
 
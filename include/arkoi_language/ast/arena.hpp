@@ -0,0 +1,108 @@
+#pragma once
+
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace arkoi::ast {
+/**
+ * @brief Destroys an object that was created by an `Arena`.
+ *
+ * Only the destructor is called, the memory itself is released together with the arena.
+ */
+struct ArenaDeleter {
+    template <typename Type>
+    void operator()(Type* object) const { object->~Type(); }
+};
+
+/**
+ * @brief The owning pointer of an object created by an `Arena`, e.g. the children of a node.
+ */
+template <typename Type>
+using Owned = std::unique_ptr<Type, ArenaDeleter>;
+
+/**
+ * @brief Bump allocates the nodes and symbols of a single program.
+ *
+ * The arena is owned by the `Program`, thus all of its memory is released at once when the
+ * program is destroyed. Every object created by the arena needs to be destroyed first, which
+ * is guaranteed for all objects owned by the nodes of the program.
+ *
+ * The arena is not thread-safe. The functions of a program are analyzed on several threads,
+ * thus each of them creates its objects in a branch of the arena instead.
+ *
+ * @see Program
+ */
+class Arena {
+public:
+    Arena() = default;
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Creates an object that is uniquely owned, such as a node.
+     *
+     * @tparam Type The type of the object to create.
+     * @param args The arguments passed to the constructor of @p Type.
+     * @return The owning pointer of the new object.
+     */
+    template <typename Type, typename... Args>
+    [[nodiscard]] Owned<Type> make(Args&&... args);
+
+    /**
+     * @brief Returns the memory resource of the arena, e.g. for the symbols of the program.
+     *
+     * @return A pointer to the `std::pmr::memory_resource`.
+     */
+    [[nodiscard]] std::pmr::memory_resource* resource() { return &_resource; }
+
+    /**
+     * @brief Creates an arena that is released together with this one.
+     *
+     * The branch is independent of this arena, thus both can be used by different threads at once.
+     * Creating the branch itself isn't thread-safe.
+     *
+     * @return A reference to the new arena, which lives as long as this one.
+     */
+    [[nodiscard]] Arena& branch();
+
+private:
+    std::vector<std::unique_ptr<Arena>> _branches{ };
+    std::pmr::monotonic_buffer_resource _resource{ };
+};
+} // namespace arkoi::ast
+
+#include "../../../src/arkoi_language/ast/arena.tpp"
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -2,9 +2,10 @@
 
 #include <utility>
 
+#include "arkoi_language/ast/arena.hpp"
 #include "arkoi_language/ast/visitor.hpp"
 #include "arkoi_language/front/token.hpp"
-#include "arkoi_language/sem/symbol_table.hpp"
+#include "arkoi_language/sem/symbol.hpp"
 #include "arkoi_language/sem/type.hpp"
 
 #include "pretty_diagnostics/span.hpp"
@@ -45,8 +46,8 @@ public:
 /**
  * @brief Represents the top-level unit of a source file.
  *
- * A `Program` consists of a sequence of global statements (e.g., function definitions)
- * and holds the root symbol table for the entire compilation unit.
+ * A `Program` consists of a sequence of global statements (e.g., function definitions).
+ * It also owns the `Arena` all nodes and symbols of the compilation unit live in.
  */
 class Program final : public Node {
 public:
@@ -55,13 +56,13 @@ public:
      *
      * @param statements The top-level statements defined in the program.
      * @param span The source code span covering the entire program.
-     * @param table The global symbol table for this program.
+     * @param arena The arena of all nodes and symbols, which is released with the program.
      */
     Program(
-        std::vector<std::unique_ptr<Node>>&& statements,
+        std::vector<Owned<Node>>&& statements,
         pretty_diagnostics::Span span,
-        std::shared_ptr<sem::SymbolTable> table
-    ) : _statements(std::move(statements)), _table(std::move(table)), _span(std::move(span)) { }
+        std::unique_ptr<Arena> arena
+    ) : _arena(std::move(arena)), _statements(std::move(statements)), _span(std::move(span)) { }
 
     /**
      * @brief Accepts a visitor to process this `Program` node.
@@ -85,22 +86,23 @@ public:
     [[nodiscard]] auto& statements() const { return _statements; }
 
     /**
-     * @brief Returns the global symbol table associated with the program.
+     * @brief Returns the arena new nodes of this program are created in, e.g. implicit casts.
      *
-     * @return A constant reference to the `sem::SymbolTable`.
+     * @return A reference to the `Arena`.
      */
-    [[nodiscard]] auto& table() const { return _table; }
+    [[nodiscard]] Arena& arena() const { return *_arena; }
 
 private:
-    std::vector<std::unique_ptr<Node>> _statements;
-    std::shared_ptr<sem::SymbolTable> _table;
+    // Declared first, thus it's destroyed after all nodes and symbols that live in it.
+    std::unique_ptr<Arena> _arena;
+    std::vector<Owned<Node>> _statements;
     pretty_diagnostics::Span _span;
 };
 
 /**
  * @brief Represents a block of statements enclosed in braces.
  *
- * Blocks introduce a new lexical scope and contain their own symbol table.
+ * Blocks introduce a new lexical scope.
  */
 class Block final : public Node {
 public:
@@ -109,13 +111,11 @@ public:
      *
      * @param statements The sequence of statements within the block.
      * @param span The source code span from the opening brace to the closing brace.
-     * @param table The symbol table for the scope introduced by this block.
      */
     Block(
-        std::vector<std::unique_ptr<Node>>&& statements,
-        pretty_diagnostics::Span span,
-        std::shared_ptr<sem::SymbolTable> table
-    ) : _statements(std::move(statements)), _table(std::move(table)), _span(std::move(span)) { }
+        std::vector<Owned<Node>>&& statements,
+        pretty_diagnostics::Span span
+    ) : _statements(std::move(statements)), _span(std::move(span)) { }
 
     /**
      * @brief Accepts a visitor to process this `Block` node.
@@ -138,16 +138,8 @@ public:
      */
     [[nodiscard]] auto& statements() const { return _statements; }
 
-    /**
-     * @brief Returns the symbol table associated with this block's scope.
-     *
-     * @return A constant reference to the `sem::SymbolTable`.
-     */
-    [[nodiscard]] auto& table() const { return _table; }
-
 private:
-    std::vector<std::unique_ptr<Node>> _statements;
-    std::shared_ptr<sem::SymbolTable> _table;
+    std::vector<Owned<Node>> _statements;
     pretty_diagnostics::Span _span;
 };
 
@@ -305,7 +297,6 @@ private:
  * @brief Represents a function definition in the AST.
  *
  * A `Function` node includes its name, parameters, return type, and the body `Block`.
- * It also holds the symbol table for the function's scope.
  */
 class Function final : public Node {
 public:
@@ -317,16 +308,14 @@ public:
      * @param type The return type of the function.
      * @param block The body block containing the function's statements.
      * @param span The source code span of the entire function definition.
-     * @param table The symbol table for the function's scope.
      */
     Function(
         Identifier name,
         std::vector<Parameter>&& parameters,
         sem::Type type,
-        std::unique_ptr<Block>&& block,
-        pretty_diagnostics::Span span,
-        std::shared_ptr<sem::SymbolTable> table
-    ) : _table(std::move(table)), _parameters(std::move(parameters)), _span(std::move(span)),
+        Owned<Block>&& block,
+        pretty_diagnostics::Span span
+    ) : _parameters(std::move(parameters)), _span(std::move(span)),
         _block(std::move(block)), _name(std::move(name)), _type(std::move(type)) { }
 
     /**
@@ -350,13 +339,6 @@ public:
      */
     [[nodiscard]] auto& parameters() { return _parameters; }
 
-    /**
-     * @brief Returns the symbol table associated with the function's scope.
-     *
-     * @return A constant reference to the `sem::SymbolTable`.
-     */
-    [[nodiscard]] auto& table() const { return _table; }
-
     /**
      * @brief Returns the return type of the function.
      *
@@ -379,10 +361,9 @@ public:
     [[nodiscard]] auto& name() { return _name; }
 
 private:
-    std::shared_ptr<sem::SymbolTable> _table;
     std::vector<Parameter> _parameters;
     pretty_diagnostics::Span _span;
-    std::unique_ptr<Block> _block;
+    Owned<Block> _block;
     Identifier _name;
     sem::Type _type;
 };
@@ -400,7 +381,7 @@ public:
      * @param expression The expression to return.
      * @param span The source code span of the return statement.
      */
-    Return(std::unique_ptr<Node>&& expression, pretty_diagnostics::Span span) :
+    Return(Owned<Node>&& expression, pretty_diagnostics::Span span) :
         _expression(std::move(expression)), _span(std::move(span)) { }
 
     /**
@@ -446,11 +427,11 @@ public:
      *
      * @param node The expression `Node` to set.
      */
-    void set_expression(std::unique_ptr<Node>&& node) { _expression = std::move(node); }
+    void set_expression(Owned<Node>&& node) { _expression = std::move(node); }
 
 private:
     std::optional<sem::Type> _type{ };
-    std::unique_ptr<Node> _expression;
+    Owned<Node> _expression;
     pretty_diagnostics::Span _span;
 };
 
@@ -471,9 +452,9 @@ public:
      * @param span The source code span of the entire if-else statement.
      */
     If(
-        std::unique_ptr<Node>&& condition,
-        std::unique_ptr<Node>&& branch,
-        std::unique_ptr<Node>&& next,
+        Owned<Node>&& condition,
+        Owned<Node>&& branch,
+        Owned<Node>&& next,
         pretty_diagnostics::Span span
     ) : _next(std::move(next)), _branch(std::move(branch)), _condition(std::move(condition)),
         _span(std::move(span)) { }
@@ -518,11 +499,11 @@ public:
      *
      * @param condition The condition `Node` to set.
      */
-    void set_condition(std::unique_ptr<Node>&& condition) { _condition = std::move(condition); }
+    void set_condition(Owned<Node>&& condition) { _condition = std::move(condition); }
 
 private:
-    std::unique_ptr<Node> _next, _branch;
-    std::unique_ptr<Node> _condition;
+    Owned<Node> _next, _branch;
+    Owned<Node> _condition;
     pretty_diagnostics::Span _span;
 };
 
@@ -540,8 +521,8 @@ public:
      * @param span The source code span of the entire while statement.
      */
     While(
-        std::unique_ptr<Node>&& condition,
-        std::unique_ptr<Node>&& then,
+        Owned<Node>&& condition,
+        Owned<Node>&& then,
         pretty_diagnostics::Span span
     ) : _condition(std::move(condition)), _span(std::move(span)),
         _then(std::move(then)) { }
@@ -579,12 +560,12 @@ public:
      *
      * @param condition The condition `Node` to set.
      */
-    void set_condition(std::unique_ptr<Node>&& condition) { _condition = std::move(condition); }
+    void set_condition(Owned<Node>&& condition) { _condition = std::move(condition); }
 
 private:
-    std::unique_ptr<Node> _condition;
+    Owned<Node> _condition;
     pretty_diagnostics::Span _span;
-    std::unique_ptr<Node> _then;
+    Owned<Node> _then;
 };
 
 /**
@@ -601,7 +582,7 @@ public:
      * @param expression The expression whose value is being assigned.
      * @param span The source code span of the assignment statement.
      */
-    Assign(Identifier name, std::unique_ptr<Node>&& expression, pretty_diagnostics::Span span) :
+    Assign(Identifier name, Owned<Node>&& expression, pretty_diagnostics::Span span) :
         _expression(std::move(expression)), _span(std::move(span)), _name(std::move(name)) { }
 
     /**
@@ -630,7 +611,7 @@ public:
      *
      * @param node The expression `Node` to set.
      */
-    void set_expression(std::unique_ptr<Node>&& node) { _expression = std::move(node); }
+    void set_expression(Owned<Node>&& node) { _expression = std::move(node); }
 
     /**
      * @brief Returns the identifier of the target variable.
@@ -640,7 +621,7 @@ public:
     [[nodiscard]] auto& name() { return _name; }
 
 private:
-    std::unique_ptr<Node> _expression;
+    Owned<Node> _expression;
     pretty_diagnostics::Span _span;
     Identifier _name;
 };
@@ -663,7 +644,7 @@ public:
     Variable(
         Identifier name,
         sem::Type type,
-        std::unique_ptr<Node>&& expression,
+        Owned<Node>&& expression,
         pretty_diagnostics::Span span
     ) : _expression(std::move(expression)), _span(std::move(span)), _name(std::move(name)),
         _type(std::move(type)) { }
@@ -694,7 +675,7 @@ public:
      *
      * @param node The expression `Node` to set.
      */
-    void set_expression(std::unique_ptr<Node>&& node) { _expression = std::move(node); }
+    void set_expression(Owned<Node>&& node) { _expression = std::move(node); }
 
     /**
      * @brief Returns the declared semantic type of the variable.
@@ -711,7 +692,7 @@ public:
     [[nodiscard]] auto& name() { return _name; }
 
 private:
-    std::unique_ptr<Node> _expression;
+    Owned<Node> _expression;
     pretty_diagnostics::Span _span;
     Identifier _name;
     sem::Type _type;
@@ -731,7 +712,7 @@ public:
      * @param arguments The list of expressions passed as arguments.
      * @param span The source code span of the function call.
      */
-    Call(Identifier name, std::vector<std::unique_ptr<Node>>&& arguments, pretty_diagnostics::Span span) :
+    Call(Identifier name, std::vector<Owned<Node>>&& arguments, pretty_diagnostics::Span span) :
         _arguments(std::move(arguments)), _span(std::move(span)), _name(std::move(name)) { }
 
     /**
@@ -763,7 +744,7 @@ public:
     [[nodiscard]] auto& name() { return _name; }
 
 private:
-    std::vector<std::unique_ptr<Node>> _arguments;
+    std::vector<Owned<Node>> _arguments;
     pretty_diagnostics::Span _span;
     Identifier _name;
 };
@@ -906,9 +887,9 @@ public:
      * @param span The source code span of the entire binary expression.
      */
     Binary(
-        std::unique_ptr<Node>&& left,
+        Owned<Node>&& left,
         const Operator op,
-        std::unique_ptr<Node>&& right,
+        Owned<Node>&& right,
         pretty_diagnostics::Span span
     ) : _left(std::move(left)), _right(std::move(right)), _span(std::move(span)), _op(op) { }
 
@@ -962,7 +943,7 @@ public:
      *
      * @param node The `Node` to set as the right operand.
      */
-    void set_right(std::unique_ptr<Node>&& node) { _right = std::move(node); }
+    void set_right(Owned<Node>&& node) { _right = std::move(node); }
 
     /**
      * @brief Returns the left operand.
@@ -976,7 +957,7 @@ public:
      *
      * @param node The `Node` to set as the left operand.
      */
-    void set_left(std::unique_ptr<Node>&& node) { _left = std::move(node); }
+    void set_left(Owned<Node>&& node) { _left = std::move(node); }
 
     /**
      * @brief Returns the result type of the binary operation.
@@ -1012,7 +993,7 @@ public:
 
 private:
     std::optional<sem::Type> _result_type{ }, _op_type{ };
-    std::unique_ptr<Node> _left, _right;
+    Owned<Node> _left, _right;
     pretty_diagnostics::Span _span;
     Operator _op;
 };
@@ -1032,7 +1013,7 @@ public:
      * @param to The target semantic type.
      * @param span The source code span of the entire cast.
      */
-    Cast(std::unique_ptr<Node>&& expression, sem::Type from, sem::Type to, pretty_diagnostics::Span span) :
+    Cast(Owned<Node>&& expression, sem::Type from, sem::Type to, pretty_diagnostics::Span span) :
         _from(from), _expression(std::move(expression)), _span(std::move(span)), _to(std::move(to)) { }
 
     /**
@@ -1044,7 +1025,7 @@ public:
      * @param to The target semantic type.
      * @param span The source code span of the entire cast.
      */
-    Cast(std::unique_ptr<Node>&& expression, sem::Type to, pretty_diagnostics::Span span) :
+    Cast(Owned<Node>&& expression, sem::Type to, pretty_diagnostics::Span span) :
         _expression(std::move(expression)), _span(std::move(span)), _to(std::move(to)) { }
 
     /**
@@ -1092,7 +1073,7 @@ public:
 
 private:
     std::optional<sem::Type> _from{ };
-    std::unique_ptr<Node> _expression;
+    Owned<Node> _expression;
     pretty_diagnostics::Span _span;
     sem::Type _to;
 };
@@ -1,24 +1,31 @@
 #pragma once
 
+#include <expected>
 #include <functional>
-#include <stack>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "arkoi_language/ast/nodes.hpp"
+#include "arkoi_language/front/scanner.hpp"
 #include "arkoi_language/front/token.hpp"
 #include "arkoi_language/utils/diagnostics.hpp"
 
 #include "pretty_diagnostics/source.hpp"
 
 namespace arkoi::front {
+class ParserError;
+
 /**
  * @brief The parser for the Arkoi language.
  *
  * The `Parser` class implements a recursive descent parser that transforms a
- * sequence of `Token` objects into an Abstract Syntax Tree (AST). It also
- * performs basic scope tracking to associate nodes with their respective
- * symbol tables.
+ * sequence of `Token` objects into an Abstract Syntax Tree (AST). Scopes
+ * are not tracked here, they are only introduced by the `sem::NameResolver`.
+ *
+ * Every parse function returns either its node or the error that prevented
+ * parsing it, which is propagated up to the enclosing statement list. There it
+ * is reported and the parser recovers, thus no exception is thrown for broken code.
  *
  * @see Scanner, ast::Node
  */
@@ -33,10 +40,22 @@ public:
      */
     Parser(const std::shared_ptr<pretty_diagnostics::Source>& source, std::vector<Token>&& tokens, utils::Diagnostics& diagnostics);
 
+    /**
+     * @brief Constructs a `Parser` that pulls the tokens from the @p scanner on demand.
+     *
+     * Only the current token is held at once, thus lexing and parsing are interleaved.
+     *
+     * @param source The source code being parsed (for diagnostics).
+     * @param scanner The scanner of the same source, which needs to outlive the parser.
+     * @param diagnostics The diagnostic handler for reporting errors.
+     */
+    Parser(const std::shared_ptr<pretty_diagnostics::Source>& source, Scanner& scanner, utils::Diagnostics& diagnostics);
+
     /**
      * @brief Parses the entire token stream into a `Program` AST node.
      *
-     * This is the main entry point for the parsing process.
+     * This is the main entry point for the parsing process, which can only be called once,
+     * as the arena of all nodes is handed over to the resulting program.
      *
      * @return The root `ast::Program` node.
      * @see ast::Program
@@ -44,12 +63,23 @@ public:
     [[nodiscard]] ast::Program parse_program();
 
 private:
+    /**
+     * @brief Either the parsed value or the error that prevented parsing it.
+     */
+    template <typename Type>
+    using Parsed = std::expected<Type, ParserError>;
+
+    /**
+     * @brief Constructs a `Parser` that calls @p tokens for every next token.
+     */
+    Parser(const std::shared_ptr<pretty_diagnostics::Source>& source, std::function<Token()> tokens, utils::Diagnostics& diagnostics);
+
     /**
      * @brief Parses a single top-level statement (e.g., function definition).
      *
      * @return A `std::unique_ptr` to the parsed `ast::Node`.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_program_statement();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_program_statement();
 
     /**
      * @brief Performs error recovery for top-level statement parsing.
@@ -65,7 +95,7 @@ private:
      * @return A `std::unique_ptr` to the parsed `ast::Function` node.
      * @see ast::Function
      */
-    [[nodiscard]] std::unique_ptr<ast::Function> _parse_function(const Token& keyword);
+    [[nodiscard]] Parsed<ast::Owned<ast::Function>> _parse_function(const Token& keyword);
 
     /**
      * @brief Parses a comma-separated list of function parameters.
@@ -73,7 +103,7 @@ private:
      * @return A vector of `ast::Parameter` nodes.
      * @see ast::Parameter
      */
-    [[nodiscard]] std::vector<ast::Parameter> _parse_parameters();
+    [[nodiscard]] Parsed<std::vector<ast::Parameter>> _parse_parameters();
 
     /**
      * @brief Performs error recovery for parameter list parsing.
@@ -85,28 +115,28 @@ private:
      *
      * @return The parsed `ast::Parameter`.
      */
-    [[nodiscard]] ast::Parameter _parse_parameter();
+    [[nodiscard]] Parsed<ast::Parameter> _parse_parameter();
 
     /**
      * @brief Parses a type annotation (e.g., '\@u32').
      *
      * @return The parsed `sem::Type`.
      */
-    [[nodiscard]] std::pair<sem::Type, pretty_diagnostics::Span> _parse_type();
+    [[nodiscard]] Parsed<std::pair<sem::Type, pretty_diagnostics::Span>> _parse_type();
 
     /**
      * @brief Parses a block of statements.
      *
      * @return A `std::unique_ptr` to the parsed `ast::Block` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Block> _parse_block();
+    [[nodiscard]] Parsed<ast::Owned<ast::Block>> _parse_block();
 
     /**
      * @brief Parses a single statement within a block.
      *
      * @return A `std::unique_ptr` to the parsed statement `ast::Node`.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_block_statement();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_block_statement();
 
     /**
      * @brief Performs error recovery for block statement parsing.
@@ -119,7 +149,7 @@ private:
      * @param keyword The 'return' keyword token.
      * @return A `std::unique_ptr` to the parsed `ast::Return` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Return> _parse_return(const Token& keyword);
+    [[nodiscard]] Parsed<ast::Owned<ast::Return>> _parse_return(const Token& keyword);
 
     /**
      * @brief Parses an if-else conditional statement.
@@ -127,7 +157,7 @@ private:
      * @param keyword The 'if' keyword token.
      * @return A `std::unique_ptr` to the parsed `ast::If` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::If> _parse_if(const Token& keyword);
+    [[nodiscard]] Parsed<ast::Owned<ast::If>> _parse_if(const Token& keyword);
 
     /**
      * @brief Parses a while statement.
@@ -135,7 +165,7 @@ private:
      * @param keyword The 'while' keyword token.
      * @return A `std::unique_ptr` to the parsed `ast::While` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::While> _parse_while(const Token& keyword);
+    [[nodiscard]] Parsed<ast::Owned<ast::While>> _parse_while(const Token& keyword);
 
     /**
      * @brief Parses an assignment statement.
@@ -143,7 +173,7 @@ private:
      * @param name The identifier being assigned to.
      * @return A `std::unique_ptr` to the parsed `ast::Assign` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Assign> _parse_assign(const Token& name);
+    [[nodiscard]] Parsed<ast::Owned<ast::Assign>> _parse_assign(const Token& name);
 
     /**
      * @brief Parses a local variable declaration.
@@ -151,7 +181,7 @@ private:
      * @param name The identifier being declared.
      * @return A `std::unique_ptr` to the parsed `ast::Variable` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Variable> _parse_variable(const Token& name);
+    [[nodiscard]] Parsed<ast::Owned<ast::Variable>> _parse_variable(const Token& name);
 
     /**
      * @brief Parses a function call statement.
@@ -159,82 +189,63 @@ private:
      * @param name The identifier of the function being called.
      * @return A `std::unique_ptr` to the parsed `ast::Call` node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Call> _parse_call(const Token& name);
+    [[nodiscard]] Parsed<ast::Owned<ast::Call>> _parse_call(const Token& name);
 
     /**
      * @brief Parses an expression, following operator precedence.
      *
      * @return A `std::unique_ptr` to the root of the expression subtree.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_expression();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_expression();
 
     /**
      * @brief Parses a 'logical or' expression ('||').
      *
      * @return A unique_ptr to the parsed 'logical or' node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_logical_or();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_logical_or();
 
     /**
      * @brief Parses a 'logical and' expression ('&&').
      *
      * @return A unique_ptr to the parsed 'logical and' node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_logical_and();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_logical_and();
 
     /**
      * @brief Parses equality expressions (e.g., '==', '!=').
      *
      * @return A unique_ptr to the parsed equality node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_equality();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_equality();
 
     /**
      * @brief Parses relational expressions (e.g., '>', '<').
      *
      * @return A unique_ptr to the parsed relational node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_relation();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_relation();
 
     /**
      * @brief Parses term-level expressions (addition and subtraction).
      *
      * @return A unique_ptr to the parsed term node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_term();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_term();
 
     /**
      * @brief Parses factor-level expressions (multiplication and division).
      *
      * @return A unique_ptr to the parsed factor node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_factor();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_factor();
 
     /**
      * @brief Parses primary expressions (literals, identifiers, parenthesized expressions).
      *
      * @return A unique_ptr to the parsed primary node.
      */
-    [[nodiscard]] std::unique_ptr<ast::Node> _parse_primary();
-
-    /**
-     * @brief Returns the current semantic scope (symbol table).
-     *
-     * @return A pointer to the current symbol table.
-     */
-    [[nodiscard]] std::shared_ptr<sem::SymbolTable> _current_scope();
-
-    /**
-     * @brief Creates and enters a new nested semantic scope.
-     *
-     * @return The newly created `sem::SymbolTable`.
-     */
-    std::shared_ptr<sem::SymbolTable> _enter_scope();
-
-    /**
-     * @brief Exits the current semantic scope, returning to its parent.
-     */
-    void _exit_scope();
+    [[nodiscard]] Parsed<ast::Owned<ast::Node>> _parse_primary();
 
     /**
      * @brief Peeks at the current token in the stream.
@@ -248,21 +259,27 @@ private:
      */
     void _next();
 
+    /**
+     * @brief Pulls the next token from the token source, skipping comments and their newlines.
+     *
+     * @return The next relevant `Token`.
+     */
+    [[nodiscard]] Token _pull();
+
     /**
      * @brief Consumes any token and returns it, advancing the position.
      *
-     * @return A reference to the consumed `Token`.
+     * @return The consumed `Token`.
      */
-    const Token& _consume_any();
+    Token _consume_any();
 
     /**
      * @brief Consumes a token of the expected @p type.
      *
      * @param type The required token type.
-     * @return A reference to the consumed `Token`.
-     * @throws UnexpectedToken if the current token doesn't match the @p type.
+     * @return The consumed `Token`, or an `UnexpectedToken` error if it doesn't match the @p type.
      */
-    const Token& _consume(Token::Type type);
+    [[nodiscard]] Parsed<Token> _consume(Token::Type type);
 
     /**
      * @brief Attempts to consume a token if it matches the @p predicate.
@@ -326,28 +343,30 @@ private:
     [[nodiscard]] static bool _is_term_operator(const Token& token);
 
 private:
-    std::stack<std::shared_ptr<sem::SymbolTable>> _scopes{ };
+    // Declared first, thus it's destroyed after the nodes that live in it.
+    std::unique_ptr<ast::Arena> _arena;
     std::shared_ptr<pretty_diagnostics::Source> _source;
     utils::Diagnostics& _diagnostics;
-    std::vector<Token> _tokens;
-    size_t _position{ };
+    std::function<Token()> _tokens;
+    std::optional<Token> _current_token{ };
 };
 
 /**
  * @brief Base class for all recoverable parser errors.
  *
  * Stores a diagnostic report describing the parsing error.
- * Thrown to unwind parsing and handled at synchronization points.
+ * Returned up to the enclosing synchronization point, where it is handled.
  */
-class ParserError : public std::exception {
+class ParserError {
 public:
     /**
      * @brief Constructs a `ParserError` error.
      *
      * @param report Diagnostic report describing the error.
+     * @param end_of_tokens If the input ended, which leaves nothing to recover at.
      */
-    explicit ParserError(pretty_diagnostics::Report report)
-        : _report(std::move(report)) { }
+    explicit ParserError(pretty_diagnostics::Report report, const bool end_of_tokens = false)
+        : _report(std::move(report)), _end_of_tokens(end_of_tokens) { }
 
     /**
      * @brief Get the diagnostic report associated with this error.
@@ -356,14 +375,22 @@ public:
      */
     [[nodiscard]] auto& report() const { return _report; }
 
+    /**
+     * @brief Checks if this is an `UnexpectedEndOfTokens`, which aborts parsing instead of recovering.
+     *
+     * @return True if the input ended, false otherwise.
+     */
+    [[nodiscard]] bool is_end_of_tokens() const { return _end_of_tokens; }
+
 private:
     pretty_diagnostics::Report _report;
+    bool _end_of_tokens;
 };
 
 /**
  * @brief Parser error indicating the unexpected end of input.
  *
- * This error is typically fatal and rethrown to abort parsing.
+ * This error is fatal and propagated without being reported to abort parsing.
  */
 class UnexpectedEndOfTokens final : public ParserError {
 public:
@@ -378,7 +405,7 @@ public:
 /**
  * @brief Parser error indicating an unexpected token.
  *
- * Thrown when the current token does not match the expected grammar.
+ * Returned when the current token does not match the expected grammar.
  */
 class UnexpectedToken final : public ParserError {
 public:
@@ -1,13 +1,18 @@
 #pragma once
 
-#include <functional>
+#include <deque>
+#include <expected>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "arkoi_language/front/token.hpp"
 #include "arkoi_language/utils/diagnostics.hpp"
 
 namespace arkoi::front {
+class ScannerError;
+
 /**
  * @brief The scanner (lexer) for the Arkoi language.
  *
@@ -38,55 +43,79 @@ public:
      */
     [[nodiscard]] std::vector<Token> tokenize();
 
+    /**
+     * @brief Returns the next token, scanning the source one line at a time on demand.
+     *
+     * After the last line this returns the remaining `Dedentation` tokens and then
+     * `EndOfFile` tokens, no matter how often it is called.
+     *
+     * @return The next `Token` of the source.
+     */
+    [[nodiscard]] Token next();
+
 private:
+    /**
+     * @brief Either the scanned value or the error that prevented scanning it.
+     */
+    template <typename Type>
+    using Scanned = std::expected<Type, ScannerError>;
+
+    /**
+     * @brief Scans the next line into the pending tokens, or finishes the source after the last line.
+     *
+     * A lexeme that can't be scanned is reported and its first character is skipped, after which
+     * scanning continues as usual. No exception is involved, thus broken lines scan as fast as clean ones.
+     */
+    void _scan_line();
+
     /**
      * @brief Lexes the next individual token from the current position.
      *
-     * @return The next parsed `Token`.
+     * @return The next parsed `Token`, or the error if no valid token starts at the current position.
      */
-    [[nodiscard]] Token _next_token();
+    [[nodiscard]] Scanned<Token> _next_token();
 
     /**
      * @brief Lexes a source code comment (starting with '#').
      *
-     * @return A `Token` of type `Comment`.
+     * @return A `Token` of type `Comment`, or the error if no comment starts at the current position.
      */
-    [[nodiscard]] Token _lex_comment();
+    [[nodiscard]] Scanned<Token> _lex_comment();
 
     /**
      * @brief Lexes an identifier or a reserved keyword.
      *
-     * @return A `Token` representing either an identifier or a keyword.
+     * @return A `Token` representing either an identifier or a keyword, or the error if none starts here.
      */
-    [[nodiscard]] Token _lex_identifier();
+    [[nodiscard]] Scanned<Token> _lex_identifier();
 
     /**
      * @brief Lexes a numeric literal, supporting both integer and floating point.
      *
-     * @return A `Token` of type `Integer` or `Floating`.
+     * @return A `Token` of type `Integer` or `Floating`, or the error if it's malformed or out of range.
      */
-    [[nodiscard]] Token _lex_number();
+    [[nodiscard]] Scanned<Token> _lex_number();
 
     /**
      * @brief Lexes a single character literal or special symbol.
      *
-     * @return The corresponding `Token`.
+     * @return The corresponding `Token`, or the error if the literal is malformed.
      */
-    [[nodiscard]] Token _lex_char();
+    [[nodiscard]] Scanned<Token> _lex_char();
 
     /**
      * @brief Lexes special characters and potential multi-character operators.
      *
-     * @return The recognized operator or symbol `Token`.
+     * @return The recognized operator or symbol `Token`, or the error if the character is unknown.
      */
-    [[nodiscard]] Token _lex_special();
+    [[nodiscard]] Scanned<Token> _lex_special();
 
     /**
      * @brief Returns the character at the current scanning position without advancing.
      *
-     * @return The current character.
+     * @return The current character, or an `UnexpectedEndOfLine` error at the end of the line.
      */
-    [[nodiscard]] char _current_char() const;
+    [[nodiscard]] Scanned<char> _current_char() const;
 
     /**
      * @brief Checks if the scanner has reached the end of the current source line.
@@ -113,6 +142,13 @@ private:
      */
     [[nodiscard]] std::optional<std::string_view> _peek(size_t count) const;
 
+    /**
+     * @brief Returns a view of the current line from the current column to its end.
+     *
+     * @return std::string_view of the remaining characters, which is empty at the line end.
+     */
+    [[nodiscard]] std::string_view _rest() const;
+
     /**
      * @brief Advances the internal pointer to the next character in the source.
      *
@@ -124,19 +160,19 @@ private:
      * @brief Consumes a character if it matches the @p expected character.
      *
      * @param expected The character that is required at the current position.
-     * @throws UnexpectedChar if the current character does not match.
+     * @return The character that was consumed, or an `UnexpectedChar` error if it does not match.
      */
-    void _consume(char expected);
+    [[nodiscard]] Scanned<char> _consume(char expected);
 
     /**
      * @brief Consumes a character if it satisfies the @p predicate.
      *
-     * @param predicate A function determining if the character is valid.
+     * @param predicate A callable determining if the character is valid, which is inlined.
      * @param expected A description of what was expected (used for error reporting).
-     * @return The character that was consumed.
-     * @throws UnexpectedChar if the predicate is not met.
+     * @return The character that was consumed, or an `UnexpectedChar` error if the predicate is not met.
      */
-    char _consume(const std::function<bool(char)>& predicate, const std::string& expected);
+    template <typename Predicate>
+    [[nodiscard]] Scanned<char> _consume(Predicate&& predicate, std::string_view expected);
 
     /**
      * @brief Attempts to consume @p expected, returning true on success.
@@ -152,10 +188,13 @@ private:
     /**
      * @brief Attempts to consume a character matching the @p predicate.
      *
-     * @param predicate A function determining if the character is valid.
+     * Unlike `_consume`, a mismatch isn't an error, as this is the common case at the end of every lexeme.
+     *
+     * @param predicate A callable determining if the character is valid, which is inlined.
      * @return The consumed character if it matched, or `std::nullopt` otherwise.
      */
-    [[nodiscard]] std::optional<char> _try_consume(const std::function<bool(char)>& predicate);
+    template <typename Predicate>
+    [[nodiscard]] std::optional<char> _try_consume(Predicate&& predicate);
 
     /**
      * @brief Calculates the number of leading spaces to determine indentation depth.
@@ -163,7 +202,34 @@ private:
      * @param line The source line to analyze.
      * @return The number of leading whitespace characters.
      */
-    [[nodiscard]] static size_t _leading_spaces(const std::string& line);
+    [[nodiscard]] static size_t _leading_spaces(std::string_view line);
+
+    /**
+     * @brief Returns the length of the run of whitespace characters at the start of @p text.
+     *
+     * Like all runs, these are classified 16 characters at once with SSE2 if it's available,
+     * only the remaining characters are checked one by one.
+     *
+     * @param text The text to scan.
+     * @return The amount of characters satisfying `_is_space`.
+     */
+    [[nodiscard]] static size_t _space_run(std::string_view text);
+
+    /**
+     * @brief Returns the length of the run of identifier characters at the start of @p text.
+     *
+     * @param text The text to scan.
+     * @return The amount of characters satisfying `_is_ident_inner`.
+     */
+    [[nodiscard]] static size_t _identifier_run(std::string_view text);
+
+    /**
+     * @brief Returns the length of the run of decimal digits at the start of @p text.
+     *
+     * @param text The text to scan.
+     * @return The amount of characters satisfying `_is_digit`.
+     */
+    [[nodiscard]] static size_t _digit_run(std::string_view text);
 
     /**
      * @brief Checks if a character is a decimal digit (0-9).
@@ -250,16 +316,19 @@ private:
     std::shared_ptr<pretty_diagnostics::Source> _source;
     size_t _row{ }, _column{ }, _indentation{ };
     utils::Diagnostics& _diagnostics;
-    std::string _current_line;
+    std::deque<Token> _pending{ };
+    std::string_view _current_line;
+    size_t _offset{ };
+    bool _finished{ };
 };
 
 /**
  * @brief Base class for all recoverable scanner (lexical) errors.
  *
  * Stores a diagnostic report describing the lexical error.
- * Thrown to unwind scanning and handled at synchronization points.
+ * Returned in place of the token that couldn't be scanned and reported at synchronization points.
  */
-class ScannerError : public std::exception {
+class ScannerError {
 public:
     /**
      * @brief Constructs a `ScannerError` error.
@@ -283,7 +352,7 @@ private:
 /**
  * @brief Scanner error indicating invalid indentation spacing.
  *
- * Thrown when the number of leading spaces in a line does not
+ * Reported when the number of leading spaces in a line does not
  * conform to the expected multiple of `SPACE_INDENTATION`.
  */
 class InvalidSpacingFormat final : public ScannerError {
@@ -314,7 +383,7 @@ public:
 /**
  * @brief Scanner error indicating an unexpected character.
  *
- * Thrown when a character does not match the expected pattern.
+ * Returned when a character does not match the expected pattern.
  */
 class UnexpectedChar final : public ScannerError {
 public:
@@ -355,6 +424,8 @@ public:
 };
 } // namespace arkoi::front
 
+#include "../../../src/arkoi_language/front/scanner.tpp"
+
 //==============================================================================
 // BSD 3-Clause License
 //
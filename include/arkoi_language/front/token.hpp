@@ -5,12 +5,16 @@
 #include <optional>
 #include <utility>
 
+#include "arkoi_language/utils/interner.hpp"
+
 namespace arkoi::front {
 /**
  * @brief Represents a single lexical unit (token) in the source code.
  *
  * A `Token` stores its type (e.g., an identifier, a keyword, or an operator)
  * and its location in the source code using a `pretty_diagnostics::Span`.
+ * Identifiers additionally carry their interned name, thus later stages compare
+ * and hash names as integers instead of slicing the source again.
  */
 class Token {
 public:
@@ -77,11 +81,24 @@ public:
     /**
      * @brief Constructs a `Token`.
      *
+     * The name of an identifier is interned from its @p span.
+     *
      * @param type The category of the token.
      * @param span The precise location of the token in the source.
      */
     Token(const Type type, pretty_diagnostics::Span span) :
-        _span(std::move(span)), _type(type) { }
+        _span(std::move(span)), _type(type) {
+        if (_type == Type::Identifier) _atom.emplace(_span.substr());
+    }
+
+    /**
+     * @brief Constructs an identifier `Token` with an already interned name.
+     *
+     * @param span The precise location of the token in the source.
+     * @param atom The interned name of the identifier.
+     */
+    Token(pretty_diagnostics::Span span, const utils::Interned atom) :
+        _span(std::move(span)), _atom(atom), _type(Type::Identifier) { }
 
     /**
      * @brief Returns the source code span of the token.
@@ -97,6 +114,14 @@ public:
      */
     [[nodiscard]] auto& type() const { return _type; }
 
+    /**
+     * @brief Returns the interned name of an identifier.
+     *
+     * @return A constant reference to the `utils::Interned` name.
+     * @throws std::bad_optional_access if the token is not an identifier.
+     */
+    [[nodiscard]] auto& atom() const { return _atom.value(); }
+
     /**
      * @brief Determines if a given string is a reserved keyword.
      *
@@ -115,6 +140,7 @@ public:
 
 private:
     pretty_diagnostics::Span _span;
+    std::optional<utils::Interned> _atom{ };
     Type _type;
 };
 
@@ -1,8 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <unordered_set>
+
 #include "arkoi_language/il/dataflow.hpp"
+#include "arkoi_language/il/operand_set.hpp"
 
 namespace arkoi::il {
+class AnalysisManager;
+
 /**
  * @brief Dataflow analysis for computing liveness at the basic block level.
  *
@@ -10,16 +19,27 @@ namespace arkoi::il {
  * basic block. An operand is live if its current value may be read in the future
  * before it is overwritten.
  *
+ * The states are dense `OperandSet`s. The upward-exposed uses and the definitions
+ * of every block are computed once in `prepare`, so the transfer function only
+ * consists of word-parallel set operations.
+ *
  * Direction: Backward
  * Granularity: Block
  *
  * @see DataflowPass
  */
 class BlockLivenessAnalysis final :
-    public DataflowPass<Operand, DataflowDirection::Backward, DataflowGranularity::Block> {
+    public DataflowPass<Operand, DataflowDirection::Backward, DataflowGranularity::Block, OperandSet> {
 public:
     BlockLivenessAnalysis() = default;
 
+    /**
+     * @brief Numbers the operands of @p function and computes the use and def sets of its blocks.
+     *
+     * @param function The function that is about to be analyzed.
+     */
+    void prepare(Function& function) override;
+
     /**
      * @brief Merges liveness states from successor blocks.
      *
@@ -50,6 +70,18 @@ public:
      * @return The liveness state at the entry of the block.
      */
     [[nodiscard]] State transfer(BasicBlock& current, const State& state) override;
+
+    /**
+     * @brief Returns the numbering of the operands used by the states.
+     *
+     * @return A constant reference to the `OperandIndex`.
+     */
+    [[nodiscard]] auto& index() const { return _index; }
+
+private:
+    std::unordered_map<BasicBlock*, State> _uses{ };
+    std::unordered_map<BasicBlock*, State> _defs{ };
+    OperandIndex _index{ };
 };
 
 /**
@@ -65,10 +97,17 @@ public:
  * @see DataflowPass, BlockLivenessAnalysis, x86_64::RegisterAllocator
  */
 class InstructionLivenessAnalysis final :
-    public DataflowPass<Operand, DataflowDirection::Backward, DataflowGranularity::Instruction> {
+    public DataflowPass<Operand, DataflowDirection::Backward, DataflowGranularity::Instruction, OperandSet> {
 public:
     InstructionLivenessAnalysis() = default;
 
+    /**
+     * @brief Numbers the operands of @p function.
+     *
+     * @param function The function that is about to be analyzed.
+     */
+    void prepare(Function& function) override;
+
     /**
      * @brief Merges liveness states from the succeeding program point.
      *
@@ -112,11 +151,516 @@ public:
      */
     [[nodiscard]] bool is_live_across_calls(const Operand& operand) const;
 
+    /**
+     * @brief Returns the numbering of the operands used by the states.
+     *
+     * @return A constant reference to the `OperandIndex`.
+     */
+    [[nodiscard]] auto& index() const { return _index; }
+
 private:
     State _live_across_calls;
+    OperandIndex _index{ };
+};
+
+/**
+ * @brief Instruction-level liveness derived lazily from block-level liveness.
+ *
+ * Instead of storing an `in` and `out` state for every instruction, this runs
+ * `BlockLivenessAnalysis` once and reconstructs the live-out state of each
+ * instruction on demand with a single backward scan over its block. Only one
+ * state per block has to be kept in memory, while the results are the same as
+ * the ones of `InstructionLivenessAnalysis`.
+ *
+ * @see BlockLivenessAnalysis, InstructionLivenessAnalysis, x86_64::RegisterAllocator
+ */
+class SparseLivenessAnalysis {
+public:
+    using State = BlockLivenessAnalysis::State;
+
+    /// Liveness depends on the instructions, see `AnalysisManager`.
+    static constexpr bool CONTROL_FLOW_ONLY = false;
+
+public:
+    SparseLivenessAnalysis() = default;
+
+    /**
+     * @brief Constructs the analysis and directly runs it on @p function.
+     *
+     * @param function The function to analyze. It must not contain `Phi` instructions.
+     */
+    explicit SparseLivenessAnalysis(Function& function) { run(function); }
+
+    /**
+     * @brief Computes the block liveness and the operands live across calls of @p function.
+     *
+     * @param function The function to analyze. It must not contain `Phi` instructions.
+     */
+    void run(Function& function);
+
+    /**
+     * @brief Walks @p block backwards and passes the live-out state of every instruction to @p func.
+     *
+     * The state reference is only valid for the duration of the callback.
+     *
+     * @tparam Func Callable as `func(Instruction&, const State&)`.
+     * @param block The block to walk, which must be part of the analyzed function.
+     * @param func The callback invoked for every instruction, starting from the terminator.
+     */
+    template <typename Func>
+    void for_each_live_out(BasicBlock& block, Func&& func) const;
+
+    /**
+     * @brief Returns a `State` with all live across calls operands.
+     *
+     * @return A reference to the `State`s that are live across calls.
+     */
+    [[nodiscard]] auto& live_across_calls() const { return _live_across_calls; }
+
+    /**
+     * @brief Checks and returns if the provided operand is live across call instructions.
+     *
+     * @param operand The operand to check.
+     * @return If the operand is live across calls.
+     */
+    [[nodiscard]] bool is_live_across_calls(const Operand& operand) const;
+
+    /**
+     * @brief Returns the underlying block-level analysis.
+     *
+     * @return A constant reference to the `DataflowAnalysis`.
+     */
+    [[nodiscard]] auto& blocks() const { return _blocks; }
+
+private:
+    /**
+     * @brief Applies the liveness transfer function of a single instruction in place.
+     *
+     * @param instruction The instruction to step over.
+     * @param live The live-out state, which becomes the live-in state.
+     */
+    static void _step(const Instruction& instruction, State& live);
+
+private:
+    DataflowAnalysis<BlockLivenessAnalysis> _blocks{ };
+    State _live_across_calls{ };
+};
+/**
+ * @brief Dominator tree and dominance frontiers of a function.
+ *
+ * Bundles the results of `DominatorTree` so they only have to be computed once
+ * per function and can be shared through the `AnalysisManager`. The children of
+ * every block in the dominator tree are kept in block order, so walks over the
+ * tree don't depend on where the blocks are allocated.
+ *
+ * @see DominatorTree, AnalysisManager, SSAPromoter
+ */
+class DominanceAnalysis {
+public:
+    /// Dominance only depends on the control flow, see `AnalysisManager`.
+    static constexpr bool CONTROL_FLOW_ONLY = true;
+
+public:
+    /**
+     * @brief Computes the dominator tree, the frontiers and the dominator tree children.
+     *
+     * @param function The function to analyze.
+     */
+    explicit DominanceAnalysis(Function& function);
+
+    /**
+     * @brief Checks if @p dominator dominates @p block in constant time.
+     *
+     * @see DominatorTree::dominates
+     */
+    [[nodiscard]] bool dominates(const BasicBlock* dominator, const BasicBlock* block) const {
+        return _tree.dominates(dominator, block);
+    }
+
+    /**
+     * @brief Returns the dominator tree the other results are derived from.
+     *
+     * @return A constant reference to the `DominatorTree`.
+     */
+    [[nodiscard]] auto& tree() const { return _tree; }
+
+    /**
+     * @brief Returns the direct children of @p block in the dominator tree.
+     *
+     * @param block The block whose children should be returned.
+     * @return The blocks immediately dominated by @p block, in block order.
+     */
+    [[nodiscard]] const std::vector<BasicBlock*>& children(BasicBlock* block) const;
+
+    /**
+     * @brief Returns the immediate dominator of every block.
+     *
+     * @return A constant reference to the `DominatorTree::Immediates`.
+     */
+    [[nodiscard]] auto& immediates() const { return _immediates; }
+
+    /**
+     * @brief Returns the dominance frontier of every block.
+     *
+     * @return A constant reference to the `DominatorTree::Frontiers`.
+     */
+    [[nodiscard]] auto& frontiers() const { return _frontiers; }
+
+private:
+    std::unordered_map<BasicBlock*, std::vector<BasicBlock*>> _children{ };
+    DominatorTree::Immediates _immediates{ };
+    DominatorTree _tree{ };
+    DominatorTree::Frontiers _frontiers{ };
+};
+
+/**
+ * @brief A natural loop of the CFG.
+ *
+ * The loop consists of its header and every block that can reach one of the
+ * latches, the sources of the back edges to the header, without passing
+ * through the header.
+ */
+struct Loop {
+    /// The single entry point of the loop, dominating all of its blocks.
+    BasicBlock* header{ };
+
+    /// The blocks with a back edge to the header.
+    std::vector<BasicBlock*> latches{ };
+
+    /// All blocks of the loop including the header, in block order.
+    std::vector<BasicBlock*> blocks{ };
+
+    /// The innermost loop containing this one, or nullptr for an outermost loop.
+    Loop* parent{ };
+
+    /// The number of loops this loop is nested in, starting at 1 for an outermost loop.
+    size_t depth{ };
+
+    /**
+     * @brief Checks if @p block is part of the loop.
+     *
+     * @param block The block to check.
+     * @return True if the block belongs to the loop or one of its nested loops.
+     */
+    [[nodiscard]] bool contains(const BasicBlock* block) const { return std::ranges::find(blocks, block) != blocks.end(); }
+};
+
+/**
+ * @brief Finds the natural loops of a function and their nesting.
+ *
+ * A back edge is an edge whose target dominates its source. All back edges
+ * to the same header form a single loop, and a loop is nested in another one
+ * if its header is part of the other loop.
+ *
+ * @see Loop, DominatorTree, AnalysisManager, opt::LICM
+ */
+class LoopAnalysis {
+public:
+    /// Loops only depend on the control flow, see `AnalysisManager`.
+    static constexpr bool CONTROL_FLOW_ONLY = true;
+
+public:
+    /**
+     * @brief Computes the dominators of @p function and collects its loops.
+     *
+     * @param function The function to analyze.
+     */
+    explicit LoopAnalysis(Function& function);
+
+    /**
+     * @brief Collects the loops of @p function with the dominator tree cached in @p analyses.
+     *
+     * @param function The function to analyze.
+     * @param analyses The manager the `DominanceAnalysis` of the function is taken from.
+     */
+    LoopAnalysis(Function& function, AnalysisManager& analyses);
+
+    /**
+     * @brief Collects the loops of @p function with an already computed dominator tree.
+     *
+     * @param function The function to analyze.
+     * @param dominators The dominator tree of @p function.
+     */
+    LoopAnalysis(Function& function, const DominatorTree& dominators);
+
+    /**
+     * @brief Returns all loops of the function, inner loops come before the loops containing them.
+     *
+     * @return A constant reference to the loops.
+     */
+    [[nodiscard]] auto& loops() const { return _loops; }
+
+    /**
+     * @brief Returns the innermost loop containing @p block.
+     *
+     * @param block The block to look up.
+     * @return The innermost loop of the block, or nullptr if it's not part of any loop.
+     */
+    [[nodiscard]] const Loop* loop(const BasicBlock* block) const;
+
+    /**
+     * @brief Returns the number of loops containing @p block.
+     *
+     * @param block The block to look up.
+     * @return The loop nesting depth of the block, 0 if it's not part of any loop.
+     */
+    [[nodiscard]] size_t depth(const BasicBlock* block) const;
+
+private:
+    std::vector<std::unique_ptr<Loop>> _loops{ };
+    std::unordered_map<const BasicBlock*, Loop*> _innermost{ };
+};
+
+/**
+ * @brief A basic induction variable of a loop.
+ *
+ * The variable is a phi in the loop header, which starts at `initial` and is
+ * incremented by the constant `step` in every iteration: `i = phi [ i0, i + step ]`.
+ */
+struct InductionVariable {
+    /// The phi in the loop header holding the value of the current iteration.
+    Variable variable;
+
+    /// The value entering the loop, copies are already resolved.
+    Operand initial;
+
+    /// The block of the single predecessor of the header outside the loop.
+    BasicBlock* entry{ };
+
+    /// The result of the increment, which is the value for the next iteration.
+    Variable update;
+
+    /// The block containing the increment.
+    BasicBlock* increment{ };
+
+    /// The block of the back edge passing on the update.
+    BasicBlock* latch{ };
+
+    /// The constant added in every iteration, negative for counting down.
+    int64_t step{ };
+};
+
+/**
+ * @brief A loop whose exit only depends on an induction variable and an invariant bound.
+ *
+ * The header ends in `if i <comparison> bound`, which leaves the loop once the
+ * comparison fails. Comparisons leaving on success or with swapped operands
+ * are normalized to this form.
+ */
+struct CountedLoop {
+    /// The induction variable controlling the exit of the loop.
+    InductionVariable induction;
+
+    /// The comparison that must hold to stay in the loop.
+    Binary::Operator comparison{ };
+
+    /// The loop-invariant bound the induction variable is compared with.
+    Operand bound;
+
+    /// The number of iterations, if the initial value and the bound are constants.
+    std::optional<uint64_t> trip_count{ };
+};
+
+/**
+ * @brief Finds the induction variables and counted loops of a function.
+ *
+ * The analysis looks at the phis of every loop header with a single entry
+ * from outside of the loop and a single back edge, like the ones created
+ * for `while i < n: ... i = i + 1`. Copies between the phi and its
+ * increment are looked through.
+ *
+ * @see InductionVariable, CountedLoop, LoopAnalysis, opt::LoopStrengthReduction
+ */
+class InductionAnalysis {
+public:
+    /// Induction variables depend on the instructions, see `AnalysisManager`.
+    static constexpr bool CONTROL_FLOW_ONLY = false;
+
+public:
+    /**
+     * @brief Computes the loops of @p function and their induction variables.
+     *
+     * @param function The function to analyze.
+     */
+    explicit InductionAnalysis(Function& function);
+
+    /**
+     * @brief Returns the loops the induction variables belong to.
+     *
+     * @return A constant reference to the `LoopAnalysis`.
+     */
+    [[nodiscard]] auto& loops() const { return _loops; }
+
+    /**
+     * @brief Returns the basic induction variables of @p loop.
+     *
+     * @param loop The loop to look up.
+     * @return The induction variables, which may be empty.
+     */
+    [[nodiscard]] const std::vector<InductionVariable>& inductions(const Loop& loop) const;
+
+    /**
+     * @brief Returns the exit condition of @p loop, if it's a counted loop.
+     *
+     * @param loop The loop to look up.
+     * @return The counted loop, or nullptr if the exit doesn't depend on an induction variable.
+     */
+    [[nodiscard]] const CountedLoop* counted(const Loop& loop) const;
+
+private:
+    /**
+     * @brief Computes the number of iterations from a constant initial value and bound.
+     *
+     * @param counted The counted loop with its normalized comparison.
+     * @return The number of iterations, or std::nullopt if it's unknown or the induction variable would wrap around.
+     */
+    [[nodiscard]] static std::optional<uint64_t> _trip_count(const CountedLoop& counted);
+
+    /**
+     * @brief Returns the sign-extended value of an integral immediate.
+     */
+    [[nodiscard]] static std::optional<int64_t> _constant(const Operand& operand);
+
+    /**
+     * @brief Returns the comparison that holds after swapping its operands.
+     */
+    [[nodiscard]] static Binary::Operator _swap(Binary::Operator op);
+
+    /**
+     * @brief Returns the comparison that holds if @p op doesn't.
+     */
+    [[nodiscard]] static Binary::Operator _negate(Binary::Operator op);
+
+private:
+    LoopAnalysis _loops;
+    std::unordered_map<const Loop*, std::vector<InductionVariable>> _inductions{ };
+    std::unordered_map<const Loop*, CountedLoop> _counted{ };
+};
+
+/**
+ * @brief Collects every operand that is read by an instruction of a function.
+ *
+ * @see AnalysisManager, opt::DeadCodeElimination
+ */
+class UseAnalysis {
+public:
+    /// Uses depend on the instructions, see `AnalysisManager`.
+    static constexpr bool CONTROL_FLOW_ONLY = false;
+
+public:
+    /**
+     * @brief Scans all instructions of @p function for the operands they read.
+     *
+     * @param function The function to analyze.
+     */
+    explicit UseAnalysis(Function& function);
+
+    /**
+     * @brief Checks if @p operand is read by any instruction.
+     *
+     * @param operand The operand to check.
+     * @return True if the operand is used, false otherwise.
+     */
+    [[nodiscard]] bool is_used(const Operand& operand) const { return _used.contains(operand); }
+
+private:
+    std::unordered_set<Operand> _used{ };
 };
+
+/**
+ * @brief Def-use and use-def chains of the variables of a function in SSA form.
+ *
+ * Maps every variable to its defining instruction and to the instructions
+ * reading it. The chains are kept up to date by `replace_all_uses`, so sparse
+ * passes can follow them while rewriting the function. Inserting or removing
+ * instructions invalidates the chains, since they point into the blocks.
+ *
+ * @see AnalysisManager, opt::ConstantPropagation, opt::CopyPropagation
+ */
+class DefUseChains {
+public:
+    /// The chains depend on the instructions, see `AnalysisManager`.
+    static constexpr bool CONTROL_FLOW_ONLY = false;
+
+public:
+    /**
+     * @brief Builds the chains of all variables defined or used in @p function.
+     *
+     * @param function The function to analyze.
+     */
+    explicit DefUseChains(Function& function);
+
+    /**
+     * @brief Returns the single instruction defining @p variable.
+     *
+     * @param variable The variable to look up.
+     * @return The defining instruction, or nullptr if the variable is a parameter,
+     *         undefined or defined more than once.
+     */
+    [[nodiscard]] Instruction* definition(const Variable& variable) const;
+
+    /**
+     * @brief Returns every instruction reading @p variable, each listed once.
+     *
+     * @param variable The variable to look up.
+     * @return A constant reference to the using instructions.
+     */
+    [[nodiscard]] const std::vector<Instruction*>& uses(const Variable& variable) const;
+
+    /**
+     * @brief Checks if @p variable holds a single value throughout the function.
+     *
+     * This is the case for parameters that are never reassigned and for variables
+     * with exactly one definition.
+     *
+     * @param variable The variable to check.
+     * @return True if the variable is only defined once, false otherwise.
+     */
+    [[nodiscard]] bool is_single_assignment(const Variable& variable) const;
+
+    /**
+     * @brief Returns the block containing @p instruction.
+     *
+     * @param instruction An instruction of the analyzed function.
+     * @return The `BasicBlock` the instruction belongs to.
+     */
+    [[nodiscard]] BasicBlock* block(const Instruction* instruction) const { return _blocks.at(instruction); }
+
+    /**
+     * @brief Replaces the uses of @p from with @p to and updates the chains accordingly.
+     *
+     * Uses inside a `Phi` are left untouched, as the copies inserted by the
+     * `PhiLowerer` would otherwise clobber values that are still live.
+     *
+     * @tparam Filter Callable as `filter(const Instruction&)`, deciding if a use may be replaced.
+     * @param from The variable whose uses should be replaced.
+     * @param to The operand replacing the uses.
+     * @param filter The predicate selecting the users to rewrite.
+     * @return The instructions that were rewritten.
+     */
+    template <typename Filter>
+    std::vector<Instruction*> replace_all_uses(const Variable& from, const Operand& to, Filter&& filter);
+
+    /**
+     * @brief Replaces all uses of @p from outside of phis with @p to.
+     *
+     * @param from The variable whose uses should be replaced.
+     * @param to The operand replacing the uses.
+     * @return The instructions that were rewritten.
+     */
+    std::vector<Instruction*> replace_all_uses(const Variable& from, const Operand& to);
+
+private:
+    std::unordered_map<Variable, std::vector<Instruction*>> _definitions{ };
+    std::unordered_map<Variable, std::vector<Instruction*>> _uses{ };
+    std::unordered_map<const Instruction*, BasicBlock*> _blocks{ };
+    std::unordered_set<Variable> _parameters{ };
+};
+
 } // namespace arkoi::il
 
+#include "../../../src/arkoi_language/il/analyses.tpp"
+
 //==============================================================================
 // BSD 3-Clause License
 //
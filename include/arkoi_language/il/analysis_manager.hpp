@@ -0,0 +1,121 @@
+#pragma once
+
+#include <concepts>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::il {
+class AnalysisManager;
+
+/**
+ * @brief Requirements for an analysis that can be cached by the `AnalysisManager`.
+ *
+ * An analysis is computed by constructing it from the function and declares
+ * with `CONTROL_FLOW_ONLY` whether its results only depend on the control flow
+ * graph, or also on the instructions inside the blocks. An analysis building on
+ * other ones is additionally constructible with the manager, which hands out the
+ * cached results of those.
+ */
+template <typename T>
+concept Analysis = (std::constructible_from<T, Function&> || std::constructible_from<T, Function&, AnalysisManager&>) && requires {
+    { T::CONTROL_FLOW_ONLY } -> std::convertible_to<bool>;
+};
+
+/**
+ * @brief Caches the results of analyses per function.
+ *
+ * Analyses are computed on first request and reused until they are
+ * invalidated. Whoever changes a function reports what it preserved, so only
+ * the analyses depending on the changed parts get dropped.
+ *
+ * @see Analysis, opt::PassManager
+ */
+class AnalysisManager {
+public:
+    /**
+     * @brief Describes which parts of a function were left untouched by a change.
+     */
+    enum class Preserved {
+        Nothing,
+        ControlFlow,
+    };
+
+public:
+    /**
+     * @brief Returns the cached analysis of @p function, computing it if necessary.
+     *
+     * The reference stays valid until the analysis is invalidated.
+     *
+     * @tparam Type The analysis to retrieve.
+     * @param function The function that is analyzed.
+     * @return A reference to the analysis results.
+     */
+    template <Analysis Type>
+    Type& get(Function& function);
+
+    /**
+     * @brief Checks if the analysis of @p function is currently cached.
+     *
+     * @tparam Type The analysis to check.
+     * @param function The function that is analyzed.
+     * @return True if the analysis is cached, false otherwise.
+     */
+    template <Analysis Type>
+    [[nodiscard]] bool cached(const Function& function) const;
+
+    /**
+     * @brief Drops every analysis of @p function that is not preserved.
+     *
+     * @param function The function that was changed.
+     * @param preserved The parts of the function that were not changed.
+     */
+    void invalidate(const Function& function, Preserved preserved = Preserved::Nothing);
+
+private:
+    struct Entry {
+        std::shared_ptr<void> analysis;
+        bool control_flow_only;
+    };
+
+    using Entries = std::unordered_map<std::type_index, Entry>;
+
+private:
+    std::unordered_map<const Function*, Entries> _entries{ };
+};
+
+#include "../../../src/arkoi_language/il/analysis_manager.tpp"
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief The direct calls between the functions of a module, built from the names of every `Call`.
+ *
+ * Calls to functions that are not part of the module, e.g. defined by another source, are
+ * listed as callees but have no `Function` of their own. The graph refers to the functions
+ * and blocks of the module, thus it must be rebuilt once functions are added or removed.
+ *
+ * @see Module, Call
+ */
+class CallGraph {
+public:
+    /**
+     * @brief A single call to a function.
+     */
+    struct Site {
+        /// The function containing the call.
+        Function* caller;
+        /// The block containing the call.
+        BasicBlock* block;
+    };
+
+public:
+    /**
+     * @brief Builds the call graph of all functions of @p module.
+     *
+     * @param module The module whose calls are collected.
+     */
+    explicit CallGraph(Module& module);
+
+    /**
+     * @brief Returns the function with the given name.
+     *
+     * @param name The name of the function.
+     * @return The function, or nullptr if it's not part of the module.
+     */
+    [[nodiscard]] Function* function(const std::string& name) const;
+
+    /**
+     * @brief Returns the names of the functions called by @p name, once for every call.
+     *
+     * @param name The name of the caller.
+     * @return The callees in the order of the calls.
+     */
+    [[nodiscard]] const std::vector<std::string>& callees(const std::string& name) const;
+
+    /**
+     * @brief Returns every call to the function @p name from within the module.
+     *
+     * @param name The name of the callee.
+     * @return The call sites, a block is listed once for every call it contains.
+     */
+    [[nodiscard]] const std::vector<Site>& sites(const std::string& name) const;
+
+    /**
+     * @brief Returns all functions that may be called, directly or not, starting from @p roots.
+     *
+     * @param roots The names of the functions the walk starts at, which are always part of the result.
+     * @return The names of the reachable functions, including calls to functions outside of the module.
+     */
+    [[nodiscard]] std::unordered_set<std::string> reachable(const std::vector<std::string>& roots) const;
+
+    /**
+     * @brief Checks if a function may call itself, directly or through other functions.
+     *
+     * @param name The name of the function.
+     * @return True if the function is part of a cycle.
+     */
+    [[nodiscard]] bool is_recursive(const std::string& name) const;
+
+    /**
+     * @brief Returns the functions of the module ordered such that callees come before their callers.
+     *
+     * Functions of a cycle are ordered by their first visit, starting at the first function of the module.
+     *
+     * @return The functions in bottom-up order.
+     */
+    [[nodiscard]] std::vector<Function*> bottom_up() const;
+
+private:
+    std::unordered_map<std::string, std::vector<std::string>> _callees{ };
+    std::unordered_map<std::string, std::vector<Site>> _sites{ };
+    std::unordered_map<std::string, Function*> _functions{ };
+    std::vector<Function*> _order{ };
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -15,20 +19,25 @@ namespace arkoi::il {
  * A basic block is a linear sequence of instructions with a single entry point
  * (the first instruction) and a single exit point (the last instruction).
  * In Arkoi IL, basic blocks are linked together to form the CFG of a function.
+ *
+ * The instruction and predecessor containers allocate from a memory resource,
+ * which is the arena of the owning `Function` for blocks created through
+ * `Function::emplace_back`.
  */
 class BasicBlock {
 public:
-    using Predecessors = std::unordered_set<BasicBlock*>;
-    using Instructions = std::vector<Instruction>;
+    using Predecessors = std::pmr::unordered_set<BasicBlock*>;
+    using Instructions = std::pmr::vector<Instruction>;
 
 public:
     /**
      * @brief Constructs a `BasicBlock` with a unique label.
      *
      * @param label The symbolic name of the block (e.g., "L1", "entry").
+     * @param resource The memory resource used for the instructions and predecessors.
      */
-    explicit BasicBlock(std::string label) :
-        _label(std::move(label)) { }
+    explicit BasicBlock(std::string label, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+        _instructions(resource), _predecessors(resource), _label(std::move(label)) { }
 
     /**
      * @brief Dispatches the visitor to this basic block.
@@ -125,11 +134,26 @@ public:
      */
     Instructions::iterator end() { return _instructions.end(); }
 
+    /**
+     * @brief Returns how often the block was executed according to the profile of the function.
+     *
+     * @return The execution count, or std::nullopt if the block wasn't part of the profile.
+     */
+    [[nodiscard]] auto& count() const { return _count; }
+
+    /**
+     * @brief Sets the execution count taken from a profile.
+     *
+     * @param count The amount of times the block was executed.
+     */
+    void set_count(const uint64_t count) { _count = count; }
+
 private:
-    Instructions _instructions{ };
-    Predecessors _predecessors{ };
+    Instructions _instructions;
+    Predecessors _predecessors;
     BasicBlock* _branch{ nullptr };
     BasicBlock* _next{ nullptr };
+    std::optional<uint64_t> _count{ };
     std::string _label;
 };
 
@@ -198,11 +222,16 @@ private:
 };
 
 /**
- * @brief Utility class for computing dominator information in a control flow graph (CFG).
+ * @brief The dominator tree of the blocks reachable from the entry of a function.
+ *
+ * The blocks are numbered in reverse postorder, and the immediate dominators are
+ * stored in vectors indexed by these numbers. The tree itself is numbered with a
+ * depth-first walk, thus a block dominates another one if the interval between
+ * its pre- and postorder numbers contains the one of the other block, which
+ * answers `dominates` in constant time.
  *
- * This class provides static methods to compute the immediate dominators
- * and dominance frontiers for all basic blocks in a function. It uses
- * standard algorithms based on the Cooper–Harvey–Kennedy iterative approach.
+ * The static methods return the same results as maps, which is the form the
+ * frontier and tree walks consume.
  */
 class DominatorTree {
 public:
@@ -212,7 +241,60 @@ public:
     /// Maps each basic block to its immediate dominator.
     using Immediates = std::unordered_map<BasicBlock*, BasicBlock*>;
 
+    /**
+     * @brief The algorithm the immediate dominators are computed with.
+     */
+    enum class Algorithm {
+        Automatic, ///< `SemiNCA` for CFGs with at least `SEMI_NCA_THRESHOLD` blocks, `Iterative` otherwise.
+        Iterative, ///< The Cooper–Harvey–Kennedy iteration, which is the fastest for small CFGs.
+        SemiNCA,   ///< The Semi-NCA variant of Lengauer–Tarjan, which doesn't depend on the loop nesting.
+    };
+
+    /// The amount of blocks from which on `Algorithm::Automatic` uses `Algorithm::SemiNCA`.
+    static constexpr size_t SEMI_NCA_THRESHOLD = 512;
+
 public:
+    DominatorTree() = default;
+
+    /**
+     * @brief Computes the dominator tree of @p function.
+     *
+     * @param function The function whose CFG will be analyzed.
+     * @param algorithm The algorithm used for the immediate dominators, all of them produce the same tree.
+     */
+    explicit DominatorTree(const Function& function, Algorithm algorithm = Algorithm::Automatic);
+
+    /**
+     * @brief Checks if @p dominator dominates @p block, which includes both being the same block.
+     *
+     * @return True if both blocks are reachable and @p dominator dominates @p block.
+     */
+    [[nodiscard]] bool dominates(const BasicBlock* dominator, const BasicBlock* block) const;
+
+    /**
+     * @brief Returns the immediate dominator of @p block.
+     *
+     * @return The immediate dominator, or nullptr for the entry and unreachable blocks.
+     */
+    [[nodiscard]] BasicBlock* immediate(const BasicBlock* block) const;
+
+    /**
+     * @brief Checks if @p block is reachable from the entry, thus part of the tree.
+     */
+    [[nodiscard]] bool contains(const BasicBlock* block) const { return _index(block) != NONE; }
+
+    /**
+     * @brief Returns the reachable blocks in reverse postorder, the index of a block is its number.
+     */
+    [[nodiscard]] auto& blocks() const { return _blocks; }
+
+    /**
+     * @brief Returns the immediate dominator of every reachable block as map, nullptr for the entry.
+     *
+     * The blocks are inserted in reverse postorder.
+     */
+    [[nodiscard]] Immediates immediates() const;
+
     /**
      * @brief Computes the immediate dominator of each block in the function.
      *
@@ -236,25 +318,57 @@ public:
      */
     static Frontiers compute_frontiers(const Function& function);
 
+    /**
+     * @brief Computes the dominance frontiers from already computed immediate dominators.
+     *
+     * @param function The function whose CFG will be analyzed.
+     * @param immediates The immediate dominators of the function's blocks.
+     * @return A map from each basic block to the set of blocks in its dominance frontier.
+     */
+    static Frontiers compute_frontiers(const Function& function, const Immediates& immediates);
+
 private:
+    /// The number of a block that isn't part of the tree.
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief Returns the reverse postorder number of @p block, or `NONE` if it is unreachable.
+     */
+    [[nodiscard]] size_t _index(const BasicBlock* block) const;
+
+    /**
+     * @brief Computes the immediate dominators with the Cooper–Harvey–Kennedy iteration.
+     */
+    void _iterative();
+
+    /**
+     * @brief Computes the immediate dominators with Semi-NCA over a depth-first preorder.
+     */
+    void _semi_nca();
+
+    /**
+     * @brief Numbers the tree with a depth-first walk for the `dominates` queries.
+     */
+    void _number();
+
     /**
      * @brief Helper function to compute the intersection of two dominator paths.
      *
-     * This is used internally by the immediate dominator computation. It walks
-     * up the dominator tree of two blocks until a common ancestor is found.
+     * It walks up the dominator tree of two blocks until a common ancestor is found,
+     * a smaller reverse postorder number is always closer to the entry.
      *
-     * @param u The first basic block.
-     * @param v The second basic block.
-     * @param immediates Map of already computed immediate dominators.
-     * @param rpo_indices Reverse postorder indices for the blocks, used to guide traversal.
-     * @return The nearest common dominator of u and v.
+     * @param u The number of the first basic block.
+     * @param v The number of the second basic block.
+     * @return The number of the nearest common dominator of u and v.
      */
-    static BasicBlock* _intersect(
-        BasicBlock* u,
-        BasicBlock* v,
-        const Immediates& immediates,
-        const BlockTraversal::BlockOrder::Indices& rpo_indices
-    );
+    [[nodiscard]] size_t _intersect(size_t u, size_t v) const;
+
+private:
+    BlockTraversal::BlockOrder::Indices _indices{ };
+    std::vector<std::vector<size_t>> _predecessors{ };
+    std::vector<BasicBlock*> _blocks{ };
+    std::vector<size_t> _immediates{ };
+    std::vector<size_t> _enter{ }, _exit{ };
 };
 
 /**
@@ -384,6 +498,9 @@ private:
  *
  * A `Function` holds a collection of `BasicBlock` objects that form its CFG.
  * It also manages the pool of blocks and provides access to entry/exit points.
+ *
+ * Blocks and their instruction lists are bump-allocated from a per-function
+ * arena, so tearing down a function releases its CFG in a few large frees.
  */
 class Function {
 public:
@@ -403,7 +520,7 @@ public:
      * @param parameters The list of input variables.
      * @param type The semantic return type.
      * @param entry_label The label for the start of the function.
-     * @param exit_label The label for the return point.
+     * @param exit_label The label for the return point, if it equals @p entry_label the entry is also the exit.
      */
     Function(
         std::string name, std::vector<Variable> parameters, const sem::Type& type,
@@ -420,8 +537,9 @@ public:
     /**
      * @brief Creates and appends a new basic block to the function.
      *
-     * @param label The label for the constructed `BasicBlock`.
+     * @param label The label for the constructed `BasicBlock`, which must be unique within the function.
      * @return A pointer to the newly created `BasicBlock`.
+     * @throws std::logic_error if the function already has a block with this label.
      */
     BasicBlock* emplace_back(const std::string& label);
 
@@ -432,6 +550,20 @@ public:
      */
     [[nodiscard]] bool is_leaf();
 
+    /**
+     * @brief Checks if the results of the function are cached by their argument, see `opt::Memoize`.
+     *
+     * @return True if the backend emits a cache in front of the function.
+     */
+    [[nodiscard]] bool is_memoized() const { return _memoized; }
+
+    /**
+     * @brief Sets if the results of the function are cached by their argument.
+     *
+     * @param memoized True if the backend should emit a cache in front of the function.
+     */
+    void set_memoized(const bool memoized) { _memoized = memoized; }
+
     /**
      * @brief Removes a basic block from the function's CFG.
      *
@@ -489,6 +621,16 @@ public:
      */
     [[nodiscard]] auto& parameters() { return _parameters; }
 
+    /**
+     * @brief Returns the arena all blocks of this function are allocated from.
+     *
+     * Memory taken from the arena is only released once the function (and all of its
+     * copies) are destroyed, thus it should only be used for data owned by the function.
+     *
+     * @return A pointer to the monotonic memory resource.
+     */
+    [[nodiscard]] auto* arena() const { return _arena.get(); }
+
     /**
      * @brief Returns a CFG traversal iterator starting at the entry block.
      *
@@ -505,12 +647,15 @@ public:
     [[nodiscard]] BlockIterator end() { return BlockIterator(nullptr); }
 
 private:
+    // The arena must be declared first, as it has to outlive every block allocated from it.
+    std::shared_ptr<std::pmr::monotonic_buffer_resource> _arena;
     std::unordered_map<std::string, std::shared_ptr<BasicBlock>> _block_pool{ };
     std::vector<Variable> _parameters;
     BasicBlock* _entry;
     BasicBlock* _exit;
     std::string _name;
     sem::Type _type;
+    bool _memoized{ };
 };
 
 /**
@@ -540,6 +685,16 @@ public:
     template <typename... Args>
     Function& emplace_back(Args&&... args);
 
+    /**
+     * @brief Removes the function with the given name from the module.
+     *
+     * References to other functions of the module are invalidated.
+     *
+     * @param name The name of the function to be removed.
+     * @return True if the function was found and removed, false otherwise.
+     */
+    [[nodiscard]] bool remove(const std::string& name);
+
     /**
      * @brief Returns an iterator to the first function in the module.
      *
@@ -21,22 +21,37 @@ public:
     /**
      * @brief Constructs a `CFGPrinter` that writes to the provided output stream.
      *
+     * The text is collected in a buffer, which is shared with the `ILPrinter` of the instructions
+     * and written once it is full, after `end` and when the printer is destroyed.
+     *
      * @param output The string stream where the DOT representation will be accumulated.
      */
     explicit CFGPrinter(std::ostream& output) :
-        _current_function(nullptr), _output(output), _printer(output) { }
+        _current_function(nullptr), _output(output), _printer(_output) { }
 
     /**
      * @brief Starts the DOT graph and visits all functions.
      */
     void visit(Module& module) override;
 
-private:
     /**
      * @brief Generates a subgraph for a single function.
+     *
+     * Outside of `visit(Module)` the subgraph needs to be enclosed by `begin` and `end`.
      */
     void visit(Function& function) override;
 
+    /**
+     * @brief Writes the header of the DOT graph and its default attributes.
+     */
+    void begin();
+
+    /**
+     * @brief Closes the DOT graph and writes it to the stream.
+     */
+    void end();
+
+private:
     /**
      * @brief Generates a node in the DOT graph for a basic block.
      */
@@ -102,10 +117,15 @@ private:
      */
     void visit(Assign& instruction) override { _printer.visit(instruction); }
 
+    /**
+     * @brief Delegates instruction printing to the internal `ILPrinter`.
+     */
+    void visit(Select& instruction) override { _printer.visit(instruction); }
+
 private:
     DataflowAnalysis<BlockLivenessAnalysis> _liveness{ };
     Function* _current_function;
-    std::ostream& _output;
+    utils::OutputBuffer _output;
     ILPrinter _printer;
 };
 } // namespace arkoi::il
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief The kind of an instruction, which equals the index of its alternative in `Instruction`.
+ */
+enum class Opcode : uint8_t {
+    Goto, If, Cast, Call, Return,
+    Binary, Alloca, Store, Load,
+    Argument, Phi, Assign, Select,
+};
+
+/**
+ * @brief A structure-of-arrays view of the variables defined and used by the instructions of a function.
+ *
+ * Every variable is numbered densely in the order it first appears, definitions before uses. Per block the
+ * opcode, the defined variable and the used variables of every instruction are kept in parallel integer
+ * arrays, thus the backend walks over them without visiting the instructions themselves. Used operands that
+ * are no variables are kept as `NONE`, which preserves the position of every use.
+ *
+ * The view is a snapshot of post-SSA code and has to be rebuilt once the instructions change.
+ *
+ * @see Instruction
+ */
+class CompactFunction {
+public:
+    /// The id standing for a missing definition or an operand that is no variable.
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief The parallel arrays of a single basic block.
+     */
+    struct Block {
+        /// The block the arrays were built from.
+        BasicBlock* source{ };
+
+        /// The opcode of every instruction.
+        std::vector<Opcode> opcodes;
+
+        /// The variable defined by every instruction, or `NONE`.
+        std::vector<uint32_t> results;
+
+        /// The start of the uses of every instruction in `operands`, followed by the end of the last one.
+        std::vector<uint32_t> offsets;
+
+        /// The used variables of all instructions, one after the other.
+        std::vector<uint32_t> operands;
+
+        /**
+         * @brief Returns the amount of instructions in the block.
+         */
+        [[nodiscard]] size_t size() const { return opcodes.size(); }
+
+        /**
+         * @brief Returns the used variables of the instruction at @p index.
+         */
+        [[nodiscard]] std::span<const uint32_t> uses(const size_t index) const {
+            return { operands.data() + offsets[index], operands.data() + offsets[index + 1] };
+        }
+    };
+
+public:
+    CompactFunction() = default;
+
+    /**
+     * @brief Builds the arrays of every block of @p function.
+     *
+     * @param function The function to build the view of, which must not contain `Phi` instructions.
+     */
+    explicit CompactFunction(Function& function);
+
+    /**
+     * @brief Returns the blocks in the iteration order of the function.
+     */
+    [[nodiscard]] auto& blocks() const { return _blocks; }
+
+    /**
+     * @brief Returns the numbered variables, indexed by their id.
+     */
+    [[nodiscard]] auto& variables() const { return _variables; }
+
+    /**
+     * @brief Returns the id of @p variable, or `NONE` if it is neither defined nor used.
+     */
+    [[nodiscard]] uint32_t id(const Variable& variable) const;
+
+    /**
+     * @brief Returns the amount of instructions of all blocks.
+     */
+    [[nodiscard]] size_t instructions() const { return _instructions; }
+
+private:
+    /**
+     * @brief Returns the id of the operand if it is a variable, which is numbered on its first appearance.
+     */
+    uint32_t _number(const Operand& operand);
+
+private:
+    std::unordered_map<Variable, uint32_t> _ids{ };
+    std::vector<Variable> _variables{ };
+    std::vector<Block> _blocks{ };
+    size_t _instructions{ };
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <concepts>
-#include <stack>
+#include <queue>
 #include <vector>
 
 #include "arkoi_language/il/cfg.hpp"
@@ -34,10 +34,14 @@ enum class DataflowGranularity {
  * @tparam ResultType The type of data stored in the dataflow sets (e.g., `Operand`).
  * @tparam DirectionType Whether the analysis is forward or backward.
  * @tparam GranularityType Whether the analysis operates on blocks or instructions.
+ * @tparam StateType The set representation of a single program point. Analyses over the
+ *                   operands of a function should prefer the dense `OperandSet`.
  *
- * @see DataflowAnalysis, BlockLivenessAnalysis
+ * @see DataflowAnalysis, BlockLivenessAnalysis, OperandSet
  */
-template <typename ResultType, DataflowDirection DirectionType, DataflowGranularity GranularityType>
+template <
+    typename ResultType, DataflowDirection DirectionType, DataflowGranularity GranularityType,
+    typename StateType = std::unordered_set<ResultType>>
 class DataflowPass {
 public:
     /**
@@ -49,7 +53,7 @@ public:
     /**
      * @brief The representation of the dataflow information at a single program point.
      */
-    using State = std::unordered_set<Result>;
+    using State = StateType;
 
     static constexpr auto Granularity = GranularityType;
     static constexpr auto Direction = DirectionType;
@@ -57,6 +61,16 @@ public:
 public:
     virtual ~DataflowPass() = default;
 
+    /**
+     * @brief Hook called once before the states of @p function are initialized.
+     *
+     * Passes can use it to set up per-function data, e.g. the operand numbering of
+     * a bit-vector state.
+     *
+     * @param function The function that is about to be analyzed.
+     */
+    virtual void prepare(Function&) { }
+
     /**
      * @brief The meet operator: combines dataflow states from multiple predecessors/successors.
      *
@@ -90,9 +104,10 @@ public:
 template <typename T>
 concept DataflowPassConcept = requires {
     typename T::Result;
+    typename T::State;
     { T::Direction } -> std::convertible_to<DataflowDirection>;
     { T::Granularity } -> std::convertible_to<DataflowGranularity>;
-} && std::is_base_of_v<DataflowPass<typename T::Result, T::Direction, T::Granularity>, T>;
+} && std::is_base_of_v<DataflowPass<typename T::Result, T::Direction, T::Granularity, typename T::State>, T>;
 
 /**
  * @brief The execution engine for dataflow analysis.
@@ -110,7 +125,7 @@ public:
      * @brief The key used to look up states (pointer to `BasicBlock` or `Instruction`).
      */
     using Key = std::conditional_t<Pass::Granularity == DataflowGranularity::Block, BasicBlock*, Instruction*>;
-    using State = std::unordered_set<typename Pass::Result>;
+    using State = typename Pass::State;
 
 public:
     /**
@@ -134,7 +149,9 @@ public:
     /**
      * @brief Executes the worklist algorithm on the provided function.
      *
-     * This method iterates until the dataflow states reach a fixed point.
+     * This method iterates until the dataflow states reach a fixed point. The worklist
+     * is ordered by reverse post-order (forward) or post-order (backward), and a block
+     * is never queued more than once at a time.
      *
      * @param function The function whose CFG will be analyzed.
      */
@@ -160,15 +177,24 @@ public:
      */
     [[nodiscard]] auto& in() const { return _in; }
 
+    /**
+     * @brief Returns how many blocks were processed until the fixed point was reached.
+     *
+     * @return The amount of worklist iterations of the last `run`.
+     */
+    [[nodiscard]] auto iterations() const { return _iterations; }
+
 private:
     std::unordered_map<Key, State> _out{ };
     std::unordered_map<Key, State> _in{ };
     std::shared_ptr<Pass> _pass;
+    size_t _iterations{ };
 };
 
-#include "../../../src/arkoi_language/il/dataflow.tpp"
 } // namespace arkoi::il
 
+#include "../../../src/arkoi_language/il/dataflow.tpp"
+
 //==============================================================================
 // BSD 3-Clause License
 //
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "arkoi_language/il/call_graph.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief Interprocedural analysis of what the functions of a module do besides returning a value.
+ *
+ * As all memory of a function lives in its own stack frame, a function only has side effects if
+ * it calls a function outside of the module, whose code is unknown. Such a function is known to
+ * always return if it contains no loop, no recursion and no division that may trap, and all of
+ * its callees always return as well.
+ *
+ * The effects start out as the ones of every function on its own and are lowered along the calls
+ * until nothing changes anymore. Once annotated, the calls carry the effects of their callee, thus
+ * the function passes can make use of them without seeing the rest of the module.
+ *
+ * @see CallGraph, Call::Effects
+ */
+class EffectAnalysis {
+public:
+    /**
+     * @brief Computes the effects of all functions of @p module.
+     *
+     * @param module The module to analyze.
+     */
+    explicit EffectAnalysis(Module& module);
+
+    /**
+     * @brief Returns the effects of calling the function @p name.
+     *
+     * @param name The name of the function.
+     * @return The effects, or `Call::Effects::Unknown` if the function is not part of the module.
+     */
+    [[nodiscard]] Call::Effects effects(const std::string& name) const;
+
+    /**
+     * @brief Stores the effects of the callee on every call of @p module.
+     *
+     * @param module The module that was analyzed.
+     * @return The number of calls whose effects changed.
+     */
+    size_t annotate(Module& module) const;
+
+private:
+    /**
+     * @brief Returns the effects of the instructions and blocks of a function, ignoring its callees.
+     *
+     * @param graph The call graph of the module.
+     * @param function The function to inspect.
+     * @return `Call::Effects::Speculatable` or `Call::Effects::ReadNone` if the function may not return.
+     */
+    [[nodiscard]] static Call::Effects _local(const CallGraph& graph, Function& function);
+
+    /**
+     * @brief Checks if the blocks of the function form a cycle, i.e. a loop.
+     *
+     * @param function The function to inspect.
+     * @return True if a block can be reached from itself.
+     */
+    [[nodiscard]] static bool _has_loop(Function& function);
+
+private:
+    std::unordered_map<std::string, Call::Effects> _effects{ };
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
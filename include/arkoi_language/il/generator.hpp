@@ -1,5 +1,9 @@
 #pragma once
 
+#include <optional>
+#include <string>
+#include <unordered_set>
+
 #include "arkoi_language/il/cfg.hpp"
 #include "arkoi_language/il/instruction.hpp"
 #include "arkoi_language/sem/type.hpp"
@@ -12,15 +16,62 @@ namespace arkoi::il {
  * Code representation organized into a Control Flow Graph. It manages the
  * creation of basic blocks, temporary variables, and stack allocations.
  *
+ * In the `Form::SSA` form the locals are kept in SSA form while the AST is walked,
+ * following Braun et al. ("Simple and Efficient Construction of SSA Form"). Every
+ * assignment defines a new version of the local and reading it looks up the
+ * version reaching the current block, which places a phi where the predecessors
+ * disagree. A block is sealed once all of its predecessors are known, until then
+ * its phis stay incomplete. Phis that only merge a single value are removed again.
+ *
  * @see ast::Visitor, Module, Function, BasicBlock
  */
 class Generator final : ast::Visitor {
 public:
+    /**
+     * @brief How the locals of the functions are generated.
+     */
+    enum class Form {
+        /// Every local lives in an `Alloca`, which the `SSAPromoter` promotes afterward.
+        Memory,
+        /// The locals are directly generated in SSA form, without any `Alloca`, `Store` or `Load`.
+        SSA,
+    };
+
+public:
+    /**
+     * @brief Constructs a `Generator` that generates every function of the program.
+     *
+     * @param form How the locals are generated.
+     */
+    explicit Generator(const Form form = Form::Memory) :
+        _form(form) { }
+
+    /**
+     * @brief Constructs a `Generator` that only generates some functions of the program.
+     *
+     * The other functions are still callable, as calls only need the symbol of the callee.
+     *
+     * @param functions The names of the functions to generate.
+     * @param form How the locals are generated.
+     */
+    explicit Generator(std::unordered_set<std::string> functions, const Form form = Form::Memory) :
+        _functions(std::move(functions)), _form(form) { }
+
     /**
      * @brief Processes the global program structure.
      */
     void visit(ast::Program& node) override;
 
+    /**
+     * @brief Generates a single function of a resolved program, regardless of the functions to generate.
+     *
+     * The labels are numbered per function, thus the function is generated the same, no matter which
+     * other functions are generated alongside it. This allows to generate them on different threads.
+     *
+     * @param node The `ast::Function` node to generate.
+     */
+    void generate(ast::Function& node) { visit(node); }
+
     /**
      * @brief Returns the compilation module being populated.
      *
@@ -142,13 +193,80 @@ private:
      */
     [[nodiscard]] Memory _make_memory(const sem::Type& type);
 
+    /**
+     * @brief Emits the allocation of @p memory, which only exists in the `Form::Memory` form.
+     */
+    void _emit_alloca(const Memory& memory, const std::optional<pretty_diagnostics::Span>& span);
+
+    /**
+     * @brief Emits the assignment of @p value to @p memory in the current block.
+     *
+     * In the `Form::SSA` form this defines a new version of the local instead of storing it.
+     */
+    void _emit_store(const Memory& memory, const Operand& value, const std::optional<pretty_diagnostics::Span>& span);
+
+    /**
+     * @brief Emits the read of @p memory in the current block into a new temporary.
+     *
+     * In the `Form::SSA` form the temporary is a copy of the version reaching the current block.
+     *
+     * @return The temporary holding the read value.
+     */
+    [[nodiscard]] Variable _emit_load(const Memory& memory, const std::optional<pretty_diagnostics::Span>& span);
+
+    /**
+     * @brief Marks @p block as sealed, as all of its predecessors are known, and completes its phis.
+     */
+    void _seal(BasicBlock* block);
+
+    /**
+     * @brief Returns the version of @p memory reaching the end of @p block.
+     */
+    [[nodiscard]] Variable _read(const Memory& memory, BasicBlock* block);
+
+    /**
+     * @brief Looks up the version of @p memory in the predecessors of @p block, which defines none itself.
+     */
+    [[nodiscard]] Variable _read_predecessors(const Memory& memory, BasicBlock* block);
+
+    /**
+     * @brief Adds the version reaching the end of every predecessor to the phi defining @p result.
+     *
+     * @return The phi result, or the single value replacing it if the phi is trivial.
+     */
+    [[nodiscard]] Variable _add_phi_operands(const Memory& memory, BasicBlock* block, const Variable& result);
+
+    /**
+     * @brief Removes the phi defining @p result in @p block if it only merges a single value besides itself.
+     *
+     * @return The phi result, or the single value replacing it.
+     */
+    Variable _remove_trivial_phi(BasicBlock* block, const Variable& result);
+
+    /**
+     * @brief Returns the value replacing @p variable, following the removed phis.
+     */
+    [[nodiscard]] Variable _resolve(Variable variable) const;
+
+    /**
+     * @brief Removes the phis left trivial by later removals and rewrites the uses of all removed phis.
+     */
+    void _finish_ssa();
+
 private:
+    std::unordered_map<BasicBlock*, std::vector<std::pair<Memory, Variable>>> _incomplete_phis{ };
+    std::unordered_map<BasicBlock*, std::unordered_map<Memory, Variable>> _definitions{ };
+    std::unordered_map<Variable, Variable> _replaced_phis{ };
+    std::unordered_map<Memory, size_t> _versions{ };
+    std::unordered_set<BasicBlock*> _sealed{ };
     std::unordered_map<std::shared_ptr<sem::Symbol>, Memory> _allocas{ };
+    std::optional<std::unordered_set<std::string>> _functions{ };
     std::optional<Memory> _return_temp{ };
     size_t _temp_index{ }, _label_index{ };
     Function* _current_function{ };
     BasicBlock* _current_block{ };
     Operand _current_operand{ };
+    Form _form;
     Module _module;
 };
 } // namespace arkoi::il
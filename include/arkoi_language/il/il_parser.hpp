@@ -0,0 +1,107 @@
+#pragma once
+
+#include <memory>
+
+#include "arkoi_language/il/cfg.hpp"
+#include "arkoi_language/utils/diagnostics.hpp"
+#include "pretty_diagnostics/report.hpp"
+#include "pretty_diagnostics/source.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief Parses the textual IL written by the `ILPrinter` back into a `Module`.
+ *
+ * This allows IL captured from another compilation to be optimized and lowered standalone,
+ * without the frontend. The format is parsed line by line: a function starts with its `fun`
+ * signature, every unindented line ending in a colon starts a block and every indented line
+ * is an instruction. The edges between the blocks are restored from their terminators, the
+ * block holding the `ret` becomes the exit of the function.
+ *
+ * As the printer omits some details, they are reconstructed:
+ * - Immediates take the type of the place they are used in, e.g. the type of a `Binary`.
+ * - The arguments of a call are the results of the preceding `arg` instructions, which are
+ *   named after the result of the call.
+ * - The execution counts of the blocks and the memoization of the functions are lost.
+ *
+ * The first malformed line is reported to the diagnostics, which aborts the parsing.
+ *
+ * @see ILPrinter, Serializer
+ */
+class ILParser {
+public:
+    /**
+     * @brief Constructs a parser for the IL in @p source.
+     *
+     * @param source The source holding the printed IL.
+     * @param diagnostics The diagnostics the first error is reported to.
+     */
+    ILParser(std::shared_ptr<pretty_diagnostics::Source> source, utils::Diagnostics& diagnostics) :
+        _source(std::move(source)), _diagnostics(diagnostics) { }
+
+    /**
+     * @brief Parses all functions of the source.
+     *
+     * @return The parsed module, which is incomplete if an error was reported.
+     */
+    [[nodiscard]] Module parse();
+
+private:
+    std::shared_ptr<pretty_diagnostics::Source> _source;
+    utils::Diagnostics& _diagnostics;
+};
+
+/**
+ * @brief Error indicating a line that doesn't follow the format of the `ILPrinter`.
+ */
+class MalformedIL final : public std::exception {
+public:
+    /**
+     * @brief Constructs a `MalformedIL` error.
+     *
+     * @param message Description of what was expected.
+     * @param span Source span of the offending part of the line.
+     */
+    MalformedIL(const std::string& message, const pretty_diagnostics::Span& span);
+
+    /**
+     * @brief Get the diagnostic report associated with this error.
+     *
+     * @return The diagnostic report.
+     */
+    [[nodiscard]] auto& report() const { return _report; }
+
+private:
+    pretty_diagnostics::Report _report;
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
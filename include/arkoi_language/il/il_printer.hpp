@@ -1,8 +1,10 @@
 #pragma once
 
-#include <sstream>
+#include <optional>
+#include <ostream>
 
 #include "arkoi_language/il/visitor.hpp"
+#include "arkoi_language/utils/output_buffer.hpp"
 
 namespace arkoi::il {
 /**
@@ -18,13 +20,24 @@ public:
     /**
      * @brief Constructs an `ILPrinter` that writes to the provided output stream.
      *
+     * The text is collected in a buffer of its own, which is written once it is full, after
+     * `visit(Module)` and when the printer is destroyed.
+     *
      * @param output The string stream where the IL text will be accumulated.
      */
     explicit ILPrinter(std::ostream& output) :
+        _owned(std::in_place, output), _output(*_owned) { }
+
+    /**
+     * @brief Constructs an `ILPrinter` that appends to the buffer of another printer.
+     *
+     * @param output The buffer where the IL text will be accumulated.
+     */
+    explicit ILPrinter(utils::OutputBuffer& output) :
         _output(output) { }
 
     /**
-     * @brief Prints a representation of the entire module.
+     * @brief Prints a representation of the entire module and writes it to the stream.
      */
     void visit(Module& module) override;
 
@@ -98,8 +111,14 @@ public:
      */
     void visit(Assign& instruction) override;
 
+    /**
+     * @brief Prints a `Select` instruction.
+     */
+    void visit(Select& instruction) override;
+
 private:
-    std::ostream& _output;
+    std::optional<utils::OutputBuffer> _owned{ };
+    utils::OutputBuffer& _output;
 };
 } // namespace arkoi::il
 
@@ -32,18 +32,18 @@ public:
     /**
      * @brief Returns the result variable defined by the call.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
     // ReSharper disable once CppMemberFunctionMayBeStatic
-    [[nodiscard]] std::vector<Operand> defs() const { return { }; }
+    [[nodiscard]] OperandList defs() const { return { }; }
 
     /**
      * @brief Returns the argument operands used by the call.
      *
-     * @return A vector of `_arguments`.
+     * @return A list of `_arguments`.
      */
     // ReSharper disable once CppMemberFunctionMayBeStatic
-    [[nodiscard]] std::vector<Operand> uses() const { return { }; }
+    [[nodiscard]] OperandList uses() const { return { }; }
 
     /**
      * @brief Returns whether this instruction is constant.
@@ -106,17 +106,17 @@ public:
     /**
      * @brief Returns the result variable defined by this instruction.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
     // ReSharper disable once CppMemberFunctionMayBeStatic
-    [[nodiscard]] std::vector<Operand> defs() const { return { }; }
+    [[nodiscard]] OperandList defs() const { return { }; }
 
     /**
      * @brief Returns the operands used by this conditional jump.
      *
-     * @return A vector containing the `_condition` operand.
+     * @return A list containing the `_condition` operand.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _condition }; }
+    [[nodiscard]] OperandList uses() const { return { _condition }; }
 
     /**
      * @brief Checks if the condition is an immediate constant.
@@ -167,8 +167,19 @@ private:
  * @brief Represents a function call in the IL.
  *
  * A `Call` defines a result variable and uses a list of argument operands.
+ * The effects of the callee are unknown until an `EffectAnalysis` annotated the call.
  */
 class Call final {
+public:
+    /**
+     * @brief What is known about the callee besides the value it returns.
+     */
+    enum class Effects {
+        Unknown,      ///< The callee may have side effects, thus the call is never moved, merged or removed.
+        ReadNone,     ///< The result only depends on the arguments and nothing else is changed, but it may not return.
+        Speculatable, ///< Additionally, the callee always returns, thus the call may be removed or executed anywhere.
+    };
+
 public:
     /**
      * @brief Constructs a `Call` instruction.
@@ -177,13 +188,14 @@ public:
      * @param name The name of the function to be called.
      * @param arguments The list of operands passed as arguments.
      * @param span The source location of this instruction.
+     * @param effects The effects of the callee, if they are already known.
      */
     Call(
         Variable result, std::string name, std::vector<Operand>&& arguments,
-        std::optional<pretty_diagnostics::Span> span
+        std::optional<pretty_diagnostics::Span> span, const Effects effects = Effects::Unknown
     ) :
         _span(std::move(span)), _arguments(std::move(arguments)), _name(std::move(name)),
-        _result(std::move(result)) { }
+        _result(std::move(result)), _effects(effects) { }
 
     /**
      * @brief Accepts a visitor to process this `Call` instruction.
@@ -195,16 +207,16 @@ public:
     /**
      * @brief Returns the result variable defined by the call.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the argument operands used by the call.
      *
-     * @return A vector of `_arguments`.
+     * @return A list of `_arguments`.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return _arguments; }
+    [[nodiscard]] OperandList uses() const { return _arguments; }
 
     /**
      * @brief Checks if the call is constant.
@@ -246,11 +258,26 @@ public:
      */
     [[nodiscard]] auto& name() const { return _name; }
 
+    /**
+     * @brief Returns what is known about the callee.
+     *
+     * @return The effects of the callee.
+     */
+    [[nodiscard]] Effects effects() const { return _effects; }
+
+    /**
+     * @brief Sets what is known about the callee.
+     *
+     * @param effects The new effects of the callee.
+     */
+    void set_effects(const Effects effects) { _effects = effects; }
+
 private:
     std::optional<pretty_diagnostics::Span> _span;
     std::vector<Operand> _arguments;
     std::string _name;
     Variable _result;
+    Effects _effects;
 };
 
 /**
@@ -279,17 +306,17 @@ public:
     /**
      * @brief Returns the result variable defined by the call.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
     // ReSharper disable once CppMemberFunctionMayBeStatic
-    [[nodiscard]] std::vector<Operand> defs() const { return { }; }
+    [[nodiscard]] OperandList defs() const { return { }; }
 
     /**
      * @brief Returns the operand used for the return value.
      *
-     * @return A vector containing the `_value` operand.
+     * @return A list containing the `_value` operand.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _value }; }
+    [[nodiscard]] OperandList uses() const { return { _value }; }
 
     /**
      * @brief Checks if the return is constant.
@@ -341,6 +368,8 @@ public:
         LessEqual,    ///< '<='
         Equal,        ///< '=='
         NotEqual,     ///< '!='
+        Shl,          ///< '<<', only with an immediate shift amount
+        Shr,          ///< '>>', arithmetic for signed types, only with an immediate shift amount
     };
 
 public:
@@ -371,16 +400,16 @@ public:
     /**
      * @brief Returns the result variable defined by this operation.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the operands used by this operation.
      *
-     * @return A vector containing the `_left` and `_right` operands.
+     * @return A list containing the `_left` and `_right` operands.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _left, _right }; }
+    [[nodiscard]] OperandList uses() const { return { _left, _right }; }
 
     /**
      * @brief Checks if both operands are immediate constants.
@@ -437,6 +466,16 @@ public:
      */
     [[nodiscard]] auto& op() const { return _op; }
 
+    /**
+     * @brief Checks if the operation may trap, which is only the case for integer divisions.
+     *
+     * Floating point divisions never trap, integer ones only with a divisor that isn't known
+     * to be neither zero nor minus one.
+     *
+     * @return True if executing the operation may trap.
+     */
+    [[nodiscard]] bool may_trap() const;
+
     /**
      * @brief Converts an AST binary operator to its IL equivalent.
      *
@@ -480,16 +519,16 @@ public:
     /**
      * @brief Returns the result variable defined by the cast.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the source operand used for the cast.
      *
-     * @return A vector containing the `_source` operand.
+     * @return A list containing the `_source` operand.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _source }; }
+    [[nodiscard]] OperandList uses() const { return { _source }; }
 
     /**
      * @brief Checks if the source operand is an immediate constant.
@@ -563,17 +602,17 @@ public:
     /**
      * @brief Returns the memory location defined by the allocation.
      *
-     * @return A vector containing the `_result` memory operand.
+     * @return A list containing the `_result` memory operand.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the argument operands used by the call.
      *
-     * @return A vector of `_arguments`.
+     * @return A list of `_arguments`.
      */
     // ReSharper disable once CppMemberFunctionMayBeStatic
-    [[nodiscard]] std::vector<Operand> uses() const { return { }; }
+    [[nodiscard]] OperandList uses() const { return { }; }
 
     /**
      * @brief Checks if the allocation is constant.
@@ -633,16 +672,16 @@ public:
     /**
      * @brief Returns the result variable defined by the load.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the memory location used by the load.
      *
-     * @return A vector containing the `_source` memory operand.
+     * @return A list containing the `_source` memory operand.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _source }; }
+    [[nodiscard]] OperandList uses() const { return { _source }; }
 
     /**
      * @brief Checks if the load is constant.
@@ -710,18 +749,18 @@ public:
     /**
      * @brief Returns the result variable defined by the call.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the operands used for the store.
      *
      * Note: the target memory location is often considered a 'use' of the address.
      *
-     * @return A vector containing the `_source` operand.
+     * @return A list containing the `_source` operand.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _source }; }
+    [[nodiscard]] OperandList uses() const { return { _source }; }
 
     /**
      * @brief Checks if the store is constant.
@@ -796,16 +835,16 @@ public:
     /**
      * @brief Returns the result variable defined by this instruction.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the source operand used by this instruction.
      *
-     * @return A vector containing the `_source` operand.
+     * @return A list containing the `_source` operand.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _source }; }
+    [[nodiscard]] OperandList uses() const { return { _source }; }
 
     /**
      * @brief Returns the result operand.
@@ -838,16 +877,19 @@ private:
 class Phi final {
 public:
     /**
-     * @brief Maps each predecessor basic block label to its corresponding incoming operand.
+     * @brief Pairs each predecessor basic block with its corresponding incoming variable.
+     *
+     * A phi has exactly one entry per predecessor, thus a flat vector is both smaller
+     * and faster to walk than a hashed map. The entries keep their insertion order.
      */
-    using Incoming = std::unordered_map<std::string, Variable>;
+    using Incoming = std::vector<std::pair<BasicBlock*, Variable>>;
 
 public:
     /**
      * @brief Constructs a `Phi` instruction.
      *
      * @param result The variable where the selected value will be stored.
-     * @param incoming A map from basic block labels to operands.
+     * @param incoming The predecessor blocks paired with their incoming variables.
      * @param span An optional source span for diagnostic purposes.
      */
     Phi(Variable result, Incoming incoming, std::optional<pretty_diagnostics::Span> span) :
@@ -878,16 +920,16 @@ public:
     /**
      * @brief Returns the result variable defined by this instruction.
      *
-     * @return A vector containing the `_result` variable.
+     * @return A list containing the `_result` variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the set of operands used as incoming values.
      *
-     * @return A vector containing all operands from the `_incoming` map.
+     * @return A list containing all operands from the `_incoming` map.
      */
-    [[nodiscard]] std::vector<Operand> uses() const {
+    [[nodiscard]] OperandList uses() const {
         auto values = _incoming | std::views::values;
         return { values.begin(), values.end() };
     }
@@ -906,6 +948,41 @@ public:
      */
     [[nodiscard]] auto& incoming() { return _incoming; }
 
+    /**
+     * @brief Returns the variable incoming from the given predecessor.
+     *
+     * @param predecessor The predecessor block to look up.
+     * @return A pointer to the variable, or `nullptr` if there is no such edge.
+     */
+    [[nodiscard]] Variable* incoming_from(const BasicBlock* predecessor);
+
+    /**
+     * @brief Sets the variable incoming from the given predecessor, replacing an existing entry.
+     *
+     * @param predecessor The predecessor block of the edge.
+     * @param value The variable flowing along the edge.
+     */
+    void set_incoming(BasicBlock* predecessor, Variable value);
+
+    /**
+     * @brief Redirects the edge of @p from to the block @p to.
+     *
+     * Used by CFG transformations that remove or merge a predecessor block.
+     *
+     * @param from The predecessor that is being replaced.
+     * @param to The block that now reaches the phi instead.
+     * @return True if an edge was redirected.
+     */
+    bool replace_predecessor(const BasicBlock* from, BasicBlock* to);
+
+    /**
+     * @brief Removes the edge of the given predecessor.
+     *
+     * @param predecessor The predecessor whose edge should be removed.
+     * @return The variable of the removed edge, or `std::nullopt` if there was none.
+     */
+    std::optional<Variable> remove_incoming(const BasicBlock* predecessor);
+
 private:
     std::optional<pretty_diagnostics::Span> _span;
     Incoming _incoming;
@@ -949,16 +1026,16 @@ public:
     /**
      * @brief Returns the SSA variable defined by this instruction.
      *
-     * @return A vector containing the result variable.
+     * @return A list containing the result variable.
      */
-    [[nodiscard]] std::vector<Operand> defs() const { return { _result }; }
+    [[nodiscard]] OperandList defs() const { return { _result }; }
 
     /**
      * @brief Returns the operand used by this instruction.
      *
-     * @return A vector containing the assigned value.
+     * @return A list containing the assigned value.
      */
-    [[nodiscard]] std::vector<Operand> uses() const { return { _value }; }
+    [[nodiscard]] OperandList uses() const { return { _value }; }
 
     /**
      * @brief Returns the result variable.
@@ -983,6 +1060,104 @@ private:
     Operand _value;
 };
 
+/**
+ * @brief Represents a choice between two values depending on a condition.
+ *
+ * If the condition evaluates to true, the result is `true_value`, otherwise
+ * it is `false_value`. Both values are always evaluated, thus this is used to
+ * replace small branches by straight-line code (see `opt::IfConversion`).
+ */
+class Select final {
+public:
+    /**
+     * @brief Constructs a `Select` instruction.
+     *
+     * @param result The variable to store the selected value.
+     * @param condition The operand to evaluate as a boolean.
+     * @param true_value The value selected if the condition is true.
+     * @param false_value The value selected if the condition is false.
+     * @param span The source location of this instruction.
+     */
+    Select(
+        Variable result, Operand condition, Operand true_value, Operand false_value,
+        std::optional<pretty_diagnostics::Span> span
+    ) :
+        _span(std::move(span)), _result(std::move(result)), _condition(std::move(condition)),
+        _true_value(std::move(true_value)), _false_value(std::move(false_value)) { }
+
+    /**
+     * @brief Accepts a visitor to process this `Select` instruction.
+     *
+     * @param visitor The visitor to accept.
+     */
+    void accept(Visitor& visitor) { visitor.visit(*this); }
+
+    /**
+     * @brief Returns the result variable defined by this instruction.
+     *
+     * @return A list containing the `_result` variable.
+     */
+    [[nodiscard]] OperandList defs() const { return { _result }; }
+
+    /**
+     * @brief Returns the operands used by this instruction.
+     *
+     * @return A list containing the `_condition`, `_true_value` and `_false_value` operands.
+     */
+    [[nodiscard]] OperandList uses() const { return { _condition, _true_value, _false_value }; }
+
+    /**
+     * @brief Checks if the condition is an immediate constant.
+     *
+     * @return True if `_condition` is an `Immediate`.
+     */
+    [[nodiscard]] bool is_constant() const { return std::holds_alternative<Immediate>(_condition); }
+
+    /**
+     * @brief Returns the optional source code span associated with this instruction.
+     *
+     * The span includes the starting and ending positions in the source file.
+     * There may be no span attached to this instruction, so this could also be
+     * std::nullopt.
+     *
+     * @return The optional `pretty_diagnostics::Span` of the node.
+     */
+    [[nodiscard]] std::optional<pretty_diagnostics::Span> span() const { return _span; }
+
+    /**
+     * @brief Returns the condition operand.
+     *
+     * @return A reference to the `_condition` operand.
+     */
+    [[nodiscard]] auto& condition() { return _condition; }
+
+    /**
+     * @brief Returns the value selected if the condition is true.
+     *
+     * @return A reference to the `_true_value` operand.
+     */
+    [[nodiscard]] auto& true_value() { return _true_value; }
+
+    /**
+     * @brief Returns the value selected if the condition is false.
+     *
+     * @return A reference to the `_false_value` operand.
+     */
+    [[nodiscard]] auto& false_value() { return _false_value; }
+
+    /**
+     * @brief Returns the result variable.
+     *
+     * @return A constant reference to the `_result` variable.
+     */
+    [[nodiscard]] auto& result() const { return _result; }
+
+private:
+    std::optional<pretty_diagnostics::Span> _span;
+    Variable _result;
+    Operand _condition, _true_value, _false_value;
+};
+
 /**
  * @brief A container for any IL instruction, implemented as a `std::variant`.
  *
@@ -993,7 +1168,7 @@ private:
 struct Instruction final : std::variant<
         Goto, If, Cast, Call, Return,
         Binary, Alloca, Store, Load,
-        Argument, Phi, Assign
+        Argument, Phi, Assign, Select
     > {
     using variant::variant;
 
@@ -1005,12 +1180,24 @@ struct Instruction final : std::variant<
     /**
      * @brief Forwards the `defs` call to the underlying instruction.
      */
-    [[nodiscard]] std::vector<Operand> defs() const;
+    [[nodiscard]] OperandList defs() const;
 
     /**
      * @brief Forwards the `uses` call to the underlying instruction.
      */
-    [[nodiscard]] std::vector<Operand> uses() const;
+    [[nodiscard]] OperandList uses() const;
+
+    /**
+     * @brief Replaces every use of @p from with @p to in place.
+     *
+     * Incoming values of a `Phi` can only be replaced by another variable, an
+     * immediate @p to leaves them untouched.
+     *
+     * @param from The variable whose uses should be replaced.
+     * @param to The operand replacing the uses.
+     * @return True if at least one use was replaced, false otherwise.
+     */
+    bool replace_uses(const Variable& from, const Operand& to);
 
     /**
      * @brief Forwards the `is_constant` call to the underlying instruction.
@@ -1031,6 +1218,15 @@ struct Instruction final : std::variant<
  * @return A reference to the output stream @p os
  */
 std::ostream& operator<<(std::ostream& os, const Binary::Operator& op);
+
+/**
+ * @brief Appends the textual representation of `Binary::Operator` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param op The binary operator to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Binary::Operator& op);
 } // namespace arkoi::il
 
 //==============================================================================
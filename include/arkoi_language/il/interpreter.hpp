@@ -0,0 +1,122 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief Executes the functions of a module on constant arguments.
+ *
+ * The instructions are evaluated with the same semantics as `opt::ConstantFolding`, thus integer
+ * arithmetic wraps around and every operation that would trap at runtime, e.g. a division by zero,
+ * aborts the evaluation. Calls to functions of the module are executed as well, calls to any other
+ * function abort it, as their code is unknown.
+ *
+ * Every executed instruction takes one step of the fuel, which is shared by all nested calls. Once it's
+ * used up the evaluation is aborted, which keeps loops that never terminate from stalling the compiler.
+ * Besides evaluating calls at compile time, this also serves as a reference for the semantics of the IL.
+ *
+ * @see opt::CTFE, opt::ConstantFolding
+ */
+class Interpreter {
+public:
+    /** @brief The default amount of instructions executed by a single `call`. */
+    static constexpr size_t DEFAULT_FUEL = 1'000'000;
+
+    /** @brief The maximum nesting of calls, deeper recursions are aborted. */
+    static constexpr size_t MAX_DEPTH = 512;
+
+public:
+    /**
+     * @brief Constructs an interpreter for the functions of @p module.
+     *
+     * @param module The module whose functions are executed, which must outlive the interpreter.
+     * @param fuel The amount of instructions a single `call` may execute.
+     */
+    explicit Interpreter(Module& module, size_t fuel = DEFAULT_FUEL);
+
+    /**
+     * @brief Calls the function @p name with the given arguments.
+     *
+     * @param name The name of the function.
+     * @param arguments The arguments, which are converted to the types of the parameters.
+     * @return The returned value, or std::nullopt if the call couldn't be evaluated.
+     */
+    [[nodiscard]] std::optional<Immediate> call(const std::string& name, const std::vector<Immediate>& arguments);
+
+    /**
+     * @brief Returns the amount of instructions executed by the last `call`.
+     *
+     * @return The amount of steps.
+     */
+    [[nodiscard]] auto steps() const { return _steps; }
+
+private:
+    /**
+     * @brief The values of the variables and stack slots of a single call.
+     */
+    struct Frame {
+        std::unordered_map<Variable, Immediate> variables{ };
+        std::map<Memory, Immediate> memory{ };
+    };
+
+    /**
+     * @brief Executes @p function until it returns.
+     */
+    [[nodiscard]] std::optional<Immediate> _run(
+        Function& function, const std::vector<Immediate>& arguments, size_t depth
+    );
+
+    /**
+     * @brief Executes a single instruction that doesn't change the control flow.
+     *
+     * @return False if the instruction couldn't be evaluated.
+     */
+    [[nodiscard]] bool _execute(Frame& frame, Instruction& instruction, size_t depth);
+
+    /**
+     * @brief Returns the value of an operand, or std::nullopt if it was never assigned.
+     */
+    [[nodiscard]] static std::optional<Immediate> _value(const Frame& frame, const Operand& operand);
+
+private:
+    std::unordered_map<std::string, Function*> _functions{ };
+    size_t _fuel, _steps{ };
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,16 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <variant>
+#include <vector>
 
 #include "arkoi_language/sem/type.hpp"
+#include "arkoi_language/utils/interner.hpp"
+#include "arkoi_language/utils/output_buffer.hpp"
 
 namespace arkoi::il {
 /**
  * @brief Represents a memory location on the stack.
  *
  * `Memory` operands are used by `Alloca`, `Load`, and `Store` instructions.
- * They are identified by an index/version.
+ * They are identified by their interned name.
  */
 class Memory final {
 public:
@@ -20,8 +27,17 @@ public:
      * @param name The unique name of the memory slot.
      * @param type The type of data stored at this memory location.
      */
-    Memory(std::string name, sem::Type type) :
-        _name(std::move(name)), _type(std::move(type)) { }
+    Memory(const std::string_view name, sem::Type type) :
+        _name(name), _type(std::move(type)) { }
+
+    /**
+     * @brief Constructs a `Memory` operand from an already interned name.
+     *
+     * @param name The interned name of the memory slot.
+     * @param type The type of data stored at this memory location.
+     */
+    Memory(const utils::Interned name, sem::Type type) :
+        _name(name), _type(std::move(type)) { }
 
     /**
      * @brief Compares two memory locations for ordering.
@@ -62,10 +78,17 @@ public:
      *
      * @return A reference to the `std::string` name.
      */
-    [[nodiscard]] auto& name() const { return _name; }
+    [[nodiscard]] auto& name() const { return _name.str(); }
+
+    /**
+     * @brief Returns the interned name, which is cheap to hash and compare.
+     *
+     * @return The `utils::Interned` handle of the name.
+     */
+    [[nodiscard]] auto symbol() const { return _name; }
 
 private:
-    std::string _name;
+    utils::Interned _name;
     sem::Type _type;
 };
 
@@ -75,6 +98,9 @@ private:
  * Variables in Arkoi IL follow Static Single Assignment (SSA) form principles,
  * though the `version` field explicitly tracks different assignments to the
  * same original source-level variable.
+ *
+ * The name is interned, thus hashing and comparing variables only involves
+ * integers, while the characters are kept in a side table for printing.
  */
 class Variable final {
 public:
@@ -85,8 +111,18 @@ public:
      * @param type The semantic type of the variable.
      * @param version The SSA version of the variable (defaults to 0).
      */
-    Variable(std::string name, sem::Type type, const size_t version = 0) :
-        _name(std::move(name)), _version(version), _type(std::move(type)) { }
+    Variable(const std::string_view name, sem::Type type, const size_t version = 0) :
+        _name(name), _version(version), _type(std::move(type)) { }
+
+    /**
+     * @brief Constructs a `Variable` operand from an already interned name.
+     *
+     * @param name The interned source-level name of the variable.
+     * @param type The semantic type of the variable.
+     * @param version The SSA version of the variable (defaults to 0).
+     */
+    Variable(const utils::Interned name, sem::Type type, const size_t version = 0) :
+        _name(name), _version(version), _type(std::move(type)) { }
 
     /**
      * @brief Compares two variables for ordering (name then version).
@@ -141,10 +177,17 @@ public:
      *
      * @return A constant reference to the name string.
      */
-    [[nodiscard]] auto& name() const { return _name; }
+    [[nodiscard]] auto& name() const { return _name.str(); }
+
+    /**
+     * @brief Returns the interned name, which is cheap to hash and compare.
+     *
+     * @return The `utils::Interned` handle of the name.
+     */
+    [[nodiscard]] auto symbol() const { return _name; }
 
 private:
-    std::string _name;
+    utils::Interned _name;
     size_t _version;
     sem::Type _type;
 };
@@ -183,6 +226,74 @@ struct Operand final : std::variant<Immediate, Variable, Memory> {
     [[nodiscard]] sem::Type type() const;
 };
 
+/**
+ * @brief The operands defined or used by an instruction, as returned by `defs` and `uses`.
+ *
+ * Up to `INLINE_CAPACITY` operands are stored inline, thus only calls and phis with more values
+ * allocate. This keeps the innermost loops of the analyses, which query every instruction, free
+ * of heap allocations.
+ */
+class OperandList {
+public:
+    /// Enough for every instruction besides calls and phis, a `Select` uses the most with three.
+    static constexpr size_t INLINE_CAPACITY = 3;
+
+    using value_type = Operand;
+    using const_iterator = const Operand*;
+    using iterator = const_iterator;
+
+public:
+    OperandList() = default;
+
+    /**
+     * @brief Constructs the list from the given operands.
+     */
+    OperandList(const std::initializer_list<Operand> operands) :
+        OperandList(operands.begin(), operands.end()) { }
+
+    /**
+     * @brief Constructs the list from the operands of a vector, e.g. the arguments of a call.
+     */
+    OperandList(const std::vector<Operand>& operands) :
+        OperandList(operands.begin(), operands.end()) { }
+
+    /**
+     * @brief Constructs the list from a range of values convertible to `Operand`.
+     */
+    template <std::forward_iterator Iterator>
+    OperandList(Iterator first, Iterator last);
+
+    [[nodiscard]] const Operand* data() const { return _size > INLINE_CAPACITY ? _heap.data() : _inline.data(); }
+
+    [[nodiscard]] const_iterator begin() const { return data(); }
+
+    [[nodiscard]] const_iterator end() const { return data() + _size; }
+
+    [[nodiscard]] size_t size() const { return _size; }
+
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    [[nodiscard]] const Operand& operator[](const size_t index) const { return data()[index]; }
+
+    [[nodiscard]] const Operand& front() const { return data()[0]; }
+
+private:
+    std::array<Operand, INLINE_CAPACITY> _inline{ };
+    std::vector<Operand> _heap{ };
+    size_t _size{ };
+};
+
+template <std::forward_iterator Iterator>
+OperandList::OperandList(Iterator first, Iterator last) :
+    _size(static_cast<size_t>(std::distance(first, last))) {
+    if (_size > INLINE_CAPACITY) {
+        _heap.assign(first, last);
+        return;
+    }
+
+    std::copy(first, last, _inline.begin());
+}
+
 /**
  * @brief Streams a detailed description of a `Immediate`.
  *
@@ -192,6 +303,15 @@ struct Operand final : std::variant<Immediate, Variable, Memory> {
  */
 std::ostream& operator<<(std::ostream& os, const Immediate& operand);
 
+/**
+ * @brief Appends the textual representation of `Immediate` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param operand The immediate to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Immediate& operand);
+
 /**
  * @brief Streams a detailed description of a `Variable`.
  *
@@ -201,6 +321,15 @@ std::ostream& operator<<(std::ostream& os, const Immediate& operand);
  */
 std::ostream& operator<<(std::ostream& os, const Variable& operand);
 
+/**
+ * @brief Appends the textual representation of `Variable` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param operand The variable to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Variable& operand);
+
 /**
  * @brief Streams a detailed description of a `Memory`.
  *
@@ -210,6 +339,15 @@ std::ostream& operator<<(std::ostream& os, const Variable& operand);
  */
 std::ostream& operator<<(std::ostream& os, const Memory& operand);
 
+/**
+ * @brief Appends the textual representation of `Memory` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param operand The memory to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Memory& operand);
+
 /**
  * @brief Streams a detailed description of a `Operand`.
  *
@@ -218,6 +356,15 @@ std::ostream& operator<<(std::ostream& os, const Memory& operand);
  * @return A reference to the output stream @p os
  */
 std::ostream& operator<<(std::ostream& os, const Operand& operand);
+
+/**
+ * @brief Appends the textual representation of `Operand` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param operand The operand to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Operand& operand);
 } // namespace arkoi::il
 
 namespace std {
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/il/cfg.hpp"
+#include "arkoi_language/il/operand.hpp"
+#include "arkoi_language/utils/bit_vector.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief A dense numbering of all non-immediate operands of a function.
+ *
+ * Every `Variable` and `Memory` operand gets a small index in the order in
+ * which it first appears in the function. This index is the bit position
+ * used by `OperandSet`.
+ *
+ * @see OperandSet
+ */
+class OperandIndex {
+public:
+    OperandIndex() = default;
+
+    /**
+     * @brief Numbers the parameters and every defined or used operand of @p function.
+     *
+     * @param function The function to number the operands of.
+     */
+    explicit OperandIndex(Function& function);
+
+    /**
+     * @brief Adds an operand to the index, if it is not already part of it.
+     *
+     * @param operand The operand to add.
+     * @return The index of the operand.
+     */
+    size_t insert(const Operand& operand);
+
+    /**
+     * @brief Looks up the index of an operand.
+     *
+     * @param operand The operand to look up.
+     * @return The index, or `std::nullopt` if the operand is not numbered.
+     */
+    [[nodiscard]] std::optional<size_t> find(const Operand& operand) const;
+
+    /**
+     * @brief Returns the operand with the given index.
+     *
+     * @param index The index of the operand.
+     * @return A constant reference to the operand.
+     */
+    [[nodiscard]] auto& operator[](const size_t index) const { return _operands[index]; }
+
+    /**
+     * @brief Returns the amount of numbered operands.
+     *
+     * @return The size of the index.
+     */
+    [[nodiscard]] size_t size() const { return _operands.size(); }
+
+private:
+    std::unordered_map<Operand, size_t> _indices{ };
+    std::vector<Operand> _operands{ };
+};
+
+/**
+ * @brief A set of operands represented as a bit vector over an `OperandIndex`.
+ *
+ * This is the dense state representation for dataflow analyses whose domain
+ * are the operands of a single function. Union, difference and equality
+ * are word-parallel instead of hashing every element. Iteration yields the
+ * operands in index order.
+ *
+ * A default constructed set has no index. It behaves like an empty set and
+ * adopts the index of the first set merged into it.
+ *
+ * @see OperandIndex, DataflowPass
+ */
+class OperandSet {
+public:
+    /**
+     * @brief Iterates over the operands contained in the set.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = Operand;
+
+        const_iterator() = default;
+
+        const_iterator(utils::BitVector::const_iterator bit, const OperandIndex* index) :
+            _bit(bit), _index(index) { }
+
+        const Operand& operator*() const { return (*_index)[*_bit]; }
+
+        const Operand* operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            ++_bit;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto copy = *this;
+            ++_bit;
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const { return _bit == other._bit; }
+
+    private:
+        utils::BitVector::const_iterator _bit{ };
+        const OperandIndex* _index{ };
+    };
+
+    using value_type = Operand;
+    using iterator = const_iterator;
+
+public:
+    OperandSet() = default;
+
+    /**
+     * @brief Constructs an empty set over the given index.
+     *
+     * @param index The index numbering the operands. Must outlive the set.
+     */
+    explicit OperandSet(const OperandIndex& index) :
+        _bits(index.size()), _index(&index) { }
+
+    /**
+     * @brief Inserts an operand into the set.
+     *
+     * @param operand The operand to insert, which must be part of the index.
+     * @return True if the operand was not contained before.
+     */
+    bool insert(const Operand& operand);
+
+    /**
+     * @brief Erases an operand from the set.
+     *
+     * @param operand The operand to erase.
+     * @return True if the operand was contained before.
+     */
+    bool erase(const Operand& operand);
+
+    /**
+     * @brief Checks if the set contains an operand.
+     *
+     * @param operand The operand to check.
+     * @return True if the operand is part of the set.
+     */
+    [[nodiscard]] bool contains(const Operand& operand) const;
+
+    /**
+     * @brief Adds all operands of @p other to this set.
+     *
+     * @param other The set to merge into this one.
+     * @return A reference to this set.
+     */
+    OperandSet& operator|=(const OperandSet& other);
+
+    /**
+     * @brief Removes all operands of @p other from this set.
+     *
+     * @param other The operands to remove.
+     * @return A reference to this set.
+     */
+    OperandSet& operator-=(const OperandSet& other);
+
+    /**
+     * @brief Checks if both sets contain the same operands.
+     *
+     * @param other Right-hand set, which must share the same index.
+     * @return True if both sets are equal.
+     */
+    bool operator==(const OperandSet& other) const { return _bits == other._bits; }
+
+    /**
+     * @brief Returns the amount of operands in the set.
+     *
+     * @return The size of the set.
+     */
+    [[nodiscard]] size_t size() const { return _bits.count(); }
+
+    /**
+     * @brief Checks if the set is empty.
+     *
+     * @return True if no operand is contained.
+     */
+    [[nodiscard]] bool empty() const { return _bits.none(); }
+
+    /**
+     * @brief Returns the underlying bit vector.
+     *
+     * @return A constant reference to the bits, indexed by the `OperandIndex`.
+     */
+    [[nodiscard]] auto& bits() const { return _bits; }
+
+    const_iterator begin() const { return { _bits.begin(), _index }; }
+
+    const_iterator end() const { return { _bits.end(), _index }; }
+
+private:
+    utils::BitVector _bits{ };
+    const OperandIndex* _index{ };
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
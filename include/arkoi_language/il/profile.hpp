@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief The block execution counts written by a program compiled with instrumentation.
+ *
+ * The instrumented program counts every execution of a block and writes the counters on exit,
+ * each as a pair of 64-bit values: the `key` of the block and its count. A block is identified
+ * by its function and its label, which the IL generator assigns before any optimization. Thus
+ * the counts are found again when the same source is compiled with the profile, independent of
+ * the decisions the optimizations take based on them. Blocks created by the optimizations carry
+ * no count, the consumers fall back to their static estimates for them.
+ *
+ * @see BasicBlock::count, x86_64::Generator::instrument
+ */
+class Profile {
+public:
+    /**
+     * @brief Loads a profile written by an instrumented program.
+     *
+     * @param path The path of the profile.
+     * @return The profile, or std::nullopt if it can't be read or isn't made up of whole counters.
+     */
+    [[nodiscard]] static std::optional<Profile> load(const std::string& path);
+
+    /**
+     * @brief Returns the key identifying a block in the profile, which is a 64-bit FNV-1a hash.
+     *
+     * @param function The name of the function.
+     * @param label The label of the block.
+     * @return The key of the block.
+     */
+    [[nodiscard]] static uint64_t key(std::string_view function, std::string_view label);
+
+    /**
+     * @brief Adds the count of a block, counts of the same block are summed.
+     *
+     * @param key The key of the block.
+     * @param count The amount of times the block was executed.
+     */
+    void add(uint64_t key, uint64_t count);
+
+    /**
+     * @brief Returns the count of a block.
+     *
+     * @param function The name of the function.
+     * @param label The label of the block.
+     * @return The count, or std::nullopt if the block isn't part of the profile.
+     */
+    [[nodiscard]] std::optional<uint64_t> count(std::string_view function, std::string_view label) const;
+
+    /**
+     * @brief Sets the count of every block of @p function that is part of the profile.
+     *
+     * @param function The function to annotate.
+     */
+    void annotate(Function& function) const;
+
+    /**
+     * @brief Returns a checksum of all counts, which tells compilations with different profiles apart.
+     *
+     * @return The checksum, independent of the order the counts were added in.
+     */
+    [[nodiscard]] uint64_t checksum() const;
+
+    /**
+     * @brief Returns the amount of blocks in the profile.
+     */
+    [[nodiscard]] size_t size() const { return _counts.size(); }
+
+private:
+    std::unordered_map<uint64_t, uint64_t> _counts{ };
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+#include "arkoi_language/il/cfg.hpp"
+#include "pretty_diagnostics/source.hpp"
+
+namespace arkoi::il {
+/**
+ * @brief Reads and writes modules in a compact binary format.
+ *
+ * The format starts with a magic and its version, followed by a table of every name used by
+ * the module, e.g. the names of functions, blocks, variables and callees. Thus each name is
+ * stored once and afterward only referenced by its index. The functions follow as a stream of
+ * blocks and instructions, in which every integer is a LEB128 varint (signed ones are zigzag
+ * encoded first) and every floating point value is stored with its little-endian bits.
+ *
+ * Only the blocks reachable from the entry and the exit are written, in the order they are
+ * iterated. As the edges are restored as well, a module read back prints exactly like the
+ * written one. Spans are stored as their locations in the source, which isn't part of the
+ * format, thus they are only restored if the source is passed to the reader.
+ *
+ * The reader works directly on a range of bytes, thus a file can be mapped into memory and
+ * read without copying it first. Every read is checked against the end of the input, which
+ * results in std::nullopt for a truncated or malformed input instead of a partial module.
+ *
+ * @see ILPrinter
+ */
+class Serializer {
+public:
+    /** @brief The version of the format, every incompatible change increases it. */
+    static constexpr uint8_t VERSION = 1;
+
+public:
+    /**
+     * @brief Writes all functions of @p module.
+     *
+     * @param module The module to serialize.
+     * @param output The stream the module is written to.
+     */
+    static void write(Module& module, std::ostream& output);
+
+    /**
+     * @brief Writes a module consisting of @p function only.
+     *
+     * @param function The function to serialize.
+     * @param output The stream the module is written to.
+     */
+    static void write(Function& function, std::ostream& output);
+
+    /**
+     * @brief Reads a module written by `write`.
+     *
+     * @param input The bytes of the serialized module.
+     * @param source The source the module was generated from, which restores the spans.
+     * @return The module, or std::nullopt if the input is truncated or malformed.
+     */
+    [[nodiscard]] static std::optional<Module> read(
+        std::string_view input, const std::shared_ptr<pretty_diagnostics::Source>& source = nullptr
+    );
+
+    /**
+     * @brief Maps the file at @p path into memory and reads the module stored in it.
+     *
+     * @param path The file written by `write`.
+     * @param source The source the module was generated from, which restores the spans.
+     * @return The module, or std::nullopt if the file can't be mapped or is malformed.
+     */
+    [[nodiscard]] static std::optional<Module> load(
+        const std::filesystem::path& path, const std::shared_ptr<pretty_diagnostics::Source>& source = nullptr
+    );
+};
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,39 +1,69 @@
 #pragma once
 
+#include <set>
 #include <stack>
 
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/il/analysis_manager.hpp"
 #include "arkoi_language/il/cfg.hpp"
 
 namespace arkoi::il {
 class SSAPromoter {
 public:
-    explicit SSAPromoter(Function& function);
+    SSAPromoter(Function& function, AnalysisManager& analyses);
 
     void promote();
 
+    [[nodiscard]] auto& candidates() const { return _candidates; }
+
+    [[nodiscard]] size_t inserted_phis() const { return _inserted_phis; }
+
 private:
-    [[nodiscard]] std::set<std::string> _collect_candidates() const;
+    [[nodiscard]] std::set<utils::Interned> _collect_candidates() const;
 
-    void _place_phi_nodes(const std::string& candidate) const;
+    [[nodiscard]] size_t _place_phi_nodes(utils::Interned candidate) const;
 
     void _rename(BasicBlock* block, std::unordered_set<BasicBlock*>& visited);
 
 private:
-    std::unordered_map<BasicBlock*, std::vector<BasicBlock*>> _children{ };
-    std::unordered_map<std::string, std::stack<size_t>> _stacks{ };
-    std::unordered_map<std::string, size_t> _counters{ };
-    DominatorTree::Frontiers _frontiers{ };
-    std::set<std::string> _candidates{ };
+    std::unordered_map<utils::Interned, std::stack<size_t>> _stacks{ };
+    std::unordered_map<utils::Interned, size_t> _counters{ };
+    std::set<utils::Interned> _candidates{ };
+    size_t _inserted_phis{ };
+    const DominanceAnalysis& _dominance;
+    AnalysisManager& _analyses;
     Function& _function;
 };
 
+/**
+ * @brief Translates out of SSA by replacing the phis with copies in their predecessors.
+ *
+ * Edges from a block with two successors into a block with phis are split first,
+ * thus the copies of an edge only run on that edge. The incoming values of all
+ * phis on the same edge are a parallel copy, which is sequentialized so no
+ * destination is overwritten before it was read. A cycle of copies costs one
+ * temporary. The remaining copies are coalesced away by the register allocator.
+ */
 class PhiLowerer {
 public:
     explicit PhiLowerer(Function& function);
 
-    void lower() const;
+    void lower();
+
+    [[nodiscard]] size_t split_edges() const { return _split_edges; }
+
+    [[nodiscard]] size_t copies() const { return _copies; }
+
+private:
+    /// A copy of the source on the right into the destination on the left.
+    using Copy = std::pair<Variable, Variable>;
+
+    void _split_critical_edges();
+
+    [[nodiscard]] std::vector<Instruction> _sequentialize(std::vector<Copy> copies);
 
 private:
+    size_t _split_edges{ }, _copies{ }, _temporaries{ };
     Function& _function;
 };
 }
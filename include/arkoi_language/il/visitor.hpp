@@ -9,6 +9,7 @@ class Binary;
 class Return;
 class Alloca;
 class Assign;
+class Select;
 class Store;
 class Load;
 class Cast;
@@ -134,6 +135,13 @@ public:
      * @param instruction The `Assign` instruction to visit.
      */
     virtual void visit(Assign& instruction) = 0;
+
+    /**
+     * @brief Visits a `Select` instruction.
+     *
+     * @param instruction The `Select` instruction to visit.
+     */
+    virtual void visit(Select& instruction) = 0;
 };
 } // namespace arkoi::il
 
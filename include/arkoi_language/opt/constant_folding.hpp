@@ -9,6 +9,7 @@ namespace arkoi::opt {
  * `ConstantFolding` identifies instructions where all operands are constant
  * (immediates) and replaces the instruction with a single `il::Constant`
  * assignment. This is a local optimization performed within basic blocks.
+ * The evaluation helpers are shared with `SCCP` and the `il::Interpreter`.
  *
  * Example: `x = 1 + 2` becomes `x = 3`.
  *
@@ -16,6 +17,21 @@ namespace arkoi::opt {
  */
 class ConstantFolding final : public Pass {
 public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "constant-folding"; }
+
+    /**
+     * @brief Folding rewrites casts and binary operations into constant assignments.
+     */
+    [[nodiscard]] Effects effects() const override { return FOLDED_CONSTANTS; }
+
+    /**
+     * @brief Only newly propagated immediates can make further instructions constant.
+     */
+    [[nodiscard]] Effects triggers() const override { return REPLACED_OPERANDS; }
+
     /**
      * @brief No-op for module entry.
      */
@@ -47,6 +63,32 @@ public:
      */
     bool on_block(il::BasicBlock& block) override;
 
+    /**
+     * @brief Converts a constant to the given type.
+     *
+     * @param to The target `sem::Type`.
+     * @param value The constant value to convert.
+     * @return The casted `il::Immediate`.
+     */
+    [[nodiscard]] static il::Immediate evaluate_cast(const sem::Type& to, const il::Immediate& value);
+
+    /**
+     * @brief Evaluates a binary operation on two constants.
+     *
+     * Both operands are converted to @p type first. Integer arithmetic wraps
+     * around like on the target, comparisons produce a boolean.
+     *
+     * @param op The operator to apply.
+     * @param type The type the operation is performed in.
+     * @param left The left constant.
+     * @param right The right constant.
+     * @return The resulting `il::Immediate`, or std::nullopt if the operation
+     *         can't be evaluated at compile time (e.g. a division by zero).
+     */
+    [[nodiscard]] static std::optional<il::Immediate> evaluate_binary(
+        il::Binary::Operator op, const sem::Type& type, const il::Immediate& left, const il::Immediate& right
+    );
+
 private:
     /**
      * @brief Evaluates an `il::Cast` instruction with a constant source.
@@ -56,6 +98,25 @@ private:
      */
     [[nodiscard]] static il::Immediate _cast(il::Cast& instruction);
 
+    /**
+     * @brief Evaluates an `il::Binary` instruction with constant operands.
+     *
+     * @param instruction The binary instruction to evaluate.
+     * @return The resulting `il::Immediate`, if it can be computed.
+     */
+    [[nodiscard]] static std::optional<il::Immediate> _binary(il::Binary& instruction);
+
+    /**
+     * @brief Applies an operator to two constants of the same C++ type.
+     *
+     * @param op The operator to apply.
+     * @param left The left constant.
+     * @param right The right constant.
+     * @return The resulting `il::Immediate`, if it can be computed.
+     */
+    template <typename Type>
+    [[nodiscard]] static std::optional<il::Immediate> _evaluate_binary(il::Binary::Operator op, Type left, Type right);
+
     /**
      * @brief Helper to perform the actual type conversion for a constant value.
      *
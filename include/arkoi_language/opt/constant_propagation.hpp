@@ -1,5 +1,6 @@
 #pragma once
 
+#include "arkoi_language/il/analyses.hpp"
 #include "arkoi_language/opt/pass.hpp"
 
 namespace arkoi::opt {
@@ -7,8 +8,9 @@ namespace arkoi::opt {
  * @brief Optimization pass that propagates constant values through the CFG.
  *
  * `ConstantPropagation` tracks variables that are assigned constant values and
- * replaces later uses of those variables with the constants themselves.
- * This is a local optimization performed within basic blocks.
+ * replaces all uses of those variables with the constants themselves. It follows
+ * the `il::DefUseChains` of the function, so only the instructions using a
+ * constant are touched, no matter in which block they are.
  *
  * Example:
  * `x = 5`
@@ -17,59 +19,56 @@ namespace arkoi::opt {
  * `x = 5`
  * `y = 5 + 1` (which `ConstantFolding` can then turn into `y = 6`)
  *
- * @see Pass, ConstantFolding
+ * @see Pass, ConstantFolding, il::DefUseChains
  */
 class ConstantPropagation final : public Pass {
 public:
     /**
-     * @brief No-op for module entry.
+     * @brief Identifies the pass in the time report.
      */
-    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+    [[nodiscard]] std::string_view name() const override { return "constant-propagation"; }
 
     /**
-     * @brief No-op for module exit.
+     * @brief Propagation replaces variables with immediates.
      */
-    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS; }
 
     /**
-     * @brief No-op for function entry.
+     * @brief Newly folded constants can be propagated further, as can constants that restructured
+     * blocks feed into fresh copies.
      */
-    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | CHANGED_BLOCKS; }
 
     /**
-     * @brief No-op for function exit.
+     * @brief No-op for module entry.
      */
-    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
 
     /**
-     * @brief Performs constant propagation on the instructions within a basic block.
+     * @brief Propagates all constants of the function using a worklist.
      *
-     * Maintains a local map of variables to their known constant values.
+     * Every constant assignment is queued once, and every copy turned into a
+     * constant assignment by the propagation is queued again.
      *
-     * @param block The `il::BasicBlock` to optimize.
+     * @param function The `il::Function` to optimize.
      * @return True if any operands were replaced with constants, false otherwise.
      */
-    bool on_block(il::BasicBlock& block) override;
+    bool enter_function(il::Function& function) override;
 
-private:
     /**
-     * @brief Attempts to propagate constants into the operands of an instruction.
-     *
-     * @param target The instruction to modify.
-     * @return True if the instruction was modified.
+     * @brief No-op for function exit.
      */
-    [[nodiscard]] bool _propagate(il::Instruction& target);
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
 
     /**
-     * @brief Replaces an operand with its known constant value if possible.
-     *
-     * @param operand The operand to potentially replace.
-     * @return True if the operand was replaced with an `il::Immediate`.
+     * @brief No-op for blocks, the propagation is done for the whole function.
      */
-    [[nodiscard]] bool _propagate(il::Operand& operand);
-
-private:
-    std::unordered_map<il::Operand, il::Immediate> _constants;
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
 };
 } // namespace arkoi::opt
 
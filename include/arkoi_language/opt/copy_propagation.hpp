@@ -1,13 +1,21 @@
 #pragma once
 
+#include <unordered_set>
+
+#include "arkoi_language/il/analyses.hpp"
 #include "arkoi_language/opt/pass.hpp"
 
 namespace arkoi::opt {
 /**
- * @brief Optimization pass that performs copy propagation within basic blocks.
+ * @brief Optimization pass that performs sparse copy propagation over the SSA form.
  *
  * `CopyPropagation` tracks variables that are assigned directly from other variables
- * and replaces later uses with the original source variable.
+ * and replaces all of their uses with the original source variable. It follows the
+ * `il::DefUseChains` of the function, so only the instructions using a copy are
+ * touched. Parameters are only propagated up to the next call, phi incoming values
+ * are left alone, and phi results whose lowered copies leak into other successors
+ * of their predecessors stay within their own block. Calls and the copies inserted
+ * by the `il::PhiLowerer` would clobber them otherwise.
  *
  * Example:
  * `$17.0 = $03.1`
@@ -16,10 +24,26 @@ namespace arkoi::opt {
  * becomes:
  * `$18.0 = $03.1`
  *
- * @see Pass, DeadCodeElimination
+ * @see Pass, DeadCodeElimination, il::DefUseChains
  */
 class CopyPropagation final : public Pass {
 public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "copy-propagation"; }
+
+    /**
+     * @brief Propagation replaces copies with their sources.
+     */
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS; }
+
+    /**
+     * @brief Copy chains are resolved in one run, but restructuring blocks (e.g. unrolling a
+     * loop) turns phis into fresh copies.
+     */
+    [[nodiscard]] Effects triggers() const override { return CHANGED_BLOCKS; }
+
     /**
      * @brief No-op for module entry.
      */
@@ -31,9 +55,15 @@ public:
     bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
 
     /**
-     * @brief No-op for function entry.
+     * @brief Propagates all copies of the function using a worklist.
+     *
+     * Every copy is queued once, and every instruction rewritten to a new copy
+     * is queued again, so chains of copies collapse in a single run.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if any operands were replaced, false otherwise.
      */
-    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+    bool enter_function(il::Function& function) override;
 
     /**
      * @brief No-op for function exit.
@@ -41,42 +71,32 @@ public:
     bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
 
     /**
-     * @brief Performs copy propagation on the instructions within a basic block.
-     *
-     * Replaces variables that are copies of others with the original source.
-     *
-     * @param block The `il::BasicBlock` to optimize.
-     * @return True if any operands were replaced, false otherwise.
+     * @brief No-op for blocks, the propagation is done for the whole function.
      */
-    bool on_block(il::BasicBlock& block) override;
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
 
 private:
     /**
-     * @brief Attempts to propagate copies into the operands of an instruction.
+     * @brief Collects the instructions following @p copy in its block up to the first argument or call.
      *
-     * @param target The instruction to modify.
-     * @return True if the instruction was modified.
+     * @param chains The def-use chains of the current function.
+     * @param copy The copy of a parameter.
+     * @return The instructions which can still read the parameter directly.
      */
-    [[nodiscard]] bool _propagate(il::Instruction& target);
+    [[nodiscard]] static std::unordered_set<const il::Instruction*> _call_free_suffix(
+        const il::DefUseChains& chains, const il::Instruction& copy
+    );
 
     /**
-     * @brief Replaces an operand with its original source if it was a copy.
+     * @brief Returns the block of a phi whose lowered copies are visible on other edges.
      *
-     * @param operand The operand to potentially replace.
-     * @return True if the operand was replaced.
+     * @param chains The def-use chains of the current function.
+     * @param definition The instruction defining the source of a copy.
+     * @return The block of the phi if one of its predecessors has a second successor, nullptr otherwise.
      */
-    [[nodiscard]] bool _propagate(il::Operand& operand);
-
-    /**
-     * @brief Replaces a variable with its original source if it was a copy.
-     *
-     * @param variable The variable to potentially replace.
-     * @return True if the variable was replaced.
-     */
-    [[nodiscard]] bool _propagate(il::Variable& variable);
-
-private:
-    std::unordered_map<il::Variable, il::Variable> _copy_map;
+    [[nodiscard]] static il::BasicBlock* _leaky_phi_block(
+        const il::DefUseChains& chains, const il::Instruction& definition
+    );
 };
 } // namespace arkoi::opt
 
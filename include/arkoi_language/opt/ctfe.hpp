@@ -0,0 +1,106 @@
+#pragma once
+
+#include "arkoi_language/il/interpreter.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Module-level optimization pass that evaluates calls with constant arguments at compile time.
+ *
+ * Every call to a function of the module without side effects, whose arguments are all constant,
+ * is executed by the `il::Interpreter`. If it returns within the fuel, the call is replaced by an
+ * assignment of its result, which the function-level passes then fold into its uses. Calls that
+ * trap, recurse too deep or run out of fuel are left for the program to execute.
+ *
+ * Example: `return fib(20)` becomes `return 6765`.
+ *
+ * @see Pass, il::Interpreter, il::EffectAnalysis, IPCP
+ */
+class CTFE final : public Pass {
+public:
+    /**
+     * @brief Constructs the pass with the amount of instructions a single call may execute.
+     *
+     * @param fuel The fuel of every evaluated call, see `il::Interpreter`.
+     */
+    explicit CTFE(const size_t fuel = il::Interpreter::DEFAULT_FUEL) :
+        _fuel(fuel) { }
+
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "ctfe"; }
+
+    /**
+     * @brief Calls become constant assignments.
+     */
+    [[nodiscard]] Effects effects() const override { return FOLDED_CONSTANTS; }
+
+    /**
+     * @brief Function-level changes are picked up once the module is visited again.
+     */
+    [[nodiscard]] Effects triggers() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Replaces every call that can be evaluated by its result.
+     *
+     * @param module The `il::Module` to optimize.
+     * @return True if a call was replaced, false otherwise.
+     */
+    bool enter_module(il::Module& module) override;
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    size_t _fuel;
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,7 +1,6 @@
 #pragma once
 
-#include <unordered_set>
-
+#include "arkoi_language/il/analyses.hpp"
 #include "arkoi_language/opt/pass.hpp"
 
 namespace arkoi::opt {
@@ -11,7 +10,8 @@ namespace arkoi::opt {
  * `DeadCodeElimination` (DCE) identifies 'dead' assignments—variables that are
  * written to but never subsequently read before the end of their lifetime.
  * It also removes instructions with no side effects that do not contribute
- * to the program's output.
+ * to the program's output. Calls are only removed if their callee is known to be
+ * `il::Call::Effects::Speculatable`, their arguments are removed once the call is gone.
  *
  * This implementation uses a simple usage-tracking mechanism across the function.
  *
@@ -19,6 +19,21 @@ namespace arkoi::opt {
  */
 class DeadCodeElimination final : public Pass {
 public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "dead-code-elimination"; }
+
+    /**
+     * @brief Elimination removes unused instructions.
+     */
+    [[nodiscard]] Effects effects() const override { return REMOVED_INSTRUCTIONS; }
+
+    /**
+     * @brief Any change that drops a use, including its own removals, can leave further definitions unused.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REPLACED_OPERANDS | REMOVED_INSTRUCTIONS; }
+
     /**
      * @brief No-op for module entry.
      */
@@ -30,10 +45,10 @@ public:
     bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
 
     /**
-     * @brief Pre-calculates the set of used operands for the entire function.
+     * @brief Fetches the set of used operands for the entire function.
      *
-     * Traverses all instructions in the function to determine which variables
-     * are read at least once.
+     * The `il::UseAnalysis` is taken from the analysis cache and only
+     * recomputed if the function changed since it was last requested.
      *
      * @param function The `il::Function` being optimized.
      * @return False (this step only gathers information).
@@ -49,7 +64,7 @@ public:
      * @brief Removes dead instructions from a basic block.
      *
      * An instruction is removed if it defines a variable not in the
-     * pre-calculated `_used` set, and the instruction has no side effects.
+     * pre-calculated `_uses` analysis, and the instruction has no side effects.
      *
      * @param block The `il::BasicBlock` to optimize.
      * @return True if any instructions were removed, false otherwise.
@@ -57,7 +72,7 @@ public:
     bool on_block(il::BasicBlock& block) override;
 
 private:
-    std::unordered_set<il::Operand> _used;
+    const il::UseAnalysis* _uses{ };
 };
 } // namespace arkoi::opt
 
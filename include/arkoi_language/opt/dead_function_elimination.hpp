@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Module-level optimization pass that removes the functions unreachable from `main`.
+ *
+ * The call graph is walked from `main` and from every function called from outside of the
+ * module, all other functions are removed. Unlike the `Inliner`, which only removes functions
+ * without any call site left, this also removes functions that only call each other or
+ * themselves. A module without `main` is a library for the other sources of the program,
+ * thus nothing is removed from it.
+ *
+ * @see Pass, il::CallGraph, Inliner
+ */
+class DeadFunctionElimination final : public Pass {
+public:
+    /**
+     * @brief Constructs the pass with the calls from outside of the module.
+     *
+     * @param external_calls The number of calls to functions of the module from code outside of it, e.g. from
+     *                       functions compiled separately. Functions called from outside are never removed.
+     */
+    explicit DeadFunctionElimination(std::unordered_map<std::string, size_t> external_calls = { }) :
+        _external_calls(std::move(external_calls)) { }
+
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "dead-function-elimination"; }
+
+    /**
+     * @brief Removing whole functions leaves the remaining ones untouched.
+     */
+    [[nodiscard]] Effects effects() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Function-level changes never make a function unreachable.
+     */
+    [[nodiscard]] Effects triggers() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Removes every function that is unreachable from the entry points of the module.
+     *
+     * @param module The `il::Module` to optimize.
+     * @return True if a function was removed, false otherwise.
+     */
+    bool enter_module(il::Module& module) override;
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    std::unordered_map<std::string, size_t> _external_calls;
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that removes redundant computations (Global Value Numbering).
+ *
+ * The blocks are visited in the order of the dominator tree, while keeping a
+ * table of all `Binary` and `Cast` expressions computed in the dominating
+ * blocks. An expression is identified by its operator, the value numbers of
+ * its operands and its type. If the same expression was already computed, the
+ * uses of the new result are replaced by the existing one, leaving the
+ * duplicate to `DeadCodeElimination`.
+ *
+ * Calls whose callee is at least `il::Call::Effects::ReadNone` are numbered
+ * as well, identified by the callee and the value numbers of their arguments.
+ * As the dominating call already returned, the duplicate is certain to return
+ * too and is thus marked as speculatable for `DeadCodeElimination`.
+ *
+ * Copies share the value number of their source and the operands of commutative
+ * operators are ordered, thus `a * b` and `c * a` are equal if `c` is a copy of `b`.
+ *
+ * @see Pass, il::DominanceAnalysis, il::DefUseChains, DeadCodeElimination
+ */
+class GVN final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "gvn"; }
+
+    /**
+     * @brief The uses of redundant results are replaced.
+     */
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS; }
+
+    /**
+     * @brief Folded, propagated or moved instructions can uncover new redundancies.
+     */
+    [[nodiscard]] Effects triggers() const override {
+        return FOLDED_CONSTANTS | REPLACED_OPERANDS | MOVED_INSTRUCTIONS | CHANGED_BLOCKS;
+    }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Numbers all values of the function and replaces the redundant ones.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if any use was replaced, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, they are visited in dominator tree order instead.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief An expression identified by its operator and the value numbers of its operands.
+     */
+    struct Expression {
+        /// The index of the instruction kind in `il::Instruction`.
+        size_t kind;
+
+        /// The operator of a `Binary`, unused otherwise.
+        il::Binary::Operator op;
+
+        /// The callee of a `Call`, empty otherwise.
+        std::string callee;
+
+        /// The operands of a `Binary`, the source of a `Cast` or the arguments of a `Call`.
+        std::vector<il::Operand> operands;
+
+        /// The operand type of a `Binary` or the result type of a `Cast` or `Call`.
+        sem::Type type;
+
+        bool operator==(const Expression& other) const = default;
+    };
+
+    /**
+     * @brief Hashes an `Expression` by its kind, operator and operands.
+     */
+    struct ExpressionHash {
+        size_t operator()(const Expression& expression) const noexcept;
+    };
+
+private:
+    /**
+     * @brief Numbers the values of @p block and its children in the dominator tree.
+     *
+     * The expressions of the block are only visible to the blocks it dominates
+     * and are removed from the table afterward.
+     *
+     * @param block The block to visit.
+     * @param dominance The dominator tree of the function.
+     * @param chains The def-use chains of the function.
+     */
+    void _visit(il::BasicBlock& block, const il::DominanceAnalysis& dominance, const il::DefUseChains& chains);
+
+    /**
+     * @brief Builds the expression computed by the instruction.
+     *
+     * @param instruction The instruction to describe.
+     * @return The expression, or std::nullopt if the instruction can't be numbered.
+     */
+    [[nodiscard]] std::optional<Expression> _expression(il::Instruction& instruction) const;
+
+    /**
+     * @brief Returns the value number of the operand.
+     *
+     * @param operand The operand to look up.
+     * @return The first operand known to hold the same value, or the operand itself.
+     */
+    [[nodiscard]] il::Operand _number(const il::Operand& operand) const;
+
+private:
+    std::unordered_map<Expression, il::Variable, ExpressionHash> _expressions{ };
+    std::unordered_map<il::Variable, il::Operand> _numbers{ };
+    std::vector<std::pair<il::Variable, il::Variable>> _redundant{ };
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that replaces small branches by `il::Select` instructions.
+ *
+ * A conditional jump whose successors only compute a few values and then meet
+ * again forms either a diamond (both successors are arms ending in the join)
+ * or a triangle (one successor is the join itself). If every instruction of
+ * the arms can be executed speculatively, the arms are hoisted in front of the
+ * jump and each phi of the join becomes a `Select` on the branch condition.
+ * The branch is replaced by a jump to the join, which can then be merged by
+ * `SimplifyCFG`.
+ *
+ * Calls, memory accesses and integer divisions by unknown divisors are never
+ * speculated. Chains of `if/else if/else` collapse from the innermost branch
+ * outward, as every conversion turns the surrounding branch into a diamond.
+ *
+ * Example:
+ * `if a > b: x = a - b else: x = b` becomes `d = a - b; x = select a > b, d, b`.
+ *
+ * @see Pass, il::Select
+ */
+class IfConversion final : public Pass {
+public:
+    /**
+     * @brief Arms of a branch are only speculated if they have at most this many instructions.
+     */
+    static constexpr size_t DEFAULT_THRESHOLD = 3;
+
+    /**
+     * @brief Constructs an `IfConversion` pass with the given arm size threshold.
+     *
+     * @param threshold The maximum number of instructions of each arm.
+     */
+    explicit IfConversion(const size_t threshold = DEFAULT_THRESHOLD) : _threshold(threshold) { }
+
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "if-conversion"; }
+
+    /**
+     * @brief Arms are hoisted and removed, the phis of the join become selects.
+     */
+    [[nodiscard]] Effects effects() const override { return MOVED_INSTRUCTIONS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief Removed instructions and merged blocks can turn further branches into diamonds.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REMOVED_INSTRUCTIONS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Converts every eligible branch of the function.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if a branch was converted, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, the branches are converted as a whole.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief Converts the branch at the end of @p head if it forms a diamond or a triangle.
+     *
+     * @param function The function containing the branch.
+     * @param head The block ending with the conditional jump.
+     * @return True if the branch was converted, false otherwise.
+     */
+    [[nodiscard]] bool _convert(il::Function& function, il::BasicBlock& head) const;
+
+    /**
+     * @brief Determines if @p arm can be hoisted into its only predecessor @p head.
+     *
+     * @param arm The successor of the branch to check.
+     * @param head The block ending with the conditional jump.
+     * @return True if the arm is only reached from @p head, continues unconditionally and can be speculated.
+     */
+    [[nodiscard]] bool _is_arm(il::BasicBlock& arm, il::BasicBlock& head) const;
+
+    /**
+     * @brief Determines if the instruction may be executed even if its branch is not taken.
+     *
+     * @param instruction The instruction to check.
+     * @return True if the instruction is a pure `Binary`, `Cast`, `Assign` or `Select` that can't trap.
+     */
+    [[nodiscard]] static bool _is_speculatable(il::Instruction& instruction);
+
+    /**
+     * @brief Moves the instructions of @p arm except its jump to the end of @p head.
+     *
+     * @param arm The arm to hoist.
+     * @param head The block receiving the instructions.
+     */
+    static void _hoist(il::BasicBlock& arm, il::BasicBlock& head);
+
+private:
+    size_t _threshold;
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
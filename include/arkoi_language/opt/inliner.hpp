@@ -0,0 +1,233 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Module-level optimization pass that inlines calls to small functions.
+ *
+ * `Inliner` replaces an `il::Call` with a copy of the callee's CFG if the
+ * callee is cheap enough, or if it's only called once in the whole module. The
+ * copy is spliced in between the two halves of the calling block, the callee's
+ * parameters are assigned the values of the call's arguments and its return
+ * value is assigned to the result of the call.
+ *
+ * Callees are processed before their callers, thus calls are inlined
+ * transitively. Recursive functions are never inlined, and functions which
+ * aren't called anymore afterwards are removed from the module (except for
+ * `main` and the functions called from outside of the module). The copied
+ * instructions are still in SSA form, the cleanup of the introduced copies
+ * and blocks is left to the function-level passes.
+ *
+ * @see Pass, il::Call, il::Module, il::CallGraph
+ */
+class Inliner final : public Pass {
+public:
+    /**
+     * @brief Callees with at most this many instructions are inlined into every caller.
+     */
+    static constexpr size_t DEFAULT_THRESHOLD = 24;
+
+    /**
+     * @brief Callees with a single call site and at most this many instructions are inlined.
+     */
+    static constexpr size_t DEFAULT_SINGLE_CALL_THRESHOLD = 256;
+
+    /**
+     * @brief The threshold is multiplied by this factor for call sites the profile shows to run more often than
+     *        their caller is entered, e.g. inside of a hot loop.
+     */
+    static constexpr size_t HOT_THRESHOLD_FACTOR = 4;
+
+    /**
+     * @brief Constructs an `Inliner` with the given cost thresholds.
+     *
+     * @param threshold The maximum cost of a callee that is inlined into every caller.
+     * @param single_call_threshold The maximum cost of a callee with a single call site.
+     * @param external_calls The number of calls to functions of the module from code outside of it, e.g. from
+     *                       functions compiled separately. Functions called from outside are never removed.
+     */
+    explicit Inliner(
+        const size_t threshold = DEFAULT_THRESHOLD, const size_t single_call_threshold = DEFAULT_SINGLE_CALL_THRESHOLD,
+        std::unordered_map<std::string, size_t> external_calls = { }
+    ) : _external_calls(std::move(external_calls)), _threshold(threshold),
+        _single_call_threshold(single_call_threshold) { }
+
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "inliner"; }
+
+    /**
+     * @brief Inlining adds and splits blocks.
+     */
+    [[nodiscard]] Effects effects() const override { return CHANGED_BLOCKS; }
+
+    /**
+     * @brief Function-level changes never enable further inlining.
+     */
+    [[nodiscard]] Effects triggers() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Inlines all calls accepted by the cost model and removes dead functions.
+     *
+     * @param module The `il::Module` to optimize.
+     * @return True if a call was inlined or a function was removed, false otherwise.
+     */
+    bool enter_module(il::Module& module) override;
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+    /**
+     * @brief Estimates the cost of inlining a function.
+     *
+     * @param function The function to estimate.
+     * @return The number of instructions of the function, excluding phis and gotos.
+     */
+    [[nodiscard]] static size_t cost(il::Function& function);
+
+private:
+    using Functions = std::unordered_map<std::string, il::Function*>;
+    using Blocks = std::unordered_map<il::BasicBlock*, il::BasicBlock*>;
+    using Labels = std::unordered_map<std::string, std::string>;
+
+    /**
+     * @brief Inlines every accepted call of a single caller.
+     *
+     * @param caller The function whose calls should be inlined.
+     * @param functions All functions of the module by name.
+     * @param call_sites The number of calls to each function in the module.
+     * @return True if a call was inlined.
+     */
+    bool _inline_calls(
+        il::Function& caller, const Functions& functions, std::unordered_map<std::string, size_t>& call_sites
+    );
+
+    /**
+     * @brief Splices a copy of the callee in place of the call at the given index.
+     *
+     * @param caller The function containing the call.
+     * @param block The block containing the call.
+     * @param index The index of the call inside the block.
+     * @param callee The function being called.
+     * @return The block containing the instructions that followed the call.
+     */
+    il::BasicBlock* _inline(il::Function& caller, il::BasicBlock& block, size_t index, il::Function& callee);
+
+    /**
+     * @brief Decides if a call to the given function should be inlined.
+     *
+     * With a profile, call sites that never ran are only inlined if they are the single call site, while
+     * hot ones are inlined up to a higher threshold.
+     *
+     * @param caller The function containing the call.
+     * @param block The block containing the call.
+     * @param callee The function being called.
+     * @param call_sites The number of calls to the callee in the module.
+     * @return True if the call should be inlined.
+     */
+    [[nodiscard]] bool _should_inline(
+        il::Function& caller, const il::BasicBlock& block, il::Function& callee, size_t call_sites
+    ) const;
+
+    /**
+     * @brief Collects the names of all functions called by the given function.
+     *
+     * @param function The function to search for calls.
+     * @return The name of the callee for every call, including duplicates.
+     */
+    [[nodiscard]] static std::vector<std::string> _callees(il::Function& function);
+
+    /**
+     * @brief Copies an instruction of the callee for the given call site.
+     *
+     * @param instruction The instruction to copy.
+     * @param site The suffix used to rename the operands.
+     * @param blocks The copies of the callee's blocks.
+     * @param labels The labels of the copies by the labels of the callee's blocks.
+     * @return The renamed copy of the instruction.
+     */
+    [[nodiscard]] static il::Instruction _clone(
+        const il::Instruction& instruction, const std::string& site, const Blocks& blocks, const Labels& labels
+    );
+
+    /**
+     * @brief Returns @p label, which is made unique within @p function by appending primes.
+     *
+     * @param function The function the label is used in.
+     * @param label The preferred label.
+     * @return A label that no block of the function has yet.
+     */
+    [[nodiscard]] static std::string _unique_label(il::Function& function, std::string label);
+
+    /**
+     * @brief Renames an operand of the callee for the given call site.
+     *
+     * @param operand The operand to rename.
+     * @param site The suffix used to rename the operand.
+     * @return The renamed operand, immediates are returned as is.
+     */
+    [[nodiscard]] static il::Operand _clone(const il::Operand& operand, const std::string& site);
+
+private:
+    std::unordered_map<std::string, size_t> _external_calls;
+    std::unordered_set<std::string> _recursive{ };
+    size_t _threshold, _single_call_threshold;
+    size_t _sites{ };
+};
+} // namespace arkoi::opt
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
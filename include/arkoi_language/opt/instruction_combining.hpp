@@ -0,0 +1,179 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that simplifies binary operations with a constant or repeated operand.
+ *
+ * `InstructionCombining` applies algebraic identities and replaces expensive
+ * operations with cheaper ones (strength reduction):
+ * 1. `x + 0`, `x - 0`, `x * 1` and `x / 1` become copies of `x`.
+ * 2. `x * 0` and `x - x` become `0`, comparisons of `x` with itself become constants.
+ * 3. Multiplications by powers of two become shifts to the left.
+ * 4. Divisions by powers of two become shifts to the right, with a correction
+ *    of the rounding for signed types.
+ * 5. Other unsigned 32bit divisions by constants become a multiplication with
+ *    a "magic number" in 64bit, followed by shifts to the right.
+ * 6. Casts to their own type and casts back to the type before a lossless cast,
+ *    e.g. `cast<bool>(cast<s32>(b))`, become copies of the original value.
+ * 7. Comparisons of a boolean, or of a boolean widened by a cast, with true or
+ *    false become a copy of the boolean or its comparison with false.
+ *
+ * Identities that don't hold for all floating point values, e.g. `x - x`
+ * being `NaN` for infinite values, are only applied to integral types.
+ *
+ * Example: `x * 8` becomes `x << 3`, and `x / 10` doesn't emit a `div` anymore.
+ * A branch on `cast<s32>(x < y) != 0` branches on the flags of `x < y` again.
+ *
+ * @see Pass, ConstantFolding, il::Binary
+ */
+class InstructionCombining final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "instruction-combining"; }
+
+    /**
+     * @brief Instructions are rewritten into constants, copies or cheaper instructions.
+     */
+    [[nodiscard]] Effects effects() const override { return FOLDED_CONSTANTS | REPLACED_OPERANDS; }
+
+    /**
+     * @brief Newly propagated immediates can expose further identities.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REPLACED_OPERANDS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief Simplifies all binary operations and casts of the block.
+     *
+     * @param block The `il::BasicBlock` to optimize.
+     * @return True if any instruction was rewritten, false otherwise.
+     */
+    bool on_block(il::BasicBlock& block) override;
+
+private:
+    /// The source of every cast of a block and the type it is cast from, by the result of the cast.
+    using Casts = std::unordered_map<il::Operand, std::pair<il::Operand, sem::Type>>;
+
+    /**
+     * @brief Looks through casts that don't change the value.
+     *
+     * @param instruction The cast to simplify.
+     * @param casts The casts in front of @p instruction in the same block.
+     * @return The operand holding the same value, or std::nullopt if the cast is needed.
+     */
+    [[nodiscard]] static std::optional<il::Operand> _cast(il::Cast& instruction, const Casts& casts);
+
+    /**
+     * @brief Appends the simplified comparison of a boolean with a constant to @p output.
+     *
+     * @param instruction The equality comparison to simplify.
+     * @param casts The casts in front of @p instruction in the same block.
+     * @param output The instructions replacing the original one.
+     * @return True if the comparison was simplified, false if @p output was left untouched.
+     */
+    [[nodiscard]] static bool _boolean(
+        il::Binary& instruction, const Casts& casts, il::BasicBlock::Instructions& output
+    );
+
+    /**
+     * @brief Appends the simplified form of @p instruction to @p output.
+     *
+     * @param instruction The binary operation to simplify.
+     * @param output The instructions replacing the original one.
+     * @return True if the instruction was simplified, false if @p output was left untouched.
+     */
+    [[nodiscard]] static bool _simplify(il::Binary& instruction, il::BasicBlock::Instructions& output);
+
+    /**
+     * @brief Applies algebraic identities that reduce the operation to a copy or constant.
+     *
+     * @param instruction The binary operation to simplify.
+     * @return The operand holding the result, or std::nullopt if no identity applies.
+     */
+    [[nodiscard]] static std::optional<il::Operand> _identity(il::Binary& instruction);
+
+    /**
+     * @brief Appends the replacement of a division by the constant @p divisor.
+     *
+     * @param instruction The integral division to replace.
+     * @param divisor The bits of the immediate divisor.
+     * @param output The instructions replacing the division.
+     * @return True if the division was replaced, false otherwise.
+     */
+    [[nodiscard]] static bool _divide(il::Binary& instruction, uint64_t divisor, il::BasicBlock::Instructions& output);
+
+    /**
+     * @brief Returns the bits of an integral immediate, sign-extended for signed types.
+     *
+     * @param operand The operand to inspect.
+     * @return The bits of the immediate, or std::nullopt if it's not an integral immediate.
+     */
+    [[nodiscard]] static std::optional<uint64_t> _integer(const il::Operand& operand);
+
+    /**
+     * @brief Checks if the operand is an immediate whose value equals @p expected.
+     *
+     * @param operand The operand to inspect.
+     * @param expected The value to compare with.
+     * @return True if the operand is an integral or floating immediate equal to @p expected.
+     */
+    [[nodiscard]] static bool _is_value(const il::Operand& operand, int64_t expected);
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
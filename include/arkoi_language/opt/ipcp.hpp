@@ -0,0 +1,199 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "arkoi_language/il/call_graph.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Module-level optimization pass that propagates constant arguments into their callees.
+ *
+ * If every call to a function passes the same constant for one of its parameters, the
+ * parameter is removed from the function and all of its calls. Instead, the entry block
+ * assigns the constant to the former parameter, which the function-level passes then fold
+ * into its uses.
+ *
+ * Otherwise, if the same constant is passed by at least two calls, or a profile shows its
+ * calls to run more often than all others together, the function is specialized. A copy of
+ * the function without the parameter is added to the module, named after the original and
+ * suffixed with ".specialized<n>", and these calls are redirected to it. Only functions below
+ * `SPECIALIZATION_THRESHOLD` are copied, at most `MAX_SPECIALIZATIONS` times each.
+ *
+ * Neither `main`, functions called from outside of the module nor recursive functions are
+ * changed, as not every caller of them can be rewritten.
+ *
+ * Example:
+ * `fun scale(x, factor): return x * factor` only called as `scale(a, 2)` and `scale(b, 2)`
+ * becomes `fun scale(x): return x * 2`.
+ *
+ * @see Pass, il::CallGraph, Inliner
+ */
+class IPCP final : public Pass {
+public:
+    /**
+     * @brief Functions with at most this many instructions are specialized.
+     */
+    static constexpr size_t SPECIALIZATION_THRESHOLD = 64;
+
+    /**
+     * @brief The maximum amount of copies of a single function.
+     */
+    static constexpr size_t MAX_SPECIALIZATIONS = 4;
+
+    /**
+     * @brief Constructs the pass with the calls from outside of the module.
+     *
+     * @param external_calls The number of calls to functions of the module from code outside of it, e.g. from
+     *                       functions compiled separately. Functions called from outside keep their parameters.
+     */
+    explicit IPCP(std::unordered_map<std::string, size_t> external_calls = { }) :
+        _external_calls(std::move(external_calls)) { }
+
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "ipcp"; }
+
+    /**
+     * @brief Parameters become constant assignments and functions are added.
+     */
+    [[nodiscard]] Effects effects() const override { return FOLDED_CONSTANTS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief Function-level changes are picked up once the module is visited again.
+     */
+    [[nodiscard]] Effects triggers() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Propagates the constant arguments of all functions, or specializes one function.
+     *
+     * @param module The `il::Module` to optimize.
+     * @return True if a parameter was removed or a function was specialized, false otherwise.
+     */
+    bool enter_module(il::Module& module) override;
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief A call to a function, identified by its position as the instructions move when arguments are removed.
+     */
+    struct CallSite {
+        il::BasicBlock* block;
+        size_t index;
+    };
+
+    /**
+     * @brief Checks if every caller of the function is part of the module and can be rewritten.
+     *
+     * @param graph The call graph of the module.
+     * @param function The function to check.
+     * @return True if the parameters of the function may be changed.
+     */
+    [[nodiscard]] bool _is_candidate(const il::CallGraph& graph, il::Function& function) const;
+
+    /**
+     * @brief Removes the parameters of @p function that receive the same constant from every call.
+     *
+     * @param graph The call graph of the module.
+     * @param function The function whose parameters are propagated.
+     * @return True if a parameter was removed.
+     */
+    bool _propagate(const il::CallGraph& graph, il::Function& function);
+
+    /**
+     * @brief Specializes @p name for the constant passed by most of its calls to one of its parameters.
+     *
+     * @param module The module the specialized copy is added to.
+     * @param graph The call graph of the module, which is invalid once a copy is added.
+     * @param name The name of the function to specialize.
+     * @return True if a copy was added.
+     */
+    bool _specialize(il::Module& module, const il::CallGraph& graph, const std::string& name);
+
+    /**
+     * @brief Returns the position of every call to @p name, in the order of the blocks and instructions.
+     */
+    [[nodiscard]] static std::vector<CallSite> _calls(const il::CallGraph& graph, const std::string& name);
+
+    /**
+     * @brief Returns the constant passed to the parameter @p parameter by a call, if it's known.
+     */
+    [[nodiscard]] static std::optional<il::Immediate> _constant(const CallSite& site, size_t parameter);
+
+    /**
+     * @brief Removes the argument of the parameter @p parameter from a call and the `il::Argument` passing it.
+     */
+    static void _remove_argument(const CallSite& site, size_t parameter, const std::string& callee);
+
+    /**
+     * @brief Replaces the parameter @p parameter of @p function by assigning @p value to it in the entry block.
+     */
+    static void _remove_parameter(il::Function& function, size_t parameter, const il::Immediate& value);
+
+    /**
+     * @brief Adds a copy of the function @p original to the module, which is named @p name.
+     *
+     * @return The copy, references to other functions of the module are invalid afterward.
+     */
+    static il::Function& _copy(il::Module& module, const std::string& original, const std::string& name);
+
+private:
+    std::unordered_map<std::string, size_t> _external_calls;
+    std::unordered_map<std::string, size_t> _specializations{ };
+    size_t _copies{ };
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that hoists loop-invariant computations out of loops.
+ *
+ * A `Binary` or `Cast` instruction is loop-invariant if all of its operands
+ * are immediates or defined outside the loop, either originally or because
+ * they were hoisted themselves. Such instructions compute the same value in
+ * every iteration and are moved into the preheader of the loop, which is
+ * created first if the loop has no dedicated one.
+ *
+ * Loops are processed from the innermost to the outermost, so an invariant
+ * computation can leave several loops at once. Divisions are only hoisted if
+ * they can't trap, as the loop body might never be executed. For the same
+ * reason, calls are only hoisted together with their arguments if the callee
+ * is `il::Call::Effects::Speculatable`.
+ *
+ * Example:
+ * `while i < n: i = i + (a * b)` computes `a * b` once in front of the loop.
+ *
+ * @see Pass, il::LoopAnalysis, il::Loop
+ */
+class LICM final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "licm"; }
+
+    /**
+     * @brief Instructions are moved between blocks and new preheaders may be inserted.
+     */
+    [[nodiscard]] Effects effects() const override { return MOVED_INSTRUCTIONS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief Folded or propagated operands and new loops can make further instructions invariant.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REPLACED_OPERANDS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Hoists the invariant instructions of every loop of the function.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if a preheader was created or an instruction was hoisted, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, the loops are processed as a whole.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief Returns the preheader of the loop, inserting a new block if necessary.
+     *
+     * The preheader is the only predecessor of the header outside the loop and
+     * must have the header as its only successor. Loops with several entries
+     * from outside are not handled.
+     *
+     * @param function The function containing the loop.
+     * @param loop The loop to find the preheader for.
+     * @param created Set to true if a new block was inserted.
+     * @return The preheader, or nullptr if the loop has none.
+     */
+    [[nodiscard]] static il::BasicBlock* _preheader(il::Function& function, const il::Loop& loop, bool& created);
+
+    /**
+     * @brief Moves the invariant instructions of the loop to the end of its preheader.
+     *
+     * @param loop The loop to process.
+     * @param preheader The preheader of the loop.
+     * @return True if an instruction was hoisted, false otherwise.
+     */
+    bool _hoist(const il::Loop& loop, il::BasicBlock& preheader);
+
+    /**
+     * @brief Moves an invariant call and the arguments passed to it to the preheader.
+     *
+     * @param loop The loop to process.
+     * @param block The block of the loop containing the call.
+     * @param index The index of the call, which is moved to the instruction after it if hoisted.
+     * @param preheader The preheader of the loop.
+     * @param position The index in the preheader the call is inserted at, which is moved after it.
+     * @return True if the call was hoisted, false otherwise.
+     */
+    bool _hoist_call(
+        const il::Loop& loop, il::BasicBlock& block, size_t& index, il::BasicBlock& preheader, size_t& position
+    );
+
+    /**
+     * @brief Determines if the operand has the same value in every iteration of the loop.
+     *
+     * @param loop The loop to check.
+     * @param operand The operand to check.
+     * @return True if the operand is an immediate or defined outside the loop.
+     */
+    [[nodiscard]] bool _is_invariant(const il::Loop& loop, const il::Operand& operand) const;
+
+    /**
+     * @brief Determines if the instruction may be executed even if the loop body is not.
+     *
+     * @param instruction The instruction to check.
+     * @return True if the instruction is a pure `Binary` or `Cast` that can't trap.
+     */
+    [[nodiscard]] static bool _is_hoistable(il::Instruction& instruction);
+
+private:
+    std::unordered_map<il::Variable, il::BasicBlock*> _definitions{ };
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
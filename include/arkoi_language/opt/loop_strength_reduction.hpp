@@ -0,0 +1,129 @@
+#pragma once
+
+#include <optional>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that replaces multiplications of induction variables by additions.
+ *
+ * A multiplication `i * c` (or a shift `i << c`) of a basic induction variable
+ * `i` with a constant is itself an induction variable, which starts at
+ * `i0 * c` and grows by `step * c` in every iteration. It is carried in a
+ * new phi of the loop header, incremented right after `i`, and the
+ * multiplication becomes a copy of it.
+ *
+ * All multiplications of the same induction variable with the same constant
+ * share a single new induction variable. Derived expressions like
+ * `i * 4 + base` are left with the addition of `base`, which is already as
+ * cheap as an additive update.
+ *
+ * Example:
+ * `while i < n: sum = sum + i * 12; i = i + 1` adds 12 to a second counter instead of multiplying.
+ *
+ * @see Pass, il::InductionAnalysis, il::InductionVariable
+ */
+class LoopStrengthReduction final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "loop-strength-reduction"; }
+
+    /**
+     * @brief Multiplications are rewritten into copies of newly inserted phis.
+     */
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS; }
+
+    /**
+     * @brief Folded or propagated operands and changed loops can expose further induction variables.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REPLACED_OPERANDS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Reduces the multiplications of the induction variables of every loop of the function.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if a multiplication was reduced, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, the loops are processed as a whole.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief Replaces the multiplications of one induction variable inside its loop.
+     *
+     * @param loop The loop of the induction variable.
+     * @param induction The basic induction variable to look for.
+     * @return True if a multiplication was reduced, false otherwise.
+     */
+    static bool _reduce(const il::Loop& loop, const il::InductionVariable& induction);
+
+    /**
+     * @brief Returns the constant factor of a multiplication or shift of @p induction.
+     *
+     * @param instruction The instruction to check.
+     * @param induction The induction variable that must be the other operand.
+     * @return The factor, or std::nullopt if the instruction isn't such a multiplication.
+     */
+    [[nodiscard]] static std::optional<uint64_t> _factor(il::Instruction& instruction, const il::InductionVariable& induction);
+
+    /**
+     * @brief Inserts @p instruction in front of the jump at the end of @p block.
+     */
+    static void _insert_before_terminator(il::BasicBlock& block, il::Instruction instruction);
+};
+} // namespace arkoi::opt
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that unrolls innermost loops with a constant trip count.
+ *
+ * Loops are fully unrolled if the copies of all iterations stay below the full
+ * threshold: every iteration gets its own copy of the loop blocks, the phis
+ * of the header become copies of the values of the previous iteration, and
+ * the original header only remains to leave the loop. Otherwise the body is
+ * duplicated up to `MAX_FACTOR` times, if the trip count is divisible by the
+ * factor and the unrolled body stays below the partial threshold. Only the
+ * original header then tests the exit condition, once for every `factor`
+ * iterations.
+ *
+ * The loop must be an innermost counted loop (see `il::CountedLoop`), which
+ * is only left through its header and has a single latch ending in a jump.
+ * Loops whose header the profile shows to never run are left as they are.
+ * Copied blocks and variables get a fresh `.u<n>` suffix.
+ *
+ * Example:
+ * `while i < 4: sum = sum + i; i = i + 1` becomes four additions of constants.
+ *
+ * @see Pass, il::InductionAnalysis, il::CountedLoop
+ */
+class LoopUnroll final : public Pass {
+public:
+    /**
+     * @brief Loops are fully unrolled if the copies of all iterations have at most this many instructions.
+     */
+    static constexpr size_t DEFAULT_FULL_THRESHOLD = 64;
+
+    /**
+     * @brief Loops are partially unrolled if the unrolled body has at most this many instructions.
+     */
+    static constexpr size_t DEFAULT_PARTIAL_THRESHOLD = 32;
+
+    /**
+     * @brief The maximum number of copies of the body in a partially unrolled loop.
+     */
+    static constexpr size_t MAX_FACTOR = 4;
+
+    /**
+     * @brief Constructs a `LoopUnroll` pass with the given size thresholds.
+     *
+     * @param full_threshold The maximum size of a fully unrolled loop.
+     * @param partial_threshold The maximum size of the body of a partially unrolled loop.
+     */
+    explicit LoopUnroll(
+        const size_t full_threshold = DEFAULT_FULL_THRESHOLD, const size_t partial_threshold = DEFAULT_PARTIAL_THRESHOLD
+    ) : _full_threshold(full_threshold), _partial_threshold(partial_threshold) { }
+
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "loop-unroll"; }
+
+    /**
+     * @brief Blocks are copied and removed, the header phis become copies.
+     */
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief Folded or propagated operands and changed loops can expose further counted loops.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REPLACED_OPERANDS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Unrolls the first loop of the function accepted by the thresholds.
+     *
+     * The loops are invalidated by unrolling, thus the remaining ones are handled in the next run.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if a loop was unrolled, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, the loops are processed as a whole.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    using Blocks = std::unordered_map<il::BasicBlock*, il::BasicBlock*>;
+    using Variables = std::unordered_map<il::Variable, il::Variable>;
+
+    /**
+     * @brief A copy of all blocks of a loop for a single iteration.
+     */
+    struct Copy {
+        Blocks blocks{ };
+        Variables variables{ };
+        std::unordered_map<std::string, std::string> labels{ };
+    };
+
+    /**
+     * @brief The parts of a loop that are rewired by unrolling.
+     */
+    struct Shape {
+        il::BasicBlock* entry{ };
+        il::BasicBlock* latch{ };
+        il::BasicBlock* body{ };
+        il::BasicBlock* exit{ };
+    };
+
+    /**
+     * @brief Checks if the loop has the shape required for unrolling.
+     *
+     * @param function The function containing the loop.
+     * @param analysis The induction analysis of the function.
+     * @param loop The loop to check.
+     * @param shape Filled with the blocks of the loop that are rewired.
+     * @return True if the loop is an innermost loop that is only left through its header.
+     */
+    [[nodiscard]] static bool _is_unrollable(
+        il::Function& function, const il::InductionAnalysis& analysis, const il::Loop& loop, Shape& shape
+    );
+
+    /**
+     * @brief Estimates the size of one iteration of the loop.
+     *
+     * @param loop The loop to estimate.
+     * @return The number of instructions of the loop, excluding phis and gotos.
+     */
+    [[nodiscard]] static size_t _cost(const il::Loop& loop);
+
+    /**
+     * @brief Replaces the loop by one copy per iteration, the header only leaves the loop.
+     *
+     * @param function The function containing the loop.
+     * @param loop The loop to unroll.
+     * @param shape The blocks of the loop that are rewired.
+     * @param trip_count The number of iterations of the loop.
+     */
+    static void _unroll_fully(il::Function& function, const il::Loop& loop, const Shape& shape, uint64_t trip_count);
+
+    /**
+     * @brief Chains @p factor copies of the loop, only the original header tests the exit condition.
+     *
+     * @param function The function containing the loop.
+     * @param loop The loop to unroll.
+     * @param shape The blocks of the loop that are rewired.
+     * @param factor The number of iterations executed per test of the exit condition.
+     */
+    static void _unroll_partially(il::Function& function, const il::Loop& loop, const Shape& shape, size_t factor);
+
+    /**
+     * @brief Copies all blocks of the loop, the header of the copy jumps straight into the body.
+     *
+     * The phis of the copied header become assignments of @p values, the back
+     * edge of the copied latch is linked afterwards with `_jump`.
+     *
+     * @param function The function containing the loop.
+     * @param loop The loop to copy.
+     * @param shape The blocks of the loop that are rewired.
+     * @param values The value of each header phi for this iteration.
+     * @return The copied blocks and renamed variables.
+     */
+    [[nodiscard]] static Copy _copy(
+        il::Function& function, const il::Loop& loop, const Shape& shape,
+        const std::unordered_map<il::Variable, il::Operand>& values
+    );
+
+    /**
+     * @brief Clones an instruction of the loop into a copy, renaming operands and labels.
+     *
+     * @param instruction The instruction to clone.
+     * @param copy The copy the instruction belongs to.
+     * @return The cloned instruction.
+     */
+    [[nodiscard]] static il::Instruction _clone(const il::Instruction& instruction, const Copy& copy);
+
+    /**
+     * @brief Returns the renamed version of @p operand in @p copy.
+     */
+    [[nodiscard]] static il::Operand _rename(const il::Operand& operand, const Copy& copy);
+
+    /**
+     * @brief Replaces the jump at the end of @p block by an unconditional jump to @p target.
+     */
+    static void _jump(il::BasicBlock& block, il::BasicBlock& target);
+
+    /**
+     * @brief Returns a copy suffix that is not used by any block of the function yet.
+     */
+    [[nodiscard]] static std::string _suffix(il::Function& function);
+
+private:
+    size_t _full_threshold;
+    size_t _partial_threshold;
+};
+} // namespace arkoi::opt
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
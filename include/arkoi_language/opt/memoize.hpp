@@ -0,0 +1,96 @@
+#pragma once
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Module-level pass that caches the results of pure recursive functions by their argument.
+ *
+ * A function is memoized if it's recursive, has no side effects by the `il::EffectAnalysis` and
+ * takes a single integral parameter. The pass only marks these functions, the backend emits a
+ * small cache table in front of them, which is looked up before the body is run and filled once
+ * it returned. Arguments that don't fit into the table always run the body.
+ *
+ * The cache trades memory for time and only pays off for functions that are called repeatedly with
+ * the same arguments, e.g. a naive fibonacci. Thus it's never part of an optimization level and has
+ * to be requested explicitly.
+ *
+ * @see Pass, il::EffectAnalysis, x86_64::Generator
+ */
+class Memoize final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "memoize"; }
+
+    /**
+     * @brief Marking a function leaves its instructions untouched.
+     */
+    [[nodiscard]] Effects effects() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Function-level changes are picked up by the next run of the module passes.
+     */
+    [[nodiscard]] Effects triggers() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief Marks every function of the module whose results can be cached.
+     *
+     * @param module The `il::Module` to optimize.
+     * @return True if a function was newly marked, false otherwise.
+     */
+    bool enter_module(il::Module& module) override;
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string_view>
 #include <vector>
 
+#include "arkoi_language/il/analysis_manager.hpp"
 #include "arkoi_language/il/cfg.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+#include "arkoi_language/utils/time_report.hpp"
 
 namespace arkoi::opt {
 /**
@@ -13,12 +18,68 @@ namespace arkoi::opt {
  * hierarchy. Passes can modify the IL (e.g., folding constants, removing
  * dead code) and must return true if any changes were made.
  *
+ * Every pass also describes which kinds of changes it makes (`effects`) and
+ * which kinds of changes can give it new work (`triggers`). The `PassManager`
+ * uses both to only revisit a function with the passes that may still change
+ * it. The effects also decide which cached analyses are dropped after a change.
+ *
  * @see PassManager, il::Module, il::Function, il::BasicBlock
  */
 class Pass {
+public:
+    /**
+     * @brief Bit mask describing kinds of changes made to the IL.
+     */
+    using Effects = uint8_t;
+
+    /** @brief No change at all. */
+    static constexpr Effects NO_EFFECTS = 0;
+
+    /** @brief Instructions were rewritten into constant assignments. */
+    static constexpr Effects FOLDED_CONSTANTS = 1 << 0;
+
+    /** @brief Operands of instructions were replaced by other operands. */
+    static constexpr Effects REPLACED_OPERANDS = 1 << 1;
+
+    /** @brief Instructions were removed from their blocks. */
+    static constexpr Effects REMOVED_INSTRUCTIONS = 1 << 2;
+
+    /** @brief Basic blocks were removed or merged into each other. */
+    static constexpr Effects CHANGED_BLOCKS = 1 << 3;
+
+    /** @brief Instructions were moved into other blocks or reordered inside of theirs without changing them. */
+    static constexpr Effects MOVED_INSTRUCTIONS = 1 << 4;
+
+    /** @brief Every kind of change, used as the conservative default. */
+    static constexpr Effects ALL_EFFECTS = 0xFF;
+
 public:
     virtual ~Pass() = default;
 
+    /**
+     * @brief Returns the name of the pass, e.g. "sccp".
+     *
+     * @return The name, which identifies the pass in the `utils::TimeReport`.
+     */
+    [[nodiscard]] virtual std::string_view name() const = 0;
+
+    /**
+     * @brief Returns the kinds of changes this pass makes when it reports a change.
+     *
+     * @return The `Effects` of this pass, all of them by default.
+     */
+    [[nodiscard]] virtual Effects effects() const { return ALL_EFFECTS; }
+
+    /**
+     * @brief Returns the kinds of changes after which this pass must run again.
+     *
+     * A pass that reaches its own fixpoint in a single run does not need to
+     * list its own effects here.
+     *
+     * @return The triggering `Effects` of this pass, all of them by default.
+     */
+    [[nodiscard]] virtual Effects triggers() const { return ALL_EFFECTS; }
+
     /**
      * @brief Hook called when starting the traversal of a module.
      *
@@ -58,24 +119,77 @@ public:
      * @return True if the pass modified the block, false otherwise.
      */
     virtual bool on_block(il::BasicBlock& block) = 0;
+
+protected:
+    /**
+     * @brief Returns the analysis cache of the `PassManager` running this pass.
+     *
+     * @return A reference to the shared `il::AnalysisManager`.
+     */
+    [[nodiscard]] il::AnalysisManager& analyses() const;
+
+    /**
+     * @brief Adds the given amount to a counter of this pass, if statistics are collected.
+     *
+     * @param counter The name of the counter, e.g. "folded-instructions".
+     * @param amount The amount that is added.
+     */
+    void count(std::string_view counter, size_t amount = 1) const;
+
+private:
+    friend class PassManager;
+
+    il::AnalysisManager* _analyses{ };
+    utils::Statistics* _statistics{ };
 };
 
 /**
  * @brief Orchestrates the execution of multiple optimization passes.
  *
  * `PassManager` stores a sequence of passes and applies them to an IL module.
+ * Each function converges on its own: a pass is only rerun on a function if
+ * another pass changed that function in a way the pass is triggered by.
+ *
+ * The manager also owns an `il::AnalysisManager` shared by all of its passes,
+ * which is invalidated according to the effects of every change.
  */
 class PassManager {
 public:
+    PassManager();
+
+    /**
+     * @brief Constructs a `PassManager` sharing an existing analysis cache.
+     *
+     * This allows analyses computed before the optimization, e.g. during
+     * SSA construction, to be reused by the passes.
+     *
+     * @param analyses The `il::AnalysisManager` used by all passes.
+     */
+    explicit PassManager(std::shared_ptr<il::AnalysisManager> analyses);
+
     /**
      * @brief Runs all registered optimization passes on the module.
      *
-     * Passes are executed in the order they were added to the manager.
+     * Passes are executed in the order they were added to the manager. Every
+     * function is optimized until it converges, independent of the others.
+     * The functions are only revisited if a module hook reports a change.
      *
      * @param module The `il::Module` to optimize.
      */
     void run(il::Module& module) const;
 
+    /**
+     * @brief Runs all registered optimization passes on a single function.
+     *
+     * The passes are applied repeatedly until the function no longer changes,
+     * skipping passes that are not triggered by the latest changes. Module
+     * hooks are not invoked, which makes it possible to optimize independent
+     * functions concurrently with one manager per thread.
+     *
+     * @param function The `il::Function` to optimize.
+     */
+    void run(il::Function& function) const;
+
     /**
      * @brief Registers a new optimization pass.
      *
@@ -86,8 +200,49 @@ public:
     template <typename Type, typename... Args>
     void add(Args&&... args);
 
+    /**
+     * @brief Returns the registered passes in the order they are run.
+     *
+     * @return The list of passes.
+     */
+    [[nodiscard]] auto& passes() const { return _passes; }
+
+    /**
+     * @brief Returns the analysis cache shared by all passes.
+     *
+     * @return A reference to the `il::AnalysisManager`.
+     */
+    [[nodiscard]] auto& analyses() const { return *_analyses; }
+
+    /**
+     * @brief Measures every run of a pass as its own stage of the report.
+     *
+     * @param report The report the runs are added to, or nullptr to measure nothing.
+     */
+    void set_time_report(utils::TimeReport* report) { _report = report; }
+
+    /**
+     * @brief Collects the counters of all passes, and how many rounds every function took to converge.
+     *
+     * @param statistics The registry the counters are added to, or nullptr to count nothing.
+     */
+    void set_statistics(utils::Statistics* statistics);
+
+private:
+    /**
+     * @brief Runs a single pass over the function and its blocks.
+     *
+     * @param pass The `Pass` to run.
+     * @param function The `il::Function` to optimize.
+     * @return True if the pass changed the function, false otherwise.
+     */
+    bool _run(Pass& pass, il::Function& function) const;
+
 private:
-    std::vector<std::unique_ptr<Pass>> _passes;
+    std::shared_ptr<il::AnalysisManager> _analyses;
+    std::vector<std::unique_ptr<Pass>> _passes{ };
+    utils::TimeReport* _report{ };
+    utils::Statistics* _statistics{ };
 };
 
 #include "../../../src/arkoi_language/opt/pass.tpp"
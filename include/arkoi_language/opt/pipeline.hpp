@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Describes which optimization passes are run, and in which order.
+ *
+ * A pipeline is a list of pass names as returned by `Pass::name`, e.g. "sccp,gvn,inliner".
+ * The function passes are run on every function in the listed order until it converges.
+ * If any module pass is part of the list, e.g. the "inliner", the module passes are run on
+ * the whole module afterward and the function passes are run once more on the result.
+ *
+ * The optimization levels are presets of this list, each one adding more expensive passes:
+ *  - Level 0 runs no pass at all.
+ *  - Level 1 runs the cheap local cleanups (folding, propagation, dead code and CFG simplification).
+ *  - Level 2 adds the global passes (SCCP, GVN, if-conversion, tail recursion) and the module passes
+ *    (compile-time evaluation of calls, interprocedural constant propagation, inlining and dead function
+ *    elimination).
+ *  - Level 3 adds the loop passes (LICM, unrolling and strength reduction).
+ *
+ * The opt-in passes, e.g. the "memoize" pass, change the behavior of the program beyond its speed,
+ * like its memory usage, and are never part of a preset. They have to be listed or appended.
+ *
+ * @see Pass, PassManager
+ */
+class Pipeline {
+public:
+    /// The number of calls to functions of the module from functions that aren't part of it.
+    using ExternalCalls = std::unordered_map<std::string, size_t>;
+
+public:
+    /** @brief The highest optimization level. */
+    static constexpr uint8_t MAX_LEVEL = 3;
+
+    /** @brief The level used if nothing else is requested, which runs every pass. */
+    static constexpr uint8_t DEFAULT_LEVEL = MAX_LEVEL;
+
+public:
+    /**
+     * @brief Constructs an empty pipeline, which runs no pass at all.
+     */
+    Pipeline() = default;
+
+    /**
+     * @brief Returns the preset of an optimization level.
+     *
+     * @param level The optimization level, levels above `MAX_LEVEL` are clamped.
+     * @return The pipeline of the level.
+     */
+    [[nodiscard]] static Pipeline level(uint8_t level);
+
+    /**
+     * @brief Parses a comma separated list of pass names.
+     *
+     * Whitespace around the names is ignored and an empty description runs no pass.
+     *
+     * @param description The list of pass names, e.g. "sccp, gvn, inliner".
+     * @return The parsed pipeline.
+     *
+     * @throws std::invalid_argument If a name doesn't belong to any pass.
+     */
+    [[nodiscard]] static Pipeline parse(std::string_view description);
+
+    /**
+     * @brief Returns the names of all passes that can be part of a pipeline.
+     *
+     * @return The names in the order of the most complete preset, followed by the opt-in passes.
+     */
+    [[nodiscard]] static std::vector<std::string_view> available();
+
+    /**
+     * @brief Appends a pass to the end of the pipeline.
+     *
+     * @param name The name of the pass, e.g. "memoize".
+     *
+     * @throws std::invalid_argument If the name doesn't belong to any pass.
+     */
+    void append(std::string_view name);
+
+    /**
+     * @brief Adds the function passes of the pipeline to the manager, in the listed order.
+     *
+     * @param manager The `PassManager` the passes are added to.
+     */
+    void add_function_passes(PassManager& manager) const;
+
+    /**
+     * @brief Adds the module passes of the pipeline to the manager, in the listed order.
+     *
+     * @param manager The `PassManager` the passes are added to.
+     * @param external_calls The calls to functions of the module from functions that aren't part of it.
+     * @param whole_program If the module holds every function of the program. Otherwise, the passes changing
+     *                      the parameters of functions are left out, as the calls from the code of other
+     *                      compilations, e.g. cached ones, can't be rewritten.
+     */
+    void add_module_passes(
+        PassManager& manager, const ExternalCalls& external_calls = { }, bool whole_program = true
+    ) const;
+
+    /**
+     * @brief Checks if the pipeline has module passes and thus needs to see the whole module.
+     *
+     * @return True if any module pass is part of the pipeline.
+     */
+    [[nodiscard]] bool has_module_passes() const;
+
+    /**
+     * @brief Returns the description of the pipeline, which `parse` turns into the same pipeline again.
+     *
+     * @return The comma separated list of pass names.
+     */
+    [[nodiscard]] std::string describe() const;
+
+    [[nodiscard]] auto& passes() const { return _passes; }
+
+private:
+    std::vector<std::string> _passes{ };
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
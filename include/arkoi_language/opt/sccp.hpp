@@ -0,0 +1,219 @@
+#pragma once
+
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass implementing sparse conditional constant propagation.
+ *
+ * `SCCP` optimistically assumes every variable to be constant and every block
+ * to be unreachable, and only gives up on them while walking the executable
+ * parts of the CFG along the `il::DefUseChains`. Unlike `ConstantPropagation`,
+ * it therefore sees through phis and loops whose incoming values only differ on
+ * edges that can never be taken.
+ *
+ * Afterwards, all variables proven constant are replaced by constant
+ * assignments, `il::If` instructions with a constant condition are turned into
+ * `il::Goto` instructions and unreachable blocks are unlinked from the CFG,
+ * which is then cleaned up by `SimplifyCFG`.
+ *
+ * Example:
+ * `x = 1`
+ * `if x == 1 then L1 else L2`
+ * becomes:
+ * `x = 1`
+ * `goto L1`
+ *
+ * @see Pass, ConstantFolding, ConstantPropagation, SimplifyCFG
+ */
+class SCCP final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "sccp"; }
+
+    /**
+     * @brief The pass folds constants and removes edges between blocks.
+     */
+    [[nodiscard]] Effects effects() const override { return FOLDED_CONSTANTS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief The analysis already reaches a fixpoint, thus running it again is pointless.
+     */
+    [[nodiscard]] Effects triggers() const override { return NO_EFFECTS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Analyzes the function and rewrites it based on the results.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if any instruction or edge was changed, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, the propagation is done for the whole function.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief The lattice value of a variable.
+     */
+    struct Value {
+        enum class Kind {
+            Undefined,
+            Constant,
+            Overdefined,
+        };
+
+        Kind kind = Kind::Undefined;
+        il::Immediate constant{ };
+
+        bool operator==(const Value& other) const = default;
+    };
+
+    using Edge = std::pair<il::BasicBlock*, il::BasicBlock*>;
+
+    /**
+     * @brief Propagates values and reachability until nothing changes anymore.
+     *
+     * @param function The function to analyze.
+     */
+    void _solve(il::Function& function);
+
+    /**
+     * @brief Rewrites the function based on the solved lattice.
+     *
+     * @param function The function to rewrite.
+     * @return True if the function was changed.
+     */
+    [[nodiscard]] bool _rewrite(il::Function& function);
+
+    /**
+     * @brief Evaluates an instruction of an executable block.
+     *
+     * @param instruction The instruction to evaluate.
+     * @param block The block containing the instruction.
+     */
+    void _visit(il::Instruction& instruction, il::BasicBlock& block);
+
+    /**
+     * @brief Marks the outgoing edges of a block, following a constant condition if known.
+     *
+     * @param block The executable block whose successors should be marked.
+     */
+    void _visit_successors(il::BasicBlock& block);
+
+    /**
+     * @brief Queues an edge if it wasn't marked as executable before.
+     *
+     * @param from The source block.
+     * @param to The target block.
+     */
+    void _mark_edge(il::BasicBlock* from, il::BasicBlock* to);
+
+    /**
+     * @brief Lowers the lattice value of a variable and queues its users if it changed.
+     *
+     * @param variable The variable to update.
+     * @param value The newly computed value.
+     */
+    void _update(const il::Variable& variable, const Value& value);
+
+    /**
+     * @brief Returns the current lattice value of an operand.
+     *
+     * @param operand The operand to look up.
+     * @return The lattice value of the operand.
+     */
+    [[nodiscard]] Value _value(const il::Operand& operand) const;
+
+    /**
+     * @brief Returns the constant condition of the block's terminator, if any.
+     *
+     * @param block The block to check.
+     * @return The value of the condition, or std::nullopt if the block doesn't
+     *         end with an `il::If` or the condition is not a constant.
+     */
+    [[nodiscard]] std::optional<bool> _constant_condition(il::BasicBlock& block) const;
+
+    /**
+     * @brief Combines two lattice values.
+     *
+     * @param left The first value.
+     * @param right The second value.
+     * @return The greatest value below both.
+     */
+    [[nodiscard]] static Value _meet(const Value& left, const Value& right);
+
+    /**
+     * @brief Removes the edge between two blocks, including the matching phi incoming values.
+     *
+     * @param from The source block.
+     * @param to The target block.
+     */
+    static void _remove_incoming(il::BasicBlock& from, il::BasicBlock& to);
+
+private:
+    std::unordered_map<il::Variable, Value> _values{ };
+    std::unordered_set<il::BasicBlock*> _executable{ };
+    std::set<Edge> _edges{ };
+    std::vector<Edge> _edge_worklist{ };
+    std::vector<il::Instruction*> _ssa_worklist{ };
+    const il::DefUseChains* _chains{ };
+};
+} // namespace arkoi::opt
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
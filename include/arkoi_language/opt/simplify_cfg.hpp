@@ -1,5 +1,8 @@
 #pragma once
 
+#include <optional>
+
+#include "arkoi_language/il/analyses.hpp"
 #include "arkoi_language/opt/pass.hpp"
 
 namespace arkoi::opt {
@@ -10,11 +13,42 @@ namespace arkoi::opt {
  * 1. Removes "proxy" blocks (blocks that only contain an unconditional jump).
  * 2. Merges blocks that are sequentially connected without branches.
  * 3. Removes unreachable basic blocks.
+ * 4. Folds branches on a constant condition into jumps.
+ * 5. Threads jumps through blocks whose branch is known from the predecessor,
+ *    i.e. the predecessor jumps directly to the successor that would be taken.
+ *
+ * A jump is only threaded through a block of at most `THREADING_BUDGET` instructions
+ * without side effects, whose results are only used within the block itself. Those
+ * only compute the condition, which is already known on the threaded edge, thus the
+ * block doesn't need to be duplicated for it. The outcome is known if the phis of
+ * the block receive constants from the predecessor, or if the predecessor branches
+ * on the same comparison (e.g. an `else if` chain re-testing its condition).
+ *
+ * Example:
+ * `[ a: t = true, goto c ] -> [ c: x = phi [ a: t, b: f ], if x ] -> [ d ]`
+ * becomes:
+ * `[ a: t = true, goto d ]`
  *
- * @see Pass, il::BasicBlock, il::Function
+ * @see Pass, SCCP, il::BasicBlock, il::Function
  */
 class SimplifyCFG final : public Pass {
 public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "simplify-cfg"; }
+
+    /**
+     * @brief Simplification removes and merges blocks.
+     */
+    [[nodiscard]] Effects effects() const override { return CHANGED_BLOCKS; }
+
+    /**
+     * @brief Removed instructions can turn blocks into proxies, folded constants decide branches, and only one
+     * block is simplified per run.
+     */
+    [[nodiscard]] Effects triggers() const override { return FOLDED_CONSTANTS | REMOVED_INSTRUCTIONS | CHANGED_BLOCKS; }
+
     /**
      * @brief No-op for module entry.
      */
@@ -43,6 +77,9 @@ public:
      */
     bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
 
+    /// The most instructions of a block, including its phis and branch, that a jump is threaded through.
+    static constexpr size_t THREADING_BUDGET = 8;
+
 private:
     /**
      * @brief Bypasses a proxy block, connecting its predecessors directly to its successor.
@@ -79,6 +116,71 @@ private:
      * @return True if the block is mergeable.
      */
     [[nodiscard]] static bool is_simple_block(const il::BasicBlock& block);
+
+    /**
+     * @brief Replaces a branch on a constant condition with a jump to the taken successor.
+     *
+     * @param function The containing function.
+     * @param block The block ending with the branch.
+     * @return True if the branch was folded.
+     */
+    [[nodiscard]] bool _fold_branch(il::Function& function, il::BasicBlock& block);
+
+    /**
+     * @brief Redirects a predecessor that knows the outcome of the branch of @p block to the taken successor.
+     *
+     * @param function The containing function.
+     * @param block The block ending with the branch to thread through.
+     * @return True if a jump was threaded.
+     */
+    [[nodiscard]] bool _thread_jump(il::Function& function, il::BasicBlock& block);
+
+    /**
+     * @brief Determines if a jump can be threaded through the block, regardless of the predecessor.
+     *
+     * @param chains The def-use chains of the containing function.
+     * @param block The block ending with a branch.
+     * @return True if the block is small, has no side effects and its results don't leave it.
+     */
+    [[nodiscard]] static bool _is_threadable(const il::DefUseChains& chains, il::BasicBlock& block);
+
+    /**
+     * @brief Evaluates the branch condition of @p block on the edge from @p predecessor.
+     *
+     * @param chains The def-use chains of the containing function.
+     * @param predecessor The predecessor the block is entered from.
+     * @param block The block ending with a branch.
+     * @return The outcome of the branch, or std::nullopt if it isn't known on this edge.
+     */
+    [[nodiscard]] static std::optional<bool> _known_condition(
+        const il::DefUseChains& chains, il::BasicBlock& predecessor, il::BasicBlock& block
+    );
+
+    /**
+     * @brief Derives the result of a comparison from an earlier comparison of the same operands.
+     *
+     * @param tested The comparison whose result is known.
+     * @param value The result of @p tested.
+     * @param binary The comparison to derive.
+     * @return The result of @p binary, or std::nullopt if it doesn't follow from @p tested.
+     */
+    [[nodiscard]] static std::optional<bool> _implied(il::Binary& tested, bool value, il::Binary& binary);
+
+    /**
+     * @brief Removes the edge between two blocks, including the incoming values of the phis of @p to.
+     *
+     * @param from The source of the edge.
+     * @param to The target of the edge.
+     */
+    static void _remove_edge(il::BasicBlock& from, il::BasicBlock& to);
+
+    /**
+     * @brief Removes @p block and every block only reachable through it, if it became unreachable.
+     *
+     * @param function The containing function.
+     * @param block The block that may have lost its last predecessor.
+     */
+    void _remove_unreachable(il::Function& function, il::BasicBlock* block);
 };
 } // namespace arkoi::opt
 
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that places independent pairs of double precision operations next to each other.
+ *
+ * Unrolled loops compute the same operations for every iteration, but the copies of one
+ * operation are separated by the rest of the body. The pass searches each block for the
+ * nearest operation that is isomorphic to another one (see `x86_64::PackedPattern`) and
+ * follows the single uses of both results as long as they stay isomorphic, which forms a
+ * chain of pairs. If packing the chain is profitable, its operations are hoisted up to the
+ * first one, alternating between the lanes. The `x86_64::InstructionSelector` then packs
+ * the adjacent pairs into single SSE instructions, thus the IL itself stays scalar.
+ *
+ * Only operations whose other operands are defined in front of the chain are hoisted, and
+ * the IL operations have no side effects, so hoisting them never changes the result.
+ *
+ * Example:
+ * `a = x / y`, `b = a + c`, `d = z / w`, `e = d + f`
+ * becomes:
+ * `a = x / y`, `d = z / w`, `b = a + c`, `e = d + f`
+ *
+ * @see Pass, LoopUnroll, x86_64::InstructionSelector
+ */
+class SLPVectorizer final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "slp-vectorizer"; }
+
+    /**
+     * @brief Instructions are only reordered inside of their block.
+     */
+    [[nodiscard]] Effects effects() const override { return MOVED_INSTRUCTIONS; }
+
+    /**
+     * @brief The pairs are formed in a single run, but unrolling and simplifications expose new ones.
+     */
+    [[nodiscard]] Effects triggers() const override {
+        return FOLDED_CONSTANTS | REPLACED_OPERANDS | REMOVED_INSTRUCTIONS | CHANGED_BLOCKS;
+    }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Counts the uses of every operand, as only results with a single use continue a chain.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return Always false, as nothing is changed yet.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief Groups the profitable chains of the block, starting from its first instruction.
+     *
+     * @param block The `il::BasicBlock` to optimize.
+     * @return True if any instruction was moved, false otherwise.
+     */
+    bool on_block(il::BasicBlock& block) override;
+
+private:
+    /**
+     * @brief Finds the chain starting with the instruction at @p start, which becomes the lower lane of its first pair.
+     *
+     * @param instructions The instructions of the block.
+     * @param start The index of the first instruction of the chain.
+     * @param definitions The index of every variable defined in the block.
+     * @return The indices of the chain, alternating between the lanes, or nothing if it isn't profitable.
+     */
+    [[nodiscard]] std::vector<size_t> _chain(
+        il::BasicBlock::Instructions& instructions, size_t start,
+        const std::unordered_map<il::Operand, size_t>& definitions
+    );
+
+private:
+    std::unordered_map<il::Operand, size_t> _uses{ };
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that forwards stored values to loads and removes dead stores.
+ *
+ * The `il::SSAPromoter` only promotes the memory slots of an `il::Alloca`, every
+ * other slot keeps its `il::Store` and `il::Load` instructions. A memory slot is
+ * local to its function and only accessed by these instructions, thus the value
+ * it holds is known from the last store or load of the same slot in the block:
+ * 1. A load of a slot with a known value becomes a copy of that value.
+ * 2. A store of the value the slot already holds is removed.
+ * 3. A store that is overwritten in the same block before any load reads it is removed.
+ *
+ * The stores left at the end of a block may still be read by a successor, thus
+ * only `DeadCodeElimination` removes them if no load of the slot is left at all.
+ *
+ * Example:
+ * `%a = store $x.0`
+ * `$y.0 = load %a`
+ * `%a = store $y.0`
+ * becomes:
+ * `%a = store $x.0`
+ * `$y.0 = $x.0`
+ *
+ * @see Pass, DeadCodeElimination, il::SSAPromoter
+ */
+class StoreForwarding final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "store-forwarding"; }
+
+    /**
+     * @brief Loads become copies and stores are removed.
+     */
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS | REMOVED_INSTRUCTIONS; }
+
+    /**
+     * @brief Merging or copying blocks puts stores and loads of different blocks next to each other.
+     */
+    [[nodiscard]] Effects triggers() const override { return CHANGED_BLOCKS | MOVED_INSTRUCTIONS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for function entry.
+     */
+    bool enter_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief Forwards the values of the memory slots within a basic block.
+     *
+     * @param block The `il::BasicBlock` to optimize.
+     * @return True if any load was replaced or any store removed, false otherwise.
+     */
+    bool on_block(il::BasicBlock& block) override;
+};
+} // namespace arkoi::opt
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+
+#include "arkoi_language/opt/pass.hpp"
+
+namespace arkoi::opt {
+/**
+ * @brief Optimization pass that turns self tail calls into loops.
+ *
+ * A call of the function to itself is a tail call if its result is returned
+ * without doing anything else in between, except for copies and merging the
+ * result in a phi. Such calls are replaced by a jump back to a new loop
+ * header, which takes over the instructions of the entry block. The
+ * parameters are replaced by phis in this header, receiving the original
+ * parameters from the entry block and the arguments from every tail call.
+ *
+ * Example:
+ * `fun sum(n, acc): if n == 0: return acc else: return sum(n - 1, acc + n)`
+ * becomes a loop, which neither grows the stack nor calls itself.
+ *
+ * @see Pass, il::Call, il::Phi
+ */
+class TailRecursion final : public Pass {
+public:
+    /**
+     * @brief Identifies the pass in the time report.
+     */
+    [[nodiscard]] std::string_view name() const override { return "tail-recursion"; }
+
+    /**
+     * @brief The calls are replaced by new edges and the parameters by phis.
+     */
+    [[nodiscard]] Effects effects() const override { return REPLACED_OPERANDS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief Removed instructions and merged blocks can leave a call directly in front of its return.
+     */
+    [[nodiscard]] Effects triggers() const override { return REMOVED_INSTRUCTIONS | CHANGED_BLOCKS; }
+
+    /**
+     * @brief No-op for module entry.
+     */
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief No-op for module exit.
+     */
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    /**
+     * @brief Replaces all self tail calls of the function with jumps to the loop header.
+     *
+     * @param function The `il::Function` to optimize.
+     * @return True if a tail call was eliminated, false otherwise.
+     */
+    bool enter_function(il::Function& function) override;
+
+    /**
+     * @brief No-op for function exit.
+     */
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    /**
+     * @brief No-op for blocks, the whole function is rewritten at once.
+     */
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    /**
+     * @brief Moves the entry block into a new loop header and turns the parameters into phis.
+     *
+     * If a previous run already created the header, it is reused.
+     *
+     * @param function The function to rewrite.
+     * @return The loop header.
+     */
+    [[nodiscard]] static il::BasicBlock* _create_header(il::Function& function);
+
+    /**
+     * @brief Replaces the tail call at the given index with a jump to the loop header.
+     *
+     * @param block The block containing the tail call.
+     * @param index The index of the call inside the block.
+     * @param header The loop header created by `_create_header`.
+     */
+    static void _eliminate(il::BasicBlock& block, size_t index, il::BasicBlock& header);
+
+    /**
+     * @brief Determines if the call at the given index is a self tail call.
+     *
+     * @param function The function containing the call.
+     * @param block The block containing the call.
+     * @param index The index of the instruction inside the block.
+     * @return True if the instruction is a call to the function itself whose result is returned directly.
+     */
+    [[nodiscard]] static bool _is_tail_call(il::Function& function, il::BasicBlock& block, size_t index);
+};
+} // namespace arkoi::opt
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
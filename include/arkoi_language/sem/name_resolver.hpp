@@ -1,7 +1,8 @@
 #pragma once
 
-#include <stack>
+#include <optional>
 
+#include "arkoi_language/ast/arena.hpp"
 #include "arkoi_language/ast/visitor.hpp"
 #include "arkoi_language/front/token.hpp"
 #include "arkoi_language/sem/symbol_table.hpp"
@@ -12,10 +13,15 @@ namespace arkoi::sem {
  * @brief Visitor that performs name resolution on the Abstract Syntax Tree (AST).
  *
  * `NameResolver` traverses the AST to associate every `Identifier` node with a
- * specific `Symbol` from the hierarchical `SymbolTable`. It identifies errors
+ * specific `Symbol` from a `SymbolTable`, in which the program, every function
+ * and every block open their own scope. It identifies errors
  * such as duplicate definitions in the same scope or references to undefined
  * variables/functions.
  *
+ * The resolution can be split into `declare`, which registers the functions and their parameters
+ * of a program, and `resolve`, which resolves the body of a single function against them. After
+ * the declaration, the bodies only read the global scope, thus they can be resolved in parallel.
+ *
  * @see ast::Visitor, SymbolTable, Symbol, TypeResolver
  */
 class NameResolver final : ast::Visitor {
@@ -33,6 +39,23 @@ public:
      */
     void visit(ast::Program& node) override;
 
+    /**
+     * @brief Declares the functions of a program and their parameters, without resolving any bodies.
+     *
+     * @param node The `ast::Program` node to declare.
+     * @return The global scope of the program, which the bodies of its functions are resolved against.
+     */
+    [[nodiscard]] SymbolTable declare(ast::Program& node);
+
+    /**
+     * @brief Resolves names within the body of a function, which was declared beforehand.
+     *
+     * @param node The `ast::Function` node to resolve.
+     * @param globals The global scope returned by `declare`, which is only read.
+     * @param arena The arena the local symbols are created in, which no other thread uses meanwhile.
+     */
+    void resolve(ast::Function& node, const SymbolTable& globals, ast::Arena& arena);
+
 private:
     /**
      * @brief First-pass visitor for function prototypes to allow forward references.
@@ -42,7 +65,14 @@ private:
     void visit_as_prototype(ast::Function& node);
 
     /**
-     * @brief Resolves names within a function definition.
+     * @brief Declares the parameters of a function in a scope of their own.
+     *
+     * @param node The `ast::Function` node whose parameters are declared.
+     */
+    void _declare_parameters(ast::Function& node);
+
+    /**
+     * @brief Resolves names within a function definition, whose parameters were already declared.
      *
      * @param node The `ast::Function` node to visit.
      */
@@ -155,7 +185,7 @@ private:
     [[nodiscard]] std::shared_ptr<Symbol> _check_existence(const front::Token& token);
 
 private:
-    std::stack<std::shared_ptr<SymbolTable>> _scopes{ };
+    std::optional<SymbolTable> _table{ };
     utils::Diagnostics& _diagnostics;
 };
 
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <memory>
-#include <unordered_map>
+#include <memory_resource>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "pretty_diagnostics/report.hpp"
 
@@ -11,23 +15,52 @@
 
 namespace arkoi::sem {
 /**
- * @brief Manages symbols within a specific lexical scope.
+ * @brief Manages the symbols of all lexical scopes that are currently open.
  *
- * `SymbolTable` implements a hierarchical symbol mapping. It stores symbols
- * defined in the current scope and maintains a pointer to a parent scope
- * to allow for name resolution in outer scopes (lexical nesting).
+ * `SymbolTable` is a flat scope stack. Every insertion appends a binding, which
+ * shadows the previous binding of the same identifier, and exiting a scope drops
+ * all bindings made since the matching `enter_scope`. The innermost binding of
+ * every identifier is indexed by the id of its interned name, thus neither
+ * insertions nor lookups hash any strings or walk through the enclosing scopes.
  *
- * @see Symbol, Function, Variable
+ * A table may be nested into another one, e.g. the global scope of a program, whose symbols are
+ * found if none of its own matches. The enclosing table is only read, thus the bodies of several
+ * functions can be resolved against the same global scope at once, each of them in a table of its own.
+ *
+ * @see Symbol, Function, Variable, NameResolver
  */
 class SymbolTable {
 public:
     /**
-     * @brief Constructs a `SymbolTable` with an optional parent table.
+     * @brief Constructs an empty `SymbolTable` without any open scope.
+     *
+     * @param resource The memory resource the symbols are allocated from, e.g. of an `ast::Arena`.
+     */
+    explicit SymbolTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+        _resource(resource) { }
+
+    /**
+     * @brief Constructs an empty `SymbolTable` nested into @p enclosing, without any open scope.
+     *
+     * @param enclosing The table searched by lookups that find no symbol in this one, which needs to outlive it.
+     * @param resource The memory resource the symbols are allocated from, e.g. of an `ast::Arena`.
+     */
+    SymbolTable(const SymbolTable* enclosing, std::pmr::memory_resource* resource) :
+        _enclosing(enclosing), _resource(resource) { }
+
+    /**
+     * @brief Opens a new scope nested into the current one.
+     */
+    void enter_scope();
+
+    /**
+     * @brief Closes the current scope and drops all of its bindings.
+     *
+     * The symbols themselves stay alive as long as they are referenced, e.g. by the AST.
      *
-     * @param parent A shared pointer to the enclosing scope's symbol table.
+     * @throws std::logic_error if there is no open scope.
      */
-    explicit SymbolTable(std::shared_ptr<SymbolTable> parent = nullptr) :
-        _parent(std::move(parent)) { }
+    void exit_scope();
 
     /**
      * @brief Creates and inserts a new symbol into the current scope.
@@ -36,28 +69,60 @@ public:
      * @tparam Args Argument types for the symbol's constructor.
      * @param identifier The identifier token for the symbol.
      * @param args Arguments to pass to the symbol constructor.
-     * @return A shared pointer to the newly created `Symbol`.
+     * @return A reference to the newly created `Symbol`, which is valid until the next insertion.
      * @throws IdentifierAlreadyTaken if the @p name already exists in the current scope.
+     * @throws std::logic_error if there is no open scope.
      */
     template <typename Type, typename... Args>
-    std::shared_ptr<Symbol>& insert(const front::Token& identifier, Args&&... args);
+    const std::shared_ptr<Symbol>& insert(const front::Token& identifier, Args&&... args);
 
     /**
-     * @brief Resolves a symbol by name, searching current and parent scopes.
+     * @brief Binds an already existing @p symbol in the current scope, e.g. a parameter declared with its function.
      *
-     * This method implements lexical scoping rules.
+     * The symbol was already checked for conflicts when it was inserted, thus it simply shadows other bindings.
+     *
+     * @param symbol The symbol to bind to its name.
+     * @throws std::logic_error if there is no open scope.
+     */
+    void bind(const std::shared_ptr<Symbol>& symbol);
+
+    /**
+     * @brief Resolves a symbol by name, searching from the innermost to the outermost binding.
+     *
+     * This method implements lexical scoping rules, bindings of other symbol kinds are skipped.
+     * If no binding of this table matches, the enclosing table is searched.
      *
      * @tparam Types Optional filter for allowed symbol types.
      * @param identifier The identifier token to search for.
-     * @return A reference to the shared pointer of the found `Symbol`.
+     * @return A reference to the found `Symbol`, which is valid until the next insertion.
      * @throws IdentifierNotFound if the symbol is not found in any accessible scope.
      */
     template <typename... Types>
-    [[nodiscard]] std::shared_ptr<Symbol>& lookup(const front::Token& identifier);
+    [[nodiscard]] const std::shared_ptr<Symbol>& lookup(const front::Token& identifier) const;
+
+private:
+    static constexpr auto NONE = std::numeric_limits<size_t>::max();
+
+    /**
+     * @brief A symbol bound to an identifier in one of the open scopes.
+     */
+    struct Binding {
+        std::shared_ptr<Symbol> symbol;
+        size_t shadowed;
+        uint32_t atom;
+    };
+
+    /**
+     * @brief Returns the index of the innermost binding of an identifier, or `NONE` if it's unbound.
+     */
+    [[nodiscard]] size_t _innermost_of(const front::Token& identifier) const;
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<Symbol>> _symbols{ };
-    std::shared_ptr<SymbolTable> _parent;
+    std::vector<Binding> _bindings{ };
+    std::vector<size_t> _innermost{ };
+    std::vector<size_t> _scopes{ };
+    const SymbolTable* _enclosing{ };
+    std::pmr::memory_resource* _resource;
 };
 
 /**
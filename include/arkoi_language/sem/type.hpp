@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstdint>
-#include <variant>
+#include <optional>
+#include <ostream>
+#include <utility>
 
+#include "arkoi_language/utils/output_buffer.hpp"
 #include "arkoi_language/utils/size.hpp"
 
 namespace arkoi::sem {
@@ -25,7 +28,7 @@ public:
      *
      * @return The `Size` enumeration value.
      */
-    [[nodiscard]] Size size() const { return _size; }
+    [[nodiscard]] constexpr Size size() const { return _size; }
 
     /**
      * @brief Checks if two integral types have the same size and signess.
@@ -33,15 +36,7 @@ public:
      * @param other Right-hand integral type.
      * @return True if both types have the same size and signess.
      */
-    bool operator==(const Integral& other) const;
-
-    /**
-     * @brief Inequality based on `==`.
-     *
-     * @param other Right-hand integral type.
-     * @return True if the types differ.
-     */
-    bool operator!=(const Integral& other) const;
+    constexpr bool operator==(const Integral& other) const = default;
 
     /**
      * @brief Returns the maximum representable value for this integral type.
@@ -55,7 +50,7 @@ public:
      *
      * @return True if signed, false otherwise.
      */
-    [[nodiscard]] auto sign() const { return _sign; }
+    [[nodiscard]] constexpr bool sign() const { return _sign; }
 
 private:
     Size _size;
@@ -72,7 +67,7 @@ public:
      *
      * @param size The size of the float (e.g., DWORD for f32, QWORD for f64).
      */
-    explicit Floating(const Size size) :
+    constexpr explicit Floating(const Size size) :
         _size(size) { }
 
     /**
@@ -80,7 +75,7 @@ public:
      *
      * @return The `Size` enumeration value.
      */
-    [[nodiscard]] Size size() const { return _size; }
+    [[nodiscard]] constexpr Size size() const { return _size; }
 
     /**
      * @brief Equality compares only the size.
@@ -88,15 +83,7 @@ public:
      * @param other Right-hand floating type.
      * @return True if both types have the same size.
      */
-    bool operator==(const Floating& other) const;
-
-    /**
-     * @brief Inequality based on `==`.
-     *
-     * @param other Right-hand floating type.
-     * @return True if the types differ.
-     */
-    bool operator!=(const Floating& other) const;
+    constexpr bool operator==(const Floating& other) const = default;
 
 private:
     Size _size{ };
@@ -115,7 +102,7 @@ public:
      * @return Always returns `Size::BYTE`.
      */
     // ReSharper disable once CppMemberFunctionMayBeStatic
-    [[nodiscard]] Size size() const { return Size::BYTE; }
+    [[nodiscard]] constexpr Size size() const { return Size::BYTE; }
 
     /**
      * @brief Equality will always be true.
@@ -123,35 +110,152 @@ public:
      * @param other Right-hand boolean type.
      * @return Always true as boolean types can't differ.
      */
-    bool operator==(const Boolean& other) const;
-
-    /**
-     * @brief Inequality based on `==`.
-     *
-     * @param other Right-hand boolean type.
-     * @return True if the types differ.
-     */
-    bool operator!=(const Boolean& other) const;
+    constexpr bool operator==(const Boolean& other) const = default;
 };
 
 /**
- * @brief A type-safe container for any semantic type.
+ * @brief A packed handle of any semantic type.
  *
- * `Type` is a `std::variant` of `Integral`, `Floating`, and `Boolean`.
- * It provides a uniform interface for type operations while preserving
- * concrete type information.
+ * `Type` stores the kind of an `Integral`, `Floating` or `Boolean` together with
+ * its size and signess in three bytes. It is implicitly constructed from each of
+ * them, while all queries are constexpr integer compares instead of a variant
+ * visitation. The concrete types are recovered by `integral`, `floating` or `visit`.
  */
-struct Type final : std::variant<Integral, Floating, Boolean> {
-    using variant::variant;
+class Type final {
+public:
+    /**
+     * @brief The kind of semantic type, which selects the meaning of the size and signess.
+     */
+    enum class Kind : uint8_t {
+        Integral, ///< An `Integral` type.
+        Floating, ///< A `Floating` type.
+        Boolean,  ///< The `Boolean` type.
+    };
+
+public:
+    /**
+     * @brief Constructs the handle of an `Integral` type.
+     *
+     * @param type The integral type.
+     */
+    constexpr Type(const Integral& type) :
+        _kind(Kind::Integral), _bytes(static_cast<uint8_t>(type.size())), _sign(type.sign()) { }
+
+    /**
+     * @brief Constructs the handle of a `Floating` type.
+     *
+     * @param type The floating type.
+     */
+    constexpr Type(const Floating& type) :
+        _kind(Kind::Floating), _bytes(static_cast<uint8_t>(type.size())) { }
+
+    /**
+     * @brief Constructs the handle of the `Boolean` type.
+     *
+     * @param type The boolean type.
+     */
+    constexpr Type(const Boolean& type) :
+        _kind(Kind::Boolean), _bytes(static_cast<uint8_t>(type.size())) { }
+
+    /**
+     * @brief Returns the kind of the type.
+     *
+     * @return The `Kind` enumeration value.
+     */
+    [[nodiscard]] constexpr Kind kind() const { return _kind; }
+
+    /**
+     * @brief Returns the storage size of the type.
+     *
+     * @return The `Size` enumeration value.
+     */
+    [[nodiscard]] constexpr Size size() const { return static_cast<Size>(_bytes); }
+
+    /**
+     * @brief Returns whether the type is a signed integral type.
+     *
+     * @return True if signed, false otherwise and for all non-integral types.
+     */
+    [[nodiscard]] constexpr bool sign() const { return _sign; }
+
+    /**
+     * @brief Checks if the type is an `Integral` type.
+     *
+     * @return True if the kind is `Kind::Integral`.
+     */
+    [[nodiscard]] constexpr bool is_integral() const { return _kind == Kind::Integral; }
 
     /**
-     * @brief Returns the size of the underlying type.
+     * @brief Checks if the type is a `Floating` type.
      *
-     * @return The `Size` of the active type variant.
+     * @return True if the kind is `Kind::Floating`.
      */
-    [[nodiscard]] Size size() const;
+    [[nodiscard]] constexpr bool is_floating() const { return _kind == Kind::Floating; }
+
+    /**
+     * @brief Checks if the type is the `Boolean` type.
+     *
+     * @return True if the kind is `Kind::Boolean`.
+     */
+    [[nodiscard]] constexpr bool is_boolean() const { return _kind == Kind::Boolean; }
+
+    /**
+     * @brief Returns the type as `Integral`.
+     *
+     * @return The `Integral` type, or std::nullopt if the type is not integral.
+     */
+    [[nodiscard]] constexpr std::optional<Integral> integral() const {
+        if (!is_integral()) return std::nullopt;
+        return Integral(size(), _sign);
+    }
+
+    /**
+     * @brief Returns the type as `Floating`.
+     *
+     * @return The `Floating` type, or std::nullopt if the type is not floating.
+     */
+    [[nodiscard]] constexpr std::optional<Floating> floating() const {
+        if (!is_floating()) return std::nullopt;
+        return Floating(size());
+    }
+
+    /**
+     * @brief Calls the visitor with the concrete type, similar to `std::visit`.
+     *
+     * @tparam Visitor A callable accepting an `Integral`, `Floating` and `Boolean`,
+     *                 which returns the same type for each of them.
+     * @param visitor The visitor to call.
+     * @return The result of the visitor.
+     */
+    template <typename Visitor>
+    constexpr decltype(auto) visit(Visitor&& visitor) const;
+
+    /**
+     * @brief Checks if both types have the same kind, size and signess.
+     *
+     * @param other Right-hand type.
+     * @return True if both types are equal.
+     */
+    constexpr bool operator==(const Type& other) const = default;
+
+private:
+    Kind _kind;
+    uint8_t _bytes;
+    bool _sign{ };
 };
 
+/**
+ * @brief Calls the visitor with the concrete types of both handles, similar to `std::visit`.
+ *
+ * @tparam Visitor A callable accepting every combination of `Integral`, `Floating` and `Boolean`.
+ * @param visitor The visitor to call.
+ * @param first The type passed as first argument.
+ * @param second The type passed as second argument.
+ * @return The result of the visitor.
+ */
+template <typename Visitor>
+constexpr decltype(auto) visit(Visitor&& visitor, const Type& first, const Type& second);
+
 /**
  * @brief Streams a detailed description of an `Integral`.
  *
@@ -161,6 +265,15 @@ struct Type final : std::variant<Integral, Floating, Boolean> {
  */
 std::ostream& operator<<(std::ostream& os, const Integral& type);
 
+/**
+ * @brief Appends the textual representation of `Integral` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param type The integral type to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Integral& type);
+
 /**
  * @brief Streams a detailed description of a `Floating`.
  *
@@ -170,6 +283,15 @@ std::ostream& operator<<(std::ostream& os, const Integral& type);
  */
 std::ostream& operator<<(std::ostream& os, const Floating& type);
 
+/**
+ * @brief Appends the textual representation of `Floating` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param type The floating type to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Floating& type);
+
 /**
  * @brief Streams a detailed description of a `Boolean`.
  *
@@ -179,6 +301,15 @@ std::ostream& operator<<(std::ostream& os, const Floating& type);
  */
 std::ostream& operator<<(std::ostream& os, const Boolean& type);
 
+/**
+ * @brief Appends the textual representation of `Boolean` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param type The boolean type to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Boolean& type);
+
 /**
  * @brief Streams a detailed description of a `sem::Type`.
  *
@@ -187,6 +318,17 @@ std::ostream& operator<<(std::ostream& os, const Boolean& type);
  * @return A reference to the output stream @p os.
  */
 std::ostream& operator<<(std::ostream& os, const Type& type);
+
+/**
+ * @brief Appends the textual representation of `sem::Type` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param type The type to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Type& type);
+
+#include "../../../src/arkoi_language/sem/type.tpp"
 } // namespace arkoi::sem
 
 //==============================================================================
@@ -13,6 +13,9 @@ namespace arkoi::sem {
  * operand types for operators, and ensures that function return values match
  * their declarations.
  *
+ * Just like the `NameResolver`, the resolution can be split into `declare` and `resolve`, thus
+ * the bodies of the functions can be resolved in parallel once their prototypes are known.
+ *
  * @see ast::Visitor, Type, NameResolver
  */
 class TypeResolver final : ast::Visitor {
@@ -30,6 +33,21 @@ public:
      */
     void visit(ast::Program& node) override;
 
+    /**
+     * @brief Resolves the parameter and return types of all functions, without resolving any bodies.
+     *
+     * @param node The `Program` node to declare.
+     */
+    void declare(ast::Program& node);
+
+    /**
+     * @brief Resolves types within the body of a function, which was declared beforehand.
+     *
+     * @param node The `Function` node to resolve.
+     * @param arena The arena implicit casts are created in, which no other thread uses meanwhile.
+     */
+    void resolve(ast::Function& node, ast::Arena& arena);
+
 private:
     /**
      * @brief First-pass visitor for function prototypes.
@@ -174,11 +192,12 @@ private:
      * @param node The expression `Node` to wrap.
      * @param from The current type of the node.
      * @param to The target type of the cast.
-     * @return A unique pointer to the new `ast::Cast` node.
+     * @return The owning pointer to the new `ast::Cast` node, which lives in the arena of the program.
      */
-    static std::unique_ptr<ast::Node> _cast(std::unique_ptr<ast::Node>& node, const Type& from, const Type& to);
+    ast::Owned<ast::Node> _cast(ast::Owned<ast::Node>& node, const Type& from, const Type& to);
 
 private:
+    ast::Arena* _arena{ };
     std::optional<Type> _current_type{ }, _return_type{ };
     utils::Diagnostics& _diagnostics;
 };
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace arkoi::utils {
+/**
+ * @brief A dense, growable set of small non-negative integers.
+ *
+ * Every index is represented by a single bit, packed into 64-bit words. Set
+ * operations like union, difference and equality are word-parallel loops,
+ * which the compiler vectorizes when the target supports it.
+ *
+ * Bits beyond the current size are treated as zero, thus vectors of
+ * different sizes can be combined and compared freely.
+ */
+class BitVector {
+public:
+    using Word = uint64_t;
+
+    static constexpr size_t WORD_BITS = sizeof(Word) * 8;
+
+    /**
+     * @brief Iterates over the indices of all set bits in ascending order.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = size_t;
+
+        const_iterator() = default;
+
+        const_iterator(const std::vector<Word>* words, size_t word);
+
+        size_t operator*() const { return _word * WORD_BITS + std::countr_zero(_current); }
+
+        const_iterator& operator++();
+
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const;
+
+    private:
+        void _skip_empty();
+
+    private:
+        const std::vector<Word>* _words{ };
+        size_t _word{ };
+        Word _current{ };
+    };
+
+public:
+    BitVector() = default;
+
+    /**
+     * @brief Constructs a bit vector that can hold @p bits without growing.
+     *
+     * @param bits The amount of bits that should be reserved.
+     */
+    explicit BitVector(const size_t bits) :
+        _words((bits + WORD_BITS - 1) / WORD_BITS, 0) { }
+
+    /**
+     * @brief Sets the bit at @p index, growing the vector if necessary.
+     *
+     * @param index The index of the bit.
+     * @return True if the bit was not set before.
+     */
+    bool set(size_t index);
+
+    /**
+     * @brief Clears the bit at @p index.
+     *
+     * @param index The index of the bit.
+     * @return True if the bit was set before.
+     */
+    bool reset(size_t index);
+
+    /**
+     * @brief Checks if the bit at @p index is set.
+     *
+     * @param index The index of the bit.
+     * @return True if the bit is set.
+     */
+    [[nodiscard]] bool test(const size_t index) const {
+        const auto word = index / WORD_BITS;
+        if (word >= _words.size()) return false;
+        return (_words[word] >> (index % WORD_BITS)) & 1;
+    }
+
+    /**
+     * @brief Adds all bits of @p other to this vector (union).
+     *
+     * @param other The bits to add.
+     * @return A reference to this vector.
+     */
+    BitVector& operator|=(const BitVector& other);
+
+    /**
+     * @brief Keeps only the bits that are also set in @p other (intersection).
+     *
+     * @param other The bits to keep.
+     * @return A reference to this vector.
+     */
+    BitVector& operator&=(const BitVector& other);
+
+    /**
+     * @brief Removes all bits of @p other from this vector (difference).
+     *
+     * @param other The bits to remove.
+     * @return A reference to this vector.
+     */
+    BitVector& operator-=(const BitVector& other);
+
+    /**
+     * @brief Checks if both vectors contain exactly the same bits.
+     *
+     * @param other Right-hand vector.
+     * @return True if the set bits are equal, regardless of the sizes.
+     */
+    bool operator==(const BitVector& other) const;
+
+    /**
+     * @brief Counts the set bits.
+     *
+     * @return The amount of set bits.
+     */
+    [[nodiscard]] size_t count() const;
+
+    /**
+     * @brief Checks if no bit is set.
+     *
+     * @return True if the vector is empty.
+     */
+    [[nodiscard]] bool none() const;
+
+    /**
+     * @brief Clears all bits, while keeping the allocated words.
+     */
+    void clear();
+
+    const_iterator begin() const { return { &_words, 0 }; }
+
+    const_iterator end() const { return { &_words, _words.size() }; }
+
+private:
+    std::vector<Word> _words{ };
+};
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arkoi::utils {
+/**
+ * @brief An on-disk cache of the files produced by compiling a single source.
+ *
+ * Every entry is a directory named after its key, holding one file per artifact (e.g. the
+ * assembly or the object) and the diagnostics printed when the entry was compiled. As the
+ * key covers the source bytes, the compiler build and the configuration, a hit can replace
+ * the whole pipeline by copying the stored artifacts to their destinations. Entries can also
+ * consist of blobs that are read into memory, e.g. the code of a single function.
+ *
+ * Entries are written to a temporary directory first and renamed afterward, thus concurrent
+ * compilers sharing the same cache never observe a partially written entry. The size of the
+ * cache is only scanned once, afterward the size of every stored entry is added to it. Once
+ * the limit is exceeded, the cache is scanned again and the least recently used entries are
+ * evicted until it fits into its size limit again. Thus storing the functions of a source one
+ * by one doesn't scan the whole cache each time.
+ *
+ * The cache never fails a compilation: any I/O error is treated like a miss and simply
+ * results in the source being compiled again.
+ */
+class Cache {
+public:
+    /**
+     * @brief A file produced by the compiler, which is stored in and restored from an entry.
+     */
+    struct Artifact {
+        /// The name of the artifact inside of the entry, e.g. "s" for the assembly.
+        std::string name;
+
+        /// The destination file the artifact is written to.
+        std::filesystem::path path;
+    };
+
+    /**
+     * @brief The contents of a file of an entry, which are kept in memory instead of a file.
+     */
+    struct Blob {
+        /// The name of the blob inside of the entry.
+        std::string name;
+
+        /// The bytes of the blob.
+        std::string contents;
+    };
+
+public:
+    /**
+     * @brief Constructs a `Cache` in the given directory, which is created if needed.
+     *
+     * @param directory The directory the entries are stored in.
+     * @param limit The maximum amount of bytes all entries together may occupy.
+     */
+    Cache(std::filesystem::path directory, size_t limit);
+
+    /**
+     * @brief Computes the key of an entry.
+     *
+     * The key is a 128-bit FNV-1a hash of the source, the configuration and a stamp of the
+     * running compiler executable, thus rebuilding the compiler invalidates all entries.
+     *
+     * @param contents The bytes of the source.
+     * @param configuration Everything else that changes the artifacts, e.g. the version and flags.
+     * @return The key as hexadecimal string.
+     */
+    [[nodiscard]] std::string key(std::string_view contents, std::string_view configuration) const;
+
+    /**
+     * @brief Copies the artifacts of an entry to their destinations.
+     *
+     * @param key The key of the entry.
+     * @param artifacts The artifacts to restore, all of them need to be present in the entry.
+     * @return The stored diagnostics on a hit, or std::nullopt on a miss.
+     */
+    [[nodiscard]] std::optional<std::string> restore(const std::string& key, const std::vector<Artifact>& artifacts) const;
+
+    /**
+     * @brief Stores the artifacts as entry and evicts old entries afterward.
+     *
+     * @param key The key of the entry.
+     * @param artifacts The artifacts to store, which must have been written already.
+     * @param diagnostics The diagnostics that are replayed on a hit.
+     */
+    void store(const std::string& key, const std::vector<Artifact>& artifacts, std::string_view diagnostics) const;
+
+    /**
+     * @brief Reads the blobs of an entry into memory.
+     *
+     * @param key The key of the entry.
+     * @param names The names of the blobs to read, all of them need to be present in the entry.
+     * @return The contents of the blobs in the order of @p names on a hit, or std::nullopt on a miss.
+     */
+    [[nodiscard]] std::optional<std::vector<std::string>> load(
+        const std::string& key, const std::vector<std::string>& names
+    ) const;
+
+    /**
+     * @brief Stores the blobs as entry and evicts old entries afterward.
+     *
+     * @param key The key of the entry.
+     * @param blobs The blobs to store.
+     */
+    void save(const std::string& key, const std::vector<Blob>& blobs) const;
+
+private:
+    /**
+     * @brief Writes a new entry into a temporary directory first, which is renamed to the key afterward.
+     *
+     * @param key The key of the entry.
+     * @param write Fills the temporary directory, which returns false if any of the files couldn't be written.
+     */
+    void _commit(const std::string& key, const std::function<bool(const std::filesystem::path&)>& write) const;
+
+    /**
+     * @brief Marks the entry as recently used, thus it's evicted last.
+     */
+    static void _touch(const std::filesystem::path& entry);
+
+    /**
+     * @brief Adds a stored entry to the size of the cache, which evicts old entries if it exceeds the limit.
+     *
+     * @param size The amount of bytes the entry occupies.
+     */
+    void _account(uintmax_t size) const;
+
+    /**
+     * @brief Removes the least recently used entries until all of them fit into the limit.
+     *
+     * @return The amount of bytes the remaining entries occupy.
+     */
+    [[nodiscard]] uintmax_t _evict() const;
+
+private:
+    std::filesystem::path _directory;
+    std::string _stamp;
+    size_t _limit;
+
+    // Units are compiled in parallel, all of them storing their entries in the same cache.
+    mutable std::mutex _mutex{ };
+    mutable std::optional<uintmax_t> _size{ };
+};
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
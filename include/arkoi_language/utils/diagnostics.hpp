@@ -22,6 +22,13 @@ public:
      */
     void add(pretty_diagnostics::Report report);
 
+    /**
+     * @brief Appends all reports of @p other, e.g. collected while a function was analyzed on another thread.
+     *
+     * @param other The diagnostics whose reports are moved into this collection.
+     */
+    void merge(Diagnostics&& other);
+
     /**
      * @brief Checks if any errors have been reported.
      *
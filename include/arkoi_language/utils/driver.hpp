@@ -2,10 +2,26 @@
 
 #include "pretty_diagnostics/source.hpp"
 
+#include <array>
+#include <chrono>
 #include <filesystem>
+#include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "arkoi_language/il/profile.hpp"
+#include "arkoi_language/opt/pipeline.hpp"
+#include "arkoi_language/utils/cache.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+#include "arkoi_language/utils/thread_pool.hpp"
+#include "arkoi_language/utils/time_report.hpp"
+#include "arkoi_language/x86_64/allocator.hpp"
+#include "arkoi_language/x86_64/encoder.hpp"
+#include "arkoi_language/x86_64/generator.hpp"
+#include "arkoi_language/x86_64/target.hpp"
+
 namespace arkoi::utils {
 /**
  * @brief Generate a unique temporary filesystem path.
@@ -17,11 +33,56 @@ namespace arkoi::utils {
  */
 std::filesystem::path generate_temp_path();
 
+/**
+ * @brief How the generated code is instrumented or optimized with the counts of an earlier run.
+ */
+struct ProfileOptions {
+    /// The file the instrumented program writes its block counts to, std::nullopt if it isn't instrumented.
+    std::optional<std::string> generate{ };
+    /// The profile every function is annotated with before it's optimized, if any.
+    const il::Profile* use{ };
+};
+
+/**
+ * @brief How the backend lays out the generated code, independent of the optimization passes.
+ */
+struct CodegenOptions {
+    /// Whether the stack slots are addressed relative to RSP, which keeps RBP free and skips its setup.
+    bool omit_frame_pointer{ };
+    /// The instruction set extensions the generated code may use, which is baseline x86-64 by default.
+    x86_64::Target target{ };
+    /// Whether a floating point multiplication and its addition are contracted into a single FMA instruction.
+    bool contract{ };
+    /// Whether the instructions of every block are reordered to hide the latency of divisions and conversions.
+    bool schedule{ };
+    /// How many ".loc" directives map the generated code back to the lines of the source.
+    x86_64::DebugInfo debug_info{ x86_64::DebugInfo::Full };
+};
+
+/**
+ * @brief The standard streams and the working directory of the command line a process is started for.
+ *
+ * By default these are the ones of the compiler itself. A server executes the command lines of several
+ * clients at once, thus it passes the ones of the client instead of replacing those of the whole process.
+ */
+struct Invocation {
+    /// The descriptors the standard input, output and error of the started processes are duplicated from.
+    std::array<int, 3> descriptors{ 0, 1, 2 };
+    /// The working directory of the started processes, empty to keep the one of the compiler.
+    std::filesystem::path directory{ };
+    /// The stream the compiler reports the results of the started processes to, e.g. their exit code.
+    std::ostream* output{ &std::cout };
+    /// The stream the compiler reports the failures of the started processes to, e.g. a crash.
+    std::ostream* error{ &std::cerr };
+};
+
 /**
  * @brief Compile a source unit through the entire compilation pipeline.
  *
  * This function coordinates the front-end (parsing, semantic analysis),
  * intermediate representation generation, optimizations, and back-end (code generation).
+ * A source ending in ".il" holds IL as printed by the `il::ILPrinter`, which is parsed
+ * instead and only passes through the optimizations and the back-end.
  *
  * @param source The source input with diagnostic support from `pretty_diagnostics`.
  * @param il_ostream Optional output stream for the intermediate language (IL).
@@ -29,53 +90,173 @@ std::filesystem::path generate_temp_path();
  * @param cfg_ostream Optional output stream for the control-flow graph (CFG).
  *                    If provided, the CFG will be printed in DOT format.
  * @param asm_ostream Optional output stream for the generated x86-64 assembly.
+ * @param obj_ostream Optional output stream for the relocatable ELF object, which is encoded
+ *                    in-process without invoking an external assembler.
+ * @param encoder Optional encoder the machine code is encoded into, e.g. to run it with `run_jit`.
+ * @param jobs The amount of threads used for the per-function stages (SSA construction,
+ *             optimization, phi lowering and register allocation). The generated output
+ *             does not depend on this value.
+ * @param allocator The register allocation algorithm used for every function.
+ * @param error_ostream The output stream the diagnostics are rendered to.
+ * @param cache Optional cache the code of single functions is stored in. If code is generated, only the
+ *              functions whose fingerprint misses are compiled, all others are stitched in from the cache.
+ * @param configuration Everything besides the source that changes the generated code, e.g. the version and
+ *                      the allocator, which is part of the keys of the cached functions.
+ * @param report Optional report every stage of the compilation is measured in.
+ * @param pipeline The optimization passes run on every function, which needs to be part of the
+ *                 configuration of the cached functions as well.
+ * @param statistics Optional registry the passes and the backend count what they changed in.
+ * @param profile The instrumentation or the profile the code is generated with, which needs to be part of
+ *                the configuration of the cached functions as well.
+ * @param codegen The options of the backend, which needs to be part of the configuration of the cached
+ *                functions as well.
+ * @param warm_pool Optional pool the per-function stages run on instead of a pool of @p jobs threads
+ *                  started for this source, e.g. the one a server keeps alive between its requests.
  *
  * @return The compilation status code (0 on success, non-zero on failure).
  * @see assemble, link
  */
 int32_t compile(
     const std::shared_ptr<pretty_diagnostics::Source>& source,
-    std::ofstream* il_ostream,
-    std::ofstream* cfg_ostream,
-    std::ofstream* asm_ostream
+    std::ostream* il_ostream,
+    std::ostream* cfg_ostream,
+    std::ostream* asm_ostream,
+    std::ostream* obj_ostream = nullptr,
+    x86_64::Encoder* encoder = nullptr,
+    size_t jobs = 1,
+    x86_64::AllocatorKind allocator = x86_64::AllocatorKind::GraphColoring,
+    std::ostream& error_ostream = std::cerr,
+    const Cache* cache = nullptr,
+    std::string_view configuration = { },
+    TimeReport* report = nullptr,
+    const opt::Pipeline& pipeline = opt::Pipeline::level(opt::Pipeline::DEFAULT_LEVEL),
+    Statistics* statistics = nullptr,
+    const ProfileOptions& profile = { },
+    const CodegenOptions& codegen = { },
+    ThreadPool* warm_pool = nullptr
 );
 
+/**
+ * @brief The measurements of a single run of a compiled binary.
+ */
+struct RunStatistics {
+    /// The wall time from starting the program until it exited.
+    std::chrono::nanoseconds wall{ };
+    /// The CPU cycles the program spent in user space, empty if no performance counters are available.
+    std::optional<uint64_t> cycles{ };
+};
+
 /**
  * @brief Execute a compiled binary and capture its result.
  *
  * @param path The filesystem path to the executable binary.
+ * @param statistics Optional statistics the run is measured in. The cycles are counted with
+ *                   `perf_event_open`, which starts counting once the binary is executed.
+ * @param invocation The streams and the working directory the binary is executed with.
  *
  * @return The exit code returned by the executed program.
  */
-int32_t run_binary(const std::string& path);
+int32_t run_binary(const std::string& path, RunStatistics* statistics = nullptr, const Invocation& invocation = { });
+
+/**
+ * @brief Execute the encoded modules in-process without assembling, linking or writing a binary.
+ *
+ * The modules are loaded into executable memory and `main` is called directly in a forked
+ * child, which then exits with its result like `_start` would. Crashes of the program are
+ * thus reported the same way as by `run_binary`.
+ *
+ * @param modules The finished encoders of all sources of the program.
+ * @param invocation The streams the result of the program is reported to.
+ *
+ * @return The exit code returned by the executed program.
+ * @see run_binary
+ */
+int32_t run_jit(const std::vector<x86_64::Encoder>& modules, const Invocation& invocation = { });
 
 /**
  * @brief Link object files into a final executable output.
  *
- * This typically invokes the system linker (e.g., `ld` or `gcc`).
+ * This typically invokes the system linker (e.g., `ld` or `gcc`), which is started directly
+ * without a shell in between.
  *
  * @param object_files A list of paths to object files to be linked.
  * @param output Output stream for capturing linker messages (stdout/stderr).
  * @param verbose If true, enables verbose output from the linker.
+ * @param invocation The streams and the working directory the linker is started with.
  *
  * @return The linker exit code (0 on success, non-zero on failure).
  * @see assemble
  */
-int32_t link(const std::vector<std::string>& object_files, std::ofstream& output, bool verbose = false);
+int32_t link(
+    const std::vector<std::string>& object_files,
+    std::ofstream& output,
+    bool verbose = false,
+    const Invocation& invocation = { }
+);
 
 /**
  * @brief Assemble an assembly file into a relocatable object file.
  *
- * This typically invokes a system assembler (e.g., `nasm` or `as`).
+ * This typically invokes a system assembler (e.g., `nasm` or `as`), which is started directly
+ * without a shell in between. The object is written to an anonymous file in memory and copied
+ * to @p output from there.
  *
  * @param input_file Path to the assembly source file (.s or .asm).
- * @param output Output stream for capturing assembler messages (stdout/stderr).
+ * @param output Output stream the relocatable object is written to.
  * @param verbose If true, enables verbose output from the assembler.
+ * @param invocation The streams and the working directory the assembler is started with.
  *
  * @return The assembler exit code (0 on success, non-zero on failure).
- * @see compile, link
+ * @see compile, link, assemble_listing
  */
-int32_t assemble(const std::string& input_file, std::ofstream& output, bool verbose = false);
+int32_t assemble(
+    const std::string& input_file,
+    std::ostream& output,
+    bool verbose = false,
+    const Invocation& invocation = { }
+);
+
+/**
+ * @brief Assemble an assembly listing held in memory into a relocatable object file.
+ *
+ * The listing is handed to the assembler through an anonymous file in memory, thus
+ * neither the listing nor the object is ever written to the disk.
+ *
+ * @param listing The assembly source, e.g. as written by `compile`.
+ * @param output Output stream the relocatable object is written to.
+ * @param verbose If true, enables verbose output from the assembler.
+ * @param invocation The streams and the working directory the assembler is started with.
+ *
+ * @return The assembler exit code (0 on success, non-zero on failure).
+ * @see assemble, assemble_listings
+ */
+int32_t assemble_listing(
+    std::string_view listing,
+    std::ostream& output,
+    bool verbose = false,
+    const Invocation& invocation = { }
+);
+
+/**
+ * @brief Assemble several listings held in memory at once, one assembler process per listing.
+ *
+ * All assemblers are started before the first one is waited for, thus they run concurrently.
+ * Every listing is assembled on its own, as each of them defines the same symbols, e.g. `_start`.
+ *
+ * @param listings The assembly sources, e.g. as written by `compile`.
+ * @param outputs The output streams the relocatable objects are written to, one per listing.
+ * @param verbose If true, enables verbose output from the assemblers.
+ * @param invocation The streams and the working directory the assemblers are started with.
+ *
+ * @return The first non-zero exit code in the order of the listings, or 0 if all of them succeeded.
+ * @see assemble_listing
+ */
+int32_t assemble_listings(
+    const std::vector<std::string_view>& listings,
+    const std::vector<std::ostream*>& outputs,
+    bool verbose = false,
+    const Invocation& invocation = { }
+);
 } // namespace arkoi::utils
 
 // BSD 3-Clause License
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/ast/visitor.hpp"
+
+namespace arkoi::utils {
+/**
+ * @brief Visitor that describes every function of a program by the source it's compiled from.
+ *
+ * The code generated for a function doesn't only depend on its own source: the `Inliner`
+ * copies the bodies of its callees, decides based on the calls in the whole program, and
+ * every instruction carries the line it originates from. Thus the fingerprint of a function
+ * covers the text and the first line of every function reachable from it, together with
+ * the number of calls to each of them in the whole program.
+ *
+ * Two compilations producing the same fingerprint for a function (with the same compiler
+ * and configuration) are thus free to share the code generated for it.
+ *
+ * @see Cache, opt::Inliner
+ */
+class Fingerprinter final : ast::Visitor {
+public:
+    /**
+     * @brief Collects the functions of the program and the calls between them.
+     *
+     * @param node The `ast::Program` node to visit.
+     */
+    void visit(ast::Program& node) override;
+
+    /**
+     * @brief Returns the names of all functions in the order they are defined.
+     *
+     * @return A constant reference to the names.
+     */
+    [[nodiscard]] auto& functions() const { return _order; }
+
+    /**
+     * @brief Returns the functions called by the given function, once for every call.
+     *
+     * @param name The name of the function.
+     * @return The names of the callees, which may also be undefined in the program.
+     */
+    [[nodiscard]] const std::vector<std::string>& callees(const std::string& name) const;
+
+    /**
+     * @brief Returns the function itself and all functions it may call, directly or transitively.
+     *
+     * @param name The name of the function.
+     * @return The names of the defined functions, sorted by name.
+     */
+    [[nodiscard]] std::set<std::string> reachable(const std::string& name) const;
+
+    /**
+     * @brief Returns everything the generated code of a function depends on, besides the configuration.
+     *
+     * @param name The name of the function.
+     * @return The fingerprint, which is meant to be hashed by `Cache::key`.
+     */
+    [[nodiscard]] std::string fingerprint(const std::string& name) const;
+
+private:
+    /**
+     * @brief Remembers the source of the function and collects its calls.
+     */
+    void visit(ast::Function& node) override;
+
+    void visit(ast::Block& node) override;
+
+    void visit([[maybe_unused]] ast::Parameter& node) override { }
+
+    void visit([[maybe_unused]] ast::Immediate& node) override { }
+
+    void visit(ast::Variable& node) override;
+
+    void visit(ast::Return& node) override;
+
+    void visit([[maybe_unused]] ast::Identifier& node) override { }
+
+    void visit(ast::Binary& node) override;
+
+    void visit(ast::Cast& node) override;
+
+    void visit(ast::Assign& node) override;
+
+    /**
+     * @brief Records the call for the current function and visits the arguments.
+     */
+    void visit(ast::Call& node) override;
+
+    void visit(ast::If& node) override;
+
+    void visit(ast::While& node) override;
+
+private:
+    /**
+     * @brief The source of a single function.
+     */
+    struct Function {
+        std::string text;
+        size_t line;
+        std::vector<std::string> callees{ };
+    };
+
+    std::unordered_map<std::string, Function> _functions{ };
+    std::unordered_map<std::string, size_t> _calls{ };
+    std::vector<std::string> _order{ };
+    Function* _current{ };
+};
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,8 +1,12 @@
 #pragma once
 
 #include <ostream>
+#include <ranges>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
+
+#include "arkoi_language/utils/bit_vector.hpp"
 
 namespace arkoi::utils {
 /**
@@ -79,18 +83,18 @@ public:
      * @brief Retrieves the set of nodes that interfere with the given node in the graph.
      *
      * @param node The node for which to retrieve the interferences.
-     * @return An unordered_set containing the nodes that are adjacent (interfere)
-     *         with the specified node. If the node is not found in the graph,
-     *         returns an empty unordered_set.
+     * @return A reference to the unordered_set containing the nodes that are
+     *         adjacent (interfere) with the specified node. If the node is not
+     *         found in the graph, returns an empty unordered_set.
      */
-    [[nodiscard]] std::unordered_set<Node> interferences(const Node& node) const;
+    [[nodiscard]] const std::unordered_set<Node>& interferences(const Node& node) const;
 
     /**
      * @brief Retrieves all nodes within the interference graph.
      *
-     * @return An unordered_set containing all nodes currently stored in the graph.
+     * @return A view over all nodes currently stored in the graph.
      */
-    [[nodiscard]] std::unordered_set<Node> nodes() const;
+    [[nodiscard]] auto nodes() const { return std::views::keys(_adjacent); }
 
     /**
      * @brief Provides access to the underlying adjacency map.
@@ -103,8 +107,104 @@ private:
     std::unordered_map<Node, std::unordered_set<Node>> _adjacent;
 };
 
+/**
+ * @brief An interference graph over dense integer node IDs.
+ *
+ * Edge queries are answered by a triangular bit matrix, where the edge between
+ * the nodes `i > j` is the bit `i * (i - 1) / 2 + j`. Appending a node only
+ * appends a row, thus the matrix grows without moving existing bits. Next to it
+ * every node keeps a vector of its neighbors for iteration, as described by
+ * Chaitin and Briggs.
+ *
+ * Nodes should be numbered from zero without large gaps, as the matrix is
+ * sized after the largest ID.
+ */
+template <>
+class InterferenceGraph<size_t> {
+public:
+    InterferenceGraph() = default;
+
+    /**
+     * @brief Constructs an interference graph that can hold @p nodes without growing.
+     *
+     * @param nodes The amount of nodes that should be reserved.
+     */
+    explicit InterferenceGraph(size_t nodes);
+
+    /**
+     * @brief Adds a node to the interference graph, if it is not already part of it.
+     *
+     * @param node The node to be added to the interference graph.
+     * @see remove_node
+     */
+    void add_node(size_t node);
+
+    /**
+     * @brief Removes a node and all associated edges from the interference graph.
+     *
+     * @param node The node to remove from the interference graph.
+     * @see add_node
+     */
+    void remove_node(size_t node);
+
+    /**
+     * @brief Adds an undirected edge between two nodes in the graph.
+     *
+     * Missing nodes are added automatically. If the two nodes are the same, no
+     * action is taken.
+     *
+     * @param first The first node of the edge.
+     * @param second The second node of the edge.
+     * @see is_interfering
+     */
+    void add_edge(size_t first, size_t second);
+
+    /**
+     * @brief Checks if two nodes in the interference graph are interfering with each other.
+     *
+     * @param first The first node to check for interference.
+     * @param second The second node to check for interference.
+     * @return True if `first` and `second` are connected by an edge, false otherwise.
+     * @see add_edge
+     */
+    [[nodiscard]] bool is_interfering(size_t first, size_t second) const;
+
+    /**
+     * @brief Retrieves the nodes that interfere with the given node in the graph.
+     *
+     * @param node The node for which to retrieve the interferences.
+     * @return A reference to the neighbors of the node, which is empty if the
+     *         node is not found in the graph.
+     */
+    [[nodiscard]] const std::vector<size_t>& interferences(size_t node) const;
+
+    /**
+     * @brief Retrieves all nodes within the interference graph.
+     *
+     * @return A reference to the set of nodes, iterable in ascending order.
+     */
+    [[nodiscard]] auto& nodes() const { return _nodes; }
+
+    /**
+     * @brief Provides access to the neighbor vectors, indexed by the node.
+     *
+     * @return A reference to the internal adjacency vectors.
+     */
+    [[nodiscard]] auto& adjacent() const { return _adjacent; }
+
+private:
+    [[nodiscard]] static size_t _edge(size_t first, size_t second);
+
+private:
+    std::vector<std::vector<size_t>> _adjacent{ };
+    BitVector _matrix{ };
+    BitVector _nodes{ };
+};
+
 template <typename Node>
 std::ostream& operator<<(std::ostream& os, const InterferenceGraph<Node>& graph);
+
+std::ostream& operator<<(std::ostream& os, const InterferenceGraph<size_t>& graph);
 } // namespace arkoi::utils
 
 #include "../../../src/arkoi_language/utils/interference_graph.tpp"
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace arkoi::utils {
+/**
+ * @brief A handle to a string stored in the process-wide intern table.
+ *
+ * Equal strings are interned to the same id, so equality only compares two
+ * integers instead of the characters. The hash of the string is computed
+ * once on interning and cached in the handle, which keeps the iteration
+ * order of hashed containers independent of the order in which ids are
+ * handed out (e.g. when multiple threads intern concurrently).
+ *
+ * The characters themselves live in a side table and are only needed when
+ * the name is printed or ordered.
+ */
+class Interned final {
+public:
+    /**
+     * @brief Interns the given string and returns its handle.
+     *
+     * Thread-safe. Interning the same string multiple times always yields
+     * handles referring to the same id.
+     *
+     * @param value The string to intern.
+     */
+    explicit Interned(std::string_view value);
+
+    /**
+     * @brief Checks if both handles refer to the same string.
+     *
+     * @param rhs Right-hand handle.
+     *
+     * @return True if both handles share the same id.
+     */
+    bool operator==(const Interned& rhs) const { return _id == rhs._id; }
+
+    /**
+     * @brief Checks if both handles refer to different strings.
+     *
+     * @param rhs Right-hand handle.
+     *
+     * @return True if the ids differ.
+     */
+    bool operator!=(const Interned& rhs) const { return _id != rhs._id; }
+
+    /**
+     * @brief Compares the interned strings lexicographically.
+     *
+     * The comparison is done on the characters and not on the ids, so that
+     * ordered containers of handles are deterministic.
+     *
+     * @param rhs Right-hand handle.
+     *
+     * @return True if this string orders before @p rhs.
+     */
+    bool operator<(const Interned& rhs) const;
+
+    /**
+     * @brief Returns the interned string.
+     *
+     * The reference stays valid until the strings are dropped, see `InternScope`.
+     *
+     * @return A constant reference to the string in the side table.
+     */
+    [[nodiscard]] const std::string& str() const;
+
+    /**
+     * @brief Returns the cached hash of the interned string.
+     *
+     * @return The same value `std::hash<std::string>` yields for the string.
+     */
+    [[nodiscard]] auto hash() const { return _hash; }
+
+    /**
+     * @brief Returns the unique id of the interned string.
+     *
+     * @return The small integer identifying the string.
+     */
+    [[nodiscard]] auto id() const { return _id; }
+
+private:
+    size_t _hash;
+    uint32_t _id;
+};
+
+/**
+ * @brief Marks a stretch of work, e.g. a request of a server, whose interned strings may be dropped afterward.
+ *
+ * A long-lived process would otherwise keep the names of every source it ever compiled. Once the last
+ * scope ends and more than `LIMIT` strings are interned, all of them are dropped, thus the ids are
+ * handed out from zero again. No handle may be used after the scopes it was created in ended. A
+ * process that never opens a scope keeps all of its strings.
+ */
+class InternScope final {
+public:
+    /**
+     * @brief The amount of strings kept for the following scopes, which keeps the common names interned.
+     */
+    static constexpr size_t LIMIT = 1 << 16;
+
+public:
+    InternScope();
+
+    InternScope(const InternScope&) = delete;
+    InternScope& operator=(const InternScope&) = delete;
+
+    /**
+     * @brief Drops all interned strings if this is the last running scope and the limit is exceeded.
+     */
+    ~InternScope();
+};
+
+/**
+ * @brief Streams the interned string.
+ *
+ * @param os The output stream.
+ * @param interned The handle to print.
+ * @return A reference to the output stream @p os
+ */
+std::ostream& operator<<(std::ostream& os, const Interned& interned);
+} // namespace arkoi::utils
+
+namespace std {
+template <>
+struct hash<arkoi::utils::Interned> {
+    size_t operator()(const arkoi::utils::Interned& interned) const noexcept {
+        return interned.hash();
+    }
+};
+} // namespace std
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
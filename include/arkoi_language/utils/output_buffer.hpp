@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace arkoi::utils {
+/**
+ * @brief Collects formatted text in a large buffer and writes it to a stream in chunks.
+ *
+ * Appending only copies characters into the buffer, which avoids the sentries, locale lookups
+ * and virtual calls an `std::ostream` does for every small piece. The stream itself is only
+ * written once the buffer is full, on `flush` and on destruction.
+ */
+class OutputBuffer final {
+public:
+    /**
+     * @brief The default size of the buffer, which is written to the stream at once.
+     */
+    static constexpr size_t CAPACITY = 64 * 1024;
+
+public:
+    /**
+     * @brief Constructs a buffer in front of @p output.
+     *
+     * @param output The stream the buffered text is written to.
+     * @param capacity The amount of characters buffered before they are written.
+     */
+    explicit OutputBuffer(std::ostream& output, size_t capacity = CAPACITY);
+
+    OutputBuffer(const OutputBuffer&) = delete;
+
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * @brief Writes the remaining text to the stream.
+     */
+    ~OutputBuffer();
+
+    /**
+     * @brief Appends the characters of @p text.
+     *
+     * @param text The text to append.
+     * @return A reference to this buffer.
+     */
+    OutputBuffer& operator<<(const std::string_view text) {
+        if (_buffer.size() + text.size() > _capacity) _drain(text.size());
+        _buffer.append(text);
+        return *this;
+    }
+
+    /**
+     * @brief Appends the characters of a null terminated string.
+     *
+     * Exact overloads for strings keep them from being converted to other types by mistake.
+     *
+     * @param text The text to append.
+     * @return A reference to this buffer.
+     */
+    OutputBuffer& operator<<(const char* text) { return *this << std::string_view(text); }
+
+    /**
+     * @brief Appends the characters of @p text.
+     *
+     * @param text The text to append.
+     * @return A reference to this buffer.
+     */
+    OutputBuffer& operator<<(const std::string& text) { return *this << std::string_view(text); }
+
+    /**
+     * @brief Appends a character, a boolean as "1" or "0", or the decimal digits of an integer.
+     *
+     * @param value The value to append.
+     * @return A reference to this buffer.
+     */
+    template <std::integral Type>
+    OutputBuffer& operator<<(const Type value) {
+        if constexpr (std::same_as<Type, char>) {
+            if (_buffer.size() == _capacity) _drain(1);
+            _buffer.push_back(value);
+        } else if constexpr (std::same_as<Type, bool>) {
+            *this << (value ? '1' : '0');
+        } else {
+            std::array<char, 24> digits{ };
+            const auto [end, _] = std::to_chars(digits.begin(), digits.end(), value);
+            *this << std::string_view(digits.begin(), end);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Appends a floating point value the same way an `std::ostream` does by default, with 6 digits.
+     *
+     * @param value The value to append.
+     * @return A reference to this buffer.
+     */
+    template <std::floating_point Type>
+    OutputBuffer& operator<<(const Type value) {
+        std::array<char, 32> digits{ };
+        const auto [end, _] = std::to_chars(digits.begin(), digits.end(), value, std::chars_format::general, 6);
+        return *this << std::string_view(digits.begin(), end);
+    }
+
+    /**
+     * @brief Writes the buffered text to the stream and flushes it.
+     */
+    void flush();
+
+    /**
+     * @brief Formats @p value through a small buffer, which lets the operators of `std::ostream` share the
+     * formatting of the buffer.
+     *
+     * @param output The stream the value is written to.
+     * @param value The value to format.
+     * @return A reference to the output stream @p output.
+     */
+    template <typename Type>
+    static std::ostream& format(std::ostream& output, const Type& value) {
+        OutputBuffer buffer(output, 64);
+        buffer << value;
+        return output;
+    }
+
+private:
+    /**
+     * @brief Writes the buffered text to the stream, which makes room for at least @p size characters.
+     */
+    void _drain(size_t size);
+
+private:
+    std::ostream& _output;
+    std::string _buffer;
+    size_t _capacity;
+};
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
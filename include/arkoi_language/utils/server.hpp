@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace arkoi::utils {
+/**
+ * @brief A command line sent to a running compiler, which is executed as if it was invoked directly.
+ */
+struct Request {
+    /// The working directory of the client, which relative paths of the arguments are resolved against.
+    std::filesystem::path directory;
+
+    /// The arguments of the command line, without the name of the executable.
+    std::vector<std::string> arguments;
+};
+
+/**
+ * @brief The standard streams a client passed along with its request, which stay open until it's answered.
+ */
+struct Streams {
+    /// The descriptors of the standard input, output and error of the client.
+    std::array<int, 3> descriptors;
+    /// Writes to the standard output of the client.
+    std::ostream& output;
+    /// Writes to the standard error of the client.
+    std::ostream& error;
+};
+
+/**
+ * @brief A long-lived compiler that executes the requests of clients, connected through a Unix socket.
+ *
+ * Every invocation of the compiler pays for starting the process and for the state it builds
+ * up, e.g. the interned strings, the opened caches or the threads of its pools. A server keeps
+ * all of them alive between requests, thus a build invoking the compiler once per source only
+ * pays for compiling it.
+ *
+ * The client passes its standard input, output and error along with the request. They are handed
+ * to the handler together with the working directory of the client, which passes them on to the
+ * assembler, the linker and a program that is run. Thus the output reaches the client unchanged,
+ * without replacing the streams or the working directory of the whole process. This allows the
+ * requests of several clients to be executed at once, each of them compiling with as many threads
+ * as it asks for.
+ *
+ * A request may write files into any directory the server has access to, thus only the user who
+ * started the server may connect to its socket.
+ *
+ * @see forward
+ */
+class Server {
+public:
+    /**
+     * @brief Handles a single request with the streams of its client and returns the exit code reported to it.
+     */
+    using Handler = std::function<int32_t(const Request&, const Streams&)>;
+
+public:
+    /**
+     * @brief Listens on the Unix socket at @p socket, which replaces a stale socket of an earlier server.
+     *
+     * The socket can only be read and written by its owner, which is required to connect to it.
+     *
+     * @param socket The path of the socket clients connect to.
+     * @throws std::system_error If the socket can't be created or bound, or if something else than a socket
+     *                           exists at @p socket.
+     */
+    explicit Server(std::filesystem::path socket);
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief Closes the socket and removes it from the file system.
+     */
+    ~Server();
+
+    /**
+     * @brief Executes the requests of clients with @p handler, until the process is terminated.
+     *
+     * Every client is served on a thread of its own, thus a long request doesn't hold back the others.
+     *
+     * @param handler The handler every request is executed with, which may be called concurrently.
+     */
+    [[noreturn]] void serve(const Handler& handler);
+
+    /**
+     * @brief Waits for a single client and executes its request with @p handler on the calling thread.
+     *
+     * A client that disconnects before its request was received, or that sends a malformed request, is dropped
+     * without calling @p handler. A working directory that doesn't exist is reported to the client instead.
+     *
+     * @param handler The handler the request is executed with.
+     * @return True if a request was executed, false if the client was dropped.
+     */
+    bool serve_one(const Handler& handler);
+
+private:
+    std::filesystem::path _socket;
+    int _descriptor{ -1 };
+};
+
+/**
+ * @brief Executes @p request on the server listening at @p socket and waits for its exit code.
+ *
+ * The standard input, output and error of the calling process are passed to the server, which
+ * writes the output of the request to them.
+ *
+ * @param socket The path of the socket the server listens on.
+ * @param request The command line to execute.
+ * @return The exit code of the request, 1 if the connection was lost while it was executed, or std::nullopt
+ *         if no server received it, in which case it should be executed by the calling process instead.
+ */
+[[nodiscard]] std::optional<int32_t> forward(const std::filesystem::path& socket, const Request& request);
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "arkoi_language/utils/output_buffer.hpp"
+
 /**
  * @brief Enumeration of standard memory and operand sizes in bytes.
  *
@@ -45,6 +47,15 @@ size_t size_to_bits(const Size& size);
  */
 std::ostream& operator<<(std::ostream& os, const Size& size);
 
+/**
+ * @brief Appends the textual representation of `Size` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param size The size to represent as a string.
+ * @return A reference to the output buffer @p os.
+ */
+arkoi::utils::OutputBuffer& operator<<(arkoi::utils::OutputBuffer& os, const Size& size);
+
 //==============================================================================
 // BSD 3-Clause License
 //
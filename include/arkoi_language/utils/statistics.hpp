@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arkoi::utils {
+/**
+ * @brief Collects named counters of what the stages of the compilation did, e.g. how many
+ * instructions a pass folded or how many variables the register allocation spilled.
+ *
+ * Every counter belongs to a group, which is the name of the pass or stage incrementing it.
+ * Counters are summed over all functions of all sources. Unlike the `TimeReport` every
+ * counter is deterministic, thus two compilations of the same sources can be compared.
+ *
+ * All members are thread-safe, thus a single registry is shared by all jobs.
+ *
+ * @see TimeReport
+ */
+class Statistics {
+public:
+    /**
+     * @brief A single named counter.
+     */
+    struct Counter {
+        /// The pass or stage the counter belongs to, e.g. "dead-code-elimination".
+        std::string group;
+
+        /// The name of the counter, e.g. "removed-instructions".
+        std::string name;
+
+        /// The accumulated value.
+        size_t value{ };
+    };
+
+public:
+    /**
+     * @brief Adds the given amount to a counter, which is created on its first use.
+     *
+     * @param group The pass or stage the counter belongs to.
+     * @param name The name of the counter.
+     * @param amount The amount that is added.
+     */
+    void add(std::string_view group, std::string_view name, size_t amount = 1);
+
+    /**
+     * @brief Returns the value of a counter.
+     *
+     * @param group The pass or stage the counter belongs to.
+     * @param name The name of the counter.
+     * @return The accumulated value, 0 if the counter was never used.
+     */
+    [[nodiscard]] size_t value(std::string_view group, std::string_view name) const;
+
+    /**
+     * @brief Returns a copy of all counters sorted by their group and name.
+     *
+     * @return The accumulated counters.
+     */
+    [[nodiscard]] std::vector<Counter> counters() const;
+
+    /**
+     * @brief Prints all counters with a value as a human-readable table.
+     *
+     * @param output The stream the table is written to.
+     */
+    void print(std::ostream& output) const;
+
+private:
+    mutable std::mutex _mutex{ };
+    std::vector<Counter> _counters{ };
+};
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
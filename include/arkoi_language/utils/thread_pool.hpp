@@ -0,0 +1,116 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace arkoi::utils {
+/**
+ * @brief A fixed-size pool of worker threads executing submitted tasks.
+ *
+ * Tasks are taken from a shared FIFO queue by whichever worker becomes idle
+ * first. A pool created with at most one job does not spawn any thread and
+ * instead executes every task inline on the calling thread, which keeps the
+ * single-threaded compilation path free of any synchronization.
+ *
+ * @see parallel_for
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructs a pool with the given amount of jobs.
+     *
+     * @param jobs The amount of tasks that may run concurrently. A value of 0
+     *             or 1 executes all tasks inline on the submitting thread.
+     */
+    explicit ThreadPool(size_t jobs);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Drains the remaining tasks and joins all worker threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Schedules a task for execution.
+     *
+     * Exceptions thrown by the task are captured and rethrown when the
+     * returned future is accessed.
+     *
+     * @tparam Func The type of the callable.
+     * @param func The callable to execute.
+     * @return A future holding the result of the task.
+     */
+    template <typename Func>
+    auto submit(Func&& func) -> std::future<std::invoke_result_t<Func>>;
+
+    /**
+     * @brief Invokes `func(index)` for every index in `[0, count)`.
+     *
+     * Blocks until all invocations are done. If any invocation throws, the
+     * exception of the lowest index is rethrown after all tasks finished.
+     *
+     * @tparam Func The type of the callable, invocable with a `size_t`.
+     * @param count The amount of indices to process.
+     * @param func The callable to execute for each index.
+     */
+    template <typename Func>
+    void parallel_for(size_t count, Func&& func);
+
+    /**
+     * @brief Returns the amount of worker threads owned by the pool.
+     *
+     * @return The amount of workers, or 0 if tasks are executed inline.
+     */
+    [[nodiscard]] size_t workers() const { return _workers.size(); }
+
+private:
+    void _work();
+
+private:
+    std::queue<std::function<void()>> _tasks{ };
+    std::vector<std::thread> _workers{ };
+    std::condition_variable _condition{ };
+    std::mutex _mutex{ };
+    bool _stopping{ };
+};
+} // namespace arkoi::utils
+
+#include "../../../src/arkoi_language/utils/thread_pool.tpp"
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
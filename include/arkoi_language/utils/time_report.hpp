@@ -0,0 +1,179 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace arkoi::utils {
+/**
+ * @brief Collects the wall time, CPU time and peak memory growth of the compilation stages.
+ *
+ * Every measurement of a stage is added to its totals, thus a stage run once per function
+ * (e.g. a single pass) reports the sum over all functions of all sources. Stages running
+ * concurrently on multiple jobs may thus report more wall time than has elapsed. The CPU
+ * time is taken from the measuring thread only, which keeps concurrent stages apart.
+ *
+ * The peak resident set size is shared by the whole process, thus its growth during a
+ * stage is only precise if nothing else runs at the same time.
+ *
+ * All members are thread-safe, thus a single report is shared by all jobs.
+ *
+ * @see Timer
+ */
+class TimeReport {
+public:
+    /**
+     * @brief The accumulated measurements of a single stage.
+     */
+    struct Stage {
+        /// The name of the stage, e.g. "parser" or the name of a pass like "sccp".
+        std::string name;
+
+        /// The elapsed wall time of all runs.
+        std::chrono::nanoseconds wall{ };
+
+        /// The CPU time spent by the measuring threads in all runs.
+        std::chrono::nanoseconds cpu{ };
+
+        /// The growth of the peak resident set size in KiB.
+        int64_t rss{ };
+
+        /// The amount of times the stage was run.
+        size_t runs{ };
+
+        /// Additional named counters of the stage, e.g. the spill rounds of the register allocation.
+        std::vector<std::pair<std::string, size_t>> counters{ };
+    };
+
+    /**
+     * @brief Measures a single run of a stage from its construction until its destruction.
+     *
+     * A timer without a report doesn't even read the clocks, thus instrumented code costs
+     * nothing if no report is requested.
+     */
+    class Timer {
+    public:
+        /**
+         * @brief Starts the measurement.
+         *
+         * @param report The report the run is added to, or nullptr to measure nothing.
+         * @param stage The name of the stage, which needs to outlive the timer.
+         */
+        Timer(TimeReport* report, std::string_view stage);
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        /**
+         * @brief Stops the measurement and adds it to the report.
+         */
+        ~Timer();
+
+    private:
+        TimeReport* _report;
+        std::string_view _stage;
+        std::chrono::steady_clock::time_point _wall{ };
+        std::chrono::nanoseconds _cpu{ };
+        int64_t _rss{ };
+    };
+
+public:
+    /**
+     * @brief Adds a single run to the totals of a stage, which is created on its first run.
+     *
+     * @param stage The name of the stage.
+     * @param wall The elapsed wall time.
+     * @param cpu The CPU time spent.
+     * @param rss The growth of the peak resident set size in KiB.
+     */
+    void record(std::string_view stage, std::chrono::nanoseconds wall, std::chrono::nanoseconds cpu, int64_t rss);
+
+    /**
+     * @brief Adds the given amount to a counter of a stage.
+     *
+     * @param stage The name of the stage.
+     * @param counter The name of the counter.
+     * @param amount The amount that is added.
+     */
+    void count(std::string_view stage, std::string_view counter, size_t amount);
+
+    /**
+     * @brief Returns a copy of all stages in the order they were first measured.
+     *
+     * @return The accumulated stages.
+     */
+    [[nodiscard]] std::vector<Stage> stages() const;
+
+    /**
+     * @brief Prints the stages as a human-readable table.
+     *
+     * @param output The stream the table is written to.
+     */
+    void print(std::ostream& output) const;
+
+    /**
+     * @brief Prints the stages as a single JSON object, which is meant to be read by other tools.
+     *
+     * @param output The stream the JSON is written to.
+     */
+    void print_json(std::ostream& output) const;
+
+    /**
+     * @brief Returns the CPU time spent by the calling thread so far.
+     */
+    [[nodiscard]] static std::chrono::nanoseconds thread_cpu_time();
+
+    /**
+     * @brief Returns the peak resident set size of the process so far in KiB.
+     */
+    [[nodiscard]] static int64_t peak_rss();
+
+private:
+    /**
+     * @brief Returns the stage with the given name, which is created if needed.
+     *
+     * Needs to be called with the mutex held.
+     */
+    Stage& _stage(std::string_view stage);
+
+private:
+    mutable std::mutex _mutex{ };
+    std::vector<Stage> _stages{ };
+};
+} // namespace arkoi::utils
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -50,7 +50,7 @@ std::string to_string(const T& value) {
 /**
  * @brief Returns the base path of a given file path.
  *
- * For example, if the input is "/home/arkoi/test.ark", the output would be "/home/arkoi/test".
+ * For example, if the input is "/home/arkoi/test.ark" or "/home/arkoi/test.il", the output would be "/home/arkoi/test".
  *
  * @param path The file path to extract the directory from.
  * @return The base directory path.
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <set>
+#include <span>
+#include <tuple>
+
 #include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/il/compact.hpp"
 #include "arkoi_language/il/instruction.hpp"
 #include "arkoi_language/utils/interference_graph.hpp"
 #include "arkoi_language/x86_64/operand.hpp"
@@ -11,6 +16,19 @@ namespace arkoi::x86_64 {
  */
 using Mapping = std::unordered_map<il::Variable, Register::Base>;
 
+/**
+ * @brief Mapping from spilled IL variables to their stack slot, spilled variables with the same slot may share it.
+ */
+using SpillSlots = std::unordered_map<il::Variable, size_t>;
+
+/**
+ * @brief The register allocation algorithms which can be selected by the driver.
+ */
+enum class AllocatorKind {
+    GraphColoring, ///< `RegisterAllocator`, slower but with better results.
+    LinearScan,    ///< `LinearScanAllocator`, a single pass over the live intervals.
+};
+
 class PreColorer final : il::Visitor {
 public:
     explicit PreColorer(il::Function& function) :
@@ -20,6 +38,16 @@ public:
 
     [[nodiscard]] auto assigned() const { return _assigned; }
 
+    /**
+     * @brief Returns the registers the sources of the arguments are passed in.
+     *
+     * Unlike the assigned registers these are only preferred, computing a source
+     * right into its argument register makes the move at the call redundant.
+     *
+     * @return The preferred register of every argument source.
+     */
+    [[nodiscard]] auto& hints() const { return _hints; }
+
     /**
      * @brief Determines the physical register used for returning a specific type.
      *
@@ -61,10 +89,13 @@ private:
 
     void visit([[maybe_unused]] il::Assign& instruction) override { }
 
+    void visit([[maybe_unused]] il::Select& instruction) override { }
+
 private:
     size_t _floating{ }, _integer{ };
     il::Function& _function;
     Mapping _assigned{ };
+    Mapping _hints{ };
 };
 
 /**
@@ -75,10 +106,18 @@ private:
  * which variables can share registers. If the graph cannot be colored with the
  * available registers, some variables are marked as "spilled" to memory.
  *
- * @see InterferenceGraph, il::InstructionLivenessAnalysis, Register
+ * Before a variable is left in memory, the function is rewritten to keep it out of
+ * it where that is cheap: A constant is recomputed right in front of every use,
+ * and the uses of a block that are not separated by a call share a copy where
+ * enough registers are free. Then the function is allocated again.
+ *
+ * @see InterferenceGraph, il::SparseLivenessAnalysis, Register
  */
 class RegisterAllocator {
 public:
+    /// The maximum amount of rewrites, each of them is followed by another round of allocation.
+    static constexpr size_t MAX_ROUNDS = 4;
+
     /**
      * @brief Constructs a `RegisterAllocator`.
      *
@@ -109,11 +148,59 @@ public:
      */
     [[nodiscard]] auto& spilled() const { return _spilled; }
 
-private:
-    void _cleanup();
+    /**
+     * @brief Returns the stack slots of the spilled variables.
+     *
+     * Spilled variables that do not interfere share a slot, regardless of their size.
+     *
+     * @return A constant reference to the `SpillSlots`.
+     */
+    [[nodiscard]] auto& slots() const { return _slots; }
+
+    /**
+     * @brief Returns how often the function was rewritten and allocated again.
+     */
+    [[nodiscard]] size_t rounds() const { return _rounds; }
 
     /**
-     * @brief Re-indexes variables to ensure unique identification during allocation.
+     * @brief Returns the amount of spilled variables that were recomputed at their uses instead.
+     */
+    [[nodiscard]] size_t rematerialized() const { return _rematerialized; }
+
+    /**
+     * @brief Returns the amount of copies that keep a spilled variable in a register between calls.
+     */
+    [[nodiscard]] size_t split_ranges() const { return _split_ranges; }
+
+    /**
+     * @brief Checks if the instruction is an integer division, which overwrites `RAX` and `RDX`.
+     */
+    [[nodiscard]] static bool is_integer_division(const il::Instruction& instruction);
+
+    /**
+     * @brief Checks if the register base is one of those overwritten by an integer division.
+     */
+    [[nodiscard]] static bool is_division_register(Register::Base base);
+
+    /**
+     * @brief Returns the registers a variable may be assigned to.
+     *
+     * Every call clobbers the caller-saved registers, thus a value live across a call
+     * is restricted to the callee-saved ones. As the System V ABI has no callee-saved
+     * XMM registers, such floating point values can only be kept on the stack.
+     *
+     * @param variable The variable to allocate.
+     * @param live_across_calls If the variable is live across at least one call.
+     * @return The registers in the order they should be tried.
+     */
+    [[nodiscard]] static std::span<const Register::Base> registers(const il::Variable& variable, bool live_across_calls);
+
+private:
+    /**
+     * @brief Numbers the variables densely, so the interference graph can be indexed by them.
+     *
+     * The numbering is the one of the `il::CompactFunction`, whose arrays are walked instead of
+     * the instructions wherever only the defined and used variables are of interest.
      */
     void _renumber();
 
@@ -122,23 +209,232 @@ private:
      */
     void _build();
 
+    /**
+     * @brief Merges the source and destination of moves, if it keeps the graph colorable.
+     *
+     * Two nodes are merged conservatively: With the Briggs test, if the merged node has less
+     * than `k` neighbors of significant degree, or with the George test, if one of them is
+     * pre-colored and every significant neighbor of the other one already interferes with it.
+     */
+    void _coalesce();
+
+    /**
+     * @brief Checks if the move-related nodes can be merged without risking a spill.
+     *
+     * @param first The node that would be kept.
+     * @param second The node that would be merged into @p first.
+     * @return True if the nodes can be coalesced.
+     */
+    [[nodiscard]] bool _can_coalesce(size_t first, size_t second) const;
+
+    /**
+     * @brief Merges @p second into @p first, which takes over all its interferences.
+     */
+    void _combine(size_t first, size_t second);
+
+    /**
+     * @brief Returns the node a node was coalesced into, or the node itself.
+     */
+    [[nodiscard]] size_t _alias(size_t node);
+
     /**
      * @brief Attempts to color the interference graph using available registers.
+     *
+     * If every node has a significant degree, the node with the lowest spill cost
+     * per degree is removed, as it is cheap to keep in memory and its removal
+     * helps the most neighbors.
      */
     void _simplify();
 
+    /**
+     * @brief Colors the nodes in the reverse order of simplification.
+     *
+     * A register already held by a move-related node is preferred, thus the
+     * moves that could not be coalesced still become redundant most of the time.
+     */
     void _select();
 
-    void _rewrite();
+    /**
+     * @brief Shares the stack slots between spilled variables that do not interfere.
+     */
+    void _assign_slots();
+
+    /**
+     * @brief Returns the registers the variable may be assigned to.
+     */
+    [[nodiscard]] std::span<const Register::Base> _registers(const il::Variable& variable) const;
+
+    /**
+     * @brief The changes planned for a block, whose positions refer to the block before any of them is applied.
+     */
+    struct Edits {
+        /// The instructions inserted in front of the instruction at the position.
+        std::vector<std::pair<size_t, il::Instruction>> insertions{ };
+        /// The uses of the instruction at the position that are renamed.
+        std::vector<std::tuple<size_t, il::Variable, il::Variable>> renames{ };
+        /// The positions of the removed instructions.
+        std::vector<size_t> erasures{ };
+    };
+
+    /**
+     * @brief Rewrites the function to keep the spilled variables out of memory where it is cheap.
+     *
+     * The variables created by a rewrite are never rewritten again, which bounds the amount of rounds.
+     *
+     * @return True if the function was changed, thus it needs to be allocated again.
+     */
+    [[nodiscard]] bool _rewrite();
+
+    /**
+     * @brief Plans to recompute @p variable in front of each of its uses, if its only definition is a constant.
+     *
+     * An `il::Assign` of an immediate or an `il::Binary` of two immediates, that is no integer
+     * division, is cheaper to recompute than to store and load again.
+     *
+     * @return True if the variable will be rematerialized.
+     */
+    bool _rematerialize(const il::Variable& variable, std::unordered_map<il::BasicBlock*, Edits>& edits);
+
+    /**
+     * @brief Plans to split the uses of @p variable into ranges which are kept in a register copy.
+     *
+     * A range holds the uses of a block that aren't separated by a call or a redefinition. Only
+     * ranges with multiple uses are split, where fewer variables with a register of the same class
+     * are live than there are registers, thus the copy has a register to take.
+     */
+    void _split(const il::Variable& variable, std::unordered_map<il::BasicBlock*, Edits>& edits);
+
+    /**
+     * @brief Clears the results of the last round, thus the function can be allocated again.
+     */
+    void _reset();
+
+private:
+    size_t _rounds{ }, _rematerialized{ }, _split_ranges{ }, _rewrites{ };
+    std::unordered_set<il::Variable> _rewritten{ };
+    std::unordered_set<il::Variable> _clobbered{ };
+    il::SparseLivenessAnalysis _liveness_analysis{ };
+    std::vector<std::vector<size_t>> _partners{ };
+    utils::InterferenceGraph<size_t> _graph{ };
+    std::vector<il::Variable> _variables{ };
+    std::vector<std::pair<size_t, size_t>> _moves{ };
+    il::CompactFunction _compact{ };
+    std::vector<size_t> _aliases{ };
+    std::vector<double> _costs{ };
+    std::vector<size_t> _stack{ };
+    std::set<il::Variable> _spilled{ };
+    il::Function& _function;
+    Mapping _assigned{ };
+    Mapping _hints{ };
+    SpillSlots _slots{ };
+};
+
+/**
+ * @brief Performs register allocation for an x86-64 function using linear scan.
+ *
+ * Every instruction is numbered in block order and the live interval of a
+ * variable spans from the first to the last position it is used, defined or
+ * live-out at. Uses are placed in front of the definitions of the same
+ * instruction, thus a value can reuse the register of an operand that dies.
+ * The intervals are visited by their start and receive a register that is
+ * neither held by an active interval nor reserved by an overlapping
+ * pre-colored one. If every register is taken, the interval ending last is
+ * spilled.
+ *
+ * The intervals are a conservative approximation of the liveness, as holes
+ * are not tracked. In exchange, the function is only scanned once and no
+ * interference graph is built, which makes this suited for fast builds.
+ *
+ * @see RegisterAllocator, il::SparseLivenessAnalysis
+ */
+class LinearScanAllocator {
+public:
+    /**
+     * @brief Constructs a `LinearScanAllocator`.
+     *
+     * @param function The `il::Function` whose variables need allocation.
+     */
+    explicit LinearScanAllocator(il::Function& function) :
+        _function(function) { }
+
+    /**
+     * @brief Executing the entire register allocation.
+     */
+    void run();
+
+    /**
+     * @brief Returns the successful virtual-to-physical register assignments.
+     *
+     * @return A constant reference to the `Mapping`.
+     */
+    [[nodiscard]] auto& assigned() const { return _assigned; }
+
+    /**
+     * @brief Returns the variables that could not be assigned a register.
+     *
+     * @return A constant reference to the set of spilled `il::Variable` objects.
+     */
+    [[nodiscard]] auto& spilled() const { return _spilled; }
+
+    /**
+     * @brief Returns the stack slots of the spilled variables.
+     *
+     * Spilled variables whose intervals do not overlap share a slot, regardless of their size.
+     *
+     * @return A constant reference to the `SpillSlots`.
+     */
+    [[nodiscard]] auto& slots() const { return _slots; }
+
+private:
+    /**
+     * @brief The range of positions a variable is live at.
+     */
+    struct Interval {
+        il::Variable variable;
+        size_t start, end;
+    };
+
+    /**
+     * @brief Computes the live intervals and pre-colors the fixed variables.
+     */
+    void _build();
+
+    /**
+     * @brief Assigns registers to the intervals in the order of their start.
+     */
+    void _scan();
+
+    /**
+     * @brief Shares the stack slots between spilled intervals that do not overlap.
+     */
+    void _assign_slots();
+
+    /**
+     * @brief Returns the registers the variable may be assigned to.
+     *
+     * @param variable The variable to allocate.
+     * @return The registers of the class of the variable.
+     */
+    [[nodiscard]] std::span<const Register::Base> _registers(const il::Variable& variable) const;
+
+    /**
+     * @brief Checks if @p base can hold the interval without clashing with a pre-colored interval.
+     *
+     * @param base The register to check.
+     * @param interval The interval to allocate.
+     * @return True if no pre-colored interval of @p base overlaps the interval.
+     */
+    [[nodiscard]] bool _is_reserved(Register::Base base, const Interval& interval) const;
 
 private:
-    std::shared_ptr<il::InstructionLivenessAnalysis> _liveness_analysis{ };
-    il::DataflowAnalysis<il::InstructionLivenessAnalysis> _analysis{ };
-    utils::InterferenceGraph<il::Variable> _graph{ };
-    std::vector<il::Variable> _stack{ };
+    std::unordered_set<il::Variable> _clobbered{ };
+    il::SparseLivenessAnalysis _liveness_analysis{ };
+    std::vector<Interval> _intervals{ }, _fixed{ };
     std::set<il::Variable> _spilled{ };
     il::Function& _function;
     Mapping _assigned{ };
+    Mapping _hints{ };
+    SpillSlots _slots{ };
 };
 } // namespace arkoi::x86_64
 
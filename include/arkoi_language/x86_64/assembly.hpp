@@ -71,7 +71,12 @@ public:
     enum class Opcode {
         CALL, MOV, SYSCALL, ENTER, LEAVE, RET, ADDSD, ADDSS, ADD, SUBSD, SUBSS, SUB, MULSD, MULSS, IMUL, DIVSD, DIVSS,
         IDIV, DIV, UCOMISD, UCOMISS, SETA, SETAE, CMP, SETG, SETGE, SETB, SETBE, SETL, SETLE, CVTSS2SD, CVTSD2SS, MOVSXD, MOVSX, MOVZX, CVTTSD2SI,
-        CVTTSS2SI, XORPS, SETE, SETNE, SETP, OR, CVTSI2SD, CVTSI2SS, TEST, JNZ, JMP, MOVSD, MOVSS, PUSH, POP
+        CVTTSS2SI, XORPS, SETE, SETNE, SETP, OR, CVTSI2SD, CVTSI2SS, TEST, JNZ, JMP, MOVSD, MOVSS, PUSH, POP, SHL, SHR, SAR, CDQ, CQO,
+        CMOVNZ, CMOVE, CMOVA, CMOVAE, CMOVB, CMOVBE, CMOVG, CMOVGE, CMOVL, CMOVLE,
+        MOVD, MOVQ, JZ, JA, JAE, JB, JBE, JG, JGE, JL, JLE, JE, JNE, JP, JNP, LEA, VADDSD, VADDSS, VSUBSD,
+        VSUBSS, VMULSD, VMULSS, VDIVSD, VDIVSS, VXORPS, VCVTSI2SD, VCVTSI2SS, VCVTSS2SD, VCVTSD2SS, VFMADD231SD,
+        VFMADD231SS, VFMSUB231SD, VFMSUB231SS, VFNMADD231SD, VFNMADD231SS, SHLX, SHRX, SARX, ADDPD, SUBPD, MULPD,
+        DIVPD, MOVAPD, MOVHPD, UNPCKLPD, UNPCKHPD
     };
 
 public:
@@ -121,6 +126,15 @@ struct AssemblyItem final : std::variant<Label, Directive, Instruction> {
  */
 std::ostream& operator<<(std::ostream& os, const Label& label);
 
+/**
+ * @brief Appends the textual representation of `Label` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param label The label to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Label& label);
+
 /**
  * @brief Streams a detailed description of a `Directive`.
  *
@@ -130,6 +144,15 @@ std::ostream& operator<<(std::ostream& os, const Label& label);
  */
 std::ostream& operator<<(std::ostream& os, const Directive& directive);
 
+/**
+ * @brief Appends the textual representation of `Directive` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param directive The directive to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Directive& directive);
+
 /**
  * @brief Streams a detailed description of a `Instruction::Opcode`.
  *
@@ -139,6 +162,15 @@ std::ostream& operator<<(std::ostream& os, const Directive& directive);
  */
 std::ostream& operator<<(std::ostream& os, const Instruction::Opcode& opcode);
 
+/**
+ * @brief Appends the textual representation of `Instruction::Opcode` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param opcode The instruction opcode to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Instruction::Opcode& opcode);
+
 /**
  * @brief Streams a detailed description of a `Instruction`.
  *
@@ -148,6 +180,15 @@ std::ostream& operator<<(std::ostream& os, const Instruction::Opcode& opcode);
  */
 std::ostream& operator<<(std::ostream& os, const Instruction& instruction);
 
+/**
+ * @brief Appends the textual representation of `Instruction` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param instruction The instruction to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Instruction& instruction);
+
 /**
  * @brief Streams a detailed description of a `AssemblyItem`.
  *
@@ -156,6 +197,15 @@ std::ostream& operator<<(std::ostream& os, const Instruction& instruction);
  * @return A reference to the output stream @p os.
  */
 std::ostream& operator<<(std::ostream& os, const AssemblyItem& item);
+
+/**
+ * @brief Appends the textual representation of `AssemblyItem` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param item The assembly item to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const AssemblyItem& item);
 } // namespace arkoi::x86_64
 
 // BSD 3-Clause License
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ostream>
+
+#include "arkoi_language/x86_64/encoder.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief Writes the machine code of an `Encoder` as relocatable ELF64 object file.
+ *
+ * The object consists of the `.text` and `.data` sections, their relocations, the
+ * symbol table and the string tables. Labels only known as reference are undefined
+ * global symbols, which are resolved by the linker.
+ *
+ * @see Encoder
+ */
+class ElfWriter {
+public:
+    /**
+     * @brief Constructs an `ElfWriter`.
+     *
+     * @param encoder The encoder holding the finished sections and symbols.
+     */
+    explicit ElfWriter(const Encoder& encoder) :
+        _encoder(encoder) { }
+
+    /**
+     * @brief Writes the object file to @p output.
+     *
+     * @param output The binary stream the object file is written to.
+     */
+    void write(std::ostream& output) const;
+
+private:
+    const Encoder& _encoder;
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
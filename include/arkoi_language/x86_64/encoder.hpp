@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/x86_64/assembly.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief Translates an assembly listing into machine code without an external assembler.
+ *
+ * The encoder understands exactly the items produced by the `Generator`: the instructions
+ * of `Instruction::Opcode`, labels, and the section, symbol, alignment and data directives.
+ * Jumps and calls always use 32-bit displacements. References to labels of the same section
+ * are resolved by `finish`, all other references are left as relocations for the linker.
+ * Debug line directives are skipped, thus objects encoded this way carry no line information.
+ *
+ * Any item that cannot be encoded throws a `std::invalid_argument`.
+ *
+ * @see ElfWriter, Generator
+ */
+class Encoder {
+public:
+    /**
+     * @brief The sections machine code and data are emitted to.
+     */
+    enum class Section {
+        Text,     ///< The executable code, `.section .text`.
+        Data,     ///< The writable data of the program, `.section .data`.
+        Bss,      ///< The zero-initialized memory reserved by `.comm`, which takes no space in the object.
+        Literal4, ///< The 4-byte constants the linker may merge, `.section .rodata.cst4`.
+        Literal8, ///< The 8-byte constants the linker may merge, `.section .rodata.cst8`.
+        Hot,      ///< The frequently executed code, `.section .text.hot`.
+        Unlikely, ///< The rarely executed code, `.section .text.unlikely`.
+    };
+
+    /**
+     * @brief A symbol of the object, either defined by a label or referenced by an instruction.
+     */
+    struct Symbol {
+        /// The name of the label.
+        std::string name;
+
+        /// The section the symbol is defined in, or std::nullopt if it is defined in another object.
+        std::optional<Section> section{ };
+
+        /// The offset of the symbol inside of its section.
+        size_t offset{ };
+
+        /// The size in bytes given by a `.size` directive.
+        size_t size{ };
+
+        /// If the symbol was made visible to other objects by a `.global` directive.
+        bool global{ };
+
+        /// If the symbol was marked as function by a `.type` directive.
+        bool function{ };
+    };
+
+    /**
+     * @brief A reference the linker needs to fill in.
+     */
+    struct Relocation {
+        /// The offset of the field inside of its section.
+        size_t offset{ };
+
+        /// The index of the referenced symbol in `symbols`.
+        size_t symbol{ };
+
+        /// The ELF relocation type, e.g. `R_X86_64_PC32`.
+        uint32_t type{ };
+
+        /// The constant added to the address of the symbol.
+        int64_t addend{ };
+    };
+
+    /**
+     * @brief The encoded content of a single section.
+     */
+    struct SectionData {
+        /// The bytes of the section, which are all zero for `Section::Bss`.
+        std::vector<uint8_t> bytes{ };
+
+        /// The references inside of the section, which are left to the linker.
+        std::vector<Relocation> relocations{ };
+    };
+
+public:
+    Encoder() = default;
+
+    /**
+     * @brief Encodes all items into the current section, starting with the text section.
+     *
+     * @param items The assembly listing to encode, which may be split over multiple calls.
+     */
+    void encode(std::span<const AssemblyItem> items);
+
+    /**
+     * @brief Encodes all items into the current section, starting with the text section.
+     *
+     * @param items The assembly listing to encode, which may be split over multiple calls.
+     */
+    void encode(const std::vector<AssemblyItem>& items) { encode(std::span(items)); }
+
+    /**
+     * @brief Resolves all label references, which must be called after the last `encode`.
+     */
+    void finish();
+
+    /**
+     * @brief Returns the encoded content of the given section.
+     *
+     * @param section The section to get.
+     * @return A constant reference to the `SectionData`.
+     */
+    [[nodiscard]] const SectionData& section(Section section) const;
+
+    /**
+     * @brief Returns all symbols in the order they were first used.
+     *
+     * @return A constant reference to the symbols.
+     */
+    [[nodiscard]] auto& symbols() const { return _symbols; }
+
+private:
+    /**
+     * @brief A label reference of an instruction that is resolved in `finish`.
+     */
+    struct Fixup {
+        Section section;
+        size_t offset;
+        size_t symbol;
+        uint32_t type;
+        int64_t addend;
+    };
+
+    void _encode(const Label& label);
+
+    void _encode(const Directive& directive);
+
+    void _encode(const Instruction& instruction);
+
+    /**
+     * @brief Encodes the two operand integer instructions based on the `/digit` of their immediate form.
+     */
+    void _arithmetic(uint8_t digit, const Operand& destination, const Operand& source);
+
+    void _mov(const Operand& destination, const Operand& source);
+
+    void _test(const Operand& destination, const Operand& source);
+
+    void _imul(const Operand& destination, const Operand& source);
+
+    void _shift(uint8_t digit, const Operand& destination, const Operand& source);
+
+    void _push(const Operand& source);
+
+    /**
+     * @brief Encodes a SSE instruction, where the destination is always encoded in the reg field.
+     */
+    void _sse(uint8_t prefix, uint8_t opcode, const Operand& destination, const Operand& source, bool wide = false);
+
+    /**
+     * @brief Encodes a VEX instruction of the form `destination, source, register or memory`.
+     *
+     * @param prefix The implied mandatory prefix, or zero if there is none.
+     * @param opcode The opcode byte following the escape bytes of the map.
+     * @param operands The destination, the additional source in the vvvv field and the r/m operand.
+     * @param wide If the VEX.W bit is set, which selects a 64-bit integer or a double precision operand.
+     * @param map The opcode map, either 1 for 0F or 2 for 0F38.
+     */
+    void _avx(
+        uint8_t prefix, uint8_t opcode, const std::vector<Operand>& operands, bool wide = false, uint8_t map = 1
+    );
+
+    /**
+     * @brief Emits the VEX prefix, opcode, ModR/M, SIB and displacement of an instruction.
+     *
+     * @param prefix The implied mandatory prefix, or zero if there is none.
+     * @param map The opcode map, either 1 for 0F or 2 for 0F38.
+     * @param wide If the VEX.W bit is set.
+     * @param opcode The opcode byte.
+     * @param reg The register encoded in the reg field.
+     * @param source The register encoded in the vvvv field.
+     * @param rm The register or memory operand encoded in the r/m field.
+     */
+    void _vex(uint8_t prefix, uint8_t map, bool wide, uint8_t opcode, uint8_t reg, uint8_t source, const Operand& rm);
+
+    /**
+     * @brief Encodes a relative jump or call to a label, the opcode bytes are followed by a 32-bit displacement.
+     */
+    void _branch(std::span<const uint8_t> opcode, const Operand& target, uint32_t type);
+
+    /**
+     * @brief Emits the prefixes, opcode, ModR/M, SIB and displacement of an instruction.
+     *
+     * @param prefix The mandatory or operand size prefix, or zero if there is none.
+     * @param wide If the REX.W bit is set for a 64-bit operand size.
+     * @param opcode The opcode bytes.
+     * @param reg The register or `/digit` encoded in the reg field.
+     * @param rm The register or memory operand encoded in the r/m field.
+     * @param trailing The amount of immediate bytes following, which RIP-relative addresses need to skip.
+     * @param force_rex If a REX prefix is needed even without any of its bits, see `needs_rex`.
+     */
+    void _modrm(
+        uint8_t prefix, bool wide, std::span<const uint8_t> opcode, uint8_t reg, const Operand& rm,
+        size_t trailing = 0, bool force_rex = false
+    );
+
+    /**
+     * @brief Emits the ModR/M, SIB and displacement of an instruction, which follow its opcode.
+     *
+     * @param reg The register or `/digit` encoded in the reg field.
+     * @param rm The register or memory operand encoded in the r/m field.
+     * @param trailing The amount of immediate bytes following, which RIP-relative addresses need to skip.
+     */
+    void _rm(uint8_t reg, const Operand& rm, size_t trailing);
+
+    void _immediate(int64_t value, size_t size);
+
+    /**
+     * @brief Appends the quoted string of an `.asciz` directive with its null terminator.
+     */
+    void _string(std::string_view literal);
+
+    [[nodiscard]] size_t _symbol(const std::string& name);
+
+    [[nodiscard]] SectionData& _current() { return _sections[static_cast<size_t>(_section)]; }
+
+private:
+    std::unordered_map<std::string, size_t> _symbol_indices{ };
+    std::vector<SectionData> _sections{ 7 };
+    std::vector<Symbol> _symbols{ };
+    std::vector<Fixup> _fixups{ };
+    Section _section{ Section::Text };
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
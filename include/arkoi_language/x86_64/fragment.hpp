@@ -0,0 +1,104 @@
+#pragma once
+
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arkoi_language/x86_64/assembly.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief The assembly generated for a single function.
+ *
+ * A fragment only references its own labels (which are qualified by the name of the function),
+ * the symbols of other functions and constants named after their bit pattern. Thus fragments
+ * generated by different compilations can be stitched together into a single listing, which
+ * allows the code of unchanged functions to be reused.
+ *
+ * @see Generator
+ */
+struct Fragment {
+    /// The items of the text section, from the symbol directives to the `.size` directive.
+    std::vector<AssemblyItem> text{ };
+
+    /// The items of the data section, which hold the memoization table of the function.
+    std::vector<AssemblyItem> data{ };
+
+    /// The floating point constants referenced by the text, which are shared with all other fragments.
+    std::vector<AssemblyItem> constants{ };
+
+    /// The key and execution counter of every block, only emitted for instrumented functions.
+    std::vector<AssemblyItem> counters{ };
+
+    /**
+     * @brief Returns the functions called by the fragment, including tail calls.
+     *
+     * @return The names of the functions in the order they are referenced, without duplicates.
+     */
+    [[nodiscard]] std::vector<std::string> callees() const;
+
+    /**
+     * @brief Orders fragments along the calls between them, starting at `main`.
+     *
+     * Every function is followed by the functions it calls, in a depth-first walk over the calls
+     * in the order they are referenced. Thus a caller and its first callee are adjacent, and the
+     * code that runs together shares its cache lines and pages. Fragments that aren't reached
+     * from `main` keep their order, each starting a walk of its own.
+     *
+     * @param fragments The fragments with the names of their functions, in the order of the source.
+     * @return The fragments in the order they should be stitched together.
+     */
+    [[nodiscard]] static std::vector<const Fragment*> call_order(
+        const std::vector<std::pair<std::string, const Fragment*>>& fragments
+    );
+
+    /**
+     * @brief Serializes the fragment into a compact binary representation.
+     *
+     * @param output The stream the fragment is written to.
+     */
+    void write(std::ostream& output) const;
+
+    /**
+     * @brief Deserializes a fragment written by `write`.
+     *
+     * @param input The stream the fragment is read from.
+     * @return The fragment, or std::nullopt if the input is truncated or malformed.
+     */
+    [[nodiscard]] static std::optional<Fragment> read(std::istream& input);
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
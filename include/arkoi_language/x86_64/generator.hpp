@@ -1,10 +1,17 @@
 #pragma once
 
-#include <sstream>
+#include <map>
+#include <set>
+#include <span>
 
 #include "arkoi_language/il/instruction.hpp"
 #include "arkoi_language/x86_64/assembly.hpp"
+#include "arkoi_language/x86_64/fragment.hpp"
+#include "arkoi_language/x86_64/layout.hpp"
+#include "arkoi_language/x86_64/peephole.hpp"
 #include "arkoi_language/x86_64/resolver.hpp"
+#include "arkoi_language/x86_64/selector.hpp"
+#include "arkoi_language/x86_64/target.hpp"
 
 namespace arkoi::x86_64 {
 /**
@@ -20,6 +27,24 @@ struct ClassifiedArguments {
     std::vector<il::Operand> stack{ };    ///< Arguments passed on the stack.
 };
 
+/**
+ * @brief A move of an argument into the register it's passed in.
+ */
+struct ArgumentMove {
+    Register destination; ///< The argument register.
+    Operand source;       ///< The value that is passed.
+    sem::Type type;       ///< The type of the argument.
+};
+
+/**
+ * @brief How much debug information is emitted along the generated code.
+ */
+enum class DebugInfo {
+    None,  ///< No debug directives at all, which keeps the listing small and fast to assemble.
+    Lines, ///< A ".loc" whenever the source line changes, shared by all following instructions of that line.
+    Full,  ///< A ".loc" at the start of every block and after every call, so each of them maps to its line.
+};
+
 /**
  * @brief Visitor that generates x86-64 assembly from the Intermediate Language (IL).
  *
@@ -30,6 +55,12 @@ struct ClassifiedArguments {
  * @see il::Visitor, Resolver, RegisterAllocator, AssemblyItem
  */
 class Generator final : il::Visitor {
+public:
+    /**
+     * @brief The number of arguments cached for a memoized function, each entry takes 16 bytes of the bss.
+     */
+    static constexpr uint32_t MEMO_ENTRIES = 1024;
+
 public:
     /**
      * @brief Constructs an x86-64 code generator for the given module.
@@ -44,14 +75,90 @@ public:
     ) :
         _mappings(std::move(resolvers)), _source(source), _function(nullptr), _module(module) { }
 
+    /**
+     * @brief Generates a fragment for every function of the module and stitches them together.
+     *
+     * The peephole optimizer runs over every fragment on its own, as all of its rules stay
+     * within a single function anyway.
+     */
     void run();
 
     /**
-     * @brief Finalizes generation and returns the assembly source as a stream.
+     * @brief Replaces the listing with the file directives and `_start`, followed by the fragments.
+     *
+     * The fragments are only referenced and not copied into the listing, thus they have to outlive
+     * every use of `write`, `text` and `data`.
+     *
+     * @param fragments The fragments in the order they are emitted, which may stem from other compilations.
+     */
+    void stitch(const std::vector<const Fragment*>& fragments);
+
+    /**
+     * @brief Returns the peephole optimizer, its rules can be disabled before `run` is called.
+     *
+     * @return A reference to the `PeepholeOptimizer`.
+     */
+    [[nodiscard]] auto& peephole() { return _peephole; }
+
+    /**
+     * @brief Instruments every generated function with a counter per basic block.
+     *
+     * `_start` writes the keys and counts of all blocks to @p path once `main` returned, which is
+     * read back by `il::Profile`. Must be called before `run`.
+     *
+     * @param path The file the profile is written to, relative paths are made absolute.
+     */
+    void instrument(const std::string& path);
+
+    /**
+     * @brief Selects the instruction set extensions the generated code may use, which is baseline x86-64 by default.
+     *
+     * Must be called before `run`, as fragments are cached by the configuration they were generated with.
+     *
+     * @param target The extensions of the processor the code is generated for.
+     * @param contract Whether a floating point multiplication may be fused with its addition, which needs FMA.
+     */
+    void select_target(const Target& target, bool contract = false);
+
+    /**
+     * @brief Selects how much debug information is emitted, which is `DebugInfo::Full` by default.
      *
-     * @return A `std::stringstream` containing the complete assembly listing.
+     * Must be called before `run`, the generated code itself is the same for every level.
+     *
+     * @param level The amount of debug directives emitted.
+     */
+    void select_debug_info(DebugInfo level);
+
+    /**
+     * @brief Writes the complete assembly listing to @p output.
+     *
+     * The items are formatted straight from the stitched fragments into a large buffer, which is
+     * written to @p output in chunks. Thus the listing itself is never held in memory as a whole.
+     *
+     * @param output The stream the listing is written to.
+     */
+    void write(std::ostream& output) const;
+
+    /**
+     * @brief Returns the items of the text section, starting with the file directives, followed by the fragments.
+     *
+     * @return The consecutive parts of the text section, which reference the stitched fragments.
+     */
+    [[nodiscard]] std::vector<std::span<const AssemblyItem>> text() const;
+
+    /**
+     * @brief Returns the items of the data sections, which hold the memoization tables, the profile and the constants.
+     *
+     * @return The consecutive parts of the data section, which reference the stitched fragments.
+     */
+    [[nodiscard]] std::vector<std::span<const AssemblyItem>> data() const;
+
+    /**
+     * @brief Returns the fragments generated by `run`, keyed by the name of their function.
+     *
+     * @return A constant reference to the fragments.
      */
-    [[nodiscard]] std::stringstream output() const;
+    [[nodiscard]] auto& fragments() const { return _fragments; }
 
 private:
     /**
@@ -76,11 +183,15 @@ private:
     void visit(il::BasicBlock& block) override;
 
     /**
-     * @brief Returns are handled by the epilogue logic in `visit(il::Function)`.
+     * @brief Loads the return value into the return register.
+     *
+     * Returned variables are usually pre-colored to the return register, which
+     * makes this a no-op unless the value is an immediate or lives on the stack.
+     * The epilogue itself is emitted by `visit(il::BasicBlock)` for the exit block.
      *
      * @param instruction The `il::Return` node to visit.
      */
-    void visit([[maybe_unused]] il::Return& instruction) override { }
+    void visit(il::Return& instruction) override;
 
     /**
     * @brief Translates an IL binary operation into machine code.
@@ -117,7 +228,7 @@ private:
      * @param right The right-hand operand to perform the multiplication.
      * @param type The type of the operands.
      */
-    void _mul(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _mul(const Operand& result, Operand left, Operand right, const sem::Type& type);
 
     /**
      * @brief Emits machine code for integer or floating-point division.
@@ -129,6 +240,94 @@ private:
      */
     void _div(const Operand& result, Operand left, Operand right, const sem::Type& type);
 
+    /**
+     * @brief Emits a scalar floating-point instruction, in its VEX form if the target supports AVX.
+     *
+     * The legacy SSE form overwrites its left operand, while the VEX form writes the result straight into
+     * the result register, which saves the copy of the left operand.
+     *
+     * @param legacy The emitter of the SSE form.
+     * @param avx The opcode of the VEX form.
+     * @param result The operand in which the result should be stored.
+     * @param left The left-hand operand.
+     * @param right The right-hand operand.
+     * @param type The floating type of the operands.
+     */
+    void _scalar(
+        void (Generator::*legacy)(const Operand&, const Operand&), Instruction::Opcode avx, const Operand& result,
+        Operand left, const Operand& right, const sem::Type& type
+    );
+
+    /**
+     * @brief Emits a single FMA instruction for a multiply-add matched by the `InstructionSelector`.
+     *
+     * @param result The operand in which the result should be stored.
+     * @param pattern The factors and the addend of the multiply-add.
+     * @param type The floating type of the operands.
+     */
+    void _fused(const Operand& result, const FusedPattern& pattern, const sem::Type& type);
+
+    /**
+     * @brief Emits a chain of pairs matched by the `InstructionSelector` as packed instructions.
+     *
+     * The chain stays packed in one of the scratch registers, while the other one takes the next pair of operands.
+     * Only the results of the last step are written, the lower lane first and then the upper one.
+     *
+     * @param pattern The pairs of operations of every step.
+     */
+    void _packed(const PackedPattern& pattern);
+
+    /**
+     * @brief Packs @p lower and @p upper into the two lanes of @p destination.
+     *
+     * @param destination The scratch register the operands are packed into.
+     * @param lower The operand of the lower lane.
+     * @param upper The operand of the upper lane.
+     */
+    void _pack(const Register& destination, const il::Operand& lower, const il::Operand& upper);
+
+    /**
+     * @brief Emits machine code for an integer shift to the left.
+     *
+     * @param result The operand in which the result should be stored.
+     * @param left The operand to be shifted.
+     * @param right The shift amount, which is either an immediate or a register if the target supports BMI2.
+     * @param type The type of the operands.
+     */
+    void _shift_left(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+
+    /**
+     * @brief Emits machine code for an integer shift to the right, which is arithmetic for signed types.
+     *
+     * @param result The operand in which the result should be stored.
+     * @param left The operand to be shifted.
+     * @param right The shift amount, which is either an immediate or a register if the target supports BMI2.
+     * @param type The type of the operands.
+     */
+    void _shift_right(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+
+    /**
+     * @brief Emits a BMI2 shift by a register, which neither needs the amount in CL nor overwrites its source.
+     *
+     * @param opcode Either SHLX, SHRX or SARX.
+     * @param result The operand in which the result should be stored.
+     * @param left The operand to be shifted.
+     * @param right The shift amount, which isn't an immediate.
+     * @param type The type of the operands, which is at least 32 bits wide.
+     */
+    void _shift_register(
+        Instruction::Opcode opcode, const Operand& result, const Operand& left, Operand right, const sem::Type& type
+    );
+
+    /**
+     * @brief Emits the compare instruction setting the flags for a comparison.
+     *
+     * @param left The left-hand operand of the comparison.
+     * @param right The right-hand operand of the comparison.
+     * @param type The type of the operands.
+     */
+    void _compare(Operand left, const Operand& right, const sem::Type& type);
+
     /**
      * @brief Emits machine code for greater-than comparison.
      *
@@ -137,7 +336,7 @@ private:
      * @param right The right-hand operand to perform the greater-than.
      * @param type The type of the operands.
      */
-    void _gth(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _gth(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type);
 
     /**
      * @brief Emits machine code for less-than comparison.
@@ -147,7 +346,7 @@ private:
      * @param right The right-hand operand to perform the less-than.
      * @param type The type of the operands.
      */
-    void _lth(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _lth(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type);
 
     /**
      * @brief Emits machine code for greater-equal comparison.
@@ -157,7 +356,7 @@ private:
      * @param right The right-hand operand to perform the greater-equal.
      * @param type The type of the operands.
      */
-    void _goe(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _goe(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type);
 
     /**
      * @brief Emits machine code for less-equal comparison.
@@ -167,7 +366,7 @@ private:
      * @param right The right-hand operand to perform the less-equal.
      * @param type The type of the operands.
      */
-    void _loe(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _loe(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type);
 
     /**
      * @brief Emits machine code for equal comparison.
@@ -177,7 +376,7 @@ private:
      * @param right The right-hand operand to perform the equal.
      * @param type The type of the operands.
      */
-    void _equ(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _equ(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type);
 
     /**
      * @brief Emits machine code for not equal comparison.
@@ -187,7 +386,7 @@ private:
      * @param right The right-hand operand to perform the not equal.
      * @param type The type of the operands.
      */
-    void _neq(const Operand& result, Operand left, const Operand& right, const sem::Type& type);
+    void _neq(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type);
 
     /**
      * @brief Translates an IL type cast into machine code.
@@ -246,6 +445,18 @@ private:
      */
     void _int_to_float(const Operand& result, Operand source, const sem::Integral& from, const sem::Floating& to);
 
+    /**
+     * @brief Converts a 32-bit or 64-bit integer register or memory operand into the scratch floating register.
+     *
+     * The conversion only writes the lower part of its destination, thus the scratch register is zeroed first.
+     * Otherwise the conversion would wait for whatever instruction wrote the scratch register last.
+     *
+     * @param source The integer operand to convert.
+     * @param to The floating type to convert to.
+     * @return The scratch register holding the converted value.
+     */
+    Register _convert_to_float(const Operand& source, const sem::Floating& to);
+
     /**
      * @brief Converts an integer to a boolean (non-zero check).
      *
@@ -291,11 +502,109 @@ private:
     void visit(il::Call& instruction) override;
 
     /**
-     * @brief Translates a function call argument into machine code.
+     * @brief Pushes the stack arguments of a call and moves the others into their argument registers.
+     *
+     * @param frame The call frame of the call, as it was set up by the resolver.
+     */
+    void _generate_arguments(const CallFrame& frame);
+
+    /**
+     * @brief Emits the moves into the argument registers as if they all happened at once.
+     *
+     * No register is overwritten before every move reading it was emitted. A cycle of
+     * moves, e.g. swapping RDI and RSI, costs one move into the scratch register.
+     *
+     * @param moves The moves into the argument registers.
+     */
+    void _parallel_move(std::vector<ArgumentMove> moves);
+
+    /**
+     * @brief Adjusts a stack slot addressed by RSP to the arguments already pushed for the current call.
+     *
+     * @param operand The operand as it was resolved at the entry of the call.
+     * @return The operand, displaced by the pushed arguments if it's relative to RSP.
+     */
+    [[nodiscard]] Operand _pushed_relative(const Operand& operand) const;
+
+    /**
+     * @brief Determines if the call at the given index can be emitted as a jump.
+     *
+     * This is the case if the call is directly followed by the return of its
+     * result in the exit block, and none of its arguments are passed on the stack.
+     *
+     * @param block The block containing the instruction.
+     * @param index The index of the instruction inside the block.
+     * @return True if the instruction is a tail call.
+     */
+    [[nodiscard]] bool _is_tail_call(il::BasicBlock& block, size_t index);
+
+    /**
+     * @brief Determines if the comparison at the given index can be fused with the following branch or select.
+     *
+     * This is the case if the comparison result is only used as the condition of the `il::If` or
+     * `il::Select` directly following it, which allows branching or moving on the flags without
+     * materializing a boolean.
+     *
+     * @param block The block containing the instruction.
+     * @param index The index of the instruction inside the block.
+     * @return True if the comparison and its user can be fused.
+     */
+    [[nodiscard]] bool _is_fused_condition(il::BasicBlock& block, size_t index);
+
+    /**
+     * @brief Gets the conditional jump taken if the given comparison holds.
+     *
+     * @param instruction The comparison to get the jump for.
+     * @return The conditional jump opcode, or `std::nullopt` if the operator is no comparison.
+     */
+    [[nodiscard]] static std::optional<Instruction::Opcode> _branch_opcode(const il::Binary& instruction);
+
+    /**
+     * @brief Gets the conditional move that moves under the same condition as @p jump.
+     *
+     * @param jump A conditional jump returned by `_branch_opcode`.
+     * @return The conditional move opcode.
+     */
+    [[nodiscard]] static Instruction::Opcode _cmov_opcode(Instruction::Opcode jump);
+
+    /**
+     * @brief Translates a tail call into the epilogue of the function followed by a `JMP` to the callee.
+     *
+     * @param instruction The `il::Call` to translate.
+     */
+    void _tail_call(il::Call& instruction);
+
+    /**
+     * @brief Emits the cache lookup in front of a memoized function, see `il::Function::is_memoized`.
+     *
+     * Every cached argument has an entry of the result and a flag if it's filled in the bss section. On a hit
+     * the result is returned right away, otherwise the body is called like a function and its result stored.
+     * The recursive calls of the body go through the cache again, as they still call the function itself.
      *
-     * @param argument The `il::Argument` to translate.
+     * @param function The `il::Function` whose body follows.
      */
-    void _generate_argument(il::Argument& argument);
+    void _memoize(il::Function& function);
+
+    /**
+     * @brief Collects the callee-saved registers the current function uses, which must be preserved.
+     *
+     * @return The registers in the order they are pushed in the prologue.
+     */
+    [[nodiscard]] std::set<Register::Base> _callee_saved() const;
+
+    /**
+     * @brief Restores the callee-saved registers and the stack frame of the current function.
+     */
+    void _epilogue();
+
+    /**
+     * @brief Returns the bytes RSP is lowered by below the callee-saved registers, which keeps calls aligned.
+     *
+     * This is only the case for frames addressed by the stack pointer, all others return 0.
+     *
+     * @return The size of the frame including the padding.
+     */
+    [[nodiscard]] size_t _frame_size() const;
 
     /**
      * @brief Translates a conditional jump into machine code.
@@ -346,6 +655,29 @@ private:
      */
     void visit(il::Assign& instruction) override;
 
+    /**
+     * @brief Translates a select into a conditional move.
+     *
+     * Integers and booleans are selected with CMOVNZ on the scratch registers.
+     * Floating point values are selected the same way on their bit patterns,
+     * which are moved through the integer scratch registers. A fused comparison
+     * selects with the conditional move of its operator instead.
+     *
+     * @param instruction The `il::Select` node to visit.
+     */
+    void visit(il::Select& instruction) override;
+
+    /**
+     * @brief Moves @p source into @p destination without converting its bits.
+     *
+     * Either operand may be an XMM register, in which case MOVD/MOVQ is used.
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     * @param size The size of the moved value.
+     */
+    void _move_bits(const Operand& destination, const Operand& source, Size size);
+
     /**
      * @brief Resolves an IL operand to its machine location via the `Resolver`.
      *
@@ -420,6 +752,22 @@ private:
      */
     void _label(const std::string& name);
 
+    /**
+     * @brief Qualifies the label of a block by the current function, thus it's unique across fragments.
+     *
+     * @param label The label of the `il::BasicBlock`.
+     * @return The name of the label in the assembly.
+     */
+    [[nodiscard]] std::string _block_label(const std::string& label) const;
+
+    /**
+     * @brief Returns the label of the profile counter of a block of the current function.
+     *
+     * @param block The `il::BasicBlock` that is counted.
+     * @return The name of the counter in the data section.
+     */
+    [[nodiscard]] std::string _counter_label(const il::BasicBlock& block) const;
+
     /**
      * @brief Emplace an unconditional jump.
      *
@@ -441,6 +789,14 @@ private:
      */
     void _call(const std::string& name);
 
+    /**
+     * @brief Emplace a LEA instruction (load effective address).
+     *
+     * @param destination The destination register.
+     * @param source The memory operand whose address is loaded.
+     */
+    void _lea(const Operand& destination, const Operand& source);
+
     /**
      * @brief Emplace a MOVSXD instruction (sign-extend move).
      *
@@ -605,6 +961,65 @@ private:
      */
     void _udiv(const Operand& source);
 
+    /**
+     * @brief Emplace a CDQ instruction (sign-extend EAX into EDX:EAX).
+     */
+    void _cdq();
+
+    /**
+     * @brief Emplace a CQO instruction (sign-extend RAX into RDX:RAX).
+     */
+    void _cqo();
+
+    /**
+     * @brief Emplace a SHL instruction (logical shift to the left).
+     *
+     * @param destination The destination operand.
+     * @param source The immediate shift amount.
+     */
+    void _shl(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a SHR instruction (logical shift to the right).
+     *
+     * @param destination The destination operand.
+     * @param source The immediate shift amount.
+     */
+    void _shr(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a SAR instruction (arithmetic shift to the right).
+     *
+     * @param destination The destination operand.
+     * @param source The immediate shift amount.
+     */
+    void _sar(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a conditional move, e.g. CMOVNZ (move if the zero flag is not set).
+     *
+     * @param opcode The conditional move to emplace.
+     * @param destination The destination register.
+     * @param source The source operand.
+     */
+    void _cmov(Instruction::Opcode opcode, const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a MOVD instruction (move 32 bits between XMM and general-purpose registers).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _movd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a MOVQ instruction (move 64 bits between XMM and general-purpose registers).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _movq(const Operand& destination, const Operand& source);
+
     /**
      * @brief Emplace a XORPS instruction (bitwise XOR on packed single-precision values).
      *
@@ -613,6 +1028,80 @@ private:
      */
     void _xorps(const Operand& destination, const Operand& source);
 
+    /**
+     * @brief Emplace an ADDPD instruction (packed double-precision add).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _addpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a SUBPD instruction (packed double-precision subtract).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _subpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a MULPD instruction (packed double-precision multiply).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _mulpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a DIVPD instruction (packed double-precision divide).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _divpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a MOVAPD instruction (move both double-precision lanes).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _movapd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a MOVHPD instruction (load the upper double-precision lane from memory).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _movhpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace an UNPCKLPD instruction (interleave the lower double-precision lanes).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _unpcklpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace an UNPCKHPD instruction (interleave the upper double-precision lanes).
+     *
+     * @param destination The destination operand.
+     * @param source The source operand.
+     */
+    void _unpckhpd(const Operand& destination, const Operand& source);
+
+    /**
+     * @brief Emplace a three operand VEX instruction, whose first source isn't overwritten.
+     *
+     * @param opcode The opcode of the instruction.
+     * @param destination The destination operand.
+     * @param first The first source operand, which must be a register.
+     * @param second The second source operand.
+     */
+    void _vex(Instruction::Opcode opcode, const Operand& destination, const Operand& first, const Operand& second);
+
     /**
      * @brief Emplace an OR instruction.
      *
@@ -778,13 +1267,6 @@ private:
      */
     void _setp(const Operand& destination);
 
-    /**
-     * @brief Emplace an ENTER instruction (create stack frame).
-     *
-     * @param size The size of the stack frame.
-     */
-    void _enter(uint16_t size);
-
     /**
      * @brief Emplace a SYSCALL instruction.
      */
@@ -807,6 +1289,13 @@ private:
      */
     static void _newline(std::vector<AssemblyItem>& output);
 
+    /**
+     * @brief Emits the constants of all @p fragments once, in the mergeable read-only sections.
+     *
+     * @param fragments The fragments that are stitched together.
+     */
+    void _pool(const std::vector<const Fragment*>& fragments);
+
     /**
      * @brief Returns the current resolver which must be set at calling time.
      *
@@ -816,12 +1305,25 @@ private:
 
 private:
     std::optional<pretty_diagnostics::Span> _debug_span{ };
+    std::optional<Instruction::Opcode> _fused_condition{ };
+    std::optional<BlockLayout> _layout{ };
+    std::optional<InstructionSelector> _selector{ };
+    std::optional<std::string> _profile_path{ };
     std::unordered_map<il::Function*, Resolver> _mappings;
     std::shared_ptr<pretty_diagnostics::Source> _source;
+    std::vector<const Fragment*> _stitched{ };
+    std::vector<AssemblyItem> _profile{ };
+    std::vector<AssemblyItem> _literals{ };
     std::vector<AssemblyItem> _data{ };
     std::vector<AssemblyItem> _text{ };
+    std::unordered_map<std::string, Fragment> _fragments{ };
+    PeepholeOptimizer _peephole{ };
     il::Function* _function;
-    size_t _constants{ };
+    std::map<std::string, std::string> _constants{ };
+    size_t _pushed{ };
+    Target _target{ };
+    DebugInfo _debug_info{ DebugInfo::Full };
+    bool _contract{ };
     il::Module& _module;
 };
 } // namespace arkoi::x86_64
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/x86_64/encoder.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief Loads the machine code of one or more `Encoder`s into executable memory.
+ *
+ * This takes the role of the linker for in-process execution: The text sections of all
+ * modules are placed into one executable mapping, followed by their data, constant and bss sections,
+ * and the remaining relocations are applied against the final addresses. Just like with the
+ * linker, every global symbol may only be defined by a single module.
+ *
+ * Any module that cannot be loaded throws a `std::invalid_argument`, failing to map the
+ * memory throws a `std::system_error`.
+ *
+ * @see Encoder
+ */
+class Jit {
+public:
+    /**
+     * @brief The signature of the `main` function, whose result is the exit code of the program.
+     */
+    using Entry = uint64_t (*)();
+
+public:
+    Jit() = default;
+
+    ~Jit();
+
+    Jit(const Jit&) = delete;
+
+    Jit& operator=(const Jit&) = delete;
+
+    /**
+     * @brief Adds the finished module of @p encoder, which needs to outlive the call to `load`.
+     *
+     * @param encoder The encoder holding the finished sections and symbols.
+     */
+    void add(const Encoder& encoder);
+
+    /**
+     * @brief Maps all added modules and resolves their references to each other.
+     */
+    void load();
+
+    /**
+     * @brief Returns the loaded function of a global symbol.
+     *
+     * @param name The name of the global symbol.
+     * @return A pointer to the function, which can be called directly.
+     */
+    [[nodiscard]] Entry entry(const std::string& name) const;
+
+private:
+    /**
+     * @brief Returns the address of a symbol of the module at @p module.
+     */
+    [[nodiscard]] uintptr_t _address(size_t module, size_t symbol) const;
+
+    /**
+     * @brief Returns the offset of a section of the module at @p module inside of the mapping.
+     */
+    [[nodiscard]] size_t _start(Encoder::Section section, size_t module) const;
+
+private:
+    std::unordered_map<std::string, uintptr_t> _globals{ };
+    std::vector<const Encoder*> _modules{ };
+    std::vector<size_t> _hot_offsets{ }, _text_offsets{ }, _unlikely_offsets{ }, _data_offsets{ }, _bss_offsets{ };
+    std::vector<size_t> _literal4_offsets{ }, _literal8_offsets{ };
+    uint8_t* _memory{ };
+    size_t _size{ };
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief Orders the blocks of a function so that likely successors follow their predecessor.
+ *
+ * Blocks are placed in chains, where every block is followed by its most likely successor
+ * that is not placed yet. This turns the branch to it into a fall-through, which is later
+ * removed by the `PeepholeOptimizer`. Successors that are only reached with a probability
+ * below `COLD_PROBABILITY` are deferred until all other blocks are placed.
+ *
+ * If both successors of a branch carry a profile count, its probability is their ratio. Otherwise
+ * it's estimated with the static heuristics of Ball and Larus, combined with the Dempster-Shafer rule.
+ *
+ * The layout also decides the text section of the function. `main` and functions with loops are
+ * hot, functions the profile never saw executed are unlikely. Blocks the profile never saw executed
+ * in an otherwise executed function are split off into the unlikely section, which keeps them out of
+ * the cache lines and pages of the hot code.
+ *
+ * @see Generator, il::LoopAnalysis
+ */
+class BlockLayout {
+public:
+    /**
+     * @brief The text sections code is placed in, which the linker groups by their name.
+     */
+    enum class Section {
+        Text,     ///< The default section, `.text`.
+        Hot,      ///< The frequently executed code, `.text.hot`.
+        Unlikely, ///< The rarely executed code, `.text.unlikely`.
+    };
+
+public:
+    /// Successors reached with a lower probability are cold and placed at the end.
+    static constexpr double COLD_PROBABILITY = 0.2;
+
+    /// The probability of a branch staying inside of its loop.
+    static constexpr double LOOP_PROBABILITY = 0.88;
+
+    /// The probability of an equality comparison not holding.
+    static constexpr double OPCODE_PROBABILITY = 0.84;
+
+public:
+    /**
+     * @brief Computes the layout of all blocks of @p function.
+     *
+     * @param function The function to lay out, the entry block always comes first.
+     */
+    explicit BlockLayout(il::Function& function);
+
+    /**
+     * @brief Returns the blocks in the order they should be emitted.
+     *
+     * @return A constant reference to the blocks.
+     */
+    [[nodiscard]] auto& blocks() const { return _blocks; }
+
+    /**
+     * @brief Returns the index of the first block that is split off into the unlikely section.
+     *
+     * @return The index into `blocks`, which is their size if no block is split off.
+     */
+    [[nodiscard]] size_t split() const { return _split; }
+
+    /**
+     * @brief Returns the section the function, except for the blocks behind `split`, is placed in.
+     *
+     * @return The section of the function.
+     */
+    [[nodiscard]] Section section() const { return _section; }
+
+    /**
+     * @brief Returns the directive that switches to @p section.
+     *
+     * @param section The section to switch to.
+     * @return The directive, e.g. `.section .text.hot,"ax",@progbits`.
+     */
+    [[nodiscard]] static std::string directive(Section section);
+
+    /**
+     * @brief Checks if @p block is the header of a loop, which is worth aligning.
+     *
+     * @param block The block to check.
+     * @return True if the block is a loop header.
+     */
+    [[nodiscard]] bool is_loop_header(const il::BasicBlock* block) const;
+
+    /**
+     * @brief Estimates the probability of control flowing from @p from to @p to.
+     *
+     * @param from The block the edge starts in.
+     * @param to The block the edge ends in.
+     * @return The probability, or zero if @p to is no successor of @p from.
+     */
+    [[nodiscard]] double probability(il::BasicBlock* from, const il::BasicBlock* to) const;
+
+private:
+    /**
+     * @brief Estimates the probability of the conditional branch of @p block being taken.
+     *
+     * @param block The block ending in an `il::If`.
+     * @return The probability of the control flowing to `BasicBlock::branch`.
+     */
+    [[nodiscard]] double _branch_probability(il::BasicBlock* block) const;
+
+    /**
+     * @brief Combines two independent estimates of the same branch.
+     *
+     * @param first The first probability.
+     * @param second The second probability.
+     * @return The combined probability.
+     */
+    [[nodiscard]] static double _combine(double first, double second);
+
+    /**
+     * @brief Decides the section of the function and moves the blocks that never executed behind the others.
+     *
+     * @param function The function that was laid out.
+     */
+    void _place(il::Function& function);
+
+private:
+    std::vector<il::BasicBlock*> _blocks{ };
+    Section _section{ Section::Text };
+    size_t _split{ };
+    il::LoopAnalysis _loops;
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
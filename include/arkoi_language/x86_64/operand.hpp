@@ -2,8 +2,10 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <variant>
 
+#include "arkoi_language/utils/output_buffer.hpp"
 #include "arkoi_language/utils/size.hpp"
 
 namespace arkoi::x86_64 {
@@ -97,11 +99,14 @@ public:
      *
      * @param size The size of the memory access (e.g., QWORD).
      * @param address The base address component.
-     * @param index The index component.
-     * @param scale The scale factor for the index.
+     * @param index The optional index register, which is scaled and added to the base.
+     * @param scale The scale factor for the index, either 1, 2, 4 or 8.
      * @param displacement The constant displacement.
      */
-    Memory(const Size size, Register address, const int64_t index, const int64_t scale, const int64_t displacement) :
+    Memory(
+        const Size size, Register address, const std::optional<Register> index, const int64_t scale,
+        const int64_t displacement
+    ) :
         _index(index), _scale(scale), _displacement(displacement), _address(address), _size(size) { }
 
     /**
@@ -112,7 +117,7 @@ public:
      * @param displacement The constant offset.
      */
     Memory(const Size size, Register address, const int64_t displacement) :
-        _index(1), _scale(1), _displacement(displacement), _address(address), _size(size) { }
+        _scale(1), _displacement(displacement), _address(address), _size(size) { }
 
     /**
      * @brief Minimal constructor for simple symbolic or fixed addresses.
@@ -121,7 +126,7 @@ public:
      * @param address The symbolic or fixed base address.
      */
     Memory(const Size size, Address address) :
-        _index(1), _scale(1), _displacement(0), _address(std::move(address)), _size(size) { }
+        _scale(1), _displacement(0), _address(std::move(address)), _size(size) { }
 
     /**
      * @brief Equality compares index, scale, displacement, address, and size.
@@ -168,7 +173,7 @@ public:
     [[nodiscard]] auto scale() const { return _scale; }
 
     /**
-     * @brief Returns the index component.
+     * @brief Returns the index register, if the address has one.
      *
      * @return The index of the address.
      */
@@ -182,7 +187,8 @@ public:
     [[nodiscard]] auto size() const { return _size; }
 
 private:
-    int64_t _index, _scale, _displacement;
+    std::optional<Register> _index;
+    int64_t _scale, _displacement;
     Address _address;
     Size _size;
 };
@@ -214,6 +220,15 @@ struct Operand : std::variant<Memory, Register, Immediate> {
  */
 std::ostream& operator<<(std::ostream& os, const Register& reg);
 
+/**
+ * @brief Appends the textual representation of `Register` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param reg The register to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Register& reg);
+
 /**
  * @brief Streams a detailed description of a `Register::Base`.
  *
@@ -223,6 +238,15 @@ std::ostream& operator<<(std::ostream& os, const Register& reg);
  */
 std::ostream& operator<<(std::ostream& os, const Register::Base& base);
 
+/**
+ * @brief Appends the textual representation of `Register::Base` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param base The register base to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Register::Base& base);
+
 /**
  * @brief Streams a detailed description of a `Memory`.
  *
@@ -232,6 +256,15 @@ std::ostream& operator<<(std::ostream& os, const Register::Base& base);
  */
 std::ostream& operator<<(std::ostream& os, const Memory& memory);
 
+/**
+ * @brief Appends the textual representation of `Memory` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param memory The memory to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Memory& memory);
+
 /**
  * @brief Streams a detailed description of a `Memory::Address`.
  *
@@ -241,6 +274,15 @@ std::ostream& operator<<(std::ostream& os, const Memory& memory);
  */
 std::ostream& operator<<(std::ostream& os, const Memory::Address& address);
 
+/**
+ * @brief Appends the textual representation of `Memory::Address` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param address The memory address to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Memory::Address& address);
+
 /**
  * @brief Streams a detailed description of a `Immediate`.
  *
@@ -250,6 +292,15 @@ std::ostream& operator<<(std::ostream& os, const Memory::Address& address);
  */
 std::ostream& operator<<(std::ostream& os, const Immediate& immediate);
 
+/**
+ * @brief Appends the textual representation of `Immediate` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param immediate The immediate to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Immediate& immediate);
+
 /**
  * @brief Streams a detailed description of a `Operand`.
  *
@@ -259,6 +310,15 @@ std::ostream& operator<<(std::ostream& os, const Immediate& immediate);
  */
 std::ostream& operator<<(std::ostream& os, const Operand& operand);
 
+/**
+ * @brief Appends the textual representation of `Operand` to the buffer.
+ *
+ * @param os The output buffer.
+ * @param operand The operand to describe.
+ * @return A reference to the output buffer @p os.
+ */
+utils::OutputBuffer& operator<<(utils::OutputBuffer& os, const Operand& operand);
+
 static constexpr std::array INTEGER_CALLEE_SAVED{
     Register::Base::B, Register::Base::R12, Register::Base::R13, Register::Base::R14,
     Register::Base::R15,
@@ -269,6 +329,14 @@ static constexpr std::array INTEGER_CALLER_SAVED{
     Register::Base::DI, Register::Base::R8, Register::Base::R9
 };
 
+// Values that are not live across calls prefer the caller-saved registers, as the callee-saved ones must be pushed
+// in the prologue first.
+static constexpr std::array INTEGER_REGISTERS{
+    Register::Base::A, Register::Base::C, Register::Base::D, Register::Base::SI,
+    Register::Base::DI, Register::Base::R8, Register::Base::R9, Register::Base::B,
+    Register::Base::R12, Register::Base::R13, Register::Base::R14, Register::Base::R15,
+};
+
 static constexpr std::array FLOATING_REGISTERS{
     Register::Base::XMM8, Register::Base::XMM9, Register::Base::XMM12, Register::Base::XMM13,
     Register::Base::XMM14, Register::Base::XMM15,
@@ -288,6 +356,9 @@ static constexpr Register RSP(Register::Base::SP, Size::QWORD);
 static constexpr Register RBP(Register::Base::BP, Size::QWORD);
 static constexpr Register RAX(Register::Base::A, Size::QWORD);
 static constexpr Register RDI(Register::Base::DI, Size::QWORD);
+static constexpr Register RSI(Register::Base::SI, Size::QWORD);
+static constexpr Register RDX(Register::Base::D, Size::QWORD);
+static constexpr Register RBX(Register::Base::B, Size::QWORD);
 } // namespace arkoi::x86_64
 
 //==============================================================================
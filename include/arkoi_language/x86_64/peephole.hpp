@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <vector>
+
+#include "arkoi_language/x86_64/assembly.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief Rewrites short instruction sequences of an assembly listing into cheaper ones.
+ *
+ * The generator translates one IL instruction at a time, which leaves redundant moves
+ * and branches at the seams between them. Every rule of `RULES` is tried at every
+ * instruction until none of them applies anymore. Comments, `.loc` and `.p2align`
+ * directives are skipped when looking for the following instruction, while labels end
+ * a sequence, as they might be reached from somewhere else.
+ *
+ * @see Generator, AssemblyItem
+ */
+class PeepholeOptimizer {
+public:
+    /**
+     * @brief A single rewrite of the listing.
+     */
+    struct Rule {
+        /// The name to disable the rule with and to report its hits under.
+        std::string_view name;
+
+        /// Rewrites the listing starting at the instruction at the index, returns true if anything changed.
+        bool (*apply)(std::vector<AssemblyItem>& items, size_t index);
+    };
+
+private:
+    static bool _self_move(std::vector<AssemblyItem>& items, size_t index);
+
+    static bool _reverse_move(std::vector<AssemblyItem>& items, size_t index);
+
+    static bool _store_load(std::vector<AssemblyItem>& items, size_t index);
+
+    static bool _compare_and_branch(std::vector<AssemblyItem>& items, size_t index);
+
+    static bool _branch_over_jump(std::vector<AssemblyItem>& items, size_t index);
+
+    static bool _jump_to_next(std::vector<AssemblyItem>& items, size_t index);
+
+public:
+    /**
+     * @brief All rules in the order they are tried.
+     *
+     * | Rule                 | Before                                 | After                    |
+     * |----------------------|----------------------------------------|--------------------------|
+     * | `self-move`          | `mov a, a`                             |                          |
+     * | `reverse-move`       | `mov a, b` `mov b, a`                  | `mov a, b`               |
+     * | `store-load`         | `mov [m], a` `mov b, [m]`              | `mov [m], a` `mov b, a`  |
+     * | `compare-and-branch` | `setcc a` `test a, a` `jnz L`          | `setcc a` `jcc L`        |
+     * | `branch-over-jump`   | `jcc L1` `jmp L2` `L1:`                | `jncc L2` `L1:`          |
+     * | `jump-to-next`       | `jmp L` `L:`                           | `L:`                     |
+     */
+    static constexpr std::array RULES{
+        Rule{ "self-move", &_self_move },
+        Rule{ "reverse-move", &_reverse_move },
+        Rule{ "store-load", &_store_load },
+        Rule{ "compare-and-branch", &_compare_and_branch },
+        Rule{ "branch-over-jump", &_branch_over_jump },
+        Rule{ "jump-to-next", &_jump_to_next },
+    };
+
+public:
+    PeepholeOptimizer() = default;
+
+    /**
+     * @brief Runs all enabled rules over @p items until none of them applies anymore.
+     *
+     * @param items The assembly listing, which is modified in place.
+     */
+    void run(std::vector<AssemblyItem>& items);
+
+    /**
+     * @brief Disables the rule with the given name.
+     *
+     * @param name The name of the rule.
+     * @return False if there is no rule with this name.
+     */
+    bool disable(std::string_view name);
+
+    /**
+     * @brief Returns how often the rule with the given name was applied.
+     *
+     * @param name The name of the rule.
+     * @return The amount of hits, 0 for unknown rules.
+     */
+    [[nodiscard]] size_t hits(std::string_view name) const;
+
+    /**
+     * @brief Returns the hits of all rules, in the order of `RULES`.
+     *
+     * @return A constant reference to the hit counters.
+     */
+    [[nodiscard]] auto& hits() const { return _hits; }
+
+private:
+    std::array<size_t, RULES.size()> _hits{ };
+    std::array<bool, RULES.size()> _disabled{ };
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
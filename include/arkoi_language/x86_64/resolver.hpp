@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 
 #include "allocator.hpp"
@@ -50,6 +51,18 @@ struct CallFrame {
     size_t stack_size{ 0 };
 };
 
+/**
+ * @brief How the stack frame of a function is set up and its stack slots are addressed.
+ */
+enum class Frame {
+    /// A leaf function whose slots fit into the 128 bytes below RSP, thus no frame is set up at all.
+    RedZone,
+    /// The slots are addressed relative to RBP, which is pushed and set to the stack pointer at the entry.
+    FramePointer,
+    /// The slots are addressed relative to RSP, which is only moved once at the entry and the exit.
+    StackPointer,
+};
+
 /**
  * @brief Visitor that maps abstract IL operands to physical x86-64 machine operands.
  *
@@ -61,7 +74,18 @@ struct CallFrame {
  */
 class Resolver final : il::Visitor {
 public:
-    void run(il::Function& function, const Mapping& mapping);
+    /**
+     * @brief Maps every operand of @p function to a register or stack location.
+     *
+     * @param function The function to resolve.
+     * @param mapping The registers assigned by the register allocation.
+     * @param slots The stack slots the spilled variables share.
+     * @param omit_frame_pointer Whether functions that need a frame address it relative to RSP instead of RBP.
+     */
+    void run(
+        il::Function& function, const Mapping& mapping, const SpillSlots& slots = { },
+        bool omit_frame_pointer = false
+    );
 
     [[nodiscard]] auto& mappings() const { return _mappings; }
 
@@ -76,11 +100,18 @@ public:
     /**
      * @brief Returns the total size of the stack frame in bytes.
      *
-     * This includes space for spilled variables and local allocations.
+     * This includes space for spilled variables and local allocations, packed by `_pack`.
      *
      * @return The stack size.
      */
-    [[nodiscard]] size_t stack_size() const;
+    [[nodiscard]] auto stack_size() const { return _stack_size; }
+
+    /**
+     * @brief Returns how the stack frame is set up, which is decided once the function is resolved.
+     *
+     * @return The kind of the frame.
+     */
+    [[nodiscard]] auto frame() const { return _frame; }
 
     /**
      * @brief Returns all the call frames which got mapped.
@@ -203,6 +234,13 @@ private:
      */
     void visit(il::Assign& instruction) override;
 
+    /**
+     * @brief Maps a Select instruction.
+     *
+     * @param instruction The `il::Select` node to visit.
+     */
+    void visit(il::Select& instruction) override;
+
     /**
      * @brief Registers an IL operand as a local that needs storage.
      *
@@ -218,11 +256,33 @@ private:
      */
     void _add_memory(const il::Variable& variable, const Memory& memory);
 
+    /**
+     * @brief Lays out the stack slots of all the locals and computes the size of the frame.
+     *
+     * Spilled variables sharing a slot get the same offset, the slots are ordered by decreasing size so each one
+     * is aligned to its size.
+     *
+     * @return The offset of every local below the top of the frame.
+     */
+    [[nodiscard]] std::unordered_map<il::Operand, int64_t> _pack();
+
+    /**
+     * @brief Returns the shared stack slot of a spilled variable.
+     *
+     * @param operand The local to look up.
+     * @return The slot, or std::nullopt if the local has its own storage.
+     */
+    [[nodiscard]] std::optional<size_t> _slot(const il::Operand& operand) const;
+
 private:
     std::unordered_map<il::Call*, CallFrame> _call_frames{ };
     std::unordered_map<il::Operand, Operand> _mappings{ };
     OrderedSet<il::Operand> _locals{ };
     CallFrame _current_call_frame{ };
+    Frame _frame{ Frame::RedZone };
+    size_t _stack_size{ };
+    bool _omit_frame_pointer{ };
+    SpillSlots _slots{ };
 };
 } // namespace arkoi::x86_64
 
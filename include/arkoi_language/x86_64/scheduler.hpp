@@ -0,0 +1,141 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "arkoi_language/il/cfg.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief Reorders the instructions of every block to hide the latency of slow operations.
+ *
+ * The scheduler runs on the IL before the phis are lowered and the registers are allocated.
+ * Every block is split into regions at its calls, phis, arguments, allocas and terminators,
+ * which keep their position. Inside of a region the instructions are list scheduled: of all
+ * instructions whose operands are ready, the one with the longest latency weighted path to
+ * the end of the region comes first, ties keep the original order. This moves independent
+ * work in between a division or conversion and its user.
+ *
+ * Instructions the `InstructionSelector` folds into the following one, i.e. integer address
+ * arithmetic, the product of a multiply-add and the lanes of a packed chain, are scheduled as
+ * one unit, just like a comparison and the select consuming its flags. A comparison only consumed
+ * by the branch of its block stays right in front of it, since the branch reads its flags as well.
+ *
+ * @see InstructionSelector, Generator
+ */
+class Scheduler {
+public:
+    /**
+     * @brief Schedules all blocks of @p function in place.
+     *
+     * @param function The function to schedule, which must still be in SSA form.
+     */
+    explicit Scheduler(il::Function& function);
+
+    /**
+     * @brief Returns the amount of instructions that changed their position.
+     *
+     * @return The amount of moved instructions.
+     */
+    [[nodiscard]] size_t moved() const { return _moved; }
+
+    /**
+     * @brief Estimates the cycles until the result of @p instruction can be used by another one.
+     *
+     * The latencies are those of the instructions the `Generator` emits on recent Intel and AMD
+     * processors, which are close enough to each other to share one table.
+     *
+     * @param instruction The instruction to estimate.
+     * @return The latency in cycles, at least one.
+     */
+    [[nodiscard]] static size_t latency(const il::Instruction& instruction);
+
+private:
+    /**
+     * @brief A group of adjacent instructions that is scheduled as a whole.
+     */
+    struct Unit {
+        /// The index of the first instruction of the unit inside of the region.
+        size_t first{ };
+
+        /// The amount of instructions in the unit.
+        size_t size{ };
+
+        /// The units that have to be scheduled before this one, with the cycles to wait for their results.
+        std::vector<std::pair<size_t, size_t>> predecessors{ };
+
+        /// The latency weighted length of the longest path from the unit to the end of the region.
+        size_t priority{ };
+    };
+
+    void _schedule(il::BasicBlock& block);
+
+    /**
+     * @brief Schedules the instructions of the region [@p begin, @p end) of @p block.
+     *
+     * @param block The block containing the region.
+     * @param begin The index of the first instruction of the region.
+     * @param end The index behind the last instruction of the region.
+     */
+    void _schedule(il::BasicBlock& block, size_t begin, size_t end);
+
+    /**
+     * @brief Returns the amount of instructions starting at @p index that are scheduled as one unit.
+     *
+     * @param instructions The instructions of the block.
+     * @param index The index of the first instruction of the unit.
+     * @param end The index behind the last instruction of the region.
+     * @return The size of the unit, at least one.
+     */
+    [[nodiscard]] size_t _unit(il::BasicBlock::Instructions& instructions, size_t index, size_t end);
+
+    /**
+     * @brief Checks if @p first is folded into @p second by the `InstructionSelector` or the `Generator`.
+     *
+     * @param first The earlier instruction.
+     * @param second The instruction directly following @p first.
+     * @return True if both instructions have to stay next to each other.
+     */
+    [[nodiscard]] bool _is_glued(il::Instruction& first, il::Instruction& second);
+
+    /**
+     * @brief Checks if @p instruction keeps its position and splits its block into regions.
+     */
+    [[nodiscard]] static bool _is_barrier(const il::Instruction& instruction);
+
+private:
+    std::unordered_map<il::Operand, size_t> _uses{ };
+    size_t _moved{ };
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "arkoi_language/il/cfg.hpp"
+#include "arkoi_language/x86_64/resolver.hpp"
+
+namespace arkoi::x86_64 {
+/**
+ * @brief The address `base + index * scale + displacement`, which a single `LEA` computes.
+ */
+struct AddressPattern {
+    il::Variable base;                    ///< The base, which is added as it is.
+    std::optional<il::Variable> index{ }; ///< The optional index, which is scaled first.
+    int64_t scale{ 1 };                   ///< The scale of the index, either 1, 2, 4 or 8.
+    int64_t displacement{ };              ///< The constant added on top, which always fits into 32 bits.
+};
+
+/**
+ * @brief The multiply-add of `left * right` and `addend`, which a single FMA instruction computes.
+ */
+struct FusedPattern {
+    /**
+     * @brief How the product and the addend are combined.
+     */
+    enum class Kind {
+        Add,        ///< `left * right + addend`
+        Subtract,   ///< `left * right - addend`
+        NegatedAdd, ///< `addend - left * right`
+    };
+
+    il::Operand left;   ///< The multiplicand.
+    il::Operand right;  ///< The multiplier.
+    il::Operand addend; ///< The value combined with the product.
+    Kind kind;          ///< How the product and the addend are combined.
+};
+
+/**
+ * @brief A chain of pairs of double precision operations, which packed SSE instructions compute together.
+ *
+ * Both lanes perform the same operation at every step. Every step but the first continues with the
+ * results of the step before in the same operand, which aren't used anywhere else and thus stay packed.
+ * Only the results of the last step are extracted from the packed register again.
+ */
+struct PackedPattern {
+    /// A division keeps the divider busy about four times as long as the other operations, in both forms.
+    static constexpr size_t DIVISION_COST = 4;
+
+    /// The operations of the lower and the upper lane of every step.
+    std::vector<std::array<il::Binary*, 2>> steps{ };
+
+    /**
+     * @brief Checks if @p lower and @p upper can be computed together as the two lanes of one packed instruction.
+     *
+     * @param lower The operation of the lower lane.
+     * @param upper The operation of the upper lane, which must not depend on the lower one.
+     * @return True if both are the same addition, subtraction, multiplication or division of doubles.
+     */
+    [[nodiscard]] static bool is_isomorphic(il::Binary& lower, il::Binary& upper);
+
+    /**
+     * @brief Checks if @p next continues with the results of @p previous in the same operand of both lanes.
+     *
+     * @param previous The lanes of the previous step.
+     * @param next The lanes of the following step.
+     * @return True if the packed result of @p previous can be used as one operand of @p next.
+     */
+    [[nodiscard]] static bool is_continued(
+        const std::array<il::Binary*, 2>& previous, const std::array<il::Binary*, 2>& next
+    );
+
+    /**
+     * @brief Checks if the packed instructions are cheaper than the scalar ones.
+     *
+     * Both lanes on their own take twice the operations, while the packed form needs a shuffle for every pair
+     * of operands that isn't packed already and another one to extract the upper lane of the result. This is
+     * only made up for by divisions, whose packed form takes as long as the scalar one.
+     *
+     * @return True if the chain is worth packing.
+     */
+    [[nodiscard]] bool is_profitable() const;
+};
+
+/**
+ * @brief Selects the `LEA` instructions of a function by matching trees of integer arithmetic.
+ *
+ * Additions, subtractions of a constant, multiplications by a constant and shifts by a constant
+ * are matched bottom up. The operand of such an instruction is folded into it, if it's defined by
+ * another match directly in front of it and isn't used anywhere else. Thus, no instruction is
+ * emitted in between and the operands of the folded one still hold their values. For example
+ * `t = b * 4, u = a + t, r = u + 8` becomes a single `LEA r, [a + b * 4 + 8]`.
+ *
+ * Every operand of a selected address and its result need to be in a register. A match that
+ * folds nothing is only selected if it saves a move, which is the case if the result doesn't
+ * share the register of the left operand, or if it replaces a multiplication.
+ *
+ * If contraction is enabled, a floating point multiplication directly followed by the only addition
+ * or subtraction using its result is fused into a single multiply-add. Just like with addresses,
+ * nothing is emitted in between, thus the factors still hold their values.
+ *
+ * Adjacent pairs of independent double precision operations, which the `opt::SLPVectorizer` places
+ * next to each other, are packed into a single SSE instruction if `PackedPattern::is_profitable`.
+ * The whole chain is generated at its last instruction. Every operand of the chain is defined in
+ * front of it, thus all of them are read before any result is written.
+ *
+ * @see Generator, Resolver
+ */
+class InstructionSelector {
+public:
+    /**
+     * @brief Selects the addresses of all blocks of @p function.
+     *
+     * @param function The function to select the instructions of.
+     * @param resolver The resolver of the function, which tells if an operand is in a register.
+     * @param contract Whether floating point multiplications are fused into their addition, which skips the
+     *                 rounding of the product and thus changes the result.
+     */
+    InstructionSelector(il::Function& function, const Resolver& resolver, bool contract = false);
+
+    /**
+     * @brief Returns the address computed by @p instruction, if it's selected as a `LEA`.
+     *
+     * @param instruction The instruction to look up.
+     * @return The address, or nullptr if the instruction is generated as usual.
+     */
+    [[nodiscard]] const AddressPattern* address(const il::Binary& instruction) const;
+
+    /**
+     * @brief Returns the multiply-add computed by @p instruction, if the product in front of it is fused into it.
+     *
+     * @param instruction The instruction to look up.
+     * @return The multiply-add, or nullptr if the instruction is generated as usual.
+     */
+    [[nodiscard]] const FusedPattern* fused(const il::Binary& instruction) const;
+
+    /**
+     * @brief Returns the packed chain ending with @p instruction, which generates the whole chain.
+     *
+     * @param instruction The instruction to look up.
+     * @return The packed chain, or nullptr if the instruction is generated as usual.
+     */
+    [[nodiscard]] const PackedPattern* packed(const il::Binary& instruction) const;
+
+    /**
+     * @brief Checks if @p instruction is folded into the address, multiply-add or packed chain of a later one.
+     *
+     * @param instruction The instruction to check.
+     * @return True if nothing needs to be generated for the instruction.
+     */
+    [[nodiscard]] bool is_folded(const il::Binary& instruction) const;
+
+    [[nodiscard]] size_t selected() const { return _addresses.size(); }
+
+    [[nodiscard]] size_t folded() const { return _folded.size(); }
+
+    [[nodiscard]] size_t contracted() const { return _fused.size(); }
+
+    [[nodiscard]] size_t vectorized() const { return _packed.size(); }
+
+private:
+    /**
+     * @brief The terms `operand * scale` added together with a constant, before it's turned into an address.
+     */
+    struct Sum {
+        std::vector<std::pair<il::Variable, int64_t>> terms{ };
+        int64_t displacement{ };
+        size_t first{ };
+    };
+
+    /**
+     * @brief Matches the instruction at @p index of @p block, folding the instructions directly in front of it.
+     *
+     * @param block The block containing the instruction.
+     * @param index The index of the instruction inside the block.
+     * @param sums The sums already matched in the block, by the index of their instruction.
+     * @return The sum computed by the instruction, or std::nullopt if it computes no address.
+     */
+    [[nodiscard]] std::optional<Sum> _match(
+        il::BasicBlock& block, size_t index, const std::unordered_map<size_t, Sum>& sums
+    );
+
+    /**
+     * @brief Turns @p sum into an address, as long as it's encodable by a single `LEA`.
+     *
+     * @param sum The sum to turn into an address.
+     * @return The address, or std::nullopt if it isn't encodable.
+     */
+    [[nodiscard]] static std::optional<AddressPattern> _address(const Sum& sum);
+
+    /**
+     * @brief Fuses the instruction at @p index of @p block with the multiplication directly in front of it.
+     *
+     * @param block The block containing the instruction.
+     * @param index The index of the instruction inside the block.
+     * @return The multiply-add, or std::nullopt if the instruction can't be fused.
+     */
+    [[nodiscard]] std::optional<FusedPattern> _fuse(il::BasicBlock& block, size_t index);
+
+    /**
+     * @brief Packs the adjacent pairs starting at @p index of @p block into the longest chain possible.
+     *
+     * @param block The block containing the instructions.
+     * @param index The index of the lower lane of the first pair.
+     * @return The packed chain, or std::nullopt if there is none or it isn't profitable.
+     */
+    [[nodiscard]] std::optional<PackedPattern> _pack(il::BasicBlock& block, size_t index);
+
+    /**
+     * @brief Checks if @p operand is assigned to a register.
+     *
+     * @param operand The operand to check.
+     * @return True if the operand is held in a register.
+     */
+    [[nodiscard]] bool _in_register(const il::Operand& operand) const;
+
+private:
+    std::unordered_map<const il::Binary*, AddressPattern> _addresses{ };
+    std::unordered_map<const il::Binary*, FusedPattern> _fused{ };
+    std::unordered_map<const il::Binary*, PackedPattern> _packed{ };
+    std::unordered_set<const il::Binary*> _folded{ };
+    std::unordered_map<il::Operand, size_t> _uses{ };
+    const Resolver& _resolver;
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
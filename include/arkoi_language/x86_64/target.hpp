@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace arkoi::x86_64 {
+/**
+ * @brief The instruction set extensions the generated code may use.
+ *
+ * The default is the baseline x86-64, which only has SSE2 and runs on every 64-bit processor.
+ * A processor is selected by its name, just like `-march` of other compilers, and single
+ * extensions are added or removed on top of it, just like `-mattr`.
+ *
+ * @see Generator
+ */
+struct Target {
+    /// The VEX encoded three-operand forms of the scalar SSE instructions, which don't merge into their destination.
+    bool avx{ };
+
+    /// The fused multiply-add instructions, which are only ever used if AVX is available as well.
+    bool fma{ };
+
+    /// The first set of bit manipulation instructions.
+    bool bmi{ };
+
+    /// The second set of bit manipulation instructions, e.g. the shifts by a register other than CL.
+    bool bmi2{ };
+
+    /// The instruction counting the leading zero bits.
+    bool lzcnt{ };
+
+    /**
+     * @brief Returns the extensions of a processor and applies the comma separated @p attributes on top.
+     *
+     * The processors are the microarchitecture levels "x86-64" to "x86-64-v4", the Intel and AMD
+     * processors since Haswell and Zen, and "native", which is the processor the compiler runs on.
+     *
+     * @param cpu The name of the processor.
+     * @param attributes The extensions to enable or disable, e.g. "+fma,-bmi2".
+     * @return The selected target.
+     *
+     * @throws std::invalid_argument If the processor or an extension is unknown.
+     */
+    [[nodiscard]] static Target parse(std::string_view cpu, std::string_view attributes = { });
+
+    /**
+     * @brief Returns the description of the target, which `parse` turns into the same target again.
+     *
+     * @return The enabled extensions as attributes of the baseline, e.g. "+avx,+fma".
+     */
+    [[nodiscard]] std::string describe() const;
+
+    bool operator==(const Target& other) const = default;
+};
+} // namespace arkoi::x86_64
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
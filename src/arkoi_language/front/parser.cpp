@@ -1,7 +1,6 @@
 #include "arkoi_language/front/parser.hpp"
 
 #include "arkoi_language/il/instruction.hpp"
-#include "arkoi_language/sem/symbol_table.hpp"
 #include "arkoi_language/utils/utils.hpp"
 
 #include "pretty_diagnostics/report.hpp"
@@ -11,25 +10,25 @@ using namespace arkoi::front;
 using namespace arkoi;
 
 Parser::Parser(const std::shared_ptr<Source>& source, std::vector<Token>&& tokens, utils::Diagnostics& diagnostics) :
-    _source(source), _diagnostics(diagnostics), _tokens(std::move(tokens)) {
-    for (auto it = _tokens.begin(); it != _tokens.end();) {
-        if (it->type() == Token::Type::Comment) {
-            it = _tokens.erase(it);
-
-            if (it == _tokens.end() || it->type() != Token::Type::Newline) {
-                continue;
-            }
-
-            it = _tokens.erase(it);
-        } else {
-            ++it;
-        }
+    Parser(source, std::function<Token()>{ }, diagnostics) {
+    if (tokens.empty() || tokens.back().type() != Token::Type::EndOfFile) {
+        tokens.emplace_back(Token::Type::EndOfFile, Span(source, 0, 0));
     }
+
+    // The end of file is never consumed twice, thus the index can't go past the last token.
+    _tokens = [tokens = std::move(tokens), index = size_t{ }]() mutable {
+        return tokens[index++];
+    };
 }
 
+Parser::Parser(const std::shared_ptr<Source>& source, Scanner& scanner, utils::Diagnostics& diagnostics) :
+    Parser(source, [&scanner] { return scanner.next(); }, diagnostics) { }
+
+Parser::Parser(const std::shared_ptr<Source>& source, std::function<Token()> tokens, utils::Diagnostics& diagnostics) :
+    _arena(std::make_unique<ast::Arena>()), _source(source), _diagnostics(diagnostics), _tokens(std::move(tokens)) { }
+
 ast::Program Parser::parse_program() {
-    std::vector<std::unique_ptr<ast::Node>> statements;
-    auto own_scope = _enter_scope();
+    std::vector<ast::Owned<ast::Node>> statements;
 
     while (true) {
         const auto& current = _current();
@@ -42,35 +41,37 @@ ast::Program Parser::parse_program() {
             break;
         }
 
-        try {
-            statements.push_back(_parse_program_statement());
-        } catch (const UnexpectedEndOfTokens&) {
+        auto statement = _parse_program_statement();
+        if (statement) {
+            statements.push_back(std::move(*statement));
+            continue;
+        }
+
+        if (statement.error().is_end_of_tokens()) {
             break;
-        } catch (const ParserError& error) {
-            _diagnostics.add(error.report());
-            _recover_program();
         }
-    }
 
-    _exit_scope();
+        _diagnostics.add(statement.error().report());
+        _recover_program();
+    }
 
     // Catch the case where the statement list is empty and thus can't return a valid span.
     if (statements.empty()) {
-        return { std::move(statements), Span(_source, 0, 0), own_scope };
+        return { std::move(statements), Span(_source, 0, 0), std::move(_arena) };
     }
 
     const auto span = statements.front()->span().join(statements.back()->span());
 
-    return { std::move(statements), span, own_scope };
+    return { std::move(statements), span, std::move(_arena) };
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_program_statement() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_program_statement() {
     const auto& current = _consume_any();
     if (current.type() == Token::Type::Fun) {
         return _parse_function(current);
     }
 
-    throw UnexpectedToken("fun", to_string(current.type()), current.span());
+    return std::unexpected(UnexpectedToken("fun", to_string(current.type()), current.span()));
 }
 
 void Parser::_recover_program() {
@@ -84,66 +85,70 @@ void Parser::_recover_program() {
     }
 }
 
-std::unique_ptr<ast::Function> Parser::_parse_function(const Token& keyword) {
-    auto own_scope = _enter_scope();
+Parser::Parsed<ast::Owned<ast::Function>> Parser::_parse_function(const Token& keyword) {
+    const auto name = _consume(Token::Type::Identifier);
+    if (!name) return std::unexpected(name.error());
 
-    const auto& name = _consume(Token::Type::Identifier);
-    auto identifier = ast::Identifier(name, ast::Identifier::Kind::Function, name.span());
+    auto identifier = ast::Identifier(*name, ast::Identifier::Kind::Function, name->span());
 
     auto parameters = _parse_parameters();
+    if (!parameters) return std::unexpected(parameters.error());
 
-    auto [return_type, return_span] = _parse_type();
+    const auto return_type = _parse_type();
+    if (!return_type) return std::unexpected(return_type.error());
 
-    _consume(Token::Type::Colon);
+    if (const auto colon = _consume(Token::Type::Colon); !colon) return std::unexpected(colon.error());
 
-    _consume(Token::Type::Newline);
+    if (const auto newline = _consume(Token::Type::Newline); !newline) return std::unexpected(newline.error());
 
     auto block = _parse_block();
+    if (!block) return std::unexpected(block.error());
 
-    _exit_scope();
-
-    const auto span = keyword.span().join(block->span());
+    const auto span = keyword.span().join((*block)->span());
 
-    return std::make_unique<ast::Function>(
+    return _arena->make<ast::Function>(
         identifier,
-        std::move(parameters),
-        return_type,
-        std::move(block),
-        span,
-        own_scope
+        std::move(*parameters),
+        return_type->first,
+        std::move(*block),
+        span
     );
 }
 
-std::vector<ast::Parameter> Parser::_parse_parameters() {
+Parser::Parsed<std::vector<ast::Parameter>> Parser::_parse_parameters() {
     std::vector<ast::Parameter> parameters;
 
-    _consume(Token::Type::LParent);
+    if (const auto parent = _consume(Token::Type::LParent); !parent) return std::unexpected(parent.error());
 
     while (true) {
         const auto& current = _current();
         if (current.type() == Token::Type::EndOfFile) {
-            throw UnexpectedEndOfTokens(_tokens.back().span());
+            return std::unexpected(UnexpectedEndOfTokens(current.span()));
         }
         if (current.type() == Token::Type::RParent) {
             break;
         }
 
         if (!parameters.empty()) {
-            _consume(Token::Type::Comma);
+            if (const auto comma = _consume(Token::Type::Comma); !comma) return std::unexpected(comma.error());
         }
 
-        try {
-            parameters.push_back(_parse_parameter());
-        } catch (const UnexpectedEndOfTokens&) {
-            // Propagate this error and don't try to recover here.
-            throw;
-        } catch (const ParserError& error) {
-            _diagnostics.add(error.report());
-            _recover_parameters();
+        auto parameter = _parse_parameter();
+        if (parameter) {
+            parameters.push_back(std::move(*parameter));
+            continue;
         }
+
+        // Propagate this error and don't try to recover here.
+        if (parameter.error().is_end_of_tokens()) {
+            return std::unexpected(parameter.error());
+        }
+
+        _diagnostics.add(parameter.error().report());
+        _recover_parameters();
     }
 
-    _consume(Token::Type::RParent);
+    if (const auto parent = _consume(Token::Type::RParent); !parent) return std::unexpected(parent.error());
 
     return parameters;
 }
@@ -160,106 +165,130 @@ void Parser::_recover_parameters() {
     }
 }
 
-ast::Parameter Parser::_parse_parameter() {
-    const auto& name = _consume(Token::Type::Identifier);
-    auto identifier = ast::Identifier(name, ast::Identifier::Kind::Variable, name.span());
+Parser::Parsed<ast::Parameter> Parser::_parse_parameter() {
+    const auto name = _consume(Token::Type::Identifier);
+    if (!name) return std::unexpected(name.error());
+
+    auto identifier = ast::Identifier(*name, ast::Identifier::Kind::Variable, name->span());
 
-    auto [type, type_span] = _parse_type();
+    const auto type = _parse_type();
+    if (!type) return std::unexpected(type.error());
 
-    auto span = name.span().join(type_span);
+    auto span = name->span().join(type->second);
 
-    return { identifier, type, span };
+    return ast::Parameter(identifier, type->first, span);
 }
 
-std::pair<sem::Type, Span> Parser::_parse_type() {
-    const auto& start_token = _consume(Token::Type::At);
+Parser::Parsed<std::pair<sem::Type, Span>> Parser::_parse_type() {
+    const auto start_token = _consume(Token::Type::At);
+    if (!start_token) return std::unexpected(start_token.error());
 
     const auto token = _consume_any();
 
-    const auto span = start_token.span().join(token.span());
+    const auto span = start_token->span().join(token.span());
+
+    const auto type = [&]() -> std::optional<sem::Type> {
+        switch (token.type()) {
+            case Token::Type::U8: return sem::Integral(Size::BYTE, false);
+            case Token::Type::S8: return sem::Integral(Size::BYTE, true);
+            case Token::Type::U16: return sem::Integral(Size::WORD, false);
+            case Token::Type::S16: return sem::Integral(Size::WORD, true);
+            case Token::Type::U32: return sem::Integral(Size::DWORD, false);
+            case Token::Type::S32: return sem::Integral(Size::DWORD, true);
+            case Token::Type::U64: return sem::Integral(Size::QWORD, false);
+            case Token::Type::S64: return sem::Integral(Size::QWORD, true);
+            case Token::Type::USize: return sem::Integral(Size::QWORD, false);
+            case Token::Type::SSize: return sem::Integral(Size::QWORD, true);
+            case Token::Type::F32: return sem::Floating(Size::DWORD);
+            case Token::Type::F64: return sem::Floating(Size::QWORD);
+            case Token::Type::Bool: return sem::Boolean();
+            default: return std::nullopt;
+        }
+    }();
 
-    switch (token.type()) {
-        case Token::Type::U8: return { sem::Integral(Size::BYTE, false), span };
-        case Token::Type::S8: return { sem::Integral(Size::BYTE, true), span };
-        case Token::Type::U16: return { sem::Integral(Size::WORD, false), span };
-        case Token::Type::S16: return { sem::Integral(Size::WORD, true), span };
-        case Token::Type::U32: return { sem::Integral(Size::DWORD, false), span };
-        case Token::Type::S32: return { sem::Integral(Size::DWORD, true), span };
-        case Token::Type::U64: return { sem::Integral(Size::QWORD, false), span };
-        case Token::Type::S64: return { sem::Integral(Size::QWORD, true), span };
-        case Token::Type::USize: return { sem::Integral(Size::QWORD, false), span };
-        case Token::Type::SSize: return { sem::Integral(Size::QWORD, true), span };
-        case Token::Type::F32: return { sem::Floating(Size::DWORD), span };
-        case Token::Type::F64: return { sem::Floating(Size::QWORD), span };
-        case Token::Type::Bool: return { sem::Boolean(), span };
-        default: throw UnexpectedToken("u8, s8, u16, s16, u32, s32, u64, s64, usize, ssize, bool", to_string(token.type()), token.span());
+    if (!type) {
+        const auto expected = "u8, s8, u16, s16, u32, s32, u64, s64, usize, ssize, bool";
+        return std::unexpected(UnexpectedToken(expected, to_string(token.type()), token.span()));
     }
+
+    return std::pair{ *type, span };
 }
 
-std::unique_ptr<ast::Block> Parser::_parse_block() {
-    std::vector<std::unique_ptr<ast::Node>> statements;
+Parser::Parsed<ast::Owned<ast::Block>> Parser::_parse_block() {
+    std::vector<ast::Owned<ast::Node>> statements;
 
-    auto own_scope = _enter_scope();
-    _consume(Token::Type::Indentation);
+    if (const auto indentation = _consume(Token::Type::Indentation); !indentation) {
+        return std::unexpected(indentation.error());
+    }
 
     while (true) {
         const auto& current = _current();
         if (current.type() == Token::Type::EndOfFile) {
-            throw UnexpectedEndOfTokens(_tokens.back().span());
+            return std::unexpected(UnexpectedEndOfTokens(current.span()));
         }
         if (current.type() == Token::Type::Dedentation) {
             break;
         }
 
-        try {
-            statements.push_back(_parse_block_statement());
-        } catch (const UnexpectedEndOfTokens&) {
-            // Propagate this error and don't try to recover here.
-            throw;
-        } catch (const ParserError& error) {
-            _diagnostics.add(error.report());
-            _recover_block();
+        auto statement = _parse_block_statement();
+        if (statement) {
+            statements.push_back(std::move(*statement));
+            continue;
+        }
+
+        // Propagate this error and don't try to recover here.
+        if (statement.error().is_end_of_tokens()) {
+            return std::unexpected(statement.error());
         }
+
+        _diagnostics.add(statement.error().report());
+        _recover_block();
     }
 
-    _consume(Token::Type::Dedentation);
-    _exit_scope();
+    if (const auto dedentation = _consume(Token::Type::Dedentation); !dedentation) {
+        return std::unexpected(dedentation.error());
+    }
 
     // Catch the case where the statement list is empty and thus can't return a valid span.
     if (statements.empty()) {
-        return std::make_unique<ast::Block>(std::move(statements), Span(_source, 0, 0), own_scope);
+        return _arena->make<ast::Block>(std::move(statements), Span(_source, 0, 0));
     }
 
     const auto span = statements.front()->span().join(statements.back()->span());
 
-    return std::make_unique<ast::Block>(std::move(statements), span, own_scope);
+    return _arena->make<ast::Block>(std::move(statements), span);
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_block_statement() {
-    std::unique_ptr<ast::Node> result;
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_block_statement() {
+    Parsed<ast::Owned<ast::Node>> result;
 
     const auto& consumed = _consume_any();
     if (consumed.type() == Token::Type::Return) {
-        result = _parse_return(consumed);
-        _consume(Token::Type::Newline);
+        result = Parsed<ast::Owned<ast::Node>>(_parse_return(consumed));
+        if (!result) return result;
+
+        if (const auto newline = _consume(Token::Type::Newline); !newline) return std::unexpected(newline.error());
     } else if (consumed.type() == Token::Type::Identifier) {
         auto& current = _current();
         if (current.type() == Token::Type::LParent) {
-            result = _parse_call(consumed);
+            result = Parsed<ast::Owned<ast::Node>>(_parse_call(consumed));
         } else if (current.type() == Token::Type::EqualSign) {
-            result = _parse_assign(consumed);
+            result = Parsed<ast::Owned<ast::Node>>(_parse_assign(consumed));
         } else if (current.type() == Token::Type::At) {
-            result = _parse_variable(consumed);
+            result = Parsed<ast::Owned<ast::Node>>(_parse_variable(consumed));
         }
-        _consume(Token::Type::Newline);
+        if (!result) return result;
+
+        if (const auto newline = _consume(Token::Type::Newline); !newline) return std::unexpected(newline.error());
     } else if (consumed.type() == Token::Type::If) {
-        result = _parse_if(consumed);
+        result = Parsed<ast::Owned<ast::Node>>(_parse_if(consumed));
         // Don't need to consume a newline, as the then node already parsed it
     } else if (consumed.type() == Token::Type::While) {
-        result = _parse_while(consumed);
+        result = Parsed<ast::Owned<ast::Node>>(_parse_while(consumed));
         // Don't need to consume a newline, as the then node already parsed it
     } else {
-        throw UnexpectedToken("return, if, while, assign or call", to_string(consumed.type()), consumed.span());
+        const auto expected = "return, if, while, assign or call";
+        return std::unexpected(UnexpectedToken(expected, to_string(consumed.type()), consumed.span()));
     }
 
     return result;
@@ -277,316 +306,340 @@ void Parser::_recover_block() {
     }
 }
 
-std::unique_ptr<ast::Return> Parser::_parse_return(const Token& keyword) {
+Parser::Parsed<ast::Owned<ast::Return>> Parser::_parse_return(const Token& keyword) {
     auto expression = _parse_expression();
+    if (!expression) return std::unexpected(expression.error());
 
-    const auto span = keyword.span().join(expression->span());
+    const auto span = keyword.span().join((*expression)->span());
 
-    return std::make_unique<ast::Return>(std::move(expression), span);
+    return _arena->make<ast::Return>(std::move(*expression), span);
 }
 
-std::unique_ptr<ast::If> Parser::_parse_if(const Token& keyword) {
+Parser::Parsed<ast::Owned<ast::If>> Parser::_parse_if(const Token& keyword) {
     auto expression = _parse_expression();
+    if (!expression) return std::unexpected(expression.error());
 
-    _consume(Token::Type::Colon);
+    if (const auto colon = _consume(Token::Type::Colon); !colon) return std::unexpected(colon.error());
 
-    std::unique_ptr<ast::Node> branch;
+    Parsed<ast::Owned<ast::Node>> branch;
     if (_try_consume(Token::Type::Newline)) {
-        branch = _parse_block();
+        branch = Parsed<ast::Owned<ast::Node>>(_parse_block());
     } else {
         branch = _parse_block_statement();
     }
+    if (!branch) return std::unexpected(branch.error());
 
-    auto span = keyword.span().join(branch->span());
+    auto span = keyword.span().join((*branch)->span());
 
     if (!_try_consume(Token::Type::Else)) {
-        return std::make_unique<ast::If>(std::move(expression), std::move(branch), nullptr, span);
+        return _arena->make<ast::If>(std::move(*expression), std::move(*branch), nullptr, span);
     }
 
     if (const auto token = _try_consume(Token::Type::If)) {
-        return std::make_unique<ast::If>(std::move(expression), std::move(branch), _parse_if(*token), span);
+        auto next = _parse_if(*token);
+        if (!next) return std::unexpected(next.error());
+
+        return _arena->make<ast::If>(std::move(*expression), std::move(*branch), std::move(*next), span);
     }
 
-    _consume(Token::Type::Colon);
+    if (const auto colon = _consume(Token::Type::Colon); !colon) return std::unexpected(colon.error());
 
-    std::unique_ptr<ast::Node> _next;
+    Parsed<ast::Owned<ast::Node>> _next;
     if (_try_consume(Token::Type::Newline)) {
-        _next = _parse_block();
+        _next = Parsed<ast::Owned<ast::Node>>(_parse_block());
     } else {
         _next = _parse_block_statement();
     }
+    if (!_next) return std::unexpected(_next.error());
 
-    span = keyword.span().join(_next->span());
+    span = keyword.span().join((*_next)->span());
 
-    return std::make_unique<ast::If>(std::move(expression), std::move(branch), std::move(_next), span);
+    return _arena->make<ast::If>(std::move(*expression), std::move(*branch), std::move(*_next), span);
 }
 
-std::unique_ptr<ast::While> Parser::_parse_while(const Token& keyword) {
+Parser::Parsed<ast::Owned<ast::While>> Parser::_parse_while(const Token& keyword) {
     auto expression = _parse_expression();
+    if (!expression) return std::unexpected(expression.error());
 
-    _consume(Token::Type::Colon);
+    if (const auto colon = _consume(Token::Type::Colon); !colon) return std::unexpected(colon.error());
 
-    std::unique_ptr<ast::Node> then;
+    Parsed<ast::Owned<ast::Node>> then;
     if (_try_consume(Token::Type::Newline)) {
-        then = _parse_block();
+        then = Parsed<ast::Owned<ast::Node>>(_parse_block());
     } else {
         then = _parse_block_statement();
     }
+    if (!then) return std::unexpected(then.error());
 
-    auto span = keyword.span().join(then->span());
+    auto span = keyword.span().join((*then)->span());
 
-    return std::make_unique<ast::While>(std::move(expression), std::move(then), span);
+    return _arena->make<ast::While>(std::move(*expression), std::move(*then), span);
 }
 
-std::unique_ptr<ast::Assign> Parser::_parse_assign(const Token& name) {
+Parser::Parsed<ast::Owned<ast::Assign>> Parser::_parse_assign(const Token& name) {
     auto identifier = ast::Identifier(name, ast::Identifier::Kind::Variable, name.span());
 
-    _consume(Token::Type::EqualSign);
+    if (const auto equal = _consume(Token::Type::EqualSign); !equal) return std::unexpected(equal.error());
 
     auto expression = _parse_expression();
+    if (!expression) return std::unexpected(expression.error());
 
-    const auto span = name.span().join(expression->span());
+    const auto span = name.span().join((*expression)->span());
 
-    return std::make_unique<ast::Assign>(identifier, std::move(expression), span);
+    return _arena->make<ast::Assign>(identifier, std::move(*expression), span);
 }
 
-std::unique_ptr<ast::Variable> Parser::_parse_variable(const Token& name) {
+Parser::Parsed<ast::Owned<ast::Variable>> Parser::_parse_variable(const Token& name) {
     auto identifier = ast::Identifier(name, ast::Identifier::Kind::Variable, name.span());
 
-    auto [type, type_span] = _parse_type();
+    const auto type = _parse_type();
+    if (!type) return std::unexpected(type.error());
 
-    _consume(Token::Type::EqualSign);
+    if (const auto equal = _consume(Token::Type::EqualSign); !equal) return std::unexpected(equal.error());
 
     auto expression = _parse_expression();
+    if (!expression) return std::unexpected(expression.error());
 
-    const auto span = name.span().join(expression->span());
+    const auto span = name.span().join((*expression)->span());
 
-    return std::make_unique<ast::Variable>(identifier, type, std::move(expression), span);
+    return _arena->make<ast::Variable>(identifier, type->first, std::move(*expression), span);
 }
 
-std::unique_ptr<ast::Call> Parser::_parse_call(const Token& name) {
+Parser::Parsed<ast::Owned<ast::Call>> Parser::_parse_call(const Token& name) {
     auto identifier = ast::Identifier(name, ast::Identifier::Kind::Function, name.span());
 
-    _consume(Token::Type::LParent);
+    if (const auto parent = _consume(Token::Type::LParent); !parent) return std::unexpected(parent.error());
 
-    std::vector<std::unique_ptr<ast::Node>> arguments;
+    std::vector<ast::Owned<ast::Node>> arguments;
     while (true) {
         const auto& current = _current();
         if (current.type() == Token::Type::EndOfFile) {
-            throw UnexpectedEndOfTokens(_tokens.back().span());
+            return std::unexpected(UnexpectedEndOfTokens(current.span()));
         }
         if (current.type() == Token::Type::RParent) {
             break;
         }
 
         if (!arguments.empty()) {
-            _consume(Token::Type::Comma);
+            if (const auto comma = _consume(Token::Type::Comma); !comma) return std::unexpected(comma.error());
         }
 
-        arguments.push_back(_parse_expression());
+        auto argument = _parse_expression();
+        if (!argument) return std::unexpected(argument.error());
+
+        arguments.push_back(std::move(*argument));
     }
 
     const auto end_token = _consume(Token::Type::RParent);
+    if (!end_token) return std::unexpected(end_token.error());
 
-    const auto span = name.span().join(end_token.span());
+    const auto span = name.span().join(end_token->span());
 
-    return std::make_unique<ast::Call>(identifier, std::move(arguments), span);
+    return _arena->make<ast::Call>(identifier, std::move(arguments), span);
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_expression() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_expression() {
     return _parse_logical_or();
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_logical_or() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_logical_or() {
     auto expression = _parse_logical_and();
+    if (!expression) return expression;
 
     while (auto op = _try_consume(Token::Type::Or)) {
         auto rhs = _parse_logical_and();
+        if (!rhs) return rhs;
+
+        const auto span = (*expression)->span().join((*rhs)->span());
 
-        const auto span = expression->span().join(rhs->span());
+        const auto type = ast::Binary::Operator::Or;
 
-        expression = std::make_unique<ast::Binary>(std::move(expression), ast::Binary::Operator::Or, std::move(rhs), span);
+        expression = _arena->make<ast::Binary>(std::move(*expression), type, std::move(*rhs), span);
     }
 
     return expression;
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_logical_and() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_logical_and() {
     auto expression = _parse_equality();
+    if (!expression) return expression;
 
     while (auto op = _try_consume(Token::Type::And)) {
         auto rhs = _parse_equality();
+        if (!rhs) return rhs;
+
+        const auto span = (*expression)->span().join((*rhs)->span());
 
-        const auto span = expression->span().join(rhs->span());
+        const auto type = ast::Binary::Operator::And;
 
-        expression = std::make_unique<ast::Binary>(std::move(expression), ast::Binary::Operator::And, std::move(rhs), span);
+        expression = _arena->make<ast::Binary>(std::move(*expression), type, std::move(*rhs), span);
     }
 
     return expression;
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_equality() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_equality() {
     auto expression = _parse_relation();
+    if (!expression) return expression;
 
     while (auto op = _try_consume(_is_equality_operator)) {
         auto type = _to_binary_operator(op.value());
 
         auto rhs = _parse_relation();
+        if (!rhs) return rhs;
 
-        const auto span = expression->span().join(rhs->span());
+        const auto span = (*expression)->span().join((*rhs)->span());
 
-        expression = std::make_unique<ast::Binary>(std::move(expression), type, std::move(rhs), span);
+        expression = _arena->make<ast::Binary>(std::move(*expression), type, std::move(*rhs), span);
     }
 
     return expression;
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_relation() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_relation() {
     auto expression = _parse_term();
+    if (!expression) return expression;
 
     while (auto op = _try_consume(_is_relational_operator)) {
         auto type = _to_binary_operator(op.value());
 
         auto rhs = _parse_term();
+        if (!rhs) return rhs;
 
-        const auto span = expression->span().join(rhs->span());
+        const auto span = (*expression)->span().join((*rhs)->span());
 
-        expression = std::make_unique<ast::Binary>(std::move(expression), type, std::move(rhs), span);
+        expression = _arena->make<ast::Binary>(std::move(*expression), type, std::move(*rhs), span);
     }
 
     return expression;
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_term() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_term() {
     auto expression = _parse_factor();
+    if (!expression) return expression;
 
     while (auto op = _try_consume(_is_term_operator)) {
         auto type = _to_binary_operator(op.value());
 
         auto rhs = _parse_factor();
+        if (!rhs) return rhs;
 
-        const auto span = expression->span().join(rhs->span());
+        const auto span = (*expression)->span().join((*rhs)->span());
 
-        expression = std::make_unique<ast::Binary>(std::move(expression), type, std::move(rhs), span);
+        expression = _arena->make<ast::Binary>(std::move(*expression), type, std::move(*rhs), span);
     }
 
     return expression;
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_factor() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_factor() {
     auto expression = _parse_primary();
+    if (!expression) return expression;
 
     while (auto op = _try_consume(_is_factor_operator)) {
         auto type = _to_binary_operator(op.value());
 
         auto rhs = _parse_primary();
+        if (!rhs) return rhs;
 
-        const auto span = expression->span().join(rhs->span());
+        const auto span = (*expression)->span().join((*rhs)->span());
 
-        expression = std::make_unique<ast::Binary>(std::move(expression), type, std::move(rhs), span);
+        expression = _arena->make<ast::Binary>(std::move(*expression), type, std::move(*rhs), span);
     }
 
     return expression;
 }
 
-std::unique_ptr<ast::Node> Parser::_parse_primary() {
+Parser::Parsed<ast::Owned<ast::Node>> Parser::_parse_primary() {
     const auto& consumed = _consume_any();
     if (consumed.type() == Token::Type::Integer) {
-        auto node = std::make_unique<ast::Immediate>(consumed, ast::Immediate::Kind::Integer, consumed.span());
+        auto node = _arena->make<ast::Immediate>(consumed, ast::Immediate::Kind::Integer, consumed.span());
         if (_current().type() != Token::Type::At) return node;
 
-        const auto [type, type_span] = _parse_type();
+        const auto type = _parse_type();
+        if (!type) return std::unexpected(type.error());
 
-        const auto span = consumed.span().join(type_span);
+        const auto span = consumed.span().join(type->second);
 
-        return std::make_unique<ast::Cast>(std::move(node), type, span);
+        return _arena->make<ast::Cast>(std::move(node), type->first, span);
     }
 
     if (consumed.type() == Token::Type::Floating) {
-        auto node = std::make_unique<ast::Immediate>(consumed, ast::Immediate::Kind::Floating, consumed.span());
+        auto node = _arena->make<ast::Immediate>(consumed, ast::Immediate::Kind::Floating, consumed.span());
         if (_current().type() != Token::Type::At) return node;
 
-        const auto [type, type_span] = _parse_type();
+        const auto type = _parse_type();
+        if (!type) return std::unexpected(type.error());
 
-        const auto span = consumed.span().join(type_span);
+        const auto span = consumed.span().join(type->second);
 
-        return std::make_unique<ast::Cast>(std::move(node), type, span);
+        return _arena->make<ast::Cast>(std::move(node), type->first, span);
     }
 
     if (consumed.type() == Token::Type::Identifier) {
         if (_current().type() == Token::Type::LParent) return _parse_call(consumed);
 
-        return std::make_unique<ast::Identifier>(consumed, ast::Identifier::Kind::Variable, consumed.span());
+        return _arena->make<ast::Identifier>(consumed, ast::Identifier::Kind::Variable, consumed.span());
     }
 
     if (consumed.type() == Token::Type::True || consumed.type() == Token::Type::False) {
-        return std::make_unique<ast::Immediate>(consumed, ast::Immediate::Kind::Boolean, consumed.span());
+        return _arena->make<ast::Immediate>(consumed, ast::Immediate::Kind::Boolean, consumed.span());
     }
 
     if (consumed.type() == Token::Type::LParent) {
         auto expression = _parse_expression();
-        _consume(Token::Type::RParent);
-        return expression;
-    }
+        if (!expression) return expression;
 
-    throw UnexpectedToken("integer, float, identifier, function call, grouping, true or false", to_string(consumed.type()), consumed.span());
-}
+        if (const auto parent = _consume(Token::Type::RParent); !parent) return std::unexpected(parent.error());
 
-std::shared_ptr<sem::SymbolTable> Parser::_current_scope() {
-    return _scopes.top();
-}
-
-std::shared_ptr<sem::SymbolTable> Parser::_enter_scope() {
-    if (_scopes.empty()) {
-        return _scopes.emplace(std::make_shared<sem::SymbolTable>());
+        return expression;
     }
 
-    return _scopes.emplace(std::make_shared<sem::SymbolTable>(_current_scope()));
+    const auto expected = "integer, float, identifier, function call, grouping, true or false";
+    return std::unexpected(UnexpectedToken(expected, to_string(consumed.type()), consumed.span()));
 }
 
-void Parser::_exit_scope() {
-    if (_scopes.empty()) {
-        throw std::logic_error("Cannot exit root scope");
-    }
-
-    _scopes.pop();
+const Token& Parser::_current() {
+    if (!_current_token) _current_token = _pull();
+    return *_current_token;
 }
 
-const Token& Parser::_current() {
-    if (_position >= _tokens.size()) {
-        throw UnexpectedEndOfTokens(_tokens.back().span());
-    }
+void Parser::_next() {
+    // The end of file is never left, the recovery and every loop stop at it instead.
+    if (_current().type() == Token::Type::EndOfFile) return;
 
-    return _tokens[_position];
+    _current_token.reset();
 }
 
-void Parser::_next() {
-    if (_position >= _tokens.size()) {
-        throw UnexpectedEndOfTokens(_tokens.back().span());
+Token Parser::_pull() {
+    auto token = _tokens();
+    while (token.type() == Token::Type::Comment) {
+        token = _tokens();
+        if (token.type() == Token::Type::Newline) token = _tokens();
     }
 
-    _position++;
+    return token;
 }
 
-const Token& Parser::_consume_any() {
-    const auto& current = _current();
+Token Parser::_consume_any() {
+    auto current = _current();
     _next();
     return current;
 }
 
-const Token& Parser::_consume(const Token::Type type) {
-    const auto& current = _current();
+Parser::Parsed<Token> Parser::_consume(const Token::Type type) {
+    auto current = _current();
     _next();
 
     if (current.type() != type) {
-        throw UnexpectedToken(to_string(type), to_string(current.type()), current.span());
+        return std::unexpected(UnexpectedToken(to_string(type), to_string(current.type()), current.span()));
     }
 
     return current;
 }
 
 std::optional<Token> Parser::_try_consume(const std::function<bool(const Token&)>& predicate) {
-    const auto& current = _current();
+    auto current = _current();
 
     if (!predicate(current)) return std::nullopt;
 
@@ -596,7 +649,7 @@ std::optional<Token> Parser::_try_consume(const std::function<bool(const Token&)
 }
 
 std::optional<Token> Parser::_try_consume(const Token::Type type) {
-    const auto& current = _current();
+    auto current = _current();
 
     if (current.type() != type) return std::nullopt;
 
@@ -645,7 +698,8 @@ UnexpectedEndOfTokens::UnexpectedEndOfTokens(const Span& span) :
        .message("Unexpected end of tokens")
        .code("E2000")
        .label("Reached end of file unexpectedly", span)
-       .build()
+       .build(),
+        true
     ) { }
 
 UnexpectedToken::UnexpectedToken(const std::string& expected, const std::string& got, const Span& span) :
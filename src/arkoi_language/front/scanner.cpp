@@ -1,7 +1,14 @@
 #include "arkoi_language/front/scanner.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
-#include <sstream>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "pretty_diagnostics/report.hpp"
 
@@ -11,128 +18,194 @@ using namespace arkoi;
 
 static constexpr size_t SPACE_INDENTATION = 4;
 
+#ifdef __SSE2__
+/**
+ * @brief Returns a mask of the characters of @p chunk that are between @p low and @p high.
+ *
+ * The range is shifted to start at zero, thus a single unsigned comparison is enough.
+ */
+static __m128i in_range(const __m128i chunk, const char low, const char high) {
+    const auto shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(low));
+    return _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(high - low))), shifted);
+}
+
+/**
+ * @brief Returns the length of the run at the start of @p text, scanning full chunks of 16 characters.
+ *
+ * @param text The text to scan, which is never read past its end.
+ * @param classify Returns the mask of the matching characters of a chunk.
+ * @return The exact length of the run if it ends inside of a full chunk, otherwise the length of
+ *         the full chunks, after which the remaining characters need to be scanned one by one.
+ */
+template <typename Classify>
+static size_t simd_run(const std::string_view text, Classify classify) {
+    constexpr size_t CHUNK_SIZE = sizeof(__m128i);
+
+    size_t length = 0;
+    for (; length + CHUNK_SIZE <= text.size(); length += CHUNK_SIZE) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + length));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(classify(chunk)));
+        if (mask != 0xFFFF) return length + static_cast<size_t>(std::countr_one(mask));
+    }
+
+    return length;
+}
+#endif
+
 std::vector<Token> Scanner::tokenize() {
     std::vector<Token> tokens;
     if (_source->contents().empty()) return tokens;
 
-    std::istringstream stream(_source->contents());
-    while (std::getline(stream, _current_line)) {
-        auto leading_spaces = _leading_spaces(_current_line);
-        if (leading_spaces % SPACE_INDENTATION != 0) {
-            const auto error = InvalidSpacingFormat({ _source, _source->from_coords(_row, 0), _source->from_coords(_row, leading_spaces) });
-            _diagnostics.add(error.report());
-            leading_spaces -= leading_spaces % SPACE_INDENTATION;
-        }
+    do {
+        tokens.push_back(next());
+    } while (tokens.back().type() != Token::Type::EndOfFile);
 
-        while (leading_spaces > _indentation) {
-            const auto span = Span(
-                _source,
-                _source->from_coords(_row, _indentation),
-                _source->from_coords(_row, _indentation + SPACE_INDENTATION)
-            );
-            tokens.emplace_back(Token::Type::Indentation, span);
+    return tokens;
+}
 
-            _indentation += SPACE_INDENTATION;
-            _column += SPACE_INDENTATION;
-        }
+Token Scanner::next() {
+    while (_pending.empty()) _scan_line();
+
+    auto token = std::move(_pending.front());
+    _pending.pop_front();
+
+    return token;
+}
 
-        while (leading_spaces < _indentation) {
-            tokens.emplace_back(Token::Type::Dedentation, Span(_source, 0, 0));
+void Scanner::_scan_line() {
+    // Every line is a view into the contents of the source, thus the lines are never copied.
+    const std::string_view contents = _source->contents();
+    if (_finished || _offset >= contents.size()) {
+        while (_indentation) {
+            _pending.emplace_back(Token::Type::Dedentation, Span(_source, 0, 0));
 
             _indentation -= SPACE_INDENTATION;
-            _column -= SPACE_INDENTATION;
         }
 
-        while (!_is_eol() && !_current_line.empty()) {
-            try {
-                auto token = _next_token();
-                tokens.push_back(token);
-            } catch (const UnexpectedEndOfLine& error) {
-                _diagnostics.add(error.report());
-                break;
-            } catch (const ScannerError& error) {
-                _diagnostics.add(error.report());
-                _next(1);
-            }
-        }
+        _pending.emplace_back(Token::Type::EndOfFile, Span(_source, 0, 0));
+        _finished = true;
+        return;
+    }
 
-        const auto start_location = _source->from_coords(_row, _column);
-        const auto end_location = _source->from_coords(_row, _column + 1);
-        tokens.emplace_back(Token::Type::Newline, Span(_source, start_location, end_location));
+    const auto end = std::min(contents.find('\n', _offset), contents.size());
+    _current_line = contents.substr(_offset, end - _offset);
+    _offset = end + 1;
 
-        _column = _indentation;
-        _row++;
+    auto leading_spaces = _leading_spaces(_current_line);
+    if (leading_spaces % SPACE_INDENTATION != 0) {
+        const auto error = InvalidSpacingFormat({ _source, _source->from_coords(_row, 0), _source->from_coords(_row, leading_spaces) });
+        _diagnostics.add(error.report());
+        leading_spaces -= leading_spaces % SPACE_INDENTATION;
     }
 
-    while (_indentation) {
-        tokens.emplace_back(Token::Type::Dedentation, Span(_source, 0, 0));
+    while (leading_spaces > _indentation) {
+        const auto span = Span(
+            _source,
+            _source->from_coords(_row, _indentation),
+            _source->from_coords(_row, _indentation + SPACE_INDENTATION)
+        );
+        _pending.emplace_back(Token::Type::Indentation, span);
+
+        _indentation += SPACE_INDENTATION;
+        _column += SPACE_INDENTATION;
+    }
+
+    while (leading_spaces < _indentation) {
+        _pending.emplace_back(Token::Type::Dedentation, Span(_source, 0, 0));
 
         _indentation -= SPACE_INDENTATION;
+        _column -= SPACE_INDENTATION;
     }
 
-    tokens.emplace_back(Token::Type::EndOfFile, Span(_source, 0, 0));
+    while (!_is_eol() && !_current_line.empty()) {
+        auto token = _next_token();
+        if (token) {
+            _pending.push_back(std::move(*token));
+            continue;
+        }
 
-    return tokens;
+        // Skipping the offending character also ends the line, if the error was reaching its end.
+        _diagnostics.add(token.error().report());
+        _next(1);
+    }
+
+    const auto start_location = _source->from_coords(_row, _column);
+    const auto end_location = _source->from_coords(_row, _column + 1);
+    _pending.emplace_back(Token::Type::Newline, Span(_source, start_location, end_location));
+
+    _column = _indentation;
+    _row++;
 }
 
-Token Scanner::_next_token() {
-    while (_try_consume(_is_space)) { }
+Scanner::Scanned<Token> Scanner::_next_token() {
+    _next(_space_run(_rest()));
 
     const auto current = _current_char();
-    if (_is_ident_start(current)) {
+    if (!current) return std::unexpected(current.error());
+
+    if (_is_ident_start(*current)) {
         return _lex_identifier();
     }
 
-    if (current == '-' || _is_digit(current)) {
+    if (*current == '-' || _is_digit(*current)) {
         return _lex_number();
     }
 
-    if (current == '\'') {
+    if (*current == '\'') {
         return _lex_char();
     }
 
-    if (current == '#') {
+    if (*current == '#') {
         return _lex_comment();
     }
 
     return _lex_special();
 }
 
-Token Scanner::_lex_comment() {
+Scanner::Scanned<Token> Scanner::_lex_comment() {
     const auto start_location = _current_location();
 
-    _consume('#');
-    while (!_is_eol()) _next(1);
+    // The lines are split before scanning them, thus a comment always extends to the end of its line.
+    if (const auto hash = _consume('#'); !hash) return std::unexpected(hash.error());
+    _next(_rest().size());
 
-    return { Token::Type::Comment, { _source, start_location, _current_location() } };
+    return Token(Token::Type::Comment, { _source, start_location, _current_location() });
 }
 
-Token Scanner::_lex_identifier() {
+Scanner::Scanned<Token> Scanner::_lex_identifier() {
     const auto start_location = _current_location();
+    const auto start_column = _column;
 
-    _consume(_is_ident_start, "_, a-z or A-Z");
-    while (_try_consume(_is_ident_inner)) { }
+    if (const auto start = _consume(_is_ident_start, "_, a-z or A-Z"); !start) return std::unexpected(start.error());
+    _next(_identifier_run(_rest()));
 
     const auto span = Span(_source, start_location, _current_location());
-    if (auto keyword = Token::lookup_keyword(span.substr())) {
-        return { *keyword, span };
+    const auto lexeme = _current_line.substr(start_column, _column - start_column);
+    if (auto keyword = Token::lookup_keyword(lexeme)) {
+        return Token(*keyword, span);
     }
 
-    return { Token::Type::Identifier, span };
+    return Token(span, utils::Interned(lexeme));
 }
 
-Token Scanner::_lex_number() {
+Scanner::Scanned<Token> Scanner::_lex_number() {
     const auto start_location = _current_location();
 
-    if (_try_consume('-') && !_is_digit(_current_char())) {
-        return { Token::Type::Minus, { _source, start_location, _current_location() } };
+    if (_try_consume('-')) {
+        const auto current = _current_char();
+        if (!current) return std::unexpected(current.error());
+
+        if (!_is_digit(*current)) {
+            return Token(Token::Type::Minus, { _source, start_location, _current_location() });
+        }
     }
 
     const auto consumed = _consume(_is_digit, "0-9");
-    bool floating;
+    if (!consumed) return std::unexpected(consumed.error());
 
-    if (consumed == '0' && _try_consume('x')) {
-        _consume(_is_hex, "0-9, a-f or A-F");
+    bool floating;
+    if (*consumed == '0' && _try_consume('x')) {
+        if (const auto digit = _consume(_is_hex, "0-9, a-f or A-F"); !digit) return std::unexpected(digit.error());
 
         while (_try_consume(_is_hex)) { }
 
@@ -146,11 +219,11 @@ Token Scanner::_lex_number() {
             while (_try_consume(_is_hex));
         }
     } else {
-        while (_try_consume(_is_digit)) { }
+        _next(_digit_run(_rest()));
 
         floating = _try_consume('.');
 
-        while (_try_consume(_is_digit)) { }
+        _next(_digit_run(_rest()));
 
         if (_try_consume(_is_expo)) {
             floating = true;
@@ -165,32 +238,32 @@ Token Scanner::_lex_number() {
     const auto kind = (floating ? Token::Type::Floating : Token::Type::Integer);
     const auto number = span.substr();
 
-    try {
-        if (floating) {
-            std::stold(number);
-        } else if (number.starts_with("-")) {
-            std::stoll(number);
-        } else {
-            std::stoull(number);
-        }
-    } catch (const std::out_of_range&) {
-        throw NumberOutOfRange(span);
+    // Reports the same overflows as std::stoull and friends, without them throwing std::out_of_range.
+    errno = 0;
+    if (floating) {
+        std::strtold(number.c_str(), nullptr);
+    } else if (number.starts_with("-")) {
+        std::strtoll(number.c_str(), nullptr, 10);
+    } else {
+        std::strtoull(number.c_str(), nullptr, 10);
     }
 
-    return { kind, span };
+    if (errno == ERANGE) return std::unexpected(NumberOutOfRange(span));
+
+    return Token(kind, span);
 }
 
-Token Scanner::_lex_char() {
+Scanner::Scanned<Token> Scanner::_lex_char() {
     const auto start_location = _current_location();
 
-    _consume('\'');
-    std::ignore = _consume(_is_ascii, "'");
-    _consume('\'');
+    if (const auto quote = _consume('\''); !quote) return std::unexpected(quote.error());
+    if (const auto character = _consume(_is_ascii, "'"); !character) return std::unexpected(character.error());
+    if (const auto quote = _consume('\''); !quote) return std::unexpected(quote.error());
 
-    return { Token::Type::Integer, { _source, start_location, _current_location() } };
+    return Token(Token::Type::Integer, { _source, start_location, _current_location() });
 }
 
-Token Scanner::_lex_special() {
+Scanner::Scanned<Token> Scanner::_lex_special() {
     const auto start_location = _current_location();
 
     for (size_t length = 2; length > 0; length--) {
@@ -202,15 +275,18 @@ Token Scanner::_lex_special() {
 
         _next(length);
 
-        return { *matched, { _source, start_location, _current_location() } };
+        return Token(*matched, { _source, start_location, _current_location() });
     }
 
-    throw UnknownChar(_current_char(), { _source, _source->from_coords(_row, _column), _source->from_coords(_row, _column + 1) });
+    const auto span = Span(_source, _source->from_coords(_row, _column), _source->from_coords(_row, _column + 1));
+    return std::unexpected(UnknownChar(_current_line[_column], span));
 }
 
-char Scanner::_current_char() const {
+Scanner::Scanned<char> Scanner::_current_char() const {
     if (_is_eol()) {
-        throw UnexpectedEndOfLine({ _source, _source->from_coords(_row, 0), _source->from_coords(_row, _current_line.size()) });
+        const auto end = _source->from_coords(_row, _current_line.size());
+        const auto span = Span(_source, _source->from_coords(_row, 0), end);
+        return std::unexpected(UnexpectedEndOfLine(span));
     }
 
     return _current_line[_column];
@@ -230,48 +306,25 @@ std::optional<std::string_view> Scanner::_peek(const size_t count) const {
     return std::string_view{ _current_line.data() + _column, count };
 }
 
-void Scanner::_next(const size_t count) {
-    _column += count;
-}
+std::string_view Scanner::_rest() const {
+    if (_is_eol()) return { };
 
-void Scanner::_consume(const char expected) {
-    _consume([&](const char input) { return input == expected; }, std::string(1, expected));
+    return _current_line.substr(_column);
 }
 
-char Scanner::_consume(const std::function<bool(char)>& predicate, const std::string& expected) {
-    const auto current = _current_char();
-    if (_is_eol()) {
-        throw UnexpectedEndOfLine({ _source, _source->from_coords(_row, 0), _source->from_coords(_row, _current_line.size()) });
-    }
-
-    if (!predicate(current)) {
-        throw UnexpectedChar(expected, { _source, _source->from_coords(_row, _column), _source->from_coords(_row, _column + 1) });
-    }
-
-    _next(1);
-
-    return current;
+void Scanner::_next(const size_t count) {
+    _column += count;
 }
 
-bool Scanner::_try_consume(const char expected) {
-    try {
-        _consume(expected);
-        return true;
-    } catch (const ScannerError&) {
-        return false;
-    }
+Scanner::Scanned<char> Scanner::_consume(const char expected) {
+    return _consume([&](const char input) { return input == expected; }, std::string_view(&expected, 1));
 }
 
-std::optional<char> Scanner::_try_consume(const std::function<bool(char)>& predicate) {
-    try {
-        auto consumed = _consume(predicate, "");
-        return consumed;
-    } catch (const ScannerError&) {
-        return std::nullopt;
-    }
+bool Scanner::_try_consume(const char expected) {
+    return _try_consume([&](const char input) { return input == expected; }).has_value();
 }
 
-size_t Scanner::_leading_spaces(const std::string& line) {
+size_t Scanner::_leading_spaces(const std::string_view line) {
     size_t count = 0;
 
     for (const auto& current : line) {
@@ -282,6 +335,43 @@ size_t Scanner::_leading_spaces(const std::string& line) {
     return count;
 }
 
+size_t Scanner::_space_run(const std::string_view text) {
+    size_t length = 0;
+#ifdef __SSE2__
+    length = simd_run(text, [](const __m128i chunk) {
+        // Same as std::isspace, which are the space and the control characters from '\t' to '\r'.
+        return _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')), in_range(chunk, '\t', '\r'));
+    });
+#endif
+
+    while (length < text.size() && _is_space(text[length])) length++;
+    return length;
+}
+
+size_t Scanner::_identifier_run(const std::string_view text) {
+    size_t length = 0;
+#ifdef __SSE2__
+    length = simd_run(text, [](const __m128i chunk) {
+        const auto letters = _mm_or_si128(in_range(chunk, 'a', 'z'), in_range(chunk, 'A', 'Z'));
+        const auto digits = _mm_or_si128(in_range(chunk, '0', '9'), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')));
+        return _mm_or_si128(letters, digits);
+    });
+#endif
+
+    while (length < text.size() && _is_ident_inner(text[length])) length++;
+    return length;
+}
+
+size_t Scanner::_digit_run(const std::string_view text) {
+    size_t length = 0;
+#ifdef __SSE2__
+    length = simd_run(text, [](const __m128i chunk) { return in_range(chunk, '0', '9'); });
+#endif
+
+    while (length < text.size() && _is_digit(text[length])) length++;
+    return length;
+}
+
 bool Scanner::_is_digit(const char input) {
     return std::isdigit(static_cast<unsigned char>(input));
 }
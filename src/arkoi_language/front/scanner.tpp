@@ -0,0 +1,61 @@
+#pragma once
+
+namespace arkoi::front {
+template <typename Predicate>
+Scanner::Scanned<char> Scanner::_consume(Predicate&& predicate, const std::string_view expected) {
+    const auto current = _current_char();
+    if (!current) return current;
+
+    if (!predicate(*current)) {
+        const auto span = pretty_diagnostics::Span(_source, _source->from_coords(_row, _column), _source->from_coords(_row, _column + 1));
+        return std::unexpected(UnexpectedChar(std::string(expected), span));
+    }
+
+    _next(1);
+
+    return current;
+}
+
+template <typename Predicate>
+std::optional<char> Scanner::_try_consume(Predicate&& predicate) {
+    if (_is_eol()) return std::nullopt;
+
+    const auto current = _current_line[_column];
+    if (!predicate(current)) return std::nullopt;
+
+    _next(1);
+
+    return current;
+}
+} // namespace arkoi::front
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,69 +1,90 @@
 #include "arkoi_language/front/token.hpp"
 
-#include <unordered_map>
-
 #include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi::front;
 using namespace arkoi;
 
 std::optional<Token::Type> Token::lookup_keyword(const std::string_view& value) {
-    static const std::unordered_map<std::string_view, Type> KEYWORDS = {
-        { "if", Type::If },
-        { "else", Type::Else },
-        { "fun", Type::Fun },
-        { "return", Type::Return },
-        { "u8", Type::U8 },
-        { "s8", Type::S8 },
-        { "u16", Type::U16 },
-        { "s16", Type::S16 },
-        { "u32", Type::U32 },
-        { "s32", Type::S32 },
-        { "u64", Type::U64 },
-        { "s64", Type::S64 },
-        { "usize", Type::USize },
-        { "ssize", Type::SSize },
-        { "f64", Type::F64 },
-        { "f32", Type::F32 },
-        { "bool", Type::Bool },
-        { "true", Type::True },
-        { "false", Type::False },
-        { "while", Type::While },
-    };
-
-    const auto keyword = KEYWORDS.find(value);
-    if (keyword != KEYWORDS.end()) {
-        return { keyword->second };
+    if (value.empty()) return std::nullopt;
+
+    // The first character leaves at most five candidates, which are mostly rejected by their length already.
+    switch (value.front()) {
+        case 'b':
+            if (value == "bool") return Type::Bool;
+            break;
+        case 'e':
+            if (value == "else") return Type::Else;
+            break;
+        case 'f':
+            if (value == "fun") return Type::Fun;
+            if (value == "f64") return Type::F64;
+            if (value == "f32") return Type::F32;
+            if (value == "false") return Type::False;
+            break;
+        case 'i':
+            if (value == "if") return Type::If;
+            break;
+        case 'r':
+            if (value == "return") return Type::Return;
+            break;
+        case 's':
+            if (value == "s8") return Type::S8;
+            if (value == "s16") return Type::S16;
+            if (value == "s32") return Type::S32;
+            if (value == "s64") return Type::S64;
+            if (value == "ssize") return Type::SSize;
+            break;
+        case 't':
+            if (value == "true") return Type::True;
+            break;
+        case 'u':
+            if (value == "u8") return Type::U8;
+            if (value == "u16") return Type::U16;
+            if (value == "u32") return Type::U32;
+            if (value == "u64") return Type::U64;
+            if (value == "usize") return Type::USize;
+            break;
+        case 'w':
+            if (value == "while") return Type::While;
+            break;
+        default: break;
     }
 
     return std::nullopt;
 }
 
 std::optional<Token::Type> Token::lookup_special(const std::string_view& value) {
-    static const std::unordered_map<std::string_view, Type> SPECIAL = {
-        { "&&", Type::And },
-        { "||", Type::Or },
-        { "!=", Type::NotEqual },
-        { "==", Type::Equal },
-        { ">=", Type::GreaterEqual },
-        { "<=", Type::LessEqual },
-        { "(", Type::LParent },
-        { ")", Type::RParent },
-        { "@", Type::At },
-        { ",", Type::Comma },
-        { "+", Type::Plus },
-        { "-", Type::Minus },
-        { "/", Type::Slash },
-        { "*", Type::Asterisk },
-        { ">", Type::GreaterThan },
-        { "<", Type::LessThan },
-        { "=", Type::EqualSign },
-        { ":", Type::Colon }
-    };
-
-    const auto special = SPECIAL.find(value);
-    if (special != SPECIAL.end()) {
-        return { special->second };
+    if (value.size() == 1) {
+        switch (value.front()) {
+            case '(': return Type::LParent;
+            case ')': return Type::RParent;
+            case '@': return Type::At;
+            case ',': return Type::Comma;
+            case '+': return Type::Plus;
+            case '-': return Type::Minus;
+            case '/': return Type::Slash;
+            case '*': return Type::Asterisk;
+            case '>': return Type::GreaterThan;
+            case '<': return Type::LessThan;
+            case '=': return Type::EqualSign;
+            case ':': return Type::Colon;
+            default: return std::nullopt;
+        }
+    }
+
+    if (value.size() == 2) {
+        if (value == "&&") return Type::And;
+        if (value == "||") return Type::Or;
+        if (value[1] != '=') return std::nullopt;
+
+        switch (value.front()) {
+            case '!': return Type::NotEqual;
+            case '=': return Type::Equal;
+            case '>': return Type::GreaterEqual;
+            case '<': return Type::LessEqual;
+            default: return std::nullopt;
+        }
     }
 
     return std::nullopt;
@@ -1,48 +1,71 @@
 #include "arkoi_language/il/analyses.hpp"
 
+#include <limits>
 #include <ranges>
 
+#include "arkoi_language/il/analysis_manager.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
 using namespace arkoi::il;
 using namespace arkoi;
 
 using State = BlockLivenessAnalysis::State;
 
+void BlockLivenessAnalysis::prepare(Function& function) {
+    _index = OperandIndex(function);
+    _uses.clear();
+    _defs.clear();
+
+    for (auto& block : function) {
+        auto& uses = _uses.insert_or_assign(&block, State(_index)).first->second;
+        auto& defs = _defs.insert_or_assign(&block, State(_index)).first->second;
+
+        for (auto& instruction : std::ranges::reverse_view(block.instructions())) {
+            for (const auto& definition : instruction.defs()) {
+                if (std::holds_alternative<Immediate>(definition)) continue;
+                uses.erase(definition);
+                defs.insert(definition);
+            }
+
+            for (const auto& use : instruction.uses()) {
+                if (std::holds_alternative<Immediate>(use)) continue;
+                uses.insert(use);
+            }
+        }
+    }
+}
+
 State BlockLivenessAnalysis::merge(const std::vector<State>& predecessors) {
-    State result;
-    for (const auto& state : predecessors) result.insert(state.begin(), state.end());
+    State result(_index);
+    for (const auto& state : predecessors) result |= state;
     return result;
 }
 
 State BlockLivenessAnalysis::initialize(Function&, BasicBlock&) {
-    return { };
+    return State(_index);
 }
 
 State BlockLivenessAnalysis::transfer(BasicBlock& current, const State& state) {
+    // In[B] = Use[B] U (Out[B] - Def[B]), where Use[B] only contains the upward-exposed uses.
     State in = state;
-
-    for (auto& instruction : std::ranges::reverse_view(current.instructions())) {
-        for (const auto& definition : instruction.defs()) {
-            if (std::holds_alternative<Immediate>(definition)) continue;
-            in.erase(definition);
-        }
-
-        for (const auto& use : instruction.uses()) {
-            if (std::holds_alternative<Immediate>(use)) continue;
-            in.insert(use);
-        }
-    }
-
+    in -= _defs.at(&current);
+    in |= _uses.at(&current);
     return in;
 }
 
+void InstructionLivenessAnalysis::prepare(Function& function) {
+    _index = OperandIndex(function);
+    _live_across_calls = State(_index);
+}
+
 State InstructionLivenessAnalysis::merge(const std::vector<State>& predecessors) {
-    State result;
-    for (const auto& state : predecessors) result.insert(state.begin(), state.end());
+    State result(_index);
+    for (const auto& state : predecessors) result |= state;
     return result;
 }
 
 State InstructionLivenessAnalysis::initialize(Function&, Instruction&) {
-    return { };
+    return State(_index);
 }
 
 State InstructionLivenessAnalysis::transfer(Instruction& current, const State& state) {
@@ -55,7 +78,7 @@ State InstructionLivenessAnalysis::transfer(Instruction& current, const State& s
             in.erase(definition);
         }
 
-        _live_across_calls.insert(in.begin(), in.end());
+        _live_across_calls |= in;
     }
 
     State in = state;
@@ -76,6 +99,468 @@ bool InstructionLivenessAnalysis::is_live_across_calls(const Operand& operand) c
     return _live_across_calls.contains(operand);
 }
 
+void SparseLivenessAnalysis::run(Function& function) {
+    _blocks.run(function);
+    _live_across_calls = State{ };
+
+    for (auto& block : function) {
+        for_each_live_out(
+            block,
+            [&](const Instruction& instruction, const State& live) {
+                if (!std::holds_alternative<Call>(instruction)) return;
+
+                State across = live;
+                for (const auto& definition : instruction.defs()) {
+                    across.erase(definition);
+                }
+
+                _live_across_calls |= across;
+            }
+        );
+    }
+}
+
+bool SparseLivenessAnalysis::is_live_across_calls(const Operand& operand) const {
+    return _live_across_calls.contains(operand);
+}
+
+void SparseLivenessAnalysis::_step(const Instruction& instruction, State& live) {
+    assert(!std::holds_alternative<Phi>(instruction));
+
+    for (const auto& definition : instruction.defs()) {
+        if (std::holds_alternative<Immediate>(definition)) continue;
+        live.erase(definition);
+    }
+
+    for (const auto& use : instruction.uses()) {
+        if (std::holds_alternative<Immediate>(use)) continue;
+        live.insert(use);
+    }
+}
+
+DominanceAnalysis::DominanceAnalysis(Function& function) :
+    _tree(function) {
+    _immediates = _tree.immediates();
+    _frontiers = DominatorTree::compute_frontiers(function, _immediates);
+
+    for (auto& block : function) {
+        const auto found = _immediates.find(&block);
+        if (found == _immediates.end() || !found->second) continue;
+        _children[found->second].push_back(found->first);
+    }
+}
+
+const std::vector<BasicBlock*>& DominanceAnalysis::children(BasicBlock* block) const {
+    static const std::vector<BasicBlock*> EMPTY{ };
+
+    const auto found = _children.find(block);
+    if (found == _children.end()) return EMPTY;
+    return found->second;
+}
+
+LoopAnalysis::LoopAnalysis(Function& function) :
+    LoopAnalysis(function, DominatorTree(function)) { }
+
+LoopAnalysis::LoopAnalysis(Function& function, AnalysisManager& analyses) :
+    LoopAnalysis(function, analyses.get<DominanceAnalysis>(function).tree()) { }
+
+LoopAnalysis::LoopAnalysis(Function& function, const DominatorTree& dominators) {
+    std::vector<BasicBlock*> order;
+    for (auto& block : function) order.push_back(&block);
+
+    // All back edges to the same header belong to the same loop.
+    for (auto* header : order) {
+        auto loop = std::make_unique<Loop>();
+        loop->header = header;
+
+        for (auto* predecessor : header->predecessors()) {
+            if (dominators.dominates(header, predecessor)) loop->latches.push_back(predecessor);
+        }
+
+        if (loop->latches.empty()) continue;
+        std::ranges::sort(loop->latches, { }, [&](auto* block) { return std::ranges::find(order, block) - order.begin(); });
+
+        // Walk backwards from the latches, the header stops the walk as it dominates the whole loop.
+        std::unordered_set<BasicBlock*> body{ header };
+        std::vector worklist(loop->latches);
+        while (!worklist.empty()) {
+            auto* block = worklist.back();
+            worklist.pop_back();
+
+            if (!body.insert(block).second) continue;
+            for (auto* predecessor : block->predecessors()) {
+                if (dominators.contains(predecessor)) worklist.push_back(predecessor);
+            }
+        }
+
+        for (auto* block : order) {
+            if (body.contains(block)) loop->blocks.push_back(block);
+        }
+
+        _loops.push_back(std::move(loop));
+    }
+
+    // Inner loops have fewer blocks than the loops containing them, thus they are visited first.
+    std::ranges::stable_sort(_loops, { }, [](const auto& loop) { return loop->blocks.size(); });
+
+    for (size_t index = 0; index < _loops.size(); index++) {
+        auto& loop = *_loops[index];
+
+        for (size_t outer = index + 1; outer < _loops.size(); outer++) {
+            if (!_loops[outer]->contains(loop.header)) continue;
+
+            loop.parent = _loops[outer].get();
+            break;
+        }
+
+        for (auto* block : loop.blocks) _innermost.try_emplace(block, &loop);
+    }
+
+    for (auto& loop : std::views::reverse(_loops)) {
+        loop->depth = loop->parent ? loop->parent->depth + 1 : 1;
+    }
+}
+
+const Loop* LoopAnalysis::loop(const BasicBlock* block) const {
+    const auto found = _innermost.find(block);
+    return found == _innermost.end() ? nullptr : found->second;
+}
+
+size_t LoopAnalysis::depth(const BasicBlock* block) const {
+    const auto* found = loop(block);
+    return found ? found->depth : 0;
+}
+
+InductionAnalysis::InductionAnalysis(Function& function) :
+    _loops(function) {
+    std::unordered_map<Variable, std::pair<Instruction*, BasicBlock*>> definitions;
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            for (const auto& def : instruction.defs()) {
+                const auto* variable = std::get_if<Variable>(&def);
+                if (!variable) continue;
+
+                // Variables defined more than once are neither invariant nor induction variables.
+                const auto [it, inserted] = definitions.try_emplace(*variable, &instruction, &block);
+                if (!inserted) it->second = { nullptr, nullptr };
+            }
+        }
+    }
+
+    const auto definition = [&](const Operand& operand) -> Instruction* {
+        const auto* variable = std::get_if<Variable>(&operand);
+        if (!variable) return nullptr;
+
+        const auto found = definitions.find(*variable);
+        return found == definitions.end() ? nullptr : found->second.first;
+    };
+
+    const auto resolve = [&](Operand operand) {
+        while (auto* assign = std::get_if<Assign>(definition(operand))) operand = assign->value();
+        return operand;
+    };
+
+    for (const auto& loop : _loops.loops()) {
+        auto* header = loop->header;
+
+        const auto is_invariant = [&](const Operand& operand) {
+            if (std::holds_alternative<Immediate>(operand)) return true;
+
+            const auto* variable = std::get_if<Variable>(&operand);
+            if (!variable) return false;
+
+            // Parameters don't have a definition inside the function.
+            const auto found = definitions.find(*variable);
+            if (found == definitions.end()) return true;
+
+            return found->second.second && !loop->contains(found->second.second);
+        };
+
+        auto& inductions = _inductions[loop.get()];
+        for (auto& instruction : *header) {
+            auto* phi = std::get_if<Phi>(&instruction);
+            if (!phi || phi->incoming().size() != 2) continue;
+
+            const auto& type = phi->result().type();
+            if (!type.is_integral()) continue;
+
+            auto outside = phi->incoming()[0], inside = phi->incoming()[1];
+            if (loop->contains(outside.first)) std::swap(outside, inside);
+            if (loop->contains(outside.first) || !loop->contains(inside.first)) continue;
+
+            const auto update = resolve(inside.second);
+            auto* binary = std::get_if<Binary>(definition(update));
+            if (!binary || binary->op_type() != type) continue;
+
+            const auto& increment = definitions.at(binary->result()).second;
+            if (!loop->contains(increment)) continue;
+
+            const Operand current = phi->result();
+            std::optional<int64_t> step;
+            if (binary->op() == Binary::Operator::Add) {
+                if (resolve(binary->left()) == current) step = _constant(binary->right());
+                else if (resolve(binary->right()) == current) step = _constant(binary->left());
+            } else if (binary->op() == Binary::Operator::Sub && resolve(binary->left()) == current) {
+                const auto subtrahend = _constant(binary->right());
+                if (subtrahend && *subtrahend != std::numeric_limits<int64_t>::min()) step = -*subtrahend;
+            }
+
+            if (!step || *step == 0) continue;
+
+            inductions.push_back({
+                phi->result(), resolve(outside.second), outside.first, binary->result(), increment, inside.first, *step
+            });
+        }
+
+        auto* _if = header->instructions().empty() ? nullptr : std::get_if<If>(&header->instructions().back());
+        if (!_if) continue;
+
+        auto* comparison = std::get_if<Binary>(definition(_if->condition()));
+        if (!comparison || !comparison->result().type().is_boolean()) continue;
+        auto op = comparison->op();
+
+        auto left = resolve(comparison->left()), right = resolve(comparison->right());
+        const auto find = [&](const Operand& operand) {
+            return std::ranges::find_if(inductions, [&](const auto& induction) { return Operand(induction.variable) == operand; });
+        };
+
+        auto induction = find(left);
+        if (induction == inductions.end()) {
+            induction = find(right);
+            if (induction == inductions.end()) continue;
+
+            std::swap(left, right);
+            op = _swap(op);
+        }
+
+        if (!is_invariant(right)) continue;
+
+        // The loop is left on the false branch of the comparison, otherwise the comparison is negated.
+        const auto stays_on_true = loop->contains(header->branch()), stays_on_false = loop->contains(header->next());
+        if (stays_on_true == stays_on_false) continue;
+        if (stays_on_false) op = _negate(op);
+
+        CountedLoop counted{ *induction, op, right };
+        counted.trip_count = _trip_count(counted);
+        _counted.emplace(loop.get(), std::move(counted));
+    }
+}
+
+const std::vector<InductionVariable>& InductionAnalysis::inductions(const Loop& loop) const {
+    static const std::vector<InductionVariable> EMPTY;
+
+    const auto found = _inductions.find(&loop);
+    return found == _inductions.end() ? EMPTY : found->second;
+}
+
+const CountedLoop* InductionAnalysis::counted(const Loop& loop) const {
+    const auto found = _counted.find(&loop);
+    return found == _counted.end() ? nullptr : &found->second;
+}
+
+std::optional<uint64_t> InductionAnalysis::_trip_count(const CountedLoop& counted) {
+    const auto initial = _constant(counted.induction.initial);
+    const auto bound = _constant(counted.bound);
+    if (!initial || !bound) return std::nullopt;
+
+    const auto type = counted.induction.variable.type().integral().value();
+    const auto bits = size_to_bytes(type.size()) * 8;
+
+    // Unsigned 64bit values above the signed maximum are rejected, which keeps the calculation within int64_t.
+    const auto max = type.sign() || bits == 64 ? std::numeric_limits<int64_t>::max() >> (64 - bits) : (int64_t{ 1 } << bits) - 1;
+    const auto min = type.sign() ? -max - 1 : 0;
+    if (*initial < min || *initial > max || *bound < min || *bound > max) return std::nullopt;
+
+    const auto start = *initial, step = counted.induction.step;
+    auto end = *bound;
+
+    switch (counted.comparison) {
+        case Binary::Operator::LessEqual: {
+            if (end == max) return std::nullopt;
+            end++;
+            [[fallthrough]];
+        }
+        case Binary::Operator::LessThan: {
+            if (step <= 0) return std::nullopt;
+            if (start >= end) return 0;
+
+            // The last value must not wrap around before reaching the bound.
+            if (end - 1 > max - step) return std::nullopt;
+
+            const auto distance = static_cast<uint64_t>(end) - static_cast<uint64_t>(start);
+            return (distance - 1) / static_cast<uint64_t>(step) + 1;
+        }
+        case Binary::Operator::GreaterEqual: {
+            if (end == min) return std::nullopt;
+            end--;
+            [[fallthrough]];
+        }
+        case Binary::Operator::GreaterThan: {
+            if (step >= 0 || step == std::numeric_limits<int64_t>::min()) return std::nullopt;
+            if (start <= end) return 0;
+            if (end + 1 < min - step) return std::nullopt;
+
+            const auto distance = static_cast<uint64_t>(start) - static_cast<uint64_t>(end);
+            return (distance - 1) / static_cast<uint64_t>(-step) + 1;
+        }
+        case Binary::Operator::NotEqual: {
+            if (start == end) return 0;
+            if ((step > 0) != (start < end) || step == std::numeric_limits<int64_t>::min()) return std::nullopt;
+
+            const auto distance = step > 0
+                                      ? static_cast<uint64_t>(end) - static_cast<uint64_t>(start)
+                                      : static_cast<uint64_t>(start) - static_cast<uint64_t>(end);
+            const auto magnitude = static_cast<uint64_t>(step > 0 ? step : -step);
+            if (distance % magnitude != 0) return std::nullopt;
+
+            return distance / magnitude;
+        }
+        default: return std::nullopt;
+    }
+}
+
+std::optional<int64_t> InductionAnalysis::_constant(const Operand& operand) {
+    const auto* immediate = std::get_if<Immediate>(&operand);
+    if (!immediate) return std::nullopt;
+
+    return std::visit(
+        []<typename Type>(const Type value) -> std::optional<int64_t> {
+            if constexpr (std::is_integral_v<Type> && !std::is_same_v<Type, bool>) {
+                return static_cast<int64_t>(value);
+            } else {
+                return std::nullopt;
+            }
+        },
+        *immediate
+    );
+}
+
+Binary::Operator InductionAnalysis::_swap(const Binary::Operator op) {
+    switch (op) {
+        case Binary::Operator::LessThan: return Binary::Operator::GreaterThan;
+        case Binary::Operator::GreaterThan: return Binary::Operator::LessThan;
+        case Binary::Operator::LessEqual: return Binary::Operator::GreaterEqual;
+        case Binary::Operator::GreaterEqual: return Binary::Operator::LessEqual;
+        default: return op;
+    }
+}
+
+Binary::Operator InductionAnalysis::_negate(const Binary::Operator op) {
+    switch (op) {
+        case Binary::Operator::LessThan: return Binary::Operator::GreaterEqual;
+        case Binary::Operator::GreaterThan: return Binary::Operator::LessEqual;
+        case Binary::Operator::LessEqual: return Binary::Operator::GreaterThan;
+        case Binary::Operator::GreaterEqual: return Binary::Operator::LessThan;
+        case Binary::Operator::Equal: return Binary::Operator::NotEqual;
+        case Binary::Operator::NotEqual: return Binary::Operator::Equal;
+        default: return op;
+    }
+}
+
+UseAnalysis::UseAnalysis(Function& function) {
+    for (auto& block : function) {
+        for (auto& instr : block) {
+            std::visit(
+                match{
+                    [&](Cast& instruction) {
+                        _used.insert(instruction.source());
+                    },
+                    [&](Return& instruction) {
+                        _used.insert(instruction.value());
+                    },
+                    [&](If& instruction) {
+                        _used.insert(instruction.condition());
+                    },
+                    [&](Store& instruction) {
+                        _used.insert(instruction.source());
+                    },
+                    [&](const Load& instruction) {
+                        _used.insert(instruction.source());
+                    },
+                    [&](Binary& instruction) {
+                        _used.insert(instruction.left());
+                        _used.insert(instruction.right());
+                    },
+                    [&](Argument& instruction) {
+                        _used.insert(instruction.source());
+                    },
+                    [&](Phi& instruction) {
+                        for (auto& operand : instruction.incoming() | std::views::values) {
+                            _used.insert(operand);
+                        }
+                    },
+                    [&](Assign& instruction) {
+                        _used.insert(instruction.value());
+                    },
+                    [&](Select& instruction) {
+                        _used.insert(instruction.condition());
+                        _used.insert(instruction.true_value());
+                        _used.insert(instruction.false_value());
+                    },
+                    [&](Call& instruction) {
+                        for (const auto& argument : instruction.arguments()) _used.insert(argument);
+                    },
+                    [&](Alloca&) { },
+                    [&](Goto&) { },
+                },
+                instr
+            );
+        }
+    }
+}
+
+DefUseChains::DefUseChains(Function& function) {
+    for (const auto& parameter : function.parameters()) {
+        _parameters.insert(parameter);
+    }
+
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            _blocks.emplace(&instruction, &block);
+
+            for (const auto& definition : instruction.defs()) {
+                const auto* variable = std::get_if<Variable>(&definition);
+                if (!variable) continue;
+
+                _definitions[*variable].push_back(&instruction);
+            }
+
+            for (const auto& use : instruction.uses()) {
+                const auto* variable = std::get_if<Variable>(&use);
+                if (!variable) continue;
+
+                auto& users = _uses[*variable];
+                if (!users.empty() && users.back() == &instruction) continue;
+                users.push_back(&instruction);
+            }
+        }
+    }
+}
+
+Instruction* DefUseChains::definition(const Variable& variable) const {
+    const auto found = _definitions.find(variable);
+    if (found == _definitions.end() || found->second.size() != 1) return nullptr;
+    return found->second.front();
+}
+
+const std::vector<Instruction*>& DefUseChains::uses(const Variable& variable) const {
+    static const std::vector<Instruction*> EMPTY{ };
+
+    const auto found = _uses.find(variable);
+    if (found == _uses.end()) return EMPTY;
+    return found->second;
+}
+
+bool DefUseChains::is_single_assignment(const Variable& variable) const {
+    const auto found = _definitions.find(variable);
+    if (_parameters.contains(variable)) return found == _definitions.end();
+    return found != _definitions.end() && found->second.size() == 1;
+}
+
+std::vector<Instruction*> DefUseChains::replace_all_uses(const Variable& from, const Operand& to) {
+    return replace_all_uses(from, to, [](const Instruction&) { return true; });
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
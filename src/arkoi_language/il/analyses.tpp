@@ -0,0 +1,70 @@
+#pragma once
+
+namespace arkoi::il {
+template <typename Func>
+void SparseLivenessAnalysis::for_each_live_out(BasicBlock& block, Func&& func) const {
+    State live = _blocks.out().at(&block);
+
+    for (auto& instruction : std::ranges::reverse_view(block.instructions())) {
+        func(instruction, static_cast<const State&>(live));
+        _step(instruction, live);
+    }
+}
+
+template <typename Filter>
+std::vector<Instruction*> DefUseChains::replace_all_uses(const Variable& from, const Operand& to, Filter&& filter) {
+    std::vector<Instruction*> replaced{ };
+
+    const auto found = _uses.find(from);
+    if (found == _uses.end()) return replaced;
+
+    std::erase_if(found->second, [&](Instruction* user) {
+        if (std::holds_alternative<Phi>(*user)) return false;
+        if (!filter(static_cast<const Instruction&>(*user))) return false;
+        if (!user->replace_uses(from, to)) return false;
+
+        replaced.push_back(user);
+        return true;
+    });
+
+    if (const auto* variable = std::get_if<Variable>(&to)) {
+        auto& users = _uses[*variable];
+        for (auto* user : replaced) {
+            if (std::ranges::find(users, user) == users.end()) users.push_back(user);
+        }
+    }
+
+    return replaced;
+}
+} // namespace arkoi::il
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,58 @@
+#pragma once
+
+template <Analysis Type>
+Type& AnalysisManager::get(Function& function) {
+    auto& entries = _entries[&function];
+
+    const auto found = entries.find(typeid(Type));
+    if (found != entries.end()) return *std::static_pointer_cast<Type>(found->second.analysis);
+
+    // The analyses this one builds on are cached as well, which may add entries while it is constructed.
+    std::shared_ptr<Type> analysis;
+    if constexpr (std::constructible_from<Type, Function&, AnalysisManager&>) {
+        analysis = std::make_shared<Type>(function, *this);
+    } else {
+        analysis = std::make_shared<Type>(function);
+    }
+
+    entries.emplace(typeid(Type), Entry{ analysis, Type::CONTROL_FLOW_ONLY });
+    return *analysis;
+}
+
+template <Analysis Type>
+bool AnalysisManager::cached(const Function& function) const {
+    const auto found = _entries.find(&function);
+    if (found == _entries.end()) return false;
+    return found->second.contains(typeid(Type));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,127 @@
+#include "arkoi_language/il/call_graph.hpp"
+
+#include <functional>
+
+using namespace arkoi::il;
+
+CallGraph::CallGraph(Module& module) {
+    for (auto& function : module) {
+        _functions.emplace(function.name(), &function);
+        _order.push_back(&function);
+
+        auto& callees = _callees[function.name()];
+        for (auto& block : function) {
+            for (const auto& instruction : block) {
+                const auto* call = std::get_if<Call>(&instruction);
+                if (!call) continue;
+
+                callees.push_back(call->name());
+                _sites[call->name()].push_back({ &function, &block });
+            }
+        }
+    }
+}
+
+Function* CallGraph::function(const std::string& name) const {
+    const auto found = _functions.find(name);
+    return found == _functions.end() ? nullptr : found->second;
+}
+
+const std::vector<std::string>& CallGraph::callees(const std::string& name) const {
+    static const std::vector<std::string> NONE;
+
+    const auto found = _callees.find(name);
+    return found == _callees.end() ? NONE : found->second;
+}
+
+const std::vector<CallGraph::Site>& CallGraph::sites(const std::string& name) const {
+    static const std::vector<Site> NONE;
+
+    const auto found = _sites.find(name);
+    return found == _sites.end() ? NONE : found->second;
+}
+
+std::unordered_set<std::string> CallGraph::reachable(const std::vector<std::string>& roots) const {
+    std::unordered_set<std::string> reachable;
+
+    auto worklist = roots;
+    while (!worklist.empty()) {
+        const auto name = worklist.back();
+        worklist.pop_back();
+
+        if (!reachable.insert(name).second) continue;
+
+        const auto& callees = this->callees(name);
+        worklist.insert(worklist.end(), callees.begin(), callees.end());
+    }
+
+    return reachable;
+}
+
+bool CallGraph::is_recursive(const std::string& name) const {
+    std::unordered_set<std::string> visited;
+
+    auto worklist = callees(name);
+    while (!worklist.empty()) {
+        const auto current = worklist.back();
+        worklist.pop_back();
+
+        if (current == name) return true;
+        if (!visited.insert(current).second) continue;
+
+        const auto& callees = this->callees(current);
+        worklist.insert(worklist.end(), callees.begin(), callees.end());
+    }
+
+    return false;
+}
+
+std::vector<Function*> CallGraph::bottom_up() const {
+    std::vector<Function*> order;
+    std::unordered_set<Function*> visited;
+
+    std::function<void(Function*)> visit = [&](Function* function) {
+        if (!visited.insert(function).second) return;
+
+        for (const auto& name : callees(function->name())) {
+            if (auto* callee = this->function(name)) visit(callee);
+        }
+
+        order.push_back(function);
+    };
+
+    for (auto* function : _order) visit(function);
+
+    return order;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,7 +1,10 @@
 #include "arkoi_language/il/cfg.hpp"
 
+#include <array>
 #include <cassert>
+#include <numeric>
 #include <ranges>
+#include <stdexcept>
 #include <utility>
 
 using namespace arkoi::il;
@@ -71,57 +74,206 @@ void BlockTraversal::_dfs(
     }
 }
 
-DominatorTree::Immediates DominatorTree::compute_immediates(const Function& function) {
-    Immediates immediates{ };
-    if (function.entry() == nullptr) return immediates;
+DominatorTree::DominatorTree(const Function& function, Algorithm algorithm) {
+    if (function.entry() == nullptr) return;
 
     auto [indices, blocks] = BlockTraversal::build(function.entry(), BlockTraversal::DFSOrder::ReversePostOrder);
+    _indices = std::move(indices);
+    _blocks = std::move(blocks);
+
+    // The predecessors are translated to their numbers once, thus the iterations don't hash any block.
+    _predecessors.resize(_blocks.size());
+    for (size_t index = 0; index < _blocks.size(); index++) {
+        for (auto* predecessor : _blocks[index]->predecessors()) {
+            const auto found = _indices.find(predecessor);
+            if (found != _indices.end()) _predecessors[index].push_back(found->second);
+        }
+    }
 
-    for (auto* block : blocks) {
-        immediates[block] = nullptr;
+    if (algorithm == Algorithm::Automatic) {
+        algorithm = _blocks.size() >= SEMI_NCA_THRESHOLD ? Algorithm::SemiNCA : Algorithm::Iterative;
     }
-    immediates[function.entry()] = function.entry();
+
+    if (algorithm == Algorithm::SemiNCA) {
+        _semi_nca();
+    } else {
+        _iterative();
+    }
+
+    _number();
+}
+
+void DominatorTree::_iterative() {
+    _immediates.assign(_blocks.size(), NONE);
+    _immediates[0] = 0;
 
     bool changed = true;
     while (changed) {
         changed = false;
 
-        for (size_t index = 1; index < blocks.size(); index++) {
-            auto* current = blocks[index];
+        for (size_t index = 1; index < _blocks.size(); index++) {
+            auto dominator = NONE;
+            for (const auto predecessor : _predecessors[index]) {
+                if (_immediates[predecessor] == NONE) continue;
 
-            BasicBlock* dominator = nullptr;
-            for (auto* predecessor : current->predecessors()) {
-                if (immediates.at(predecessor) != nullptr) {
-                    dominator = predecessor;
-                    break;
-                }
+                dominator = dominator == NONE ? predecessor : _intersect(predecessor, dominator);
             }
 
-            if (!dominator) continue;
+            if (dominator == NONE || _immediates[index] == dominator) continue;
 
-            for (auto* predecessor : current->predecessors()) {
-                if (immediates.at(predecessor) != nullptr) {
-                    dominator = _intersect(predecessor, dominator, immediates, indices);
-                }
-            }
+            _immediates[index] = dominator;
+            changed = true;
+        }
+    }
+}
 
-            if (immediates[current] != dominator) {
-                immediates[current] = dominator;
-                changed = true;
-            }
+void DominatorTree::_semi_nca() {
+    const auto size = _blocks.size();
+
+    // The preorder of a depth-first walk with the same successor order as `BlockTraversal`. It is walked with an
+    // explicit stack, as a recursion could overflow for the large CFGs this is meant for.
+    std::vector<size_t> order, preorder(size, NONE), parent(size, NONE);
+    std::vector<std::pair<size_t, size_t>> stack{ { 0, 0 } };
+    order.reserve(size);
+    preorder[0] = 0;
+    order.push_back(0);
+
+    while (!stack.empty()) {
+        auto& [current, successor] = stack.back();
+
+        auto* block = _blocks[current];
+        std::array successors{ block->next(), block->branch() };
+        if (successor == successors.size()) {
+            stack.pop_back();
+            continue;
         }
+
+        auto* target = successors[successor++];
+        if (!target) continue;
+
+        const auto index = _indices.at(target);
+        if (preorder[index] != NONE) continue;
+
+        preorder[index] = order.size();
+        parent[order.size()] = preorder[current];
+        order.push_back(index);
+        stack.emplace_back(index, 0);
     }
 
-    immediates[function.entry()] = nullptr;
+    // The semidominators are computed in reverse preorder over a forest with path compression, all numbers in
+    // here are preorder numbers.
+    std::vector<size_t> semi(size), label(size), ancestor(size, NONE), path;
+    std::iota(semi.begin(), semi.end(), 0);
+    std::iota(label.begin(), label.end(), 0);
+
+    const auto eval = [&](const size_t node) {
+        if (ancestor[node] == NONE) return node;
+
+        path.clear();
+        for (auto current = node; ancestor[ancestor[current]] != NONE; current = ancestor[current]) {
+            path.push_back(current);
+        }
+
+        for (const auto current : std::views::reverse(path)) {
+            const auto above = ancestor[current];
+            if (semi[label[above]] < semi[label[current]]) label[current] = label[above];
+            ancestor[current] = ancestor[above];
+        }
+
+        return label[node];
+    };
+
+    for (auto node = size - 1; node > 0; node--) {
+        for (const auto predecessor : _predecessors[order[node]]) {
+            const auto candidate = semi[eval(preorder[predecessor])];
+            if (candidate < semi[node]) semi[node] = candidate;
+        }
+
+        ancestor[node] = parent[node];
+    }
+
+    // The immediate dominator is the nearest common ancestor of the parent and the semidominator.
+    std::vector<size_t> immediates(size);
+    immediates[0] = 0;
+    for (size_t node = 1; node < size; node++) {
+        auto dominator = parent[node];
+        while (dominator > semi[node]) dominator = immediates[dominator];
+        immediates[node] = dominator;
+    }
+
+    _immediates.assign(size, NONE);
+    for (size_t node = 0; node < size; node++) _immediates[order[node]] = order[immediates[node]];
+}
+
+void DominatorTree::_number() {
+    const auto size = _blocks.size();
+    if (size == 0) return;
+
+    std::vector<std::vector<size_t>> children(size);
+    for (size_t index = 1; index < size; index++) children[_immediates[index]].push_back(index);
+
+    _enter.assign(size, 0);
+    _exit.assign(size, 0);
+
+    size_t counter = 0;
+    std::vector<std::pair<size_t, size_t>> stack{ { 0, 0 } };
+    _enter[0] = counter++;
+    while (!stack.empty()) {
+        auto& [current, child] = stack.back();
+        if (child == children[current].size()) {
+            _exit[current] = counter++;
+            stack.pop_back();
+            continue;
+        }
+
+        const auto next = children[current][child++];
+        _enter[next] = counter++;
+        stack.emplace_back(next, 0);
+    }
+}
+
+bool DominatorTree::dominates(const BasicBlock* dominator, const BasicBlock* block) const {
+    const auto outer = _index(dominator), inner = _index(block);
+    if (outer == NONE || inner == NONE) return false;
+
+    return _enter[outer] <= _enter[inner] && _exit[inner] <= _exit[outer];
+}
+
+BasicBlock* DominatorTree::immediate(const BasicBlock* block) const {
+    const auto index = _index(block);
+    if (index == NONE || index == 0) return nullptr;
+
+    return _blocks[_immediates[index]];
+}
+
+DominatorTree::Immediates DominatorTree::immediates() const {
+    Immediates immediates{ };
+    for (size_t index = 0; index < _blocks.size(); index++) {
+        immediates[_blocks[index]] = index == 0 ? nullptr : _blocks[_immediates[index]];
+    }
 
     return immediates;
 }
 
+size_t DominatorTree::_index(const BasicBlock* block) const {
+    const auto found = _indices.find(const_cast<BasicBlock*>(block));
+    if (found == _indices.end()) return NONE;
+
+    return found->second;
+}
+
+DominatorTree::Immediates DominatorTree::compute_immediates(const Function& function) {
+    return DominatorTree(function).immediates();
+}
+
 DominatorTree::Frontiers DominatorTree::compute_frontiers(const Function& function) {
+    return compute_frontiers(function, compute_immediates(function));
+}
+
+DominatorTree::Frontiers DominatorTree::compute_frontiers(const Function& function, const Immediates& immediates) {
     Frontiers frontiers{ };
     if (function.entry() == nullptr) return frontiers;
 
-    auto immediates = compute_immediates(function);
     for (auto* block : immediates | std::views::keys) {
         frontiers[block] = { };
     }
@@ -141,20 +293,10 @@ DominatorTree::Frontiers DominatorTree::compute_frontiers(const Function& functi
     return frontiers;
 }
 
-BasicBlock* DominatorTree::_intersect(
-    BasicBlock* u,
-    BasicBlock* v,
-    const Immediates& immediates,
-    const BlockTraversal::BlockOrder::Indices& rpo_indices
-) {
+size_t DominatorTree::_intersect(size_t u, size_t v) const {
     while (u != v) {
-        while (rpo_indices.at(u) > rpo_indices.at(v)) {
-            u = immediates.at(u);
-        }
-
-        while (rpo_indices.at(v) > rpo_indices.at(u)) {
-            v = immediates.at(v);
-        }
+        while (u > v) u = _immediates[u];
+        while (v > u) v = _immediates[v];
     }
 
     return u;
@@ -219,14 +361,20 @@ Function::Function(
     std::string name, std::vector<Variable> parameters, const sem::Type& type, std::string entry_label,
     std::string exit_label
 ) :
-    _parameters(std::move(parameters)), _name(std::move(name)), _type(type) {
-    _entry = emplace_back(std::move(entry_label));
-    _exit = emplace_back(std::move(exit_label));
+    _arena(std::make_shared<std::pmr::monotonic_buffer_resource>()), _parameters(std::move(parameters)),
+    _name(std::move(name)), _type(type) {
+    _entry = emplace_back(entry_label);
+    _exit = exit_label == entry_label ? _entry : emplace_back(std::move(exit_label));
 }
 
 BasicBlock* Function::emplace_back(const std::string& label) {
-    auto block = std::make_shared<BasicBlock>(label);
-    _block_pool.emplace(label, block);
+    // The block, its control block and its containers are all placed in the arena of the function.
+    const auto allocator = std::pmr::polymorphic_allocator<BasicBlock>(_arena.get());
+    auto block = std::allocate_shared<BasicBlock>(allocator, label, _arena.get());
+    if (!_block_pool.emplace(label, block).second) {
+        throw std::logic_error("The function " + _name + " already has a block labeled " + label);
+    }
+
     return block.get();
 }
 
@@ -249,6 +397,21 @@ bool Function::remove(BasicBlock* target) {
     return _block_pool.erase(target->label());
 }
 
+bool Module::remove(const std::string& name) {
+    // The remaining functions are moved into a new vector, as assigning to a function would release its
+    // arena before the blocks allocated in it.
+    Functions remaining;
+    remaining.reserve(_functions.size());
+
+    for (auto& function : _functions) {
+        if (function.name() != name) remaining.push_back(std::move(function));
+    }
+
+    const auto removed = remaining.size() != _functions.size();
+    _functions = std::move(remaining);
+    return removed;
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
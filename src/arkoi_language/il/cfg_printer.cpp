@@ -3,6 +3,16 @@
 using namespace arkoi::il;
 
 void CFGPrinter::visit(Module& module) {
+    begin();
+
+    for (auto& function : module) {
+        function.accept(*this);
+    }
+
+    end();
+}
+
+void CFGPrinter::begin() {
     _output << "digraph CFG {\n";
 
     _output << "\tgraph [fontname = \"Monospace\"];\n";
@@ -11,12 +21,11 @@ void CFGPrinter::visit(Module& module) {
 
     _output << "\tbgcolor = \"#f7f7f7\";\n";
     _output << "\tsplines = false;\n\n";
+}
 
-    for (auto& function : module) {
-        function.accept(*this);
-    }
-
+void CFGPrinter::end() {
     _output << "}\n";
+    _output.flush();
 }
 
 void CFGPrinter::visit(Function& function) {
@@ -0,0 +1,84 @@
+#include "arkoi_language/il/compact.hpp"
+
+using namespace arkoi::il;
+using namespace arkoi;
+
+template <Opcode Code, typename Type>
+constexpr bool IS_OPCODE_OF = std::is_same_v<std::variant_alternative_t<static_cast<size_t>(Code), Instruction::variant>, Type>;
+
+static_assert(IS_OPCODE_OF<Opcode::Goto, Goto> && IS_OPCODE_OF<Opcode::Binary, Binary>);
+static_assert(IS_OPCODE_OF<Opcode::Assign, Assign> && IS_OPCODE_OF<Opcode::Select, Select>);
+static_assert(std::variant_size_v<Instruction::variant> == static_cast<size_t>(Opcode::Select) + 1);
+
+CompactFunction::CompactFunction(Function& function) {
+    for (auto& block : function) {
+        auto& compact = _blocks.emplace_back();
+        compact.source = &block;
+
+        const auto size = block.instructions().size();
+        compact.opcodes.reserve(size);
+        compact.results.reserve(size);
+        compact.offsets.reserve(size + 1);
+        compact.offsets.push_back(0);
+
+        for (auto& instruction : block) {
+            compact.opcodes.push_back(static_cast<Opcode>(instruction.index()));
+
+            // Every instruction defines at most a single operand.
+            const auto defs = instruction.defs();
+            compact.results.push_back(defs.empty() ? NONE : _number(defs.front()));
+
+            for (const auto& use : instruction.uses()) compact.operands.push_back(_number(use));
+            compact.offsets.push_back(static_cast<uint32_t>(compact.operands.size()));
+        }
+
+        _instructions += size;
+    }
+}
+
+uint32_t CompactFunction::id(const Variable& variable) const {
+    const auto found = _ids.find(variable);
+    if (found == _ids.end()) return NONE;
+    return found->second;
+}
+
+uint32_t CompactFunction::_number(const Operand& operand) {
+    const auto* variable = std::get_if<Variable>(&operand);
+    if (!variable) return NONE;
+
+    const auto [entry, inserted] = _ids.try_emplace(*variable, static_cast<uint32_t>(_variables.size()));
+    if (inserted) _variables.push_back(*variable);
+
+    return entry->second;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
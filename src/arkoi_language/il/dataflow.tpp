@@ -2,12 +2,39 @@
 
 #include <cassert>
 
+namespace arkoi::il {
 template <DataflowPassConcept Pass>
 void DataflowAnalysis<Pass>::run(Function& function) {
     _out.clear();
     _in.clear();
 
-    std::stack<BasicBlock*> worklist;
+    _pass->prepare(function);
+    _iterations = 0;
+
+    // Blocks are processed in reverse post-order for forward analyses and in post-order for backward analyses,
+    // thus (apart from back edges) all inputs of a block are computed before the block itself.
+    constexpr auto order = Pass::Direction == DataflowDirection::Forward
+                               ? BlockTraversal::DFSOrder::ReversePostOrder
+                               : BlockTraversal::DFSOrder::PostOrder;
+    auto [indices, blocks] = BlockTraversal::build(function.entry(), order);
+
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<>> worklist;
+    std::vector<bool> queued(blocks.size(), false);
+
+    auto enqueue = [&](BasicBlock* block) {
+        auto [entry, inserted] = indices.try_emplace(block, blocks.size());
+        if (inserted) {
+            // Blocks not reachable from the entry (e.g. dead predecessors) are appended to the order.
+            blocks.push_back(block);
+            queued.push_back(false);
+        }
+
+        const auto index = entry->second;
+        if (queued[index]) return;
+
+        queued[index] = true;
+        worklist.push(index);
+    };
 
     for (auto& block : function) {
         if constexpr (Pass::Granularity == DataflowGranularity::Block) {
@@ -26,13 +53,16 @@ void DataflowAnalysis<Pass>::run(Function& function) {
             }
         }
 
-        worklist.push(&block);
+        enqueue(&block);
     }
 
     while (!worklist.empty()) {
-        auto* block = worklist.top();
+        auto* block = blocks[worklist.top()];
+        queued[worklist.top()] = false;
         worklist.pop();
 
+        _iterations++;
+
         // A requirement for every basic block.
         assert(!block->instructions().empty());
 
@@ -53,8 +83,8 @@ void DataflowAnalysis<Pass>::run(Function& function) {
                 if (new_out == old_out) continue;
                 old_out = std::move(new_out);
 
-                if (block->next()) worklist.push(block->next());
-                if (block->branch()) worklist.push(block->branch());
+                if (block->next()) enqueue(block->next());
+                if (block->branch()) enqueue(block->branch());
             } else {
                 std::vector<State> states;
                 if (block->next()) states.push_back(_in[block->next()]);
@@ -68,7 +98,7 @@ void DataflowAnalysis<Pass>::run(Function& function) {
                 old_in = std::move(new_in);
 
                 for (auto* predecessor : block->predecessors()) {
-                    worklist.push(predecessor);
+                    enqueue(predecessor);
                 }
             }
         } else {
@@ -107,7 +137,7 @@ void DataflowAnalysis<Pass>::run(Function& function) {
                 if (!changed) continue;
 
                 for (auto* predecessor : block->predecessors()) {
-                    worklist.push(predecessor);
+                    enqueue(predecessor);
                 }
             } else {
                 std::vector<State> states;
@@ -150,12 +180,13 @@ void DataflowAnalysis<Pass>::run(Function& function) {
                 if (!changed) continue;
 
                 for (auto* predecessor : block->predecessors()) {
-                    worklist.push(predecessor);
+                    enqueue(predecessor);
                 }
             }
         }
     }
 }
+} // namespace arkoi::il
 
 //==============================================================================
 // BSD 3-Clause License
@@ -0,0 +1,117 @@
+#include "arkoi_language/il/effect_analysis.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+using namespace arkoi::il;
+
+EffectAnalysis::EffectAnalysis(Module& module) {
+    const CallGraph graph(module);
+    for (auto& function : module) _effects.emplace(function.name(), _local(graph, function));
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (auto& function : module) {
+            auto& effects = _effects.at(function.name());
+            for (const auto& callee : graph.callees(function.name())) {
+                const auto lowered = std::min(effects, this->effects(callee));
+                if (lowered == effects) continue;
+
+                effects = lowered;
+                changed = true;
+            }
+        }
+    }
+}
+
+Call::Effects EffectAnalysis::effects(const std::string& name) const {
+    const auto found = _effects.find(name);
+    return found == _effects.end() ? Call::Effects::Unknown : found->second;
+}
+
+size_t EffectAnalysis::annotate(Module& module) const {
+    size_t changed = 0;
+    for (auto& function : module) {
+        for (auto& block : function) {
+            for (auto& instruction : block) {
+                auto* call = std::get_if<Call>(&instruction);
+                if (!call) continue;
+
+                const auto effects = this->effects(call->name());
+                if (call->effects() == effects) continue;
+
+                call->set_effects(effects);
+                changed++;
+            }
+        }
+    }
+
+    return changed;
+}
+
+Call::Effects EffectAnalysis::_local(const CallGraph& graph, Function& function) {
+    if (graph.is_recursive(function.name()) || _has_loop(function)) return Call::Effects::ReadNone;
+
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            const auto* binary = std::get_if<Binary>(&instruction);
+            if (binary && binary->may_trap()) return Call::Effects::ReadNone;
+        }
+    }
+
+    return Call::Effects::Speculatable;
+}
+
+bool EffectAnalysis::_has_loop(Function& function) {
+    // A block that is reached again while its successors are still being visited closes a cycle.
+    std::unordered_set<BasicBlock*> visited, active;
+
+    std::function<bool(BasicBlock*)> visit = [&](BasicBlock* block) {
+        if (active.contains(block)) return true;
+        if (!visited.insert(block).second) return false;
+
+        active.insert(block);
+        for (auto* successor : { block->next(), block->branch() }) {
+            if (successor && visit(successor)) return true;
+        }
+        active.erase(block);
+
+        return false;
+    };
+
+    return visit(function.entry());
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,5 +1,6 @@
 #include "arkoi_language/il/generator.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
 
@@ -11,6 +12,9 @@ using namespace arkoi;
 
 void Generator::visit(ast::Program& node) {
     for (const auto& item : node.statements()) {
+        auto* function = dynamic_cast<ast::Function*>(item.get());
+        if (function && _functions && !_functions->contains(function->name().value().span().substr())) continue;
+
         item->accept(*this);
     }
 }
@@ -18,13 +22,19 @@ void Generator::visit(ast::Program& node) {
 void Generator::visit(ast::Function& node) {
     // Resetting the variables for each function
     _temp_index = 0;
+    _label_index = 0;
     _allocas.clear();
+    _incomplete_phis.clear();
+    _definitions.clear();
+    _replaced_phis.clear();
+    _versions.clear();
+    _sealed.clear();
 
     auto& function_symbol = std::get<sem::Function>(*node.name().symbol());
 
     std::vector<Variable> parameters;
     for (auto& parameter : function_symbol.parameters()) {
-        parameters.emplace_back(parameter->name().span().substr(), parameter->type());
+        parameters.emplace_back(parameter->name().atom(), parameter->type());
     }
 
     auto entry_label = _make_label_symbol();
@@ -40,21 +50,22 @@ void Generator::visit(ast::Function& node) {
     _current_function = &function;
 
     _current_block = function.entry();
+    _seal(_current_block);
 
     auto return_temp = _make_memory(node.type());
-    _current_block->emplace_back<Alloca>(return_temp, std::nullopt);
+    _emit_alloca(return_temp, std::nullopt);
     _return_temp = return_temp;
 
     for (auto& parameter : node.parameters()) {
         auto alloca_temp = _make_memory(parameter.type());
         _allocas.emplace(parameter.name().symbol(), alloca_temp);
-        _current_block->emplace_back<Alloca>(alloca_temp, std::nullopt);
+        _emit_alloca(alloca_temp, std::nullopt);
     }
 
     for (auto& parameter : node.parameters()) {
         auto destination = _allocas.at(parameter.name().symbol());
-        auto source = Variable(parameter.name().value().span().substr(), parameter.type());
-        _current_block->emplace_back<Store>(destination, source, std::nullopt);
+        auto source = Variable(parameter.name().value().atom(), parameter.type());
+        _emit_store(destination, source, std::nullopt);
     }
 
     node.block()->accept(*this);
@@ -63,10 +74,12 @@ void Generator::visit(ast::Function& node) {
     _current_block->set_next(_current_function->exit());
 
     _current_block = _current_function->exit();
+    _seal(_current_block);
 
-    auto result_temp = _make_temporary(node.type());
-    _current_block->emplace_back<Load>(result_temp, return_temp, std::nullopt);
+    auto result_temp = _emit_load(return_temp, std::nullopt);
     _current_block->emplace_back<Return>(result_temp, std::nullopt);
+
+    if (_form == Form::SSA) _finish_ssa();
 }
 
 void Generator::visit(ast::Block& node) {
@@ -147,13 +160,13 @@ void Generator::visit_boolean(const ast::Immediate& node) {
 void Generator::visit(ast::Variable& node) {
     auto temp = _make_memory(node.type());
     _allocas.emplace(node.name().symbol(), temp);
-    _current_block->emplace_back<Alloca>(temp, node.span());
+    _emit_alloca(temp, node.span());
 
     // This will set _current_operand
     node.expression()->accept(*this);
     auto expression = _current_operand;
 
-    _current_block->emplace_back<Store>(temp, _current_operand, node.span());
+    _emit_store(temp, expression, node.span());
 
     _current_operand = temp;
 }
@@ -164,7 +177,7 @@ void Generator::visit(ast::Return& node) {
     auto expression = _current_operand;
 
     // Populate the current basic block with instructions
-    _current_block->emplace_back<Store>(*_return_temp, expression, node.span());
+    _emit_store(*_return_temp, expression, node.span());
     _current_block->emplace_back<Goto>(_current_function->exit()->label(), node.span());
 
     // Connect the current basic block with the function end basic block
@@ -179,12 +192,8 @@ void Generator::visit(ast::Identifier& node) {
     // TODO(timo): In the future there will be local/global and parameter variables,
     //             thus they need to be searched in such order: local, parameter, global.
     //             For now only parameter variables exist.
-    const auto& variable = std::get<sem::Variable>(*node.symbol());
-
     auto alloca_temp = _allocas.at(node.symbol());
-    auto temp = _make_temporary(variable.type());
-    _current_block->emplace_back<Load>(temp, alloca_temp, node.span());
-    _current_operand = temp;
+    _current_operand = _emit_load(alloca_temp, node.span());
 }
 
 void Generator::visit(ast::Binary& node) {
@@ -224,8 +233,8 @@ void Generator::visit_and(ast::Binary& node) {
     auto* merge_block = _current_function->emplace_back(merge_label);
 
     { // Current entry block
-        _current_block->emplace_back<Alloca>(result, node.span());
-        _current_block->emplace_back<Store>(result, false, node.span());
+        _emit_alloca(result, node.span());
+        _emit_store(result, false, node.span());
 
         // This will set _current_operand
         node.left()->accept(*this);
@@ -238,6 +247,7 @@ void Generator::visit_and(ast::Binary& node) {
 
     { // Right eval block if the condition is true.
         _current_block = right_block;
+        _seal(_current_block);
 
         // This will set _current_operand
         node.right()->accept(*this);
@@ -250,17 +260,18 @@ void Generator::visit_and(ast::Binary& node) {
 
     { // This block will set the result to true.
         _current_block = true_block;
-        _current_block->emplace_back<Store>(result, true, node.span());
+        _seal(_current_block);
+
+        _emit_store(result, true, node.span());
         _current_block->emplace_back<Goto>(merge_label, node.span());
         _current_block->set_next(merge_block);
     }
 
     { // Block where the control flow merges
         _current_block = merge_block;
+        _seal(_current_block);
 
-        auto temp = _make_temporary(result.type());
-        _current_block->emplace_back<Load>(temp, result, node.span());
-        _current_operand = temp;
+        _current_operand = _emit_load(result, node.span());
     }
 }
 
@@ -277,8 +288,8 @@ void Generator::visit_or(ast::Binary& node) {
     auto* merge_block = _current_function->emplace_back(merge_label);
 
     { // Current entry block
-        _current_block->emplace_back<Alloca>(result, node.span());
-        _current_block->emplace_back<Store>(result, false, node.span());
+        _emit_alloca(result, node.span());
+        _emit_store(result, false, node.span());
 
         // This will set _current_operand
         node.left()->accept(*this);
@@ -291,6 +302,7 @@ void Generator::visit_or(ast::Binary& node) {
 
     { // Right eval block if the condition is true.
         _current_block = right_block;
+        _seal(_current_block);
 
         // This will set _current_operand
         node.right()->accept(*this);
@@ -303,17 +315,18 @@ void Generator::visit_or(ast::Binary& node) {
 
     { // This block will set the result to true.
         _current_block = true_block;
-        _current_block->emplace_back<Store>(result, true, node.span());
+        _seal(_current_block);
+
+        _emit_store(result, true, node.span());
         _current_block->emplace_back<Goto>(merge_label, node.span());
         _current_block->set_next(merge_block);
     }
 
     { // Block where the control flow merges
         _current_block = merge_block;
+        _seal(_current_block);
 
-        auto temp = _make_temporary(result.type());
-        _current_block->emplace_back<Load>(temp, result, node.span());
-        _current_operand = temp;
+        _current_operand = _emit_load(result, node.span());
     }
 }
 
@@ -334,23 +347,27 @@ void Generator::visit(ast::Assign& node) {
     auto expression = _current_operand;
 
     auto alloca_temp = _allocas.at(node.name().symbol());
-    _current_block->emplace_back<Store>(alloca_temp, expression, node.span());
+    _emit_store(alloca_temp, expression, node.span());
 }
 
 void Generator::visit(ast::Call& node) {
     const auto& function = std::get<sem::Function>(*node.name().symbol());
 
-    std::vector<Operand> arguments;
-    for (size_t index = 0; index < node.arguments().size(); index++) {
-        const auto& parameter = function.parameters()[index];
-        const auto& argument = node.arguments()[index];
-
+    // The backend moves the arguments into place at the call itself. Thus, all arguments are evaluated before the
+    // first of them is passed, otherwise a nested call would be made in between and clobber the passed ones.
+    std::vector<Operand> expressions;
+    for (const auto& argument : node.arguments()) {
         // This will set _current_operand
         argument->accept(*this);
-        auto expression = _current_operand;
+        expressions.push_back(_current_operand);
+    }
+
+    std::vector<Operand> arguments;
+    for (size_t index = 0; index < expressions.size(); index++) {
+        const auto& parameter = function.parameters()[index];
 
         auto result = _make_temporary(parameter->type());
-        _current_block->emplace_back<Argument>(result, expression, node.span());
+        _current_block->emplace_back<Argument>(result, std::move(expressions[index]), node.span());
         arguments.emplace_back(result);
     }
 
@@ -389,6 +406,7 @@ void Generator::visit(ast::If& node) {
     bool branch_already_connected = false;
     { // Branch block
         _current_block = branch_block;
+        _seal(_current_block);
 
         node.branch()->accept(*this);
 
@@ -406,6 +424,7 @@ void Generator::visit(ast::If& node) {
     bool next_already_connected = false;
     { // Next block
         _current_block = next_block;
+        _seal(_current_block);
 
         if (node.next()) node.next()->accept(*this);
 
@@ -422,6 +441,7 @@ void Generator::visit(ast::If& node) {
 
     if (!next_already_connected || !branch_already_connected) { // After block
         _current_block = after_block;
+        _seal(_current_block);
     }
 }
 
@@ -437,6 +457,8 @@ void Generator::visit(ast::While& node) {
 
     { // Entrance block
         _current_block->set_next(condition_block);
+
+        // The back edge of the loop isn't known yet, thus the condition block is sealed after the body.
         _current_block = condition_block;
 
         // This will set _current_operand
@@ -451,14 +473,188 @@ void Generator::visit(ast::While& node) {
 
     { // Then block
         _current_block = loop_block;
+        _seal(_current_block);
 
         node.then()->accept(*this);
 
         _current_block->emplace_back<Goto>(condition_label, std::nullopt);
         _current_block->set_next(condition_block);
+        _seal(condition_block);
     }
 
     _current_block = after_block;
+    _seal(_current_block);
+}
+
+/**
+ * @brief Returns the phi defining @p result in @p block, or the end of its instructions.
+ */
+static auto find_phi(BasicBlock& block, const Variable& result) {
+    return std::ranges::find_if(block.instructions(), [&](Instruction& instruction) {
+        auto* phi = std::get_if<Phi>(&instruction);
+        return phi && phi->result() == result;
+    });
+}
+
+void Generator::_emit_alloca(const Memory& memory, const std::optional<pretty_diagnostics::Span>& span) {
+    if (_form == Form::Memory) _current_block->emplace_back<Alloca>(memory, span);
+}
+
+void Generator::_emit_store(
+    const Memory& memory,
+    const Operand& value,
+    const std::optional<pretty_diagnostics::Span>& span
+) {
+    if (_form == Form::Memory) {
+        _current_block->emplace_back<Store>(memory, value, span);
+        return;
+    }
+
+    // The version 0 is kept for reads that no definition reaches.
+    const Variable version(memory.symbol(), memory.type(), ++_versions[memory]);
+    _current_block->emplace_back<Assign>(version, value, span);
+    _definitions[_current_block].insert_or_assign(memory, version);
+}
+
+Variable Generator::_emit_load(const Memory& memory, const std::optional<pretty_diagnostics::Span>& span) {
+    auto temp = _make_temporary(memory.type());
+
+    if (_form == Form::Memory) {
+        _current_block->emplace_back<Load>(temp, memory, span);
+    } else {
+        _current_block->emplace_back<Assign>(temp, _read(memory, _current_block), span);
+    }
+
+    return temp;
+}
+
+void Generator::_seal(BasicBlock* block) {
+    if (_form == Form::Memory) return;
+    if (!_sealed.insert(block).second) return;
+
+    const auto incomplete = _incomplete_phis.find(block);
+    if (incomplete == _incomplete_phis.end()) return;
+
+    const auto phis = std::move(incomplete->second);
+    _incomplete_phis.erase(incomplete);
+
+    for (const auto& [memory, result] : phis) {
+        std::ignore = _add_phi_operands(memory, block, result);
+    }
+}
+
+Variable Generator::_read(const Memory& memory, BasicBlock* block) {
+    const auto definitions = _definitions.find(block);
+    if (definitions != _definitions.end()) {
+        const auto definition = definitions->second.find(memory);
+        if (definition != definitions->second.end()) return _resolve(definition->second);
+    }
+
+    return _read_predecessors(memory, block);
+}
+
+Variable Generator::_read_predecessors(const Memory& memory, BasicBlock* block) {
+    const auto& predecessors = block->predecessors();
+
+    Variable value(memory.symbol(), memory.type(), 0);
+    if (!_sealed.contains(block)) {
+        // Not all predecessors are known yet, thus the phi is completed once the block is sealed.
+        value.set_version(++_versions[memory]);
+        block->instructions().insert(block->instructions().begin(), Phi(value, { }, std::nullopt));
+        _incomplete_phis[block].emplace_back(memory, value);
+    } else if (predecessors.size() == 1) {
+        value = _read(memory, *predecessors.begin());
+    } else if (!predecessors.empty()) {
+        value.set_version(++_versions[memory]);
+        block->instructions().insert(block->instructions().begin(), Phi(value, { }, std::nullopt));
+
+        // The phi is defined before its operands are read, which breaks the recursion on loops.
+        _definitions[block].insert_or_assign(memory, value);
+        value = _add_phi_operands(memory, block, value);
+    }
+
+    _definitions[block].insert_or_assign(memory, value);
+    return value;
+}
+
+Variable Generator::_add_phi_operands(const Memory& memory, BasicBlock* block, const Variable& result) {
+    // The predecessors are a hashed set, thus they are sorted to keep the order of the incoming values stable.
+    std::vector<BasicBlock*> predecessors(block->predecessors().begin(), block->predecessors().end());
+    std::ranges::sort(predecessors, { }, &BasicBlock::label);
+
+    for (auto* predecessor : predecessors) {
+        auto value = _read(memory, predecessor);
+
+        // Reading the predecessors may place further phis in front of this one, thus it is looked up every time.
+        std::get<Phi>(*find_phi(*block, result)).set_incoming(predecessor, std::move(value));
+    }
+
+    return _remove_trivial_phi(block, result);
+}
+
+Variable Generator::_remove_trivial_phi(BasicBlock* block, const Variable& result) {
+    auto& instructions = block->instructions();
+    const auto found = find_phi(*block, result);
+    if (found == instructions.end()) return result;
+
+    std::optional<Variable> same;
+    for (const auto& [predecessor, incoming] : std::get<Phi>(*found).incoming()) {
+        const auto value = _resolve(incoming);
+        if (value == result || value == same) continue;
+
+        // The phi merges two different values, thus it stays.
+        if (same) return result;
+        same = value;
+    }
+
+    // A phi that only merges itself is only reached by undefined values.
+    const auto replacement = same.value_or(Variable(result.symbol(), result.type(), 0));
+    _replaced_phis.insert_or_assign(result, replacement);
+    instructions.erase(found);
+
+    return replacement;
+}
+
+Variable Generator::_resolve(Variable variable) const {
+    for (auto replaced = _replaced_phis.find(variable); replaced != _replaced_phis.end();) {
+        variable = replaced->second;
+        replaced = _replaced_phis.find(variable);
+    }
+
+    return variable;
+}
+
+void Generator::_finish_ssa() {
+    // A phi only becomes trivial once its operands are known, thus the phis that use a removed phi are
+    // checked again until nothing is removed anymore.
+    for (bool changed = true; changed;) {
+        changed = false;
+
+        for (auto& block : *_current_function) {
+            std::vector<Variable> results;
+            for (auto& instruction : block) {
+                auto* phi = std::get_if<Phi>(&instruction);
+                if (phi) results.push_back(phi->result());
+            }
+
+            for (const auto& result : results) {
+                changed |= _remove_trivial_phi(&block, result) != result;
+            }
+        }
+    }
+
+    if (_replaced_phis.empty()) return;
+
+    for (auto& block : *_current_function) {
+        for (auto& instruction : block) {
+            for (const auto& use : instruction.uses()) {
+                const auto* variable = std::get_if<Variable>(&use);
+                if (!variable || !_replaced_phis.contains(*variable)) continue;
+
+                instruction.replace_uses(*variable, _resolve(*variable));
+            }
+        }
+    }
 }
 
 std::string Generator::_make_label_symbol() {
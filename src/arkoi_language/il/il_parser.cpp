@@ -0,0 +1,579 @@
+#include "arkoi_language/il/il_parser.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+#include <unordered_map>
+
+#include "arkoi_language/opt/constant_folding.hpp"
+
+using namespace arkoi::il;
+using namespace arkoi;
+using namespace pretty_diagnostics;
+
+namespace {
+/**
+ * @brief A single line of the source and the index it starts at.
+ */
+struct Line {
+    std::string_view text;
+    size_t start;
+};
+
+/**
+ * @brief Reads the tokens of a single line, every error is reported with the span of the current token.
+ */
+class Cursor {
+public:
+    Cursor(const std::shared_ptr<Source>& source, const Line& line, const size_t position = 0) :
+        _source(source), _line(line), _position(position) { }
+
+    /**
+     * @brief Consumes @p expected if the line continues with it.
+     */
+    bool accept(const std::string_view expected) {
+        if (!_rest().starts_with(expected)) return false;
+
+        _position += expected.size();
+        return true;
+    }
+
+    void expect(const std::string_view expected) {
+        if (!accept(expected)) error("Expected \"" + std::string(expected) + "\"");
+    }
+
+    /**
+     * @brief Reads everything up to the next delimiter, i.e. a space, comma, colon or bracket.
+     */
+    std::string_view word() {
+        const auto rest = _rest();
+        const auto end = std::min(rest.find_first_of(" ,:()[]"), rest.size());
+        if (end == 0) error("Expected a name or number");
+
+        _position += end;
+        return rest.substr(0, end);
+    }
+
+    sem::Type type() {
+        expect("@");
+
+        const auto start = _position;
+        const auto name = word();
+        if (name == "bool") return sem::Boolean();
+        if (name == "f32") return sem::Floating(Size::DWORD);
+        if (name == "f64") return sem::Floating(Size::QWORD);
+
+        if (name.size() >= 2 && (name[0] == 'u' || name[0] == 's')) {
+            size_t bits = 0;
+            const auto [end, error] = std::from_chars(name.data() + 1, name.data() + name.size(), bits);
+            if (error == std::errc{ } && end == name.data() + name.size()) {
+                switch (bits) {
+                    case 8: return sem::Integral(Size::BYTE, name[0] == 's');
+                    case 16: return sem::Integral(Size::WORD, name[0] == 's');
+                    case 32: return sem::Integral(Size::DWORD, name[0] == 's');
+                    case 64: return sem::Integral(Size::QWORD, name[0] == 's');
+                    default: break;
+                }
+            }
+        }
+
+        _position = start;
+        error("Expected a type");
+    }
+
+    [[nodiscard]] bool at_end() const { return _rest().empty(); }
+
+    void expect_end() {
+        if (!at_end()) error("Expected the end of the line");
+    }
+
+    [[noreturn]] void error(const std::string& message) const {
+        const auto length = std::max<size_t>(1, std::min(_rest().find(' '), _rest().size()));
+        const auto start = _line.start + std::min(_position, _line.text.size());
+        throw MalformedIL(message, Span(_source, start, start + std::min(length, _rest().size())));
+    }
+
+private:
+    [[nodiscard]] std::string_view _rest() const {
+        return _line.text.substr(std::min(_position, _line.text.size()));
+    }
+
+private:
+    const std::shared_ptr<Source>& _source;
+    const Line& _line;
+    size_t _position;
+};
+
+/**
+ * @brief Splits a variable like "$x.inlined.2" into its name and its version after the last dot.
+ */
+std::pair<std::string_view, size_t> split_variable(Cursor& cursor, const std::string_view token) {
+    const auto dot = token.rfind('.');
+    if (!token.starts_with('$') || dot == std::string_view::npos || dot == 1) cursor.error("Expected a variable");
+
+    size_t version = 0;
+    const auto digits = token.substr(dot + 1);
+    const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), version);
+    if (error != std::errc{ } || end != digits.data() + digits.size()) cursor.error("Expected a variable version");
+
+    return { token.substr(1, dot - 1), version };
+}
+
+/**
+ * @brief Parses the lines of a single function, which are known to be well-formed once it's done.
+ */
+class FunctionParser {
+public:
+    FunctionParser(const std::shared_ptr<Source>& source, const std::vector<Line>& lines) :
+        _source(source), _lines(lines) { }
+
+    void parse(Module& module) {
+        const auto& header = _lines.front();
+        Cursor cursor(_source, header);
+        cursor.expect("fun ");
+
+        const auto name = std::string(cursor.word());
+        cursor.expect("(");
+
+        std::vector<Variable> parameters;
+        while (!cursor.accept(")")) {
+            if (!parameters.empty()) cursor.expect(", ");
+
+            const auto [parameter, version] = split_variable(cursor, cursor.word());
+            cursor.expect(" ");
+
+            parameters.emplace_back(parameter, cursor.type(), version);
+            _variables.emplace(parameters.back().name() + "." + std::to_string(version), parameters.back().type());
+        }
+
+        cursor.expect(" ");
+        const auto type = cursor.type();
+        cursor.expect(":");
+        cursor.expect_end();
+
+        _collect();
+
+        if (_labels.empty()) cursor.error("Expected at least one block");
+
+        // A function always consists of an entry and an exit, thus both of them have to be distinct at first.
+        auto unused = _labels.front();
+        while (std::ranges::find(_labels, unused) != _labels.end()) unused += "'";
+
+        // Without a return the exit is never reached, thus it stays an empty block.
+        const auto exit = _exit.value_or(unused);
+        const auto exit_label = exit == _labels.front() ? unused : exit;
+
+        auto& function = module.emplace_back(name, std::move(parameters), type, _labels.front(), exit_label);
+        _blocks.emplace(function.entry()->label(), function.entry());
+
+        if (exit_label != exit) {
+            std::ignore = function.remove(function.exit());
+            function.set_exit(function.entry());
+        } else {
+            _blocks.emplace(exit, function.exit());
+        }
+
+        for (const auto& label : _labels) {
+            if (!_blocks.contains(label)) _blocks.emplace(label, function.emplace_back(label));
+        }
+
+        // The labels were checked by `_collect` already, thus every header names a block.
+        const auto header_block = [&](const Line& line) {
+            return _blocks.at(std::string(line.text.substr(0, line.text.size() - 1)));
+        };
+
+        BasicBlock* current = nullptr;
+        for (size_t index = 1; index < _lines.size(); index++) {
+            const auto& line = _lines[index];
+            if (!line.text.starts_with(' ')) {
+                current = header_block(line);
+                _pending.clear();
+                continue;
+            }
+
+            _instruction(*current, line, type);
+        }
+
+        // The blocks are printed in the order they are laid out, thus a block without a terminator falls through.
+        const Line* previous = nullptr;
+        for (size_t index = 1; index < _lines.size(); index++) {
+            const auto& line = _lines[index];
+            if (line.text.starts_with(' ')) continue;
+
+            auto* block = header_block(line);
+            if (previous) _link(*header_block(*previous), *previous, block);
+            previous = &line;
+        }
+        _link(*header_block(*previous), *previous, nullptr);
+    }
+
+private:
+    /**
+     * @brief Collects the labels, the exit and the types of all results, which may be used before they're defined.
+     */
+    void _collect() {
+        for (size_t index = 1; index < _lines.size(); index++) {
+            const auto& line = _lines[index];
+            Cursor cursor(_source, line);
+
+            if (!line.text.starts_with(' ')) {
+                const auto label = std::string(cursor.word());
+                cursor.expect(":");
+                cursor.expect_end();
+
+                if (std::ranges::find(_labels, label) != _labels.end()) cursor.error("The block is defined twice");
+                _labels.push_back(label);
+                continue;
+            }
+
+            cursor.expect("  ");
+            if (_labels.empty()) cursor.error("Expected a block before the first instruction");
+
+            if (cursor.accept("ret ")) {
+                if (!_exit) _exit = _labels.back();
+                continue;
+            }
+
+            const auto is_variable = cursor.accept("$"), is_memory = !is_variable && cursor.accept("%");
+            if (!is_variable && !is_memory) continue;
+
+            const auto result = std::string(cursor.word());
+            cursor.expect(" ");
+            const auto type = cursor.type();
+
+            auto& definitions = is_variable ? _variables : _memories;
+            const auto [found, inserted] = definitions.emplace(result, type);
+            if (!inserted && found->second != type) cursor.error("The result is defined with another type before");
+        }
+    }
+
+    void _instruction(BasicBlock& block, const Line& line, const sem::Type& return_type) {
+        Cursor cursor(_source, line, 2);
+
+        if (cursor.accept("ret ")) {
+            block.emplace_back<Return>(_operand(cursor, return_type), std::nullopt);
+        } else if (cursor.accept("goto ")) {
+            block.emplace_back<Goto>(_label(cursor), std::nullopt);
+        } else if (cursor.accept("if ")) {
+            auto condition = _operand(cursor, sem::Boolean());
+            cursor.expect(" then ");
+            auto branch = _label(cursor);
+            cursor.expect(" else ");
+            auto next = _label(cursor);
+            block.emplace_back<If>(std::move(condition), std::move(next), std::move(branch), std::nullopt);
+        } else if (cursor.accept("arg ")) {
+            const auto type = cursor.type();
+            cursor.expect(" ");
+            auto source = _operand(cursor, type);
+
+            // The result of an argument isn't printed, thus it's named after the call once it's known.
+            _pending.push_back(block.instructions().size());
+            block.emplace_back<Argument>(Variable("arg", type), std::move(source), std::nullopt);
+        } else if (cursor.accept("%")) {
+            const auto name = cursor.word();
+            cursor.expect(" ");
+            const Memory result(name, cursor.type());
+            cursor.expect(" = ");
+
+            if (cursor.accept("alloca")) {
+                block.emplace_back<Alloca>(result, std::nullopt);
+            } else if (cursor.accept("store ")) {
+                block.emplace_back<Store>(result, _operand(cursor, result.type()), std::nullopt);
+            } else {
+                cursor.error("Expected alloca or store");
+            }
+        } else {
+            _definition(block, cursor);
+        }
+
+        cursor.expect_end();
+    }
+
+    void _definition(BasicBlock& block, Cursor& cursor) {
+        const auto token = cursor.word();
+        const auto [name, version] = split_variable(cursor, token);
+        cursor.expect(" ");
+        const Variable result(name, cursor.type(), version);
+        cursor.expect(" = ");
+
+        if (cursor.accept("call ")) {
+            auto effects = Call::Effects::Unknown;
+            if (cursor.accept("readnone ")) effects = Call::Effects::ReadNone;
+            else if (cursor.accept("speculatable ")) effects = Call::Effects::Speculatable;
+
+            const auto callee = std::string(cursor.word());
+            cursor.expect(", ");
+
+            const auto count = _number<size_t>(cursor);
+            if (count > _pending.size()) cursor.error("Expected as many arguments before the call");
+
+            std::vector<Operand> arguments;
+            for (auto index = _pending.size() - count; index < _pending.size(); index++) {
+                auto& argument = std::get<Argument>(block.instructions()[_pending[index]]);
+                argument = Argument(
+                    Variable(
+                        result.name() + ".arg" + std::to_string(arguments.size()), argument.result().type(),
+                        result.version()
+                    ),
+                    argument.source(), std::nullopt
+                );
+                arguments.emplace_back(argument.result());
+            }
+            _pending.resize(_pending.size() - count);
+
+            block.emplace_back<Call>(result, callee, std::move(arguments), std::nullopt, effects);
+        } else if (cursor.accept("cast ")) {
+            const auto from = cursor.type();
+            cursor.expect(" ");
+            block.emplace_back<Cast>(result, _operand(cursor, from), from, std::nullopt);
+        } else if (cursor.accept("load ")) {
+            cursor.expect("%");
+            const auto memory = std::string(cursor.word());
+
+            const auto found = _memories.find(memory);
+            if (found == _memories.end()) cursor.error("The stack slot is never allocated or stored");
+
+            block.emplace_back<Load>(result, Memory(memory, found->second), std::nullopt);
+        } else if (cursor.accept("phi [ ")) {
+            Phi::Incoming incoming;
+            while (!cursor.accept("]") && !cursor.accept(" ]")) {
+                if (!incoming.empty()) cursor.expect(", ");
+
+                auto* predecessor = _block(cursor, _label(cursor));
+                cursor.expect(": ");
+
+                auto value = _operand(cursor, result.type());
+                if (!std::holds_alternative<Variable>(value)) cursor.error("Expected a variable");
+                incoming.emplace_back(predecessor, std::get<Variable>(value));
+
+                cursor.accept(" ");
+            }
+
+            block.emplace_back<Phi>(result, std::move(incoming), std::nullopt);
+        } else if (cursor.accept("select ")) {
+            auto condition = _operand(cursor, sem::Boolean());
+            cursor.expect(", ");
+            auto true_value = _operand(cursor, result.type());
+            cursor.expect(", ");
+            auto false_value = _operand(cursor, result.type());
+            block.emplace_back<Select>(
+                result, std::move(condition), std::move(true_value), std::move(false_value), std::nullopt
+            );
+        } else if (const auto op = _operator(cursor)) {
+            const auto op_type = cursor.type();
+            cursor.expect(" ");
+            auto left = _operand(cursor, op_type);
+            cursor.expect(", ");
+            auto right = _operand(cursor, op_type);
+            block.emplace_back<Binary>(result, std::move(left), *op, std::move(right), op_type, std::nullopt);
+        } else {
+            block.emplace_back<Assign>(result, _operand(cursor, result.type()), std::nullopt);
+        }
+    }
+
+    /**
+     * @brief Restores the edges of the block from its terminator, or to the @p following block without one.
+     */
+    void _link(BasicBlock& block, const Line& line, BasicBlock* following) {
+        Cursor cursor(_source, line);
+
+        const auto& instructions = block.instructions();
+        const auto* last = instructions.empty() ? nullptr : &instructions.back();
+        if (const auto* _goto = last ? std::get_if<Goto>(last) : nullptr) {
+            block.set_next(_block(cursor, _goto->label()));
+        } else if (const auto* _if = last ? std::get_if<If>(last) : nullptr) {
+            block.set_next(_block(cursor, _if->next()));
+            block.set_branch(_block(cursor, _if->branch()));
+        } else if (!last || !std::holds_alternative<Return>(*last)) {
+            if (!following) cursor.error("Expected the last block to end with goto, if or ret");
+            block.set_next(following);
+        }
+    }
+
+    std::optional<Binary::Operator> _operator(Cursor& cursor) {
+        using Operator = Binary::Operator;
+
+        static constexpr std::pair<std::string_view, Operator> OPERATORS[]{
+            { "add ", Operator::Add }, { "sub ", Operator::Sub }, { "mul ", Operator::Mul },
+            { "div ", Operator::Div }, { "lth ", Operator::LessThan }, { "gth ", Operator::GreaterThan },
+            { "goe ", Operator::GreaterEqual }, { "loe ", Operator::LessEqual }, { "equ ", Operator::Equal },
+            { "neq ", Operator::NotEqual }, { "shl ", Operator::Shl }, { "shr ", Operator::Shr },
+        };
+
+        for (const auto& [name, op] : OPERATORS) {
+            if (cursor.accept(name)) return op;
+        }
+
+        return std::nullopt;
+    }
+
+    Operand _operand(Cursor& cursor, const sem::Type& type) {
+        if (cursor.accept("%")) {
+            const auto name = std::string(cursor.word());
+
+            const auto found = _memories.find(name);
+            if (found == _memories.end()) cursor.error("The stack slot is never allocated or stored");
+            return Memory(name, found->second);
+        }
+
+        const auto token = cursor.word();
+        if (token.starts_with('$')) {
+            const auto found = _variables.find(std::string(token.substr(1)));
+            if (found == _variables.end()) cursor.error("The variable is never defined");
+
+            const auto [name, version] = split_variable(cursor, token);
+            return Variable(name, found->second, version);
+        }
+
+        return _immediate(cursor, token, type);
+    }
+
+    /**
+     * @brief Parses the immediate @p token as the widest value of its kind, which is then converted to @p type.
+     */
+    Immediate _immediate(Cursor& cursor, const std::string_view token, const sem::Type& type) {
+        const auto* begin = token.data(), * end = token.data() + token.size();
+
+        const auto parsed = [&](const auto result) {
+            if (result.ec != std::errc{ } || result.ptr != end) cursor.error("Expected a " + _describe(type));
+        };
+
+        Immediate value = false;
+        if (type.is_floating()) {
+            double number = 0;
+            parsed(std::from_chars(begin, end, number));
+            value = number;
+        } else if (type.is_integral() && type.sign()) {
+            int64_t number = 0;
+            parsed(std::from_chars(begin, end, number));
+            value = number;
+        } else {
+            uint64_t number = 0;
+            parsed(std::from_chars(begin, end, number));
+            if (type.is_boolean() && number > 1) cursor.error("Expected a " + _describe(type));
+            value = number;
+        }
+
+        return opt::ConstantFolding::evaluate_cast(type, value);
+    }
+
+    template <typename Type>
+    Type _number(Cursor& cursor) {
+        const auto token = cursor.word();
+
+        Type value{ };
+        const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (error != std::errc{ } || end != token.data() + token.size()) cursor.error("Expected a number");
+        return value;
+    }
+
+    static std::string _label(Cursor& cursor) { return std::string(cursor.word()); }
+
+    BasicBlock* _block(const Cursor& cursor, const std::string& label) const {
+        const auto found = _blocks.find(label);
+        if (found == _blocks.end()) cursor.error("The block \"" + label + "\" is never defined");
+        return found->second;
+    }
+
+    static std::string _describe(const sem::Type& type) {
+        std::ostringstream output;
+        output << "number of type @" << type;
+        return output.str();
+    }
+
+private:
+    const std::shared_ptr<Source>& _source;
+    const std::vector<Line>& _lines;
+
+    std::unordered_map<std::string, sem::Type> _variables{ };
+    std::unordered_map<std::string, sem::Type> _memories{ };
+    std::unordered_map<std::string, BasicBlock*> _blocks{ };
+    std::vector<std::string> _labels{ };
+    std::optional<std::string> _exit{ };
+
+    /// The indices of the arguments in the current block that weren't passed to a call yet.
+    std::vector<size_t> _pending{ };
+};
+} // namespace
+
+Module ILParser::parse() {
+    const std::string_view contents = _source->contents();
+
+    // The lines are grouped by function, blank lines are only used to separate them.
+    std::vector<std::vector<Line>> functions;
+    for (size_t start = 0; start < contents.size();) {
+        const auto end = std::min(contents.find('\n', start), contents.size());
+        const auto text = contents.substr(start, end - start);
+
+        if (text.starts_with("fun ")) functions.emplace_back();
+
+        if (!text.empty()) {
+            if (functions.empty()) {
+                const Line line{ text, start };
+                try {
+                    Cursor(_source, line).error("Expected \"fun\"");
+                } catch (const MalformedIL& error) {
+                    _diagnostics.add(error.report());
+                    return { };
+                }
+            }
+
+            functions.back().push_back({ text, start });
+        }
+
+        start = end + 1;
+    }
+
+    Module module;
+    for (const auto& lines : functions) {
+        try {
+            FunctionParser(_source, lines).parse(module);
+        } catch (const MalformedIL& error) {
+            _diagnostics.add(error.report());
+            break;
+        }
+    }
+
+    return module;
+}
+
+MalformedIL::MalformedIL(const std::string& message, const Span& span) :
+    _report(
+        Report::Builder()
+       .severity(Severity::Error)
+       .message("Malformed IL")
+       .code("E4000")
+       .label(message, span)
+       .build()
+    ) { }
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
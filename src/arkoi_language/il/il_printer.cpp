@@ -1,10 +1,7 @@
 #include "arkoi_language/il/il_printer.hpp"
 
-#include <iostream>
-
 #include "arkoi_language/il/cfg.hpp"
 #include "arkoi_language/il/instruction.hpp"
-#include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi::il;
 
@@ -12,6 +9,8 @@ void ILPrinter::visit(Module& module) {
     for (auto& function : module) {
         function.accept(*this);
     }
+
+    _output.flush();
 }
 
 void ILPrinter::visit(Function& function) {
@@ -51,7 +50,7 @@ void ILPrinter::visit(Return& instruction) {
 
 void ILPrinter::visit(Binary& instruction) {
     _output << instruction.result() << " @" << instruction.result().type();
-    _output << " = " << to_string(instruction.op()) << " @" << instruction.op_type();
+    _output << " = " << instruction.op() << " @" << instruction.op_type();
     _output << " " << instruction.left() << ", " << instruction.right();
 }
 
@@ -66,7 +65,15 @@ void ILPrinter::visit(Argument& argument) {
 
 void ILPrinter::visit(Call& instruction) {
     _output << instruction.result() << " @" << instruction.result().type();
-    _output << " = call " << instruction.name() << ", " << instruction.arguments().size();
+    _output << " = call ";
+
+    switch (instruction.effects()) {
+        case Call::Effects::Unknown: break;
+        case Call::Effects::ReadNone: _output << "readnone "; break;
+        case Call::Effects::Speculatable: _output << "speculatable "; break;
+    }
+
+    _output << instruction.name() << ", " << instruction.arguments().size();
 }
 
 void ILPrinter::visit(Goto& instruction) {
@@ -100,7 +107,7 @@ void ILPrinter::visit(Phi& instruction) {
 
     for (auto it = instruction.incoming().begin(); it != instruction.incoming().end(); ++it) {
         const auto& [block, value] = *it;
-        _output << block << ": " << value;
+        _output << block->label() << ": " << value;
 
         if (std::next(it) != instruction.incoming().end()) {
             _output << ", ";
@@ -115,6 +122,12 @@ void ILPrinter::visit(Assign& instruction) {
     _output << " = " << instruction.value();
 }
 
+void ILPrinter::visit(Select& instruction) {
+    _output << instruction.result() << " @" << instruction.result().type();
+    _output << " = select " << instruction.condition() << ", " << instruction.true_value();
+    _output << ", " << instruction.false_value();
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
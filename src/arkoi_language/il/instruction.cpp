@@ -1,5 +1,7 @@
 #include "arkoi_language/il/instruction.hpp"
 
+#include "arkoi_language/utils/utils.hpp"
+
 using namespace arkoi::il;
 using namespace arkoi;
 
@@ -23,18 +25,124 @@ Binary::Operator Binary::node_to_instruction(const ast::Binary::Operator op) {
     std::unreachable();
 }
 
+bool Binary::may_trap() const {
+    if (_op != Operator::Div || _op_type.is_floating()) return false;
+
+    const auto* divisor = std::get_if<Immediate>(&_right);
+    if (!divisor) return true;
+
+    return std::visit([](const auto value) {
+        using Value = std::decay_t<decltype(value)>;
+        return value == Value(0) || value == static_cast<Value>(-1);
+    }, *divisor);
+}
+
+Variable* Phi::incoming_from(const BasicBlock* predecessor) {
+    for (auto& [block, value] : _incoming) {
+        if (block == predecessor) return &value;
+    }
+
+    return nullptr;
+}
+
+void Phi::set_incoming(BasicBlock* predecessor, Variable value) {
+    if (auto* existing = incoming_from(predecessor)) {
+        *existing = std::move(value);
+        return;
+    }
+
+    _incoming.emplace_back(predecessor, std::move(value));
+}
+
+bool Phi::replace_predecessor(const BasicBlock* from, BasicBlock* to) {
+    for (auto& [block, value] : _incoming) {
+        if (block != from) continue;
+
+        block = to;
+        return true;
+    }
+
+    return false;
+}
+
+std::optional<Variable> Phi::remove_incoming(const BasicBlock* predecessor) {
+    for (auto it = _incoming.begin(); it != _incoming.end(); ++it) {
+        if (it->first != predecessor) continue;
+
+        auto value = std::move(it->second);
+        _incoming.erase(it);
+        return value;
+    }
+
+    return std::nullopt;
+}
+
 void Instruction::accept(Visitor& visitor) {
     std::visit([&](auto& item) { item.accept(visitor); }, *this);
 }
 
-std::vector<Operand> Instruction::defs() const {
+OperandList Instruction::defs() const {
     return std::visit([&](auto& item) { return item.defs(); }, *this);
 }
 
-std::vector<Operand> Instruction::uses() const {
+OperandList Instruction::uses() const {
     return std::visit([&](auto& item) { return item.uses(); }, *this);
 }
 
+bool Instruction::replace_uses(const Variable& from, const Operand& to) {
+    bool replaced = false;
+
+    const auto replace = [&](Operand& operand) {
+        const auto* variable = std::get_if<Variable>(&operand);
+        if (!variable || *variable != from) return;
+
+        operand = to;
+        replaced = true;
+    };
+
+    std::visit(
+        match{
+            [&](Binary& instruction) {
+                replace(instruction.left());
+                replace(instruction.right());
+            },
+            [&](Return& instruction) { replace(instruction.value()); },
+            [&](Cast& instruction) { replace(instruction.source()); },
+            [&](If& instruction) { replace(instruction.condition()); },
+            [&](Store& instruction) { replace(instruction.source()); },
+            [&](Argument& instruction) { replace(instruction.source()); },
+            [&](Assign& instruction) { replace(instruction.value()); },
+            [&](Select& instruction) {
+                replace(instruction.condition());
+                replace(instruction.true_value());
+                replace(instruction.false_value());
+            },
+            [&](Call& instruction) {
+                for (auto& argument : instruction.arguments()) {
+                    replace(argument);
+                }
+            },
+            [&](Phi& instruction) {
+                const auto* variable = std::get_if<Variable>(&to);
+                if (!variable) return;
+
+                for (auto& incoming : instruction.incoming() | std::views::values) {
+                    if (incoming != from) continue;
+
+                    incoming = *variable;
+                    replaced = true;
+                }
+            },
+            [&](Alloca&) { },
+            [&](Load&) { },
+            [&](Goto&) { },
+        },
+        *this
+    );
+
+    return replaced;
+}
+
 bool Instruction::is_constant() const {
     return std::visit([&](auto& item) { return item.is_constant(); }, *this);
 }
@@ -43,7 +151,7 @@ std::optional<pretty_diagnostics::Span> Instruction::span() const {
     return std::visit([&](auto& item) { return item.span(); }, *this);
 }
 
-std::ostream& il::operator<<(std::ostream& os, const Binary::Operator& op) {
+utils::OutputBuffer& il::operator<<(utils::OutputBuffer& os, const Binary::Operator& op) {
     switch (op) {
         case Binary::Operator::Add: return os << "add";
         case Binary::Operator::Sub: return os << "sub";
@@ -55,12 +163,18 @@ std::ostream& il::operator<<(std::ostream& os, const Binary::Operator& op) {
         case Binary::Operator::LessEqual: return os << "loe";
         case Binary::Operator::Equal: return os << "equ";
         case Binary::Operator::NotEqual: return os << "neq";
+        case Binary::Operator::Shl: return os << "shl";
+        case Binary::Operator::Shr: return os << "shr";
     }
 
     // As the -Wswitch flag is set, this will never be reached.
     std::unreachable();
 }
 
+std::ostream& il::operator<<(std::ostream& os, const Binary::Operator& op) {
+    return utils::OutputBuffer::format(os, op);
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
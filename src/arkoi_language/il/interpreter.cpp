@@ -0,0 +1,217 @@
+#include "arkoi_language/il/interpreter.hpp"
+
+#include "arkoi_language/opt/constant_folding.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::il;
+using namespace arkoi;
+
+Interpreter::Interpreter(Module& module, const size_t fuel) :
+    _fuel(fuel) {
+    for (auto& function : module) _functions.emplace(function.name(), &function);
+}
+
+std::optional<Immediate> Interpreter::call(const std::string& name, const std::vector<Immediate>& arguments) {
+    _steps = 0;
+
+    const auto found = _functions.find(name);
+    if (found == _functions.end()) return std::nullopt;
+
+    return _run(*found->second, arguments, 0);
+}
+
+std::optional<Immediate> Interpreter::_run(
+    Function& function, const std::vector<Immediate>& arguments, const size_t depth
+) {
+    if (depth > MAX_DEPTH) return std::nullopt;
+
+    auto& parameters = function.parameters();
+    if (parameters.size() != arguments.size()) return std::nullopt;
+
+    Frame frame;
+    for (size_t index = 0; index < parameters.size(); index++) {
+        const auto value = opt::ConstantFolding::evaluate_cast(parameters[index].type(), arguments[index]);
+        frame.variables.insert_or_assign(parameters[index], value);
+    }
+
+    BasicBlock* previous = nullptr;
+    auto* block = function.entry();
+    while (block) {
+        auto& instructions = block->instructions();
+
+        // The phis at the start of the block are all evaluated with the values of the edge taken to it.
+        size_t index = 0;
+        std::vector<std::pair<Variable, Immediate>> incoming;
+        for (; index < instructions.size() && std::holds_alternative<Phi>(instructions[index]); index++) {
+            if (++_steps > _fuel) return std::nullopt;
+
+            auto& phi = std::get<Phi>(instructions[index]);
+            const auto* source = previous ? phi.incoming_from(previous) : nullptr;
+            const auto value = source ? _value(frame, *source) : std::nullopt;
+            if (!value) return std::nullopt;
+
+            incoming.emplace_back(phi.result(), *value);
+        }
+
+        for (const auto& [variable, value] : incoming) frame.variables.insert_or_assign(variable, value);
+
+        auto* next = block->next();
+        for (; index < instructions.size(); index++) {
+            if (++_steps > _fuel) return std::nullopt;
+
+            auto& instruction = instructions[index];
+            if (auto* _return = std::get_if<Return>(&instruction)) {
+                const auto value = _value(frame, _return->value());
+                if (!value) return std::nullopt;
+
+                return opt::ConstantFolding::evaluate_cast(function.type(), *value);
+            }
+
+            if (auto* _if = std::get_if<If>(&instruction)) {
+                const auto condition = _value(frame, _if->condition());
+                if (!condition) return std::nullopt;
+
+                const auto taken = std::get<bool>(opt::ConstantFolding::evaluate_cast(sem::Boolean(), *condition));
+                next = taken ? block->branch() : block->next();
+                break;
+            }
+
+            if (std::holds_alternative<Goto>(instruction)) break;
+
+            if (!_execute(frame, instruction, depth)) return std::nullopt;
+        }
+
+        previous = block;
+        block = next;
+    }
+
+    // The exit block was left without returning a value.
+    return std::nullopt;
+}
+
+bool Interpreter::_execute(Frame& frame, Instruction& instruction, const size_t depth) {
+    const auto assign = [&](const Variable& result, const std::optional<Immediate>& value) {
+        if (!value) return false;
+
+        frame.variables.insert_or_assign(result, *value);
+        return true;
+    };
+
+    return std::visit(
+        match{
+            [&](Binary& binary) {
+                const auto left = _value(frame, binary.left()), right = _value(frame, binary.right());
+                if (!left || !right) return false;
+
+                const auto value = opt::ConstantFolding::evaluate_binary(binary.op(), binary.op_type(), *left, *right);
+                return assign(binary.result(), value);
+            },
+            [&](Cast& cast) {
+                const auto source = _value(frame, cast.source());
+                if (!source) return false;
+
+                return assign(cast.result(), opt::ConstantFolding::evaluate_cast(cast.result().type(), *source));
+            },
+            [&](Assign& instruction) {
+                const auto value = _value(frame, instruction.value());
+                if (!value) return false;
+
+                const auto& result = instruction.result();
+                return assign(result, opt::ConstantFolding::evaluate_cast(result.type(), *value));
+            },
+            [&](Select& select) {
+                const auto condition = _value(frame, select.condition());
+                if (!condition) return false;
+
+                const auto taken = std::get<bool>(opt::ConstantFolding::evaluate_cast(sem::Boolean(), *condition));
+                return assign(select.result(), _value(frame, taken ? select.true_value() : select.false_value()));
+            },
+            [&](Argument& argument) {
+                return assign(argument.result(), _value(frame, argument.source()));
+            },
+            [&](Call& call) {
+                const auto found = _functions.find(call.name());
+                if (found == _functions.end()) return false;
+
+                std::vector<Immediate> arguments;
+                for (const auto& operand : call.arguments()) {
+                    const auto value = _value(frame, operand);
+                    if (!value) return false;
+
+                    arguments.push_back(*value);
+                }
+
+                return assign(call.result(), _run(*found->second, arguments, depth + 1));
+            },
+            [&](Alloca&) {
+                return true;
+            },
+            [&](Load& load) {
+                const auto found = frame.memory.find(load.source());
+                if (found == frame.memory.end()) return false;
+
+                return assign(load.result(), found->second);
+            },
+            [&](Store& store) {
+                const auto value = _value(frame, store.source());
+                if (!value) return false;
+
+                const auto& result = store.result();
+                frame.memory.insert_or_assign(result, opt::ConstantFolding::evaluate_cast(result.type(), *value));
+                return true;
+            },
+            // The instructions changing the control flow are handled by `_run`.
+            [&](auto&) {
+                return false;
+            },
+        },
+        instruction
+    );
+}
+
+std::optional<Immediate> Interpreter::_value(const Frame& frame, const Operand& operand) {
+    if (const auto* immediate = std::get_if<Immediate>(&operand)) return *immediate;
+
+    if (const auto* variable = std::get_if<Variable>(&operand)) {
+        const auto found = frame.variables.find(*variable);
+        if (found == frame.variables.end()) return std::nullopt;
+
+        return found->second;
+    }
+
+    const auto found = frame.memory.find(std::get<Memory>(operand));
+    if (found == frame.memory.end()) return std::nullopt;
+
+    return found->second;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
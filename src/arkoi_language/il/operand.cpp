@@ -1,5 +1,8 @@
 #include "arkoi_language/il/operand.hpp"
 
+#include <array>
+#include <charconv>
+#include <concepts>
 #include <iomanip>
 
 #include "arkoi_language/utils/utils.hpp"
@@ -51,10 +54,16 @@ sem::Type Operand::type() const {
     return std::visit([](const auto& value) { return value.type(); }, *this);
 }
 
-std::ostream& il::operator<<(std::ostream& os, const Immediate& operand) {
+utils::OutputBuffer& il::operator<<(utils::OutputBuffer& os, const Immediate& operand) {
     std::visit(
         match{
             [&os](const bool& value) { os << (value ? "1" : "0"); },
+            [&os]<std::floating_point Type>(const Type& value) {
+                // The shortest representation that reads back as the same value, thus the printed IL is lossless.
+                std::array<char, 32> buffer{ };
+                const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+                os << std::string_view(buffer.data(), result.ptr);
+            },
             [&os](const auto& value) { os << value; },
         },
         operand
@@ -62,30 +71,30 @@ std::ostream& il::operator<<(std::ostream& os, const Immediate& operand) {
     return os;
 }
 
-std::ostream& il::operator<<(std::ostream& os, const Variable& operand) {
+utils::OutputBuffer& il::operator<<(utils::OutputBuffer& os, const Variable& operand) {
     os << "$" << operand.name();
     os << "." << operand.version();
     return os;
 }
 
-std::ostream& il::operator<<(std::ostream& os, const Memory& operand) {
+utils::OutputBuffer& il::operator<<(utils::OutputBuffer& os, const Memory& operand) {
     os << "%" << operand.name();
     return os;
 }
 
-std::ostream& il::operator<<(std::ostream& os, const Operand& operand) {
+utils::OutputBuffer& il::operator<<(utils::OutputBuffer& os, const Operand& operand) {
     std::visit([&os](const auto& other) { os << other; }, operand);
     return os;
 }
 
 size_t std::hash<Variable>::operator()(const Variable& variable) const noexcept {
-    const size_t name_hash = std::hash<std::string>{ }(variable.name());
+    const size_t name_hash = variable.symbol().hash();
     const size_t generation_hash = std::hash<size_t>{ }(variable.version());
     return name_hash ^ (generation_hash << 1);
 }
 
 size_t std::hash<Memory>::operator()(const Memory& memory) const noexcept {
-    return std::hash<std::string>{ }(memory.name());
+    return memory.symbol().hash();
 }
 
 size_t std::hash<Immediate>::operator()(const Immediate& immediate) const noexcept {
@@ -106,6 +115,22 @@ size_t std::hash<Operand>::operator()(const Operand& operand) const noexcept {
     );
 }
 
+std::ostream& il::operator<<(std::ostream& os, const Immediate& operand) {
+    return utils::OutputBuffer::format(os, operand);
+}
+
+std::ostream& il::operator<<(std::ostream& os, const Variable& operand) {
+    return utils::OutputBuffer::format(os, operand);
+}
+
+std::ostream& il::operator<<(std::ostream& os, const Memory& operand) {
+    return utils::OutputBuffer::format(os, operand);
+}
+
+std::ostream& il::operator<<(std::ostream& os, const Operand& operand) {
+    return utils::OutputBuffer::format(os, operand);
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
@@ -0,0 +1,114 @@
+#include "arkoi_language/il/operand_set.hpp"
+
+#include <cassert>
+
+using namespace arkoi::il;
+using namespace arkoi;
+
+OperandIndex::OperandIndex(Function& function) {
+    for (const auto& parameter : function.parameters()) {
+        insert(parameter);
+    }
+
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            for (const auto& definition : instruction.defs()) {
+                if (std::holds_alternative<Immediate>(definition)) continue;
+                insert(definition);
+            }
+
+            for (const auto& use : instruction.uses()) {
+                if (std::holds_alternative<Immediate>(use)) continue;
+                insert(use);
+            }
+        }
+    }
+}
+
+size_t OperandIndex::insert(const Operand& operand) {
+    if (std::holds_alternative<Immediate>(operand)) {
+        throw std::invalid_argument("Immediates cannot be part of an operand index.");
+    }
+
+    const auto [entry, inserted] = _indices.try_emplace(operand, _operands.size());
+    if (inserted) _operands.push_back(operand);
+
+    return entry->second;
+}
+
+std::optional<size_t> OperandIndex::find(const Operand& operand) const {
+    const auto found = _indices.find(operand);
+    if (found == _indices.end()) return std::nullopt;
+    return found->second;
+}
+
+bool OperandSet::insert(const Operand& operand) {
+    assert(_index && "An operand set without an index cannot hold operands.");
+
+    const auto index = _index->find(operand);
+    assert(index && "The operand is not part of the operand index.");
+
+    return _bits.set(*index);
+}
+
+bool OperandSet::erase(const Operand& operand) {
+    if (!_index) return false;
+
+    const auto index = _index->find(operand);
+    if (!index) return false;
+
+    return _bits.reset(*index);
+}
+
+bool OperandSet::contains(const Operand& operand) const {
+    if (!_index) return false;
+
+    const auto index = _index->find(operand);
+    if (!index) return false;
+
+    return _bits.test(*index);
+}
+
+OperandSet& OperandSet::operator|=(const OperandSet& other) {
+    if (!_index) _index = other._index;
+    assert(!other._index || _index == other._index);
+
+    _bits |= other._bits;
+    return *this;
+}
+
+OperandSet& OperandSet::operator-=(const OperandSet& other) {
+    _bits -= other._bits;
+    return *this;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
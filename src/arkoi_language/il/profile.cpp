@@ -0,0 +1,99 @@
+#include "arkoi_language/il/profile.hpp"
+
+#include <array>
+#include <fstream>
+
+using namespace arkoi::il;
+
+std::optional<Profile> Profile::load(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return std::nullopt;
+
+    Profile profile;
+
+    std::array<uint64_t, 2> counter{ };
+    while (input.read(reinterpret_cast<char*>(counter.data()), sizeof(counter))) {
+        profile.add(counter[0], counter[1]);
+    }
+
+    // A program killed while writing its counters leaves a truncated profile behind.
+    if (input.gcount() != 0) return std::nullopt;
+
+    return profile;
+}
+
+uint64_t Profile::key(const std::string_view function, const std::string_view label) {
+    uint64_t hash = 0xCBF29CE484222325;
+
+    const auto mix = [&](const std::string_view text) {
+        for (const auto character : text) {
+            hash ^= static_cast<uint8_t>(character);
+            hash *= 0x100000001B3;
+        }
+    };
+
+    // The separator can't be part of a function name, thus no two blocks share the same input.
+    mix(function);
+    mix(".");
+    mix(label);
+
+    return hash;
+}
+
+void Profile::add(const uint64_t key, const uint64_t count) {
+    _counts[key] += count;
+}
+
+std::optional<uint64_t> Profile::count(const std::string_view function, const std::string_view label) const {
+    const auto found = _counts.find(key(function, label));
+    if (found == _counts.end()) return std::nullopt;
+
+    return found->second;
+}
+
+void Profile::annotate(Function& function) const {
+    for (auto& block : function) {
+        if (const auto count = this->count(function.name(), block.label())) block.set_count(*count);
+    }
+}
+
+uint64_t Profile::checksum() const {
+    // Every pair is hashed on its own and combined commutatively, as the map has no stable order.
+    uint64_t checksum = 0;
+    for (const auto& [key, count] : _counts) {
+        checksum += (key ^ (count * 0x9E3779B97F4A7C15)) * 0x100000001B3;
+    }
+
+    return checksum;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
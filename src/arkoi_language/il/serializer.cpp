@@ -0,0 +1,728 @@
+#include "arkoi_language/il/serializer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::il;
+using namespace arkoi;
+
+namespace {
+constexpr std::string_view MAGIC = "ARKIL";
+
+/**
+ * @brief The alternatives of the serialized instructions, stored in front of their fields.
+ */
+enum Tag : uint8_t { GOTO, IF, CAST, CALL, RETURN, BINARY, ALLOCA, STORE, LOAD, ARGUMENT, PHI, ASSIGN, SELECT };
+
+/// The tag of an instruction with a span has this bit set, which is followed by its locations.
+constexpr uint8_t HAS_SPAN = 0x80;
+
+/**
+ * @brief The alternatives of the serialized operands.
+ */
+enum OperandTag : uint8_t { IMMEDIATE, VARIABLE, MEMORY };
+
+/// The flags of a function.
+constexpr uint8_t MEMOIZED = 0x01;
+
+/// The flags of a block.
+constexpr uint8_t HAS_COUNT = 0x01, HAS_NEXT = 0x02, HAS_BRANCH = 0x04;
+
+/**
+ * @brief Collects the names and the stream of a module, which are written together by `finish`.
+ */
+class Writer {
+public:
+    void function(Function& function) {
+        string(function.name());
+        type(function.type());
+        byte(function.is_memoized() ? MEMOIZED : 0);
+
+        varint(function.parameters().size());
+        for (const auto& parameter : function.parameters()) variable(parameter);
+
+        std::vector<BasicBlock*> blocks;
+        for (auto& block : function) blocks.push_back(&block);
+
+        // The exit isn't reachable from the entry if the function never returns.
+        if (std::ranges::find(blocks, function.exit()) == blocks.end()) blocks.push_back(function.exit());
+
+        varint(blocks.size());
+        for (const auto* block : blocks) string(block->label());
+        string(function.exit()->label());
+
+        for (auto* block : blocks) {
+            uint8_t flags = 0;
+            if (block->count()) flags |= HAS_COUNT;
+            if (block->next()) flags |= HAS_NEXT;
+            if (block->branch()) flags |= HAS_BRANCH;
+            byte(flags);
+
+            if (block->count()) varint(*block->count());
+            if (block->next()) string(block->next()->label());
+            if (block->branch()) string(block->branch()->label());
+
+            varint(block->instructions().size());
+            for (auto& instruction : block->instructions()) this->instruction(instruction);
+        }
+    }
+
+    void finish(std::ostream& output) const {
+        std::string header(MAGIC);
+        header.push_back(static_cast<char>(Serializer::VERSION));
+
+        Writer table;
+        table.varint(_strings.size());
+        for (const auto& value : _strings) {
+            table.varint(value.size());
+            table._stream.append(value);
+        }
+
+        output.write(header.data(), static_cast<std::streamsize>(header.size()));
+        output.write(table._stream.data(), static_cast<std::streamsize>(table._stream.size()));
+        output.write(_stream.data(), static_cast<std::streamsize>(_stream.size()));
+    }
+
+private:
+    void instruction(Instruction& instruction) {
+        const auto span = instruction.span();
+
+        const auto tag = [&](const Tag value) {
+            byte(span ? value | HAS_SPAN : value);
+            if (!span) return;
+
+            location(span->start());
+            location(span->end());
+        };
+
+        std::visit(
+            match{
+                [&](Goto& instruction) {
+                    tag(GOTO);
+                    string(instruction.label());
+                },
+                [&](If& instruction) {
+                    tag(IF);
+                    operand(instruction.condition());
+                    string(instruction.next());
+                    string(instruction.branch());
+                },
+                [&](Cast& instruction) {
+                    tag(CAST);
+                    variable(instruction.result());
+                    operand(instruction.source());
+                    type(instruction.from());
+                },
+                [&](Call& instruction) {
+                    tag(CALL);
+                    variable(instruction.result());
+                    string(instruction.name());
+                    byte(static_cast<uint8_t>(instruction.effects()));
+
+                    varint(instruction.arguments().size());
+                    for (const auto& argument : instruction.arguments()) operand(argument);
+                },
+                [&](Return& instruction) {
+                    tag(RETURN);
+                    operand(instruction.value());
+                },
+                [&](Binary& instruction) {
+                    tag(BINARY);
+                    variable(instruction.result());
+                    operand(instruction.left());
+                    byte(static_cast<uint8_t>(instruction.op()));
+                    operand(instruction.right());
+                    type(instruction.op_type());
+                },
+                [&](Alloca& instruction) {
+                    tag(ALLOCA);
+                    memory(instruction.result());
+                },
+                [&](Store& instruction) {
+                    tag(STORE);
+                    memory(instruction.result());
+                    operand(instruction.source());
+                },
+                [&](Load& instruction) {
+                    tag(LOAD);
+                    variable(instruction.result());
+                    memory(instruction.source());
+                },
+                [&](Argument& instruction) {
+                    tag(ARGUMENT);
+                    variable(instruction.result());
+                    operand(instruction.source());
+                },
+                [&](Phi& instruction) {
+                    tag(PHI);
+                    variable(instruction.result());
+
+                    varint(instruction.incoming().size());
+                    for (const auto& [block, value] : instruction.incoming()) {
+                        string(block->label());
+                        variable(value);
+                    }
+                },
+                [&](Assign& instruction) {
+                    tag(ASSIGN);
+                    variable(instruction.result());
+                    operand(instruction.value());
+                },
+                [&](Select& instruction) {
+                    tag(SELECT);
+                    variable(instruction.result());
+                    operand(instruction.condition());
+                    operand(instruction.true_value());
+                    operand(instruction.false_value());
+                },
+            },
+            instruction
+        );
+    }
+
+    void operand(const Operand& operand) {
+        std::visit(
+            match{
+                [&](const Immediate& value) {
+                    byte(IMMEDIATE);
+                    immediate(value);
+                },
+                [&](const Variable& value) {
+                    byte(VARIABLE);
+                    variable(value);
+                },
+                [&](const Memory& value) {
+                    byte(MEMORY);
+                    memory(value);
+                },
+            },
+            operand
+        );
+    }
+
+    void immediate(const Immediate& immediate) {
+        byte(static_cast<uint8_t>(immediate.index()));
+
+        std::visit(
+            match{
+                [&](const uint64_t value) { varint(value); },
+                [&](const int64_t value) { zigzag(value); },
+                [&](const uint32_t value) { varint(value); },
+                [&](const int32_t value) { zigzag(value); },
+                [&](const double value) { fixed(std::bit_cast<uint64_t>(value)); },
+                [&](const float value) { fixed(std::bit_cast<uint32_t>(value)); },
+                [&](const bool value) { byte(value); },
+            },
+            immediate
+        );
+    }
+
+    void variable(const Variable& variable) {
+        string(variable.name());
+        varint(variable.version());
+        type(variable.type());
+    }
+
+    void memory(const Memory& memory) {
+        string(memory.name());
+        type(memory.type());
+    }
+
+    /**
+     * @brief Types fit into a single byte: the kind, the sign and the logarithm of the size.
+     */
+    void type(const sem::Type& type) {
+        const auto bytes = size_to_bytes(type.size());
+        byte(static_cast<uint8_t>(static_cast<uint8_t>(type.kind()) | type.sign() << 2 | std::countr_zero(bytes) << 3));
+    }
+
+    void location(const pretty_diagnostics::Location& location) {
+        varint(location.row());
+        varint(location.column());
+        varint(location.index());
+    }
+
+    void string(const std::string& value) {
+        const auto [found, inserted] = _indices.try_emplace(value, _strings.size());
+        if (inserted) _strings.push_back(value);
+
+        varint(found->second);
+    }
+
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            byte(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+
+        byte(static_cast<uint8_t>(value));
+    }
+
+    void zigzag(const int64_t value) {
+        varint(static_cast<uint64_t>(value) << 1 ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    template <typename Type>
+    void fixed(Type value) {
+        for (size_t index = 0; index < sizeof(Type); index++) {
+            byte(static_cast<uint8_t>(value));
+            value >>= 8;
+        }
+    }
+
+    void byte(const uint8_t value) { _stream.push_back(static_cast<char>(value)); }
+
+private:
+    std::unordered_map<std::string_view, uint64_t> _indices{ };
+    std::vector<std::string_view> _strings{ };
+    std::string _stream{ };
+};
+
+/**
+ * @brief Reads the values written by `Writer`, any failure leaves the reader in the failed state.
+ */
+class Reader {
+public:
+    Reader(const std::string_view input, std::shared_ptr<pretty_diagnostics::Source> source) :
+        _source(std::move(source)), _input(input) { }
+
+    std::optional<Module> module() {
+        if (!_input.starts_with(MAGIC)) return std::nullopt;
+        _position = MAGIC.size();
+
+        if (byte() != Serializer::VERSION) return std::nullopt;
+
+        const auto strings = count();
+        for (uint64_t index = 0; index < strings && !_failed; index++) {
+            const auto size = count();
+            if (_failed) break;
+
+            _strings.emplace_back(_input.substr(_position, size), std::nullopt);
+            _position += size;
+        }
+
+        Module module;
+        while (!_failed && _position < _input.size()) function(module);
+
+        if (_failed) return std::nullopt;
+        return module;
+    }
+
+private:
+    void function(Module& module) {
+        const auto name = string();
+        const auto type = this->type();
+        const auto flags = byte();
+
+        std::vector<Variable> parameters;
+        const auto parameter_count = count();
+        for (uint64_t index = 0; index < parameter_count && !_failed; index++) parameters.push_back(variable());
+
+        std::vector<std::string> labels;
+        const auto block_count = count();
+        for (uint64_t index = 0; index < block_count && !_failed; index++) labels.emplace_back(string());
+
+        const auto exit = string();
+        if (_failed || labels.empty() || std::ranges::find(labels, exit) == labels.end()) {
+            _failed = true;
+            return;
+        }
+
+        // A function always consists of an entry and an exit, thus both of them have to be distinct at first.
+        auto exit_label = exit;
+        if (exit_label == labels.front()) {
+            while (std::ranges::find(labels, exit_label) != labels.end()) exit_label += "'";
+        }
+
+        auto& function = module.emplace_back(name, std::move(parameters), type, labels.front(), exit_label);
+        function.set_memoized(flags & MEMOIZED);
+
+        _blocks.clear();
+        _blocks.emplace(function.entry()->label(), function.entry());
+
+        if (exit_label != exit) {
+            std::ignore = function.remove(function.exit());
+            function.set_exit(function.entry());
+        } else {
+            _blocks.emplace(exit, function.exit());
+        }
+
+        for (const auto& label : labels) {
+            if (_blocks.contains(label)) continue;
+            _blocks.emplace(label, function.emplace_back(label));
+        }
+
+        if (_blocks.size() != labels.size()) _failed = true;
+
+        for (const auto& label : labels) {
+            if (_failed) return;
+
+            auto* current = _blocks.at(label);
+
+            const auto block_flags = byte();
+            if (block_flags & HAS_COUNT) current->set_count(varint());
+            if (block_flags & HAS_NEXT) current->set_next(block());
+            if (block_flags & HAS_BRANCH) current->set_branch(block());
+
+            const auto instructions = count();
+            for (uint64_t index = 0; index < instructions && !_failed; index++) instruction(*current);
+        }
+    }
+
+    void instruction(BasicBlock& block) {
+        const auto tag = byte();
+
+        std::optional<pretty_diagnostics::Span> span;
+        if (tag & HAS_SPAN) {
+            const auto start = location(), end = location();
+            if (_source) span.emplace(_source, start, end);
+        }
+
+        switch (tag & ~HAS_SPAN) {
+            case GOTO: {
+                auto label = string();
+                block.emplace_back<Goto>(std::move(label), std::move(span));
+                break;
+            }
+            case IF: {
+                auto condition = operand();
+                auto next = string();
+                auto branch = string();
+                block.emplace_back<If>(std::move(condition), std::move(next), std::move(branch), std::move(span));
+                break;
+            }
+            case CAST: {
+                auto result = variable();
+                auto source = operand();
+                const auto from = type();
+                block.emplace_back<Cast>(std::move(result), std::move(source), from, std::move(span));
+                break;
+            }
+            case CALL: {
+                auto result = variable();
+                auto name = string();
+
+                const auto effects = byte();
+                if (effects > static_cast<uint8_t>(Call::Effects::Speculatable)) _failed = true;
+
+                std::vector<Operand> arguments;
+                const auto argument_count = count();
+                for (uint64_t index = 0; index < argument_count && !_failed; index++) arguments.push_back(operand());
+
+                block.emplace_back<Call>(
+                    std::move(result), std::move(name), std::move(arguments), std::move(span),
+                    static_cast<Call::Effects>(effects)
+                );
+                break;
+            }
+            case RETURN: {
+                auto value = operand();
+                block.emplace_back<Return>(std::move(value), std::move(span));
+                break;
+            }
+            case BINARY: {
+                auto result = variable();
+                auto left = operand();
+
+                const auto op = byte();
+                if (op > static_cast<uint8_t>(Binary::Operator::Shr)) _failed = true;
+
+                auto right = operand();
+                const auto op_type = type();
+                block.emplace_back<Binary>(
+                    std::move(result), std::move(left), static_cast<Binary::Operator>(op), std::move(right), op_type,
+                    std::move(span)
+                );
+                break;
+            }
+            case ALLOCA: {
+                auto result = memory();
+                block.emplace_back<Alloca>(std::move(result), std::move(span));
+                break;
+            }
+            case STORE: {
+                auto result = memory();
+                auto source = operand();
+                block.emplace_back<Store>(std::move(result), std::move(source), std::move(span));
+                break;
+            }
+            case LOAD: {
+                auto result = variable();
+                auto source = memory();
+                block.emplace_back<Load>(std::move(result), std::move(source), std::move(span));
+                break;
+            }
+            case ARGUMENT: {
+                auto result = variable();
+                auto source = operand();
+                block.emplace_back<Argument>(std::move(result), std::move(source), std::move(span));
+                break;
+            }
+            case PHI: {
+                auto result = variable();
+
+                Phi::Incoming incoming;
+                const auto incoming_count = count();
+                for (uint64_t index = 0; index < incoming_count && !_failed; index++) {
+                    auto* predecessor = this->block();
+                    incoming.emplace_back(predecessor, variable());
+                }
+
+                block.emplace_back<Phi>(std::move(result), std::move(incoming), std::move(span));
+                break;
+            }
+            case ASSIGN: {
+                auto result = variable();
+                auto value = operand();
+                block.emplace_back<Assign>(std::move(result), std::move(value), std::move(span));
+                break;
+            }
+            case SELECT: {
+                auto result = variable();
+                auto condition = operand();
+                auto true_value = operand();
+                auto false_value = operand();
+                block.emplace_back<Select>(
+                    std::move(result), std::move(condition), std::move(true_value), std::move(false_value),
+                    std::move(span)
+                );
+                break;
+            }
+            default: _failed = true; break;
+        }
+    }
+
+    Operand operand() {
+        switch (byte()) {
+            case IMMEDIATE: return immediate();
+            case VARIABLE: return variable();
+            case MEMORY: return memory();
+            default: _failed = true; return Immediate(false);
+        }
+    }
+
+    Immediate immediate() {
+        switch (byte()) {
+            case 0: return varint();
+            case 1: return zigzag();
+            case 2: return static_cast<uint32_t>(bounded(UINT32_MAX));
+            case 3: {
+                const auto value = zigzag();
+                if (value < INT32_MIN || value > INT32_MAX) _failed = true;
+                return static_cast<int32_t>(value);
+            }
+            case 4: return std::bit_cast<double>(fixed<uint64_t>());
+            case 5: return std::bit_cast<float>(fixed<uint32_t>());
+            case 6: return static_cast<bool>(bounded(1));
+            default: _failed = true; return false;
+        }
+    }
+
+    Variable variable() {
+        const auto name = interned();
+        const auto version = varint();
+        return { name, type(), version };
+    }
+
+    Memory memory() {
+        const auto name = interned();
+        return { name, type() };
+    }
+
+    sem::Type type() {
+        const auto value = byte();
+
+        const auto kind = value & 0x03;
+        const auto sign = (value >> 2 & 0x01) != 0;
+        const auto size = static_cast<Size>(size_t{ 1 } << (value >> 3 & 0x03));
+        if (value >> 5 != 0) _failed = true;
+
+        switch (kind) {
+            case static_cast<uint8_t>(sem::Type::Kind::Integral): return sem::Integral(size, sign);
+            case static_cast<uint8_t>(sem::Type::Kind::Floating): {
+                if (size != Size::DWORD && size != Size::QWORD) _failed = true;
+                return sem::Floating(size);
+            }
+            case static_cast<uint8_t>(sem::Type::Kind::Boolean): {
+                if (size != Size::BYTE || sign) _failed = true;
+                return sem::Boolean();
+            }
+            default: _failed = true; return sem::Boolean();
+        }
+    }
+
+    pretty_diagnostics::Location location() {
+        const auto row = varint();
+        const auto column = varint();
+        return { row, column, varint() };
+    }
+
+    BasicBlock* block() {
+        const auto found = _blocks.find(string());
+        if (found != _blocks.end()) return found->second;
+
+        _failed = true;
+        return nullptr;
+    }
+
+    utils::Interned interned() {
+        const auto index = bounded(_strings.size() - 1);
+        if (_failed || _strings.empty()) return utils::Interned("");
+
+        auto& [value, interned] = _strings[index];
+        if (!interned) interned.emplace(value);
+        return *interned;
+    }
+
+    std::string string() {
+        const auto index = bounded(_strings.size() - 1);
+        if (_failed || _strings.empty()) return { };
+        return std::string(_strings[index].first);
+    }
+
+    /**
+     * @brief Reads an amount of elements, each of them takes at least one byte.
+     *
+     * Thus a corrupted input never results in huge allocations.
+     */
+    uint64_t count() {
+        const auto value = varint();
+        if (!_failed && value <= _input.size() - _position) return value;
+
+        _failed = true;
+        return 0;
+    }
+
+    uint64_t bounded(const uint64_t maximum) {
+        const auto value = varint();
+        if (value <= maximum) return value;
+
+        _failed = true;
+        return 0;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (size_t shift = 0; shift < 64; shift += 7) {
+            const auto current = byte();
+            value |= static_cast<uint64_t>(current & 0x7F) << shift;
+            if (!(current & 0x80)) return value;
+        }
+
+        _failed = true;
+        return 0;
+    }
+
+    int64_t zigzag() {
+        const auto value = varint();
+        return static_cast<int64_t>(value >> 1 ^ -(value & 1));
+    }
+
+    template <typename Type>
+    Type fixed() {
+        Type value = 0;
+        for (size_t index = 0; index < sizeof(Type); index++) {
+            value |= static_cast<Type>(byte()) << index * 8;
+        }
+        return value;
+    }
+
+    uint8_t byte() {
+        if (_failed || _position >= _input.size()) {
+            _failed = true;
+            return 0;
+        }
+
+        return static_cast<uint8_t>(_input[_position++]);
+    }
+
+private:
+    /// Every name of the table is only interned once it's used by an operand.
+    std::vector<std::pair<std::string_view, std::optional<utils::Interned>>> _strings{ };
+    std::unordered_map<std::string, BasicBlock*> _blocks{ };
+    std::shared_ptr<pretty_diagnostics::Source> _source;
+    std::string_view _input;
+    size_t _position{ };
+    bool _failed{ };
+};
+} // namespace
+
+void Serializer::write(Module& module, std::ostream& output) {
+    Writer writer;
+    for (auto& function : module) writer.function(function);
+    writer.finish(output);
+}
+
+void Serializer::write(Function& function, std::ostream& output) {
+    Writer writer;
+    writer.function(function);
+    writer.finish(output);
+}
+
+std::optional<Module> Serializer::read(
+    const std::string_view input, const std::shared_ptr<pretty_diagnostics::Source>& source
+) {
+    return Reader(input, source).module();
+}
+
+std::optional<Module> Serializer::load(
+    const std::filesystem::path& path, const std::shared_ptr<pretty_diagnostics::Source>& source
+) {
+    const auto descriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) return std::nullopt;
+
+    struct stat status{ };
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        close(descriptor);
+        return std::nullopt;
+    }
+
+    const auto size = static_cast<size_t>(status.st_size);
+    auto* memory = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+
+    if (memory == MAP_FAILED) return std::nullopt;
+
+    auto module = read(std::string_view(static_cast<const char*>(memory), size), source);
+    munmap(memory, size);
+
+    return module;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
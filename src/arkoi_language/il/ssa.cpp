@@ -3,42 +3,37 @@
 using namespace arkoi::il;
 using namespace arkoi;
 
-SSAPromoter::SSAPromoter(Function& function) :
-    _function(function) {
-    _frontiers = DominatorTree::compute_frontiers(_function);
-
+SSAPromoter::SSAPromoter(Function& function, AnalysisManager& analyses) :
+    _dominance(analyses.get<DominanceAnalysis>(function)), _analyses(analyses), _function(function) {
     _candidates = _collect_candidates();
     for (const auto& candidate : _candidates) {
         _stacks[candidate].push(0);
         _counters[candidate] = 0;
     }
-
-    auto immediates = DominatorTree::compute_immediates(_function);
-    for (auto& [block, immediate] : immediates) {
-        if (!immediate) continue;
-        _children[immediate].push_back(block);
-    }
 }
 
 void SSAPromoter::promote() {
     if (_candidates.empty()) return;
 
     for (const auto& candidate : _candidates) {
-        _place_phi_nodes(candidate);
+        _inserted_phis += _place_phi_nodes(candidate);
     }
 
     std::unordered_set<BasicBlock*> visited{ };
     _rename(_function.entry(), visited);
+
+    // Only instructions were inserted and renamed, thus the dominance stays valid.
+    _analyses.invalidate(_function, AnalysisManager::Preserved::ControlFlow);
 }
 
-std::set<std::string> SSAPromoter::_collect_candidates() const {
-    std::set<std::string> candidates{ };
+std::set<utils::Interned> SSAPromoter::_collect_candidates() const {
+    std::set<utils::Interned> candidates{ };
     for (auto& block : _function) {
         for (auto& instruction : block) {
             const auto* alloca = std::get_if<Alloca>(&instruction);
             if (!alloca) continue;
 
-            const auto& name = alloca->result().name();
+            const auto name = alloca->result().symbol();
             if (candidates.contains(name)) {
                 throw std::runtime_error("SSA conversion failed: multiple definitions of variable.");
             }
@@ -49,15 +44,19 @@ std::set<std::string> SSAPromoter::_collect_candidates() const {
     return candidates;
 }
 
-void SSAPromoter::_place_phi_nodes(const std::string& candidate) const {
+size_t SSAPromoter::_place_phi_nodes(const utils::Interned candidate) const {
     std::unordered_set<BasicBlock*> definition_blocks{ };
+    std::vector<BasicBlock*> use_blocks{ };
 
     std::optional<sem::Type> type{ };
     for (auto& block : _function) {
+        bool defined = false, exposed = false;
+
         for (auto& instruction : block) {
             if (const auto* alloca = std::get_if<Alloca>(&instruction)) {
-                if (alloca->result().name() != candidate) continue;
+                if (alloca->result().symbol() != candidate) continue;
                 definition_blocks.insert(&block);
+                defined = true;
 
                 // This will only be set once, because `_collect_candidates` makes sure
                 // that a name only has one alloca.
@@ -65,14 +64,35 @@ void SSAPromoter::_place_phi_nodes(const std::string& candidate) const {
             }
 
             if (const auto* store = std::get_if<Store>(&instruction)) {
-                if (store->result().name() != candidate) continue;
+                if (store->result().symbol() != candidate) continue;
                 definition_blocks.insert(&block);
+                defined = true;
+            }
+
+            if (const auto* load = std::get_if<Load>(&instruction)) {
+                if (load->source().symbol() != candidate) continue;
+                exposed |= !defined;
             }
         }
+
+        if (exposed) use_blocks.push_back(&block);
     }
 
     const Variable variable{ candidate, *type };
 
+    // Pruned SSA: The candidate is live-in where it is loaded before being stored, and in every predecessor of
+    // such a block that doesn't store it itself. A phi anywhere else would be dead, thus none is placed there.
+    std::unordered_set live_blocks(use_blocks.begin(), use_blocks.end());
+    while (!use_blocks.empty()) {
+        auto* block = use_blocks.back();
+        use_blocks.pop_back();
+
+        for (auto* predecessor : block->predecessors()) {
+            if (definition_blocks.contains(predecessor)) continue;
+            if (live_blocks.insert(predecessor).second) use_blocks.push_back(predecessor);
+        }
+    }
+
     std::deque worklist(definition_blocks.begin(), definition_blocks.end());
     std::unordered_set<BasicBlock*> inserted_blocks{ };
 
@@ -80,10 +100,11 @@ void SSAPromoter::_place_phi_nodes(const std::string& candidate) const {
         auto* block = worklist.front();
         worklist.pop_front();
 
-        if (!_frontiers.contains(block)) continue;
+        const auto found = _dominance.frontiers().find(block);
+        if (found == _dominance.frontiers().end()) continue;
 
-        for (auto* frontier : _frontiers.at(block)) {
-            if (inserted_blocks.contains(frontier)) continue;
+        for (auto* frontier : found->second) {
+            if (inserted_blocks.contains(frontier) || !live_blocks.contains(frontier)) continue;
             inserted_blocks.insert(frontier);
 
             frontier->instructions().insert(
@@ -96,18 +117,20 @@ void SSAPromoter::_place_phi_nodes(const std::string& candidate) const {
             }
         }
     }
+
+    return inserted_blocks.size();
 }
 
 void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& visited) {
     if (visited.contains(block)) return;
     visited.insert(block);
 
-    std::unordered_map<std::string, size_t> pushed_count;
+    std::unordered_map<utils::Interned, size_t> pushed_count;
     for (auto it = block->instructions().begin(); it != block->instructions().end(); ++it) {
         auto& instruction = *it;
 
         if (auto* phi = std::get_if<Phi>(&instruction)) {
-            const auto& name = phi->result().name();
+            const auto name = phi->result().symbol();
             if (!_candidates.contains(name)) continue;
 
             const auto new_version = _counters[name]++;
@@ -116,7 +139,7 @@ void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& vi
             _stacks[name].push(new_version);
             pushed_count[name]++;
         } else if (auto* store = std::get_if<Store>(&instruction)) {
-            const auto& name = store->result().name();
+            const auto name = store->result().symbol();
             if (!_candidates.contains(name)) continue;
 
             const auto new_version = _counters[name]++;
@@ -127,7 +150,7 @@ void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& vi
 
             instruction = Assign(result, store->source(), store->span());
         } else if (const auto* load = std::get_if<Load>(&instruction)) {
-            const auto& name = load->source().name();
+            const auto name = load->source().symbol();
             if (!_candidates.contains(name)) continue;
 
             const auto version = _stacks[name].top();
@@ -135,7 +158,7 @@ void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& vi
 
             instruction = Assign(load->result(), source, load->span());
         } else if (const auto* alloca = std::get_if<Alloca>(&*it)) {
-            const auto& name = alloca->result().name();
+            const auto name = alloca->result().symbol();
             if (!_candidates.contains(name)) continue;
 
             it = --block->instructions().erase(it);
@@ -147,13 +170,13 @@ void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& vi
 
         for (auto& instruction : successor->instructions()) {
             if (auto* phi = std::get_if<Phi>(&instruction)) {
-                const auto& name = phi->result().name();
+                const auto name = phi->result().symbol();
                 if (!_candidates.contains(name)) continue;
 
                 const auto version = _stacks[name].top();
                 const auto source = Variable{ name, phi->result().type(), version };
 
-                phi->incoming().insert_or_assign(block->label(), source);
+                phi->set_incoming(block, source);
             }
         }
     };
@@ -161,10 +184,8 @@ void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& vi
     handle_successor(block->next());
     handle_successor(block->branch());
 
-    if (_children.contains(block)) {
-        for (auto* child : _children.at(block)) {
-            _rename(child, visited);
-        }
+    for (auto* child : _dominance.children(block)) {
+        _rename(child, visited);
     }
 
     for (auto& [name, count] : pushed_count) {
@@ -177,42 +198,41 @@ void SSAPromoter::_rename(BasicBlock* block, std::unordered_set<BasicBlock*>& vi
 PhiLowerer::PhiLowerer(Function& function) :
     _function(function) { }
 
-void PhiLowerer::lower() const {
-    for (auto& block : _function) {
-        std::vector<Phi*> phis;
+void PhiLowerer::lower() {
+    _split_critical_edges();
 
+    for (auto& block : _function) {
+        // The incoming values of all phis form one parallel copy per predecessor, in the order of the phis.
+        std::vector<std::pair<BasicBlock*, std::vector<Copy>>> edges;
         for (auto& instruction : block.instructions()) {
             auto* phi = std::get_if<Phi>(&instruction);
             if (!phi) continue;
 
-            phis.push_back(phi);
-        }
+            for (const auto& [predecessor, source] : phi->incoming()) {
+                // Edges of blocks which are no predecessors anymore (e.g. removed by the optimizer) are dropped.
+                if (!block.predecessors().contains(predecessor)) continue;
 
-        if (phis.empty()) continue;
+                auto edge = std::ranges::find(edges, predecessor, &std::pair<BasicBlock*, std::vector<Copy>>::first);
+                if (edge == edges.end()) edge = edges.emplace(edges.end(), predecessor, std::vector<Copy>{ });
 
-        for (auto* predecessor : block.predecessors()) {
-            for (const auto& phi : phis) {
-                const auto& result = phi->result();
-
-                auto source_result = phi->incoming().find(predecessor->label());
-                if (source_result == phi->incoming().end()) continue;
+                edge->second.emplace_back(phi->result(), source);
+            }
+        }
 
-                const auto& source = source_result->second;
+        if (edges.empty()) continue;
 
-                auto rit = predecessor->instructions().rbegin();
-                for (; rit != predecessor->instructions().rend(); ++rit) {
-                    const auto& instruction = *rit;
-                    if (!(std::get_if<Goto>(&instruction) || std::get_if<If>(&instruction)
-                          || std::get_if<Return>(&instruction))) {
-                        break;
-                    }
+        for (auto& [predecessor, copies] : edges) {
+            auto rit = predecessor->instructions().rbegin();
+            for (; rit != predecessor->instructions().rend(); ++rit) {
+                const auto& instruction = *rit;
+                if (!(std::get_if<Goto>(&instruction) || std::get_if<If>(&instruction)
+                      || std::get_if<Return>(&instruction))) {
+                    break;
                 }
-
-                predecessor->instructions().insert(
-                    rit.base(),
-                    Assign(result, source, std::nullopt)
-                );
             }
+
+            const auto sequence = _sequentialize(std::move(copies));
+            predecessor->instructions().insert(rit.base(), sequence.begin(), sequence.end());
         }
 
         auto& instructions = block.instructions();
@@ -225,6 +245,81 @@ void PhiLowerer::lower() const {
     }
 }
 
+void PhiLowerer::_split_critical_edges() {
+    std::vector<std::pair<BasicBlock*, BasicBlock*>> edges;
+    for (auto& block : _function) {
+        const auto has_phi = std::ranges::any_of(block.instructions(), [](const Instruction& instruction) {
+            return std::holds_alternative<Phi>(instruction);
+        });
+        if (!has_phi) continue;
+
+        // The copies of an edge from a block with two successors would also run on the other edge.
+        for (auto* predecessor : block.predecessors()) {
+            if (!predecessor->next() || !predecessor->branch() || predecessor->next() == predecessor->branch()) continue;
+            edges.emplace_back(predecessor, &block);
+        }
+    }
+
+    // The predecessors are a hashed set, thus the edges are sorted to keep the labels of the new blocks stable.
+    std::ranges::sort(edges, { }, [](const auto& edge) { return std::pair(edge.second->label(), edge.first->label()); });
+
+    for (const auto& [predecessor, block] : edges) {
+        auto* split = _function.emplace_back(predecessor->label() + "." + block->label());
+        _split_edges++;
+
+        auto& terminator = predecessor->instructions().back();
+        const auto redirect = [&](const std::string& label) { return label == block->label() ? split->label() : label; };
+        if (auto* _if = std::get_if<If>(&terminator)) {
+            terminator = If(_if->condition(), redirect(_if->next()), redirect(_if->branch()), _if->span());
+        }
+
+        if (predecessor->next() == block) predecessor->set_next(split);
+        if (predecessor->branch() == block) predecessor->set_branch(split);
+
+        split->emplace_back<Goto>(block->label(), std::nullopt);
+        split->set_next(block);
+
+        for (auto& instruction : *block) {
+            auto* phi = std::get_if<Phi>(&instruction);
+            if (phi) phi->replace_predecessor(predecessor, split);
+        }
+    }
+}
+
+std::vector<Instruction> PhiLowerer::_sequentialize(std::vector<Copy> copies) {
+    std::erase_if(copies, [](const Copy& copy) { return copy.first == copy.second; });
+
+    std::vector<Instruction> sequence;
+    sequence.reserve(copies.size());
+
+    const auto is_read = [&](const Variable& variable) {
+        return std::ranges::any_of(copies, [&](const Copy& copy) { return copy.second == variable; });
+    };
+
+    while (!copies.empty()) {
+        // A copy whose destination isn't read by another pending copy can be emitted right away.
+        const auto ready = std::ranges::find_if(copies, [&](const Copy& copy) { return !is_read(copy.first); });
+        if (ready != copies.end()) {
+            sequence.emplace_back(Assign(ready->first, ready->second, std::nullopt));
+            copies.erase(ready);
+            continue;
+        }
+
+        // Every pending destination is still read, thus they form cycles. One of them is broken by saving the
+        // value of a destination in a temporary, which then is read instead.
+        const auto& destination = copies.front().first;
+        const Variable temporary(destination.name() + ".tmp", destination.type(), _temporaries++);
+        sequence.emplace_back(Assign(temporary, destination, std::nullopt));
+
+        for (auto& copy : copies) {
+            if (copy.second == destination) copy.second = temporary;
+        }
+    }
+
+    _copies += sequence.size();
+    return sequence;
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
@@ -1,5 +1,8 @@
 #include "arkoi_language/opt/constant_folding.hpp"
 
+#include <limits>
+#include <type_traits>
+
 #include "arkoi_language/il/operand.hpp"
 #include "arkoi_language/utils/utils.hpp"
 
@@ -15,6 +18,14 @@ bool ConstantFolding::on_block(il::BasicBlock& block) {
         if (auto* const cast = std::get_if<il::Cast>(&instruction)) {
             const auto value = _cast(*cast);
             instruction = il::Assign(cast->result(), value, cast->span());
+            count("folded-instructions");
+            changed = true;
+        } else if (auto* const binary = std::get_if<il::Binary>(&instruction)) {
+            const auto value = _binary(*binary);
+            if (!value) continue;
+
+            instruction = il::Assign(binary->result(), *value, binary->span());
+            count("folded-instructions");
             changed = true;
         }
     }
@@ -23,25 +34,102 @@ bool ConstantFolding::on_block(il::BasicBlock& block) {
 }
 
 il::Immediate ConstantFolding::_cast(il::Cast& instruction) {
-    auto expression = std::get<il::Immediate>(instruction.source());
+    return evaluate_cast(instruction.result().type(), std::get<il::Immediate>(instruction.source()));
+}
+
+std::optional<il::Immediate> ConstantFolding::_binary(il::Binary& instruction) {
+    const auto& left = std::get<il::Immediate>(instruction.left());
+    const auto& right = std::get<il::Immediate>(instruction.right());
+    return evaluate_binary(instruction.op(), instruction.op_type(), left, right);
+}
+
+il::Immediate ConstantFolding::evaluate_cast(const sem::Type& to, const il::Immediate& value) {
+    return std::visit([&](const auto& expression) { return _evaluate_cast(to, expression); }, value);
+}
+
+std::optional<il::Immediate> ConstantFolding::evaluate_binary(
+    const il::Binary::Operator op, const sem::Type& type, const il::Immediate& left, const il::Immediate& right
+) {
+    const auto converted_left = evaluate_cast(type, left);
+    const auto converted_right = evaluate_cast(type, right);
 
     return std::visit(
-        [&](const auto& value) {
-            return _evaluate_cast(instruction.result().type(), value);
+        [&]<typename Left, typename Right>(const Left lhs, const Right rhs) -> std::optional<il::Immediate> {
+            if constexpr (std::is_same_v<Left, Right>) {
+                return _evaluate_binary(op, lhs, rhs);
+            } else {
+                std::unreachable();
+            }
         },
-        expression
+        converted_left, converted_right
     );
 }
 
+template <typename Type>
+std::optional<il::Immediate> ConstantFolding::_evaluate_binary(const il::Binary::Operator op, Type left, Type right) {
+    using Operator = il::Binary::Operator;
+
+    switch (op) {
+        case Operator::GreaterThan: return left > right;
+        case Operator::LessThan: return left < right;
+        case Operator::GreaterEqual: return left >= right;
+        case Operator::LessEqual: return left <= right;
+        case Operator::Equal: return left == right;
+        case Operator::NotEqual: return left != right;
+        default: break;
+    }
+
+    if constexpr (std::is_same_v<Type, bool>) {
+        return std::nullopt;
+    } else if constexpr (std::is_floating_point_v<Type>) {
+        switch (op) {
+            case Operator::Add: return static_cast<Type>(left + right);
+            case Operator::Sub: return static_cast<Type>(left - right);
+            case Operator::Mul: return static_cast<Type>(left * right);
+            case Operator::Div: return static_cast<Type>(left / right);
+            default: std::unreachable();
+        }
+    } else {
+        // The arithmetic is done unsigned, so overflows wrap around instead of being undefined.
+        using Unsigned = std::make_unsigned_t<Type>;
+        const auto lhs = static_cast<Unsigned>(left), rhs = static_cast<Unsigned>(right);
+
+        switch (op) {
+            case Operator::Add: return static_cast<Type>(lhs + rhs);
+            case Operator::Sub: return static_cast<Type>(lhs - rhs);
+            case Operator::Mul: return static_cast<Type>(lhs * rhs);
+            case Operator::Div: {
+                // Both would trap at runtime, thus they are left for the program to execute.
+                if (right == 0) return std::nullopt;
+                if constexpr (std::is_signed_v<Type>) {
+                    if (left == std::numeric_limits<Type>::min() && right == -1) return std::nullopt;
+                }
+
+                return static_cast<Type>(left / right);
+            }
+            case Operator::Shl: {
+                if (rhs >= sizeof(Type) * 8) return std::nullopt;
+                return static_cast<Type>(lhs << rhs);
+            }
+            case Operator::Shr: {
+                // Shifting a signed value to the right is arithmetic, as it is for sar.
+                if (rhs >= sizeof(Type) * 8) return std::nullopt;
+                return static_cast<Type>(left >> rhs);
+            }
+            default: std::unreachable();
+        }
+    }
+}
+
 il::Immediate ConstantFolding::_evaluate_cast(const sem::Type& to, auto expression) {
-    return std::visit(
+    return to.visit(
         match{
             [&](const sem::Integral& type) -> il::Immediate {
                 switch (type.size()) {
                     case Size::BYTE: return type.sign() ? static_cast<int8_t>(expression) : static_cast<uint8_t>(expression);
                     case Size::WORD: return type.sign() ? static_cast<int16_t>(expression) : static_cast<uint16_t>(expression);
-                    case Size::DWORD: return type.sign() ? static_cast<int32_t>(expression) : static_cast<uint32_t>(expression);
-                    case Size::QWORD: return type.sign() ? static_cast<int64_t>(expression) : static_cast<uint64_t>(expression);
+                    case Size::DWORD: return type.sign() ? il::Immediate(static_cast<int32_t>(expression)) : il::Immediate(static_cast<uint32_t>(expression));
+                    case Size::QWORD: return type.sign() ? il::Immediate(static_cast<int64_t>(expression)) : il::Immediate(static_cast<uint64_t>(expression));
                 }
 
                 std::unreachable();
@@ -56,8 +144,7 @@ il::Immediate ConstantFolding::_evaluate_cast(const sem::Type& to, auto expressi
             [&](const sem::Boolean&) -> il::Immediate {
                 return static_cast<bool>(expression);
             }
-        },
-        to
+        }
     );
 }
 
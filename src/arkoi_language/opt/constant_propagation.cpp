@@ -1,82 +1,39 @@
 #include "arkoi_language/opt/constant_propagation.hpp"
 
-#include <unordered_map>
-
-#include "arkoi_language/il/operand.hpp"
-#include "arkoi_language/utils/utils.hpp"
-
 using namespace arkoi::opt;
 using namespace arkoi;
 
-bool ConstantPropagation::on_block(il::BasicBlock& block) {
-    bool changed = false;
-
-    _constants.clear();
+bool ConstantPropagation::enter_function(il::Function& function) {
+    auto& chains = analyses().get<il::DefUseChains>(function);
 
-    for (auto& instruction : block.instructions()) {
-        if (instruction.is_constant()) {
-            if (auto* assign = std::get_if<il::Assign>(&instruction)) {
-                const auto immediate = std::get<il::Immediate>(assign->value());
-                _constants[assign->result()] = immediate;
-            }
+    std::vector<il::Instruction*> worklist{ };
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            if (std::holds_alternative<il::Assign>(instruction)) worklist.push_back(&instruction);
         }
-
-        changed |= _propagate(instruction);
     }
 
-    return changed;
-}
-
-bool ConstantPropagation::_propagate(il::Instruction& target) {
-    auto propagated = false;
-
-    std::visit(
-        match{
-            [&](il::Binary& instruction) {
-                propagated |= _propagate(instruction.left());
-                propagated |= _propagate(instruction.right());
-            },
-            [&](il::Return& instruction) {
-                propagated |= _propagate(instruction.value());
-            },
-            [&](il::Cast& instruction) {
-                propagated |= _propagate(instruction.source());
-            },
-            [&](il::If& instruction) {
-                propagated |= _propagate(instruction.condition());
-            },
-            [&](il::Store& instruction) {
-                propagated |= _propagate(instruction.source());
-            },
-            [&](il::Argument& instruction) {
-                propagated |= _propagate(instruction.source());
-            },
-            [&](il::Assign& instruction) {
-                propagated |= _propagate(instruction.value());
-            },
-            [&](il::Call&) { },
-            [&](il::Alloca&) { },
-            [&](il::Load&) { },
-            [&](il::Goto&) { },
-            [&](il::Phi&) { },
-        },
-        target
-    );
+    bool changed = false;
+    while (!worklist.empty()) {
+        auto* instruction = worklist.back();
+        worklist.pop_back();
 
-    return propagated;
-}
+        auto& assign = std::get<il::Assign>(*instruction);
 
-bool ConstantPropagation::_propagate(il::Operand& operand) {
-    const auto* variable = std::get_if<il::Variable>(&operand);
-    if (variable == nullptr) return false;
+        const auto* immediate = std::get_if<il::Immediate>(&assign.value());
+        if (!immediate || !chains.is_single_assignment(assign.result())) continue;
 
-    const auto result = _constants.find(*variable);
-    if (result == _constants.end()) return false;
+        for (auto* user : chains.replace_all_uses(assign.result(), *immediate)) {
+            if (std::holds_alternative<il::Assign>(*user)) worklist.push_back(user);
+            count("propagated-constants");
+            changed = true;
+        }
+    }
 
-    operand = result->second;
-    return true;
+    return changed;
 }
 
+
 //==============================================================================
 // BSD 3-Clause License
 //
@@ -1,93 +1,116 @@
 #include "arkoi_language/opt/copy_propagation.hpp"
 
-#include "arkoi_language/utils/utils.hpp"
-
 using namespace arkoi::opt;
 using namespace arkoi;
 
-bool CopyPropagation::on_block(il::BasicBlock& block) {
+bool CopyPropagation::enter_function(il::Function& function) {
+    auto& chains = analyses().get<il::DefUseChains>(function);
+
+    std::vector<il::Instruction*> worklist{ };
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            if (std::holds_alternative<il::Assign>(instruction)) worklist.push_back(&instruction);
+        }
+    }
+
     bool changed = false;
+    while (!worklist.empty()) {
+        auto* instruction = worklist.back();
+        worklist.pop_back();
 
-    _copy_map.clear();
+        auto& assign = std::get<il::Assign>(*instruction);
 
-    for (auto& instruction : block.instructions()) {
-        if (auto* assign = std::get_if<il::Assign>(&instruction)) {
-            const auto* source_variable = std::get_if<il::Variable>(&assign->value());
-            if (!source_variable) continue;
+        const auto* source = std::get_if<il::Variable>(&assign.value());
+        if (!source || !chains.is_single_assignment(assign.result())) continue;
 
-            il::Variable resolved_variable = *source_variable;
-            if (_copy_map.contains(*source_variable)) {
-                resolved_variable = _copy_map.at(*source_variable);
-                assign->set_value(resolved_variable);
-                changed = true;
-            }
+        const auto* definition = chains.definition(*source);
+        if (!definition && !chains.is_single_assignment(*source)) continue;
 
-            _copy_map.insert_or_assign(assign->result(), resolved_variable);
-        } else {
-            changed |= _propagate(instruction);
+        std::unordered_set<const il::Instruction*> allowed{ };
+        if (!definition) {
+            // Parameters are bound to their argument registers, which are clobbered by calls. Thus, they are only
+            // read directly until the first argument is passed after the copy.
+            allowed = _call_free_suffix(chains, *instruction);
+        }
+
+        // Phi results are reassigned at the end of every predecessor once the phis are lowered. If a predecessor
+        // has another successor, the new value leaks into it. Then, they can only be read safely in their own block,
+        // except for its terminator if the block loops back to itself.
+        auto* phi_block = definition ? _leaky_phi_block(chains, *definition) : nullptr;
+
+        const auto is_safe = [&](const il::Instruction& user) {
+            if (!definition) return allowed.contains(&user);
+            if (!phi_block) return true;
+
+            if (chains.block(&user) != phi_block) return false;
+            return !std::holds_alternative<il::If>(user) || !phi_block->predecessors().contains(phi_block);
+        };
+
+        for (auto* user : chains.replace_all_uses(assign.result(), *source, is_safe)) {
+            if (std::holds_alternative<il::Assign>(*user)) worklist.push_back(user);
+            count("propagated-copies");
+            changed = true;
         }
     }
 
     return changed;
 }
 
-bool CopyPropagation::_propagate(il::Instruction& target) {
-    auto propagated = false;
-
-    std::visit(
-        match{
-            [&](il::Binary& instruction) {
-                propagated |= _propagate(instruction.left());
-                propagated |= _propagate(instruction.right());
-            },
-            [&](il::Return& instruction) {
-                propagated |= _propagate(instruction.value());
-            },
-            [&](il::Cast& instruction) {
-                propagated |= _propagate(instruction.source());
-            },
-            [&](il::If& instruction) {
-                propagated |= _propagate(instruction.condition());
-            },
-            [&](il::Store& instruction) {
-                propagated |= _propagate(instruction.source());
-            },
-            [&](il::Argument& instruction) {
-                propagated |= _propagate(instruction.source());
-            },
-            [&](il::Assign& instruction) {
-                propagated |= _propagate(instruction.value());
-            },
-            [&](il::Call& instruction) {
-                for (auto& argument : instruction.arguments()) {
-                    propagated |= _propagate(argument);
-                }
-            },
-            [&](il::Phi& instruction) {
-                for (auto& variable : instruction.incoming() | std::views::values) {
-                    propagated |= _propagate(variable);
-                }
-            },
-            [&](il::Alloca&) { },
-            [&](il::Load&) { },
-            [&](il::Goto&) { },
-        },
-        target
-    );
-
-    return propagated;
-}
+std::unordered_set<const il::Instruction*> CopyPropagation::_call_free_suffix(
+    const il::DefUseChains& chains, const il::Instruction& copy
+) {
+    std::unordered_set<const il::Instruction*> suffix{ };
+
+    auto& instructions = chains.block(&copy)->instructions();
+    for (auto index = static_cast<size_t>(&copy - instructions.data()) + 1; index < instructions.size(); index++) {
+        const auto& instruction = instructions[index];
+        if (std::holds_alternative<il::Argument>(instruction)) break;
+        if (std::holds_alternative<il::Call>(instruction)) break;
+
+        suffix.insert(&instruction);
+    }
 
-bool CopyPropagation::_propagate(il::Operand& operand) {
-    auto* variable = std::get_if<il::Variable>(&operand);
-    if (variable == nullptr) return false;
-    return _propagate(*variable);
+    return suffix;
 }
 
-bool CopyPropagation::_propagate(il::Variable& variable) {
-    const auto result = _copy_map.find(variable);
-    if (result == _copy_map.end()) return false;
+il::BasicBlock* CopyPropagation::_leaky_phi_block(const il::DefUseChains& chains, const il::Instruction& definition) {
+    if (!std::holds_alternative<il::Phi>(definition)) return nullptr;
+
+    auto* block = chains.block(&definition);
+    for (const auto* predecessor : block->predecessors()) {
+        if (predecessor->branch()) return block;
+    }
 
-    variable = result->second;
-    return true;
+    return nullptr;
 }
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
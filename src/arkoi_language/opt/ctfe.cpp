@@ -0,0 +1,90 @@
+#include "arkoi_language/opt/ctfe.hpp"
+
+#include <sstream>
+#include <unordered_map>
+
+#include "arkoi_language/il/effect_analysis.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool CTFE::enter_module(il::Module& module) {
+    const il::EffectAnalysis analysis(module);
+    il::Interpreter interpreter(module, _fuel);
+
+    // The same call is often made from multiple places, which is only evaluated once.
+    std::unordered_map<std::string, std::optional<il::Immediate>> evaluated;
+
+    bool changed = false;
+    for (auto& function : module) {
+        for (auto& block : function) {
+            std::unordered_map<il::Variable, il::Immediate> constants;
+
+            for (auto& instruction : block.instructions()) {
+                if (auto* argument = std::get_if<il::Argument>(&instruction)) {
+                    const auto* immediate = std::get_if<il::Immediate>(&argument->source());
+                    if (immediate) constants.insert_or_assign(argument->result(), *immediate);
+                    continue;
+                }
+
+                auto* call = std::get_if<il::Call>(&instruction);
+                if (!call || analysis.effects(call->name()) == il::Call::Effects::Unknown) continue;
+
+                std::vector<il::Immediate> arguments;
+                std::stringstream key;
+                key << call->name();
+                for (const auto& operand : call->arguments()) {
+                    const auto* variable = std::get_if<il::Variable>(&operand);
+                    const auto found = variable ? constants.find(*variable) : constants.end();
+                    if (found == constants.end()) break;
+
+                    arguments.push_back(found->second);
+                    key << " " << found->second.type() << " " << found->second;
+                }
+
+                if (arguments.size() != call->arguments().size()) continue;
+
+                auto [entry, inserted] = evaluated.try_emplace(key.str());
+                if (inserted) entry->second = interpreter.call(call->name(), arguments);
+                if (!entry->second) continue;
+
+                instruction = il::Assign(call->result(), *entry->second, call->span());
+                count("evaluated-calls");
+                changed = true;
+            }
+        }
+    }
+
+    return changed;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
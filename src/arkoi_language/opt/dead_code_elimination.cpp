@@ -1,89 +1,51 @@
 #include "arkoi_language/opt/dead_code_elimination.hpp"
 
-#include <ranges>
-
 #include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi::opt;
 using namespace arkoi;
 
 bool DeadCodeElimination::enter_function(il::Function& function) {
-    _used.clear();
-
-    for (auto& block : function) {
-        for (auto& instr : block) {
-            std::visit(
-                match{
-                    [&](il::Cast& instruction) {
-                        _used.insert(instruction.source());
-                    },
-                    [&](il::Return& instruction) {
-                        _used.insert(instruction.value());
-                    },
-                    [&](il::If& instruction) {
-                        _used.insert(instruction.condition());
-                    },
-                    [&](il::Store& instruction) {
-                        _used.insert(instruction.source());
-                    },
-                    [&](const il::Load& instruction) {
-                        _used.insert(instruction.source());
-                    },
-                    [&](il::Binary& instruction) {
-                        _used.insert(instruction.left());
-                        _used.insert(instruction.right());
-                    },
-                    [&](il::Argument& instruction) {
-                        _used.insert(instruction.source());
-                    },
-                    [&](il::Phi& instruction) {
-                        for (auto& operand : instruction.incoming() | std::views::values) {
-                            _used.insert(operand);
-                        }
-                    },
-                    [&](il::Assign& instruction) {
-                        _used.insert(instruction.value());
-                    },
-                    [&](il::Call&) { },
-                    [&](il::Alloca&) { },
-                    [&](il::Goto&) { },
-                },
-                instr
-            );
-        }
-    }
-
+    _uses = &analyses().get<il::UseAnalysis>(function);
     return false;
 }
 
 bool DeadCodeElimination::on_block(il::BasicBlock& block) {
-    return std::erase_if(
+    const auto removed = std::erase_if(
         block.instructions(),
         [&](auto& instr) {
             return std::visit(
                 match{
                     [&](const il::Binary& instruction) {
-                        return !_used.contains(instruction.result());
+                        return !_uses->is_used(instruction.result());
                     },
                     [&](const il::Load& instruction) {
-                        return !_used.contains(instruction.result());
+                        return !_uses->is_used(instruction.result());
                     },
                     [&](const il::Cast& instruction) {
-                        return !_used.contains(instruction.result());
+                        return !_uses->is_used(instruction.result());
                     },
                     [&](const il::Assign& instruction) {
-                        return !_used.contains(instruction.result());
+                        return !_uses->is_used(instruction.result());
+                    },
+                    [&](const il::Select& instruction) {
+                        return !_uses->is_used(instruction.result());
                     },
                     [&](const il::Alloca& instruction) {
-                        return !_used.contains(instruction.result());
+                        return !_uses->is_used(instruction.result());
                     },
                     [&](const il::Store& instruction) {
-                        return !_used.contains(instruction.result());
+                        return !_uses->is_used(instruction.result());
+                    },
+                    [&](il::Argument& instruction) {
+                        return !_uses->is_used(instruction.result());
+                    },
+                    [&](const il::Call& instruction) {
+                        if (instruction.effects() != il::Call::Effects::Speculatable) return false;
+                        return !_uses->is_used(instruction.result());
                     },
-                    [&](il::Argument&) { return false; },
                     [&](il::Return&) { return false; },
                     [&](il::Goto&) { return false; },
-                    [&](il::Call&) { return false; },
                     [&](il::Phi&) { return false; },
                     [&](il::If&) { return false; },
                 },
@@ -91,6 +53,9 @@ bool DeadCodeElimination::on_block(il::BasicBlock& block) {
             );
         }
     );
+
+    count("removed-instructions", removed);
+    return removed != 0;
 }
 
 //==============================================================================
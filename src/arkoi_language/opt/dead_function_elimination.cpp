@@ -0,0 +1,64 @@
+#include "arkoi_language/opt/dead_function_elimination.hpp"
+
+#include "arkoi_language/il/call_graph.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool DeadFunctionElimination::enter_module(il::Module& module) {
+    const il::CallGraph graph(module);
+    if (!graph.function("main")) return false;
+
+    std::vector<std::string> roots{ "main" };
+    for (const auto& [name, calls] : _external_calls) {
+        if (calls != 0) roots.push_back(name);
+    }
+
+    const auto reachable = graph.reachable(roots);
+
+    std::vector<std::string> dead;
+    for (auto& function : module) {
+        if (!reachable.contains(function.name())) dead.push_back(function.name());
+    }
+
+    bool changed = false;
+    for (const auto& name : dead) {
+        if (!module.remove(name)) continue;
+
+        count("removed-functions");
+        changed = true;
+    }
+
+    return changed;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,160 @@
+#include "arkoi_language/opt/gvn.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool GVN::enter_function(il::Function& function) {
+    auto& dominance = analyses().get<il::DominanceAnalysis>(function);
+    auto& chains = analyses().get<il::DefUseChains>(function);
+
+    _expressions.clear();
+    _numbers.clear();
+    _redundant.clear();
+
+    _visit(*function.entry(), dominance, chains);
+
+    bool changed = false;
+    for (const auto& [duplicate, original] : _redundant) {
+        const auto replaced = chains.replace_all_uses(duplicate, original).size();
+        count("replaced-uses", replaced);
+        changed |= replaced != 0;
+    }
+
+    return changed;
+}
+
+void GVN::_visit(il::BasicBlock& block, const il::DominanceAnalysis& dominance, const il::DefUseChains& chains) {
+    std::vector<Expression> scope;
+
+    for (auto& instruction : block) {
+        if (auto* assign = std::get_if<il::Assign>(&instruction)) {
+            // Copies hold the same value as their source.
+            if (chains.is_single_assignment(assign->result()) && !std::holds_alternative<il::Memory>(assign->value())) {
+                _numbers.emplace(assign->result(), _number(assign->value()));
+            }
+
+            continue;
+        }
+
+        // The arguments of a call hold the same value as their source, which numbers the arguments of the call.
+        if (auto* argument = std::get_if<il::Argument>(&instruction)) {
+            if (chains.is_single_assignment(argument->result()) && !std::holds_alternative<il::Memory>(argument->source())) {
+                _numbers.emplace(argument->result(), _number(argument->source()));
+            }
+
+            continue;
+        }
+
+        auto expression = _expression(instruction);
+        if (!expression) continue;
+
+        const auto result = std::get<il::Variable>(instruction.defs().front());
+        if (!chains.is_single_assignment(result)) continue;
+
+        const auto found = _expressions.find(*expression);
+        if (found != _expressions.end()) {
+            // The dominating call returned with the same arguments, thus the duplicate would return as well.
+            if (auto* call = std::get_if<il::Call>(&instruction)) call->set_effects(il::Call::Effects::Speculatable);
+
+            _numbers.emplace(result, found->second);
+            _redundant.emplace_back(result, found->second);
+            continue;
+        }
+
+        _expressions.emplace(*expression, result);
+        scope.push_back(std::move(*expression));
+    }
+
+    for (auto* child : dominance.children(&block)) _visit(*child, dominance, chains);
+
+    for (const auto& expression : scope) _expressions.erase(expression);
+}
+
+std::optional<GVN::Expression> GVN::_expression(il::Instruction& instruction) const {
+    const auto is_memory = [](const il::Operand& operand) { return std::holds_alternative<il::Memory>(operand); };
+
+    if (auto* cast = std::get_if<il::Cast>(&instruction)) {
+        if (is_memory(cast->source())) return std::nullopt;
+
+        return Expression{ instruction.index(), { }, { }, { _number(cast->source()) }, cast->result().type() };
+    }
+
+    if (auto* call = std::get_if<il::Call>(&instruction)) {
+        if (call->effects() == il::Call::Effects::Unknown) return std::nullopt;
+
+        std::vector<il::Operand> arguments;
+        for (const auto& argument : call->arguments()) arguments.push_back(_number(argument));
+
+        return Expression{ instruction.index(), { }, call->name(), std::move(arguments), call->result().type() };
+    }
+
+    auto* binary = std::get_if<il::Binary>(&instruction);
+    if (!binary || is_memory(binary->left()) || is_memory(binary->right())) return std::nullopt;
+
+    auto left = _number(binary->left()), right = _number(binary->right());
+
+    switch (binary->op()) {
+        case il::Binary::Operator::Add:
+        case il::Binary::Operator::Mul:
+        case il::Binary::Operator::Equal:
+        case il::Binary::Operator::NotEqual: {
+            // Commutative operators compute the same value for both orders of their operands.
+            if (std::hash<il::Operand>{ }(right) < std::hash<il::Operand>{ }(left)) std::swap(left, right);
+            break;
+        }
+        default: break;
+    }
+
+    return Expression{
+        instruction.index(), binary->op(), { }, { std::move(left), std::move(right) }, binary->op_type()
+    };
+}
+
+il::Operand GVN::_number(const il::Operand& operand) const {
+    const auto* variable = std::get_if<il::Variable>(&operand);
+    if (!variable) return operand;
+
+    const auto found = _numbers.find(*variable);
+    return found == _numbers.end() ? operand : found->second;
+}
+
+size_t GVN::ExpressionHash::operator()(const Expression& expression) const noexcept {
+    const size_t op_hash = std::hash<size_t>{ }(static_cast<size_t>(expression.op));
+    const size_t callee_hash = std::hash<std::string>{ }(expression.callee);
+
+    size_t hash = expression.kind ^ (op_hash << 1) ^ (callee_hash << 2);
+    for (const auto& operand : expression.operands) hash = hash * 31 + std::hash<il::Operand>{ }(operand);
+
+    return hash;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
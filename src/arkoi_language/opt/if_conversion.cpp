@@ -0,0 +1,166 @@
+#include "arkoi_language/opt/if_conversion.hpp"
+
+#include <cassert>
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool IfConversion::enter_function(il::Function& function) {
+    bool changed = false;
+
+    // Converting a branch removes blocks, thus the traversal starts over after every conversion.
+    for (bool converted = true; converted;) {
+        converted = false;
+
+        for (auto& block : function) {
+            if (!_convert(function, block)) continue;
+
+            count("converted-branches");
+            converted = changed = true;
+            break;
+        }
+    }
+
+    return changed;
+}
+
+bool IfConversion::_convert(il::Function& function, il::BasicBlock& head) const {
+    if (head.instructions().empty()) return false;
+
+    auto* _if = std::get_if<il::If>(&head.instructions().back());
+    if (!_if || std::holds_alternative<il::Immediate>(_if->condition())) return false;
+
+    auto* branch = head.branch();
+    auto* next = head.next();
+    if (!branch || !next || branch == next) return false;
+
+    // The arms are the successors that are hoisted, the sides are the predecessors of the join per condition.
+    std::vector<il::BasicBlock*> arms;
+    il::BasicBlock *join = nullptr, *true_side = nullptr, *false_side = nullptr;
+    if (_is_arm(*branch, head) && _is_arm(*next, head) && branch->next() == next->next()) {
+        join = branch->next();
+        true_side = branch, false_side = next;
+        arms = { branch, next };
+    } else if (_is_arm(*branch, head) && branch->next() == next) {
+        join = next;
+        true_side = branch, false_side = &head;
+        arms = { branch };
+    } else if (_is_arm(*next, head) && next->next() == branch) {
+        join = branch;
+        true_side = &head, false_side = next;
+        arms = { next };
+    } else {
+        return false;
+    }
+
+    if (join == &head || join->predecessors().size() != 2) return false;
+
+    for (auto& instruction : *join) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (phi && (!phi->incoming_from(true_side) || !phi->incoming_from(false_side))) return false;
+    }
+
+    const auto condition = _if->condition();
+    const auto span = _if->span();
+    head.instructions().pop_back();
+
+    for (auto* arm : arms) _hoist(*arm, head);
+
+    for (auto& instruction : *join) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (!phi) continue;
+
+        const auto true_value = *phi->incoming_from(true_side);
+        const auto false_value = *phi->incoming_from(false_side);
+        instruction = il::Select(phi->result(), condition, true_value, false_value, phi->span());
+    }
+
+    head.emplace_back<il::Goto>(join->label(), span);
+    head.set_branch(nullptr);
+    head.set_next(join);
+
+    for (auto* arm : arms) {
+        arm->set_next(nullptr);
+
+        [[maybe_unused]] const auto removed = function.remove(arm);
+        assert(removed);
+    }
+
+    return true;
+}
+
+bool IfConversion::_is_arm(il::BasicBlock& arm, il::BasicBlock& head) const {
+    if (arm.predecessors().size() != 1 || !arm.predecessors().contains(&head)) return false;
+    if (arm.branch() || !arm.next() || arm.next() == &arm) return false;
+
+    size_t size = 0;
+    for (auto& instruction : arm) {
+        if (std::holds_alternative<il::Goto>(instruction)) continue;
+        if (!_is_speculatable(instruction)) return false;
+
+        size++;
+    }
+
+    return size <= _threshold;
+}
+
+bool IfConversion::_is_speculatable(il::Instruction& instruction) {
+    if (std::holds_alternative<il::Cast>(instruction) || std::holds_alternative<il::Assign>(instruction)) return true;
+    if (std::holds_alternative<il::Select>(instruction)) return true;
+
+    auto* binary = std::get_if<il::Binary>(&instruction);
+    if (!binary) return false;
+    if (binary->op() != il::Binary::Operator::Div) return true;
+
+    // Floating point divisions never trap, integer ones only with a known divisor.
+    if (binary->op_type().is_floating()) return true;
+
+    const auto* divisor = std::get_if<il::Immediate>(&binary->right());
+    if (!divisor) return false;
+
+    return std::visit([](const auto value) {
+        using Value = std::decay_t<decltype(value)>;
+        return value != Value(0) && value != static_cast<Value>(-1);
+    }, *divisor);
+}
+
+void IfConversion::_hoist(il::BasicBlock& arm, il::BasicBlock& head) {
+    for (auto& instruction : arm) {
+        if (std::holds_alternative<il::Goto>(instruction)) continue;
+
+        head.instructions().push_back(std::move(instruction));
+    }
+
+    arm.instructions().clear();
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,359 @@
+#include "arkoi_language/opt/inliner.hpp"
+
+#include <algorithm>
+
+#include "arkoi_language/il/call_graph.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool Inliner::enter_module(il::Module& module) {
+    Functions functions;
+    for (auto& function : module) functions.emplace(function.name(), &function);
+
+    // The graph is built before anything is inlined, which is enough as inlining never adds a new cycle.
+    const il::CallGraph graph(module);
+
+    _recursive.clear();
+    for (auto& function : module) {
+        if (graph.is_recursive(function.name())) _recursive.insert(function.name());
+    }
+
+    // Calls from outside of the module count like any other call site, thus those functions are never dead.
+    auto call_sites = _external_calls;
+    for (auto& function : module) {
+        for (const auto& name : _callees(function)) call_sites[name]++;
+    }
+
+    bool changed = false;
+    for (auto* caller : graph.bottom_up()) {
+        changed |= _inline_calls(*caller, functions, call_sites);
+    }
+
+    // Functions that are not called anymore are unreachable from the entry point.
+    std::vector<std::string> dead;
+    for (auto& function : module) {
+        if (function.name() == "main" || call_sites[function.name()] != 0) continue;
+        dead.push_back(function.name());
+    }
+
+    for (const auto& name : dead) {
+        if (!module.remove(name)) continue;
+
+        count("removed-functions");
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool Inliner::_inline_calls(
+    il::Function& caller, const Functions& functions, std::unordered_map<std::string, size_t>& call_sites
+) {
+    std::vector<il::BasicBlock*> worklist;
+    for (auto& block : caller) worklist.push_back(&block);
+
+    bool changed = false;
+    while (!worklist.empty()) {
+        auto* block = worklist.back();
+        worklist.pop_back();
+
+        auto& instructions = block->instructions();
+        for (size_t index = 0; index < instructions.size(); index++) {
+            const auto* call = std::get_if<il::Call>(&instructions[index]);
+            if (!call) continue;
+
+            const auto found = functions.find(call->name());
+            if (found == functions.end() || found->second == &caller) continue;
+
+            auto& callee = *found->second;
+            if (!_should_inline(caller, *block, callee, call_sites[callee.name()])) continue;
+
+            // The calls of the callee are copied into the caller.
+            call_sites[callee.name()]--;
+            for (const auto& name : _callees(callee)) call_sites[name]++;
+
+            // The rest of the block is moved into a new block, which is searched for further calls.
+            worklist.push_back(_inline(caller, *block, index, callee));
+            count("inlined-calls");
+            changed = true;
+            break;
+        }
+    }
+
+    return changed;
+}
+
+il::BasicBlock* Inliner::_inline(il::Function& caller, il::BasicBlock& block, const size_t index, il::Function& callee) {
+    const auto site = std::to_string(_sites++);
+
+    // Every function numbers its labels on its own, thus the callee's labels are prefixed by its name. Labels of
+    // parsed IL may still collide with them, which is resolved by `_unique_label`.
+    const auto rename = [&](const std::string& label) {
+        return _unique_label(caller, callee.name() + "." + label + "." + site);
+    };
+
+    auto& instructions = block.instructions();
+    auto call = std::get<il::Call>(instructions[index]);
+    const auto span = call.span();
+
+    // Split the block after the call, the continuation takes over all successors of the block.
+    auto* continuation = caller.emplace_back(_unique_label(caller, block.label() + ".ret." + site));
+    if (block.count()) continuation->set_count(*block.count());
+    continuation->instructions().assign(
+        std::make_move_iterator(instructions.begin() + static_cast<std::ptrdiff_t>(index) + 1),
+        std::make_move_iterator(instructions.end())
+    );
+    instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(index), instructions.end());
+
+    for (auto* successor : { block.next(), block.branch() }) {
+        if (!successor) continue;
+
+        for (auto& instruction : successor->instructions()) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi) phi->replace_predecessor(&block, continuation);
+        }
+    }
+
+    continuation->set_next(block.next());
+    continuation->set_branch(block.branch());
+    block.set_branch(nullptr);
+
+    if (caller.exit() == &block) caller.set_exit(continuation);
+
+    // Copy the blocks of the callee, the links between them are restored afterwards.
+    // The counts of the callee are scaled down to the share of its executions that stem from this call site.
+    const auto& site_count = block.count();
+    const auto& callee_count = callee.entry()->count();
+
+    Blocks blocks;
+    Labels labels;
+    for (auto& original : callee) {
+        auto* copy = caller.emplace_back(rename(original.label()));
+        labels.emplace(original.label(), copy->label());
+        if (site_count && callee_count && original.count() && *callee_count != 0) {
+            const auto share = static_cast<double>(*site_count) / static_cast<double>(*callee_count);
+            copy->set_count(static_cast<uint64_t>(static_cast<double>(*original.count()) * share));
+        }
+
+        blocks.emplace(&original, copy);
+    }
+
+    for (const auto& [original, copy] : blocks) {
+        for (auto& instruction : original->instructions()) {
+            if (auto* const _return = std::get_if<il::Return>(&instruction)) {
+                const auto value = _clone(_return->value(), site);
+                copy->emplace_back<il::Assign>(call.result(), value, _return->span());
+                copy->emplace_back<il::Goto>(continuation->label(), _return->span());
+                copy->set_next(continuation);
+                continue;
+            }
+
+            copy->instructions().push_back(_clone(instruction, site, blocks, labels));
+        }
+
+        if (original->next()) copy->set_next(blocks.at(original->next()));
+        if (original->branch()) copy->set_branch(blocks.at(original->branch()));
+    }
+
+    // The arguments of the call become plain copies into the parameters of the callee.
+    std::unordered_set<il::Variable> arguments;
+    for (const auto& argument : call.arguments()) {
+        if (const auto* variable = std::get_if<il::Variable>(&argument)) arguments.insert(*variable);
+    }
+
+    for (auto& instruction : instructions) {
+        auto* argument = std::get_if<il::Argument>(&instruction);
+        if (!argument || !arguments.contains(argument->result())) continue;
+
+        instruction = il::Assign(argument->result(), argument->source(), argument->span());
+    }
+
+    for (size_t parameter = 0; parameter < callee.parameters().size(); parameter++) {
+        const auto copy = std::get<il::Variable>(_clone(callee.parameters()[parameter], site));
+        block.emplace_back<il::Assign>(copy, call.arguments()[parameter], span);
+    }
+
+    auto* entry = blocks.at(callee.entry());
+    block.emplace_back<il::Goto>(entry->label(), span);
+    block.set_next(entry);
+
+    return continuation;
+}
+
+bool Inliner::_should_inline(
+    il::Function& caller, const il::BasicBlock& block, il::Function& callee, const size_t call_sites
+) const {
+    if (callee.name() == "main" || _recursive.contains(callee.name())) return false;
+
+    // Inlining a call that never ran only grows the caller, unless the callee is removed afterwards.
+    const auto& site_count = block.count();
+    if (site_count && *site_count == 0 && call_sites != 1) return false;
+
+    // The return value is assigned to the result of the call, which is only possible for a single definition.
+    size_t returns = 0;
+    for (auto& block : callee) {
+        returns += std::ranges::count_if(block, [](const auto& instruction) {
+            return std::holds_alternative<il::Return>(instruction);
+        });
+    }
+    if (returns != 1) return false;
+
+    const auto& caller_count = caller.entry()->count();
+    const auto is_hot = site_count && caller_count && *site_count > *caller_count;
+
+    const auto estimated = cost(callee);
+    if (estimated <= (is_hot ? _threshold * HOT_THRESHOLD_FACTOR : _threshold)) return true;
+
+    return call_sites == 1 && estimated <= _single_call_threshold;
+}
+
+size_t Inliner::cost(il::Function& function) {
+    size_t cost = 0;
+    for (auto& block : function) {
+        for (const auto& instruction : block) {
+            if (std::holds_alternative<il::Phi>(instruction) || std::holds_alternative<il::Goto>(instruction)) continue;
+            cost++;
+        }
+    }
+
+    return cost;
+}
+
+std::vector<std::string> Inliner::_callees(il::Function& function) {
+    std::vector<std::string> callees;
+    for (auto& block : function) {
+        for (const auto& instruction : block) {
+            const auto* call = std::get_if<il::Call>(&instruction);
+            if (call) callees.push_back(call->name());
+        }
+    }
+
+    return callees;
+}
+
+il::Instruction Inliner::_clone(
+    const il::Instruction& instruction, const std::string& site, const Blocks& blocks, const Labels& labels
+) {
+    const auto label = [&](const std::string& name) { return labels.at(name); };
+    const auto operand = [&](const il::Operand& value) { return _clone(value, site); };
+    const auto variable = [&](const il::Variable& value) { return std::get<il::Variable>(_clone(value, site)); };
+    const auto memory = [&](const il::Memory& value) { return std::get<il::Memory>(_clone(value, site)); };
+
+    auto copy = instruction;
+    return std::visit(
+        match{
+            [&](il::Goto& goto_) -> il::Instruction {
+                return il::Goto(label(goto_.label()), goto_.span());
+            },
+            [&](il::If& if_) -> il::Instruction {
+                return il::If(operand(if_.condition()), label(if_.next()), label(if_.branch()), if_.span());
+            },
+            [&](il::Cast& cast) -> il::Instruction {
+                return il::Cast(variable(cast.result()), operand(cast.source()), cast.from(), cast.span());
+            },
+            [&](il::Call& call) -> il::Instruction {
+                std::vector<il::Operand> arguments;
+                for (const auto& argument : call.arguments()) arguments.push_back(operand(argument));
+                return il::Call(
+                    variable(call.result()), call.name(), std::move(arguments), call.span(), call.effects()
+                );
+            },
+            [&](il::Return& return_) -> il::Instruction {
+                return il::Return(operand(return_.value()), return_.span());
+            },
+            [&](il::Binary& binary) -> il::Instruction {
+                return il::Binary(
+                    variable(binary.result()), operand(binary.left()), binary.op(), operand(binary.right()),
+                    binary.op_type(), binary.span()
+                );
+            },
+            [&](il::Alloca& alloca) -> il::Instruction {
+                return il::Alloca(memory(alloca.result()), alloca.span());
+            },
+            [&](il::Store& store) -> il::Instruction {
+                return il::Store(memory(store.result()), operand(store.source()), store.span());
+            },
+            [&](il::Load& load) -> il::Instruction {
+                return il::Load(variable(load.result()), memory(load.source()), load.span());
+            },
+            [&](il::Argument& argument) -> il::Instruction {
+                return il::Argument(variable(argument.result()), operand(argument.source()), argument.span());
+            },
+            [&](il::Phi& phi) -> il::Instruction {
+                il::Phi::Incoming incoming;
+                for (const auto& [predecessor, value] : phi.incoming()) {
+                    // Values of blocks which were removed from the callee are dropped.
+                    const auto found = blocks.find(predecessor);
+                    if (found != blocks.end()) incoming.emplace_back(found->second, variable(value));
+                }
+                return il::Phi(variable(phi.result()), std::move(incoming), phi.span());
+            },
+            [&](il::Assign& assign) -> il::Instruction {
+                return il::Assign(variable(assign.result()), operand(assign.value()), assign.span());
+            },
+            [&](il::Select& select) -> il::Instruction {
+                return il::Select(
+                    variable(select.result()), operand(select.condition()), operand(select.true_value()),
+                    operand(select.false_value()), select.span()
+                );
+            },
+        },
+        copy
+    );
+}
+
+std::string Inliner::_unique_label(il::Function& function, std::string label) {
+    while (function.block_pool().contains(label)) label += "'";
+    return label;
+}
+
+il::Operand Inliner::_clone(const il::Operand& operand, const std::string& site) {
+    return std::visit(
+        match{
+            [&](const il::Immediate& immediate) -> il::Operand {
+                return immediate;
+            },
+            [&](const il::Variable& variable) -> il::Operand {
+                return il::Variable(variable.name() + "." + site, variable.type(), variable.version());
+            },
+            [&](const il::Memory& memory) -> il::Operand {
+                return il::Memory(memory.name() + "." + site, memory.type());
+            },
+        },
+        operand
+    );
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,350 @@
+#include "arkoi_language/opt/instruction_combining.hpp"
+
+#include <bit>
+#include <limits>
+
+#include "arkoi_language/opt/constant_folding.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool InstructionCombining::on_block(il::BasicBlock& block) {
+    bool changed = false;
+
+    // The casts of the block by their result, which chains of casts and comparisons look through.
+    Casts casts;
+
+    auto& instructions = block.instructions();
+    for (size_t index = 0; index < instructions.size(); index++) {
+        if (auto* cast = std::get_if<il::Cast>(&instructions[index])) {
+            if (const auto source = _cast(*cast, casts)) {
+                instructions[index] = il::Assign(cast->result(), *source, cast->span());
+                count("combined-instructions");
+                changed = true;
+            } else {
+                casts.insert_or_assign(cast->result(), std::pair(cast->source(), cast->from()));
+            }
+
+            continue;
+        }
+
+        auto* binary = std::get_if<il::Binary>(&instructions[index]);
+        if (!binary || binary->is_constant()) continue;
+
+        il::BasicBlock::Instructions replacement(instructions.get_allocator());
+        if (!_boolean(*binary, casts, replacement) && !_simplify(*binary, replacement)) continue;
+
+        // The instructions are only touched if they change, as cached analyses point into the block.
+        instructions[index] = std::move(replacement.front());
+        const auto position = instructions.begin() + static_cast<std::ptrdiff_t>(index) + 1;
+        instructions.insert(position, std::make_move_iterator(replacement.begin() + 1), std::make_move_iterator(replacement.end()));
+
+        index += replacement.size() - 1;
+        count("combined-instructions");
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool InstructionCombining::_simplify(il::Binary& instruction, il::BasicBlock::Instructions& output) {
+    if (const auto value = _identity(instruction)) {
+        output.emplace_back(il::Assign(instruction.result(), *value, instruction.span()));
+        return true;
+    }
+
+    const auto& type = instruction.op_type();
+    if (!type.is_integral()) return false;
+
+    const auto is_power_of_two = [&](const uint64_t value) {
+        return std::has_single_bit(value) && value != 1 && static_cast<int64_t>(value) > 0;
+    };
+
+    if (instruction.op() == il::Binary::Operator::Mul) {
+        auto left = instruction.left(), right = instruction.right();
+        if (std::holds_alternative<il::Immediate>(left)) std::swap(left, right);
+
+        const auto factor = _integer(right);
+        if (!factor || !is_power_of_two(*factor)) return false;
+
+        const auto amount = ConstantFolding::evaluate_cast(type, static_cast<uint64_t>(std::countr_zero(*factor)));
+        output.emplace_back(il::Binary(
+            instruction.result(), left, il::Binary::Operator::Shl, amount, type, instruction.span()
+        ));
+        return true;
+    }
+
+    if (instruction.op() == il::Binary::Operator::Div) {
+        const auto divisor = _integer(instruction.right());
+        if (!divisor) return false;
+
+        return _divide(instruction, *divisor, output);
+    }
+
+    return false;
+}
+
+std::optional<il::Operand> InstructionCombining::_cast(il::Cast& instruction, const Casts& casts) {
+    const auto& to = instruction.result().type();
+    if (instruction.from() == to) return instruction.source();
+
+    const auto* variable = std::get_if<il::Variable>(&instruction.source());
+    const auto found = variable ? casts.find(*variable) : casts.end();
+    if (found == casts.end()) return std::nullopt;
+
+    const auto& [source, from] = found->second;
+    const auto& through = variable->type();
+    if (from != to) return std::nullopt;
+
+    // Booleans become zero or one, which every integral and floating point type represents exactly.
+    if (from.is_boolean()) return source;
+
+    // Narrowing an integer back to its own type after widening it restores all of its bits.
+    if (from.is_integral() && through.is_integral()) {
+        if (size_to_bytes(through.integral()->size()) < size_to_bytes(from.integral()->size())) return std::nullopt;
+        return source;
+    }
+
+    // Every single precision value is exactly representable in double precision.
+    if (from.is_floating() && through.is_floating() && from.size() == Size::DWORD) return source;
+
+    return std::nullopt;
+}
+
+bool InstructionCombining::_boolean(il::Binary& instruction, const Casts& casts, il::BasicBlock::Instructions& output) {
+    using Operator = il::Binary::Operator;
+
+    const auto op = instruction.op();
+    if (op != Operator::Equal && op != Operator::NotEqual) return false;
+
+    auto left = instruction.left(), right = instruction.right();
+    if (std::holds_alternative<il::Immediate>(left)) std::swap(left, right);
+
+    std::optional<il::Operand> boolean;
+    if (instruction.op_type().is_boolean()) {
+        boolean = left;
+    } else if (const auto* variable = std::get_if<il::Variable>(&left)) {
+        // The comparison of a widened boolean with zero or one only depends on the boolean.
+        const auto found = casts.find(*variable);
+        if (found != casts.end() && found->second.second.is_boolean()) boolean = found->second.first;
+    }
+
+    if (!boolean || !std::holds_alternative<il::Immediate>(right)) return false;
+    if (!instruction.op_type().is_boolean() && !_is_value(right, 0) && !_is_value(right, 1)) return false;
+
+    const auto value = std::get<bool>(ConstantFolding::evaluate_cast(sem::Boolean(), std::get<il::Immediate>(right)));
+    const auto keeps = (op == Operator::Equal) == value;
+
+    // A boolean compared to be false is already in the form the inversion is written in.
+    if (!keeps && instruction.op_type().is_boolean() && op == Operator::Equal) return false;
+
+    // Comparing with true or with not false keeps the boolean, the other two invert it.
+    const auto& span = instruction.span();
+    if (keeps) {
+        output.emplace_back(il::Assign(instruction.result(), *boolean, span));
+    } else {
+        output.emplace_back(il::Binary(
+            instruction.result(), *boolean, Operator::Equal, il::Immediate(false), sem::Boolean(), span
+        ));
+    }
+
+    return true;
+}
+
+std::optional<il::Operand> InstructionCombining::_identity(il::Binary& instruction) {
+    using Operator = il::Binary::Operator;
+
+    const auto& type = instruction.op_type();
+    const auto& left = instruction.left();
+    const auto& right = instruction.right();
+
+    const bool integral = type.is_integral();
+    const auto zero = [&] { return il::Operand(ConstantFolding::evaluate_cast(type, 0u)); };
+
+    // Floating point comparisons of a value with itself are false for NaN, thus they are only folded for integers.
+    const bool same = std::holds_alternative<il::Variable>(left) && left == right && !type.is_floating();
+
+    switch (instruction.op()) {
+        case Operator::Add: {
+            if (integral && _is_value(right, 0)) return left;
+            if (integral && _is_value(left, 0)) return right;
+            break;
+        }
+        case Operator::Sub: {
+            if (_is_value(right, 0)) return left;
+            if (integral && same) return zero();
+            break;
+        }
+        case Operator::Mul: {
+            if (_is_value(right, 1)) return left;
+            if (_is_value(left, 1)) return right;
+            if (integral && (_is_value(left, 0) || _is_value(right, 0))) return zero();
+            break;
+        }
+        case Operator::Div: {
+            if (_is_value(right, 1)) return left;
+            break;
+        }
+        case Operator::Shl:
+        case Operator::Shr: {
+            if (_is_value(right, 0)) return left;
+            break;
+        }
+        case Operator::Equal:
+        case Operator::LessEqual:
+        case Operator::GreaterEqual: {
+            if (same) return il::Immediate(true);
+            break;
+        }
+        case Operator::NotEqual:
+        case Operator::LessThan:
+        case Operator::GreaterThan: {
+            if (same) return il::Immediate(false);
+            break;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool InstructionCombining::_divide(il::Binary& instruction, const uint64_t divisor, il::BasicBlock::Instructions& output) {
+    using Operator = il::Binary::Operator;
+
+    const auto& result = instruction.result();
+    const auto& left = instruction.left();
+    const auto& span = instruction.span();
+
+    const auto& type = instruction.op_type();
+    const auto integral = type.integral().value();
+    const auto bits = static_cast<uint64_t>(size_to_bytes(integral.size()) * 8);
+
+    const auto temporary = [&](const std::string& suffix, const sem::Type& temporary_type) {
+        return il::Variable(result.name() + "." + suffix, temporary_type, result.version());
+    };
+    const auto immediate = [](const sem::Type& immediate_type, const uint64_t value) -> il::Operand {
+        return ConstantFolding::evaluate_cast(immediate_type, value);
+    };
+
+    if (integral.sign()) {
+        const auto value = static_cast<int64_t>(divisor);
+        if (value == -1) {
+            output.emplace_back(il::Binary(result, immediate(type, 0), Operator::Sub, left, type, span));
+            return true;
+        }
+
+        if (value <= 1 || !std::has_single_bit(divisor)) return false;
+        const auto shift = static_cast<uint64_t>(std::countr_zero(divisor));
+
+        // An arithmetic shift rounds towards negative infinity, thus 2^shift - 1 is added to negative dividends first,
+        // which is the sign mask shifted to the right logically.
+        const sem::Type unsigned_type = sem::Integral(integral.size(), false);
+        const auto sign = temporary("sign", type), mask = temporary("mask", unsigned_type);
+        const auto bias = temporary("bias", unsigned_type), adjust = temporary("adjust", type);
+        const auto biased = temporary("biased", type);
+
+        output.emplace_back(il::Binary(sign, left, Operator::Shr, immediate(type, bits - 1), type, span));
+        output.emplace_back(il::Cast(mask, sign, type, span));
+        output.emplace_back(il::Binary(bias, mask, Operator::Shr, immediate(unsigned_type, bits - shift), unsigned_type, span));
+        output.emplace_back(il::Cast(adjust, bias, unsigned_type, span));
+        output.emplace_back(il::Binary(biased, left, Operator::Add, adjust, type, span));
+        output.emplace_back(il::Binary(result, biased, Operator::Shr, immediate(type, shift), type, span));
+        return true;
+    }
+
+    if (divisor <= 1) return false;
+
+    if (std::has_single_bit(divisor)) {
+        const auto shift = static_cast<uint64_t>(std::countr_zero(divisor));
+        output.emplace_back(il::Binary(result, left, Operator::Shr, immediate(type, shift), type, span));
+        return true;
+    }
+
+    // The quotient of 64bit divisions would need the upper half of a 128bit product.
+    if (bits != 32) return false;
+
+    // With shift = ceil(log2(divisor)), the magic number m = ceil(2^(32 + shift) / divisor) gives the exact quotient
+    // floor(x * m / 2^(32 + shift)) for every 32bit x (Granlund and Montgomery). As m needs 33 bits, the product is
+    // split into x * 2^32 + x * (m - 2^32), which keeps all intermediate values within 64 bits.
+    const auto shift = static_cast<uint64_t>(std::bit_width(divisor - 1));
+    const auto numerator = shift == 32 ? std::numeric_limits<uint64_t>::max() : (uint64_t{ 1 } << (32 + shift)) - 1;
+    const auto magic = numerator / divisor + 1 - (uint64_t{ 1 } << 32);
+
+    const sem::Type wide_type = sem::Integral(Size::QWORD, false);
+    const auto wide = temporary("wide", wide_type), product = temporary("product", wide_type);
+    const auto high = temporary("high", wide_type), sum = temporary("sum", wide_type);
+    const auto quotient = temporary("quotient", wide_type);
+
+    output.emplace_back(il::Cast(wide, left, type, span));
+    output.emplace_back(il::Binary(product, wide, Operator::Mul, immediate(wide_type, magic), wide_type, span));
+    output.emplace_back(il::Binary(high, product, Operator::Shr, immediate(wide_type, 32), wide_type, span));
+    output.emplace_back(il::Binary(sum, wide, Operator::Add, high, wide_type, span));
+    output.emplace_back(il::Binary(quotient, sum, Operator::Shr, immediate(wide_type, shift), wide_type, span));
+    output.emplace_back(il::Cast(result, quotient, wide_type, span));
+    return true;
+}
+
+std::optional<uint64_t> InstructionCombining::_integer(const il::Operand& operand) {
+    const auto* immediate = std::get_if<il::Immediate>(&operand);
+    if (!immediate) return std::nullopt;
+
+    return std::visit(
+        []<typename Type>(const Type value) -> std::optional<uint64_t> {
+            if constexpr (std::is_integral_v<Type> && !std::is_same_v<Type, bool>) {
+                return static_cast<uint64_t>(static_cast<std::conditional_t<std::is_signed_v<Type>, int64_t, uint64_t>>(value));
+            } else {
+                return std::nullopt;
+            }
+        },
+        *immediate
+    );
+}
+
+bool InstructionCombining::_is_value(const il::Operand& operand, const int64_t expected) {
+    const auto* immediate = std::get_if<il::Immediate>(&operand);
+    if (!immediate) return false;
+
+    return std::visit(
+        [&]<typename Type>(const Type value) {
+            if constexpr (std::is_same_v<Type, bool>) {
+                return false;
+            } else if constexpr (std::is_floating_point_v<Type>) {
+                return value == static_cast<Type>(expected);
+            } else {
+                return static_cast<int64_t>(value) == expected;
+            }
+        },
+        *immediate
+    );
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,264 @@
+#include "arkoi_language/opt/ipcp.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_set>
+
+#include "arkoi_language/opt/inliner.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool IPCP::enter_module(il::Module& module) {
+    const il::CallGraph graph(module);
+
+    bool changed = false;
+    for (auto& function : module) {
+        if (_is_candidate(graph, function)) changed |= _propagate(graph, function);
+    }
+
+    // Specializing adds a function to the module, which invalidates the graph. Thus, only a single function is
+    // specialized at once, the pass manager visits the module again until nothing changes anymore.
+    if (changed) return true;
+
+    std::vector<std::string> names;
+    for (auto& function : module) {
+        if (!_is_candidate(graph, function)) continue;
+        if (_specializations[function.name()] >= MAX_SPECIALIZATIONS) continue;
+        if (Inliner::cost(function) > SPECIALIZATION_THRESHOLD) continue;
+
+        names.push_back(function.name());
+    }
+
+    return std::ranges::any_of(names, [&](const auto& name) { return _specialize(module, graph, name); });
+}
+
+bool IPCP::_is_candidate(const il::CallGraph& graph, il::Function& function) const {
+    if (function.name() == "main" || function.parameters().empty()) return false;
+
+    const auto external = _external_calls.find(function.name());
+    if (external != _external_calls.end() && external->second != 0) return false;
+
+    return !graph.sites(function.name()).empty() && !graph.is_recursive(function.name());
+}
+
+bool IPCP::_propagate(const il::CallGraph& graph, il::Function& function) {
+    auto calls = _calls(graph, function.name());
+
+    bool changed = false;
+    for (size_t parameter = function.parameters().size(); parameter-- > 0;) {
+        const auto value = _constant(calls.front(), parameter);
+        if (!value) continue;
+
+        const auto is_same = [&](const CallSite& site) { return _constant(site, parameter) == value; };
+        if (!std::ranges::all_of(calls, is_same)) continue;
+
+        for (const auto& site : std::views::reverse(calls)) _remove_argument(site, parameter, function.name());
+        _remove_parameter(function, parameter, *value);
+
+        // Removing the arguments moved the calls behind them.
+        calls = _calls(graph, function.name());
+
+        count("propagated-arguments");
+        changed = true;
+    }
+
+    return changed;
+}
+
+bool IPCP::_specialize(il::Module& module, const il::CallGraph& graph, const std::string& name) {
+    const auto calls = _calls(graph, name);
+    const auto parameters = graph.function(name)->parameters().size();
+
+    // The constant passed by the most calls is chosen, or the one whose calls ran most often.
+    struct Candidate {
+        size_t parameter;
+        il::Immediate value;
+        std::vector<CallSite> calls;
+        uint64_t count;
+    };
+
+    std::optional<Candidate> best;
+    for (size_t parameter = 0; parameter < parameters; parameter++) {
+        std::vector<Candidate> candidates;
+        for (const auto& site : calls) {
+            const auto value = _constant(site, parameter);
+            if (!value) continue;
+
+            auto found = std::ranges::find_if(candidates, [&](const auto& other) { return other.value == *value; });
+            if (found == candidates.end()) found = candidates.insert(candidates.end(), { parameter, *value, { }, 0 });
+
+            found->calls.push_back(site);
+            found->count += site.block->count().value_or(0);
+        }
+
+        uint64_t total = 0;
+        for (const auto& site : calls) total += site.block->count().value_or(0);
+
+        for (auto& candidate : candidates) {
+            if (candidate.calls.size() == calls.size()) continue;
+
+            const auto is_hot = candidate.count * 2 > total;
+            if (candidate.calls.size() < 2 && !is_hot) continue;
+            if (best && best->calls.size() >= candidate.calls.size()) continue;
+
+            best = std::move(candidate);
+        }
+    }
+
+    if (!best) return false;
+
+    const auto specialized = name + ".specialized" + std::to_string(_copies++);
+    auto& copy = _copy(module, name, specialized);
+    _remove_parameter(copy, best->parameter, best->value);
+
+    for (const auto& site : std::views::reverse(best->calls)) _remove_argument(site, best->parameter, specialized);
+
+    _specializations[name]++;
+    count("specialized-functions");
+
+    return true;
+}
+
+std::vector<IPCP::CallSite> IPCP::_calls(const il::CallGraph& graph, const std::string& name) {
+    std::vector<CallSite> calls;
+
+    std::unordered_set<il::BasicBlock*> visited;
+    for (const auto& site : graph.sites(name)) {
+        if (!visited.insert(site.block).second) continue;
+
+        auto& instructions = site.block->instructions();
+        for (size_t index = 0; index < instructions.size(); index++) {
+            const auto* call = std::get_if<il::Call>(&instructions[index]);
+            if (call && call->name() == name) calls.push_back({ site.block, index });
+        }
+    }
+
+    return calls;
+}
+
+std::optional<il::Immediate> IPCP::_constant(const CallSite& site, const size_t parameter) {
+    auto& instructions = site.block->instructions();
+    auto& call = std::get<il::Call>(instructions[site.index]);
+
+    const auto& argument = call.arguments()[parameter];
+    if (const auto* immediate = std::get_if<il::Immediate>(&argument)) return *immediate;
+
+    // The arguments are passed right in front of the call, which defines the operands of the call.
+    for (size_t index = site.index; index-- > 0;) {
+        auto* passed = std::get_if<il::Argument>(&instructions[index]);
+        if (!passed || il::Operand(passed->result()) != argument) continue;
+
+        const auto* immediate = std::get_if<il::Immediate>(&passed->source());
+        if (!immediate) return std::nullopt;
+
+        return *immediate;
+    }
+
+    return std::nullopt;
+}
+
+void IPCP::_remove_argument(const CallSite& site, const size_t parameter, const std::string& callee) {
+    auto& instructions = site.block->instructions();
+    auto& call = std::get<il::Call>(instructions[site.index]);
+
+    auto arguments = call.arguments();
+    const auto argument = arguments[parameter];
+    arguments.erase(arguments.begin() + static_cast<std::ptrdiff_t>(parameter));
+
+    instructions[site.index] = il::Call(call.result(), callee, std::move(arguments), call.span(), call.effects());
+
+    for (size_t index = site.index; index-- > 0;) {
+        auto* passed = std::get_if<il::Argument>(&instructions[index]);
+        if (!passed || il::Operand(passed->result()) != argument) continue;
+
+        instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(index));
+        break;
+    }
+}
+
+void IPCP::_remove_parameter(il::Function& function, const size_t parameter, const il::Immediate& value) {
+    auto& parameters = function.parameters();
+    const auto variable = parameters[parameter];
+    parameters.erase(parameters.begin() + static_cast<std::ptrdiff_t>(parameter));
+
+    auto& instructions = function.entry()->instructions();
+    instructions.insert(instructions.begin(), il::Assign(variable, value, std::nullopt));
+}
+
+il::Function& IPCP::_copy(il::Module& module, const std::string& original, const std::string& name) {
+    const auto find = [&](const std::string& target) -> il::Function& {
+        return *std::ranges::find(module, target, &il::Function::name);
+    };
+
+    {
+        auto& source = find(original);
+        module.emplace_back(
+            name, source.parameters(), source.type(), source.entry()->label(), source.exit()->label()
+        );
+    }
+
+    // Adding the copy moved the functions of the module, thus both are looked up again.
+    auto& source = find(original);
+    auto& copy = find(name);
+
+    std::unordered_map<il::BasicBlock*, il::BasicBlock*> blocks;
+    for (auto& block : source) {
+        auto* target = &block == source.entry() ? copy.entry()
+            : &block == source.exit() ? copy.exit()
+            : copy.emplace_back(block.label());
+
+        blocks.emplace(&block, target);
+    }
+
+    for (const auto& [block, target] : blocks) {
+        target->instructions().assign(block->instructions().begin(), block->instructions().end());
+        if (block->count()) target->set_count(*block->count());
+
+        for (auto& instruction : target->instructions()) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (!phi) continue;
+
+            // Values of blocks which aren't reachable anymore are dropped, same as by the inliner.
+            auto& incoming = phi->incoming();
+            std::erase_if(incoming, [&](const auto& pair) { return !blocks.contains(pair.first); });
+            for (auto& predecessor : incoming | std::views::keys) predecessor = blocks.at(predecessor);
+        }
+
+        if (block->next()) target->set_next(blocks.at(block->next()));
+        if (block->branch()) target->set_branch(blocks.at(block->branch()));
+    }
+
+    return copy;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,231 @@
+#include "arkoi_language/opt/licm.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_set>
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool LICM::enter_function(il::Function& function) {
+    _definitions.clear();
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            for (const auto& def : instruction.defs()) {
+                const auto* variable = std::get_if<il::Variable>(&def);
+                if (!variable) continue;
+
+                // Variables defined more than once are never treated as invariant.
+                const auto [it, inserted] = _definitions.try_emplace(*variable, &block);
+                if (!inserted) it->second = nullptr;
+            }
+        }
+    }
+
+    bool changed = false;
+    for (const auto& loop : analyses().get<il::LoopAnalysis>(function).loops()) {
+        bool created = false;
+        auto* preheader = _preheader(function, *loop, created);
+        if (!preheader) continue;
+
+        changed |= _hoist(*loop, *preheader) || created;
+
+        // The loops don't know about the new block, so they are recomputed in the next run.
+        if (created) break;
+    }
+
+    return changed;
+}
+
+il::BasicBlock* LICM::_preheader(il::Function& function, const il::Loop& loop, bool& created) {
+    auto* header = loop.header;
+
+    il::BasicBlock* outside = nullptr;
+    for (auto* predecessor : header->predecessors()) {
+        if (loop.contains(predecessor)) continue;
+        if (outside) return nullptr;
+
+        outside = predecessor;
+    }
+
+    if (!outside) return nullptr;
+    if (!outside->branch() || !outside->next()) return outside;
+    if (outside->branch() == outside->next()) return nullptr;
+
+    // The predecessor also leaves to another block, thus the edge to the header is split.
+    auto* preheader = function.emplace_back(header->label() + ".pre");
+    created = true;
+
+    auto& terminator = outside->instructions().back();
+    const auto redirect = [&](const std::string& label) { return label == header->label() ? preheader->label() : label; };
+    if (auto* _if = std::get_if<il::If>(&terminator)) {
+        terminator = il::If(_if->condition(), redirect(_if->next()), redirect(_if->branch()), _if->span());
+    }
+
+    if (outside->next() == header) outside->set_next(preheader);
+    if (outside->branch() == header) outside->set_branch(preheader);
+
+    preheader->emplace_back<il::Goto>(header->label(), std::nullopt);
+    preheader->set_next(header);
+
+    for (auto& instruction : *header) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (phi) phi->replace_predecessor(outside, preheader);
+    }
+
+    return preheader;
+}
+
+bool LICM::_hoist(const il::Loop& loop, il::BasicBlock& preheader) {
+    auto& target = preheader.instructions();
+
+    // Jumps stay at the end of the preheader.
+    auto position = target.size();
+    if (!target.empty() && (std::holds_alternative<il::Goto>(target.back()) || std::holds_alternative<il::If>(target.back()))) {
+        position--;
+    }
+
+    bool changed = false;
+    for (auto* block : loop.blocks) {
+        auto& instructions = block->instructions();
+
+        for (size_t index = 0; index < instructions.size();) {
+            auto& instruction = instructions[index];
+            if (std::holds_alternative<il::Call>(instruction)) {
+                if (_hoist_call(loop, *block, index, preheader, position)) {
+                    changed = true;
+                } else {
+                    index++;
+                }
+
+                continue;
+            }
+
+            if (!_is_hoistable(instruction)) {
+                index++;
+                continue;
+            }
+
+            const auto& uses = instruction.uses();
+            const auto is_invariant = [&](const auto& operand) { return _is_invariant(loop, operand); };
+            if (!std::ranges::all_of(uses, is_invariant)) {
+                index++;
+                continue;
+            }
+
+            const auto result = std::get<il::Variable>(instruction.defs().front());
+            auto definition = _definitions.find(result);
+            if (definition == _definitions.end() || definition->second != block) {
+                index++;
+                continue;
+            }
+
+            target.insert(target.begin() + static_cast<std::ptrdiff_t>(position++), std::move(instruction));
+            instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(index));
+
+            definition->second = &preheader;
+            count("hoisted-instructions");
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+bool LICM::_hoist_call(
+    const il::Loop& loop, il::BasicBlock& block, size_t& index, il::BasicBlock& preheader, size_t& position
+) {
+    auto& instructions = block.instructions();
+    auto& call = std::get<il::Call>(instructions[index]);
+    if (call.effects() != il::Call::Effects::Speculatable) return false;
+
+    const auto definition = _definitions.find(call.result());
+    if (definition == _definitions.end() || definition->second != &block) return false;
+
+    // The arguments are passed right in front of the call, thus they are moved together with it.
+    std::vector<size_t> moved;
+    for (const auto& operand : call.arguments()) {
+        std::optional<size_t> found;
+        for (size_t current = index; current-- > 0;) {
+            auto* argument = std::get_if<il::Argument>(&instructions[current]);
+            if (!argument || il::Operand(argument->result()) != operand) continue;
+
+            if (_is_invariant(loop, argument->source())) found = current;
+            break;
+        }
+
+        if (!found) return false;
+        moved.push_back(*found);
+    }
+
+    std::ranges::sort(moved);
+    moved.push_back(index);
+
+    auto& target = preheader.instructions();
+    for (const auto current : moved) {
+        for (const auto& def : instructions[current].defs()) _definitions[std::get<il::Variable>(def)] = &preheader;
+        target.insert(target.begin() + static_cast<std::ptrdiff_t>(position++), std::move(instructions[current]));
+    }
+
+    for (const auto current : std::views::reverse(moved)) {
+        instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(current));
+    }
+
+    // The call and all of its arguments were in front of the next instruction.
+    index = index + 1 - moved.size();
+
+    count("hoisted-calls");
+    return true;
+}
+
+bool LICM::_is_invariant(const il::Loop& loop, const il::Operand& operand) const {
+    if (std::holds_alternative<il::Immediate>(operand)) return true;
+
+    const auto* variable = std::get_if<il::Variable>(&operand);
+    if (!variable) return false;
+
+    // Parameters don't have a definition inside the function.
+    const auto definition = _definitions.find(*variable);
+    if (definition == _definitions.end()) return true;
+
+    return definition->second && !loop.contains(definition->second);
+}
+
+bool LICM::_is_hoistable(il::Instruction& instruction) {
+    if (std::holds_alternative<il::Cast>(instruction)) return true;
+
+    // The instructions are executed even if the loop isn't, thus they must not trap.
+    const auto* binary = std::get_if<il::Binary>(&instruction);
+    return binary && !binary->may_trap();
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
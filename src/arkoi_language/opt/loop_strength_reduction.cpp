@@ -0,0 +1,143 @@
+#include "arkoi_language/opt/loop_strength_reduction.hpp"
+
+#include <algorithm>
+#include <map>
+
+#include "arkoi_language/opt/constant_folding.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool LoopStrengthReduction::enter_function(il::Function& function) {
+    auto& analysis = analyses().get<il::InductionAnalysis>(function);
+
+    bool changed = false;
+    for (const auto& loop : analysis.loops().loops()) {
+        for (const auto& induction : analysis.inductions(*loop)) {
+            if (!_reduce(*loop, induction)) continue;
+
+            count("reduced-inductions");
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+bool LoopStrengthReduction::_reduce(const il::Loop& loop, const il::InductionVariable& induction) {
+    using Operator = il::Binary::Operator;
+
+    const auto& type = induction.variable.type();
+    const auto immediate = [&](const uint64_t value) { return ConstantFolding::evaluate_cast(type, value); };
+
+    // The multiplications are first rewritten in place, as cached analyses point into the blocks.
+    std::map<uint64_t, il::Variable> reduced;
+    for (auto* block : loop.blocks) {
+        for (auto& instruction : *block) {
+            const auto factor = _factor(instruction, induction);
+            if (!factor) continue;
+
+            const auto binary = std::get<il::Binary>(instruction);
+            const auto& result = binary.result();
+            const auto [it, inserted] = reduced.try_emplace(*factor, il::Variable(result.name() + ".iv", type, result.version()));
+            instruction = il::Assign(result, it->second, binary.span());
+        }
+    }
+
+    for (const auto& [factor, variable] : reduced) {
+        const il::Variable initial(variable.name() + ".init", type, variable.version());
+        const il::Variable next(variable.name() + ".next", type, variable.version());
+
+        if (std::holds_alternative<il::Immediate>(induction.initial)) {
+            const auto value = ConstantFolding::evaluate_cast(sem::Integral(Size::QWORD, false), std::get<il::Immediate>(induction.initial));
+            _insert_before_terminator(*induction.entry, il::Assign(initial, immediate(std::get<uint64_t>(value) * factor), std::nullopt));
+        } else {
+            _insert_before_terminator(*induction.entry, il::Binary(initial, induction.initial, Operator::Mul, immediate(factor), type, std::nullopt));
+        }
+
+        auto& header = loop.header->instructions();
+        header.insert(header.begin(), il::Phi(variable, { { induction.entry, initial }, { induction.latch, next } }, std::nullopt));
+
+        // The new induction variable is incremented right after the original one.
+        auto& instructions = induction.increment->instructions();
+        const auto update = std::ranges::find_if(instructions, [&](const auto& instruction) {
+            const auto& defs = instruction.defs();
+            return !defs.empty() && defs.front() == il::Operand(induction.update);
+        });
+
+        const auto step = static_cast<uint64_t>(induction.step) * factor;
+        instructions.insert(update + 1, il::Binary(next, variable, Operator::Add, immediate(step), type, std::nullopt));
+    }
+
+    return !reduced.empty();
+}
+
+std::optional<uint64_t> LoopStrengthReduction::_factor(il::Instruction& instruction, const il::InductionVariable& induction) {
+    auto* binary = std::get_if<il::Binary>(&instruction);
+    if (!binary || binary->op_type() != induction.variable.type()) return std::nullopt;
+
+    const il::Operand current = induction.variable;
+    const auto constant = [](const il::Operand& operand) -> std::optional<uint64_t> {
+        const auto* immediate = std::get_if<il::Immediate>(&operand);
+        if (!immediate) return std::nullopt;
+
+        const auto value = ConstantFolding::evaluate_cast(sem::Integral(Size::QWORD, false), *immediate);
+        return std::get<uint64_t>(value);
+    };
+
+    if (binary->op() == il::Binary::Operator::Mul) {
+        if (binary->left() == current) return constant(binary->right());
+        if (binary->right() == current) return constant(binary->left());
+    }
+
+    if (binary->op() == il::Binary::Operator::Shl && binary->left() == current) {
+        const auto integral = induction.variable.type().integral().value();
+        const auto amount = constant(binary->right());
+        if (amount && *amount < size_to_bytes(integral.size()) * 8) return uint64_t{ 1 } << *amount;
+    }
+
+    return std::nullopt;
+}
+
+void LoopStrengthReduction::_insert_before_terminator(il::BasicBlock& block, il::Instruction instruction) {
+    auto& instructions = block.instructions();
+
+    auto position = instructions.end();
+    if (!instructions.empty() && (std::holds_alternative<il::Goto>(instructions.back()) || std::holds_alternative<il::If>(instructions.back()))) {
+        position--;
+    }
+
+    instructions.insert(position, std::move(instruction));
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,422 @@
+#include "arkoi_language/opt/loop_unroll.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <ranges>
+
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool LoopUnroll::enter_function(il::Function& function) {
+    const auto& analysis = analyses().get<il::InductionAnalysis>(function);
+
+    for (const auto& loop : analysis.loops().loops()) {
+        const auto* counted = analysis.counted(*loop);
+        if (!counted || !counted->trip_count) continue;
+
+        // A loop the profile never saw running isn't worth the code growth.
+        const auto& header_count = loop->header->count();
+        if (header_count && *header_count == 0) {
+            count("cold-loops");
+            continue;
+        }
+
+        Shape shape;
+        if (!_is_unrollable(function, analysis, *loop, shape)) continue;
+
+        const auto trip_count = *counted->trip_count;
+        const auto cost = std::max<size_t>(_cost(*loop), 1);
+        if (trip_count <= _full_threshold / cost) {
+            _unroll_fully(function, *loop, shape, trip_count);
+            count("fully-unrolled-loops");
+            return true;
+        }
+
+        for (size_t factor = MAX_FACTOR; factor >= 2; factor--) {
+            if (trip_count % factor != 0 || cost * factor > _partial_threshold) continue;
+
+            _unroll_partially(function, *loop, shape, factor);
+            count("partially-unrolled-loops");
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool LoopUnroll::_is_unrollable(
+    il::Function& function, const il::InductionAnalysis& analysis, const il::Loop& loop, Shape& shape
+) {
+    const auto is_nested = [&](const auto& other) { return other->parent == &loop; };
+    if (std::ranges::any_of(analysis.loops().loops(), is_nested)) return false;
+
+    auto* header = loop.header;
+    if (loop.latches.size() != 1 || header->predecessors().size() != 2) return false;
+
+    // The back edge must be a plain jump, which is redirected to the next copy.
+    auto* latch = loop.latches.front();
+    if (latch == header || latch->branch() || latch->next() != header) return false;
+    if (latch->instructions().empty() || !std::holds_alternative<il::Goto>(latch->instructions().back())) return false;
+
+    for (auto* predecessor : header->predecessors()) {
+        if (!loop.contains(predecessor)) shape.entry = predecessor;
+    }
+
+    if (header->instructions().empty() || !std::holds_alternative<il::If>(header->instructions().back())) return false;
+    if (!header->next() || !header->branch()) return false;
+
+    shape.latch = latch;
+    shape.body = loop.contains(header->branch()) ? header->branch() : header->next();
+    shape.exit = loop.contains(header->branch()) ? header->next() : header->branch();
+    if (!shape.entry || shape.body == header || loop.contains(shape.exit)) return false;
+
+    // The header is the only way out of the loop.
+    for (auto* block : loop.blocks) {
+        if (block == header) continue;
+
+        for (auto* successor : { block->next(), block->branch() }) {
+            if (successor && !loop.contains(successor)) return false;
+        }
+    }
+
+    // Copies rename the variables of the loop, which requires a single definition of each.
+    std::unordered_map<il::Variable, size_t> definitions;
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            for (const auto& def : instruction.defs()) {
+                if (const auto* variable = std::get_if<il::Variable>(&def)) definitions[*variable]++;
+            }
+        }
+    }
+
+    for (auto* block : loop.blocks) {
+        for (auto& instruction : *block) {
+            if (std::holds_alternative<il::Alloca>(instruction)) return false;
+
+            for (const auto& def : instruction.defs()) {
+                const auto* variable = std::get_if<il::Variable>(&def);
+                if (variable && definitions[*variable] != 1) return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t LoopUnroll::_cost(const il::Loop& loop) {
+    size_t cost = 0;
+    for (auto* block : loop.blocks) {
+        for (const auto& instruction : *block) {
+            if (std::holds_alternative<il::Phi>(instruction) || std::holds_alternative<il::Goto>(instruction)) continue;
+            cost++;
+        }
+    }
+
+    return cost;
+}
+
+void LoopUnroll::_unroll_fully(il::Function& function, const il::Loop& loop, const Shape& shape, const uint64_t trip_count) {
+    auto* header = loop.header;
+
+    std::unordered_map<il::Variable, il::Operand> values;
+    for (auto& instruction : *header) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (phi) values.insert_or_assign(phi->result(), *phi->incoming_from(shape.entry));
+    }
+
+    il::BasicBlock* first = nullptr;
+    il::BasicBlock* previous = nullptr;
+    for (uint64_t iteration = 0; iteration < trip_count; iteration++) {
+        const auto copy = _copy(function, loop, shape, values);
+
+        auto* copied_header = copy.blocks.at(header);
+        if (previous) _jump(*previous, *copied_header);
+        else first = copied_header;
+        previous = copy.blocks.at(shape.latch);
+
+        for (auto& instruction : *header) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi) values.insert_or_assign(phi->result(), _rename(*phi->incoming_from(shape.latch), copy));
+        }
+    }
+
+    if (first) {
+        auto& instructions = shape.entry->instructions();
+        const auto redirect = [&](const std::string& label) { return label == header->label() ? first->label() : label; };
+
+        if (!instructions.empty()) {
+            auto& terminator = instructions.back();
+            if (auto* _if = std::get_if<il::If>(&terminator)) {
+                terminator = il::If(_if->condition(), redirect(_if->next()), redirect(_if->branch()), _if->span());
+            } else if (auto* _goto = std::get_if<il::Goto>(&terminator)) {
+                terminator = il::Goto(redirect(_goto->label()), _goto->span());
+            }
+        }
+
+        if (shape.entry->next() == header) shape.entry->set_next(first);
+        if (shape.entry->branch() == header) shape.entry->set_branch(first);
+
+        _jump(*previous, *header);
+    }
+
+    // The original header is executed a last time to leave the loop, as its definitions are used afterward.
+    for (auto& instruction : *header) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (phi) instruction = il::Assign(phi->result(), values.at(phi->result()), phi->span());
+    }
+    _jump(*header, *shape.exit);
+
+    std::vector<il::BasicBlock*> body;
+    for (auto* block : loop.blocks) {
+        if (block == header) continue;
+
+        block->set_next(nullptr);
+        block->set_branch(nullptr);
+        body.push_back(block);
+    }
+
+    for (auto* block : body) {
+        [[maybe_unused]] const auto removed = function.remove(block);
+        assert(removed);
+    }
+}
+
+void LoopUnroll::_unroll_partially(il::Function& function, const il::Loop& loop, const Shape& shape, const size_t factor) {
+    auto* header = loop.header;
+
+    std::unordered_map<il::Variable, il::Operand> values;
+    for (auto& instruction : *header) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (phi) values.insert_or_assign(phi->result(), *phi->incoming_from(shape.latch));
+    }
+
+    auto* previous = shape.latch;
+    for (size_t iteration = 1; iteration < factor; iteration++) {
+        const auto copy = _copy(function, loop, shape, values);
+
+        _jump(*previous, *copy.blocks.at(header));
+        previous = copy.blocks.at(shape.latch);
+
+        for (auto& instruction : *header) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi) values.insert_or_assign(phi->result(), _rename(*phi->incoming_from(shape.latch), copy));
+        }
+    }
+
+    _jump(*previous, *header);
+
+    // The back edge now comes from the latch of the last copy.
+    for (auto& instruction : *header) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (!phi) continue;
+
+        phi->replace_predecessor(shape.latch, previous);
+        phi->set_incoming(previous, std::get<il::Variable>(values.at(phi->result())));
+    }
+}
+
+LoopUnroll::Copy LoopUnroll::_copy(
+    il::Function& function, const il::Loop& loop, const Shape& shape,
+    const std::unordered_map<il::Variable, il::Operand>& values
+) {
+    const auto suffix = _suffix(function);
+
+    Copy copy;
+    for (auto* block : loop.blocks) {
+        auto* cloned = function.emplace_back(block->label() + suffix);
+        copy.blocks.emplace(block, cloned);
+        copy.labels.emplace(block->label(), cloned->label());
+
+        for (auto& instruction : *block) {
+            for (const auto& def : instruction.defs()) {
+                const auto* variable = std::get_if<il::Variable>(&def);
+                if (!variable) continue;
+
+                copy.variables.emplace(*variable, il::Variable(variable->name() + suffix, variable->type(), variable->version()));
+            }
+        }
+    }
+
+    for (auto* block : loop.blocks) {
+        auto* cloned = copy.blocks.at(block);
+
+        for (auto& instruction : *block) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi && block == loop.header) {
+                const auto result = std::get<il::Variable>(_rename(phi->result(), copy));
+                cloned->emplace_back<il::Assign>(result, values.at(phi->result()), phi->span());
+                continue;
+            }
+
+            cloned->instructions().push_back(_clone(instruction, copy));
+        }
+
+        // The copied header always continues with the body, the back edge of the latch is linked by the caller.
+        if (block == loop.header) {
+            _jump(*cloned, *copy.blocks.at(shape.body));
+            continue;
+        }
+
+        if (block == shape.latch) continue;
+
+        if (block->next()) cloned->set_next(copy.blocks.at(block->next()));
+        if (block->branch()) cloned->set_branch(copy.blocks.at(block->branch()));
+    }
+
+    return copy;
+}
+
+il::Instruction LoopUnroll::_clone(const il::Instruction& instruction, const Copy& copy) {
+    const auto label = [&](const std::string& name) {
+        const auto found = copy.labels.find(name);
+        return found == copy.labels.end() ? name : found->second;
+    };
+    const auto operand = [&](const il::Operand& value) { return _rename(value, copy); };
+    const auto variable = [&](const il::Variable& value) { return std::get<il::Variable>(_rename(value, copy)); };
+
+    auto cloned = instruction;
+    return std::visit(
+        match{
+            [&](il::Goto& goto_) -> il::Instruction {
+                return il::Goto(label(goto_.label()), goto_.span());
+            },
+            [&](il::If& if_) -> il::Instruction {
+                return il::If(operand(if_.condition()), label(if_.next()), label(if_.branch()), if_.span());
+            },
+            [&](il::Cast& cast) -> il::Instruction {
+                return il::Cast(variable(cast.result()), operand(cast.source()), cast.from(), cast.span());
+            },
+            [&](il::Call& call) -> il::Instruction {
+                std::vector<il::Operand> arguments;
+                for (const auto& argument : call.arguments()) arguments.push_back(operand(argument));
+                return il::Call(
+                    variable(call.result()), call.name(), std::move(arguments), call.span(), call.effects()
+                );
+            },
+            [&](il::Return& return_) -> il::Instruction {
+                return il::Return(operand(return_.value()), return_.span());
+            },
+            [&](il::Binary& binary) -> il::Instruction {
+                return il::Binary(
+                    variable(binary.result()), operand(binary.left()), binary.op(), operand(binary.right()),
+                    binary.op_type(), binary.span()
+                );
+            },
+            [&](il::Alloca& alloca) -> il::Instruction {
+                return alloca;
+            },
+            [&](il::Store& store) -> il::Instruction {
+                return il::Store(store.result(), operand(store.source()), store.span());
+            },
+            [&](il::Load& load) -> il::Instruction {
+                return il::Load(variable(load.result()), load.source(), load.span());
+            },
+            [&](il::Argument& argument) -> il::Instruction {
+                return il::Argument(variable(argument.result()), operand(argument.source()), argument.span());
+            },
+            [&](il::Phi& phi) -> il::Instruction {
+                il::Phi::Incoming incoming;
+                for (const auto& [predecessor, value] : phi.incoming()) {
+                    incoming.emplace_back(copy.blocks.at(predecessor), variable(value));
+                }
+                return il::Phi(variable(phi.result()), std::move(incoming), phi.span());
+            },
+            [&](il::Assign& assign) -> il::Instruction {
+                return il::Assign(variable(assign.result()), operand(assign.value()), assign.span());
+            },
+            [&](il::Select& select) -> il::Instruction {
+                return il::Select(
+                    variable(select.result()), operand(select.condition()), operand(select.true_value()),
+                    operand(select.false_value()), select.span()
+                );
+            },
+        },
+        cloned
+    );
+}
+
+il::Operand LoopUnroll::_rename(const il::Operand& operand, const Copy& copy) {
+    const auto* variable = std::get_if<il::Variable>(&operand);
+    if (!variable) return operand;
+
+    // Variables defined outside the loop are shared by all copies.
+    const auto found = copy.variables.find(*variable);
+    return found == copy.variables.end() ? operand : il::Operand(found->second);
+}
+
+void LoopUnroll::_jump(il::BasicBlock& block, il::BasicBlock& target) {
+    auto& instructions = block.instructions();
+
+    std::optional<pretty_diagnostics::Span> span;
+    if (!instructions.empty()) {
+        auto& last = instructions.back();
+        if (auto* _if = std::get_if<il::If>(&last)) span = _if->span();
+        if (auto* _goto = std::get_if<il::Goto>(&last)) span = _goto->span();
+        if (std::holds_alternative<il::If>(last) || std::holds_alternative<il::Goto>(last)) instructions.pop_back();
+    }
+
+    block.emplace_back<il::Goto>(target.label(), span);
+    block.set_branch(nullptr);
+    block.set_next(&target);
+}
+
+std::string LoopUnroll::_suffix(il::Function& function) {
+    size_t next = 0;
+    const auto scan = [&](const std::string_view name) {
+        for (auto position = name.find(".u"); position != std::string_view::npos; position = name.find(".u", position + 1)) {
+            size_t end = position + 2, value = 0;
+            while (end < name.size() && std::isdigit(static_cast<unsigned char>(name[end]))) {
+                value = value * 10 + static_cast<size_t>(name[end++] - '0');
+            }
+
+            if (end != position + 2) next = std::max(next, value + 1);
+        }
+    };
+
+    // Copied variables may outlive their blocks, e.g. when blocks are merged, thus both are checked.
+    for (const auto& label : function.block_pool() | std::views::keys) scan(label);
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            for (const auto& def : instruction.defs()) {
+                if (const auto* variable = std::get_if<il::Variable>(&def)) scan(variable->name());
+            }
+        }
+    }
+
+    return ".u" + std::to_string(next);
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
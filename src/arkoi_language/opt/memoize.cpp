@@ -0,0 +1,64 @@
+#include "arkoi_language/opt/memoize.hpp"
+
+#include "arkoi_language/il/call_graph.hpp"
+#include "arkoi_language/il/effect_analysis.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool Memoize::enter_module(il::Module& module) {
+    const il::CallGraph graph(module);
+    const il::EffectAnalysis analysis(module);
+
+    bool changed = false;
+    for (auto& function : module) {
+        if (function.is_memoized() || function.name() == "main") continue;
+
+        // The argument is the index into the cache, thus there must be exactly one integer.
+        const auto& parameters = function.parameters();
+        if (parameters.size() != 1 || !parameters.front().type().is_integral()) continue;
+
+        // Without recursion every call is a separate computation, which a cache doesn't speed up.
+        if (!graph.is_recursive(function.name())) continue;
+
+        // Skipping the body must not skip anything besides computing the result.
+        if (analysis.effects(function.name()) == il::Call::Effects::Unknown) continue;
+
+        function.set_memoized(true);
+        count("memoized-functions");
+        changed = true;
+    }
+
+    return changed;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
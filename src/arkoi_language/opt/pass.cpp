@@ -1,24 +1,46 @@
 #include "arkoi_language/opt/pass.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 using namespace arkoi::opt;
+using namespace arkoi;
+
+il::AnalysisManager& Pass::analyses() const {
+    assert(_analyses != nullptr);
+    return *_analyses;
+}
+
+void Pass::count(const std::string_view counter, const size_t amount) const {
+    if (_statistics) _statistics->add(name(), counter, amount);
+}
+
+PassManager::PassManager() :
+    _analyses(std::make_shared<il::AnalysisManager>()) { }
+
+PassManager::PassManager(std::shared_ptr<il::AnalysisManager> analyses) :
+    _analyses(std::move(analyses)) { }
+
+void PassManager::set_statistics(utils::Statistics* statistics) {
+    _statistics = statistics;
+    for (const auto& pass : _passes) pass->_statistics = statistics;
+}
 
 void PassManager::run(il::Module& module) const {
     while (true) {
         bool changed = false;
 
         for (const auto& pass : _passes) {
+            const utils::TimeReport::Timer timer(_report, pass->name());
             changed |= pass->enter_module(module);
+        }
 
-            for (auto& function : module) {
-                changed |= pass->enter_function(function);
-
-                for (auto& block : function) {
-                    changed |= pass->on_block(block);
-                }
-
-                changed |= pass->exit_function(function);
-            }
+        for (auto& function : module) {
+            run(function);
+        }
 
+        for (const auto& pass : _passes) {
+            const utils::TimeReport::Timer timer(_report, pass->name());
             changed |= pass->exit_module(module);
         }
 
@@ -26,6 +48,54 @@ void PassManager::run(il::Module& module) const {
     }
 }
 
+void PassManager::run(il::Function& function) const {
+    // Every pass needs to run at least once, afterward only the passes triggered by a change.
+    std::vector pending(_passes.size(), true);
+
+    size_t rounds = 0, runs = 0;
+    while (std::ranges::find(pending, true) != pending.end()) {
+        rounds++;
+
+        for (size_t index = 0; index < _passes.size(); index++) {
+            if (!pending[index]) continue;
+            pending[index] = false;
+
+            const auto& pass = _passes[index];
+            runs++;
+            if (!_run(*pass, function)) continue;
+
+            const auto preserved = (pass->effects() & Pass::CHANGED_BLOCKS)
+                ? il::AnalysisManager::Preserved::Nothing
+                : il::AnalysisManager::Preserved::ControlFlow;
+            _analyses->invalidate(function, preserved);
+
+            for (size_t other = 0; other < _passes.size(); other++) {
+                if (_passes[other]->triggers() & pass->effects()) pending[other] = true;
+            }
+        }
+    }
+
+    if (_statistics) {
+        _statistics->add("pass-manager", "functions");
+        _statistics->add("pass-manager", "rounds", rounds);
+        _statistics->add("pass-manager", "pass-runs", runs);
+    }
+}
+
+bool PassManager::_run(Pass& pass, il::Function& function) const {
+    const utils::TimeReport::Timer timer(_report, pass.name());
+
+    bool changed = pass.enter_function(function);
+
+    for (auto& block : function) {
+        changed |= pass.on_block(block);
+    }
+
+    changed |= pass.exit_function(function);
+
+    return changed;
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
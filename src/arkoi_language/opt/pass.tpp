@@ -2,7 +2,9 @@
 
 template <typename Type, typename... Args>
 void PassManager::add(Args&&... args) {
-    _passes.push_back(std::make_unique<Type>(std::forward<Args>(args)...));
+    auto& pass = _passes.emplace_back(std::make_unique<Type>(std::forward<Args>(args)...));
+    pass->_analyses = _analyses.get();
+    pass->_statistics = _statistics;
 }
 
 //==============================================================================
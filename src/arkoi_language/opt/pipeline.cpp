@@ -0,0 +1,228 @@
+#include "arkoi_language/opt/pipeline.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "arkoi_language/opt/constant_folding.hpp"
+#include "arkoi_language/opt/constant_propagation.hpp"
+#include "arkoi_language/opt/copy_propagation.hpp"
+#include "arkoi_language/opt/ctfe.hpp"
+#include "arkoi_language/opt/dead_code_elimination.hpp"
+#include "arkoi_language/opt/dead_function_elimination.hpp"
+#include "arkoi_language/opt/gvn.hpp"
+#include "arkoi_language/opt/if_conversion.hpp"
+#include "arkoi_language/opt/inliner.hpp"
+#include "arkoi_language/opt/instruction_combining.hpp"
+#include "arkoi_language/opt/ipcp.hpp"
+#include "arkoi_language/opt/licm.hpp"
+#include "arkoi_language/opt/loop_strength_reduction.hpp"
+#include "arkoi_language/opt/loop_unroll.hpp"
+#include "arkoi_language/opt/memoize.hpp"
+#include "arkoi_language/opt/sccp.hpp"
+#include "arkoi_language/opt/simplify_cfg.hpp"
+#include "arkoi_language/opt/slp_vectorizer.hpp"
+#include "arkoi_language/opt/store_forwarding.hpp"
+#include "arkoi_language/opt/tail_recursion.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+/**
+ * @brief The level of the passes that are only run if requested, which is above every preset.
+ */
+static constexpr uint8_t OPT_IN = UINT8_MAX;
+
+/**
+ * @brief A function pass that can be part of a pipeline.
+ */
+struct FunctionPass {
+    /// The name of the pass, which is the same as returned by `Pass::name`.
+    std::string_view name;
+    /// The first optimization level the pass is part of.
+    uint8_t level;
+    /// Adds a new instance of the pass to the manager.
+    void (*add)(PassManager& manager);
+};
+
+/**
+ * @brief All function passes, in the order they are run by the presets.
+ */
+static const std::vector<FunctionPass> FUNCTION_PASSES{
+    { "sccp", 2, [](PassManager& manager) { manager.add<SCCP>(); } },
+    { "constant-folding", 1, [](PassManager& manager) { manager.add<ConstantFolding>(); } },
+    { "instruction-combining", 1, [](PassManager& manager) { manager.add<InstructionCombining>(); } },
+    { "constant-propagation", 1, [](PassManager& manager) { manager.add<ConstantPropagation>(); } },
+    { "copy-propagation", 1, [](PassManager& manager) { manager.add<CopyPropagation>(); } },
+    { "gvn", 2, [](PassManager& manager) { manager.add<GVN>(); } },
+    { "store-forwarding", 1, [](PassManager& manager) { manager.add<StoreForwarding>(); } },
+    { "dead-code-elimination", 1, [](PassManager& manager) { manager.add<DeadCodeElimination>(); } },
+    { "simplify-cfg", 1, [](PassManager& manager) { manager.add<SimplifyCFG>(); } },
+    { "if-conversion", 2, [](PassManager& manager) { manager.add<IfConversion>(); } },
+    { "tail-recursion", 2, [](PassManager& manager) { manager.add<TailRecursion>(); } },
+    { "licm", 3, [](PassManager& manager) { manager.add<LICM>(); } },
+    { "loop-unroll", 3, [](PassManager& manager) { manager.add<LoopUnroll>(); } },
+    { "loop-strength-reduction", 3, [](PassManager& manager) { manager.add<LoopStrengthReduction>(); } },
+    { "slp-vectorizer", 3, [](PassManager& manager) { manager.add<SLPVectorizer>(); } },
+};
+
+/**
+ * @brief A pass that is run on the whole module.
+ */
+struct ModulePass {
+    /// The name of the pass, which is the same as returned by `Pass::name`.
+    std::string_view name;
+    /// The first optimization level the pass is part of, or `OPT_IN` if no preset runs it.
+    uint8_t level;
+    /// If the pass changes the signature of functions, which is only possible if the module is the whole program.
+    bool whole_program;
+    /// Adds a new instance of the pass to the manager.
+    void (*add)(PassManager& manager, const Pipeline::ExternalCalls& external_calls);
+};
+
+/**
+ * @brief All module passes, in the order they are run by the presets.
+ */
+static const std::vector<ModulePass> MODULE_PASSES{
+    { "ctfe", 2, false, [](PassManager& manager, const Pipeline::ExternalCalls&) {
+        manager.add<CTFE>();
+    } },
+    { "ipcp", 2, true, [](PassManager& manager, const Pipeline::ExternalCalls& external_calls) {
+        manager.add<IPCP>(external_calls);
+    } },
+    { "inliner", 2, false, [](PassManager& manager, const Pipeline::ExternalCalls& external_calls) {
+        manager.add<Inliner>(Inliner::DEFAULT_THRESHOLD, Inliner::DEFAULT_SINGLE_CALL_THRESHOLD, external_calls);
+    } },
+    { "dead-function-elimination", 2, false, [](PassManager& manager, const Pipeline::ExternalCalls& external_calls) {
+        manager.add<DeadFunctionElimination>(external_calls);
+    } },
+    { "memoize", OPT_IN, false, [](PassManager& manager, const Pipeline::ExternalCalls&) {
+        manager.add<Memoize>();
+    } },
+};
+
+static std::string_view trim(std::string_view text) {
+    const auto start = text.find_first_not_of(" \t");
+    if (start == std::string_view::npos) return { };
+
+    const auto end = text.find_last_not_of(" \t");
+    return text.substr(start, end - start + 1);
+}
+
+static const FunctionPass* find_function_pass(const std::string_view name) {
+    const auto found = std::ranges::find(FUNCTION_PASSES, name, &FunctionPass::name);
+    return found == FUNCTION_PASSES.end() ? nullptr : &*found;
+}
+
+static const ModulePass* find_module_pass(const std::string_view name) {
+    const auto found = std::ranges::find(MODULE_PASSES, name, &ModulePass::name);
+    return found == MODULE_PASSES.end() ? nullptr : &*found;
+}
+
+Pipeline Pipeline::level(uint8_t level) {
+    level = std::min(level, MAX_LEVEL);
+
+    Pipeline pipeline;
+    for (const auto& pass : FUNCTION_PASSES) {
+        if (pass.level <= level) pipeline._passes.emplace_back(pass.name);
+    }
+
+    for (const auto& pass : MODULE_PASSES) {
+        if (pass.level <= level) pipeline._passes.emplace_back(pass.name);
+    }
+
+    return pipeline;
+}
+
+Pipeline Pipeline::parse(const std::string_view description) {
+    Pipeline pipeline;
+
+    if (trim(description).empty()) return pipeline;
+
+    size_t start = 0;
+    while (true) {
+        const auto end = description.find(',', start);
+        const auto name = trim(description.substr(start, end == std::string_view::npos ? end : end - start));
+
+        pipeline.append(name);
+
+        if (end == std::string_view::npos) break;
+        start = end + 1;
+    }
+
+    return pipeline;
+}
+
+std::vector<std::string_view> Pipeline::available() {
+    std::vector<std::string_view> names;
+    for (const auto& pass : FUNCTION_PASSES) names.push_back(pass.name);
+    for (const auto& pass : MODULE_PASSES) names.push_back(pass.name);
+    return names;
+}
+
+void Pipeline::append(const std::string_view name) {
+    if (!find_function_pass(name) && !find_module_pass(name)) {
+        throw std::invalid_argument("The pass \"" + std::string(name) + "\" doesn't exist.");
+    }
+
+    _passes.emplace_back(name);
+}
+
+void Pipeline::add_function_passes(PassManager& manager) const {
+    for (const auto& name : _passes) {
+        if (const auto* pass = find_function_pass(name)) pass->add(manager);
+    }
+}
+
+void Pipeline::add_module_passes(
+    PassManager& manager, const ExternalCalls& external_calls, const bool whole_program
+) const {
+    for (const auto& name : _passes) {
+        const auto* pass = find_module_pass(name);
+        if (pass && (whole_program || !pass->whole_program)) pass->add(manager, external_calls);
+    }
+}
+
+bool Pipeline::has_module_passes() const {
+    return std::ranges::any_of(_passes, [](const auto& name) { return find_module_pass(name) != nullptr; });
+}
+
+std::string Pipeline::describe() const {
+    std::string description;
+    for (const auto& name : _passes) {
+        if (!description.empty()) description += ",";
+        description += name;
+    }
+
+    return description;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,319 @@
+#include "arkoi_language/opt/sccp.hpp"
+
+#include <cassert>
+
+#include "arkoi_language/opt/constant_folding.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool SCCP::enter_function(il::Function& function) {
+    _chains = &analyses().get<il::DefUseChains>(function);
+
+    _solve(function);
+    const auto changed = _rewrite(function);
+
+    _values.clear();
+    _executable.clear();
+    _edges.clear();
+    _chains = nullptr;
+
+    return changed;
+}
+
+void SCCP::_solve(il::Function& function) {
+    _mark_edge(nullptr, function.entry());
+
+    while (!_edge_worklist.empty() || !_ssa_worklist.empty()) {
+        while (!_edge_worklist.empty()) {
+            const auto [from, to] = _edge_worklist.back();
+            _edge_worklist.pop_back();
+
+            // Reaching an already executable block only changes the values of its phis.
+            if (!_executable.insert(to).second) {
+                for (auto& instruction : *to) {
+                    if (std::holds_alternative<il::Phi>(instruction)) _visit(instruction, *to);
+                }
+
+                continue;
+            }
+
+            for (auto& instruction : *to) _visit(instruction, *to);
+
+            // Conditional terminators mark their edges as part of the visit.
+            if (to->instructions().empty() || !std::holds_alternative<il::If>(to->instructions().back())) {
+                _visit_successors(*to);
+            }
+        }
+
+        while (!_ssa_worklist.empty()) {
+            auto* instruction = _ssa_worklist.back();
+            _ssa_worklist.pop_back();
+
+            auto* block = _chains->block(instruction);
+            if (_executable.contains(block)) _visit(*instruction, *block);
+        }
+    }
+}
+
+void SCCP::_visit(il::Instruction& instruction, il::BasicBlock& block) {
+    using Kind = Value::Kind;
+
+    std::visit(
+        match{
+            [&](il::Phi& phi) {
+                Value value;
+                for (const auto& [predecessor, incoming] : phi.incoming()) {
+                    if (!_edges.contains({ predecessor, &block })) continue;
+                    value = _meet(value, _value(incoming));
+                }
+
+                _update(phi.result(), value);
+            },
+            [&](il::Assign& assign) {
+                _update(assign.result(), _value(assign.value()));
+            },
+            [&](il::Binary& binary) {
+                const auto left = _value(binary.left()), right = _value(binary.right());
+
+                Value value;
+                if (left.kind == Kind::Overdefined || right.kind == Kind::Overdefined) {
+                    value.kind = Kind::Overdefined;
+                } else if (left.kind == Kind::Constant && right.kind == Kind::Constant) {
+                    const auto result = ConstantFolding::evaluate_binary(
+                        binary.op(), binary.op_type(), left.constant, right.constant
+                    );
+
+                    // Operations that can't be folded (e.g. a division by zero) are left for the runtime.
+                    if (result) value = { Kind::Constant, *result };
+                    else value.kind = Kind::Overdefined;
+                }
+
+                _update(binary.result(), value);
+            },
+            [&](il::Cast& cast) {
+                auto value = _value(cast.source());
+                if (value.kind == Kind::Constant) {
+                    value.constant = ConstantFolding::evaluate_cast(cast.result().type(), value.constant);
+                }
+
+                _update(cast.result(), value);
+            },
+            [&](il::Select& select) {
+                const auto condition = _value(select.condition());
+
+                Value value;
+                if (condition.kind == Kind::Constant) {
+                    const auto taken = std::get<bool>(ConstantFolding::evaluate_cast(sem::Boolean(), condition.constant));
+                    value = _value(taken ? select.true_value() : select.false_value());
+                } else if (condition.kind == Kind::Overdefined) {
+                    // Both values might be selected at runtime, only the same constant for both is known.
+                    value = _meet(_value(select.true_value()), _value(select.false_value()));
+                }
+
+                _update(select.result(), value);
+            },
+            [&](il::If&) {
+                _visit_successors(block);
+            },
+            [&](auto& other) {
+                // Calls, loads etc. produce values which are unknown at compile time.
+                for (const auto& definition : other.defs()) {
+                    const auto* variable = std::get_if<il::Variable>(&definition);
+                    if (variable) _update(*variable, { Kind::Overdefined, { } });
+                }
+            },
+        },
+        instruction
+    );
+}
+
+void SCCP::_visit_successors(il::BasicBlock& block) {
+    if (!block.instructions().empty()) {
+        if (auto* const _if = std::get_if<il::If>(&block.instructions().back())) {
+            const auto condition = _value(_if->condition());
+            if (condition.kind == Value::Kind::Undefined) return;
+
+            if (const auto taken = _constant_condition(block)) {
+                _mark_edge(&block, *taken ? block.branch() : block.next());
+                return;
+            }
+        }
+    }
+
+    if (block.next()) _mark_edge(&block, block.next());
+    if (block.branch()) _mark_edge(&block, block.branch());
+}
+
+void SCCP::_mark_edge(il::BasicBlock* from, il::BasicBlock* to) {
+    if (!_edges.insert({ from, to }).second) return;
+    _edge_worklist.emplace_back(from, to);
+}
+
+void SCCP::_update(const il::Variable& variable, const Value& value) {
+    auto& current = _values[variable];
+
+    const auto lowered = _meet(current, value);
+    if (lowered == current) return;
+
+    current = lowered;
+    for (auto* user : _chains->uses(variable)) _ssa_worklist.push_back(user);
+}
+
+SCCP::Value SCCP::_value(const il::Operand& operand) const {
+    return std::visit(
+        match{
+            [](const il::Immediate& immediate) {
+                return Value{ Value::Kind::Constant, immediate };
+            },
+            [&](const il::Variable& variable) {
+                // Parameters and variables with several definitions are not in SSA form.
+                if (!_chains->definition(variable)) return Value{ Value::Kind::Overdefined, { } };
+
+                const auto found = _values.find(variable);
+                return found == _values.end() ? Value{ } : found->second;
+            },
+            [](const il::Memory&) {
+                return Value{ Value::Kind::Overdefined, { } };
+            },
+        },
+        operand
+    );
+}
+
+std::optional<bool> SCCP::_constant_condition(il::BasicBlock& block) const {
+    if (block.instructions().empty()) return std::nullopt;
+
+    auto* const _if = std::get_if<il::If>(&block.instructions().back());
+    if (!_if) return std::nullopt;
+
+    const auto condition = _value(_if->condition());
+    if (condition.kind != Value::Kind::Constant) return std::nullopt;
+
+    const auto value = ConstantFolding::evaluate_cast(sem::Boolean(), condition.constant);
+    return std::get<bool>(value);
+}
+
+SCCP::Value SCCP::_meet(const Value& left, const Value& right) {
+    if (left.kind == Value::Kind::Undefined) return right;
+    if (right.kind == Value::Kind::Undefined) return left;
+    if (left == right) return left;
+
+    return { Value::Kind::Overdefined, { } };
+}
+
+bool SCCP::_rewrite(il::Function& function) {
+    std::vector<il::BasicBlock*> blocks;
+    for (auto& block : function) blocks.push_back(&block);
+
+    // A branch on an unresolved condition would leave its successors unmarked, those can't be removed.
+    for (auto* block : blocks) {
+        if (!_executable.contains(block) || _constant_condition(*block)) continue;
+
+        const auto is_dead = [&](il::BasicBlock* successor) { return successor && !_executable.contains(successor); };
+        if (is_dead(block->next()) || is_dead(block->branch())) return false;
+    }
+
+    bool changed = false;
+    for (auto* block : blocks) {
+        if (!_executable.contains(block)) continue;
+
+        for (auto& instruction : *block) {
+            if (auto* const assign = std::get_if<il::Assign>(&instruction)) {
+                if (std::holds_alternative<il::Immediate>(assign->value())) continue;
+            }
+
+            const auto defs = instruction.defs();
+            if (defs.size() != 1 || std::holds_alternative<il::Call>(instruction)) continue;
+
+            const auto* variable = std::get_if<il::Variable>(&defs.front());
+            if (!variable) continue;
+
+            const auto value = _value(*variable);
+            if (value.kind != Value::Kind::Constant) continue;
+
+            instruction = il::Assign(*variable, value.constant, instruction.span());
+            count("folded-instructions");
+            changed = true;
+        }
+
+        const auto condition = _constant_condition(*block);
+        if (!condition) continue;
+
+        auto* taken = *condition ? block->branch() : block->next();
+        auto* dropped = *condition ? block->next() : block->branch();
+
+        block->instructions().back() = il::Goto(taken->label(), block->instructions().back().span());
+        if (dropped != taken) _remove_incoming(*block, *dropped);
+
+        block->set_branch(nullptr);
+        block->set_next(taken);
+        taken->add_predecessor(block);
+        count("folded-branches");
+        changed = true;
+    }
+
+    std::vector<il::BasicBlock*> unreachable;
+    for (auto* block : blocks) {
+        if (_executable.contains(block)) continue;
+
+        if (block->next()) _remove_incoming(*block, *block->next());
+        if (block->branch()) _remove_incoming(*block, *block->branch());
+        block->set_next(nullptr);
+        block->set_branch(nullptr);
+
+        unreachable.push_back(block);
+        count("unreachable-blocks");
+        changed = true;
+    }
+
+    for (auto* block : unreachable) {
+        if (block == function.exit() || !block->predecessors().empty()) continue;
+
+        [[maybe_unused]] const auto removed = function.remove(block);
+        assert(removed);
+    }
+
+    return changed;
+}
+
+void SCCP::_remove_incoming(il::BasicBlock& from, il::BasicBlock& to) {
+    for (auto& instruction : to) {
+        if (auto* phi = std::get_if<il::Phi>(&instruction)) phi->remove_incoming(&from);
+    }
+
+    to.remove_predecessor(&from);
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
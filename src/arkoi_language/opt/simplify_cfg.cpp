@@ -1,14 +1,36 @@
 #include "arkoi_language/opt/simplify_cfg.hpp"
 
 #include <cassert>
+#include <unordered_set>
+
+#include "arkoi_language/opt/constant_folding.hpp"
+#include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi::opt;
 using namespace arkoi;
 
 bool SimplifyCFG::exit_function(il::Function& function) {
     for (auto& block : function) {
-        if (_remove_proxy_block(block) || _merge_block(function, block)) {
-            assert(function.remove(&block));
+        const auto proxy = _remove_proxy_block(block);
+        if (proxy || _merge_block(function, block)) {
+            [[maybe_unused]] const auto removed = function.remove(&block);
+            assert(removed);
+
+            count(proxy ? "removed-proxy-blocks" : "merged-blocks");
+            return true;
+        }
+    }
+
+    for (auto& block : function) {
+        if (_fold_branch(function, block)) {
+            count("folded-branches");
+            return true;
+        }
+    }
+
+    for (auto& block : function) {
+        if (_thread_jump(function, block)) {
+            count("threaded-jumps");
             return true;
         }
     }
@@ -22,6 +44,19 @@ bool SimplifyCFG::_remove_proxy_block(il::BasicBlock& block) {
     const auto& target = std::get<il::Goto>(block.instructions().front());
     auto* target_block = block.next();
 
+    // The phis of the target receive the value of the proxy block from each of its predecessors now.
+    for (auto& instruction : target_block->instructions()) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (!phi) continue;
+
+        const auto value = phi->remove_incoming(&block);
+        if (!value) continue;
+
+        for (auto* predecessor : block.predecessors()) {
+            phi->set_incoming(predecessor, *value);
+        }
+    }
+
     // Replace every predecessor goto with a copy of the current one. Also, delete the predecessor, as an
     // empty predecessor vector is needed to delete a BasicBlock from a function.
     for (auto& predecessor : block.predecessors()) {
@@ -38,8 +73,12 @@ bool SimplifyCFG::_is_proxy_block(il::BasicBlock& block) {
     if (block.instructions().size() != 1) return false;
     if (!std::holds_alternative<il::Goto>(block.instructions().front())) return false;
 
+    // Without predecessors there is nothing to redirect, this is the case for the entry block.
+    if (block.predecessors().empty()) return false;
+
     for (auto* predecessor : block.predecessors()) {
-        assert(!predecessor->instructions().empty());
+        // Predecessors emptied by other passes fall through without a goto that could be redirected.
+        if (predecessor->instructions().empty()) return false;
 
         const auto& last_instruction = predecessor->instructions().back();
         const auto* goto_instruction = std::get_if<il::Goto>(&last_instruction);
@@ -55,8 +94,19 @@ bool SimplifyCFG::_merge_block(il::Function& function, il::BasicBlock& block) {
     auto* predecessor = *block.predecessors().begin();
     auto& instructions = predecessor->instructions();
 
-    // Remove the goto instruction
-    instructions.erase(instructions.end());
+    // Remove the goto instruction, if the predecessor doesn't just fall through
+    if (!instructions.empty() && std::holds_alternative<il::Goto>(instructions.back())) instructions.pop_back();
+
+    // With the predecessor as the only way into the block, its phis turn into plain copies.
+    for (auto& instruction : block.instructions()) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (!phi) continue;
+
+        const auto* value = phi->incoming_from(predecessor);
+        assert(value);
+
+        instruction = il::Assign(phi->result(), *value, phi->span());
+    }
 
     // Move all the instructions from the current block to the predecessor
     instructions.insert(
@@ -69,6 +119,14 @@ bool SimplifyCFG::_merge_block(il::Function& function, il::BasicBlock& block) {
     auto* target_block = block.next();
     predecessor->set_next(target_block);
 
+    // The phis of the next block are now reached through the predecessor.
+    if (target_block) {
+        for (auto& instruction : target_block->instructions()) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi) phi->replace_predecessor(&block, predecessor);
+        }
+    }
+
     // In case of merging a basic block with the exit block of a function, the exit block must be set to the
     // predecessor.
     if (&block == function.exit()) function.set_exit(predecessor);
@@ -84,14 +142,285 @@ bool SimplifyCFG::is_simple_block(const il::BasicBlock& block) {
     if (block.predecessors().size() != 1) return false;
 
     auto* predecessor = *block.predecessors().begin();
-    assert(!predecessor->instructions().empty());
+    if (predecessor->branch()) return false;
+
+    // Predecessors emptied by other passes, or ending without a jump, fall through into the block.
+    if (predecessor->instructions().empty()) return true;
 
     const auto& instruction = predecessor->instructions().back();
-    if (!std::holds_alternative<il::Goto>(instruction)) return false;
+    return !std::holds_alternative<il::If>(instruction) && !std::holds_alternative<il::Return>(instruction);
+}
+
+bool SimplifyCFG::_fold_branch(il::Function& function, il::BasicBlock& block) {
+    if (block.instructions().empty()) return false;
+
+    auto* _if = std::get_if<il::If>(&block.instructions().back());
+    if (!_if) return false;
+
+    const auto* condition = std::get_if<il::Immediate>(&_if->condition());
+    if (!condition && block.next() != block.branch()) return false;
+
+    const auto taken_branch = condition && std::get<bool>(ConstantFolding::evaluate_cast(sem::Boolean(), *condition));
+    auto* taken = taken_branch ? block.branch() : block.next();
+    auto* dropped = taken_branch ? block.next() : block.branch();
+
+    block.instructions().back() = il::Goto(taken->label(), _if->span());
+    if (dropped != taken) _remove_edge(block, *dropped);
+
+    block.set_branch(nullptr);
+    block.set_next(taken);
+    taken->add_predecessor(&block);
+
+    if (dropped != taken) _remove_unreachable(function, dropped);
+    return true;
+}
+
+bool SimplifyCFG::_thread_jump(il::Function& function, il::BasicBlock& block) {
+    if (block.instructions().empty() || !std::holds_alternative<il::If>(block.instructions().back())) return false;
+    if (block.next() == block.branch()) return false;
+
+    const auto& chains = analyses().get<il::DefUseChains>(function);
+    if (!_is_threadable(chains, block)) return false;
+
+    const auto& dominance = analyses().get<il::DominanceAnalysis>(function);
+    for (auto* predecessor : block.predecessors()) {
+        // Threading a back edge would give the loop a second entry, unreachable predecessors are left alone.
+        if (dominance.dominates(&block, predecessor)) continue;
+        if (!dominance.dominates(function.entry(), predecessor)) continue;
+
+        // Only predecessors with exactly one jump into the block can be redirected.
+        if (predecessor->instructions().empty() || predecessor->next() == predecessor->branch()) continue;
+        auto& terminator = predecessor->instructions().back();
+        if (!std::holds_alternative<il::Goto>(terminator) && !std::holds_alternative<il::If>(terminator)) continue;
+
+        const auto condition = _known_condition(chains, *predecessor, block);
+        if (!condition) continue;
+
+        // A phi of the target can't receive two different values from the same predecessor.
+        auto* target = *condition ? block.branch() : block.next();
+        if (target == &block || target->predecessors().contains(predecessor)) continue;
+
+        // The phis of the target receive the value of the block from the predecessor now.
+        for (auto& instruction : target->instructions()) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (!phi) continue;
+
+            const auto* value = phi->incoming_from(&block);
+            assert(value);
+
+            phi->set_incoming(predecessor, *value);
+        }
+
+        for (auto& instruction : block.instructions()) {
+            if (auto* phi = std::get_if<il::Phi>(&instruction)) phi->remove_incoming(predecessor);
+        }
+
+        if (auto* _goto = std::get_if<il::Goto>(&terminator)) {
+            *_goto = il::Goto(target->label(), _goto->span());
+            predecessor->set_next(target);
+        } else {
+            auto& _if = std::get<il::If>(terminator);
+            const auto is_next = predecessor->next() == &block;
+            _if = il::If(
+                _if.condition(), is_next ? target->label() : _if.next(), is_next ? _if.branch() : target->label(),
+                _if.span()
+            );
+
+            if (is_next) predecessor->set_next(target);
+            else predecessor->set_branch(target);
+        }
+
+        if (block.predecessors().empty()) _remove_unreachable(function, &block);
+        return true;
+    }
+
+    return false;
+}
+
+bool SimplifyCFG::_is_threadable(const il::DefUseChains& chains, il::BasicBlock& block) {
+    if (block.instructions().size() > THREADING_BUDGET) return false;
+
+    for (auto& instruction : block.instructions()) {
+        const auto is_pure = std::visit(
+            match{
+                [](const il::Phi&) { return true; },
+                [](const il::Binary&) { return true; },
+                [](const il::Cast&) { return true; },
+                [](const il::Assign&) { return true; },
+                [](const il::Select&) { return true; },
+                [](const il::Load&) { return true; },
+                [](const il::If&) { return true; },
+                [](const auto&) { return false; },
+            },
+            instruction
+        );
+        if (!is_pure) return false;
+
+        // A result used behind the block would have no definition on the threaded edge.
+        for (const auto& definition : instruction.defs()) {
+            const auto* variable = std::get_if<il::Variable>(&definition);
+            if (!variable) continue;
+
+            for (const auto* user : chains.uses(*variable)) {
+                if (chains.block(user) != &block) return false;
+            }
+        }
+    }
 
     return true;
 }
 
+std::optional<bool> SimplifyCFG::_known_condition(
+    const il::DefUseChains& chains, il::BasicBlock& predecessor, il::BasicBlock& block
+) {
+    std::unordered_map<il::Variable, il::Immediate> constants{ };
+
+    const auto constant = [&](const il::Operand& operand) -> std::optional<il::Immediate> {
+        if (const auto* immediate = std::get_if<il::Immediate>(&operand)) return *immediate;
+
+        const auto* variable = std::get_if<il::Variable>(&operand);
+        if (!variable) return std::nullopt;
+
+        if (const auto found = constants.find(*variable); found != constants.end()) return found->second;
+
+        // The definitions outside the block don't depend on the edge, but only constant copies are known.
+        auto* definition = chains.definition(*variable);
+        auto* assign = definition ? std::get_if<il::Assign>(definition) : nullptr;
+        if (!assign) return std::nullopt;
+
+        const auto* immediate = std::get_if<il::Immediate>(&assign->value());
+        return immediate ? std::optional(*immediate) : std::nullopt;
+    };
+
+    // The branch of the predecessor decides its condition on the edge into the block.
+    il::Binary* tested = nullptr;
+    const auto tested_value = predecessor.branch() == &block;
+    if (auto* _if = std::get_if<il::If>(&predecessor.instructions().back())) {
+        if (const auto* condition = std::get_if<il::Variable>(&_if->condition())) {
+            constants.insert_or_assign(*condition, il::Immediate(tested_value));
+
+            auto* definition = chains.definition(*condition);
+            tested = definition ? std::get_if<il::Binary>(definition) : nullptr;
+        }
+    }
+
+    for (auto& instruction : block.instructions()) {
+        auto result = std::visit(
+            match{
+                [&](il::Phi& phi) -> std::optional<std::pair<il::Variable, il::Immediate>> {
+                    const auto* value = phi.incoming_from(&predecessor);
+                    if (!value) return std::nullopt;
+
+                    const auto known = constant(*value);
+                    if (!known) return std::nullopt;
+                    return std::pair{ phi.result(), *known };
+                },
+                [&](il::Assign& assign) -> std::optional<std::pair<il::Variable, il::Immediate>> {
+                    const auto known = constant(assign.value());
+                    if (!known) return std::nullopt;
+                    return std::pair{ assign.result(), *known };
+                },
+                [&](il::Cast& cast) -> std::optional<std::pair<il::Variable, il::Immediate>> {
+                    const auto known = constant(cast.source());
+                    if (!known) return std::nullopt;
+                    return std::pair{ cast.result(), ConstantFolding::evaluate_cast(cast.result().type(), *known) };
+                },
+                [&](il::Binary& binary) -> std::optional<std::pair<il::Variable, il::Immediate>> {
+                    const auto left = constant(binary.left()), right = constant(binary.right());
+                    if (left && right) {
+                        const auto known = ConstantFolding::evaluate_binary(
+                            binary.op(), binary.op_type(), *left, *right
+                        );
+                        if (!known) return std::nullopt;
+                        return std::pair{ binary.result(), *known };
+                    }
+
+                    if (!tested) return std::nullopt;
+                    const auto implied = _implied(*tested, tested_value, binary);
+                    if (!implied) return std::nullopt;
+                    return std::pair{ binary.result(), il::Immediate(*implied) };
+                },
+                [](auto&) -> std::optional<std::pair<il::Variable, il::Immediate>> { return std::nullopt; },
+            },
+            instruction
+        );
+
+        if (result) constants.insert_or_assign(result->first, result->second);
+    }
+
+    auto& _if = std::get<il::If>(block.instructions().back());
+    const auto condition = constant(_if.condition());
+    if (!condition) return std::nullopt;
+
+    return std::get<bool>(ConstantFolding::evaluate_cast(sem::Boolean(), *condition));
+}
+
+std::optional<bool> SimplifyCFG::_implied(il::Binary& tested, const bool value, il::Binary& binary) {
+    if (tested.left() != binary.left() || tested.right() != binary.right()) return std::nullopt;
+    if (tested.op_type() != binary.op_type()) return std::nullopt;
+
+    if (tested.op() == binary.op()) return value;
+
+    // The negation of a floating point comparison is also true for NaN, which the inverse comparison isn't.
+    if (binary.op_type().is_floating()) return std::nullopt;
+
+    using Operator = il::Binary::Operator;
+    const auto inverse = [](const Operator op) -> std::optional<Operator> {
+        switch (op) {
+            case Operator::GreaterThan: return Operator::LessEqual;
+            case Operator::LessThan: return Operator::GreaterEqual;
+            case Operator::GreaterEqual: return Operator::LessThan;
+            case Operator::LessEqual: return Operator::GreaterThan;
+            case Operator::Equal: return Operator::NotEqual;
+            case Operator::NotEqual: return Operator::Equal;
+            default: return std::nullopt;
+        }
+    };
+
+    if (inverse(tested.op()) == binary.op()) return !value;
+    return std::nullopt;
+}
+
+void SimplifyCFG::_remove_edge(il::BasicBlock& from, il::BasicBlock& to) {
+    for (auto& instruction : to) {
+        if (auto* phi = std::get_if<il::Phi>(&instruction)) phi->remove_incoming(&from);
+    }
+
+    to.remove_predecessor(&from);
+}
+
+void SimplifyCFG::_remove_unreachable(il::Function& function, il::BasicBlock* block) {
+    std::unordered_set<il::BasicBlock*> reachable{ };
+    for (auto& current : function) reachable.insert(&current);
+
+    // Blocks are only iterated when reachable from the entry, everything else found from the block is unreachable.
+    std::unordered_set<il::BasicBlock*> unreachable{ };
+    std::vector worklist{ block };
+    while (!worklist.empty()) {
+        auto* current = worklist.back();
+        worklist.pop_back();
+
+        if (!current || reachable.contains(current) || !unreachable.insert(current).second) continue;
+        worklist.push_back(current->next());
+        worklist.push_back(current->branch());
+    }
+
+    for (auto* current : unreachable) {
+        if (current->next()) _remove_edge(*current, *current->next());
+        if (current->branch()) _remove_edge(*current, *current->branch());
+        current->set_next(nullptr);
+        current->set_branch(nullptr);
+    }
+
+    for (auto* current : unreachable) {
+        if (current == function.exit() || !current->predecessors().empty()) continue;
+
+        [[maybe_unused]] const auto removed = function.remove(current);
+        assert(removed);
+        count("unreachable-blocks");
+    }
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
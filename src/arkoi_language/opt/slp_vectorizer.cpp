@@ -0,0 +1,167 @@
+#include "arkoi_language/opt/slp_vectorizer.hpp"
+
+#include <algorithm>
+
+#include "arkoi_language/x86_64/selector.hpp"
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool SLPVectorizer::enter_function(il::Function& function) {
+    _uses.clear();
+    for (auto& block : function) {
+        for (const auto& instruction : block.instructions()) {
+            for (const auto& use : instruction.uses()) _uses[use]++;
+        }
+    }
+
+    return false;
+}
+
+bool SLPVectorizer::on_block(il::BasicBlock& block) {
+    auto& instructions = block.instructions();
+
+    std::unordered_map<il::Operand, size_t> definitions;
+    const auto define = [&] {
+        definitions.clear();
+        for (size_t index = 0; index < instructions.size(); index++) {
+            for (const auto& def : instructions[index].defs()) definitions[def] = index;
+        }
+    };
+    define();
+
+    auto changed = false;
+    for (size_t start = 0; start < instructions.size(); start++) {
+        const auto chain = _chain(instructions, start, definitions);
+        if (chain.empty()) continue;
+
+        // A chain that is already grouped is found again by every run, which must not count as a change.
+        auto is_grouped = true;
+        for (size_t offset = 0; offset < chain.size(); offset++) is_grouped &= chain[offset] == start + offset;
+
+        if (is_grouped) {
+            start += chain.size() - 1;
+            continue;
+        }
+
+        // The chain is hoisted up to its start, the instructions in between keep their order behind it.
+        const auto last = std::ranges::max(chain);
+        std::vector<il::Instruction> grouped;
+        for (const auto index : chain) grouped.push_back(std::move(instructions[index]));
+        for (auto index = start; index <= last; index++) {
+            if (std::ranges::find(chain, index) == chain.end()) grouped.push_back(std::move(instructions[index]));
+        }
+        std::ranges::move(grouped, instructions.begin() + static_cast<std::ptrdiff_t>(start));
+
+        count("grouped-pairs", chain.size() / 2);
+        changed = true;
+        define();
+
+        start += chain.size() - 1;
+    }
+
+    return changed;
+}
+
+std::vector<size_t> SLPVectorizer::_chain(
+    il::BasicBlock::Instructions& instructions, const size_t start,
+    const std::unordered_map<il::Operand, size_t>& definitions
+) {
+    const auto binary = [&](const size_t index) { return std::get_if<il::Binary>(&instructions[index]); };
+
+    // Every operand besides the packed results of the step before needs to be available at the start of the chain.
+    const auto is_available = [&](const il::Operand& operand) {
+        const auto found = definitions.find(operand);
+        return found == definitions.end() || found->second < start;
+    };
+    const auto is_hoistable = [&](il::Binary& instruction, const il::Operand* packed) {
+        const auto is_ready = [&](const il::Operand& operand) {
+            return (packed && operand == *packed) || is_available(operand);
+        };
+
+        return is_ready(instruction.left()) && is_ready(instruction.right());
+    };
+
+    auto* lower = binary(start);
+    if (!lower) return { };
+
+    // The nearest isomorphic operation becomes the upper lane, which keeps the pairing stable across runs.
+    std::vector<size_t> chain;
+    for (auto index = start + 1; index < instructions.size(); index++) {
+        auto* upper = binary(index);
+        if (!upper || !x86_64::PackedPattern::is_isomorphic(*lower, *upper)) continue;
+        if (!is_hoistable(*upper, nullptr)) continue;
+
+        chain = { start, index };
+        break;
+    }
+    if (chain.empty()) return { };
+
+    x86_64::PackedPattern pattern{ { { lower, binary(chain[1]) } } };
+    while (true) {
+        const auto& previous = pattern.steps.back();
+        const auto lower_result = il::Operand(previous[0]->result());
+        const auto upper_result = il::Operand(previous[1]->result());
+        if (_uses[lower_result] != 1 || _uses[upper_result] != 1) break;
+
+        // The only use of each result is behind its definition in the same block, if it's there at all.
+        const auto user = [&](const il::Operand& result) -> std::optional<size_t> {
+            for (auto index = definitions.at(result) + 1; index < instructions.size(); index++) {
+                const auto uses = instructions[index].uses();
+                if (std::ranges::find(uses, result) == uses.end()) continue;
+
+                if (!binary(index)) return std::nullopt;
+                return index;
+            }
+
+            return std::nullopt;
+        };
+
+        const auto next_lower = user(lower_result);
+        const auto next_upper = user(upper_result);
+        if (!next_lower || !next_upper) break;
+
+        const std::array next{ binary(*next_lower), binary(*next_upper) };
+        if (!x86_64::PackedPattern::is_isomorphic(*next[0], *next[1])) break;
+        if (!x86_64::PackedPattern::is_continued(previous, next)) break;
+        if (!is_hoistable(*next[0], &lower_result) || !is_hoistable(*next[1], &upper_result)) break;
+
+        pattern.steps.push_back(next);
+        chain.push_back(*next_lower);
+        chain.push_back(*next_upper);
+    }
+
+    if (!pattern.is_profitable()) return { };
+    return chain;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,103 @@
+#include "arkoi_language/opt/store_forwarding.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool StoreForwarding::on_block(il::BasicBlock& block) {
+    auto& instructions = block.instructions();
+
+    // The value each slot holds, and the last store of each slot that no load has read yet.
+    std::unordered_map<il::Memory, il::Operand> values{ };
+    std::unordered_map<il::Memory, size_t> unread{ };
+    std::unordered_set<size_t> dead{ };
+    // The results of the forwarded loads, which are copies of the forwarded values.
+    std::unordered_map<il::Operand, il::Operand> copies{ };
+    size_t forwarded_loads = 0, redundant_stores = 0;
+
+    for (size_t index = 0; index < instructions.size(); index++) {
+        auto& instruction = instructions[index];
+
+        if (auto* store = std::get_if<il::Store>(&instruction)) {
+            const auto& memory = store->result();
+
+            const auto copy = copies.find(store->source());
+            const auto& source = copy != copies.end() ? copy->second : store->source();
+
+            const auto value = values.find(memory);
+            if (value != values.end() && value->second == source) {
+                dead.insert(index);
+                redundant_stores++;
+                continue;
+            }
+
+            if (const auto previous = unread.find(memory); previous != unread.end()) {
+                dead.insert(previous->second);
+            }
+
+            values.insert_or_assign(memory, source);
+            unread.insert_or_assign(memory, index);
+        } else if (const auto* load = std::get_if<il::Load>(&instruction)) {
+            const auto& memory = load->source();
+
+            const auto value = values.find(memory);
+            if (value != values.end()) {
+                copies.insert_or_assign(load->result(), value->second);
+                instruction = il::Assign(load->result(), value->second, load->span());
+                forwarded_loads++;
+                continue;
+            }
+
+            values.insert_or_assign(memory, load->result());
+            unread.erase(memory);
+        } else if (const auto* alloca = std::get_if<il::Alloca>(&instruction)) {
+            // A new allocation doesn't hold the value of any previous store.
+            values.erase(alloca->result());
+            unread.erase(alloca->result());
+        }
+    }
+
+    const auto overwritten_stores = dead.size() - redundant_stores;
+    if (!dead.empty()) {
+        size_t index = 0;
+        std::erase_if(instructions, [&](const auto&) { return dead.contains(index++); });
+    }
+
+    count("forwarded-loads", forwarded_loads);
+    count("redundant-stores", redundant_stores);
+    count("overwritten-stores", overwritten_stores);
+    return forwarded_loads != 0 || !dead.empty();
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
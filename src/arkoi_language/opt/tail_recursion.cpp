@@ -0,0 +1,193 @@
+#include "arkoi_language/opt/tail_recursion.hpp"
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_set>
+
+using namespace arkoi::opt;
+using namespace arkoi;
+
+bool TailRecursion::enter_function(il::Function& function) {
+    std::vector<std::pair<il::BasicBlock*, size_t>> calls;
+    for (auto& block : function) {
+        for (size_t index = 0; index < block.instructions().size(); index++) {
+            if (!_is_tail_call(function, block, index)) continue;
+
+            calls.emplace_back(&block, index);
+            break;
+        }
+    }
+
+    if (calls.empty()) return false;
+
+    auto* entry = function.entry();
+    auto* header = _create_header(function);
+
+    for (auto [block, index] : calls) {
+        // The instructions of the entry block were moved into the header.
+        if (block == entry) block = header;
+        _eliminate(*block, index, *header);
+    }
+
+    count("eliminated-calls", calls.size());
+    return true;
+}
+
+il::BasicBlock* TailRecursion::_create_header(il::Function& function) {
+    auto* entry = function.entry();
+    const auto label = entry->label() + ".tail";
+
+    // A previous run already created the header, the parameters are only used by its phis.
+    auto& existing = entry->instructions();
+    if (existing.size() == 1 && std::holds_alternative<il::Goto>(existing.front())) {
+        if (entry->next() && entry->next()->label() == label) return entry->next();
+    }
+
+    auto* header = function.emplace_back(label);
+
+    header->instructions() = std::move(entry->instructions());
+    entry->instructions().clear();
+
+    for (auto* successor : { entry->next(), entry->branch() }) {
+        if (!successor) continue;
+
+        for (auto& instruction : successor->instructions()) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi) phi->replace_predecessor(entry, header);
+        }
+    }
+
+    header->set_next(entry->next());
+    header->set_branch(entry->branch());
+    entry->set_branch(nullptr);
+
+    if (function.exit() == entry) function.set_exit(header);
+
+    entry->emplace_back<il::Goto>(header->label(), std::nullopt);
+    entry->set_next(header);
+
+    // Every iteration of the loop receives new values for the parameters.
+    auto& instructions = header->instructions();
+    for (const auto& parameter : std::views::reverse(function.parameters())) {
+        const il::Variable value(parameter.name() + ".tail", parameter.type(), parameter.version());
+
+        for (auto& block : function) {
+            for (auto& instruction : block) instruction.replace_uses(parameter, value);
+        }
+
+        instructions.insert(instructions.begin(), il::Phi(value, { { entry, parameter } }, std::nullopt));
+    }
+
+    return header;
+}
+
+void TailRecursion::_eliminate(il::BasicBlock& block, const size_t index, il::BasicBlock& header) {
+    auto& instructions = block.instructions();
+    auto call = std::get<il::Call>(instructions[index]);
+
+    // The arguments of the call are passed to the next iteration through the phis of the header.
+    std::unordered_set<il::Variable> arguments;
+    for (const auto& argument : call.arguments()) arguments.insert(std::get<il::Variable>(argument));
+
+    for (size_t current = 0; current < index; current++) {
+        auto* argument = std::get_if<il::Argument>(&instructions[current]);
+        if (!argument || !arguments.contains(argument->result())) continue;
+
+        instructions[current] = il::Assign(argument->result(), argument->source(), argument->span());
+    }
+
+    auto argument = call.arguments().begin();
+    for (auto& instruction : header) {
+        auto* phi = std::get_if<il::Phi>(&instruction);
+        if (!phi || argument == call.arguments().end()) break;
+
+        phi->set_incoming(&block, std::get<il::Variable>(*argument++));
+    }
+
+    instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(index), instructions.end());
+    instructions.emplace_back(il::Goto(header.label(), call.span()));
+
+    if (auto* successor = block.next()) {
+        for (auto& instruction : *successor) {
+            auto* phi = std::get_if<il::Phi>(&instruction);
+            if (phi) phi->remove_incoming(&block);
+        }
+    }
+
+    block.set_next(&header);
+}
+
+bool TailRecursion::_is_tail_call(il::Function& function, il::BasicBlock& block, const size_t index) {
+    auto* call = std::get_if<il::Call>(&block.instructions()[index]);
+    if (!call || call->name() != function.name()) return false;
+    if (call->arguments().size() != function.parameters().size()) return false;
+
+    const auto is_variable = [](const auto& argument) { return std::holds_alternative<il::Variable>(argument); };
+    if (!std::ranges::all_of(call->arguments(), is_variable)) return false;
+
+    // Follow the result through copies and phis until it's returned.
+    il::Operand value = call->result();
+    il::BasicBlock* previous = nullptr;
+    auto* current = &block;
+    auto position = index + 1;
+
+    std::unordered_set<il::BasicBlock*> visited{ current };
+    while (true) {
+        auto& instructions = current->instructions();
+        for (; position < instructions.size(); position++) {
+            auto& instruction = instructions[position];
+
+            if (auto* phi = std::get_if<il::Phi>(&instruction)) {
+                const auto* incoming = phi->incoming_from(previous);
+                if (incoming && il::Operand(*incoming) == value) value = phi->result();
+            } else if (auto* assign = std::get_if<il::Assign>(&instruction)) {
+                if (assign->value() == value) value = assign->result();
+            } else if (auto* _return = std::get_if<il::Return>(&instruction)) {
+                return _return->value() == value;
+            } else if (!std::holds_alternative<il::Goto>(instruction)) {
+                // Anything else could have side effects or depend on the call.
+                return false;
+            }
+        }
+
+        if (current->branch() || !current->next()) return false;
+
+        previous = current;
+        current = current->next();
+        position = 0;
+
+        if (!visited.insert(current).second) return false;
+    }
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
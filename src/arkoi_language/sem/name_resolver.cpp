@@ -5,7 +5,18 @@
 using namespace arkoi::sem;
 
 void NameResolver::visit(ast::Program& node) {
-    _scopes.push(node.table());
+    const auto globals = declare(node);
+
+    for (const auto& item : node.statements()) {
+        auto* function = dynamic_cast<ast::Function*>(item.get());
+        if (function) resolve(*function, globals, node.arena());
+    }
+}
+
+SymbolTable NameResolver::declare(ast::Program& node) {
+    // The symbols are owned by the nodes referencing them, thus they can live in the arena of the program.
+    _table.emplace(node.arena().resource());
+    _table->enter_scope();
 
     // At first all function prototypes are name resolved.
     for (const auto& item : node.statements()) {
@@ -14,10 +25,20 @@ void NameResolver::visit(ast::Program& node) {
     }
 
     for (const auto& item : node.statements()) {
-        item->accept(*this);
+        auto* function = dynamic_cast<ast::Function*>(item.get());
+        if (function) _declare_parameters(*function);
     }
 
-    _scopes.pop();
+    auto globals = std::move(*_table);
+    _table.reset();
+
+    return globals;
+}
+
+void NameResolver::resolve(ast::Function& node, const SymbolTable& globals, ast::Arena& arena) {
+    _table.emplace(&globals, arena.resource());
+    node.accept(*this);
+    _table.reset();
 }
 
 void NameResolver::visit_as_prototype(ast::Function& node) {
@@ -26,8 +47,8 @@ void NameResolver::visit_as_prototype(ast::Function& node) {
     node.name().accept(*this);
 }
 
-void NameResolver::visit(ast::Function& node) {
-    _scopes.push(node.table());
+void NameResolver::_declare_parameters(ast::Function& node) {
+    _table->enter_scope();
 
     std::vector<std::shared_ptr<Variable>> parameters;
     for (auto& parameter : node.parameters()) {
@@ -40,16 +61,27 @@ void NameResolver::visit(ast::Function& node) {
     auto& function = std::get<Function>(*node.name().symbol());
     function.set_parameters(std::move(parameters));
 
+    _table->exit_scope();
+}
+
+void NameResolver::visit(ast::Function& node) {
+    _table->enter_scope();
+
+    // The parameters were checked for conflicts once they were declared, thus they're only bound again.
+    for (auto& parameter : node.parameters()) {
+        _table->bind(parameter.name().symbol());
+    }
+
     node.block()->accept(*this);
-    _scopes.pop();
+    _table->exit_scope();
 }
 
 void NameResolver::visit(ast::Block& node) {
-    _scopes.push(node.table());
+    _table->enter_scope();
     for (const auto& item : node.statements()) {
         item->accept(*this);
     }
-    _scopes.pop();
+    _table->exit_scope();
 }
 
 void NameResolver::visit(ast::Parameter& node) {
@@ -3,7 +3,7 @@
 template <typename Type, typename... Args>
 std::shared_ptr<Symbol> NameResolver::_check_non_existence(const front::Token& token, Args&&... args) {
     try {
-        return _scopes.top()->insert<Type>(token, std::forward<Args>(args)...);
+        return _table->insert<Type>(token, std::forward<Args>(args)...);
     } catch (const SemanticError& error) {
         _diagnostics.add(error.report());
         return nullptr;
@@ -13,7 +13,7 @@ std::shared_ptr<Symbol> NameResolver::_check_non_existence(const front::Token& t
 template <typename... Types>
 std::shared_ptr<Symbol> NameResolver::_check_existence(const front::Token& token) {
     try {
-        return _scopes.top()->lookup<Types...>(token);
+        return _table->lookup<Types...>(token);
     } catch (const SemanticError& error) {
         _diagnostics.add(error.report());
         return nullptr;
@@ -4,6 +4,41 @@ using namespace pretty_diagnostics;
 using namespace arkoi::sem;
 using namespace arkoi;
 
+void SymbolTable::enter_scope() {
+    _scopes.push_back(_bindings.size());
+}
+
+void SymbolTable::exit_scope() {
+    if (_scopes.empty()) throw std::logic_error("Cannot exit a scope that was never entered");
+
+    // Restore the bindings that were shadowed by the scope, which unwinds it in reverse order.
+    while (_bindings.size() > _scopes.back()) {
+        const auto& binding = _bindings.back();
+        _innermost[binding.atom] = binding.shadowed;
+        _bindings.pop_back();
+    }
+
+    _scopes.pop_back();
+}
+
+void SymbolTable::bind(const std::shared_ptr<Symbol>& symbol) {
+    if (_scopes.empty()) throw std::logic_error("Cannot bind a symbol without an open scope");
+
+    const auto atom = symbol->name().atom().id();
+    if (_innermost.size() <= atom) _innermost.resize(atom + 1, NONE);
+
+    const auto shadowed = _innermost[atom];
+    _innermost[atom] = _bindings.size();
+    _bindings.emplace_back(symbol, shadowed, atom);
+}
+
+size_t SymbolTable::_innermost_of(const front::Token& identifier) const {
+    const auto atom = identifier.atom().id();
+    if (atom >= _innermost.size()) return NONE;
+
+    return _innermost[atom];
+}
+
 IdentifierAlreadyTaken::IdentifierAlreadyTaken(const front::Token& first, const front::Token& second) :
     SemanticError(
         Report::Builder()
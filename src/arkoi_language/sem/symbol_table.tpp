@@ -1,32 +1,37 @@
 #pragma once
 
 template <typename Type, typename... Args>
-std::shared_ptr<Symbol>& SymbolTable::insert(const front::Token& identifier, Args&&... args) {
-    const auto name = identifier.span().substr();
+const std::shared_ptr<Symbol>& SymbolTable::insert(const front::Token& identifier, Args&&... args) {
+    if (_scopes.empty()) throw std::logic_error("Cannot insert a symbol without an open scope");
 
-    const auto found = _symbols.find(name);
-    if (found != _symbols.end()) {
-        throw IdentifierAlreadyTaken(found->second->name(), identifier);
+    const auto atom = identifier.atom().id();
+    if (_innermost.size() <= atom) _innermost.resize(atom + 1, NONE);
+
+    // Only a binding made since the current scope was entered conflicts, all others are shadowed.
+    const auto shadowed = _innermost[atom];
+    if (shadowed != NONE && shadowed >= _scopes.back()) {
+        throw IdentifierAlreadyTaken(_bindings[shadowed].symbol->name(), identifier);
     }
 
-    auto symbol = std::make_shared<Symbol>(Type(identifier, std::forward<Args>(args)...));
-    auto result = _symbols.emplace(name, symbol);
+    auto symbol = std::allocate_shared<Symbol>(
+        std::pmr::polymorphic_allocator<Symbol>(_resource),
+        Type(identifier, std::forward<Args>(args)...)
+    );
 
-    return result.first->second;
+    _innermost[atom] = _bindings.size();
+    return _bindings.emplace_back(std::move(symbol), shadowed, atom).symbol;
 }
 
 template <typename... Types>
-[[nodiscard]] std::shared_ptr<Symbol>& SymbolTable::lookup(const front::Token& identifier) {
-    const auto name = identifier.span().substr();
-
-    const auto found = _symbols.find(name);
-    if (found != _symbols.end() && (std::holds_alternative<Types>(*found->second) || ...)) {
-        return found->second;
+const std::shared_ptr<Symbol>& SymbolTable::lookup(const front::Token& identifier) const {
+    for (auto index = _innermost_of(identifier); index != NONE; index = _bindings[index].shadowed) {
+        const auto& symbol = _bindings[index].symbol;
+        if ((std::holds_alternative<Types>(*symbol) || ...)) return symbol;
     }
 
-    if (_parent == nullptr) throw IdentifierNotFound(identifier);
+    if (_enclosing) return _enclosing->lookup<Types...>(identifier);
 
-    return _parent->lookup<Types...>(identifier);
+    throw IdentifierNotFound(identifier);
 }
 
 //==============================================================================
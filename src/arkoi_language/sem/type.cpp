@@ -6,14 +6,6 @@
 using namespace arkoi::sem;
 using namespace arkoi;
 
-bool Integral::operator==(const Integral& other) const {
-    return _size == other._size && _sign == other._sign;
-}
-
-bool Integral::operator!=(const Integral& other) const {
-    return !(other == *this);
-}
-
 uint64_t Integral::max() const {
     switch (_size) {
         case Size::BYTE: return _sign ? std::numeric_limits<int8_t>::max() : std::numeric_limits<uint8_t>::max();
@@ -26,41 +18,37 @@ uint64_t Integral::max() const {
     std::unreachable();
 }
 
-bool Floating::operator==(const Floating& other) const {
-    return _size == other._size;
-}
-
-bool Floating::operator!=(const Floating& other) const {
-    return !(other == *this);
+utils::OutputBuffer& sem::operator<<(utils::OutputBuffer& os, const Integral& type) {
+    return os << (type.sign() ? "s" : "u") << size_to_bits(type.size());
 }
 
-bool Boolean::operator==(const Boolean&) const {
-    return true;
+utils::OutputBuffer& sem::operator<<(utils::OutputBuffer& os, const Floating& type) {
+    return os << "f" << size_to_bits(type.size());
 }
 
-bool Boolean::operator!=(const Boolean&) const {
-    return false;
+utils::OutputBuffer& sem::operator<<(utils::OutputBuffer& os, const Boolean&) {
+    return os << "bool";
 }
 
-Size Type::size() const {
-    return std::visit([](const auto& value) { return value.size(); }, *this);
+utils::OutputBuffer& sem::operator<<(utils::OutputBuffer& os, const Type& type) {
+    type.visit([&os](const auto& value) { os << value; });
+    return os;
 }
 
 std::ostream& sem::operator<<(std::ostream& os, const Integral& type) {
-    return os << (type.sign() ? "s" : "u") << size_to_bits(type.size());
+    return utils::OutputBuffer::format(os, type);
 }
 
 std::ostream& sem::operator<<(std::ostream& os, const Floating& type) {
-    return os << "f" << size_to_bits(type.size());
+    return utils::OutputBuffer::format(os, type);
 }
 
-std::ostream& sem::operator<<(std::ostream& os, const Boolean&) {
-    return os << "bool";
+std::ostream& sem::operator<<(std::ostream& os, const Boolean& type) {
+    return utils::OutputBuffer::format(os, type);
 }
 
 std::ostream& sem::operator<<(std::ostream& os, const Type& type) {
-    std::visit([&os](const auto& value) { os << value; }, type);
-    return os;
+    return utils::OutputBuffer::format(os, type);
 }
 
 //==============================================================================
@@ -12,16 +12,26 @@ static constinit Integral BOOL_PROMOTED_INT_TYPE = { Size::DWORD, false };
 static constinit Boolean BOOL_TYPE = { };
 
 void TypeResolver::visit(ast::Program& node) {
+    declare(node);
+
     for (const auto& statement : node.statements()) {
         auto* function = dynamic_cast<ast::Function*>(statement.get());
-        if (function) visit_as_prototype(*function);
+        if (function) resolve(*function, node.arena());
     }
+}
 
+void TypeResolver::declare(ast::Program& node) {
     for (const auto& statement : node.statements()) {
-        statement->accept(*this);
+        auto* function = dynamic_cast<ast::Function*>(statement.get());
+        if (function) visit_as_prototype(*function);
     }
 }
 
+void TypeResolver::resolve(ast::Function& node, ast::Arena& arena) {
+    _arena = &arena;
+    node.accept(*this);
+}
+
 void TypeResolver::visit_as_prototype(ast::Function& node) {
     for (auto& parameter : node.parameters()) {
         parameter.accept(*this);
@@ -257,7 +267,7 @@ void TypeResolver::visit(ast::If& node) {
         throw std::runtime_error("Return statement has a wrong return op.");
     }
 
-    if (!std::holds_alternative<Boolean>(type)) {
+    if (!type.is_boolean()) {
         auto casted_condition = _cast(node.condition(), type, BOOL_TYPE);
         node.set_condition(std::move(casted_condition));
     }
@@ -276,7 +286,7 @@ void TypeResolver::visit(ast::While& node) {
         throw std::runtime_error("Return statement has a wrong return op.");
     }
 
-    if (!std::holds_alternative<Boolean>(type)) {
+    if (!type.is_boolean()) {
         auto casted_condition = _cast(node.condition(), type, BOOL_TYPE);
         node.set_condition(std::move(casted_condition));
     }
@@ -286,8 +296,8 @@ void TypeResolver::visit(ast::While& node) {
 
 // https://en.cppreference.com/w/cpp/language/usual_arithmetic_conversions
 Type TypeResolver::_arithmetic_conversion(const Type& left_type, const Type& right_type) {
-    const auto* floating_left = std::get_if<Floating>(&left_type);
-    const auto* floating_right = std::get_if<Floating>(&right_type);
+    const auto floating_left = left_type.floating();
+    const auto floating_right = right_type.floating();
 
     // Stage 4: If either operand is of a floating-point type, the following rules are applied:
     if (floating_left || floating_right) {
@@ -307,21 +317,19 @@ Type TypeResolver::_arithmetic_conversion(const Type& left_type, const Type& rig
     }
 
     // Stage 5: Both operands are converted to a common op C.
-    auto t1 = std::visit(
+    auto t1 = left_type.visit(
         match{
             [](const Integral& type) -> Integral { return type; },
             [](const Boolean&) -> Integral { return BOOL_PROMOTED_INT_TYPE; },
             [](const auto&) -> Integral { throw std::runtime_error("The left type must be of integral type."); }
-        },
-        left_type
+        }
     );
-    auto t2 = std::visit(
+    auto t2 = right_type.visit(
         match{
             [](const Integral& type) -> Integral { return type; },
             [](const Boolean&) -> Integral { return BOOL_PROMOTED_INT_TYPE; },
             [](const auto&) -> Integral { throw std::runtime_error("The left type must be of integral type."); }
-        },
-        right_type
+        }
     );
 
     // Given the types T1 and T2 as the promoted op (under the rules of integral promotions) of the operands, the
@@ -356,7 +364,7 @@ Type TypeResolver::_arithmetic_conversion(const Type& left_type, const Type& rig
 
 // https://en.cppreference.com/w/cpp/language/implicit_conversion
 bool TypeResolver::_can_implicit_convert(const Type& from, const Type& destination) {
-    return std::visit(
+    return sem::visit(
         match{
             // A prvalue of an integer mid or of unscoped enumeration op can be converted to any other integer mid.
             // If the conversion is listed under integral promotions, it is a promotion and not a conversion.
@@ -388,8 +396,9 @@ bool TypeResolver::_can_implicit_convert(const Type& from, const Type& destinati
     );
 }
 
-std::unique_ptr<ast::Node> TypeResolver::_cast(std::unique_ptr<ast::Node>& node, const Type& from, const Type& to) {
-    return std::make_unique<ast::Cast>(std::move(node), from, to, node->span());
+ast::Owned<ast::Node> TypeResolver::_cast(ast::Owned<ast::Node>& node, const Type& from, const Type& to) {
+    const auto span = node->span();
+    return _arena->make<ast::Cast>(std::move(node), from, to, span);
 }
 
 //==============================================================================
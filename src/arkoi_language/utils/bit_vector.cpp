@@ -0,0 +1,146 @@
+#include "arkoi_language/utils/bit_vector.hpp"
+
+#include <algorithm>
+
+using namespace arkoi::utils;
+
+BitVector::const_iterator::const_iterator(const std::vector<Word>* words, const size_t word) :
+    _words(words), _word(word) {
+    if (_word < _words->size()) _current = (*_words)[_word];
+    _skip_empty();
+}
+
+BitVector::const_iterator& BitVector::const_iterator::operator++() {
+    // Clear the lowest set bit, which is the one currently pointed at.
+    _current &= _current - 1;
+    _skip_empty();
+    return *this;
+}
+
+BitVector::const_iterator BitVector::const_iterator::operator++(int) {
+    auto copy = *this;
+    ++*this;
+    return copy;
+}
+
+bool BitVector::const_iterator::operator==(const const_iterator& other) const {
+    return _word == other._word && _current == other._current;
+}
+
+void BitVector::const_iterator::_skip_empty() {
+    while (_current == 0 && _word < _words->size()) {
+        if (++_word == _words->size()) break;
+        _current = (*_words)[_word];
+    }
+}
+
+bool BitVector::set(const size_t index) {
+    const auto word = index / WORD_BITS;
+    if (word >= _words.size()) _words.resize(word + 1, 0);
+
+    const auto mask = Word(1) << (index % WORD_BITS);
+    const auto was_set = (_words[word] & mask) != 0;
+    _words[word] |= mask;
+
+    return !was_set;
+}
+
+bool BitVector::reset(const size_t index) {
+    const auto word = index / WORD_BITS;
+    if (word >= _words.size()) return false;
+
+    const auto mask = Word(1) << (index % WORD_BITS);
+    const auto was_set = (_words[word] & mask) != 0;
+    _words[word] &= ~mask;
+
+    return was_set;
+}
+
+BitVector& BitVector::operator|=(const BitVector& other) {
+    if (other._words.size() > _words.size()) _words.resize(other._words.size(), 0);
+
+    for (size_t index = 0; index < other._words.size(); index++) {
+        _words[index] |= other._words[index];
+    }
+
+    return *this;
+}
+
+BitVector& BitVector::operator&=(const BitVector& other) {
+    const auto shared = std::min(_words.size(), other._words.size());
+
+    for (size_t index = 0; index < shared; index++) {
+        _words[index] &= other._words[index];
+    }
+
+    std::fill(_words.begin() + static_cast<std::ptrdiff_t>(shared), _words.end(), 0);
+    return *this;
+}
+
+BitVector& BitVector::operator-=(const BitVector& other) {
+    const auto shared = std::min(_words.size(), other._words.size());
+
+    for (size_t index = 0; index < shared; index++) {
+        _words[index] &= ~other._words[index];
+    }
+
+    return *this;
+}
+
+bool BitVector::operator==(const BitVector& other) const {
+    const auto& shorter = _words.size() < other._words.size() ? _words : other._words;
+    const auto& longer = _words.size() < other._words.size() ? other._words : _words;
+
+    if (!std::equal(shorter.begin(), shorter.end(), longer.begin())) return false;
+
+    return std::all_of(
+        longer.begin() + static_cast<std::ptrdiff_t>(shorter.size()),
+        longer.end(),
+        [](const Word word) { return word == 0; }
+    );
+}
+
+size_t BitVector::count() const {
+    size_t count = 0;
+    for (const auto word : _words) count += std::popcount(word);
+    return count;
+}
+
+bool BitVector::none() const {
+    return std::ranges::all_of(_words, [](const Word word) { return word == 0; });
+}
+
+void BitVector::clear() {
+    std::ranges::fill(_words, 0);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,279 @@
+#include "arkoi_language/utils/cache.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "arkoi_language/utils/driver.hpp"
+
+using namespace arkoi::utils;
+using namespace arkoi;
+
+namespace {
+/// The file of an entry holding the diagnostics, which artifact names never collide with.
+constexpr auto DIAGNOSTICS_FILE = "diagnostics";
+
+/**
+ * @brief The 128-bit variant of the FNV-1a hash, computed on two 64-bit halves.
+ */
+class Fnv1a128 {
+public:
+    /**
+     * @brief Hashes the length of @p bytes followed by the bytes, thus concatenations stay distinct.
+     */
+    void update(const std::string_view bytes) {
+        const auto length = static_cast<uint64_t>(bytes.size());
+        for (size_t shift = 0; shift < 64; shift += 8) _byte(static_cast<uint8_t>(length >> shift));
+        for (const auto byte : bytes) _byte(static_cast<uint8_t>(byte));
+    }
+
+    [[nodiscard]] std::string hex() const {
+        constexpr auto HEX_CHARACTERS = "0123456789abcdef";
+
+        std::string result;
+        for (const auto half : { _high, _low }) {
+            for (int shift = 60; shift >= 0; shift -= 4) result += HEX_CHARACTERS[(half >> shift) & 0xF];
+        }
+
+        return result;
+    }
+
+private:
+    void _byte(const uint8_t byte) {
+        _low ^= byte;
+
+        // The prime is 2^88 + 0x13B, thus the product is a small multiplication plus a shift of the low half.
+        constexpr uint64_t PRIME_LOW = 0x13B;
+        const auto carry = ((_low >> 32) * PRIME_LOW + (((_low & 0xFFFFFFFF) * PRIME_LOW) >> 32)) >> 32;
+        _high = _high * PRIME_LOW + carry + (_low << 24);
+        _low = _low * PRIME_LOW;
+    }
+
+private:
+    uint64_t _high{ 0x6C62272E07BB0142 };
+    uint64_t _low{ 0x62B821756295C58D };
+};
+
+/**
+ * @brief Identifies the build of the running compiler by the size and modification time of its executable.
+ */
+std::string executable_stamp() {
+    std::error_code error;
+
+    const auto executable = std::filesystem::read_symlink("/proc/self/exe", error);
+    if (error) return { };
+
+    const auto size = std::filesystem::file_size(executable, error);
+    if (error) return { };
+
+    const auto time = std::filesystem::last_write_time(executable, error);
+    if (error) return { };
+
+    std::ostringstream stamp;
+    stamp << executable.string() << ":" << size << ":" << time.time_since_epoch().count();
+    return stamp.str();
+}
+
+/**
+ * @brief Sums up the sizes of the files of an entry, files that can't be read are skipped.
+ */
+uintmax_t entry_size(const std::filesystem::path& entry) {
+    uintmax_t size = 0;
+
+    std::error_code error;
+    for (auto file = std::filesystem::directory_iterator(entry, error);
+         !error && file != std::filesystem::directory_iterator(); file.increment(error)) {
+        std::error_code size_error;
+        const auto file_size = file->file_size(size_error);
+        if (!size_error) size += file_size;
+    }
+
+    return size;
+}
+} // namespace
+
+Cache::Cache(std::filesystem::path directory, const size_t limit) :
+    _directory(std::move(directory)), _stamp(executable_stamp()), _limit(limit) {
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+}
+
+std::string Cache::key(const std::string_view contents, const std::string_view configuration) const {
+    Fnv1a128 hash;
+    hash.update(_stamp);
+    hash.update(configuration);
+    hash.update(contents);
+    return hash.hex();
+}
+
+std::optional<std::string> Cache::restore(const std::string& key, const std::vector<Artifact>& artifacts) const {
+    const auto entry = _directory / key;
+
+    std::ifstream diagnostics_file(entry / DIAGNOSTICS_FILE, std::ios::binary);
+    if (!diagnostics_file) return std::nullopt;
+
+    std::error_code error;
+    for (const auto& artifact : artifacts) {
+        std::filesystem::copy_file(entry / artifact.name, artifact.path, std::filesystem::copy_options::overwrite_existing, error);
+        if (error) return std::nullopt;
+    }
+
+    std::ostringstream diagnostics;
+    diagnostics << diagnostics_file.rdbuf();
+
+    _touch(entry);
+
+    return diagnostics.str();
+}
+
+void Cache::store(const std::string& key, const std::vector<Artifact>& artifacts, const std::string_view diagnostics) const {
+    _commit(key, [&](const std::filesystem::path& temporary) {
+        std::error_code error;
+        for (const auto& artifact : artifacts) {
+            std::filesystem::copy_file(artifact.path, temporary / artifact.name, error);
+            if (error) return false;
+        }
+
+        std::ofstream diagnostics_file(temporary / DIAGNOSTICS_FILE, std::ios::binary);
+        diagnostics_file << diagnostics;
+        return static_cast<bool>(diagnostics_file);
+    });
+}
+
+std::optional<std::vector<std::string>> Cache::load(
+    const std::string& key, const std::vector<std::string>& names
+) const {
+    const auto entry = _directory / key;
+
+    std::vector<std::string> contents;
+    for (const auto& name : names) {
+        std::ifstream file(entry / name, std::ios::binary);
+        if (!file) return std::nullopt;
+
+        std::ostringstream blob;
+        blob << file.rdbuf();
+        contents.push_back(std::move(blob).str());
+    }
+
+    _touch(entry);
+
+    return contents;
+}
+
+void Cache::save(const std::string& key, const std::vector<Blob>& blobs) const {
+    _commit(key, [&](const std::filesystem::path& temporary) {
+        for (const auto& [name, contents] : blobs) {
+            std::ofstream file(temporary / name, std::ios::binary);
+            file << contents;
+            if (!file) return false;
+        }
+
+        return true;
+    });
+}
+
+void Cache::_commit(const std::string& key, const std::function<bool(const std::filesystem::path&)>& write) const {
+    std::error_code error;
+
+    const auto entry = _directory / key;
+    if (std::filesystem::exists(entry, error)) return;
+
+    // The name of a temporary entry contains a dot, which distinguishes it from the hexadecimal keys.
+    const auto temporary = _directory / (key + "." + generate_temp_path().filename().string());
+    std::filesystem::create_directories(temporary, error);
+    if (error) return;
+
+    if (!write(temporary)) error = std::make_error_code(std::errc::io_error);
+
+    // If another compiler stored the same entry in the meantime, its entry is just as good.
+    if (!error) std::filesystem::rename(temporary, entry, error);
+    if (error) {
+        std::filesystem::remove_all(temporary, error);
+        return;
+    }
+
+    _account(entry_size(entry));
+}
+
+void Cache::_touch(const std::filesystem::path& entry) {
+    // Touching the entry marks it as recently used, thus it's evicted last.
+    std::error_code error;
+    std::filesystem::last_write_time(entry, std::filesystem::file_time_type::clock::now(), error);
+}
+
+void Cache::_account(const uintmax_t size) const {
+    const std::lock_guard lock(_mutex);
+
+    // The first scan already includes the new entry. Entries of other compilers are picked up by the next scan.
+    if (!_size) _size = _evict();
+    else if (*_size += size; *_size > _limit) _size = _evict();
+}
+
+uintmax_t Cache::_evict() const {
+    struct Entry {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        uintmax_t size;
+    };
+
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+
+    std::error_code error;
+    for (auto it = std::filesystem::directory_iterator(_directory, error);
+         !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+        const auto& path = it->path();
+        if (path.filename().string().contains('.')) continue;
+
+        std::error_code entry_error;
+        Entry entry{ path, std::filesystem::last_write_time(path, entry_error), 0 };
+        if (entry_error) continue;
+
+        entry.size = entry_size(path);
+        total += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    if (total <= _limit) return total;
+
+    std::ranges::sort(entries, { }, &Entry::time);
+    for (const auto& entry : entries) {
+        if (total <= _limit) break;
+
+        std::filesystem::remove_all(entry.path, error);
+        total -= entry.size;
+    }
+
+    return total;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,6 +1,7 @@
 #include "arkoi_language/utils/diagnostics.hpp"
 
 #include <algorithm>
+#include <iterator>
 
 #include "pretty_diagnostics/renderer.hpp"
 
@@ -11,6 +12,11 @@ void utils::Diagnostics::add(Report report) {
     _reports.push_back(std::move(report));
 }
 
+void utils::Diagnostics::merge(Diagnostics&& other) {
+    std::ranges::move(other._reports, std::back_inserter(_reports));
+    other._reports.clear();
+}
+
 bool utils::Diagnostics::has_errors() const {
     return std::ranges::any_of(
         _reports,
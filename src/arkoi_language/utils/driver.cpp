@@ -1,34 +1,50 @@
 #include "arkoi_language/utils/driver.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
 #include <fstream>
 #include <iostream>
 #include <random>
+#include <spawn.h>
 #include <sstream>
 #include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
 
 #include "arkoi_language/front/parser.hpp"
 #include "arkoi_language/front/scanner.hpp"
 #include "arkoi_language/il/cfg_printer.hpp"
+#include "arkoi_language/il/effect_analysis.hpp"
 #include "arkoi_language/il/generator.hpp"
+#include "arkoi_language/il/il_parser.hpp"
 #include "arkoi_language/il/il_printer.hpp"
+#include "arkoi_language/il/serializer.hpp"
 #include "arkoi_language/il/ssa.hpp"
-#include "arkoi_language/opt/constant_folding.hpp"
-#include "arkoi_language/opt/constant_propagation.hpp"
-#include "arkoi_language/opt/copy_propagation.hpp"
-#include "arkoi_language/opt/dead_code_elimination.hpp"
 #include "arkoi_language/opt/pass.hpp"
-#include "arkoi_language/opt/simplify_cfg.hpp"
+#include "arkoi_language/opt/pipeline.hpp"
 #include "arkoi_language/sem/name_resolver.hpp"
 #include "arkoi_language/sem/type_resolver.hpp"
+#include "arkoi_language/utils/fingerprint.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+#include "arkoi_language/utils/thread_pool.hpp"
+#include "arkoi_language/utils/time_report.hpp"
+#include "arkoi_language/x86_64/elf.hpp"
+#include "arkoi_language/x86_64/encoder.hpp"
 #include "arkoi_language/x86_64/generator.hpp"
+#include "arkoi_language/x86_64/jit.hpp"
+#include "arkoi_language/x86_64/scheduler.hpp"
 
 using namespace arkoi::utils;
 using namespace arkoi;
 
 std::string random_hex(size_t length) {
-    static std::mt19937_64 rng{ std::random_device{ }() };
-    static std::uniform_int_distribution dist(0, 15);
+    // Temporary paths are requested from multiple compilation units at once, thus every thread owns a generator.
+    thread_local std::mt19937_64 rng{ std::random_device{ }() };
+    thread_local std::uniform_int_distribution dist(0, 15);
     const static auto HEX_CHARACTERS = "0123456789abcdef";
 
     std::string result;
@@ -44,55 +60,515 @@ std::filesystem::path utils::generate_temp_path() {
     return temp_dir / ("arkoi_" + unique_name);
 }
 
-int32_t utils::compile(
+/**
+ * @brief Runs the function passes of the pipeline until none of them changes the function anymore.
+ */
+static void optimize(
+    il::Function& function,
+    const std::shared_ptr<il::AnalysisManager>& analyses,
+    const opt::Pipeline& pipeline,
+    TimeReport* report,
+    Statistics* statistics
+) {
+    opt::PassManager manager(analyses);
+    manager.set_time_report(report);
+    manager.set_statistics(statistics);
+    pipeline.add_function_passes(manager);
+    manager.run(function);
+}
+
+/**
+ * @brief Checks if any block of @p function still allocates memory.
+ */
+static bool has_allocas(il::Function& function) {
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            if (std::holds_alternative<il::Alloca>(instruction)) return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Promotes, optimizes and inlines all functions of the module.
+ *
+ * @param whole_program If the module holds every function of the program, which allows the module passes
+ *                      to change the parameters of its functions.
+ * @param external_calls The calls to functions of the module from functions that aren't part of it.
+ */
+static void optimize_module(
+    il::Module& module,
+    ThreadPool& pool,
+    const opt::Pipeline& pipeline,
+    TimeReport* report,
+    Statistics* statistics,
+    const il::Profile* profile,
+    const bool whole_program,
+    const opt::Pipeline::ExternalCalls& external_calls = { }
+) {
+    // After the IL generation every function is independent of the others, thus the per-function stages
+    // are scheduled onto the pool. The results are stored by index to keep the output deterministic.
+    // The calls carry the effects of their callees, which lets the function passes remove, merge and hoist them.
+    const auto annotate_effects = [&] {
+        if (pipeline.passes().empty()) return;
+
+        const TimeReport::Timer timer(report, "effects");
+        const auto annotated = il::EffectAnalysis(module).annotate(module);
+        if (statistics) statistics->add("effects", "annotated-calls", annotated);
+    };
+
+    annotate_effects();
+
+    std::vector<il::Function*> functions;
+    for (auto& function : module) functions.push_back(&function);
+
+    pool.parallel_for(functions.size(), [&](const size_t index) {
+        auto& function = *functions[index];
+
+        // The labels are still the ones of the IL generator, which are the keys of the profile.
+        if (profile) profile->annotate(function);
+
+        // The dominance computed for the SSA construction stays cached for the optimization passes.
+        auto analyses = std::make_shared<il::AnalysisManager>();
+
+        // The IL generator already emits SSA, thus only the allocas of parsed IL are left to promote.
+        if (has_allocas(function)) {
+            const TimeReport::Timer timer(report, "ssa");
+
+            auto ssa_promoter = il::SSAPromoter(function, *analyses);
+            ssa_promoter.promote();
+
+            if (statistics) {
+                statistics->add("ssa", "promoted-variables", ssa_promoter.candidates().size());
+                statistics->add("ssa", "inserted-phis", ssa_promoter.inserted_phis());
+            }
+        }
+
+        optimize(function, analyses, pipeline, report, statistics);
+    });
+
+    if (!pipeline.has_module_passes()) return;
+
+    // The module passes need to see the whole module and run on the already optimized functions. The
+    // propagated constants and inlined instructions are in SSA form, thus the function passes are run
+    // again on the result.
+    opt::PassManager module_passes;
+    module_passes.set_time_report(report);
+    module_passes.set_statistics(statistics);
+    pipeline.add_module_passes(module_passes, external_calls, whole_program);
+    module_passes.run(module);
+
+    // The functions were simplified and copied, which may have removed loops or calls with unknown effects.
+    annotate_effects();
+
+    functions.clear();
+    for (auto& function : module) functions.push_back(&function);
+
+    pool.parallel_for(functions.size(), [&](const size_t index) {
+        optimize(*functions[index], std::make_shared<il::AnalysisManager>(), pipeline, report, statistics);
+    });
+}
+
+/**
+ * @brief Lowers the phis of all functions of the module and allocates their registers.
+ */
+static std::unordered_map<il::Function*, x86_64::Resolver> allocate(
+    il::Module& module,
+    ThreadPool& pool,
+    const x86_64::AllocatorKind allocator,
+    TimeReport* report,
+    Statistics* statistics,
+    const CodegenOptions& codegen
+) {
+    std::vector<il::Function*> functions;
+    for (auto& function : module) functions.push_back(&function);
+
+    std::vector<x86_64::Resolver> function_resolvers(functions.size());
+    pool.parallel_for(functions.size(), [&](const size_t index) {
+        auto& function = *functions[index];
+
+        if (codegen.schedule) {
+            const TimeReport::Timer timer(report, "scheduler");
+
+            const auto scheduler = x86_64::Scheduler(function);
+            if (statistics) statistics->add("scheduler", "moved-instructions", scheduler.moved());
+        }
+
+        {
+            const TimeReport::Timer timer(report, "phi-lowerer");
+
+            auto phi_lowerer = il::PhiLowerer(function);
+            phi_lowerer.lower();
+
+            if (statistics) {
+                statistics->add("phi-lowerer", "split-edges", phi_lowerer.split_edges());
+                statistics->add("phi-lowerer", "copies", phi_lowerer.copies());
+            }
+        }
+
+        const auto resolve = [&](const auto& assigned, const auto& slots) {
+            const TimeReport::Timer timer(report, "resolver");
+            function_resolvers[index].run(function, assigned, slots, codegen.omit_frame_pointer);
+        };
+
+        if (allocator == x86_64::AllocatorKind::LinearScan) {
+            auto linear_scan = x86_64::LinearScanAllocator(function);
+            {
+                const TimeReport::Timer timer(report, "register-allocation");
+                linear_scan.run();
+            }
+
+            if (report) report->count("register-allocation", "spilled", linear_scan.spilled().size());
+            if (statistics) statistics->add("linear-scan", "spilled-variables", linear_scan.spilled().size());
+            resolve(linear_scan.assigned(), linear_scan.slots());
+        } else {
+            auto graph_coloring = x86_64::RegisterAllocator(function);
+            {
+                const TimeReport::Timer timer(report, "register-allocation");
+                graph_coloring.run();
+            }
+
+            // Every rewrite of the spilled variables is followed by another round of the graph coloring.
+            if (report) {
+                report->count("register-allocation", "spill-rounds", graph_coloring.rounds());
+                report->count("register-allocation", "spilled", graph_coloring.spilled().size());
+            }
+
+            if (statistics) {
+                statistics->add("graph-coloring", "spill-rounds", graph_coloring.rounds());
+                statistics->add("graph-coloring", "spilled-variables", graph_coloring.spilled().size());
+                statistics->add("graph-coloring", "rematerialized-variables", graph_coloring.rematerialized());
+                statistics->add("graph-coloring", "split-ranges", graph_coloring.split_ranges());
+            }
+
+            resolve(graph_coloring.assigned(), graph_coloring.slots());
+        }
+    });
+
+    std::unordered_map<il::Function*, x86_64::Resolver> resolvers;
+    for (size_t index = 0; index < functions.size(); index++) {
+        resolvers.insert_or_assign(functions[index], std::move(function_resolvers[index]));
+    }
+
+    return resolvers;
+}
+
+/**
+ * @brief Adds the hits of every peephole rule of the generator to the statistics.
+ */
+static void count_peephole_hits(x86_64::Generator& asm_generator, Statistics* statistics) {
+    if (!statistics) return;
+
+    const auto& hits = asm_generator.peephole().hits();
+    for (size_t index = 0; index < hits.size(); index++) {
+        statistics->add("peephole", x86_64::PeepholeOptimizer::RULES[index].name, hits[index]);
+    }
+}
+
+/**
+ * @brief Writes the listing of the generator as assembly and encodes it with the integrated assembler.
+ */
+static int32_t emit(
+    const x86_64::Generator& asm_generator,
+    std::ostream* asm_ostream,
+    std::ostream* obj_ostream,
+    x86_64::Encoder* encoder,
+    std::ostream& error_ostream,
+    TimeReport* report
+) {
+    if (asm_ostream) {
+        asm_generator.write(*asm_ostream);
+        asm_ostream->flush();
+    }
+
+    if (obj_ostream || encoder) {
+        const TimeReport::Timer timer(report, "assemble");
+
+        try {
+            auto local_encoder = x86_64::Encoder();
+            auto& target = encoder ? *encoder : local_encoder;
+            for (const auto items : asm_generator.text()) target.encode(items);
+            for (const auto items : asm_generator.data()) target.encode(items);
+            target.finish();
+
+            if (obj_ostream) {
+                x86_64::ElfWriter(target).write(*obj_ostream);
+                obj_ostream->flush();
+            }
+        } catch (const std::invalid_argument& error) {
+            error_ostream << "The integrated assembler failed: " << error.what() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief The results of compiling a single function, which are stored in the cache.
+ */
+struct FunctionRecord {
+    /// The optimized IL of the function, as written by the `il::Serializer`, which is only printed on demand.
+    std::string il{ };
+
+    /// The code of the function, or std::nullopt if the function was inlined into every caller.
+    std::optional<x86_64::Fragment> fragment{ };
+};
+
+static std::optional<FunctionRecord> load_record(const Cache& cache, const std::string& key) {
+    auto blobs = cache.load(key, { "il", "fragment" });
+    if (!blobs) return std::nullopt;
+
+    auto& contents = *blobs;
+    FunctionRecord record{ std::move(contents[0]), std::nullopt };
+
+    const auto& fragment = contents[1];
+
+    // A removed function has no code at all, which is different from an empty fragment.
+    if (!fragment.empty()) {
+        std::istringstream input(fragment);
+        record.fragment = x86_64::Fragment::read(input);
+        if (!record.fragment) return std::nullopt;
+    }
+
+    return record;
+}
+
+static void save_record(const Cache& cache, const std::string& key, const FunctionRecord& record) {
+    std::ostringstream fragment;
+    if (record.fragment) record.fragment->write(fragment);
+
+    cache.save(key, { { "il", record.il }, { "fragment", std::move(fragment).str() } });
+}
+
+/**
+ * @brief Compiles the program function by function, reusing the code of the functions found in the cache.
+ *
+ * Every function is looked up by its fingerprint, which covers all functions it may inline. The
+ * functions that miss are compiled together with everything they may inline, but only they are
+ * allocated and generated; the other functions of that unit merely serve as input for the inliner.
+ * Calls from functions outside of the unit are passed to the inliner, thus its decisions match the
+ * ones of a whole-program compilation as closely as possible.
+ *
+ * A function inlined into every caller has no code of its own. If the cached code of another
+ * function still calls it, it's compiled again and kept regardless of its callers.
+ */
+static int32_t compile_functions(
+    ast::Program& program,
     const std::shared_ptr<pretty_diagnostics::Source>& source,
-    std::ofstream* il_ostream,
-    std::ofstream* cfg_ostream,
-    std::ofstream* asm_ostream
+    std::ostream* il_ostream,
+    std::ostream* cfg_ostream,
+    std::ostream* asm_ostream,
+    std::ostream* obj_ostream,
+    x86_64::Encoder* encoder,
+    ThreadPool& pool,
+    const x86_64::AllocatorKind allocator,
+    std::ostream& error_ostream,
+    const Cache& cache,
+    const std::string_view configuration,
+    TimeReport* report,
+    const opt::Pipeline& pipeline,
+    Statistics* statistics,
+    const ProfileOptions& profile,
+    const CodegenOptions& codegen
 ) {
-    Diagnostics diagnostics;
+    Fingerprinter fingerprinter;
+    {
+        const TimeReport::Timer timer(report, "fingerprint");
+        fingerprinter.visit(program);
+    }
 
-    front::Scanner scanner(source, diagnostics);
-    auto tokens = scanner.tokenize();
+    const auto& names = fingerprinter.functions();
 
-    front::Parser parser(source, std::move(tokens), diagnostics);
-    auto program = parser.parse_program();
+    // Without an entry point every function may be called by another source.
+    std::vector<std::string> roots{ "main" };
+    if (std::ranges::find(names, "main") == names.end()) roots = names;
 
-    if (diagnostics.has_errors()) {
-        diagnostics.render(std::cerr);
-        return 1;
+    std::unordered_set<std::string> needed;
+    for (const auto& root : roots) {
+        const auto reachable = fingerprinter.reachable(root);
+        needed.insert(reachable.begin(), reachable.end());
     }
 
-    auto name_resolver = sem::NameResolver(diagnostics);
-    name_resolver.visit(program);
-    if (diagnostics.has_errors()) {
-        diagnostics.render(std::cerr);
-        return 1;
+    // A function compiled despite being inlined everywhere has different code, thus it's stored separately.
+    const auto key = [&](const std::string& name, const bool kept) {
+        auto kind = std::string(configuration) + (kept ? ";kept" : ";function");
+        return cache.key(fingerprinter.fingerprint(name), kind);
+    };
+
+    std::unordered_map<std::string, FunctionRecord> records;
+    for (const auto& name : needed) {
+        if (auto record = load_record(cache, key(name, false))) records.emplace(name, std::move(*record));
     }
 
-    auto type_resolver = sem::TypeResolver(diagnostics);
-    type_resolver.visit(program);
-    if (diagnostics.has_errors()) {
-        diagnostics.render(std::cerr);
-        return 1;
+    std::unordered_set<std::string> kept;
+    std::unordered_set<std::string> emitted;
+    while (true) {
+        std::unordered_set<std::string> misses;
+        for (const auto& name : needed) {
+            const auto found = records.find(name);
+            if (found == records.end() || (kept.contains(name) && !found->second.fragment)) misses.insert(name);
+        }
+
+        if (!misses.empty()) {
+            // The misses are compiled together with every function they may inline.
+            std::unordered_set<std::string> unit;
+            for (const auto& name : misses) {
+                const auto reachable = fingerprinter.reachable(name);
+                unit.insert(reachable.begin(), reachable.end());
+            }
+
+            std::unordered_map<std::string, size_t> external_calls;
+            for (const auto& name : names) {
+                if (unit.contains(name)) continue;
+
+                for (const auto& callee : fingerprinter.callees(name)) {
+                    if (unit.contains(callee)) external_calls[callee]++;
+                }
+            }
+
+            for (const auto& name : kept) external_calls[name] = std::max<size_t>(external_calls[name], 1);
+
+            auto il_generator = il::Generator(unit, il::Generator::Form::SSA);
+            {
+                const TimeReport::Timer timer(report, "il-generator");
+                il_generator.visit(program);
+            }
+
+            auto module = std::move(il_generator.module());
+
+            // The cached code of the other units calls functions with their signature, thus it can't change.
+            optimize_module(module, pool, pipeline, report, statistics, profile.use, false, external_calls);
+
+            // The code of the other functions of the unit is already known, thus they are dropped.
+            std::vector<std::string> known;
+            for (auto& function : module) {
+                if (!misses.contains(function.name())) known.push_back(function.name());
+            }
+
+            for (const auto& name : known) std::ignore = module.remove(name);
+
+            std::unordered_map<std::string, FunctionRecord> compiled;
+            for (auto& function : module) {
+                std::ostringstream il_output;
+                il::Serializer::write(function, il_output);
+
+                compiled.emplace(function.name(), FunctionRecord{ std::move(il_output).str(), std::nullopt });
+            }
+
+            const auto resolvers = allocate(module, pool, allocator, report, statistics, codegen);
+
+            auto asm_generator = x86_64::Generator(source, module, resolvers);
+            if (profile.generate) asm_generator.instrument(*profile.generate);
+            asm_generator.select_target(codegen.target, codegen.contract);
+            asm_generator.select_debug_info(codegen.debug_info);
+            {
+                const TimeReport::Timer timer(report, "generator");
+                asm_generator.run();
+            }
+
+            count_peephole_hits(asm_generator, statistics);
+
+            for (const auto& name : misses) {
+                auto& record = compiled[name];
+
+                const auto fragment = asm_generator.fragments().find(name);
+                if (fragment != asm_generator.fragments().end()) record.fragment = fragment->second;
+
+                save_record(cache, key(name, kept.contains(name)), record);
+                records.insert_or_assign(name, std::move(record));
+            }
+        }
+
+        // Walk from the entry point through the calls of the fragments, which finds all code reachable at runtime.
+        bool complete = true;
+        emitted.clear();
+
+        auto worklist = roots;
+        while (!worklist.empty()) {
+            const auto name = worklist.back();
+            worklist.pop_back();
+
+            if (!needed.contains(name) || !emitted.insert(name).second) continue;
+
+            const auto& record = records.at(name);
+            if (!record.fragment) {
+                kept.insert(name);
+                complete = false;
+                continue;
+            }
+
+            const auto callees = record.fragment->callees();
+            worklist.insert(worklist.end(), callees.begin(), callees.end());
+        }
+
+        if (complete) break;
     }
 
-    auto il_generator = il::Generator();
-    il_generator.visit(program);
+    std::vector<std::pair<std::string, const x86_64::Fragment*>> fragments;
+    for (const auto& name : names) {
+        if (emitted.contains(name)) fragments.emplace_back(name, &*records.at(name).fragment);
+    }
+
+    if (il_ostream || cfg_ostream) {
+        // The stored IL is only read back for printing, thus it's not needed to reuse the code.
+        il::Module printed;
+        for (const auto& name : names) {
+            if (!emitted.contains(name)) continue;
+
+            auto module = il::Serializer::read(records.at(name).il);
+            if (!module) {
+                error_ostream << "The cached IL of \"" << name << "\" is malformed." << std::endl;
+                return 1;
+            }
+
+            for (auto& function : *module) printed.emplace_back(std::move(function));
+        }
+
+        if (il_ostream) {
+            il::ILPrinter(*il_ostream).visit(printed);
+            il_ostream->flush();
+        }
 
-    auto module = il_generator.module();
-    for (auto& function : module) {
-        auto ssa_promoter = il::SSAPromoter(function);
-        ssa_promoter.promote();
+        if (cfg_ostream) {
+            il::CFGPrinter(*cfg_ostream).visit(printed);
+            cfg_ostream->flush();
+        }
     }
 
-    opt::PassManager manager;
-    manager.add<opt::ConstantFolding>();
-    manager.add<opt::ConstantPropagation>();
-    manager.add<opt::CopyPropagation>();
-    manager.add<opt::DeadCodeElimination>();
-    manager.add<opt::SimplifyCFG>();
-    manager.run(module);
+    il::Module empty;
+    auto asm_generator = x86_64::Generator(source, empty, { });
+    if (profile.generate) asm_generator.instrument(*profile.generate);
+    {
+        const TimeReport::Timer timer(report, "generator");
+        asm_generator.stitch(x86_64::Fragment::call_order(fragments));
+    }
+
+    return emit(asm_generator, asm_ostream, obj_ostream, encoder, error_ostream, report);
+}
+
+/**
+ * @brief Optimizes the whole program in @p module, prints it and generates its code.
+ */
+static int32_t compile_module(
+    il::Module& module,
+    const std::shared_ptr<pretty_diagnostics::Source>& source,
+    std::ostream* il_ostream,
+    std::ostream* cfg_ostream,
+    std::ostream* asm_ostream,
+    std::ostream* obj_ostream,
+    x86_64::Encoder* encoder,
+    ThreadPool& pool,
+    const x86_64::AllocatorKind allocator,
+    std::ostream& error_ostream,
+    TimeReport* report,
+    const opt::Pipeline& pipeline,
+    Statistics* statistics,
+    const ProfileOptions& profile,
+    const CodegenOptions& codegen
+) {
+    optimize_module(module, pool, pipeline, report, statistics, profile.use, true);
 
     if (il_ostream) {
         auto il_printer = il::ILPrinter(*il_ostream);
@@ -106,36 +582,255 @@ int32_t utils::compile(
         cfg_ostream->flush();
     }
 
-    for (auto& function : module) {
-        auto phi_lowerer = il::PhiLowerer(function);
-        phi_lowerer.lower();
+    const auto resolvers = allocate(module, pool, allocator, report, statistics, codegen);
+
+    if (!asm_ostream && !obj_ostream && !encoder) return 0;
+
+    auto asm_generator = x86_64::Generator(source, module, resolvers);
+    if (profile.generate) asm_generator.instrument(*profile.generate);
+    asm_generator.select_target(codegen.target, codegen.contract);
+    asm_generator.select_debug_info(codegen.debug_info);
+    {
+        const TimeReport::Timer timer(report, "generator");
+        asm_generator.run();
     }
 
-    std::unordered_map<il::Function*, x86_64::Resolver> resolvers;
-    for (auto& function : module) {
-        auto allocator = x86_64::RegisterAllocator(function);
-        allocator.run();
+    count_peephole_hits(asm_generator, statistics);
 
-        auto resolver = x86_64::Resolver();
-        resolver.run(function, allocator.assigned());
+    return emit(asm_generator, asm_ostream, obj_ostream, encoder, error_ostream, report);
+}
 
-        resolvers.insert_or_assign(&function, std::move(resolver));
+/**
+ * @brief Returns the functions of the program, in the order they're defined.
+ */
+static std::vector<ast::Function*> functions_of(ast::Program& program) {
+    std::vector<ast::Function*> functions;
+    for (const auto& statement : program.statements()) {
+        auto* function = dynamic_cast<ast::Function*>(statement.get());
+        if (function) functions.push_back(function);
     }
 
-    if (asm_ostream) {
-        auto asm_generator = x86_64::Generator(source, module, resolvers);
-        asm_generator.run();
+    return functions;
+}
 
-        *asm_ostream << asm_generator.output().str();
-        asm_ostream->flush();
+/**
+ * @brief Resolves the names and types of the program, while the bodies of its functions are resolved on the pool.
+ *
+ * The signatures of all functions are declared up front, afterwards each body only reads them. Every body
+ * is resolved into its own branch of the arena and with its own diagnostics, which are merged in the order
+ * of the functions, thus the reports don't depend on how the bodies were scheduled.
+ *
+ * @return True if the program was resolved without any errors.
+ */
+static bool resolve(
+    ast::Program& program,
+    const std::vector<ast::Function*>& functions,
+    ThreadPool& pool,
+    Diagnostics& diagnostics,
+    TimeReport* report
+) {
+    std::vector<ast::Arena*> arenas;
+    for (size_t index = 0; index < functions.size(); index++) arenas.push_back(&program.arena().branch());
+
+    const auto merge = [&](std::vector<Diagnostics>& function_diagnostics) {
+        for (auto& other : function_diagnostics) diagnostics.merge(std::move(other));
+        return !diagnostics.has_errors();
+    };
+
+    std::vector<Diagnostics> name_diagnostics(functions.size());
+    {
+        const TimeReport::Timer timer(report, "name-resolver");
+
+        const auto globals = sem::NameResolver(diagnostics).declare(program);
+        pool.parallel_for(functions.size(), [&](const size_t index) {
+            sem::NameResolver(name_diagnostics[index]).resolve(*functions[index], globals, *arenas[index]);
+        });
     }
+    if (!merge(name_diagnostics)) return false;
 
-    return 0;
+    std::vector<Diagnostics> type_diagnostics(functions.size());
+    {
+        const TimeReport::Timer timer(report, "type-resolver");
+
+        sem::TypeResolver(diagnostics).declare(program);
+        pool.parallel_for(functions.size(), [&](const size_t index) {
+            sem::TypeResolver(type_diagnostics[index]).resolve(*functions[index], *arenas[index]);
+        });
+    }
+    return merge(type_diagnostics);
 }
 
-int32_t utils::run_binary(const std::string& path) {
+/**
+ * @brief Generates the IL of all functions on the pool, which are collected in the order they're defined.
+ */
+static il::Module generate(const std::vector<ast::Function*>& functions, ThreadPool& pool, TimeReport* report) {
+    const TimeReport::Timer timer(report, "il-generator");
+
+    std::vector<il::Module> modules(functions.size());
+    pool.parallel_for(functions.size(), [&](const size_t index) {
+        auto il_generator = il::Generator(il::Generator::Form::SSA);
+        il_generator.generate(*functions[index]);
+        modules[index] = std::move(il_generator.module());
+    });
+
+    il::Module module;
+    for (auto& function_module : modules) {
+        for (auto& function : function_module) module.emplace_back(std::move(function));
+    }
+
+    return module;
+}
+
+int32_t utils::compile(
+    const std::shared_ptr<pretty_diagnostics::Source>& source,
+    std::ostream* il_ostream,
+    std::ostream* cfg_ostream,
+    std::ostream* asm_ostream,
+    std::ostream* obj_ostream,
+    x86_64::Encoder* encoder,
+    const size_t jobs,
+    const x86_64::AllocatorKind allocator,
+    std::ostream& error_ostream,
+    const Cache* cache,
+    const std::string_view configuration,
+    TimeReport* report,
+    const opt::Pipeline& pipeline,
+    Statistics* statistics,
+    const ProfileOptions& profile,
+    const CodegenOptions& codegen,
+    ThreadPool* warm_pool
+) {
+    Diagnostics diagnostics;
+
+    // Printed IL skips the frontend, thus the optimizer and the backend can be run on IL captured elsewhere.
+    if (std::filesystem::path(source->path()).extension() == ".il") {
+        auto module = [&] {
+            const TimeReport::Timer timer(report, "il-parser");
+            return il::ILParser(source, diagnostics).parse();
+        }();
+
+        if (diagnostics.has_errors()) {
+            diagnostics.render(error_ostream);
+            return 1;
+        }
+
+        std::optional<ThreadPool> owned_pool;
+        auto& pool = warm_pool ? *warm_pool : owned_pool.emplace(jobs);
+        return compile_module(
+            module, source, il_ostream, cfg_ostream, asm_ostream, obj_ostream, encoder, pool, allocator, error_ostream,
+            report, pipeline, statistics, profile, codegen
+        );
+    }
+
+    // The parser pulls the tokens on demand, thus the whole token stream is never held in memory. Only
+    // for the time report the tokens are scanned up front, otherwise both stages can't be told apart.
+    front::Scanner scanner(source, diagnostics);
+    auto program = [&] {
+        if (!report) return front::Parser(source, scanner, diagnostics).parse_program();
+
+        std::vector<front::Token> tokens;
+        {
+            const TimeReport::Timer timer(report, "scanner");
+            tokens = scanner.tokenize();
+        }
+
+        const TimeReport::Timer timer(report, "parser");
+        return front::Parser(source, std::move(tokens), diagnostics).parse_program();
+    }();
+
+    if (diagnostics.has_errors()) {
+        diagnostics.render(error_ostream);
+        return 1;
+    }
+
+    std::optional<ThreadPool> owned_pool;
+    auto& pool = warm_pool ? *warm_pool : owned_pool.emplace(jobs);
+
+    // Once their signatures are known, the functions are independent of each other up to the inliner.
+    const auto functions = functions_of(program);
+    if (!resolve(program, functions, pool, diagnostics, report)) {
+        diagnostics.render(error_ostream);
+        return 1;
+    }
+
+    // The cached code of functions is only worth looking up if any code is generated at all.
+    if (cache && (asm_ostream || obj_ostream || encoder)) {
+        return compile_functions(
+            program, source, il_ostream, cfg_ostream, asm_ostream, obj_ostream, encoder, pool, allocator,
+            error_ostream, *cache, configuration, report, pipeline, statistics, profile, codegen
+        );
+    }
+
+    auto module = generate(functions, pool, report);
+    return compile_module(
+        module, source, il_ostream, cfg_ostream, asm_ostream, obj_ostream, encoder, pool, allocator, error_ostream,
+        report, pipeline, statistics, profile, codegen
+    );
+}
+
+
+/**
+ * @brief Waits for the child process @p pid and reports how it terminated to the streams of @p invocation.
+ */
+static int32_t wait_child(const pid_t pid, const Invocation& invocation) {
+    int status;
+    if (waitpid(pid, &status, 0) == -1) {
+        *invocation.error << "Failed to wait for child process." << std::endl;
+        return 1;
+    }
+
+    if (WIFSIGNALED(status)) {
+        const int32_t signal = 128 + WTERMSIG(status);
+        *invocation.error << "Child process terminated by signal: " << signal << std::endl;
+        return signal;
+    }
+
+    if (WIFEXITED(status)) {
+        const int32_t exit_code = WEXITSTATUS(status);
+        *invocation.output << "Executed with exit code: " << exit_code << std::endl;
+        return exit_code;
+    }
+
+    *invocation.error << "Child process terminated abnormally." << std::endl;
+    return 1;
+}
+
+/**
+ * @brief Replaces the standard streams and the working directory of a forked child by those of @p invocation.
+ *
+ * Only async-signal-safe functions are called, as the child of a threaded process may only call those.
+ *
+ * @return True if the working directory could be changed.
+ */
+static bool enter_invocation(const Invocation& invocation) {
+    for (int stream = 0; stream < static_cast<int>(invocation.descriptors.size()); stream++) {
+        if (invocation.descriptors[stream] != stream) dup2(invocation.descriptors[stream], stream);
+    }
+
+    return invocation.directory.empty() || chdir(invocation.directory.c_str()) == 0;
+}
+
+/**
+ * @brief Opens a counter of the user space cycles of the process @p pid, which starts once the process executes.
+ *
+ * @return The file descriptor of the counter, or -1 if performance counters aren't available.
+ */
+static int open_cycle_counter(const pid_t pid) {
+    perf_event_attr attributes{ };
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CPU_CYCLES;
+    attributes.disabled = 1;
+    attributes.enable_on_exec = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, pid, -1, -1, 0));
+}
+
+int32_t utils::run_binary(const std::string& path, RunStatistics* statistics, const Invocation& invocation) {
     if (!std::filesystem::exists(path)) {
-        std::cerr << "Binary does not exist: " << path << std::endl;
+        *invocation.error << "Binary does not exist: " << path << std::endl;
         return 1;
     }
 
@@ -147,81 +842,211 @@ int32_t utils::run_binary(const std::string& path) {
         error
     );
     if (error) {
-        std::cerr << "Failed to set permissions for binary: " << error.message() << std::endl;
+        *invocation.error << "Failed to set permissions for binary: " << error.message() << std::endl;
+        return 1;
+    }
+
+    // When measuring, the child waits until the counter is attached to it, which is signaled by closing the pipe.
+    int gate[2] = { -1, -1 };
+    if (statistics && pipe(gate) == -1) {
+        *invocation.error << "Failed to create a pipe." << std::endl;
         return 1;
     }
 
     const pid_t pid = fork();
     if (pid == -1) {
-        std::cerr << "Failed to fork process." << std::endl;
+        *invocation.error << "Failed to fork process." << std::endl;
         return 1;
     }
 
     if (pid == 0) {
+        // The child must not return into the compiler, which could be a server executing other requests.
+        constexpr std::string_view message = "Failed to execute binary.\n";
+        if (!enter_invocation(invocation)) {
+            (void) !write(STDERR_FILENO, message.data(), message.size());
+            _exit(1);
+        }
+
+        if (statistics) {
+            close(gate[1]);
+
+            char signal;
+            while (read(gate[0], &signal, 1) == -1 && errno == EINTR) { }
+            close(gate[0]);
+        }
+
         execl(path.c_str(), path.c_str(), nullptr);
-        std::cerr << "Failed to execute binary." << std::endl;
+        (void) !write(STDERR_FILENO, message.data(), message.size());
+        _exit(1);
+    }
+
+    if (!statistics) return wait_child(pid, invocation);
+
+    close(gate[0]);
+    const auto counter = open_cycle_counter(pid);
+
+    const auto start = std::chrono::steady_clock::now();
+    close(gate[1]);
+
+    const auto exit_code = wait_child(pid, invocation);
+    statistics->wall = std::chrono::steady_clock::now() - start;
+
+    statistics->cycles.reset();
+    if (counter != -1) {
+        uint64_t cycles;
+        if (read(counter, &cycles, sizeof(cycles)) == sizeof(cycles)) statistics->cycles = cycles;
+        close(counter);
+    }
+
+    return exit_code;
+}
+
+int32_t utils::run_jit(const std::vector<x86_64::Encoder>& modules, const Invocation& invocation) {
+    x86_64::Jit jit;
+    x86_64::Jit::Entry entry;
+    try {
+        for (const auto& module : modules) jit.add(module);
+        jit.load();
+
+        entry = jit.entry("main");
+    } catch (const std::exception& error) {
+        *invocation.error << "Failed to load the program: " << error.what() << std::endl;
         return 1;
     }
 
-    int status;
-    if (waitpid(pid, &status, 0) == -1) {
-        std::cerr << "Failed to wait for child process." << std::endl;
+    const pid_t pid = fork();
+    if (pid == -1) {
+        *invocation.error << "Failed to fork process." << std::endl;
         return 1;
     }
 
-    if (WIFSIGNALED(status)) {
-        const int32_t signal = 128 + WTERMSIG(status);
-        std::cerr << "Child process terminated by signal: " << signal << std::endl;
-        return signal;
+    if (pid == 0) {
+        // The handlers of the compiler are reset, thus a crash terminates the child like a freshly executed binary.
+        for (const auto signal : { SIGSEGV, SIGBUS, SIGFPE, SIGILL }) std::signal(signal, SIG_DFL);
+
+        // Same as the "_start" routine, the result of "main" is passed to the exit syscall.
+        _exit(static_cast<int>(entry() & 0xFF));
     }
 
-    if (WIFEXITED(status)) {
-        const int32_t exit_code = WEXITSTATUS(status);
-        std::cout << "Executed with exit code: " << exit_code << std::endl;
-        return exit_code;
+    return wait_child(pid, invocation);
+}
+
+/**
+ * @brief Creates an anonymous file in memory, which child processes inherit and open through "/dev/fd".
+ *
+ * @param name The name of the file, which is only used for debugging.
+ * @return The descriptor of the file, or -1 if it couldn't be created.
+ */
+static int create_memory_file(const char* name) {
+    return memfd_create(name, 0);
+}
+
+/**
+ * @brief Writes all of @p contents to the descriptor @p fd.
+ */
+static bool write_memory_file(const int fd, const std::string_view contents) {
+    for (size_t written = 0; written < contents.size();) {
+        const auto result = ::write(fd, contents.data() + written, contents.size() - written);
+        if (result == -1 && errno == EINTR) continue;
+        if (result == -1) return false;
+
+        written += static_cast<size_t>(result);
     }
 
-    std::cerr << "Child process terminated abnormally." << std::endl;
-    return 1;
+    return true;
 }
 
-int32_t utils::link(const std::vector<std::string>& object_files, std::ofstream& output, const bool verbose) {
-    const auto temp_path = generate_temp_path().string() + ".o";
+/**
+ * @brief Copies the contents of the descriptor @p fd from its start to @p output.
+ */
+static bool read_memory_file(const int fd, std::ostream& output) {
+    std::array<char, 64 * 1024> buffer{ };
 
-    std::ostringstream command;
-    command << "ld -o " << std::quoted(temp_path);
-    for (const auto& object_file : object_files) command << " " << std::quoted(object_file);
+    off_t offset = 0;
+    while (true) {
+        const auto result = pread(fd, buffer.data(), buffer.size(), offset);
+        if (result == -1 && errno == EINTR) continue;
+        if (result == -1) return false;
+        if (result == 0) return true;
 
-    const auto link_command = command.str();
-    if (verbose) std::cerr << "STAGE=LINKING: " << link_command << std::endl;
+        output.write(buffer.data(), result);
+        offset += result;
+    }
+}
 
-    const auto link_result = std::system(link_command.c_str());
-    if (link_result == -1) return -1;
+/**
+ * @brief Starts the tool of @p arguments, which is searched in the "PATH", without a shell in between.
+ *
+ * @param arguments The name of the tool followed by its arguments.
+ * @param stage The stage printed together with the arguments if @p verbose is set.
+ * @param invocation The streams and the working directory the tool is started with.
+ * @return The id of the started process, or -1 if it couldn't be started.
+ */
+static pid_t spawn_tool(
+    const std::vector<std::string>& arguments,
+    const std::string_view stage,
+    const bool verbose,
+    const Invocation& invocation
+) {
+    if (verbose) {
+        auto& error = *invocation.error;
+        error << "STAGE=" << stage << ":";
+        for (const auto& argument : arguments) error << " " << argument;
+        error << std::endl;
+    }
 
-    const auto link_exit = WEXITSTATUS(link_result);
+    std::vector<char*> argv;
+    argv.reserve(arguments.size() + 1);
+    for (const auto& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
 
-    std::ifstream input(temp_path);
-    output << input.rdbuf();
-    input.close();
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    for (int stream = 0; stream < static_cast<int>(invocation.descriptors.size()); stream++) {
+        const auto descriptor = invocation.descriptors[stream];
+        if (descriptor != stream) posix_spawn_file_actions_adddup2(&actions, descriptor, stream);
+    }
+    if (!invocation.directory.empty()) posix_spawn_file_actions_addchdir_np(&actions, invocation.directory.c_str());
 
-    std::remove(temp_path.c_str());
+    pid_t pid;
+    const auto result = posix_spawnp(&pid, argv.front(), &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
 
-    return link_exit;
+    return result == 0 ? pid : -1;
 }
 
-int32_t utils::assemble(const std::string& input_file, std::ofstream& output, bool verbose) {
-    const auto temp_path = generate_temp_path().string() + ".o";
+/**
+ * @brief Waits for the tool @p pid started by `spawn_tool` without reporting anything.
+ *
+ * @return The exit code of the tool, 128 plus the signal it was terminated by, or -1 if it couldn't be waited for.
+ */
+static int32_t wait_tool(const pid_t pid) {
+    int status;
+    while (waitpid(pid, &status, 0) == -1) {
+        if (errno != EINTR) return -1;
+    }
+
+    if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+    if (WIFEXITED(status)) return WEXITSTATUS(status);
 
-    std::ostringstream command;
-    command << "as -o " << std::quoted(temp_path) << " " << std::quoted(input_file);
+    return -1;
+}
+
+int32_t utils::link(
+    const std::vector<std::string>& object_files,
+    std::ofstream& output,
+    const bool verbose,
+    const Invocation& invocation
+) {
+    const auto temp_path = generate_temp_path().string() + ".o";
 
-    const auto assemble_command = command.str();
-    if (verbose) std::cerr << "STAGE=ASSEMBLING: " << assemble_command << std::endl;
+    std::vector<std::string> arguments{ "ld", "-o", temp_path };
+    arguments.insert(arguments.end(), object_files.begin(), object_files.end());
 
-    const auto assemble_result = std::system(assemble_command.c_str());
-    if (assemble_result == -1) return -1;
+    const auto pid = spawn_tool(arguments, "LINKING", verbose, invocation);
+    if (pid == -1) return -1;
 
-    const auto assemble_exit = WEXITSTATUS(assemble_result);
+    const auto link_exit = wait_tool(pid);
 
     std::ifstream input(temp_path);
     output << input.rdbuf();
@@ -229,9 +1054,84 @@ int32_t utils::assemble(const std::string& input_file, std::ofstream& output, bo
 
     std::remove(temp_path.c_str());
 
+    return link_exit;
+}
+
+int32_t utils::assemble(
+    const std::string& input_file,
+    std::ostream& output,
+    const bool verbose,
+    const Invocation& invocation
+) {
+    // The object is written to a file in memory, thus it never touches the disk before it reaches the output.
+    const auto object_fd = create_memory_file("arkoi.o");
+    if (object_fd == -1) return -1;
+
+    const auto pid = spawn_tool(
+        { "as", "-o", "/dev/fd/" + std::to_string(object_fd), input_file }, "ASSEMBLING", verbose, invocation
+    );
+    const auto assemble_exit = pid == -1 ? -1 : wait_tool(pid);
+    if (assemble_exit == 0 && !read_memory_file(object_fd, output)) {
+        close(object_fd);
+        return -1;
+    }
+
+    close(object_fd);
     return assemble_exit;
 }
 
+int32_t utils::assemble_listings(
+    const std::vector<std::string_view>& listings,
+    const std::vector<std::ostream*>& outputs,
+    const bool verbose,
+    const Invocation& invocation
+) {
+    struct Job {
+        int listing_fd = -1;
+        int object_fd = -1;
+        pid_t pid = -1;
+    };
+
+    // Every assembler is started before the first one is waited for, thus all of them run at the same time.
+    // The assemblers inherit the files and read them through "/dev/fd", which avoids a pipe they could stop reading.
+    std::vector<Job> jobs(listings.size());
+    for (size_t index = 0; index < listings.size(); index++) {
+        auto& job = jobs[index];
+
+        job.listing_fd = create_memory_file("arkoi.s");
+        job.object_fd = create_memory_file("arkoi.o");
+        if (job.listing_fd == -1 || job.object_fd == -1) continue;
+        if (!write_memory_file(job.listing_fd, listings[index])) continue;
+
+        job.pid = spawn_tool({
+            "as", "-o", "/dev/fd/" + std::to_string(job.object_fd), "/dev/fd/" + std::to_string(job.listing_fd)
+        }, "ASSEMBLING", verbose, invocation);
+    }
+
+    int32_t result = 0;
+    for (size_t index = 0; index < jobs.size(); index++) {
+        const auto& job = jobs[index];
+
+        auto assemble_exit = job.pid == -1 ? -1 : wait_tool(job.pid);
+        if (assemble_exit == 0 && !read_memory_file(job.object_fd, *outputs[index])) assemble_exit = -1;
+        if (result == 0) result = assemble_exit;
+
+        if (job.listing_fd != -1) close(job.listing_fd);
+        if (job.object_fd != -1) close(job.object_fd);
+    }
+
+    return result;
+}
+
+int32_t utils::assemble_listing(
+    const std::string_view listing,
+    std::ostream& output,
+    const bool verbose,
+    const Invocation& invocation
+) {
+    return assemble_listings({ listing }, { &output }, verbose, invocation);
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
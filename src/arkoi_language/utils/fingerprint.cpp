@@ -0,0 +1,146 @@
+#include "arkoi_language/utils/fingerprint.hpp"
+
+#include "arkoi_language/ast/nodes.hpp"
+
+using namespace arkoi::utils;
+using namespace arkoi;
+
+void Fingerprinter::visit(ast::Program& node) {
+    for (const auto& item : node.statements()) {
+        item->accept(*this);
+    }
+}
+
+const std::vector<std::string>& Fingerprinter::callees(const std::string& name) const {
+    return _functions.at(name).callees;
+}
+
+std::set<std::string> Fingerprinter::reachable(const std::string& name) const {
+    std::set<std::string> reachable;
+
+    std::vector worklist{ name };
+    while (!worklist.empty()) {
+        const auto current = worklist.back();
+        worklist.pop_back();
+
+        const auto found = _functions.find(current);
+        if (found == _functions.end() || !reachable.insert(current).second) continue;
+
+        worklist.insert(worklist.end(), found->second.callees.begin(), found->second.callees.end());
+    }
+
+    return reachable;
+}
+
+std::string Fingerprinter::fingerprint(const std::string& name) const {
+    std::string fingerprint;
+
+    // Every text is prefixed by its length, thus the concatenation is unambiguous.
+    for (const auto& current : reachable(name)) {
+        const auto& function = _functions.at(current);
+        const auto calls = _calls.contains(current) ? _calls.at(current) : 0;
+
+        fingerprint += std::to_string(current.size()) + ":" + current;
+        fingerprint += ":" + std::to_string(function.line) + ":" + std::to_string(calls);
+        fingerprint += ":" + std::to_string(function.text.size()) + ":" + function.text;
+    }
+
+    return fingerprint;
+}
+
+void Fingerprinter::visit(ast::Function& node) {
+    const auto name = node.name().value().span().substr();
+    const auto span = node.span();
+
+    _order.push_back(name);
+
+    _current = &_functions[name];
+    _current->text = span.substr();
+    _current->line = span.start().row();
+
+    node.block()->accept(*this);
+    _current = nullptr;
+}
+
+void Fingerprinter::visit(ast::Block& node) {
+    for (const auto& item : node.statements()) {
+        item->accept(*this);
+    }
+}
+
+void Fingerprinter::visit(ast::Variable& node) {
+    node.expression()->accept(*this);
+}
+
+void Fingerprinter::visit(ast::Return& node) {
+    node.expression()->accept(*this);
+}
+
+void Fingerprinter::visit(ast::Binary& node) {
+    node.left()->accept(*this);
+    node.right()->accept(*this);
+}
+
+void Fingerprinter::visit(ast::Cast& node) {
+    node.expression()->accept(*this);
+}
+
+void Fingerprinter::visit(ast::Assign& node) {
+    node.expression()->accept(*this);
+}
+
+void Fingerprinter::visit(ast::Call& node) {
+    const auto name = node.name().value().span().substr();
+
+    _current->callees.push_back(name);
+    _calls[name]++;
+
+    for (const auto& argument : node.arguments()) {
+        argument->accept(*this);
+    }
+}
+
+void Fingerprinter::visit(ast::If& node) {
+    node.condition()->accept(*this);
+
+    node.branch()->accept(*this);
+
+    if (node.next()) node.next()->accept(*this);
+}
+
+void Fingerprinter::visit(ast::While& node) {
+    node.condition()->accept(*this);
+
+    node.then()->accept(*this);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
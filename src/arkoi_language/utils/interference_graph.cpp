@@ -0,0 +1,106 @@
+#include "arkoi_language/utils/interference_graph.hpp"
+
+#include <algorithm>
+
+using namespace arkoi::utils;
+using namespace arkoi;
+
+InterferenceGraph<size_t>::InterferenceGraph(const size_t nodes) :
+    _adjacent(nodes), _matrix(nodes * nodes / 2), _nodes(nodes) { }
+
+void InterferenceGraph<size_t>::add_node(const size_t node) {
+    if (node >= _adjacent.size()) _adjacent.resize(node + 1);
+    _nodes.set(node);
+}
+
+void InterferenceGraph<size_t>::remove_node(const size_t node) {
+    if (!_nodes.reset(node)) return;
+
+    for (const auto neighbor : _adjacent[node]) {
+        _matrix.reset(_edge(node, neighbor));
+
+        auto& neighbors = _adjacent[neighbor];
+        neighbors.erase(std::ranges::find(neighbors, node));
+    }
+
+    _adjacent[node].clear();
+}
+
+void InterferenceGraph<size_t>::add_edge(const size_t first, const size_t second) {
+    if (first == second) return;
+
+    add_node(first);
+    add_node(second);
+
+    // The matrix filters duplicates, thus the neighbor vectors never contain a node twice.
+    if (!_matrix.set(_edge(first, second))) return;
+
+    _adjacent[first].push_back(second);
+    _adjacent[second].push_back(first);
+}
+
+bool InterferenceGraph<size_t>::is_interfering(const size_t first, const size_t second) const {
+    if (first == second) return false;
+    return _matrix.test(_edge(first, second));
+}
+
+const std::vector<size_t>& InterferenceGraph<size_t>::interferences(const size_t node) const {
+    static const std::vector<size_t> EMPTY;
+
+    if (!_nodes.test(node)) return EMPTY;
+    return _adjacent[node];
+}
+
+size_t InterferenceGraph<size_t>::_edge(const size_t first, const size_t second) {
+    const auto [row, column] = std::minmax(first, second);
+    return column * (column - 1) / 2 + row;
+}
+
+std::ostream& utils::operator<<(std::ostream& os, const InterferenceGraph<size_t>& graph) {
+    os << "graph InterferenceGraph {\n";
+
+    for (const auto node : graph.nodes()) os << "    \"" << node << "\"\n";
+
+    for (const auto node : graph.nodes()) {
+        for (const auto neighbor : graph.interferences(node)) {
+            if (node < neighbor) continue;
+
+            os << "    \"" << node << "\" -- \"" << neighbor << "\"\n";
+        }
+    }
+
+    os << "}\n";
+
+    return os;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
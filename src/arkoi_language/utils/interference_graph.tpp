@@ -36,19 +36,14 @@ bool InterferenceGraph<Node>::is_interfering(const Node& first, const Node& seco
 }
 
 template <typename Node>
-std::unordered_set<Node> InterferenceGraph<Node>::interferences(const Node& node) const {
+const std::unordered_set<Node>& InterferenceGraph<Node>::interferences(const Node& node) const {
+    static const std::unordered_set<Node> EMPTY;
+
     auto found = _adjacent.find(node);
-    if (found == _adjacent.end()) return { };
+    if (found == _adjacent.end()) return EMPTY;
     return found->second;
 }
 
-template <typename Node>
-std::unordered_set<Node> InterferenceGraph<Node>::nodes() const {
-    std::unordered_set<Node> nodes;
-    for (const auto& [node, _] : _adjacent) nodes.insert(node);
-    return nodes;
-}
-
 template <typename Node>
 std::ostream& operator<<(std::ostream& os, const InterferenceGraph<Node>& graph) {
     os << "graph InterferenceGraph {\n";
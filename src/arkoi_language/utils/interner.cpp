@@ -0,0 +1,116 @@
+#include "arkoi_language/utils/interner.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace arkoi::utils;
+using namespace arkoi;
+
+namespace {
+/**
+ * @brief The side table holding the characters of every interned string.
+ *
+ * The strings are stored in a deque, as it never relocates its elements on
+ * growth, which allows handing out references without holding the lock.
+ */
+struct InternTable {
+    std::unordered_map<std::string_view, uint32_t> ids{ };
+    std::deque<std::string> strings{ };
+    std::shared_mutex mutex{ };
+    size_t scopes{ };
+};
+
+InternTable& intern_table() {
+    static InternTable table;
+    return table;
+}
+} // namespace
+
+Interned::Interned(const std::string_view value) :
+    _hash(std::hash<std::string_view>{ }(value)) {
+    auto& table = intern_table();
+
+    {
+        std::shared_lock lock(table.mutex);
+        if (const auto found = table.ids.find(value); found != table.ids.end()) {
+            _id = found->second;
+            return;
+        }
+    }
+
+    std::unique_lock lock(table.mutex);
+    if (const auto found = table.ids.find(value); found != table.ids.end()) {
+        _id = found->second;
+        return;
+    }
+
+    _id = static_cast<uint32_t>(table.strings.size());
+    const auto& stored = table.strings.emplace_back(value);
+    table.ids.emplace(stored, _id);
+}
+
+bool Interned::operator<(const Interned& rhs) const {
+    if (_id == rhs._id) return false;
+    return str() < rhs.str();
+}
+
+const std::string& Interned::str() const {
+    auto& table = intern_table();
+
+    std::shared_lock lock(table.mutex);
+    return table.strings[_id];
+}
+
+InternScope::InternScope() {
+    auto& table = intern_table();
+
+    std::unique_lock lock(table.mutex);
+    table.scopes++;
+}
+
+InternScope::~InternScope() {
+    auto& table = intern_table();
+
+    std::unique_lock lock(table.mutex);
+    if (--table.scopes != 0 || table.strings.size() <= LIMIT) return;
+
+    table.ids.clear();
+    table.strings.clear();
+}
+
+std::ostream& utils::operator<<(std::ostream& os, const Interned& interned) {
+    return os << interned.str();
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
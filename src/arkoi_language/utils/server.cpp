@@ -0,0 +1,367 @@
+#include "arkoi_language/utils/server.hpp"
+
+#include <array>
+#include <csignal>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+
+using namespace arkoi::utils;
+
+namespace {
+/// The standard input, output and error, which the client passes to the server.
+constexpr size_t STREAMS = 3;
+
+/**
+ * @brief Owns a file descriptor, which is closed once it goes out of scope.
+ */
+class Descriptor {
+public:
+    explicit Descriptor(const int descriptor = -1) :
+        _descriptor(descriptor) { }
+
+    Descriptor(const Descriptor&) = delete;
+    Descriptor& operator=(const Descriptor&) = delete;
+
+    ~Descriptor() {
+        if (_descriptor != -1) close(_descriptor);
+    }
+
+    [[nodiscard]] int get() const { return _descriptor; }
+
+private:
+    int _descriptor;
+};
+
+/**
+ * @brief Creates the address of the Unix socket at @p path.
+ *
+ * @throws std::invalid_argument If the path doesn't fit into the address.
+ */
+sockaddr_un address_of(const std::filesystem::path& path) {
+    sockaddr_un address{ };
+    address.sun_family = AF_UNIX;
+
+    const auto& native = path.native();
+    if (native.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("The socket path " + native + " is too long.");
+    }
+
+    std::memcpy(address.sun_path, native.c_str(), native.size() + 1);
+    return address;
+}
+
+bool write_all(const int descriptor, const void* data, const size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    for (size_t written = 0; written < size;) {
+        // A client that went away must not terminate the server with SIGPIPE.
+        const auto result = send(descriptor, bytes + written, size - written, MSG_NOSIGNAL);
+        if (result == -1 && errno == EINTR) continue;
+        if (result <= 0) return false;
+
+        written += static_cast<size_t>(result);
+    }
+
+    return true;
+}
+
+bool read_all(const int descriptor, void* data, const size_t size) {
+    auto* bytes = static_cast<char*>(data);
+    for (size_t read = 0; read < size;) {
+        const auto result = recv(descriptor, bytes + read, size - read, 0);
+        if (result == -1 && errno == EINTR) continue;
+        if (result <= 0) return false;
+
+        read += static_cast<size_t>(result);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the size of the command line of a process, which no part of a request can exceed.
+ */
+uint64_t max_request_size() {
+    const auto size = sysconf(_SC_ARG_MAX);
+    return size > 0 ? static_cast<uint64_t>(size) : 1 << 21;
+}
+
+/**
+ * @brief Writes @p string prefixed by its length, which `read_string` reads back.
+ */
+bool write_string(const int descriptor, const std::string& string) {
+    const auto size = static_cast<uint64_t>(string.size());
+    return write_all(descriptor, &size, sizeof(size)) && write_all(descriptor, string.data(), string.size());
+}
+
+/**
+ * @brief Reads a string written by `write_string`, a length beyond `max_request_size` is rejected.
+ */
+std::optional<std::string> read_string(const int descriptor) {
+    uint64_t size;
+    if (!read_all(descriptor, &size, sizeof(size))) return std::nullopt;
+    if (size > max_request_size()) return std::nullopt;
+
+    std::string string(size, '\0');
+    if (!read_all(descriptor, string.data(), string.size())) return std::nullopt;
+
+    return string;
+}
+
+/**
+ * @brief Sends the standard streams of the calling process, they're attached to a single byte.
+ */
+bool send_streams(const int descriptor) {
+    constexpr std::array<int, STREAMS> streams{ STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+
+    char byte = 0;
+    iovec vector{ &byte, sizeof(byte) };
+
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(streams))> control{ };
+    msghdr message{ };
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    auto* header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(streams));
+    std::memcpy(CMSG_DATA(header), streams.data(), sizeof(streams));
+
+    return sendmsg(descriptor, &message, MSG_NOSIGNAL) == sizeof(byte);
+}
+
+/**
+ * @brief Receives the standard streams of the client, which are sent by `send_streams`.
+ */
+bool receive_streams(const int descriptor, std::array<std::optional<Descriptor>, STREAMS>& streams) {
+    char byte;
+    iovec vector{ &byte, sizeof(byte) };
+
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * STREAMS)> control{ };
+    msghdr message{ };
+    message.msg_iov = &vector;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    if (recvmsg(descriptor, &message, MSG_CMSG_CLOEXEC) != sizeof(byte)) return false;
+
+    const auto* header = CMSG_FIRSTHDR(&message);
+    if (!header || header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS) return false;
+    if (header->cmsg_len != CMSG_LEN(sizeof(int) * STREAMS)) return false;
+
+    std::array<int, STREAMS> received;
+    std::memcpy(received.data(), CMSG_DATA(header), sizeof(received));
+    for (size_t index = 0; index < STREAMS; index++) streams[index].emplace(received[index]);
+
+    return true;
+}
+
+/**
+ * @brief Writes to a stream of the client, e.g. its standard error.
+ *
+ * Nothing is buffered, thus the output is written in the order it's produced, even if several threads of a
+ * request write to the same stream, and nothing has to be flushed before the client is answered.
+ */
+class DescriptorBuffer final : public std::streambuf {
+public:
+    explicit DescriptorBuffer(const int descriptor) :
+        _descriptor(descriptor) { }
+
+protected:
+    int_type overflow(const int_type character) override {
+        if (traits_type::eq_int_type(character, traits_type::eof())) return traits_type::not_eof(character);
+
+        const auto byte = traits_type::to_char_type(character);
+        return xsputn(&byte, 1) == 1 ? character : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* data, const std::streamsize size) override {
+        for (std::streamsize written = 0; written < size;) {
+            const auto result = write(_descriptor, data + written, static_cast<size_t>(size - written));
+            if (result == -1 && errno == EINTR) continue;
+            if (result <= 0) return written;
+
+            written += result;
+        }
+
+        return size;
+    }
+
+private:
+    int _descriptor;
+};
+
+/**
+ * @brief Receives the request of @p client and executes it with @p handler, see `Server::serve_one`.
+ */
+bool handle(const Descriptor& client, const Server::Handler& handler) {
+    std::array<std::optional<Descriptor>, STREAMS> streams;
+    if (!receive_streams(client.get(), streams)) return false;
+
+    // Every argument takes at least a pointer of the command line, thus a larger count is malformed.
+    uint64_t count;
+    if (!read_all(client.get(), &count, sizeof(count))) return false;
+    if (count > max_request_size() / sizeof(char*)) return false;
+
+    // The working directory is sent first, followed by the arguments.
+    Request request;
+    for (uint64_t index = 0; index <= count; index++) {
+        auto string = read_string(client.get());
+        if (!string) return false;
+
+        if (index == 0) request.directory = std::move(*string);
+        else request.arguments.push_back(std::move(*string));
+    }
+
+    // The relative paths of the arguments are resolved against the directory, which thus has to be absolute.
+    if (!request.directory.is_absolute()) return false;
+
+    DescriptorBuffer output_buffer(streams[STDOUT_FILENO]->get());
+    DescriptorBuffer error_buffer(streams[STDERR_FILENO]->get());
+    std::ostream output(&output_buffer);
+    std::ostream error(&error_buffer);
+
+    std::array<int, STREAMS> descriptors{ };
+    for (size_t index = 0; index < STREAMS; index++) descriptors[index] = streams[index]->get();
+
+    int32_t exit_code = 1;
+    std::error_code status;
+    if (!std::filesystem::is_directory(request.directory, status)) {
+        error << "The working directory " << request.directory << " doesn't exist." << std::endl;
+    } else {
+        try {
+            exit_code = handler(request, { descriptors, output, error });
+        } catch (const std::exception& exception) {
+            error << exception.what() << std::endl;
+        }
+    }
+
+    write_all(client.get(), &exit_code, sizeof(exit_code));
+    return true;
+}
+} // namespace
+
+Server::Server(std::filesystem::path socket) :
+    _socket(std::move(socket)) {
+    const auto address = address_of(_socket);
+
+    _descriptor = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (_descriptor == -1) throw std::system_error(errno, std::generic_category(), "Failed to create the socket");
+
+    // The socket of a server that didn't shut down cleanly would otherwise block the address. Anything else
+    // at the path is left alone, as it was most likely passed by mistake.
+    struct stat status{ };
+    if (lstat(_socket.c_str(), &status) == 0) {
+        if (!S_ISSOCK(status.st_mode)) {
+            close(_descriptor);
+            throw std::system_error(EADDRINUSE, std::generic_category(), "Failed to listen on " + _socket.string());
+        }
+
+        unlink(_socket.c_str());
+    }
+
+    // A request may write into every directory the server has access to, thus no other user may connect. The
+    // permissions are changed before listening, which leaves no moment where others could connect.
+    if (bind(_descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1
+        || chmod(_socket.c_str(), S_IRUSR | S_IWUSR) == -1
+        || listen(_descriptor, SOMAXCONN) == -1) {
+        const auto code = errno;
+        close(_descriptor);
+        throw std::system_error(code, std::generic_category(), "Failed to listen on " + _socket.string());
+    }
+}
+
+Server::~Server() {
+    close(_descriptor);
+
+    std::error_code error;
+    std::filesystem::remove(_socket, error);
+}
+
+void Server::serve(const Handler& handler) {
+    // The output of a request goes to the client, which may close it before the request is done.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    while (true) {
+        const auto client = accept4(_descriptor, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client == -1) continue;
+
+        std::thread([client, &handler] { handle(Descriptor(client), handler); }).detach();
+    }
+}
+
+bool Server::serve_one(const Handler& handler) {
+    const Descriptor client(accept4(_descriptor, nullptr, nullptr, SOCK_CLOEXEC));
+    if (client.get() == -1) return false;
+
+    return handle(client, handler);
+}
+
+std::optional<int32_t> arkoi::utils::forward(const std::filesystem::path& socket, const Request& request) {
+    if (socket.native().size() >= sizeof(sockaddr_un::sun_path)) return std::nullopt;
+    const auto address = address_of(socket);
+
+    const Descriptor connection(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (connection.get() == -1) return std::nullopt;
+    if (connect(connection.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1) {
+        return std::nullopt;
+    }
+
+    // A server that went away before receiving the request hasn't executed anything yet.
+    if (!send_streams(connection.get())) return std::nullopt;
+
+    const auto count = static_cast<uint64_t>(request.arguments.size());
+    if (!write_all(connection.get(), &count, sizeof(count))) return std::nullopt;
+    if (!write_string(connection.get(), request.directory.string())) return std::nullopt;
+    for (const auto& argument : request.arguments) {
+        if (!write_string(connection.get(), argument)) return std::nullopt;
+    }
+
+    // The request has been sent completely, thus a lost connection means it failed on the server.
+    int32_t exit_code;
+    if (!read_all(connection.get(), &exit_code, sizeof(exit_code))) return 1;
+
+    return exit_code;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -11,6 +11,10 @@ size_t size_to_bits(const Size& size) {
 }
 
 std::ostream& operator<<(std::ostream& os, const Size& size) {
+    return arkoi::utils::OutputBuffer::format(os, size);
+}
+
+arkoi::utils::OutputBuffer& operator<<(arkoi::utils::OutputBuffer& os, const Size& size) {
     switch (size) {
         case Size::BYTE: return os << "BYTE";
         case Size::WORD: return os << "WORD";
@@ -0,0 +1,88 @@
+#include "arkoi_language/utils/statistics.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+using namespace arkoi::utils;
+
+void Statistics::add(const std::string_view group, const std::string_view name, const size_t amount) {
+    std::lock_guard lock(_mutex);
+
+    const auto found = std::ranges::find_if(_counters, [&](const Counter& counter) {
+        return counter.group == group && counter.name == name;
+    });
+    if (found != _counters.end()) found->value += amount;
+    else _counters.push_back(Counter{ std::string(group), std::string(name), amount });
+}
+
+size_t Statistics::value(const std::string_view group, const std::string_view name) const {
+    std::lock_guard lock(_mutex);
+
+    const auto found = std::ranges::find_if(_counters, [&](const Counter& counter) {
+        return counter.group == group && counter.name == name;
+    });
+    return found == _counters.end() ? 0 : found->value;
+}
+
+std::vector<Statistics::Counter> Statistics::counters() const {
+    std::vector<Counter> counters;
+    {
+        std::lock_guard lock(_mutex);
+        counters = _counters;
+    }
+
+    // The order of first use depends on the scheduling of the jobs, thus they are sorted to stay comparable.
+    std::ranges::sort(counters, [](const Counter& left, const Counter& right) {
+        if (left.group != right.group) return left.group < right.group;
+        return left.name < right.name;
+    });
+
+    return counters;
+}
+
+void Statistics::print(std::ostream& output) const {
+    const auto counters = this->counters();
+
+    output << "===== Statistics =====\n";
+    output << std::right << std::setw(12) << "Value" << "  " << std::left << std::setw(28) << "Group" << "Counter\n";
+
+    const auto old_flags = output.flags();
+    for (const auto& counter : counters) {
+        if (counter.value == 0) continue;
+
+        output << std::right << std::setw(12) << counter.value << "  "
+               << std::left << std::setw(28) << counter.group << counter.name << "\n";
+    }
+    output.flags(old_flags);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
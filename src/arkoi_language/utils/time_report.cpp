@@ -0,0 +1,175 @@
+#include "arkoi_language/utils/time_report.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sys/resource.h>
+
+using namespace arkoi::utils;
+
+TimeReport::Timer::Timer(TimeReport* report, const std::string_view stage) :
+    _report(report), _stage(stage) {
+    if (!_report) return;
+
+    _rss = peak_rss();
+    _cpu = thread_cpu_time();
+    _wall = std::chrono::steady_clock::now();
+}
+
+TimeReport::Timer::~Timer() {
+    if (!_report) return;
+
+    const auto wall = std::chrono::steady_clock::now() - _wall;
+    const auto cpu = thread_cpu_time() - _cpu;
+    const auto rss = peak_rss() - _rss;
+
+    _report->record(_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(wall), cpu, rss);
+}
+
+void TimeReport::record(
+    const std::string_view stage, const std::chrono::nanoseconds wall, const std::chrono::nanoseconds cpu,
+    const int64_t rss
+) {
+    std::lock_guard lock(_mutex);
+
+    auto& current = _stage(stage);
+    current.wall += wall;
+    current.cpu += cpu;
+    current.rss += rss;
+    current.runs++;
+}
+
+void TimeReport::count(const std::string_view stage, const std::string_view counter, const size_t amount) {
+    std::lock_guard lock(_mutex);
+
+    auto& counters = _stage(stage).counters;
+
+    const auto found = std::ranges::find(counters, counter, &std::pair<std::string, size_t>::first);
+    if (found != counters.end()) found->second += amount;
+    else counters.emplace_back(counter, amount);
+}
+
+std::vector<TimeReport::Stage> TimeReport::stages() const {
+    std::lock_guard lock(_mutex);
+    return _stages;
+}
+
+void TimeReport::print(std::ostream& output) const {
+    const auto stages = this->stages();
+
+    const auto milliseconds = [](const std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+
+    std::chrono::nanoseconds total_wall{ }, total_cpu{ };
+    for (const auto& stage : stages) {
+        total_wall += stage.wall;
+        total_cpu += stage.cpu;
+    }
+
+    output << "===== Time report =====\n";
+    output << std::left << std::setw(28) << "Stage" << std::right
+           << std::setw(12) << "Wall (ms)" << std::setw(8) << "%"
+           << std::setw(12) << "CPU (ms)" << std::setw(12) << "RSS (KiB)"
+           << std::setw(8) << "Runs" << "\n";
+
+    const auto old_flags = output.flags();
+    const auto old_precision = output.precision();
+    output << std::fixed << std::setprecision(3);
+
+    for (const auto& stage : stages) {
+        const auto share = total_wall.count() == 0 ? 0.0 : 100.0 * stage.wall.count() / total_wall.count();
+
+        output << std::left << std::setw(28) << stage.name << std::right
+               << std::setw(12) << milliseconds(stage.wall) << std::setw(7) << std::setprecision(1) << share << "%"
+               << std::setprecision(3)
+               << std::setw(12) << milliseconds(stage.cpu) << std::setw(12) << stage.rss
+               << std::setw(8) << stage.runs;
+
+        for (const auto& [name, value] : stage.counters) output << "  " << name << "=" << value;
+        output << "\n";
+    }
+
+    output << std::left << std::setw(28) << "Total" << std::right
+           << std::setw(12) << milliseconds(total_wall) << std::setw(8) << ""
+           << std::setw(12) << milliseconds(total_cpu) << "\n";
+
+    output.flags(old_flags);
+    output.precision(old_precision);
+}
+
+void TimeReport::print_json(std::ostream& output) const {
+    const auto stages = this->stages();
+
+    // Both names are made up of identifiers and punctuation only, thus quoting them is enough to escape them.
+    output << "{\"stages\":[";
+    for (size_t index = 0; index < stages.size(); index++) {
+        const auto& stage = stages[index];
+        if (index != 0) output << ",";
+
+        output << "{\"name\":" << std::quoted(stage.name)
+               << ",\"wall_ns\":" << stage.wall.count()
+               << ",\"cpu_ns\":" << stage.cpu.count()
+               << ",\"rss_kib\":" << stage.rss
+               << ",\"runs\":" << stage.runs
+               << ",\"counters\":{";
+
+        for (size_t counter = 0; counter < stage.counters.size(); counter++) {
+            if (counter != 0) output << ",";
+            output << std::quoted(stage.counters[counter].first) << ":" << stage.counters[counter].second;
+        }
+
+        output << "}}";
+    }
+    output << "]}\n";
+}
+
+std::chrono::nanoseconds TimeReport::thread_cpu_time() {
+    timespec time{ };
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+int64_t TimeReport::peak_rss() {
+    rusage usage{ };
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+TimeReport::Stage& TimeReport::_stage(const std::string_view stage) {
+    const auto found = std::ranges::find(_stages, stage, &Stage::name);
+    if (found != _stages.end()) return *found;
+
+    return _stages.emplace_back(std::string(stage));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
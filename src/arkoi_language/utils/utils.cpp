@@ -4,8 +4,8 @@
 
 std::string get_base_path(const std::string& path) {
     const auto last_dot = path.find_last_of('.');
-    if (last_dot == std::string::npos || path.substr(last_dot) != ".ark") {
-        throw std::invalid_argument("This is not a valid file path with '.ark' extension.");
+    if (last_dot == std::string::npos || (path.substr(last_dot) != ".ark" && path.substr(last_dot) != ".il")) {
+        throw std::invalid_argument("This is not a valid file path with '.ark' or '.il' extension.");
     }
 
     return path.substr(0, last_dot);
@@ -1,60 +1,81 @@
 #include "arkoi_language/x86_64/allocator.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
 
 #include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi::x86_64;
 using namespace arkoi;
 
+/**
+ * @brief Copies the parameters passed in a register overwritten by integer divisions at the entry of the function.
+ *
+ * A parameter arrives in its register, thus it can't be colored differently if it has to survive a division.
+ * Its uses are renamed to the copy instead, which is colored like any other variable. If the copy isn't live
+ * across a division, it's coalesced with the parameter again.
+ */
+static void copy_division_parameters(il::Function& function) {
+    bool has_division = false;
+    for (auto& block : function) {
+        has_division |= std::ranges::any_of(block.instructions(), RegisterAllocator::is_integer_division);
+    }
+    if (!has_division) return;
+
+    PreColorer pre_colorer(function);
+    pre_colorer.run();
+
+    const auto assigned = pre_colorer.assigned();
+
+    size_t inserted = 0;
+    for (const auto& parameter : function.parameters()) {
+        const auto color = assigned.find(parameter);
+        if (color == assigned.end() || !RegisterAllocator::is_division_register(color->second)) continue;
+
+        const il::Variable copy(parameter.name() + ".arg", parameter.type(), parameter.version());
+        for (auto& block : function) {
+            for (auto& instruction : block) instruction.replace_uses(parameter, copy);
+        }
+
+        auto& instructions = function.entry()->instructions();
+        const auto position = instructions.begin() + static_cast<std::ptrdiff_t>(inserted++);
+        instructions.insert(position, il::Assign(copy, parameter, std::nullopt));
+    }
+}
+
 void PreColorer::run() {
     _function.accept(*this);
 }
 
 Register PreColorer::return_register(const sem::Type& target) {
-    return std::visit(
-        match{
-            [&](const sem::Integral& type) -> Register {
-                return { Register::Base::A, type.size() };
-            },
-            [&](const sem::Floating& type) -> Register {
-                return { Register::Base::XMM0, type.size() };
-            },
-            [&](const sem::Boolean&) -> Register {
-                return { Register::Base::A, Size::BYTE };
-            }
-        },
-        target
-    );
+    // Integrals and booleans are both returned in the A register, just with their own size.
+    const auto base = target.is_floating() ? Register::Base::XMM0 : Register::Base::A;
+    return { base, target.size() };
 }
 
 void PreColorer::visit(il::Function& function) {
     size_t integer = 0, floating = 0;
 
     for (auto& parameter : function.parameters()) {
-        std::visit(
-            match{
-                [&](const sem::Floating& type) {
-                    if (floating >= SSE_ARGUMENT_REGISTERS.size()) return;
-
-                    const auto reg = Register(SSE_ARGUMENT_REGISTERS[floating++], type.size());
-                    _assigned.insert_or_assign(parameter, reg.base());
-                },
-                [&](const sem::Boolean& type) {
-                    if (integer >= INTEGER_ARGUMENT_REGISTERS.size()) return;
-
-                    const auto reg = Register(INTEGER_ARGUMENT_REGISTERS[integer++], type.size());
-                    _assigned.insert_or_assign(parameter, reg.base());
-                },
-                [&](const sem::Integral& type) {
-                    if (integer >= INTEGER_ARGUMENT_REGISTERS.size()) return;
-
-                    const auto reg = Register(INTEGER_ARGUMENT_REGISTERS[integer++], type.size());
-                    _assigned.insert_or_assign(parameter, reg.base());
-                }
-            },
-            parameter.type()
-        );
+        const auto& type = parameter.type();
+
+        if (type.is_floating()) {
+            if (floating >= SSE_ARGUMENT_REGISTERS.size()) continue;
+
+            const auto reg = Register(SSE_ARGUMENT_REGISTERS[floating++], type.size());
+            _assigned.insert_or_assign(parameter, reg.base());
+        } else {
+            if (integer >= INTEGER_ARGUMENT_REGISTERS.size()) continue;
+
+            const auto reg = Register(INTEGER_ARGUMENT_REGISTERS[integer++], type.size());
+            _assigned.insert_or_assign(parameter, reg.base());
+        }
     }
 
     for (auto& block : function) {
@@ -80,17 +101,18 @@ void PreColorer::visit(il::Argument& argument) {
     const auto& result = argument.result();
     const auto& type = result.type();
 
-    if (std::holds_alternative<sem::Integral>(type) || std::holds_alternative<sem::Boolean>(type)) {
-        if (_integer < INTEGER_ARGUMENT_REGISTERS.size()) {
-            const auto reg = Register(INTEGER_ARGUMENT_REGISTERS[_integer++], type.size());
-            _assigned.insert_or_assign(result, reg.base());
-        }
-    } else if (std::holds_alternative<sem::Floating>(type)) {
-        if (_floating < SSE_ARGUMENT_REGISTERS.size()) {
-            const auto reg = Register(SSE_ARGUMENT_REGISTERS[_floating++], type.size());
-            _assigned.insert_or_assign(result, reg.base());
-        }
+    std::optional<Register::Base> base;
+    if (type.is_integral() || type.is_boolean()) {
+        if (_integer < INTEGER_ARGUMENT_REGISTERS.size()) base = INTEGER_ARGUMENT_REGISTERS[_integer++];
+    } else if (type.is_floating()) {
+        if (_floating < SSE_ARGUMENT_REGISTERS.size()) base = SSE_ARGUMENT_REGISTERS[_floating++];
     }
+
+    if (!base) return;
+    _assigned.insert_or_assign(result, *base);
+
+    // A source passed to several calls keeps the register of the first one.
+    if (const auto* source = std::get_if<il::Variable>(&argument.source())) _hints.emplace(*source, *base);
 }
 
 void PreColorer::visit(il::Call&) {
@@ -100,47 +122,51 @@ void PreColorer::visit(il::Call&) {
 }
 
 void RegisterAllocator::run() {
-    do {
+    copy_division_parameters(_function);
+
+    while (true) {
         _renumber();
         _build();
+        _coalesce();
         _simplify();
         _select();
+        _assign_slots();
 
-        if (!_spilled.empty()) {
-            _rewrite();
-            _cleanup();
-        }
-    } while (!_spilled.empty());
+        // Without a rewrite another round would color the same graph again. The spilled variables that are left
+        // just keep no register, thus the resolver assigns them a stack slot instead.
+        if (_spilled.empty() || _rounds == MAX_ROUNDS || !_rewrite()) break;
+
+        _reset();
+        _rounds++;
+    }
 }
 
-void RegisterAllocator::_cleanup() {
-    _graph = utils::InterferenceGraph<il::Variable>();
-    _assigned.clear();
-    _spilled.clear();
+void RegisterAllocator::_reset() {
+    _clobbered.clear();
+    _partners.clear();
+    _variables.clear();
+    _moves.clear();
+    _aliases.clear();
+    _costs.clear();
     _stack.clear();
+    _spilled.clear();
+    _assigned.clear();
+    _hints.clear();
+    _slots.clear();
 }
 
 void RegisterAllocator::_renumber() {
-    _liveness_analysis = std::make_shared<il::InstructionLivenessAnalysis>();
-    _analysis = il::DataflowAnalysis(_liveness_analysis);
-    _analysis.run(_function);
+    _liveness_analysis.run(_function);
+
+    _compact = il::CompactFunction(_function);
+    _variables = _compact.variables();
+
+    _graph = utils::InterferenceGraph<size_t>(_variables.size());
 }
 
 void RegisterAllocator::_build() {
-    for (auto& block : _function) {
-        for (auto& instruction : block) {
-            for (const auto& def : instruction.defs()) {
-                auto* def_variable = std::get_if<il::Variable>(&def);
-                if (!def_variable) continue;
-                _graph.add_node(*def_variable);
-            }
-
-            for (const auto& use : instruction.uses()) {
-                auto* use_variable = std::get_if<il::Variable>(&use);
-                if (!use_variable) continue;
-                _graph.add_node(*use_variable);
-            }
-        }
+    for (size_t index = 0; index < _variables.size(); index++) {
+        _graph.add_node(index);
     }
 
     auto add_clique = [&](auto const& operands) {
@@ -152,98 +178,261 @@ void RegisterAllocator::_build() {
                 auto* j_op = std::get_if<il::Variable>(&operands[j]);
                 if (!j_op) continue;
 
-                _graph.add_edge(*i_op, *j_op);
+                _graph.add_edge(_compact.id(*i_op), _compact.id(*j_op));
             }
         }
     };
 
-    for (const auto& [instruction, outs] : _analysis.out()) {
-        const auto& defs = instruction->defs();
-        const auto& uses = instruction->uses();
-
-        for (const auto& def : defs) {
-            auto* def_variable = std::get_if<il::Variable>(&def);
-            if (!def_variable) continue;
+    for (auto& block : _function) {
+        _liveness_analysis.for_each_live_out(
+            block,
+            [&](const il::Instruction& instruction, const il::SparseLivenessAnalysis::State& outs) {
+                const auto& defs = instruction.defs();
+                const auto& uses = instruction.uses();
+
+                if (is_integer_division(instruction)) {
+                    for (const auto& out : outs) {
+                        auto* out_variable = std::get_if<il::Variable>(&out);
+                        if (!out_variable) continue;
+                        if (std::ranges::find(defs, out) != defs.end()) continue;
+
+                        _clobbered.insert(*out_variable);
+                    }
+                }
 
-            for (const auto& out : outs) {
-                auto* out_variable = std::get_if<il::Variable>(&out);
-                if (!out_variable) continue;
-                if (*def_variable == *out_variable) continue;
+                // The destination of a move holds the same value as its source, thus both may share a
+                // register, even if the source stays alive. Any later redefinition adds the edge anyway. The
+                // same holds for an argument, which is moved into its register at the call.
+                const auto is_move = std::holds_alternative<il::Assign>(instruction)
+                                     || std::holds_alternative<il::Argument>(instruction);
+                const auto* move_source = is_move ? std::get_if<il::Variable>(&uses.front()) : nullptr;
+
+                for (const auto& def : defs) {
+                    auto* def_variable = std::get_if<il::Variable>(&def);
+                    if (!def_variable) continue;
+
+                    for (const auto& out : outs) {
+                        auto* out_variable = std::get_if<il::Variable>(&out);
+                        if (!out_variable) continue;
+                        if (*def_variable == *out_variable) continue;
+                        if (move_source && *move_source == *out_variable) continue;
+
+                        _graph.add_edge(_compact.id(*def_variable), _compact.id(*out_variable));
+                    }
+                }
 
-                _graph.add_edge(*def_variable, *out_variable);
+                add_clique(uses);
+                add_clique(defs);
             }
-        }
-
-        add_clique(uses);
-        add_clique(defs);
+        );
     }
 
     PreColorer pre_colorer(_function);
     pre_colorer.run();
 
+    _hints = pre_colorer.hints();
+
+    const auto& parameters = _function.parameters();
     for (const auto& [variable, color] : pre_colorer.assigned()) {
+        // A pre-colored return value that must survive a division is colored normally instead, the return
+        // instruction moves it into the return register anyway.
+        const auto is_parameter = std::ranges::find(parameters, variable) != parameters.end();
+        if (!is_parameter && _clobbered.contains(variable) && is_division_register(color)) continue;
+
         _assigned.insert_or_assign(variable, color);
     }
+
+    // Every use and definition is weighted by the loop depth, thus variables used in loops are spilled last.
+    // With a profile the executions per call of the block are known, which replace the estimate.
+    static constexpr double LOOP_WEIGHT = 10.0;
+
+    const auto& entry_count = _function.entry()->count();
+
+    const il::LoopAnalysis loops(_function);
+    _costs.assign(_variables.size(), 0.0);
+    _partners.resize(_variables.size());
+    for (const auto& block : _compact.blocks()) {
+        auto weight = std::pow(LOOP_WEIGHT, static_cast<double>(loops.depth(block.source)));
+        if (block.source->count() && entry_count && *entry_count != 0) {
+            weight = static_cast<double>(*block.source->count()) / static_cast<double>(*entry_count);
+        }
+
+        for (size_t index = 0; index < block.size(); index++) {
+            const auto result = block.results[index];
+            if (result != il::CompactFunction::NONE) _costs[result] += weight;
+
+            const auto uses = block.uses(index);
+            for (const auto use : uses) {
+                if (use != il::CompactFunction::NONE) _costs[use] += weight;
+            }
+
+            if (block.opcodes[index] != il::Opcode::Assign || uses.front() == il::CompactFunction::NONE) continue;
+
+            const size_t destination = result, origin = uses.front();
+            _moves.emplace_back(destination, origin);
+
+            _partners[destination].push_back(origin);
+            _partners[origin].push_back(destination);
+        }
+    }
+}
+
+void RegisterAllocator::_coalesce() {
+    _aliases.resize(_variables.size());
+    std::iota(_aliases.begin(), _aliases.end(), 0);
+
+    // Every merge can enable further ones, thus the moves are visited until nothing changes anymore.
+    auto changed = true;
+    while (changed) {
+        changed = false;
+
+        for (const auto& [destination, source] : _moves) {
+            auto first = _alias(destination), second = _alias(source);
+            if (first == second) continue;
+
+            // A pre-colored node is always kept, as its register is fixed already.
+            if (_assigned.contains(_variables[second])) std::swap(first, second);
+            if (!_can_coalesce(first, second)) continue;
+
+            _combine(first, second);
+            changed = true;
+        }
+    }
+}
+
+bool RegisterAllocator::_can_coalesce(const size_t first, const size_t second) const {
+    if (_graph.is_interfering(first, second)) return false;
+
+    const auto& kept = _variables[first];
+    const auto& merged = _variables[second];
+    if (_assigned.contains(merged)) return false;
+
+    const auto registers = _registers(kept);
+    if (!std::ranges::equal(registers, _registers(merged))) return false;
+
+    auto k = registers.size();
+    if (_clobbered.contains(kept) || _clobbered.contains(merged)) {
+        k -= std::ranges::count_if(registers, is_division_register);
+    }
+
+    auto is_significant = [&](const size_t node) {
+        return _assigned.contains(_variables[node]) || _graph.interferences(node).size() >= k;
+    };
+
+    // George: Every significant neighbor of the merged node must already interfere with the pre-colored one.
+    if (const auto color = _assigned.find(kept); color != _assigned.end()) {
+        if (std::ranges::find(registers, color->second) == registers.end()) return false;
+        if (_clobbered.contains(merged) && is_division_register(color->second)) return false;
+
+        return std::ranges::all_of(_graph.interferences(second), [&](const size_t neighbor) {
+            const auto found = _assigned.find(_variables[neighbor]);
+            if (found != _assigned.end()) return found->second != color->second;
+
+            return !is_significant(neighbor) || _graph.is_interfering(neighbor, first);
+        });
+    }
+
+    // Briggs: The merged node must have less than k significant neighbors.
+    utils::BitVector neighbors(_variables.size());
+    for (const auto neighbor : _graph.interferences(first)) neighbors.set(neighbor);
+    for (const auto neighbor : _graph.interferences(second)) neighbors.set(neighbor);
+
+    const auto significant = std::ranges::count_if(neighbors, is_significant);
+    return static_cast<size_t>(significant) < k;
+}
+
+void RegisterAllocator::_combine(const size_t first, const size_t second) {
+    for (const auto neighbor : _graph.interferences(second)) {
+        _graph.add_edge(first, neighbor);
+    }
+
+    _graph.remove_node(second);
+    _aliases[second] = first;
+    _costs[first] += _costs[second];
+
+    if (_clobbered.contains(_variables[second])) _clobbered.insert(_variables[first]);
+
+    const auto partners = _partners[second];
+    _partners[first].insert(_partners[first].end(), partners.begin(), partners.end());
+}
+
+size_t RegisterAllocator::_alias(size_t node) {
+    while (_aliases[node] != node) {
+        _aliases[node] = _aliases[_aliases[node]];
+        node = _aliases[node];
+    }
+
+    return node;
+}
+
+bool RegisterAllocator::is_integer_division(const il::Instruction& instruction) {
+    const auto* binary = std::get_if<il::Binary>(&instruction);
+    if (!binary || binary->op() != il::Binary::Operator::Div) return false;
+
+    return !binary->op_type().is_floating();
+}
+
+bool RegisterAllocator::is_division_register(const Register::Base base) {
+    return base == Register::Base::A || base == Register::Base::D;
+}
+
+std::span<const Register::Base> RegisterAllocator::registers(const il::Variable& variable, const bool live_across_calls) {
+    if (variable.type().is_floating()) {
+        if (live_across_calls) return { };
+        return FLOATING_REGISTERS;
+    }
+
+    if (live_across_calls) return INTEGER_CALLEE_SAVED;
+    return INTEGER_REGISTERS;
 }
 
 void RegisterAllocator::_simplify() {
     auto work_list = _graph.nodes();
 
-    std::unordered_map<il::Variable, size_t> current_degree;
-    for (const auto& node : work_list) {
+    std::vector<size_t> current_degree(_variables.size());
+    for (const auto node : work_list) {
         current_degree[node] = _graph.interferences(node).size();
     }
 
     for (const auto& variable : std::views::keys(_assigned)) {
-        work_list.erase(variable);
+        const auto id = _compact.id(variable);
+        if (id != il::CompactFunction::NONE) work_list.reset(id);
     }
 
-    auto compute_k = [&](const il::Variable& variable) {
-        if (std::holds_alternative<sem::Floating>(variable.type())) {
-            return FLOATING_REGISTERS.size();
-        }
-
-        if (_liveness_analysis->live_across_calls().contains(variable)) {
-            return INTEGER_CALLEE_SAVED.size();
-        }
-
-        return INTEGER_CALLER_SAVED.size();
+    auto compute_k = [&](const size_t node) {
+        return _registers(_variables[node]).size();
     };
 
-    // For now this spill cost is only calculated on its degree.
-    auto spill_cost = [&](const il::Variable& first, const il::Variable& second) {
-        const auto first_size = current_degree[first];
-        const auto first_k = compute_k(first);
-
-        const auto second_size = current_degree[second];
-        const auto second_k = compute_k(second);
-
-        return (first_size * first_k) < (second_size * second_k);
+    // The cost of spilling a node relative to the amount of neighbors it would unblock.
+    auto spill_cost = [&](const size_t node) {
+        return _costs[node] / static_cast<double>(current_degree[node]);
     };
 
-    auto remove_node = [&](const il::Variable& node) {
-        for (const auto& neighbor : _graph.interferences(node)) {
-            if (!current_degree.contains(neighbor)) continue;
+    auto remove_node = [&](const size_t node) {
+        for (const auto neighbor : _graph.interferences(node)) {
             current_degree[neighbor]--;
         }
-        work_list.erase(node);
+        work_list.reset(node);
     };
 
-    while (!work_list.empty()) {
+    while (!work_list.none()) {
         auto result = std::ranges::find_if(
             work_list,
-            [&](const auto& node) {
-                return current_degree[node] < compute_k(node);
+            [&](const auto node) {
+                // A node without any register never takes one from its neighbors.
+                const auto k = compute_k(node);
+                return k == 0 || current_degree[node] < k;
             }
         );
 
         if (result != work_list.end()) {
-            _stack.push_back(*result);
-            remove_node(*result);
+            const auto node = *result;
+            _stack.push_back(node);
+            remove_node(node);
             continue;
         }
 
-        const auto& candidate = *std::max_element(work_list.begin(), work_list.end(), spill_cost);
+        const auto candidate = *std::ranges::min_element(work_list, { }, spill_cost);
         _stack.push_back(candidate);
         remove_node(candidate);
     }
@@ -251,7 +440,8 @@ void RegisterAllocator::_simplify() {
 
 void RegisterAllocator::_select() {
     while (!_stack.empty()) {
-        auto node = _stack.back();
+        const auto index = _stack.back();
+        const auto& node = _variables[index];
         _stack.pop_back();
 
         if (_assigned.contains(node)) {
@@ -259,41 +449,463 @@ void RegisterAllocator::_select() {
         }
 
         std::unordered_set<Register::Base> taken;
-        for (const auto& interference : _graph.interferences(node)) {
-            const auto found = _assigned.find(interference);
+        for (const auto interference : _graph.interferences(index)) {
+            const auto found = _assigned.find(_variables[interference]);
             if (found == _assigned.end()) continue;
 
             taken.insert(found->second);
         }
 
-        auto try_assign = [&](const auto& regs) -> bool {
-            for (const auto base : regs) {
-                if (taken.contains(base)) continue;
-                _assigned[node] = base;
-                return true;
-            }
+        if (_clobbered.contains(node)) {
+            taken.insert(Register::Base::A);
+            taken.insert(Register::Base::D);
+        }
 
-            return false;
+        const auto registers = _registers(node);
+        auto is_free = [&](const Register::Base base) {
+            return !taken.contains(base) && std::ranges::find(registers, base) != registers.end();
         };
 
-        auto succeeded = false;
-        if (std::holds_alternative<sem::Floating>(node.type())) {
-            succeeded = try_assign(FLOATING_REGISTERS);
-        } else if (_liveness_analysis->is_live_across_calls(node)) {
-            succeeded = try_assign(INTEGER_CALLEE_SAVED);
-        } else {
-            succeeded = try_assign(INTEGER_CALLER_SAVED);
+        // Prefer the register of a move-related node, which makes the remaining move redundant.
+        std::optional<Register::Base> chosen;
+        for (const auto partner : _partners[index]) {
+            const auto found = _assigned.find(_variables[_alias(partner)]);
+            if (found == _assigned.end() || !is_free(found->second)) continue;
+
+            chosen = found->second;
+            break;
+        }
+
+        // Otherwise an argument source is computed right into the register it's passed in.
+        if (const auto hint = _hints.find(node); !chosen && hint != _hints.end() && is_free(hint->second)) {
+            chosen = hint->second;
+        }
+
+        if (!chosen) {
+            const auto free = std::ranges::find_if(registers, is_free);
+            if (free != registers.end()) chosen = *free;
         }
 
-        if (!succeeded) {
+        if (chosen) {
+            _assigned[node] = *chosen;
+        } else {
             _spilled.insert(node);
         }
     }
+
+    // The coalesced nodes share the register or stack slot decision of the node they were merged into.
+    for (size_t index = 0; index < _variables.size(); index++) {
+        const auto alias = _alias(index);
+        if (alias == index) continue;
+
+        const auto found = _assigned.find(_variables[alias]);
+        if (found != _assigned.end()) {
+            _assigned.insert_or_assign(_variables[index], found->second);
+        } else {
+            _spilled.insert(_variables[index]);
+        }
+    }
+}
+
+void RegisterAllocator::_assign_slots() {
+    std::vector<std::vector<il::Variable>> owners;
+
+    for (const auto& variable : _spilled) {
+        const auto node = _alias(_compact.id(variable));
+
+        // The resolver sizes a slot for its largest member, thus variables of every size can share one.
+        auto slot = std::ranges::find_if(owners, [&](const std::vector<il::Variable>& members) {
+            return std::ranges::none_of(members, [&](const il::Variable& member) {
+                return _graph.is_interfering(node, _alias(_compact.id(member)));
+            });
+        });
+
+        if (slot == owners.end()) slot = owners.emplace(owners.end());
+        slot->push_back(variable);
+
+        _slots.emplace(variable, std::distance(owners.begin(), slot));
+    }
+}
+
+std::span<const Register::Base> RegisterAllocator::_registers(const il::Variable& variable) const {
+    return registers(variable, _liveness_analysis.is_live_across_calls(variable));
+}
+
+bool RegisterAllocator::_rewrite() {
+    // The liveness is needed to plan every rewrite, thus the function is only changed once all are planned.
+    std::unordered_map<il::BasicBlock*, Edits> edits;
+
+    // The spilled variables are ordered, thus the names of the created variables are deterministic.
+    for (const auto& variable : _spilled) {
+        if (_rewritten.contains(variable)) continue;
+
+        if (_rematerialize(variable, edits)) {
+            _rematerialized++;
+            continue;
+        }
+
+        _split(variable, edits);
+    }
+
+    for (auto& [block, edit] : edits) {
+        auto& instructions = block->instructions();
+
+        for (const auto& [index, from, to] : edit.renames) instructions[index].replace_uses(from, to);
+
+        // The positions refer to the unchanged block, thus the edits are applied from the back.
+        std::ranges::stable_sort(edit.insertions, std::greater{ }, [](const auto& insertion) { return insertion.first; });
+        std::ranges::sort(edit.erasures, std::greater{ });
+
+        auto erasure = edit.erasures.begin();
+        for (auto& [index, instruction] : edit.insertions) {
+            for (; erasure != edit.erasures.end() && *erasure >= index; ++erasure) {
+                instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(*erasure));
+            }
+
+            instructions.insert(instructions.begin() + static_cast<std::ptrdiff_t>(index), std::move(instruction));
+        }
+
+        for (; erasure != edit.erasures.end(); ++erasure) {
+            instructions.erase(instructions.begin() + static_cast<std::ptrdiff_t>(*erasure));
+        }
+    }
+
+    return !edits.empty();
+}
+
+bool RegisterAllocator::_rematerialize(const il::Variable& variable, std::unordered_map<il::BasicBlock*, Edits>& edits) {
+    const auto is_immediate = [](const il::Operand& operand) {
+        return std::holds_alternative<il::Immediate>(operand);
+    };
+
+    // Phi lowering may have assigned the variable in multiple blocks, thus the single definition is searched.
+    il::BasicBlock* definition_block = nullptr;
+    size_t definition_index = 0, definitions = 0;
+    for (auto& block : _function) {
+        for (size_t index = 0; index < block.instructions().size(); index++) {
+            const auto defs = block.instructions()[index].defs();
+            if (std::ranges::find(defs, il::Operand(variable)) == defs.end()) continue;
+
+            definition_block = &block;
+            definition_index = index;
+            definitions++;
+        }
+    }
+    if (definitions != 1) return false;
+
+    auto definition = definition_block->instructions()[definition_index];
+
+    // Returns the definition with another result, if it is a constant.
+    using Recompute = std::function<il::Instruction(const il::Variable&)>;
+    const auto recompute = std::visit(
+        match{
+            [&](il::Assign& assign) -> Recompute {
+                if (!is_immediate(assign.value())) return nullptr;
+
+                return [value = assign.value(), span = assign.span()](const il::Variable& result) {
+                    return il::Assign(result, value, span);
+                };
+            },
+            [&](il::Binary& binary) -> Recompute {
+                if (is_integer_division(definition)) return nullptr;
+                if (!is_immediate(binary.left()) || !is_immediate(binary.right())) return nullptr;
+
+                return [binary](const il::Variable& result) mutable {
+                    return il::Binary(result, binary.left(), binary.op(), binary.right(), binary.op_type(), binary.span());
+                };
+            },
+            [](auto&) -> Recompute { return nullptr; },
+        },
+        static_cast<il::Instruction::variant&>(definition)
+    );
+    if (!recompute) return false;
+
+    edits[definition_block].erasures.push_back(definition_index);
+
+    for (auto& block : _function) {
+        auto& instructions = block.instructions();
+        for (size_t index = 0; index < instructions.size(); index++) {
+            const auto uses = instructions[index].uses();
+            if (std::ranges::find(uses, il::Operand(variable)) == uses.end()) continue;
+
+            const il::Variable copy(variable.name() + ".remat", variable.type(), _rewrites++);
+            _rewritten.insert(copy);
+
+            auto& edit = edits[&block];
+            edit.renames.emplace_back(index, variable, copy);
+            edit.insertions.emplace_back(index, recompute(copy));
+        }
+    }
+
+    return true;
+}
+
+void RegisterAllocator::_split(const il::Variable& variable, std::unordered_map<il::BasicBlock*, Edits>& edits) {
+    const auto available = registers(variable, false).size();
+    const auto is_floating = variable.type().is_floating();
+
+    for (auto& block : _function) {
+        auto& instructions = block.instructions();
+
+        // The amount of variables of the same class that got a register and are live after every instruction.
+        std::vector<size_t> pressure(instructions.size());
+        _liveness_analysis.for_each_live_out(
+            block,
+            [&](const il::Instruction& instruction, const il::SparseLivenessAnalysis::State& outs) {
+                size_t live = 0;
+                for (const auto& out : outs) {
+                    const auto* out_variable = std::get_if<il::Variable>(&out);
+                    if (!out_variable || out_variable->type().is_floating() != is_floating) continue;
+                    if (_assigned.contains(*out_variable)) live++;
+                }
+
+                pressure[static_cast<size_t>(&instruction - instructions.data())] = live;
+            }
+        );
+
+        struct Range {
+            size_t first, last, uses, pressure;
+        };
+
+        std::optional<Range> current;
+        const auto close = [&] {
+            if (current && current->uses > 1 && current->pressure < available) {
+                const il::Variable copy(variable.name() + ".split", variable.type(), _rewrites++);
+                _rewritten.insert(copy);
+
+                auto& edit = edits[&block];
+                for (auto index = current->first; index <= current->last; index++) {
+                    edit.renames.emplace_back(index, variable, copy);
+                }
+                edit.insertions.emplace_back(current->first, il::Assign(copy, variable, std::nullopt));
+                _split_ranges++;
+            }
+
+            current.reset();
+        };
+
+        for (size_t index = 0; index < instructions.size(); index++) {
+            const auto& instruction = instructions[index];
+
+            // A value live across a call could only be kept in a callee-saved register, if any, thus the range ends.
+            if (std::holds_alternative<il::Call>(instruction)) close();
+
+            const auto uses = instruction.uses();
+            if (std::ranges::find(uses, il::Operand(variable)) != uses.end()) {
+                if (!current) current = Range{ index, index, 0, 0 };
+
+                // The copy is live from its definition until the last use, thus the pressure between them counts.
+                for (auto position = current->last; position < index; position++) {
+                    current->pressure = std::max(current->pressure, pressure[position]);
+                }
+
+                current->last = index;
+                current->uses++;
+            }
+
+            const auto defs = instruction.defs();
+            if (std::ranges::find(defs, il::Operand(variable)) != defs.end()) close();
+        }
+
+        close();
+    }
+}
+
+void LinearScanAllocator::run() {
+    copy_division_parameters(_function);
+
+    _build();
+    _scan();
+    _assign_slots();
+}
+
+void LinearScanAllocator::_build() {
+    _liveness_analysis.run(_function);
+
+    const il::CompactFunction compact(_function);
+
+    static constexpr auto UNUSED = std::numeric_limits<size_t>::max();
+    std::vector<std::pair<size_t, size_t>> ranges(compact.variables().size(), { UNUSED, 0 });
+    const auto extend = [&](const uint32_t id, const size_t position) {
+        if (id == il::CompactFunction::NONE) return;
+
+        auto& [start, end] = ranges[id];
+        start = std::min(start, position);
+        end = std::max(end, position);
+    };
+
+    // Every instruction owns two positions, the uses are read before the definitions are written.
+    std::vector<size_t> first_positions;
+    first_positions.reserve(compact.blocks().size());
+
+    size_t index = 0;
+    for (const auto& block : compact.blocks()) {
+        first_positions.push_back(index + 1);
+
+        for (size_t offset = 0; offset < block.size(); offset++) {
+            index++;
+
+            for (const auto use : block.uses(offset)) extend(use, 2 * index);
+            extend(block.results[offset], 2 * index + 1);
+        }
+    }
+
+    // Parameters are live from the entry of the function, before any instruction.
+    std::vector<il::Variable> unused_parameters;
+    for (const auto& parameter : _function.parameters()) {
+        const auto id = compact.id(parameter);
+        if (id != il::CompactFunction::NONE) extend(id, 0);
+        else unused_parameters.push_back(parameter);
+    }
+
+    for (size_t block_index = 0; block_index < compact.blocks().size(); block_index++) {
+        auto& block = *compact.blocks()[block_index].source;
+        const auto* first = block.instructions().data();
+
+        _liveness_analysis.for_each_live_out(
+            block,
+            [&](const il::Instruction& instruction, const il::SparseLivenessAnalysis::State& outs) {
+                const auto offset = static_cast<size_t>(&instruction - first);
+                const auto position = 2 * (first_positions[block_index] + offset) + 1;
+                const auto& defs = instruction.defs();
+
+                for (const auto& out : outs) {
+                    const auto* out_variable = std::get_if<il::Variable>(&out);
+                    if (!out_variable) continue;
+
+                    extend(compact.id(*out_variable), position);
+
+                    if (!RegisterAllocator::is_integer_division(instruction)) continue;
+                    if (std::ranges::find(defs, out) != defs.end()) continue;
+
+                    _clobbered.insert(*out_variable);
+                }
+            }
+        );
+    }
+
+    PreColorer pre_colorer(_function);
+    pre_colorer.run();
+
+    _hints = pre_colorer.hints();
+
+    const auto& parameters = _function.parameters();
+    for (const auto& [variable, color] : pre_colorer.assigned()) {
+        // The same exception as in the graph coloring, the return instruction moves the value anyway.
+        const auto is_parameter = std::ranges::find(parameters, variable) != parameters.end();
+        if (!is_parameter && _clobbered.contains(variable) && RegisterAllocator::is_division_register(color)) continue;
+
+        _assigned.insert_or_assign(variable, color);
+    }
+
+    const auto add_interval = [&](const il::Variable& variable, const size_t start, const size_t end) {
+        const Interval interval{ variable, start, end };
+        _intervals.push_back(interval);
+
+        if (_assigned.contains(variable)) _fixed.push_back(interval);
+    };
+
+    for (size_t id = 0; id < ranges.size(); id++) {
+        add_interval(compact.variables()[id], ranges[id].first, ranges[id].second);
+    }
+    for (const auto& parameter : unused_parameters) add_interval(parameter, 0, 0);
+
+    std::ranges::sort(_intervals, [](const Interval& first, const Interval& second) {
+        if (first.start != second.start) return first.start < second.start;
+        if (first.end != second.end) return first.end < second.end;
+        return first.variable < second.variable;
+    });
+}
+
+void LinearScanAllocator::_scan() {
+    // The active intervals are sorted by their end, thus expired ones are always at the front.
+    std::vector<const Interval*> active;
+
+    const auto activate = [&](const Interval& interval) {
+        const auto position = std::ranges::upper_bound(active, interval.end, { }, &Interval::end);
+        active.insert(position, &interval);
+    };
+
+    for (const auto& interval : _intervals) {
+        while (!active.empty() && active.front()->end < interval.start) active.erase(active.begin());
+
+        if (_assigned.contains(interval.variable)) {
+            activate(interval);
+            continue;
+        }
+
+        std::unordered_set<Register::Base> taken;
+        for (const auto* other : active) taken.insert(_assigned.at(other->variable));
+
+        const auto is_available = [&](const Register::Base base) {
+            if (_clobbered.contains(interval.variable) && RegisterAllocator::is_division_register(base)) return false;
+            return !_is_reserved(base, interval);
+        };
+
+        const auto registers = _registers(interval.variable);
+        const auto is_free = [&](const Register::Base base) { return !taken.contains(base) && is_available(base); };
+
+        // An argument source is preferably computed right into the register it's passed in.
+        auto free = std::ranges::find_if(registers, is_free);
+        if (const auto hint = _hints.find(interval.variable); hint != _hints.end() && is_free(hint->second)) {
+            if (const auto found = std::ranges::find(registers, hint->second); found != registers.end()) free = found;
+        }
+
+        if (free != registers.end()) {
+            _assigned.emplace(interval.variable, *free);
+            activate(interval);
+            continue;
+        }
+
+        // Spill the interval ending last, which frees its register for the longest time.
+        const auto victim = std::find_if(active.rbegin(), active.rend(), [&](const Interval* other) {
+            if (other->end <= interval.end) return false;
+
+            const auto is_fixed = std::ranges::find(_fixed, other->variable, &Interval::variable) != _fixed.end();
+            const auto base = _assigned.at(other->variable);
+            return !is_fixed && std::ranges::find(registers, base) != registers.end() && is_available(base);
+        });
+
+        if (victim == active.rend()) {
+            _spilled.insert(interval.variable);
+            continue;
+        }
+
+        const auto* spilled = *victim;
+        _assigned.emplace(interval.variable, _assigned.at(spilled->variable));
+        _assigned.erase(spilled->variable);
+        _spilled.insert(spilled->variable);
+
+        active.erase(std::next(victim).base());
+        activate(interval);
+    }
+}
+
+void LinearScanAllocator::_assign_slots() {
+    // The intervals are sorted by their start, thus a slot is free once the end of its last interval has passed.
+    std::vector<const Interval*> owners;
+
+    for (const auto& interval : _intervals) {
+        if (!_spilled.contains(interval.variable)) continue;
+
+        auto slot = std::ranges::find_if(owners, [&](const Interval* last) { return last->end < interval.start; });
+
+        if (slot == owners.end()) slot = owners.emplace(owners.end());
+        *slot = &interval;
+
+        _slots.emplace(interval.variable, std::distance(owners.begin(), slot));
+    }
+}
+
+std::span<const Register::Base> LinearScanAllocator::_registers(const il::Variable& variable) const {
+    return RegisterAllocator::registers(variable, _liveness_analysis.is_live_across_calls(variable));
 }
 
-// ReSharper disable once CppMemberFunctionMayBeStatic
-void RegisterAllocator::_rewrite() {
-    // TODO: Add spilled variables to the IL.
+bool LinearScanAllocator::_is_reserved(const Register::Base base, const Interval& interval) const {
+    return std::ranges::any_of(_fixed, [&](const Interval& fixed) {
+        if (fixed.start > interval.end || interval.start > fixed.end) return false;
+        return _assigned.at(fixed.variable) == base;
+    });
 }
 
 // BSD 3-Clause License
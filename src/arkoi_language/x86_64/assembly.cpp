@@ -6,17 +6,17 @@
 using namespace arkoi::x86_64;
 using namespace arkoi;
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Label& label) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Label& label) {
     os << label.name() << ":";
     return os;
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Directive& directive) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Directive& directive) {
     os << directive.text();
     return os;
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Instruction::Opcode& opcode) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Instruction::Opcode& opcode) {
     switch (opcode) {
         case Instruction::Opcode::ADD: return os << "add";
         case Instruction::Opcode::CALL: return os << "call";
@@ -69,29 +69,110 @@ std::ostream& x86_64::operator<<(std::ostream& os, const Instruction::Opcode& op
         case Instruction::Opcode::MOVSS: return os << "movss";
         case Instruction::Opcode::PUSH: return os << "push";
         case Instruction::Opcode::POP: return os << "pop";
+        case Instruction::Opcode::SHL: return os << "shl";
+        case Instruction::Opcode::SHR: return os << "shr";
+        case Instruction::Opcode::SAR: return os << "sar";
+        case Instruction::Opcode::CDQ: return os << "cdq";
+        case Instruction::Opcode::CQO: return os << "cqo";
+        case Instruction::Opcode::CMOVNZ: return os << "cmovnz";
+        case Instruction::Opcode::CMOVE: return os << "cmove";
+        case Instruction::Opcode::CMOVA: return os << "cmova";
+        case Instruction::Opcode::CMOVAE: return os << "cmovae";
+        case Instruction::Opcode::CMOVB: return os << "cmovb";
+        case Instruction::Opcode::CMOVBE: return os << "cmovbe";
+        case Instruction::Opcode::CMOVG: return os << "cmovg";
+        case Instruction::Opcode::CMOVGE: return os << "cmovge";
+        case Instruction::Opcode::CMOVL: return os << "cmovl";
+        case Instruction::Opcode::CMOVLE: return os << "cmovle";
+        case Instruction::Opcode::MOVD: return os << "movd";
+        case Instruction::Opcode::MOVQ: return os << "movq";
+        case Instruction::Opcode::JZ: return os << "jz";
+        case Instruction::Opcode::JA: return os << "ja";
+        case Instruction::Opcode::JAE: return os << "jae";
+        case Instruction::Opcode::JB: return os << "jb";
+        case Instruction::Opcode::JBE: return os << "jbe";
+        case Instruction::Opcode::JG: return os << "jg";
+        case Instruction::Opcode::JGE: return os << "jge";
+        case Instruction::Opcode::JL: return os << "jl";
+        case Instruction::Opcode::JLE: return os << "jle";
+        case Instruction::Opcode::JE: return os << "je";
+        case Instruction::Opcode::JNE: return os << "jne";
+        case Instruction::Opcode::JP: return os << "jp";
+        case Instruction::Opcode::JNP: return os << "jnp";
+        case Instruction::Opcode::LEA: return os << "lea";
+        case Instruction::Opcode::VADDSD: return os << "vaddsd";
+        case Instruction::Opcode::VADDSS: return os << "vaddss";
+        case Instruction::Opcode::VSUBSD: return os << "vsubsd";
+        case Instruction::Opcode::VSUBSS: return os << "vsubss";
+        case Instruction::Opcode::VMULSD: return os << "vmulsd";
+        case Instruction::Opcode::VMULSS: return os << "vmulss";
+        case Instruction::Opcode::VDIVSD: return os << "vdivsd";
+        case Instruction::Opcode::VDIVSS: return os << "vdivss";
+        case Instruction::Opcode::VXORPS: return os << "vxorps";
+        case Instruction::Opcode::VCVTSI2SD: return os << "vcvtsi2sd";
+        case Instruction::Opcode::VCVTSI2SS: return os << "vcvtsi2ss";
+        case Instruction::Opcode::VCVTSS2SD: return os << "vcvtss2sd";
+        case Instruction::Opcode::VCVTSD2SS: return os << "vcvtsd2ss";
+        case Instruction::Opcode::VFMADD231SD: return os << "vfmadd231sd";
+        case Instruction::Opcode::VFMADD231SS: return os << "vfmadd231ss";
+        case Instruction::Opcode::VFMSUB231SD: return os << "vfmsub231sd";
+        case Instruction::Opcode::VFMSUB231SS: return os << "vfmsub231ss";
+        case Instruction::Opcode::VFNMADD231SD: return os << "vfnmadd231sd";
+        case Instruction::Opcode::VFNMADD231SS: return os << "vfnmadd231ss";
+        case Instruction::Opcode::SHLX: return os << "shlx";
+        case Instruction::Opcode::SHRX: return os << "shrx";
+        case Instruction::Opcode::SARX: return os << "sarx";
+        case Instruction::Opcode::ADDPD: return os << "addpd";
+        case Instruction::Opcode::SUBPD: return os << "subpd";
+        case Instruction::Opcode::MULPD: return os << "mulpd";
+        case Instruction::Opcode::DIVPD: return os << "divpd";
+        case Instruction::Opcode::MOVAPD: return os << "movapd";
+        case Instruction::Opcode::MOVHPD: return os << "movhpd";
+        case Instruction::Opcode::UNPCKLPD: return os << "unpcklpd";
+        case Instruction::Opcode::UNPCKHPD: return os << "unpckhpd";
     }
 
     std::unreachable();
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Instruction& instruction) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Instruction& instruction) {
     os << "\t" << instruction.opcode();
     for (size_t index = 0; index < instruction.operands().size(); index++) {
         const auto& operand = instruction.operands()[index];
         if (index != 0) {
-            os << ", " << to_string(operand);
+            os << ", " << operand;
         } else {
-            os << " " << to_string(operand);
+            os << " " << operand;
         }
     }
     return os;
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const AssemblyItem& item) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const AssemblyItem& item) {
     std::visit([&os](const auto& value) { os << value; }, item);
     return os;
 }
 
+std::ostream& x86_64::operator<<(std::ostream& os, const Label& label) {
+    return utils::OutputBuffer::format(os, label);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Directive& directive) {
+    return utils::OutputBuffer::format(os, directive);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Instruction::Opcode& opcode) {
+    return utils::OutputBuffer::format(os, opcode);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Instruction& instruction) {
+    return utils::OutputBuffer::format(os, instruction);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const AssemblyItem& item) {
+    return utils::OutputBuffer::format(os, item);
+}
+
 // BSD 3-Clause License
 //
 // Copyright (c) 2025, Timo Behrend
@@ -0,0 +1,227 @@
+#include "arkoi_language/x86_64/elf.hpp"
+
+#include <array>
+#include <cstring>
+#include <elf.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+/**
+ * @brief The sections of the object file in the order of their headers.
+ */
+enum SectionIndex : uint16_t {
+    NULL_INDEX, TEXT_INDEX, HOT_INDEX, UNLIKELY_INDEX, DATA_INDEX, BSS_INDEX, LITERAL4_INDEX, LITERAL8_INDEX,
+    RELA_TEXT_INDEX, RELA_HOT_INDEX, RELA_UNLIKELY_INDEX, RELA_DATA_INDEX, SYMTAB_INDEX, STRTAB_INDEX, SHSTRTAB_INDEX,
+    SECTION_COUNT,
+};
+
+template <typename Type>
+static void append(std::string& buffer, const Type& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(Type));
+}
+
+static void align(std::string& buffer, const size_t alignment) {
+    buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, '\0');
+}
+
+/**
+ * @brief Appends @p name to the string table and returns its offset.
+ */
+static uint32_t add_string(std::string& table, const std::string& name) {
+    const auto offset = static_cast<uint32_t>(table.size());
+    table.append(name);
+    table.push_back('\0');
+    return offset;
+}
+
+static uint16_t section_index(const Encoder::Section section) {
+    switch (section) {
+        case Encoder::Section::Text: return TEXT_INDEX;
+        case Encoder::Section::Data: return DATA_INDEX;
+        case Encoder::Section::Bss: return BSS_INDEX;
+        case Encoder::Section::Literal4: return LITERAL4_INDEX;
+        case Encoder::Section::Literal8: return LITERAL8_INDEX;
+        case Encoder::Section::Hot: return HOT_INDEX;
+        case Encoder::Section::Unlikely: return UNLIKELY_INDEX;
+    }
+
+    std::unreachable();
+}
+
+void ElfWriter::write(std::ostream& output) const {
+    const auto& symbols = _encoder.symbols();
+
+    // All local symbols must precede the global ones, the null symbol is always the first.
+    std::vector<size_t> order;
+    for (size_t index = 0; index < symbols.size(); index++) {
+        if (!symbols[index].global && symbols[index].section) order.push_back(index);
+    }
+
+    const auto first_global = static_cast<uint32_t>(order.size() + 1);
+    for (size_t index = 0; index < symbols.size(); index++) {
+        if (symbols[index].global || !symbols[index].section) order.push_back(index);
+    }
+
+    std::vector<uint32_t> symbol_indices(symbols.size());
+    std::string strtab(1, '\0');
+    std::string symtab;
+    append(symtab, Elf64_Sym{ });
+
+    for (const auto index : order) {
+        const auto& symbol = symbols[index];
+        symbol_indices[index] = static_cast<uint32_t>(symtab.size() / sizeof(Elf64_Sym));
+
+        const auto bind = (symbol.global || !symbol.section) ? STB_GLOBAL : STB_LOCAL;
+        const auto type = symbol.function ? STT_FUNC : STT_NOTYPE;
+
+        Elf64_Sym entry{ };
+        entry.st_name = add_string(strtab, symbol.name);
+        entry.st_info = ELF64_ST_INFO(bind, type);
+        entry.st_shndx = symbol.section ? section_index(*symbol.section) : SHN_UNDEF;
+        entry.st_value = symbol.offset;
+        entry.st_size = symbol.size;
+        append(symtab, entry);
+    }
+
+    const auto relocations = [&](const Encoder::Section section) {
+        std::string buffer;
+        for (const auto& relocation : _encoder.section(section).relocations) {
+            Elf64_Rela entry{ };
+            entry.r_offset = relocation.offset;
+            entry.r_info = ELF64_R_INFO(symbol_indices[relocation.symbol], relocation.type);
+            entry.r_addend = relocation.addend;
+            append(buffer, entry);
+        }
+        return buffer;
+    };
+
+    std::array<std::string, SECTION_COUNT> contents;
+    for (const auto section : { Encoder::Section::Text, Encoder::Section::Hot, Encoder::Section::Unlikely,
+                                Encoder::Section::Data, Encoder::Section::Literal4, Encoder::Section::Literal8 }) {
+        const auto& bytes = _encoder.section(section).bytes;
+        contents[section_index(section)] = std::string(bytes.begin(), bytes.end());
+    }
+    contents[RELA_TEXT_INDEX] = relocations(Encoder::Section::Text);
+    contents[RELA_HOT_INDEX] = relocations(Encoder::Section::Hot);
+    contents[RELA_UNLIKELY_INDEX] = relocations(Encoder::Section::Unlikely);
+    contents[RELA_DATA_INDEX] = relocations(Encoder::Section::Data);
+    contents[SYMTAB_INDEX] = std::move(symtab);
+    contents[STRTAB_INDEX] = std::move(strtab);
+
+    std::array<Elf64_Shdr, SECTION_COUNT> headers{ };
+    std::string shstrtab(1, '\0');
+    const auto define = [&](const SectionIndex index, const std::string& name, const uint32_t type,
+                            const uint64_t flags, const uint64_t alignment) {
+        auto& header = headers[index];
+        header.sh_name = add_string(shstrtab, name);
+        header.sh_type = type;
+        header.sh_flags = flags;
+        header.sh_addralign = alignment;
+    };
+
+    define(TEXT_INDEX, ".text", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16);
+    define(HOT_INDEX, ".text.hot", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16);
+    define(UNLIKELY_INDEX, ".text.unlikely", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16);
+    define(DATA_INDEX, ".data", SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, 8);
+    define(BSS_INDEX, ".bss", SHT_NOBITS, SHF_ALLOC | SHF_WRITE, 16);
+    define(LITERAL4_INDEX, ".rodata.cst4", SHT_PROGBITS, SHF_ALLOC | SHF_MERGE, 4);
+    define(LITERAL8_INDEX, ".rodata.cst8", SHT_PROGBITS, SHF_ALLOC | SHF_MERGE, 8);
+    define(RELA_TEXT_INDEX, ".rela.text", SHT_RELA, SHF_INFO_LINK, 8);
+    define(RELA_HOT_INDEX, ".rela.text.hot", SHT_RELA, SHF_INFO_LINK, 8);
+    define(RELA_UNLIKELY_INDEX, ".rela.text.unlikely", SHT_RELA, SHF_INFO_LINK, 8);
+    define(RELA_DATA_INDEX, ".rela.data", SHT_RELA, SHF_INFO_LINK, 8);
+    define(SYMTAB_INDEX, ".symtab", SHT_SYMTAB, 0, 8);
+    define(STRTAB_INDEX, ".strtab", SHT_STRTAB, 0, 1);
+    define(SHSTRTAB_INDEX, ".shstrtab", SHT_STRTAB, 0, 1);
+    contents[SHSTRTAB_INDEX] = shstrtab;
+
+    for (const auto& [index, target] : { std::pair{ RELA_TEXT_INDEX, TEXT_INDEX },
+                                         std::pair{ RELA_HOT_INDEX, HOT_INDEX },
+                                         std::pair{ RELA_UNLIKELY_INDEX, UNLIKELY_INDEX },
+                                         std::pair{ RELA_DATA_INDEX, DATA_INDEX } }) {
+        headers[index].sh_link = SYMTAB_INDEX;
+        headers[index].sh_info = target;
+        headers[index].sh_entsize = sizeof(Elf64_Rela);
+    }
+
+    // The linker merges identical entries of these sections across all objects.
+    headers[LITERAL4_INDEX].sh_entsize = 4;
+    headers[LITERAL8_INDEX].sh_entsize = 8;
+
+    headers[SYMTAB_INDEX].sh_link = STRTAB_INDEX;
+    headers[SYMTAB_INDEX].sh_info = first_global;
+    headers[SYMTAB_INDEX].sh_entsize = sizeof(Elf64_Sym);
+
+    // The sections follow the file header, the section headers are placed at the end of the file.
+    std::string buffer(sizeof(Elf64_Ehdr), '\0');
+    for (size_t index = 1; index < SECTION_COUNT; index++) {
+        align(buffer, headers[index].sh_addralign);
+        headers[index].sh_offset = buffer.size();
+
+        // The bss section only has a size, its zeros are left to the loader.
+        if (index == BSS_INDEX) {
+            headers[index].sh_size = _encoder.section(Encoder::Section::Bss).bytes.size();
+            continue;
+        }
+
+        headers[index].sh_size = contents[index].size();
+        buffer.append(contents[index]);
+    }
+
+    align(buffer, 8);
+    const auto header_offset = buffer.size();
+    for (const auto& header : headers) append(buffer, header);
+
+    Elf64_Ehdr header{ };
+    std::memcpy(header.e_ident, ELFMAG, SELFMAG);
+    header.e_ident[EI_CLASS] = ELFCLASS64;
+    header.e_ident[EI_DATA] = ELFDATA2LSB;
+    header.e_ident[EI_VERSION] = EV_CURRENT;
+    header.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+    header.e_type = ET_REL;
+    header.e_machine = EM_X86_64;
+    header.e_version = EV_CURRENT;
+    header.e_shoff = header_offset;
+    header.e_ehsize = sizeof(Elf64_Ehdr);
+    header.e_shentsize = sizeof(Elf64_Shdr);
+    header.e_shnum = SECTION_COUNT;
+    header.e_shstrndx = SHSTRTAB_INDEX;
+    std::memcpy(buffer.data(), &header, sizeof(Elf64_Ehdr));
+
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,883 @@
+#include "arkoi_language/x86_64/encoder.hpp"
+
+#include <array>
+#include <bit>
+#include <elf.h>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+/**
+ * @brief Returns the condition code of a `SETcc`, `CMOVcc` or `Jcc`, which is added to the base opcode.
+ */
+static std::optional<uint8_t> condition_of(const Instruction::Opcode opcode) {
+    switch (opcode) {
+        case Instruction::Opcode::SETB:
+        case Instruction::Opcode::CMOVB:
+        case Instruction::Opcode::JB: return 0x2;
+        case Instruction::Opcode::SETAE:
+        case Instruction::Opcode::CMOVAE:
+        case Instruction::Opcode::JAE: return 0x3;
+        case Instruction::Opcode::SETE:
+        case Instruction::Opcode::CMOVE:
+        case Instruction::Opcode::JZ:
+        case Instruction::Opcode::JE: return 0x4;
+        case Instruction::Opcode::SETNE:
+        case Instruction::Opcode::CMOVNZ:
+        case Instruction::Opcode::JNZ:
+        case Instruction::Opcode::JNE: return 0x5;
+        case Instruction::Opcode::SETBE:
+        case Instruction::Opcode::CMOVBE:
+        case Instruction::Opcode::JBE: return 0x6;
+        case Instruction::Opcode::SETA:
+        case Instruction::Opcode::CMOVA:
+        case Instruction::Opcode::JA: return 0x7;
+        case Instruction::Opcode::SETP:
+        case Instruction::Opcode::JP: return 0xA;
+        case Instruction::Opcode::JNP: return 0xB;
+        case Instruction::Opcode::SETL:
+        case Instruction::Opcode::CMOVL:
+        case Instruction::Opcode::JL: return 0xC;
+        case Instruction::Opcode::SETGE:
+        case Instruction::Opcode::CMOVGE:
+        case Instruction::Opcode::JGE: return 0xD;
+        case Instruction::Opcode::SETLE:
+        case Instruction::Opcode::CMOVLE:
+        case Instruction::Opcode::JLE: return 0xE;
+        case Instruction::Opcode::SETG:
+        case Instruction::Opcode::CMOVG:
+        case Instruction::Opcode::JG: return 0xF;
+        default: return std::nullopt;
+    }
+}
+
+static bool is_sse(const Register& reg) {
+    return reg.base() >= Register::Base::XMM0;
+}
+
+/**
+ * @brief Returns the 4-bit register number, the upper bit is encoded in the REX prefix.
+ */
+static uint8_t number(const Register& reg) {
+    const auto base = static_cast<uint8_t>(reg.base());
+    if (is_sse(reg)) return base - static_cast<uint8_t>(Register::Base::XMM0);
+
+    // Unlike the hardware, `Register::Base` orders SI and DI before SP and BP.
+    switch (reg.base()) {
+        case Register::Base::SI: return 6;
+        case Register::Base::DI: return 7;
+        case Register::Base::SP: return 4;
+        case Register::Base::BP: return 5;
+        default: return base;
+    }
+}
+
+/**
+ * @brief Checks if @p operand is one of `SPL`, `BPL`, `SIL` or `DIL`, which without a REX prefix encode `AH` to `BH`.
+ */
+static bool needs_rex(const Operand& operand) {
+    const auto* reg = std::get_if<Register>(&operand);
+    if (!reg || reg->size() != Size::BYTE) return false;
+
+    const auto base = reg->base();
+    return base == Register::Base::SP || base == Register::Base::BP || base == Register::Base::SI
+           || base == Register::Base::DI;
+}
+
+static Size size_of(const Operand& operand) {
+    if (const auto* reg = std::get_if<Register>(&operand)) return reg->size();
+    if (const auto* memory = std::get_if<Memory>(&operand)) return memory->size();
+
+    throw std::invalid_argument("Immediates have no operand size.");
+}
+
+static const Register& register_of(const Operand& operand) {
+    const auto* reg = std::get_if<Register>(&operand);
+    if (!reg) throw std::invalid_argument("Expected a register operand.");
+
+    return *reg;
+}
+
+/**
+ * @brief Interprets the immediate as signed value of the given size, just like the processor sign-extends it.
+ */
+static int64_t immediate_of(const Operand& operand, const Size size) {
+    const auto value = std::visit(
+        match{
+            [](const std::string&) -> int64_t { throw std::invalid_argument("Labels can only be used as targets."); },
+            [](const double) -> int64_t { throw std::invalid_argument("Floating immediates can't be encoded."); },
+            [](const float) -> int64_t { throw std::invalid_argument("Floating immediates can't be encoded."); },
+            [](const bool value) -> int64_t { return value; },
+            [](const auto value) -> int64_t { return static_cast<int64_t>(value); },
+        },
+        std::get<Immediate>(operand)
+    );
+
+    switch (size) {
+        case Size::BYTE: return static_cast<int8_t>(value);
+        case Size::WORD: return static_cast<int16_t>(value);
+        case Size::DWORD: return static_cast<int32_t>(value);
+        case Size::QWORD: return value;
+    }
+
+    // As the -Wswitch flag is set, this will never be reached.
+    std::unreachable();
+}
+
+static bool fits_int8(const int64_t value) {
+    return value >= std::numeric_limits<int8_t>::min() && value <= std::numeric_limits<int8_t>::max();
+}
+
+static bool fits_int32(const int64_t value) {
+    return value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+}
+
+/**
+ * @brief Returns the size of the immediate field, 64-bit operations only take sign-extended 32-bit immediates.
+ */
+static size_t immediate_size(const Size size, const int64_t value) {
+    if (size == Size::QWORD && !fits_int32(value)) {
+        throw std::invalid_argument("The immediate " + std::to_string(value) + " does not fit into 32 bits.");
+    }
+
+    return std::min<size_t>(size_to_bytes(size), 4);
+}
+
+/**
+ * @brief The recommended multi-byte NOPs from the Intel SDM, indexed by their length minus one.
+ */
+static const std::array<std::vector<uint8_t>, 9> NOPS{ {
+    { 0x90 },
+    { 0x66, 0x90 },
+    { 0x0F, 0x1F, 0x00 },
+    { 0x0F, 0x1F, 0x40, 0x00 },
+    { 0x0F, 0x1F, 0x44, 0x00, 0x00 },
+    { 0x66, 0x0F, 0x1F, 0x44, 0x00, 0x00 },
+    { 0x0F, 0x1F, 0x80, 0x00, 0x00, 0x00, 0x00 },
+    { 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x66, 0x0F, 0x1F, 0x84, 0x00, 0x00, 0x00, 0x00, 0x00 },
+} };
+
+static std::string_view trim(std::string_view text) {
+    const auto start = text.find_first_not_of(" \t");
+    if (start == std::string_view::npos) return { };
+
+    const auto end = text.find_last_not_of(" \t");
+    return text.substr(start, end - start + 1);
+}
+
+void Encoder::encode(const std::span<const AssemblyItem> items) {
+    for (const auto& item : items) {
+        std::visit([&](const auto& value) { _encode(value); }, item);
+    }
+}
+
+void Encoder::finish() {
+    for (const auto& [section, offset, symbol, type, addend] : _fixups) {
+        auto& data = _sections[static_cast<size_t>(section)];
+
+        // References inside of the same section are position independent, which leaves nothing to the linker.
+        const auto& target = _symbols[symbol];
+        if (target.section != section) {
+            data.relocations.push_back({ offset, symbol, type, addend });
+            continue;
+        }
+
+        const auto displacement = static_cast<int64_t>(target.offset) + addend - static_cast<int64_t>(offset);
+        for (size_t index = 0; index < 4; index++) {
+            data.bytes[offset + index] = static_cast<uint8_t>(static_cast<uint64_t>(displacement) >> (index * 8));
+        }
+    }
+
+    _fixups.clear();
+}
+
+const Encoder::SectionData& Encoder::section(const Section section) const {
+    return _sections[static_cast<size_t>(section)];
+}
+
+void Encoder::_encode(const Label& label) {
+    auto& symbol = _symbols[_symbol(label.name())];
+    if (symbol.section) throw std::invalid_argument("The label " + label.name() + " is defined twice.");
+
+    symbol.section = _section;
+    symbol.offset = _current().bytes.size();
+}
+
+void Encoder::_encode(const Directive& directive) {
+    const auto text = trim(directive.text());
+    if (text.empty() || text.starts_with("#")) return;
+
+    // The syntax is fixed and no debug information is emitted, which leaves nothing to do for these.
+    if (text.starts_with(".intel_syntax") || text.starts_with(".file") || text.starts_with(".loc")) return;
+
+    const auto split = text.find_first_of(" \t");
+    const auto name = text.substr(0, split);
+    const auto argument = split == std::string_view::npos ? std::string_view{ } : trim(text.substr(split));
+
+    if (name == ".section") {
+        // The flags of mergeable sections are implied by their name, ".section .rodata.cst8,"aM",@progbits,8".
+        const auto section = trim(argument.substr(0, argument.find(',')));
+        if (section == ".text") {
+            _section = Section::Text;
+        } else if (section == ".data") {
+            _section = Section::Data;
+        } else if (section == ".rodata.cst4") {
+            _section = Section::Literal4;
+        } else if (section == ".rodata.cst8") {
+            _section = Section::Literal8;
+        } else if (section == ".text.hot") {
+            _section = Section::Hot;
+        } else if (section == ".text.unlikely") {
+            _section = Section::Unlikely;
+        } else {
+            throw std::invalid_argument("The section " + std::string(section) + " is not supported.");
+        }
+    } else if (name == ".global") {
+        _symbols[_symbol(std::string(argument))].global = true;
+    } else if (name == ".type") {
+        const auto symbol = trim(argument.substr(0, argument.find(',')));
+        _symbols[_symbol(std::string(symbol))].function = argument.ends_with("@function");
+    } else if (name == ".size") {
+        // The generator always sizes a function up to the current position, ".size name, .-name".
+        auto& symbol = _symbols[_symbol(std::string(trim(argument.substr(0, argument.find(',')))))];
+        if (symbol.section != _section) throw std::invalid_argument("Only defined symbols can be sized.");
+
+        symbol.size = _current().bytes.size() - symbol.offset;
+    } else if (name == ".p2align") {
+        const auto alignment = size_t{ 1 } << std::stoul(std::string(argument));
+
+        auto& bytes = _current().bytes;
+        while (bytes.size() % alignment != 0) {
+            const auto padding = alignment - bytes.size() % alignment;
+            if (_section != Section::Text && _section != Section::Hot && _section != Section::Unlikely) {
+                bytes.insert(bytes.end(), padding, 0x00);
+                continue;
+            }
+
+            // Code is padded with as few NOPs as possible, which are decoded faster than many single-byte ones.
+            const auto& nop = NOPS[std::min(padding, NOPS.size()) - 1];
+            bytes.insert(bytes.end(), nop.begin(), nop.end());
+        }
+    } else if (name == ".local") {
+        // Symbols are local unless they are made global, which leaves nothing to do.
+    } else if (name == ".comm") {
+        // The memory is reserved in the bss section without switching to it, ".comm name, size, alignment".
+        // Only local common symbols are emitted, which are placed in the bss section of the object right away.
+        const auto first = argument.find(',');
+        const auto second = argument.find(',', first + 1);
+        if (first == std::string_view::npos) throw std::invalid_argument("The directive .comm needs a size.");
+
+        const auto label = std::string(trim(argument.substr(0, first)));
+        const auto size = std::stoul(std::string(argument.substr(first + 1, second - first - 1)));
+        const auto alignment = second == std::string_view::npos
+                                   ? size_t{ 1 }
+                                   : std::stoul(std::string(argument.substr(second + 1)));
+
+        auto& symbol = _symbols[_symbol(label)];
+        if (symbol.section) throw std::invalid_argument("The label " + label + " is defined twice.");
+
+        auto& bytes = _sections[static_cast<size_t>(Section::Bss)].bytes;
+        bytes.resize((bytes.size() + alignment - 1) / alignment * alignment, 0x00);
+
+        symbol.section = Section::Bss;
+        symbol.offset = bytes.size();
+        symbol.size = size;
+        bytes.resize(bytes.size() + size, 0x00);
+    } else if (name == ".quad") {
+        _immediate(static_cast<int64_t>(std::stoull(std::string(argument))), 8);
+    } else if (name.ends_with(":")) {
+        // Constants are emitted in a single line, e.g. "float0: .double 1.500000".
+        _encode(Label(std::string(name.substr(0, name.size() - 1))));
+
+        const auto value_split = argument.find_first_of(" \t");
+        const auto type = argument.substr(0, value_split);
+        const auto value = std::string(trim(argument.substr(value_split)));
+
+        if (type == ".double") {
+            _immediate(std::bit_cast<int64_t>(std::stod(value)), 8);
+        } else if (type == ".float") {
+            _immediate(std::bit_cast<int32_t>(std::stof(value)), 4);
+        } else if (type == ".quad") {
+            _immediate(static_cast<int64_t>(std::stoull(value)), 8);
+        } else if (type == ".asciz") {
+            _string(value);
+        } else {
+            throw std::invalid_argument("The data directive " + std::string(type) + " is not supported.");
+        }
+    } else {
+        throw std::invalid_argument("The directive " + std::string(text) + " is not supported.");
+    }
+}
+
+void Encoder::_encode(const Instruction& instruction) {
+    const auto& operands = instruction.operands();
+    auto& bytes = _current().bytes;
+
+    if (const auto condition = condition_of(instruction.opcode())) {
+        // Conditional moves are the only ones of them with two operands.
+        if (operands.size() == 2) {
+            const auto size = size_of(operands[0]);
+            const std::array<uint8_t, 2> opcode{ 0x0F, static_cast<uint8_t>(0x40 + *condition) };
+            return _modrm(size == Size::WORD ? 0x66 : 0, size == Size::QWORD, opcode, number(register_of(operands[0])),
+                          operands[1]);
+        }
+
+        if (std::holds_alternative<Immediate>(operands.front())) {
+            const std::array<uint8_t, 2> opcode{ 0x0F, static_cast<uint8_t>(0x80 + *condition) };
+            return _branch(opcode, operands.front(), R_X86_64_PC32);
+        }
+
+        const std::array<uint8_t, 2> opcode{ 0x0F, static_cast<uint8_t>(0x90 + *condition) };
+        return _modrm(0, false, opcode, 0, operands.front(), 0, needs_rex(operands.front()));
+    }
+
+    switch (instruction.opcode()) {
+        case Instruction::Opcode::ADD: return _arithmetic(0, operands[0], operands[1]);
+        case Instruction::Opcode::OR: return _arithmetic(1, operands[0], operands[1]);
+        case Instruction::Opcode::SUB: return _arithmetic(5, operands[0], operands[1]);
+        case Instruction::Opcode::CMP: return _arithmetic(7, operands[0], operands[1]);
+        case Instruction::Opcode::MOV: return _mov(operands[0], operands[1]);
+        case Instruction::Opcode::TEST: return _test(operands[0], operands[1]);
+        case Instruction::Opcode::IMUL: return _imul(operands[0], operands[1]);
+        case Instruction::Opcode::SHL: return _shift(4, operands[0], operands[1]);
+        case Instruction::Opcode::SHR: return _shift(5, operands[0], operands[1]);
+        case Instruction::Opcode::SAR: return _shift(7, operands[0], operands[1]);
+        case Instruction::Opcode::PUSH: return _push(operands[0]);
+        case Instruction::Opcode::DIV:
+        case Instruction::Opcode::IDIV: {
+            const auto size = size_of(operands[0]);
+            const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(size == Size::BYTE ? 0xF6 : 0xF7) };
+            const auto digit = instruction.opcode() == Instruction::Opcode::IDIV ? 7 : 6;
+            return _modrm(size == Size::WORD ? 0x66 : 0, size == Size::QWORD, opcode, digit, operands[0], 0,
+                          needs_rex(operands[0]));
+        }
+        case Instruction::Opcode::POP: {
+            const auto number = ::number(register_of(operands[0]));
+            if (number >= 8) bytes.push_back(0x41);
+            bytes.push_back(0x58 + (number & 7));
+            return;
+        }
+        case Instruction::Opcode::CALL: {
+            constexpr std::array<uint8_t, 1> opcode{ 0xE8 };
+            return _branch(opcode, operands[0], R_X86_64_PLT32);
+        }
+        case Instruction::Opcode::JMP: {
+            constexpr std::array<uint8_t, 1> opcode{ 0xE9 };
+            return _branch(opcode, operands[0], R_X86_64_PLT32);
+        }
+        case Instruction::Opcode::ENTER: {
+            bytes.push_back(0xC8);
+            _immediate(immediate_of(operands[0], Size::WORD), 2);
+            _immediate(immediate_of(operands[1], Size::BYTE), 1);
+            return;
+        }
+        case Instruction::Opcode::LEAVE: return bytes.push_back(0xC9);
+        case Instruction::Opcode::RET: return bytes.push_back(0xC3);
+        case Instruction::Opcode::CDQ: return bytes.push_back(0x99);
+        case Instruction::Opcode::CQO: {
+            bytes.push_back(0x48);
+            bytes.push_back(0x99);
+            return;
+        }
+        case Instruction::Opcode::SYSCALL: {
+            bytes.push_back(0x0F);
+            bytes.push_back(0x05);
+            return;
+        }
+        case Instruction::Opcode::MOVSXD: {
+            constexpr std::array<uint8_t, 1> opcode{ 0x63 };
+            return _modrm(0, true, opcode, number(register_of(operands[0])), operands[1]);
+        }
+        case Instruction::Opcode::LEA: {
+            // The address is always computed in 64 bits, the destination decides how much of it is kept.
+            constexpr std::array<uint8_t, 1> opcode{ 0x8D };
+            const auto wide = size_of(operands[0]) == Size::QWORD;
+            return _modrm(0, wide, opcode, number(register_of(operands[0])), operands[1]);
+        }
+        case Instruction::Opcode::MOVSX:
+        case Instruction::Opcode::MOVZX: {
+            const auto size = size_of(operands[0]);
+            const auto source_size = size_of(operands[1]);
+            if (source_size != Size::BYTE && source_size != Size::WORD) {
+                throw std::invalid_argument("Only 8-bit and 16-bit sources can be extended.");
+            }
+
+            const auto base = instruction.opcode() == Instruction::Opcode::MOVSX ? 0xBE : 0xB6;
+            const std::array<uint8_t, 2> opcode{ 0x0F, static_cast<uint8_t>(base + (source_size == Size::WORD)) };
+            return _modrm(size == Size::WORD ? 0x66 : 0, size == Size::QWORD, opcode, number(register_of(operands[0])),
+                          operands[1], 0, needs_rex(operands[1]));
+        }
+        case Instruction::Opcode::ADDSD: return _sse(0xF2, 0x58, operands[0], operands[1]);
+        case Instruction::Opcode::ADDSS: return _sse(0xF3, 0x58, operands[0], operands[1]);
+        case Instruction::Opcode::SUBSD: return _sse(0xF2, 0x5C, operands[0], operands[1]);
+        case Instruction::Opcode::SUBSS: return _sse(0xF3, 0x5C, operands[0], operands[1]);
+        case Instruction::Opcode::MULSD: return _sse(0xF2, 0x59, operands[0], operands[1]);
+        case Instruction::Opcode::MULSS: return _sse(0xF3, 0x59, operands[0], operands[1]);
+        case Instruction::Opcode::DIVSD: return _sse(0xF2, 0x5E, operands[0], operands[1]);
+        case Instruction::Opcode::DIVSS: return _sse(0xF3, 0x5E, operands[0], operands[1]);
+        case Instruction::Opcode::UCOMISD: return _sse(0x66, 0x2E, operands[0], operands[1]);
+        case Instruction::Opcode::UCOMISS: return _sse(0, 0x2E, operands[0], operands[1]);
+        case Instruction::Opcode::CVTSS2SD: return _sse(0xF3, 0x5A, operands[0], operands[1]);
+        case Instruction::Opcode::CVTSD2SS: return _sse(0xF2, 0x5A, operands[0], operands[1]);
+        case Instruction::Opcode::XORPS: return _sse(0, 0x57, operands[0], operands[1]);
+        case Instruction::Opcode::CVTTSD2SI:
+            return _sse(0xF2, 0x2C, operands[0], operands[1], size_of(operands[0]) == Size::QWORD);
+        case Instruction::Opcode::CVTTSS2SI:
+            return _sse(0xF3, 0x2C, operands[0], operands[1], size_of(operands[0]) == Size::QWORD);
+        case Instruction::Opcode::CVTSI2SD:
+            return _sse(0xF2, 0x2A, operands[0], operands[1], size_of(operands[1]) == Size::QWORD);
+        case Instruction::Opcode::CVTSI2SS:
+            return _sse(0xF3, 0x2A, operands[0], operands[1], size_of(operands[1]) == Size::QWORD);
+        case Instruction::Opcode::ADDPD: return _sse(0x66, 0x58, operands[0], operands[1]);
+        case Instruction::Opcode::SUBPD: return _sse(0x66, 0x5C, operands[0], operands[1]);
+        case Instruction::Opcode::MULPD: return _sse(0x66, 0x59, operands[0], operands[1]);
+        case Instruction::Opcode::DIVPD: return _sse(0x66, 0x5E, operands[0], operands[1]);
+        case Instruction::Opcode::MOVAPD: return _sse(0x66, 0x28, operands[0], operands[1]);
+        case Instruction::Opcode::MOVHPD: return _sse(0x66, 0x16, operands[0], operands[1]);
+        case Instruction::Opcode::UNPCKLPD: return _sse(0x66, 0x14, operands[0], operands[1]);
+        case Instruction::Opcode::UNPCKHPD: return _sse(0x66, 0x15, operands[0], operands[1]);
+        case Instruction::Opcode::VADDSD: return _avx(0xF2, 0x58, operands);
+        case Instruction::Opcode::VADDSS: return _avx(0xF3, 0x58, operands);
+        case Instruction::Opcode::VSUBSD: return _avx(0xF2, 0x5C, operands);
+        case Instruction::Opcode::VSUBSS: return _avx(0xF3, 0x5C, operands);
+        case Instruction::Opcode::VMULSD: return _avx(0xF2, 0x59, operands);
+        case Instruction::Opcode::VMULSS: return _avx(0xF3, 0x59, operands);
+        case Instruction::Opcode::VDIVSD: return _avx(0xF2, 0x5E, operands);
+        case Instruction::Opcode::VDIVSS: return _avx(0xF3, 0x5E, operands);
+        case Instruction::Opcode::VXORPS: return _avx(0, 0x57, operands);
+        case Instruction::Opcode::VCVTSS2SD: return _avx(0xF3, 0x5A, operands);
+        case Instruction::Opcode::VCVTSD2SS: return _avx(0xF2, 0x5A, operands);
+        case Instruction::Opcode::VCVTSI2SD: return _avx(0xF2, 0x2A, operands, size_of(operands[2]) == Size::QWORD);
+        case Instruction::Opcode::VCVTSI2SS: return _avx(0xF3, 0x2A, operands, size_of(operands[2]) == Size::QWORD);
+        case Instruction::Opcode::VFMADD231SD: return _avx(0x66, 0xB9, operands, true, 2);
+        case Instruction::Opcode::VFMADD231SS: return _avx(0x66, 0xB9, operands, false, 2);
+        case Instruction::Opcode::VFMSUB231SD: return _avx(0x66, 0xBB, operands, true, 2);
+        case Instruction::Opcode::VFMSUB231SS: return _avx(0x66, 0xBB, operands, false, 2);
+        case Instruction::Opcode::VFNMADD231SD: return _avx(0x66, 0xBD, operands, true, 2);
+        case Instruction::Opcode::VFNMADD231SS: return _avx(0x66, 0xBD, operands, false, 2);
+        case Instruction::Opcode::SHLX:
+        case Instruction::Opcode::SHRX:
+        case Instruction::Opcode::SARX: {
+            // Unlike the other VEX instructions, the source is the r/m operand and the shift amount the extra one.
+            const auto prefix = instruction.opcode() == Instruction::Opcode::SHLX
+                                    ? 0x66
+                                    : instruction.opcode() == Instruction::Opcode::SHRX ? 0xF2 : 0xF3;
+            const auto wide = size_of(operands[0]) == Size::QWORD;
+            return _vex(prefix, 2, wide, 0xF7, number(register_of(operands[0])), number(register_of(operands[2])),
+                        operands[1]);
+        }
+        case Instruction::Opcode::MOVSD:
+        case Instruction::Opcode::MOVSS: {
+            const auto prefix = instruction.opcode() == Instruction::Opcode::MOVSD ? 0xF2 : 0xF3;
+            if (std::holds_alternative<Register>(operands[0])) return _sse(prefix, 0x10, operands[0], operands[1]);
+
+            constexpr std::array<uint8_t, 2> opcode{ 0x0F, 0x11 };
+            return _modrm(prefix, false, opcode, number(register_of(operands[1])), operands[0]);
+        }
+        case Instruction::Opcode::MOVD:
+        case Instruction::Opcode::MOVQ: {
+            const auto wide = instruction.opcode() == Instruction::Opcode::MOVQ;
+            const auto* destination = std::get_if<Register>(&operands[0]);
+            if (destination && is_sse(*destination)) return _sse(0x66, 0x6E, operands[0], operands[1], wide);
+
+            constexpr std::array<uint8_t, 2> opcode{ 0x0F, 0x7E };
+            return _modrm(0x66, wide, opcode, number(register_of(operands[1])), operands[0]);
+        }
+        default: {
+            std::stringstream output;
+            output << instruction.opcode();
+            throw std::invalid_argument("The opcode " + output.str() + " can't be encoded.");
+        }
+    }
+}
+
+void Encoder::_arithmetic(const uint8_t digit, const Operand& destination, const Operand& source) {
+    const auto size = size_of(destination);
+    const auto prefix = size == Size::WORD ? 0x66 : 0;
+    const auto wide = size == Size::QWORD;
+    const auto is_byte = size == Size::BYTE;
+    const auto force_rex = needs_rex(destination) || needs_rex(source);
+
+    if (std::holds_alternative<Immediate>(source)) {
+        const auto value = immediate_of(source, size);
+
+        // Small immediates are sign-extended from 8 bits, which saves up to three bytes.
+        if (is_byte || fits_int8(value)) {
+            const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0x80 : 0x83) };
+            _modrm(prefix, wide, opcode, digit, destination, 1, force_rex);
+            return _immediate(value, 1);
+        }
+
+        const auto bytes = immediate_size(size, value);
+        constexpr std::array<uint8_t, 1> opcode{ 0x81 };
+        _modrm(prefix, wide, opcode, digit, destination, bytes, force_rex);
+        return _immediate(value, bytes);
+    }
+
+    // The register operand is always encoded in the reg field, the direction bit selects which one it is.
+    if (const auto* reg = std::get_if<Register>(&source)) {
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(digit * 8 + (is_byte ? 0 : 1)) };
+        return _modrm(prefix, wide, opcode, number(*reg), destination, 0, force_rex);
+    }
+
+    const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(digit * 8 + (is_byte ? 2 : 3)) };
+    _modrm(prefix, wide, opcode, number(register_of(destination)), source, 0, force_rex);
+}
+
+void Encoder::_mov(const Operand& destination, const Operand& source) {
+    const auto size = size_of(destination);
+    const auto prefix = size == Size::WORD ? 0x66 : 0;
+    const auto wide = size == Size::QWORD;
+    const auto is_byte = size == Size::BYTE;
+    const auto force_rex = needs_rex(destination) || needs_rex(source);
+
+    if (std::holds_alternative<Immediate>(source)) {
+        const auto value = immediate_of(source, size);
+
+        // Registers have a short form carrying the register in the opcode, which also is the only form for 64 bits.
+        const auto* reg = std::get_if<Register>(&destination);
+        if (reg && (!wide || !fits_int32(value))) {
+            auto& bytes = _current().bytes;
+            if (prefix) bytes.push_back(prefix);
+
+            const auto number = ::number(*reg);
+            const uint8_t rex = (wide ? 0x48 : 0) | (number >= 8 ? 0x41 : 0) | (force_rex ? 0x40 : 0);
+            if (rex) bytes.push_back(rex);
+
+            bytes.push_back(static_cast<uint8_t>((is_byte ? 0xB0 : 0xB8) + (number & 7)));
+            return _immediate(value, size_to_bytes(size));
+        }
+
+        const auto bytes = immediate_size(size, value);
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0xC6 : 0xC7) };
+        _modrm(prefix, wide, opcode, 0, destination, bytes, force_rex);
+        return _immediate(value, bytes);
+    }
+
+    if (const auto* reg = std::get_if<Register>(&source)) {
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0x88 : 0x89) };
+        return _modrm(prefix, wide, opcode, number(*reg), destination, 0, force_rex);
+    }
+
+    const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0x8A : 0x8B) };
+    _modrm(prefix, wide, opcode, number(register_of(destination)), source, 0, force_rex);
+}
+
+void Encoder::_test(const Operand& destination, const Operand& source) {
+    const auto size = size_of(destination);
+    const auto prefix = size == Size::WORD ? 0x66 : 0;
+    const auto wide = size == Size::QWORD;
+    const auto is_byte = size == Size::BYTE;
+    const auto force_rex = needs_rex(destination) || needs_rex(source);
+
+    // Unlike the arithmetic instructions, there is no sign-extended 8-bit immediate form.
+    if (std::holds_alternative<Immediate>(source)) {
+        const auto value = immediate_of(source, size);
+        const auto bytes = immediate_size(size, value);
+
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0xF6 : 0xF7) };
+        _modrm(prefix, wide, opcode, 0, destination, bytes, force_rex);
+        return _immediate(value, bytes);
+    }
+
+    const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0x84 : 0x85) };
+    _modrm(prefix, wide, opcode, number(register_of(source)), destination, 0, force_rex);
+}
+
+void Encoder::_imul(const Operand& destination, const Operand& source) {
+    const auto size = size_of(destination);
+    if (size == Size::BYTE) throw std::invalid_argument("There is no two operand form of imul for 8 bits.");
+
+    const auto prefix = size == Size::WORD ? 0x66 : 0;
+    const auto wide = size == Size::QWORD;
+    const auto reg = number(register_of(destination));
+
+    // The immediate form has three operands, the destination is used as both the result and the multiplicand.
+    if (std::holds_alternative<Immediate>(source)) {
+        const auto value = immediate_of(source, size);
+        const auto bytes = fits_int8(value) ? 1 : immediate_size(size, value);
+
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(bytes == 1 ? 0x6B : 0x69) };
+        _modrm(prefix, wide, opcode, reg, destination, bytes);
+        return _immediate(value, bytes);
+    }
+
+    constexpr std::array<uint8_t, 2> opcode{ 0x0F, 0xAF };
+    _modrm(prefix, wide, opcode, reg, source);
+}
+
+void Encoder::_shift(const uint8_t digit, const Operand& destination, const Operand& source) {
+    const auto size = size_of(destination);
+    const auto prefix = size == Size::WORD ? 0x66 : 0;
+    const auto wide = size == Size::QWORD;
+    const auto is_byte = size == Size::BYTE;
+    const auto force_rex = needs_rex(destination);
+
+    // Any other shift amount than an immediate must be in the CL register.
+    if (!std::holds_alternative<Immediate>(source)) {
+        if (register_of(source).base() != Register::Base::C) throw std::invalid_argument("Shifts only use CL.");
+
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0xD2 : 0xD3) };
+        return _modrm(prefix, wide, opcode, digit, destination, 0, force_rex);
+    }
+
+    const auto value = immediate_of(source, Size::BYTE);
+    if (value == 1) {
+        const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0xD0 : 0xD1) };
+        return _modrm(prefix, wide, opcode, digit, destination, 0, force_rex);
+    }
+
+    const std::array<uint8_t, 1> opcode{ static_cast<uint8_t>(is_byte ? 0xC0 : 0xC1) };
+    _modrm(prefix, wide, opcode, digit, destination, 1, force_rex);
+    _immediate(value, 1);
+}
+
+void Encoder::_push(const Operand& source) {
+    auto& bytes = _current().bytes;
+
+    if (std::holds_alternative<Immediate>(source)) {
+        const auto value = immediate_of(source, Size::QWORD);
+        const auto size = fits_int8(value) ? 1 : immediate_size(Size::QWORD, value);
+
+        bytes.push_back(size == 1 ? 0x6A : 0x68);
+        return _immediate(value, size);
+    }
+
+    if (const auto* reg = std::get_if<Register>(&source)) {
+        if (is_sse(*reg)) throw std::invalid_argument("SSE registers can't be pushed.");
+
+        const auto number = ::number(*reg);
+        if (number >= 8) bytes.push_back(0x41);
+        return bytes.push_back(0x50 + (number & 7));
+    }
+
+    constexpr std::array<uint8_t, 1> opcode{ 0xFF };
+    _modrm(0, false, opcode, 6, source);
+}
+
+void Encoder::_sse(
+    const uint8_t prefix, const uint8_t opcode, const Operand& destination, const Operand& source,
+    const bool wide
+) {
+    const std::array<uint8_t, 2> bytes{ 0x0F, opcode };
+    _modrm(prefix, wide, bytes, number(register_of(destination)), source);
+}
+
+void Encoder::_avx(
+    const uint8_t prefix, const uint8_t opcode, const std::vector<Operand>& operands, const bool wide,
+    const uint8_t map
+) {
+    if (operands.size() != 3) throw std::invalid_argument("The VEX encoded instructions take three operands.");
+
+    _vex(prefix, map, wide, opcode, number(register_of(operands[0])), number(register_of(operands[1])), operands[2]);
+}
+
+void Encoder::_vex(
+    const uint8_t prefix, const uint8_t map, const bool wide, const uint8_t opcode, const uint8_t reg,
+    const uint8_t source, const Operand& rm
+) {
+    auto& bytes = _current().bytes;
+
+    const auto* rm_reg = std::get_if<Register>(&rm);
+    const auto* memory = std::get_if<Memory>(&rm);
+    const auto* base = memory ? std::get_if<Register>(&memory->address()) : nullptr;
+    const auto index = memory ? memory->index() : std::nullopt;
+
+    // The R, X and B bits extend the register fields just like the ones of the REX prefix, but they are inverted.
+    const auto extend_reg = reg >= 8;
+    const auto extend_index = index && number(*index) >= 8;
+    const auto extend_base = (rm_reg && number(*rm_reg) >= 8) || (base && number(*base) >= 8);
+
+    uint8_t implied = 0;
+    if (prefix == 0x66) implied = 0b01;
+    if (prefix == 0xF3) implied = 0b10;
+    if (prefix == 0xF2) implied = 0b11;
+
+    // The additional source register is stored inverted as well, the vector length is always 128 bits.
+    const auto last = static_cast<uint8_t>(((~source & 0xF) << 3) | implied);
+
+    // The two byte form implies the 0F map and neither extends the r/m operand nor sets W.
+    if (map == 1 && !extend_index && !extend_base && !wide) {
+        bytes.push_back(0xC5);
+        bytes.push_back(static_cast<uint8_t>((extend_reg ? 0 : 0x80) | last));
+    } else {
+        bytes.push_back(0xC4);
+        bytes.push_back(static_cast<uint8_t>((extend_reg ? 0 : 0x80) | (extend_index ? 0 : 0x40)
+                                             | (extend_base ? 0 : 0x20) | map));
+        bytes.push_back(static_cast<uint8_t>((wide ? 0x80 : 0) | last));
+    }
+
+    bytes.push_back(opcode);
+    _rm(reg, rm, 0);
+}
+
+void Encoder::_branch(const std::span<const uint8_t> opcode, const Operand& target, const uint32_t type) {
+    const auto* immediate = std::get_if<Immediate>(&target);
+    const auto* name = immediate ? std::get_if<std::string>(immediate) : nullptr;
+    if (!name) throw std::invalid_argument("Only labels can be the target of a jump or call.");
+
+    auto& bytes = _current().bytes;
+    bytes.insert(bytes.end(), opcode.begin(), opcode.end());
+
+    // The displacement is relative to the end of the instruction, which is right after the field.
+    _fixups.push_back({ _section, bytes.size(), _symbol(*name), type, -4 });
+    _immediate(0, 4);
+}
+
+void Encoder::_modrm(
+    const uint8_t prefix, const bool wide, const std::span<const uint8_t> opcode, const uint8_t reg,
+    const Operand& rm, const size_t trailing, const bool force_rex
+) {
+    auto& bytes = _current().bytes;
+
+    uint8_t rex = (wide ? 0x48 : 0) | (reg >= 8 ? 0x44 : 0) | (force_rex ? 0x40 : 0);
+    if (const auto* rm_reg = std::get_if<Register>(&rm); rm_reg && number(*rm_reg) >= 8) rex |= 0x41;
+
+    const auto* memory = std::get_if<Memory>(&rm);
+    const auto* base = memory ? std::get_if<Register>(&memory->address()) : nullptr;
+    if (base && number(*base) >= 8) rex |= 0x41;
+
+    const auto index = memory ? memory->index() : std::nullopt;
+    if (index && number(*index) >= 8) rex |= 0x42;
+
+    if (prefix) bytes.push_back(prefix);
+    if (rex) bytes.push_back(rex);
+    bytes.insert(bytes.end(), opcode.begin(), opcode.end());
+
+    _rm(reg, rm, trailing);
+}
+
+void Encoder::_rm(const uint8_t reg, const Operand& rm, const size_t trailing) {
+    auto& bytes = _current().bytes;
+
+    const auto* memory = std::get_if<Memory>(&rm);
+    const auto* base = memory ? std::get_if<Register>(&memory->address()) : nullptr;
+    const auto index = memory ? memory->index() : std::nullopt;
+
+    const auto field = static_cast<uint8_t>((reg & 7) << 3);
+    if (const auto* rm_reg = std::get_if<Register>(&rm)) {
+        bytes.push_back(0xC0 | field | (number(*rm_reg) & 7));
+        return;
+    }
+
+    if (!memory) throw std::invalid_argument("Immediates can't be encoded as register or memory operand.");
+    if (index && !base) throw std::invalid_argument("Only addresses with a base register can be indexed.");
+    if (index && number(*index) == 0b100) throw std::invalid_argument("RSP can't be used as an index.");
+
+    std::visit(
+        match{
+            [&](const std::string& name) {
+                // Labels are addressed relative to the instruction pointer, which points after the immediate.
+                bytes.push_back(field | 0b101);
+                _fixups.push_back({ _section, bytes.size(), _symbol(name), R_X86_64_PC32,
+                                   -4 - static_cast<int64_t>(trailing) });
+                _immediate(0, 4);
+            },
+            [&](const int64_t address) {
+                if (!fits_int32(address)) throw std::invalid_argument("Absolute addresses must fit into 32 bits.");
+
+                // Without a base and index, the SIB byte encodes an absolute 32-bit address.
+                bytes.push_back(field | 0b100);
+                bytes.push_back(0x25);
+                _immediate(address, 4);
+            },
+            [&](const Register& address) {
+                const auto low = number(address) & 7;
+                const auto displacement = memory->displacement();
+                if (!fits_int32(displacement)) throw std::invalid_argument("Displacements must fit into 32 bits.");
+
+                // RBP and R13 without displacement encode a RIP-relative address, thus they always need one.
+                uint8_t mod = 0b10;
+                if (displacement == 0 && low != 0b101) {
+                    mod = 0b00;
+                } else if (fits_int8(displacement)) {
+                    mod = 0b01;
+                }
+
+                if (index) {
+                    // The scale is encoded as its logarithm, an index of 0b100 without REX.X would mean no index.
+                    const auto scale = static_cast<uint8_t>(std::countr_zero(static_cast<uint64_t>(memory->scale())));
+                    bytes.push_back(static_cast<uint8_t>(mod << 6) | field | 0b100);
+                    const auto index_field = static_cast<uint8_t>((number(*index) & 7) << 3);
+                    bytes.push_back(static_cast<uint8_t>(scale << 6) | index_field | low);
+                } else {
+                    bytes.push_back(static_cast<uint8_t>(mod << 6) | field | low);
+
+                    // RSP and R12 select a SIB byte, which is needed to address them without an index.
+                    if (low == 0b100) bytes.push_back(0x24);
+                }
+
+                if (mod == 0b01) _immediate(displacement, 1);
+                if (mod == 0b10) _immediate(displacement, 4);
+            },
+        },
+        memory->address()
+    );
+}
+
+void Encoder::_string(const std::string_view literal) {
+    if (literal.size() < 2 || !literal.starts_with('"') || !literal.ends_with('"')) {
+        throw std::invalid_argument("The string " + std::string(literal) + " is not quoted.");
+    }
+
+    // The generator only escapes backslashes and quotes, which are kept as they are.
+    auto& bytes = _current().bytes;
+    for (size_t index = 1; index + 1 < literal.size(); index++) {
+        if (literal[index] == '\\' && index + 2 < literal.size()) index++;
+        bytes.push_back(static_cast<uint8_t>(literal[index]));
+    }
+
+    bytes.push_back(0);
+}
+
+void Encoder::_immediate(const int64_t value, const size_t size) {
+    auto& bytes = _current().bytes;
+    for (size_t index = 0; index < size; index++) {
+        bytes.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (index * 8)));
+    }
+}
+
+size_t Encoder::_symbol(const std::string& name) {
+    const auto [iterator, inserted] = _symbol_indices.try_emplace(name, _symbols.size());
+    if (inserted) _symbols.push_back(Symbol{ .name = name });
+
+    return iterator->second;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
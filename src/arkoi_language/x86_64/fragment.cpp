@@ -0,0 +1,316 @@
+#include "arkoi_language/x86_64/fragment.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+namespace {
+/**
+ * @brief The alternatives of the serialized variants, stored in front of their values.
+ */
+enum Tag : uint8_t { LABEL, DIRECTIVE, INSTRUCTION };
+
+template <typename Type>
+void append(std::ostream& output, const Type& value) {
+    output.write(reinterpret_cast<const char*>(&value), sizeof(Type));
+}
+
+void append(std::ostream& output, const std::string& value) {
+    append(output, static_cast<uint64_t>(value.size()));
+    output.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+void append(std::ostream& output, const Register& reg) {
+    append(output, static_cast<uint8_t>(reg.base()));
+    append(output, static_cast<uint8_t>(reg.size()));
+}
+
+void append(std::ostream& output, const Immediate& immediate) {
+    append(output, static_cast<uint8_t>(immediate.index()));
+    std::visit([&](const auto& value) { append(output, value); }, immediate);
+}
+
+void append(std::ostream& output, const Memory& memory) {
+    append(output, static_cast<uint8_t>(memory.size()));
+    append(output, memory.index().has_value());
+    if (memory.index()) append(output, *memory.index());
+    append(output, memory.scale());
+    append(output, memory.displacement());
+
+    append(output, static_cast<uint8_t>(memory.address().index()));
+    std::visit([&](const auto& value) { append(output, value); }, memory.address());
+}
+
+void append(std::ostream& output, const std::vector<AssemblyItem>& items) {
+    append(output, static_cast<uint64_t>(items.size()));
+
+    for (const auto& item : items) {
+        std::visit(
+            match{
+                [&](const Label& label) {
+                    append(output, LABEL);
+                    append(output, label.name());
+                },
+                [&](const Directive& directive) {
+                    append(output, DIRECTIVE);
+                    append(output, directive.text());
+                },
+                [&](const Instruction& instruction) {
+                    append(output, INSTRUCTION);
+                    append(output, static_cast<uint8_t>(instruction.opcode()));
+                    append(output, static_cast<uint8_t>(instruction.operands().size()));
+
+                    for (const auto& operand : instruction.operands()) {
+                        append(output, static_cast<uint8_t>(operand.index()));
+                        std::visit([&](const auto& value) { append(output, value); }, operand);
+                    }
+                },
+            },
+            item
+        );
+    }
+}
+
+/**
+ * @brief Reads the values written by `append`, any failure leaves the reader in the failed state.
+ */
+class Reader {
+public:
+    explicit Reader(std::istream& input) :
+        _input(input) { }
+
+    template <typename Type>
+    Type number() {
+        Type value{ };
+        if (!_input.read(reinterpret_cast<char*>(&value), sizeof(Type))) _failed = true;
+        return value;
+    }
+
+    std::string string() {
+        const auto size = number<uint64_t>();
+
+        // The length is checked against the remaining input, thus a corrupted entry never allocates huge strings.
+        const auto position = _input.tellg();
+        _input.seekg(0, std::ios::end);
+        const auto remaining = _input.tellg() - position;
+        _input.seekg(position);
+
+        if (_failed || !_input || remaining < 0 || size > static_cast<uint64_t>(remaining)) {
+            _failed = true;
+            return { };
+        }
+
+        std::string value(size, '\0');
+        _input.read(value.data(), static_cast<std::streamsize>(size));
+        return value;
+    }
+
+    Register reg() {
+        const auto base = number<uint8_t>();
+        const auto size = number<uint8_t>();
+
+        if (base > static_cast<uint8_t>(Register::Base::XMM15)) _failed = true;
+        return { static_cast<Register::Base>(base), _size(size) };
+    }
+
+    Immediate immediate() {
+        switch (number<uint8_t>()) {
+            case 0: return string();
+            case 1: return number<uint64_t>();
+            case 2: return number<int64_t>();
+            case 3: return number<uint32_t>();
+            case 4: return number<int32_t>();
+            case 5: return number<double>();
+            case 6: return number<float>();
+            case 7: return number<bool>();
+            default: _failed = true; return false;
+        }
+    }
+
+    Memory memory() {
+        const auto size = _size(number<uint8_t>());
+        const auto index = number<bool>() ? std::optional(reg()) : std::nullopt;
+        const auto scale = number<int64_t>();
+        const auto displacement = number<int64_t>();
+
+        switch (number<uint8_t>()) {
+            case 0: return _plain(Memory(size, string()), index, scale, displacement);
+            case 1: return _plain(Memory(size, number<int64_t>()), index, scale, displacement);
+            case 2: return { size, reg(), index, scale, displacement };
+            default: _failed = true; return { size, int64_t{ 0 } };
+        }
+    }
+
+    std::vector<AssemblyItem> items() {
+        const auto count = number<uint64_t>();
+
+        std::vector<AssemblyItem> items;
+        for (uint64_t index = 0; index < count && !_failed; index++) {
+            switch (number<uint8_t>()) {
+                case LABEL: items.emplace_back(Label(string())); break;
+                case DIRECTIVE: items.emplace_back(Directive(string())); break;
+                case INSTRUCTION: items.emplace_back(instruction()); break;
+                default: _failed = true; break;
+            }
+        }
+
+        return items;
+    }
+
+    Instruction instruction() {
+        const auto opcode = number<uint8_t>();
+        if (opcode > static_cast<uint8_t>(Instruction::Opcode::LEA)) _failed = true;
+
+        const auto count = number<uint8_t>();
+
+        std::vector<Operand> operands;
+        for (uint8_t index = 0; index < count && !_failed; index++) {
+            switch (number<uint8_t>()) {
+                case 0: operands.emplace_back(memory()); break;
+                case 1: operands.emplace_back(reg()); break;
+                case 2: operands.emplace_back(immediate()); break;
+                default: _failed = true; break;
+            }
+        }
+
+        return { static_cast<Instruction::Opcode>(opcode), std::move(operands) };
+    }
+
+    [[nodiscard]] bool failed() const { return _failed; }
+
+private:
+    Size _size(const uint8_t size) {
+        if (size != 1 && size != 2 && size != 4 && size != 8) _failed = true;
+        return static_cast<Size>(size);
+    }
+
+    /**
+     * @brief Symbolic and absolute addresses are never indexed or displaced, see `Memory(Size, Address)`.
+     */
+    Memory _plain(
+        Memory memory, const std::optional<Register>& index, const int64_t scale, const int64_t displacement
+    ) {
+        if (index != memory.index() || scale != memory.scale() || displacement != memory.displacement()) _failed = true;
+        return memory;
+    }
+
+private:
+    std::istream& _input;
+    bool _failed{ };
+};
+} // namespace
+
+std::vector<std::string> Fragment::callees() const {
+    std::vector<std::string> callees;
+
+    for (const auto& item : text) {
+        const auto* instruction = std::get_if<Instruction>(&item);
+        if (!instruction || instruction->operands().empty()) continue;
+
+        const auto opcode = instruction->opcode();
+        if (opcode != Instruction::Opcode::CALL && opcode != Instruction::Opcode::JMP) continue;
+
+        const auto* immediate = std::get_if<Immediate>(&instruction->operands().front());
+        const auto* name = immediate ? std::get_if<std::string>(immediate) : nullptr;
+
+        // The labels of blocks are qualified by the function, which is never the case for a function itself.
+        if (!name || name->contains('.')) continue;
+
+        if (std::ranges::find(callees, *name) == callees.end()) callees.push_back(*name);
+    }
+
+    return callees;
+}
+
+std::vector<const Fragment*> Fragment::call_order(
+    const std::vector<std::pair<std::string, const Fragment*>>& fragments
+) {
+    std::unordered_map<std::string_view, const Fragment*> by_name;
+    for (const auto& [name, fragment] : fragments) by_name.emplace(name, fragment);
+
+    std::vector<std::string_view> roots;
+    if (by_name.contains("main")) roots.emplace_back("main");
+    for (const auto& [name, fragment] : fragments) roots.emplace_back(name);
+
+    std::vector<const Fragment*> ordered;
+    std::unordered_set<const Fragment*> visited;
+    for (const auto root : roots) {
+        std::vector worklist{ root };
+        while (!worklist.empty()) {
+            const auto found = by_name.find(worklist.back());
+            worklist.pop_back();
+
+            // Calls of functions that are defined elsewhere, e.g. by the runtime, have no fragment.
+            if (found == by_name.end() || !visited.insert(found->second).second) continue;
+            ordered.push_back(found->second);
+
+            // The callees are pushed in reverse, thus the first one referenced is placed next.
+            const auto callees = found->second->callees();
+            for (const auto& callee : std::views::reverse(callees)) {
+                const auto callee_name = by_name.find(callee);
+                if (callee_name != by_name.end()) worklist.push_back(callee_name->first);
+            }
+        }
+    }
+
+    return ordered;
+}
+
+void Fragment::write(std::ostream& output) const {
+    append(output, text);
+    append(output, data);
+    append(output, constants);
+    append(output, counters);
+}
+
+std::optional<Fragment> Fragment::read(std::istream& input) {
+    Reader reader(input);
+
+    Fragment fragment;
+    fragment.text = reader.items();
+    fragment.data = reader.items();
+    fragment.constants = reader.items();
+    fragment.counters = reader.items();
+
+    if (reader.failed()) return std::nullopt;
+    return fragment;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,144 +1,507 @@
 #include "arkoi_language/x86_64/generator.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <filesystem>
+#include <limits>
 #include <ranges>
 #include <set>
+#include <sstream>
+#include <utility>
 
 #include "arkoi_language/il/cfg.hpp"
 #include "arkoi_language/il/il_printer.hpp"
+#include "arkoi_language/il/profile.hpp"
+#include "arkoi_language/utils/output_buffer.hpp"
 #include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi::x86_64;
 using namespace arkoi;
 
+/**
+ * @brief Renders the floating point @p value with as many digits as are needed to read it back exactly.
+ */
+template <typename Floating>
+static std::string render_floating(const Floating value) {
+    std::array<char, 32> buffer{ };
+    const auto [end, _] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    return { buffer.data(), end };
+}
+
+/**
+ * @brief Returns the label of a pooled constant, which is named after its bit pattern and size.
+ *
+ * Identical constants thus share their label across all functions, even across compilations.
+ */
+static std::string constant_label(const uint64_t bits, const Size size) {
+    std::array<char, 16> buffer{ };
+    const auto [end, _] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), bits, 16);
+    const auto digits = std::string(buffer.data(), end);
+
+    const auto width = (size == Size::QWORD) ? size_t{ 16 } : size_t{ 8 };
+    const auto prefix = (size == Size::QWORD) ? ".Lf64." : ".Lf32.";
+    return prefix + std::string(width - digits.size(), '0') + digits;
+}
+
+/**
+ * @brief Checks if @p operand loads the positive zero of the constant pool.
+ */
+static bool is_zero_constant(const Operand& operand) {
+    const auto* memory = std::get_if<Memory>(&operand);
+    const auto* label = memory ? std::get_if<std::string>(&memory->address()) : nullptr;
+    return label && *label == constant_label(0, memory->size());
+}
+
+/**
+ * @brief Checks if @p operand is a register with the same base as the register @p reg.
+ */
+static bool is_same_register(const Operand& operand, const Operand& reg) {
+    const auto* first = std::get_if<Register>(&operand);
+    const auto* second = std::get_if<Register>(&reg);
+    return first && second && first->base() == second->base();
+}
+
 void Generator::run() {
     _module.accept(*this);
+
+    std::vector<std::pair<std::string, const Fragment*>> fragments;
+    for (auto& function : _module) fragments.emplace_back(function.name(), &_fragments.at(function.name()));
+
+    stitch(Fragment::call_order(fragments));
 }
 
-std::stringstream Generator::output() const {
-    std::stringstream output;
+void Generator::instrument(const std::string& path) {
+    _profile_path = std::filesystem::absolute(path).string();
+}
 
-    for (const auto& item : this->_text) output << item << "\n";
-    for (const auto& item : this->_data) output << item << "\n";
+void Generator::select_target(const Target& target, const bool contract) {
+    _target = target;
+    _contract = contract;
+}
 
-    return output;
+void Generator::select_debug_info(const DebugInfo level) {
+    _debug_info = level;
 }
 
-void Generator::visit(il::Module& module) {
+void Generator::stitch(const std::vector<const Fragment*>& fragments) {
+    _stitched = fragments;
+    _profile.clear();
+    _text.clear();
+    _data.clear();
+    _literals.clear();
+
+    _pool(fragments);
+
     _directive(".section .data", _data);
 
     _directive(".intel_syntax noprefix", _text);
-    _directive(".file 1 \"" + _source->path() + "\"", _text);
+    if (_debug_info != DebugInfo::None) _directive(".file 1 \"" + _source->path() + "\"", _text);
     _newline(_text);
 
     _directive(".section .text", _text);
     _directive(".global _start", _text);
     _label("_start");
     _call("main");
-    _mov(RDI, RAX);
+
+    size_t counters = 0;
+    for (const auto* fragment : fragments) counters += fragment->counters.size();
+
+    if (counters != 0 && _profile_path.has_value()) {
+        // The exit code is kept in a register that is not clobbered by a syscall.
+        _mov(RBX, RAX);
+
+        // open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)
+        _mov(RAX, 2);
+        _lea(RDI, Memory(Size::QWORD, "__arkoi_profile.path"));
+        _mov(RSI, 577);
+        _mov(RDX, 420);
+        _syscall();
+
+        // write(fd, __arkoi_profile, size), every counter is a key and a count directive.
+        _mov(RDI, RAX);
+        _mov(RAX, 1);
+        _lea(RSI, Memory(Size::QWORD, "__arkoi_profile"));
+        _mov(RDX, static_cast<uint32_t>(counters * 8));
+        _syscall();
+
+        // close(fd)
+        _mov(RAX, 3);
+        _syscall();
+
+        _mov(RDI, RBX);
+    } else {
+        _mov(RDI, RAX);
+    }
+
     _mov(RAX, 60);
     _syscall();
     _newline(_text);
 
+    if (counters == 0 || !_profile_path.has_value()) return;
+
+    _directive("\t.p2align 3", _profile);
+    _profile.emplace_back(Label("__arkoi_profile"));
+    for (const auto* fragment : fragments) {
+        _profile.insert(_profile.end(), fragment->counters.begin(), fragment->counters.end());
+    }
+
+    std::string path;
+    for (const auto character : _profile_path.value()) {
+        if (character == '\\' || character == '"') path += '\\';
+        path += character;
+    }
+    _directive("\t__arkoi_profile.path: .asciz\t\"" + path + "\"", _profile);
+}
+
+void Generator::_pool(const std::vector<const Fragment*>& fragments) {
+    // Every constant is defined once for the whole listing, no matter how many fragments reference it.
+    std::set<std::string> singles, doubles;
+    for (const auto* fragment : fragments) {
+        for (const auto& item : fragment->constants) {
+            const auto& definition = std::get<Directive>(item).text();
+            auto& constants = definition.starts_with("\t.Lf64.") ? doubles : singles;
+            constants.insert(definition);
+        }
+    }
+
+    // The sections are mergeable, thus the linker also folds identical constants of other objects.
+    const auto emit = [&](const std::set<std::string>& constants, const std::string& size, const std::string& align) {
+        if (constants.empty()) return;
+
+        _directive(".section .rodata.cst" + size + ",\"aM\",@progbits," + size, _literals);
+        _directive("\t.p2align " + align, _literals);
+        for (const auto& definition : constants) _directive(definition, _literals);
+    };
+
+    emit(doubles, "8", "3");
+    emit(singles, "4", "2");
+}
+
+void Generator::write(std::ostream& output) const {
+    utils::OutputBuffer buffer(output);
+
+    for (const auto items : text()) {
+        for (const auto& item : items) buffer << item << '\n';
+    }
+
+    for (const auto items : data()) {
+        for (const auto& item : items) buffer << item << '\n';
+    }
+}
+
+std::vector<std::span<const AssemblyItem>> Generator::text() const {
+    // Every fragment is followed by an empty line, which separates the functions in the listing.
+    static const std::vector<AssemblyItem> NEWLINE{ Directive("") };
+
+    std::vector<std::span<const AssemblyItem>> parts{ _text };
+    for (const auto* fragment : _stitched) {
+        parts.emplace_back(fragment->text);
+        parts.emplace_back(NEWLINE);
+    }
+
+    return parts;
+}
+
+std::vector<std::span<const AssemblyItem>> Generator::data() const {
+    std::vector<std::span<const AssemblyItem>> parts{ _data };
+    for (const auto* fragment : _stitched) parts.emplace_back(fragment->data);
+    parts.emplace_back(_profile);
+    parts.emplace_back(_literals);
+
+    return parts;
+}
+
+void Generator::visit(il::Module& module) {
     for (auto& function : module) {
         function.accept(*this);
-        _newline(_text);
     }
 }
 
 void Generator::visit(il::Function& function) {
     _function = &function;
+    _constants.clear();
+    _debug_span = { };
+
+    // The blocks are emitted along their likely paths, so most branches become fall-throughs.
+    _layout.emplace(function);
+    const auto& blocks = _layout->blocks();
 
+    _directive(BlockLayout::directive(_layout->section()), _text);
     _directive(".global " + function.name(), _text);
     _directive(".type " + function.name() + ", @function", _text);
 
     _label(function.name());
-    for (auto& block : function) {
-        block.accept(*this);
-    }
+    if (function.is_memoized()) _memoize(function);
 
+    // The integer arithmetic that forms an address is computed by a single LEA, and if allowed a multiplication
+    // followed by an addition by a single FMA.
+    _selector.emplace(function, current_resolver(), _target.avx && _target.fma && _contract);
+
+    for (size_t index = 0; index < _layout->split(); index++) {
+        blocks[index]->accept(*this);
+    }
 
     _directive(".size " + function.name() + ", .-" + function.name(), _text);
-}
 
-void Generator::visit(il::BasicBlock& block) {
-    // Reset the debug span every time a new basic block is generated.
-    _debug_span = { };
+    // The blocks that never executed are reached by a jump into the unlikely section, every block ends in one.
+    if (_layout->split() != blocks.size()) {
+        const auto cold = function.name() + ".cold";
 
-    if (_function->entry() == &block) {
-        // If we are in a leaf function and the stack size in less or equal to 128 bytes (redzone), we can skip the enter
-        // instruction.
-        const auto stack_size = current_resolver().stack_size();
-        if (!_function->is_leaf() || stack_size > 128) _enter(stack_size);
+        _directive(BlockLayout::directive(BlockLayout::Section::Unlikely), _text);
+        _debug_span = { };
+        _directive(".type " + cold + ", @function", _text);
+        _label(cold);
 
-        const auto& mappings = current_resolver().mappings();
-        std::set<Register::Base> saved_registers;
+        for (size_t index = _layout->split(); index < blocks.size(); index++) {
+            blocks[index]->accept(*this);
+        }
 
-        for (const auto& operand : mappings | std::views::values) {
-            auto* reg = std::get_if<Register>(&operand);
-            if (!reg) continue;
+        _directive(".size " + cold + ", .-" + cold, _text);
+    }
+
+    // Every function is generated into an empty listing, which is then moved into its own fragment.
+    auto& fragment = _fragments[function.name()];
+    fragment.text = std::exchange(_text, { });
+    fragment.data = std::exchange(_data, { });
+    fragment.counters.clear();
+    if (_profile_path.has_value()) {
+        for (auto* block : _layout->blocks()) {
+            const auto key = il::Profile::key(function.name(), block->label());
+            fragment.counters.emplace_back(Directive("\t.quad\t" + std::to_string(key)));
+            fragment.counters.emplace_back(Directive("\t" + _counter_label(*block) + ": .quad\t0"));
+        }
+    }
+
+    _peephole.run(fragment.text);
 
-            const auto base = reg->base();
-            const auto is_callee_saved = std::ranges::find(INTEGER_CALLEE_SAVED, base) != INTEGER_CALLEE_SAVED.end();
-            if (!is_callee_saved) continue;
+    // Only the constants that are still loaded are kept, as a zero is materialized without a load.
+    std::set<std::string> referenced;
+    for (const auto& item : fragment.text) {
+        const auto* instruction = std::get_if<Instruction>(&item);
+        if (!instruction) continue;
 
-            saved_registers.insert(base);
+        for (const auto& operand : instruction->operands()) {
+            const auto* memory = std::get_if<Memory>(&operand);
+            const auto* label = memory ? std::get_if<std::string>(&memory->address()) : nullptr;
+            if (label) referenced.insert(*label);
+        }
+    }
+
+    fragment.constants.clear();
+    for (const auto& [label, definition] : _constants) {
+        if (referenced.contains(label)) fragment.constants.emplace_back(Directive(definition));
+    }
+}
+
+void Generator::visit(il::BasicBlock& block) {
+    // Reset the debug span every time a new basic block is generated, unless only the line changes are of interest.
+    if (_debug_info == DebugInfo::Full) _debug_span = { };
+
+    if (_function->entry() == &block) {
+        const auto saved_registers = _callee_saved();
+        const auto& resolver = current_resolver();
+        const auto stack_size = resolver.stack_size();
+
+        // Leaf functions with a small stack use the redzone below RSP, thus they need no frame at all.
+        if (resolver.frame() == Frame::FramePointer) {
+            // The push of RBP realigns the stack, only an odd amount of callee-saved registers pushed below the
+            // frame would misalign every call.
+            const auto padding = saved_registers.size() % 2 == 0 ? 0 : 8;
+            _push(RBP);
+            _mov(RBP, RSP);
+            if (stack_size + padding != 0) _sub(RSP, stack_size + padding);
         }
 
         for (const auto& base : saved_registers) {
             _push(Register(base, Size::QWORD));
         }
+
+        // Without a frame pointer the frame is allocated below the callee-saved registers, which are pushed first.
+        if (const auto frame_size = _frame_size(); frame_size != 0) _sub(RSP, frame_size);
     } else {
+        // Loop headers are the target of every back edge, thus they are aligned to a fetch block.
+        if (_layout->is_loop_header(&block)) _directive("\t.p2align 4", _text);
+
         // Just a normal block.
-        _label(block.label());
+        _label(_block_label(block.label()));
     }
 
-    for (auto& instruction : block) {
-        std::stringstream output;
-        output << "\t# ";
-        il::ILPrinter printer(output);
-        instruction.accept(printer);
+    // The counter is incremented after the prologue, which keeps the frame setup at the function entry.
+    if (_profile_path.has_value()) _add(Memory(Size::QWORD, _counter_label(block)), 1);
+
+    auto& instructions = block.instructions();
+    for (size_t index = 0; index < instructions.size(); index++) {
+        auto& instruction = instructions[index];
 
-        _directive(output.str(), _text);
+        std::ostringstream output;
+        {
+            utils::OutputBuffer buffer(output, 128);
+            buffer << "\t# ";
+
+            il::ILPrinter printer(buffer);
+            instruction.accept(printer);
+        }
+
+        _directive(std::move(output).str(), _text);
 
         if (!(std::holds_alternative<il::Argument>(instruction) || std::holds_alternative<il::Alloca>(instruction))) {
             _debug_line(instruction);
         }
 
+        // A call whose result is returned right away reuses the frame of the caller, this replaces the
+        // epilogue of the exit block.
+        if (_is_tail_call(block, index)) {
+            _tail_call(std::get<il::Call>(instruction));
+            return;
+        }
+
+        // The instruction is computed as part of the address of the one following it.
+        if (const auto* binary = std::get_if<il::Binary>(&instruction); binary && _selector->is_folded(*binary)) {
+            continue;
+        }
+
+        // A comparison only consumed by the following branch or select sets the flags without materializing a boolean.
+        if (_is_fused_condition(block, index)) {
+            auto& binary = std::get<il::Binary>(instruction);
+            _compare(_load(binary.left()), _load(binary.right()), binary.op_type());
+            _fused_condition = _branch_opcode(binary);
+            continue;
+        }
+
         instruction.accept(*this);
 
         // Whenever a call instruction is generated, reset the debug span so a new debug line will
         // be created.
-        if (std::holds_alternative<il::Call>(instruction)) {
+        if (_debug_info == DebugInfo::Full && std::holds_alternative<il::Call>(instruction)) {
             _debug_span = { };
         }
     }
 
     if (_function->exit() == &block) {
-        const auto& mappings = current_resolver().mappings();
-        std::set<Register::Base> saved_registers;
+        _epilogue();
+        _ret();
+    }
+}
 
-        for (const auto& operand : mappings | std::views::values) {
-            auto* reg = std::get_if<Register>(&operand);
-            if (!reg) continue;
+void Generator::_memoize(il::Function& function) {
+    const auto table = function.name() + ".memo";
+    const auto miss = table + ".miss";
+    const auto body = table + ".body";
 
-            const auto base = reg->base();
-            const auto is_callee_saved = std::ranges::find(INTEGER_CALLEE_SAVED, base) != INTEGER_CALLEE_SAVED.end();
-            if (!is_callee_saved) continue;
+    const Register index(Register::Base::R10, Size::QWORD), base(Register::Base::R11, Size::QWORD);
+    const auto& type = function.type();
 
-            saved_registers.insert(base);
-        }
+    // The argument is zero extended, thus negative ones are out of range just like the too large ones.
+    const auto parameter = function.parameters().front().type().integral()->size();
+    switch (parameter) {
+        case Size::BYTE:
+        case Size::WORD: _movzx(Register(index.base(), Size::DWORD), Register(Register::Base::DI, parameter)); break;
+        case Size::DWORD: _mov(Register(index.base(), Size::DWORD), Register(Register::Base::DI, Size::DWORD)); break;
+        case Size::QWORD: _mov(index, RDI); break;
+    }
 
-        for (const auto& base : std::views::reverse(saved_registers)) {
-            _pop(Register(base, Size::QWORD));
-        }
+    _cmp(index, MEMO_ENTRIES);
+    _text.emplace_back(Instruction(Instruction::Opcode::JAE, { body }));
 
-        // If the function is not a leaf or the stack size exceeds 128 bytes, we need to restore the stack using the
-        // leave instruction.
-        const auto stack_size = current_resolver().stack_size();
-        if (!_function->is_leaf() || stack_size > 128) _leave();
+    _shl(index, 4);
+    _lea(base, Memory(Size::QWORD, table));
+    _add(index, base);
 
-        _ret();
+    const Memory value(Size::QWORD, index, 0), filled(Size::QWORD, index, 8);
+    _cmp(filled, 0);
+    _text.emplace_back(Instruction(Instruction::Opcode::JE, { miss }));
+
+    const Register xmm0(Register::Base::XMM0, Size::QWORD);
+    if (type.is_floating() && type.floating()->size() == Size::DWORD) {
+        _movss(xmm0, value);
+    } else if (type.is_floating()) {
+        _movsd(xmm0, value);
+    } else {
+        _mov(RAX, value);
+    }
+    _ret();
+
+    // The entry stays in a caller-saved register across the call, which also keeps the stack 16-byte aligned.
+    _label(miss);
+    _push(index);
+    _call(body);
+    _pop(index);
+
+    if (type.is_floating() && type.floating()->size() == Size::DWORD) {
+        _movss(value, xmm0);
+    } else if (type.is_floating()) {
+        _movsd(value, xmm0);
+    } else {
+        _mov(value, RAX);
     }
+    _mov(filled, 1);
+    _ret();
+
+    _label(body);
+    _directive("\t.local " + table, _data);
+    _directive("\t.comm " + table + ", " + std::to_string(MEMO_ENTRIES * 16) + ", 16", _data);
+}
+
+std::set<Register::Base> Generator::_callee_saved() const {
+    std::set<Register::Base> saved_registers;
+
+    for (const auto& operand : current_resolver().mappings() | std::views::values) {
+        auto* reg = std::get_if<Register>(&operand);
+        if (!reg) continue;
+
+        const auto base = reg->base();
+        const auto is_callee_saved = std::ranges::find(INTEGER_CALLEE_SAVED, base) != INTEGER_CALLEE_SAVED.end();
+        if (!is_callee_saved) continue;
+
+        saved_registers.insert(base);
+    }
+
+    return saved_registers;
+}
+
+void Generator::_epilogue() {
+    if (const auto frame_size = _frame_size(); frame_size != 0) _add(RSP, frame_size);
+
+    const auto saved_registers = _callee_saved();
+    for (const auto& base : std::views::reverse(saved_registers)) {
+        _pop(Register(base, Size::QWORD));
+    }
+
+    if (current_resolver().frame() == Frame::FramePointer) _leave();
+}
+
+size_t Generator::_frame_size() const {
+    const auto& resolver = current_resolver();
+    if (resolver.frame() != Frame::StackPointer) return 0;
+
+    // The return address and the callee-saved registers are below the frame, which has to realign the stack.
+    const auto padding = _callee_saved().size() % 2 == 0 ? 8 : 0;
+    return resolver.stack_size() + padding;
+}
+
+bool Generator::_is_tail_call(il::BasicBlock& block, const size_t index) {
+    if (_function->exit() != &block) return false;
+
+    auto& instructions = block.instructions();
+    if (index + 1 >= instructions.size()) return false;
+
+    auto* call = std::get_if<il::Call>(&instructions[index]);
+    auto* _return = std::get_if<il::Return>(&instructions[index + 1]);
+    if (!call || !_return || _return->value() != il::Operand(call->result())) return false;
+
+    // Arguments on the stack would need to be placed in the incoming argument area of the caller.
+    const auto& frame = current_resolver().call_frames().at(call);
+    return frame.stack.empty() && frame.stack_size == 0;
+}
+
+void Generator::_tail_call(il::Call& instruction) {
+    _generate_arguments(current_resolver().call_frames().at(&instruction));
+
+    // The callee returns directly to the caller of this function, with the result already in place.
+    _epilogue();
+    _jmp(instruction.name());
 }
 
 void Generator::visit(il::Binary& instruction) {
@@ -147,6 +510,19 @@ void Generator::visit(il::Binary& instruction) {
     const auto right = _load(instruction.right());
     const auto& type = instruction.op_type();
 
+    if (const auto* address = _selector->address(instruction)) {
+        // The address is always computed with the full registers, only the lower half is used of a 32-bit result.
+        const auto full = [&](const il::Variable& variable) {
+            return Register(std::get<Register>(_load(variable)).base(), Size::QWORD);
+        };
+
+        const auto index = address->index ? std::optional(full(*address->index)) : std::nullopt;
+        return _lea(result, Memory(Size::QWORD, full(address->base), index, address->scale, address->displacement));
+    }
+
+    if (const auto* pattern = _selector->fused(instruction)) return _fused(result, *pattern, type);
+    if (const auto* pattern = _selector->packed(instruction)) return _packed(*pattern);
+
     switch (instruction.op()) {
         case il::Binary::Operator::Add: return _add(result, left, right, type);
         case il::Binary::Operator::Sub: return _sub(result, left, right, type);
@@ -158,30 +534,34 @@ void Generator::visit(il::Binary& instruction) {
         case il::Binary::Operator::LessEqual: return _loe(result, left, right, type);
         case il::Binary::Operator::Equal: return _equ(result, left, right, type);
         case il::Binary::Operator::NotEqual: return _neq(result, left, right, type);
+        case il::Binary::Operator::Shl: return _shift_left(result, left, right, type);
+        case il::Binary::Operator::Shr: return _shift_right(result, left, right, type);
     }
 
     std::unreachable();
 }
 
 void Generator::_add(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (left != result || !std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
-
+    if (type.is_floating()) {
         // Depending on the size of the type, either choose addsd or addss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_addsd : &Generator::_addss;
-        (this->*instruction)(left, right);
-
-        // Finally, store the lhs (where the result is written to) to the result operand.
-        _store(left, result, type);
+        const auto is_double = type.size() == Size::QWORD;
+        const auto legacy = is_double ? &Generator::_addsd : &Generator::_addss;
+        const auto avx = is_double ? Instruction::Opcode::VADDSD : Instruction::Opcode::VADDSS;
+        _scalar(legacy, avx, result, left, right, type);
     } else {
+        // The addition is commutative, thus a result sharing the register of the right operand just adds the left.
+        if (is_same_register(right, result) && !std::holds_alternative<Immediate>(left)) {
+            _add(result, left);
+            return;
+        }
+
         // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
         // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (left != result || !std::holds_alternative<Register>(left)) {
+        // A result in a register is used as the left operand itself, unless the right operand would be overwritten.
+        if (left != result && std::holds_alternative<Register>(result) && !is_same_register(right, result)) {
+            _store(left, result, type);
+            left = result;
+        } else if (left != result || !std::holds_alternative<Register>(left)) {
             left = _store_temp_1(left, type);
         }
 
@@ -193,24 +573,20 @@ void Generator::_add(const Operand& result, Operand left, const Operand& right,
 }
 
 void Generator::_sub(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (left != result || !std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
-
+    if (type.is_floating()) {
         // Depending on the size of the type, either choose subsd or subss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_subsd : &Generator::_subss;
-        (this->*instruction)(left, right);
-
-        // Finally, store the lhs (where the result is written to) to the result operand.
-        _store(left, result, type);
+        const auto is_double = type.size() == Size::QWORD;
+        const auto legacy = is_double ? &Generator::_subsd : &Generator::_subss;
+        const auto avx = is_double ? Instruction::Opcode::VSUBSD : Instruction::Opcode::VSUBSS;
+        _scalar(legacy, avx, result, left, right, type);
     } else {
         // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
         // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (left != result || !std::holds_alternative<Register>(left)) {
+        // A result in a register is used as the left operand itself, unless the right operand would be overwritten.
+        if (left != result && std::holds_alternative<Register>(result) && !is_same_register(right, result)) {
+            _store(left, result, type);
+            left = result;
+        } else if (left != result || !std::holds_alternative<Register>(left)) {
             left = _store_temp_1(left, type);
         }
 
@@ -221,28 +597,44 @@ void Generator::_sub(const Operand& result, Operand left, const Operand& right,
     }
 }
 
-void Generator::_mul(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (left != result || !std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
-
+void Generator::_mul(const Operand& result, Operand left, Operand right, const sem::Type& type) {
+    if (type.is_floating()) {
         // Depending on the size of the type, either choose mulsd or mulss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_mulsd : &Generator::_mulss;
-        (this->*instruction)(left, right);
-
-        // Finally, store the lhs (where the result is written to) to the result operand.
-        _store(left, result, type);
+        const auto is_double = type.size() == Size::QWORD;
+        const auto legacy = is_double ? &Generator::_mulsd : &Generator::_mulss;
+        const auto avx = is_double ? Instruction::Opcode::VMULSD : Instruction::Opcode::VMULSS;
+        _scalar(legacy, avx, result, left, right, type);
     } else {
+        // The multiplication is commutative, thus a result sharing the register of the right operand is swapped.
+        if (is_same_register(right, result)) std::swap(left, right);
+
         // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
         // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (left != result || !std::holds_alternative<Register>(left)) {
+        // A result in a register is used as the left operand itself, which saves the scratch register.
+        if (left != result && std::holds_alternative<Register>(result)) {
+            _store(left, result, type);
+            left = result;
+        } else if (left != result || !std::holds_alternative<Register>(left)) {
             left = _store_temp_1(left, type);
         }
 
+        // The immediate of imul is sign-extended from 32bit, thus wider immediates need to be in a register first.
+        const auto* immediate = std::get_if<Immediate>(&right);
+        if (immediate && type.size() == Size::QWORD) {
+            const auto is_wide = std::visit(
+                match{
+                    [](const uint64_t value) { return value > std::numeric_limits<int32_t>::max(); },
+                    [](const int64_t value) {
+                        return value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max();
+                    },
+                    [](const auto&) { return false; },
+                },
+                *immediate
+            );
+
+            if (is_wide) right = _store_temp_2(right, type);
+        }
+
         // When discarding the upper part of the multiplication result, imul and mul are indistinguishable. Thus, just
         // imul is used as it also is easier to handle.
         _imul(left, right);
@@ -253,212 +645,339 @@ void Generator::_mul(const Operand& result, Operand left, const Operand& right,
 }
 
 void Generator::_div(const Operand& result, Operand left, Operand right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (left != result || !std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
-
+    if (type.is_floating()) {
         // Depending on the size of the type, either choose divsd or divss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_divsd : &Generator::_divss;
-        (this->*instruction)(left, right);
-
-        // Finally, store the lhs (where the result is written to) to the result operand.
-        _store(left, result, type);
+        const auto is_double = type.size() == Size::QWORD;
+        const auto legacy = is_double ? &Generator::_divsd : &Generator::_divss;
+        const auto avx = is_double ? Instruction::Opcode::VDIVSD : Instruction::Opcode::VDIVSS;
+        _scalar(legacy, avx, result, left, right, type);
     } else {
-        // First store the lhs operand in the "A" register of the given operand size.
+        // The div/idiv instruction only accepts mem/reg, thus an immediate must be converted. The same goes for a
+        // divisor in the "A" or "D" register, as both are overwritten before the division.
+        const auto* right_reg = std::get_if<Register>(&right);
+        const auto is_clobbered = right_reg && (right_reg->base() == Register::Base::A || right_reg->base() == Register::Base::D);
+        if (std::holds_alternative<Immediate>(right) || is_clobbered) {
+            right = _store_temp_2(right, type);
+        }
+
+        // Then store the lhs operand in the "A" register of the given operand size.
         auto a_reg = Register(Register::Base::A, type.size());
         _store(left, a_reg, type);
 
-        // The div/idiv instruction only accepts mem/reg, thus an immediate must be converted.
-        if (std::holds_alternative<Immediate>(right)) {
-            right = _store_temp_2(right, type);
+        // The dividend is formed by the "D" and "A" registers, thus the upper half needs to be sign- or zero-extended.
+        auto integral = type.integral();
+        const auto is_signed = integral && integral->sign();
+        if (!is_signed) {
+            _mov(Register(Register::Base::D, Size::DWORD), Immediate(0u));
+        } else if (type.size() == Size::QWORD) {
+            _cqo();
+        } else {
+            _cdq();
         }
 
         // Depending on the signess of the integral value, we need to choose idiv or div.
-        auto* integral = std::get_if<sem::Integral>(&type);
-        const auto& instruction = (integral && integral->sign()) ? &Generator::_idiv : &Generator::_udiv;
+        const auto& instruction = is_signed ? &Generator::_idiv : &Generator::_udiv;
         (this->*instruction)(right);
 
         _store(a_reg, result, type);
     }
 }
 
-void Generator::_gth(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
-
-        // Depending on the size of the type, either choose ucomisd or ucomiss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_ucomisd : &Generator::_ucomiss;
-        (this->*instruction)(left, right);
+void Generator::_scalar(
+    void (Generator::*legacy)(const Operand&, const Operand&), const Instruction::Opcode avx, const Operand& result,
+    Operand left, const Operand& right, const sem::Type& type
+) {
+    if (_target.avx) {
+        // The VEX form takes its first source in a register and doesn't overwrite it, thus the result is written
+        // straight to its register. Only a result in memory goes through the scratch register.
+        if (!std::holds_alternative<Register>(left)) left = _store_temp_1(left, type);
 
-        _seta(result);
-    } else {
-        // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
-        // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+        const auto destination = std::holds_alternative<Register>(result) ? result : Operand(_temp_1_register(type));
+        _vex(avx, destination, left, right);
 
-        _cmp(left, right);
+        _store(destination, result, type);
+        return;
+    }
 
-        const auto* integral = std::get_if<sem::Integral>(&type);
-        const auto& instruction = (integral && integral->sign()) ? &Generator::_setg : &Generator::_seta;
-        (this->*instruction)(result);
+    // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
+    // we just need to adjust the lhs to a register, which we always do.
+    // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
+    if (left != result || !std::holds_alternative<Register>(left)) {
+        left = _store_temp_1(left, type);
     }
+
+    (this->*legacy)(left, right);
+
+    // Finally, store the lhs (where the result is written to) to the result operand.
+    _store(left, result, type);
 }
 
-void Generator::_lth(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+void Generator::_fused(const Operand& result, const FusedPattern& pattern, const sem::Type& type) {
+    auto left = _load(pattern.left);
+    const auto right = _load(pattern.right);
+    const auto addend = _load(pattern.addend);
 
-        // Depending on the size of the type, either choose ucomisd or ucomiss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_ucomisd : &Generator::_ucomiss;
-        (this->*instruction)(left, right);
+    // The 231 forms compute `destination = left * right +/- destination`, thus the addend is moved into the
+    // destination first. The result register can only take its place if it doesn't hold one of the factors.
+    if (!std::holds_alternative<Register>(left)) left = _store_temp_2(left, type);
 
-        _setb(result);
-    } else {
-        // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
-        // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+    const auto is_factor = is_same_register(left, result) || is_same_register(right, result);
+    const auto destination = std::holds_alternative<Register>(result) && !is_factor
+        ? result
+        : Operand(_temp_1_register(type));
 
-        _cmp(left, right);
+    _store(addend, destination, type);
 
-        const auto* integral = std::get_if<sem::Integral>(&type);
-        const auto& instruction = (integral && integral->sign()) ? &Generator::_setl : &Generator::_setb;
-        (this->*instruction)(result);
+    const auto is_double = type.size() == Size::QWORD;
+    switch (pattern.kind) {
+        case FusedPattern::Kind::Add: {
+            const auto opcode = is_double ? Instruction::Opcode::VFMADD231SD : Instruction::Opcode::VFMADD231SS;
+            _vex(opcode, destination, left, right);
+            break;
+        }
+        case FusedPattern::Kind::Subtract: {
+            const auto opcode = is_double ? Instruction::Opcode::VFMSUB231SD : Instruction::Opcode::VFMSUB231SS;
+            _vex(opcode, destination, left, right);
+            break;
+        }
+        case FusedPattern::Kind::NegatedAdd: {
+            const auto opcode = is_double ? Instruction::Opcode::VFNMADD231SD : Instruction::Opcode::VFNMADD231SS;
+            _vex(opcode, destination, left, right);
+            break;
+        }
     }
+
+    _store(destination, result, type);
 }
 
-void Generator::_goe(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+void Generator::_packed(const PackedPattern& pattern) {
+    const sem::Type type = sem::Floating(Size::QWORD);
+    auto packed = _temp_1_register(type);
+    auto other = _temp_2_register(type);
 
-        // Depending on the size of the type, either choose ucomisd or ucomiss.
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_ucomisd : &Generator::_ucomiss;
-        (this->*instruction)(left, right);
+    const auto operation = [&](il::Binary& instruction, const Register& destination, const Register& source) {
+        switch (instruction.op()) {
+            case il::Binary::Operator::Add: return _addpd(destination, source);
+            case il::Binary::Operator::Sub: return _subpd(destination, source);
+            case il::Binary::Operator::Mul: return _mulpd(destination, source);
+            case il::Binary::Operator::Div: return _divpd(destination, source);
+            default: std::unreachable();
+        }
+    };
 
-        _setae(result);
+    const auto& [first_lower, first_upper] = pattern.steps.front();
+    _pack(packed, first_lower->left(), first_upper->left());
+    if (first_lower->left() == first_lower->right() && first_upper->left() == first_upper->right()) {
+        operation(*first_lower, packed, packed);
     } else {
-        // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
-        // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
+        _pack(other, first_lower->right(), first_upper->right());
+        operation(*first_lower, packed, other);
+    }
+
+    for (size_t index = 1; index < pattern.steps.size(); index++) {
+        const auto& [lower, upper] = pattern.steps[index];
+
+        // The packed results of the step before are either the left or the right operand of both lanes.
+        if (lower->left() == il::Operand(pattern.steps[index - 1][0]->result())) {
+            _pack(other, lower->right(), upper->right());
+            operation(*lower, packed, other);
+        } else {
+            _pack(other, lower->left(), upper->left());
+            operation(*lower, other, packed);
+            std::swap(packed, other);
         }
+    }
 
-        _cmp(left, right);
+    // Every operand was read already, thus the results can't overwrite any of them anymore.
+    const auto& [last_lower, last_upper] = pattern.steps.back();
+    _store(packed, _load(last_lower->result()), type);
+    _unpckhpd(packed, packed);
+    _store(packed, _load(last_upper->result()), type);
+}
+
+void Generator::_pack(const Register& destination, const il::Operand& lower, const il::Operand& upper) {
+    // A move of the whole register doesn't depend on the previous value of the destination, unlike movsd.
+    const auto low = _load(lower);
+    if (std::holds_alternative<Register>(low)) _movapd(destination, low);
+    else _movsd(destination, low);
 
-        const auto* integral = std::get_if<sem::Integral>(&type);
-        const auto& instruction = (integral && integral->sign()) ? &Generator::_setge : &Generator::_setae;
-        (this->*instruction)(result);
+    const auto high = _load(upper);
+    if (std::holds_alternative<Register>(high)) _unpcklpd(destination, high);
+    else _movhpd(destination, high);
+}
+
+void Generator::_shift_left(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
+    if (_target.bmi2 && !std::holds_alternative<Immediate>(right) && type.size() >= Size::DWORD) {
+        return _shift_register(Instruction::Opcode::SHLX, result, left, right, type);
+    }
+
+    // The shift amount is always an immediate, which only leaves the lhs to be adjusted to a register.
+    if (left != result || !std::holds_alternative<Register>(left)) {
+        left = _store_temp_1(left, type);
     }
+
+    _shl(left, right);
+
+    // Finally, store the lhs (where the result is written to) to the result operand.
+    _store(left, result, type);
 }
 
-void Generator::_loe(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+void Generator::_shift_right(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
+    // Depending on the signess of the integral value, the sign bit is either shifted in or not.
+    auto integral = type.integral();
+    if (_target.bmi2 && !std::holds_alternative<Immediate>(right) && type.size() >= Size::DWORD) {
+        const auto opcode = (integral && integral->sign()) ? Instruction::Opcode::SARX : Instruction::Opcode::SHRX;
+        return _shift_register(opcode, result, left, right, type);
+    }
+
+    // The shift amount is always an immediate, which only leaves the lhs to be adjusted to a register.
+    if (left != result || !std::holds_alternative<Register>(left)) {
+        left = _store_temp_1(left, type);
+    }
+
+    const auto& instruction = (integral && integral->sign()) ? &Generator::_sar : &Generator::_shr;
+    (this->*instruction)(left, right);
 
+    // Finally, store the lhs (where the result is written to) to the result operand.
+    _store(left, result, type);
+}
+
+void Generator::_shift_register(
+    const Instruction::Opcode opcode, const Operand& result, const Operand& left, Operand right, const sem::Type& type
+) {
+    // The amount is read from a register of the same size as the shifted operand, while the operand itself may be
+    // in memory. The result is written straight to its register, as the source isn't overwritten.
+    if (!std::holds_alternative<Register>(right)) right = _store_temp_2(right, type);
+
+    const auto destination = std::holds_alternative<Register>(result) ? result : Operand(_temp_1_register(type));
+    _vex(opcode, destination, left, right);
+
+    _store(destination, result, type);
+}
+
+void Generator::_compare(Operand left, const Operand& right, const sem::Type& type) {
+    // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
+    // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
+    // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
+    // the same holds for floating point comparisons.
+    if (!std::holds_alternative<Register>(left)) {
+        left = _store_temp_1(left, type);
+    }
+
+    if (type.is_floating()) {
         // Depending on the size of the type, either choose ucomisd or ucomiss.
         const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_ucomisd : &Generator::_ucomiss;
         (this->*instruction)(left, right);
-
-        _setbe(result);
     } else {
-        // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
-        // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
-
         _cmp(left, right);
-
-        const auto* integral = std::get_if<sem::Integral>(&type);
-        const auto& instruction = (integral && integral->sign()) ? &Generator::_setle : &Generator::_setbe;
-        (this->*instruction)(result);
     }
 }
 
-void Generator::_equ(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+void Generator::_gth(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type) {
+    _compare(left, right, type);
 
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_ucomisd : &Generator::_ucomiss;
-        (this->*instruction)(left, right);
+    // Floating point comparisons set the flags like unsigned ones.
+    const auto integral = type.integral();
+    const auto& instruction = (integral && integral->sign()) ? &Generator::_setg : &Generator::_seta;
+    (this->*instruction)(result);
+}
 
-        _sete(result);
-    } else {
-        // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
-        // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+void Generator::_lth(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type) {
+    _compare(left, right, type);
 
-        _cmp(left, right);
+    const auto integral = type.integral();
+    const auto& instruction = (integral && integral->sign()) ? &Generator::_setl : &Generator::_setb;
+    (this->*instruction)(result);
+}
+
+void Generator::_goe(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type) {
+    _compare(left, right, type);
+
+    const auto integral = type.integral();
+    const auto& instruction = (integral && integral->sign()) ? &Generator::_setge : &Generator::_setae;
+    (this->*instruction)(result);
+}
+
+void Generator::_loe(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type) {
+    _compare(left, right, type);
+
+    const auto integral = type.integral();
+    const auto& instruction = (integral && integral->sign()) ? &Generator::_setle : &Generator::_setbe;
+    (this->*instruction)(result);
+}
+
+void Generator::_equ(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type) {
+    _compare(left, right, type);
+    _sete(result);
+}
+
+void Generator::_neq(const Operand& result, const Operand& left, const Operand& right, const sem::Type& type) {
+    _compare(left, right, type);
+    _setne(result);
+}
 
-        _sete(result);
+std::optional<Instruction::Opcode> Generator::_branch_opcode(const il::Binary& instruction) {
+    const auto integral = instruction.op_type().integral();
+    const auto is_signed = integral && integral->sign();
+
+    switch (instruction.op()) {
+        case il::Binary::Operator::GreaterThan: return is_signed ? Instruction::Opcode::JG : Instruction::Opcode::JA;
+        case il::Binary::Operator::LessThan: return is_signed ? Instruction::Opcode::JL : Instruction::Opcode::JB;
+        case il::Binary::Operator::GreaterEqual: return is_signed ? Instruction::Opcode::JGE : Instruction::Opcode::JAE;
+        case il::Binary::Operator::LessEqual: return is_signed ? Instruction::Opcode::JLE : Instruction::Opcode::JBE;
+        case il::Binary::Operator::Equal: return Instruction::Opcode::JE;
+        case il::Binary::Operator::NotEqual: return Instruction::Opcode::JNE;
+        default: return std::nullopt;
     }
 }
 
-void Generator::_neq(const Operand& result, Operand left, const Operand& right, const sem::Type& type) {
-    if (std::holds_alternative<sem::Floating>(type)) {
-        // As there are no direct floating immediates (they will always be replaced with memory operands, see _load),
-        // we just need to adjust the lhs to a register, which we always do.
-        // Thus left:right will always be reg:mem or reg:reg, which is a valid operand encoding.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+Instruction::Opcode Generator::_cmov_opcode(const Instruction::Opcode jump) {
+    switch (jump) {
+        case Instruction::Opcode::JA: return Instruction::Opcode::CMOVA;
+        case Instruction::Opcode::JAE: return Instruction::Opcode::CMOVAE;
+        case Instruction::Opcode::JB: return Instruction::Opcode::CMOVB;
+        case Instruction::Opcode::JBE: return Instruction::Opcode::CMOVBE;
+        case Instruction::Opcode::JG: return Instruction::Opcode::CMOVG;
+        case Instruction::Opcode::JGE: return Instruction::Opcode::CMOVGE;
+        case Instruction::Opcode::JL: return Instruction::Opcode::CMOVL;
+        case Instruction::Opcode::JLE: return Instruction::Opcode::CMOVLE;
+        case Instruction::Opcode::JE: return Instruction::Opcode::CMOVE;
+        case Instruction::Opcode::JNE: return Instruction::Opcode::CMOVNZ;
+        default: throw std::invalid_argument("This is not a conditional jump.");
+    }
+}
 
-        const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_ucomisd : &Generator::_ucomiss;
-        (this->*instruction)(left, right);
+bool Generator::_is_fused_condition(il::BasicBlock& block, const size_t index) {
+    auto& instructions = block.instructions();
+    if (index + 1 >= instructions.size()) return false;
 
-        _setne(result);
-    } else {
-        // The only valid combinations of left:right are reg:mem, reg:reg, mem:reg, reg:imm, mem:imm. But as left will
-        // always be a register, you only need to care about reg:mem, reg:reg, reg:imm, which covers all other cases.
-        if (!std::holds_alternative<Register>(left)) {
-            left = _store_temp_1(left, type);
-        }
+    auto* binary = std::get_if<il::Binary>(&instructions[index]);
+    if (!binary || !_branch_opcode(*binary)) return false;
 
-        _cmp(left, right);
+    const il::Operand result(binary->result());
+    const auto condition = match{
+        [](il::If& user) -> std::optional<il::Operand> { return user.condition(); },
+        [](il::Select& user) -> std::optional<il::Operand> { return user.condition(); },
+        [](auto&) -> std::optional<il::Operand> { return std::nullopt; },
+    };
+    if (std::visit(condition, instructions[index + 1]) != result) return false;
 
-        _setne(result);
+    // The flags only survive until the branch, thus the boolean must not be needed anywhere else.
+    size_t uses = 0;
+    for (auto& current : *_function) {
+        for (auto& other : current.instructions()) {
+            uses += std::ranges::count(other.uses(), result);
+        }
     }
+
+    return uses == 1;
 }
 
 void Generator::visit(il::Cast& instruction) {
     const auto result = _load(instruction.result());
     const auto source = _load(instruction.source());
 
-    std::visit(
+    sem::visit(
         match{
             [&](const sem::Floating& from, const sem::Floating& to) { _float_to_float(result, source, from, to); },
             [&](const sem::Floating& from, const sem::Integral& to) { _float_to_int(result, source, from, to); },
@@ -482,6 +1001,21 @@ void Generator::_float_to_float(
     // If both are the same, a simple move will fulfill
     if (from == to) return _store(source, result, to);
 
+    if (_target.avx) {
+        // The VEX form merges the upper part from its first source, which is the converted value itself. Thus it
+        // neither depends on the previous value of the result, nor overwrites the source.
+        if (!std::holds_alternative<Register>(source)) source = _store_temp_1(source, from);
+
+        auto destination = std::holds_alternative<Register>(result) ? std::get<Register>(result) : _temp_1_register(to);
+        destination.set_size(to.size());
+
+        const auto is_double = from.size() == Size::QWORD;
+        const auto opcode = is_double ? Instruction::Opcode::VCVTSD2SS : Instruction::Opcode::VCVTSS2SD;
+        _vex(opcode, destination, source, source);
+
+        return _store(destination, result, to);
+    }
+
     const auto* source_reg = std::get_if<Register>(&source);
     const auto* result_reg = std::get_if<Register>(&result);
     if (!source_reg || !result_reg || source_reg->base() != result_reg->base()) {
@@ -504,8 +1038,8 @@ void Generator::_int_to_int(
     // If both are the same exact type, store the source in the result.
     if (from == to) return _store(source, result, to);
 
-    if (from.sign() == to.sign() && !from.sign() && from.size() == Size::DWORD && to.size() == Size::QWORD) {
-        // This catches the case when you want to transform a 32bit unsigned integer to a 64bit unsigned integer.
+    if (!from.sign() && from.size() == Size::DWORD && to.size() == Size::QWORD) {
+        // This catches the case when you want to transform a 32bit unsigned integer to a 64bit integer.
         // There is no zero extension of such operand types, as all 32bit operations implicitly zero-extend 32bit to
         // 64bit.
         auto temp_1_32 = _temp_1_register(from);
@@ -513,8 +1047,8 @@ void Generator::_int_to_int(
 
         auto temp_1_64 = _temp_1_register(to);
         _store(temp_1_64, result, to);
-    } else if (from.sign() == to.sign() && from.sign() && from.size() == Size::DWORD && to.size() == Size::QWORD) {
-        // This is another case where a 32bit signed integer is converted to a 64bit signed integer. The standard movsx
+    } else if (from.sign() && from.size() == Size::DWORD && to.size() == Size::QWORD) {
+        // This is another case where a 32bit signed integer is converted to a 64bit integer. The standard movsx
         // is not applicable to this case, thus there is the movsxd instruction that covers this case.
 
         // movsxd only works with reg:mem or reg:reg, thus convert imm to reg.
@@ -637,17 +1171,32 @@ void Generator::_int_to_float(
         source = converted_source;
     }
 
-    // A temporary floating register that is needed to hold the converted integer.
-    auto temp_1_sse = _temp_1_register(to);
-
-    // Either choose the cvtsi2ss/cvtsi2sd instruction based on the size.
-    const auto& instruction = (to.size() == Size::QWORD) ? &Generator::_cvtsi2sd : &Generator::_cvtsi2ss;
-    (this->*instruction)(temp_1_sse, source);
+    // Convert the integer into a temporary floating register, either as float (cvtsi2ss) or double (cvtsi2sd).
+    const auto temp_1_sse = _convert_to_float(source, to);
 
     // Finally, store the calculated result in the result operand.
     _store(temp_1_sse, result, to);
 }
 
+Register Generator::_convert_to_float(const Operand& source, const sem::Floating& to) {
+    const auto temp_1_sse = _temp_1_register(to);
+    const auto is_double = to.size() == Size::QWORD;
+
+    if (_target.avx) {
+        _vex(Instruction::Opcode::VXORPS, temp_1_sse, temp_1_sse, temp_1_sse);
+
+        const auto opcode = is_double ? Instruction::Opcode::VCVTSI2SD : Instruction::Opcode::VCVTSI2SS;
+        _vex(opcode, temp_1_sse, temp_1_sse, source);
+    } else {
+        _xorps(temp_1_sse, temp_1_sse);
+
+        const auto& instruction = is_double ? &Generator::_cvtsi2sd : &Generator::_cvtsi2ss;
+        (this->*instruction)(temp_1_sse, source);
+    }
+
+    return temp_1_sse;
+}
+
 void Generator::_int_to_bool(
     const Operand& result, Operand source, const sem::Integral& from,
     const sem::Boolean& to
@@ -679,14 +1228,12 @@ void Generator::_bool_to_float(
 
     // One sse and one int register is needed to transform a bool to a float.
     const auto temp_1_int = _temp_1_register(sem::Integral(Size::DWORD, false));
-    const auto temp_1_sse = _temp_1_register(to);
 
     // Zero-extend the bool to 32bit.
     _movzx(temp_1_int, source);
 
     // Convert the 32bit integer to either a float (cvtsi2ss) or double (cvtsi2sd).
-    const auto& instruction = (to.size() == Size::QWORD) ? &Generator::_cvtsi2sd : &Generator::_cvtsi2ss;
-    (this->*instruction)(temp_1_sse, temp_1_int);
+    const auto temp_1_sse = _convert_to_float(temp_1_int, to);
 
     // Finally, store the calculated result in the result operand.
     _store(temp_1_sse, result, to);
@@ -722,49 +1269,115 @@ void Generator::_bool_to_int(
 }
 
 void Generator::visit(il::Call& instruction) {
-    auto& [
-        integer,
-        floating,
-        stack,
-        stack_size
-    ] = current_resolver().call_frames().at(&instruction);
+    const auto& frame = current_resolver().call_frames().at(&instruction);
 
     const auto result = _load(instruction.result());
     const auto type = instruction.result().type();
 
-    for (const auto& current : integer) {
-        _generate_argument(*current);
-    }
-
-    for (const auto& current : floating) {
-        _generate_argument(*current);
-    }
-
-    for (const auto& current : std::views::reverse(stack)) {
-        _generate_argument(*current);
-    }
+    _generate_arguments(frame);
 
     _call(instruction.name());
 
-    if (stack_size != 0) _add(RSP, stack_size);
+    if (frame.stack_size != 0) _add(RSP, frame.stack_size);
+    _pushed = 0;
 
     const auto return_reg = PreColorer::return_register(type);
     _store(return_reg, result, type);
 }
 
-void Generator::_generate_argument(il::Argument& argument) {
-    const auto result = _load(argument.result());
-    const auto source = _load(argument.source());
-    const auto type = argument.result().type();
+void Generator::_generate_arguments(const CallFrame& frame) {
+    // The pushes only read the sources, thus they come first and leave every register untouched for the moves.
+    for (auto* argument : std::views::reverse(frame.stack)) {
+        _push(_pushed_relative(_load(argument->source())));
+        _pushed += 8;
+    }
 
-    if (std::holds_alternative<Memory>(result)) {
-        _push(source);
-    } else {
-        _store(source, result, type);
+    std::vector<ArgumentMove> moves;
+    auto add_moves = [&](const std::vector<il::Argument*>& arguments) {
+        for (auto* argument : arguments) {
+            const auto destination = std::get<Register>(_load(argument->result()));
+            const auto source = _pushed_relative(_load(argument->source()));
+            moves.push_back({ destination, source, argument->result().type() });
+        }
+    };
+
+    add_moves(frame.integer);
+    add_moves(frame.floating);
+
+    _parallel_move(std::move(moves));
+}
+
+void Generator::_parallel_move(std::vector<ArgumentMove> moves) {
+    const auto reads = [](const ArgumentMove& move, const Register& reg) {
+        const auto* source = std::get_if<Register>(&move.source);
+        return source && source->base() == reg.base();
+    };
+
+    std::erase_if(moves, [&](const ArgumentMove& move) { return reads(move, move.destination); });
+
+    // Immediates and stack slots can't be overwritten by any of the moves, thus they're placed last and the
+    // registers are shuffled among each other first.
+    std::vector<ArgumentMove> pending, remaining;
+    for (auto& move : moves) {
+        (std::holds_alternative<Register>(move.source) ? pending : remaining).push_back(std::move(move));
     }
+
+    while (!pending.empty()) {
+        // A move whose destination isn't read by another pending move can be emitted right away.
+        const auto ready = std::ranges::find_if(pending, [&](const ArgumentMove& move) {
+            return std::ranges::none_of(pending, [&](const ArgumentMove& other) {
+                return reads(other, move.destination);
+            });
+        });
+
+        if (ready != pending.end()) {
+            _store(ready->source, ready->destination, ready->type);
+            pending.erase(ready);
+            continue;
+        }
+
+        // Every pending destination is still read, thus they form cycles. One of them is broken by saving the
+        // destination in the scratch register, which then is read instead.
+        const auto destination = pending.front().destination;
+        const auto reader = std::ranges::find_if(pending, [&](const ArgumentMove& move) {
+            return reads(move, destination);
+        });
+
+        const auto saved = _store_temp_1(reader->source, reader->type);
+        for (auto& move : pending) {
+            if (reads(move, destination)) move.source = saved;
+        }
+    }
+
+    for (const auto& [destination, source, type] : remaining) {
+        _store(source, destination, type);
+    }
+}
+
+Operand Generator::_pushed_relative(const Operand& operand) const {
+    // Slots addressed by RBP or placed in the redzone don't move with the pushed arguments.
+    if (current_resolver().frame() != Frame::StackPointer) return operand;
+
+    const auto* memory = std::get_if<Memory>(&operand);
+    if (!memory) return operand;
+
+    const auto* reg = std::get_if<Register>(&memory->address());
+    if (!reg || *reg != RSP) return operand;
+
+    const auto displacement = memory->displacement() + static_cast<int64_t>(_pushed);
+    return Memory(memory->size(), RSP, memory->index(), memory->scale(), displacement);
 }
 
 void Generator::visit(il::If& instruction) {
+    // The flags of a fused comparison are still set, so the branch can be taken on them directly.
+    if (_fused_condition) {
+        _text.emplace_back(Instruction(*_fused_condition, { _block_label(instruction.branch()) }));
+        _fused_condition.reset();
+
+        _jmp(_block_label(instruction.next()));
+        return;
+    }
+
     auto condition = _load(instruction.condition());
 
     // The test instruction only works with reg:imm, mem:imm, reg:reg, mem:reg, thus we simply put the condition in a
@@ -774,12 +1387,12 @@ void Generator::visit(il::If& instruction) {
     }
 
     _test(condition, condition);
-    _jnz(instruction.branch());
-    _jmp(instruction.next());
+    _jnz(_block_label(instruction.branch()));
+    _jmp(_block_label(instruction.next()));
 }
 
 void Generator::visit(il::Goto& instruction) {
-    _jmp(instruction.label());
+    _jmp(_block_label(instruction.label()));
 }
 
 void Generator::visit(il::Store& instruction) {
@@ -796,6 +1409,14 @@ void Generator::visit(il::Load& instruction) {
     _store(source, result, type);
 }
 
+void Generator::visit(il::Return& instruction) {
+    // Returned variables are usually pre-colored to the return register, in which case nothing is moved. But
+    // immediates and variables living on the stack still need to be loaded into it.
+    const auto type = instruction.value().type();
+    const auto return_reg = PreColorer::return_register(type);
+    _store(_load(instruction.value()), return_reg, type);
+}
+
 void Generator::visit(il::Assign& instruction) {
     const auto result = _load(instruction.result());
     const auto immediate = _load(instruction.value());
@@ -803,22 +1424,88 @@ void Generator::visit(il::Assign& instruction) {
     _store(immediate, result, type);
 }
 
+void Generator::visit(il::Select& instruction) {
+    const auto result = _load(instruction.result());
+    const auto type = instruction.result().type();
+
+    const auto condition = _load(instruction.condition());
+
+    // The flags of a fused comparison are still set, none of the moves below change them.
+    const auto fused = std::exchange(_fused_condition, std::nullopt);
+
+    // Constant conditions are usually folded beforehand, but if not there is nothing to select.
+    if (const auto* immediate = std::get_if<Immediate>(&condition)) {
+        const auto taken = std::get<bool>(*immediate) ? instruction.true_value() : instruction.false_value();
+        _store(_load(taken), result, type);
+        return;
+    }
+
+    // Floating point values are selected on their bit patterns in the integer scratch registers.
+    const auto is_floating = type.is_floating();
+    const auto integer_type = is_floating ? sem::Type(sem::Integral(type.size(), false)) : type;
+
+    const auto false_value = _temp_1_register(integer_type);
+    const auto true_value = _temp_2_register(integer_type);
+    if (is_floating) {
+        _move_bits(false_value, _load(instruction.false_value()), type.size());
+        _move_bits(true_value, _load(instruction.true_value()), type.size());
+    } else {
+        _store(_load(instruction.false_value()), false_value, type);
+        _store(_load(instruction.true_value()), true_value, type);
+    }
+
+    // The test instruction only works with registers, memory operands are compared against zero.
+    if (fused) {
+        // The comparison was already emitted in front of the select.
+    } else if (std::holds_alternative<Register>(condition)) {
+        _test(condition, condition);
+    } else {
+        _cmp(condition, 0);
+    }
+
+    // There is no 8-bit conditional move, instead the lower bits of the 32-bit registers are selected.
+    const auto size = std::max(type.size(), Size::DWORD);
+    const auto opcode = fused ? _cmov_opcode(*fused) : Instruction::Opcode::CMOVNZ;
+    _cmov(opcode, Register(false_value.base(), size), Register(true_value.base(), size));
+
+    if (is_floating) {
+        _move_bits(result, false_value, type.size());
+    } else {
+        _store(false_value, result, type);
+    }
+}
+
+void Generator::_move_bits(const Operand& destination, const Operand& source, const Size size) {
+    if (source == destination) return;
+
+    const auto is_sse = [](const Operand& operand) {
+        const auto* reg = std::get_if<Register>(&operand);
+        return reg && reg->base() >= Register::Base::XMM0 && reg->base() <= Register::Base::XMM15;
+    };
+
+    if (!is_sse(destination) && !is_sse(source)) {
+        _mov(destination, source);
+        return;
+    }
+
+    const auto& instruction = (size == Size::QWORD) ? &Generator::_movq : &Generator::_movd;
+    (this->*instruction)(destination, source);
+}
+
 Operand Generator::_load(const il::Operand& operand) {
     return std::visit(
         match{
             [&](const il::Immediate& immediate) -> Operand {
-                if (std::holds_alternative<double>(immediate)) {
-                    const auto name = "float" + std::to_string(_constants++);
-                    const auto value = std::to_string(std::get<double>(immediate));
-                    _directive("\t" + name + ": .double\t" + value, _data);
-                    return Memory(Size::QWORD, name);
+                if (const auto* value = std::get_if<double>(&immediate)) {
+                    const auto label = constant_label(std::bit_cast<uint64_t>(*value), Size::QWORD);
+                    _constants.try_emplace(label, "\t" + label + ": .double\t" + render_floating(*value));
+                    return Memory(Size::QWORD, label);
                 }
 
-                if (std::holds_alternative<float>(immediate)) {
-                    auto name = "float" + std::to_string(_constants++);
-                    const auto value = std::to_string(std::get<float>(immediate));
-                    _directive("\t" + name + ": .float\t" + value, _data);
-                    return Memory(Size::DWORD, name);
+                if (const auto* value = std::get_if<float>(&immediate)) {
+                    const auto label = constant_label(std::bit_cast<uint32_t>(*value), Size::DWORD);
+                    _constants.try_emplace(label, "\t" + label + ": .float\t" + render_floating(*value));
+                    return Memory(Size::DWORD, label);
                 }
 
                 return std::visit([](const auto& value) -> Immediate { return value; }, immediate);
@@ -838,13 +1525,20 @@ void Generator::_store(Operand source, const Operand& destination, const sem::Ty
     // If the source and destination is the same, the mov instruction is not needed.
     if (source == destination) return;
 
+    // A positive zero has no bits set, thus it's cleared in place instead of being loaded from the pool.
+    if (type.is_floating() && is_zero_constant(source)) {
+        const auto* reg = std::get_if<Register>(&destination);
+        if (reg && reg->base() >= Register::Base::XMM0) return _xorps(destination, destination);
+        return _mov(destination, int32_t{ 0 });
+    }
+
     // Since mov instructions only accept operands in the forms (src:dest) reg:mem, mem:reg, imm:reg, or imm:mem,
     // a mem:mem operation must be split into two mov instructions.
     if (std::holds_alternative<Memory>(source) && std::holds_alternative<Memory>(destination)) {
         source = _store_temp_1(source, type);
     }
 
-    if (std::holds_alternative<sem::Floating>(type)) {
+    if (type.is_floating()) {
         const auto& instruction = (type.size() == Size::QWORD) ? &Generator::_movsd : &Generator::_movss;
         (this->*instruction)(destination, source);
     } else {
@@ -859,7 +1553,7 @@ Register Generator::_store_temp_1(const Operand& source, const sem::Type& type)
 }
 
 Register Generator::_temp_1_register(const sem::Type& type) {
-    auto reg_base = (std::holds_alternative<sem::Floating>(type) ? Register::Base::XMM10 : Register::Base::R10);
+    auto reg_base = (type.is_floating() ? Register::Base::XMM10 : Register::Base::R10);
     return { reg_base, type.size() };
 }
 
@@ -870,7 +1564,7 @@ Register Generator::_store_temp_2(const Operand& source, const sem::Type& type)
 }
 
 Register Generator::_temp_2_register(const sem::Type& type) {
-    auto reg_base = (std::holds_alternative<sem::Floating>(type) ? Register::Base::XMM11 : Register::Base::R11);
+    auto reg_base = (type.is_floating() ? Register::Base::XMM11 : Register::Base::R11);
     return { reg_base, type.size() };
 }
 
@@ -879,7 +1573,7 @@ void Generator::_directive(const std::string& directive, std::vector<AssemblyIte
 }
 
 void Generator::_debug_line(const il::Instruction& instruction) {
-    if (!instruction.span().has_value()) return;
+    if (_debug_info == DebugInfo::None || !instruction.span().has_value()) return;
 
     const auto span = instruction.span().value();
     if (_debug_span.has_value()) {
@@ -894,6 +1588,14 @@ void Generator::_label(const std::string& name) {
     _text.emplace_back(Label(name));
 }
 
+std::string Generator::_block_label(const std::string& label) const {
+    return _function->name() + "." + label;
+}
+
+std::string Generator::_counter_label(const il::BasicBlock& block) const {
+    return _block_label(block.label()) + ".count";
+}
+
 void Generator::_jmp(const std::string& name) {
     _text.emplace_back(Instruction(Instruction::Opcode::JMP, { name }));
 }
@@ -990,10 +1692,80 @@ void Generator::_udiv(const Operand& source) {
     _text.emplace_back(Instruction(Instruction::Opcode::DIV, { source }));
 }
 
+void Generator::_cdq() {
+    _text.emplace_back(Instruction(Instruction::Opcode::CDQ, { }));
+}
+
+void Generator::_cqo() {
+    _text.emplace_back(Instruction(Instruction::Opcode::CQO, { }));
+}
+
+void Generator::_shl(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::SHL, { destination, source }));
+}
+
+void Generator::_shr(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::SHR, { destination, source }));
+}
+
+void Generator::_sar(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::SAR, { destination, source }));
+}
+
+void Generator::_cmov(const Instruction::Opcode opcode, const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(opcode, { destination, source }));
+}
+
+void Generator::_movd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::MOVD, { destination, source }));
+}
+
+void Generator::_movq(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::MOVQ, { destination, source }));
+}
+
 void Generator::_xorps(const Operand& destination, const Operand& source) {
     _text.emplace_back(Instruction(Instruction::Opcode::XORPS, { destination, source }));
 }
 
+void Generator::_addpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::ADDPD, { destination, source }));
+}
+
+void Generator::_subpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::SUBPD, { destination, source }));
+}
+
+void Generator::_mulpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::MULPD, { destination, source }));
+}
+
+void Generator::_divpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::DIVPD, { destination, source }));
+}
+
+void Generator::_movapd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::MOVAPD, { destination, source }));
+}
+
+void Generator::_movhpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::MOVHPD, { destination, source }));
+}
+
+void Generator::_unpcklpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::UNPCKLPD, { destination, source }));
+}
+
+void Generator::_unpckhpd(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::UNPCKHPD, { destination, source }));
+}
+
+void Generator::_vex(
+    const Instruction::Opcode opcode, const Operand& destination, const Operand& first, const Operand& second
+) {
+    _text.emplace_back(Instruction(opcode, { destination, first, second }));
+}
+
 void Generator::_or(const Operand& destination, const Operand& source) {
     _text.emplace_back(Instruction(Instruction::Opcode::OR, { destination, source }));
 }
@@ -1082,8 +1854,8 @@ void Generator::_setp(const Operand& destination) {
     _text.emplace_back(Instruction(Instruction::Opcode::SETP, { destination }));
 }
 
-void Generator::_enter(uint16_t size) {
-    _text.emplace_back(Instruction(Instruction::Opcode::ENTER, { size, 0 }));
+void Generator::_lea(const Operand& destination, const Operand& source) {
+    _text.emplace_back(Instruction(Instruction::Opcode::LEA, { destination, source }));
 }
 
 void Generator::_syscall() {
@@ -0,0 +1,199 @@
+#include "arkoi_language/x86_64/jit.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <elf.h>
+#include <limits>
+#include <stdexcept>
+#include <system_error>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+/// The alignment of every section, which matches the largest `.p2align` the generator emits.
+static constexpr size_t SECTION_ALIGNMENT = 16;
+
+/// The sections holding code, in the order they are placed in the executable pages.
+static constexpr std::array CODE_SECTIONS{ Encoder::Section::Hot, Encoder::Section::Text, Encoder::Section::Unlikely };
+
+static size_t align(const size_t value, const size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+Jit::~Jit() {
+    if (_memory) munmap(_memory, _size);
+}
+
+void Jit::add(const Encoder& encoder) {
+    _modules.push_back(&encoder);
+}
+
+void Jit::load() {
+    const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    size_t offset = 0;
+    const auto place = [&](std::vector<size_t>& offsets, const Encoder::Section section) {
+        for (const auto* module : _modules) {
+            offset = align(offset, SECTION_ALIGNMENT);
+            offsets.push_back(offset);
+            offset += module->section(section).bytes.size();
+        }
+    };
+
+    // Like the linker, the hot code of all modules is placed first and the unlikely code last.
+    place(_hot_offsets, Encoder::Section::Hot);
+    place(_text_offsets, Encoder::Section::Text);
+    place(_unlikely_offsets, Encoder::Section::Unlikely);
+
+    // The data is placed on its own pages, thus only the code needs to be executable.
+    const auto text_size = align(offset, page_size);
+    offset = text_size;
+    for (const auto* module : _modules) {
+        offset = align(offset, SECTION_ALIGNMENT);
+        _data_offsets.push_back(offset);
+        offset += module->section(Encoder::Section::Data).bytes.size();
+    }
+
+    // The constants are only read, they are placed next to the data instead of on their own pages.
+    for (const auto* module : _modules) {
+        offset = align(offset, SECTION_ALIGNMENT);
+        _literal4_offsets.push_back(offset);
+        offset += module->section(Encoder::Section::Literal4).bytes.size();
+
+        offset = align(offset, SECTION_ALIGNMENT);
+        _literal8_offsets.push_back(offset);
+        offset += module->section(Encoder::Section::Literal8).bytes.size();
+    }
+
+    // The anonymous mapping is zero-filled, which already is the content of the bss sections.
+    for (const auto* module : _modules) {
+        offset = align(offset, SECTION_ALIGNMENT);
+        _bss_offsets.push_back(offset);
+        offset += module->section(Encoder::Section::Bss).bytes.size();
+    }
+
+    _size = std::max(align(offset, page_size), page_size);
+    auto* memory = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) throw std::system_error(errno, std::generic_category(), "Failed to map the program");
+    _memory = static_cast<uint8_t*>(memory);
+
+    for (size_t index = 0; index < _modules.size(); index++) {
+        for (const auto section : CODE_SECTIONS) {
+            std::ranges::copy(_modules[index]->section(section).bytes, _memory + _start(section, index));
+        }
+
+        const auto& data = _modules[index]->section(Encoder::Section::Data).bytes;
+        std::ranges::copy(data, _memory + _data_offsets[index]);
+        for (const auto section : { Encoder::Section::Literal4, Encoder::Section::Literal8 }) {
+            std::ranges::copy(_modules[index]->section(section).bytes, _memory + _start(section, index));
+        }
+
+        for (size_t symbol = 0; symbol < _modules[index]->symbols().size(); symbol++) {
+            const auto& defined = _modules[index]->symbols()[symbol];
+            if (!defined.global || !defined.section) continue;
+
+            const auto inserted = _globals.try_emplace(defined.name, _address(index, symbol)).second;
+            if (!inserted) throw std::invalid_argument("The symbol " + defined.name + " is defined by multiple modules.");
+        }
+    }
+
+    for (size_t index = 0; index < _modules.size(); index++) {
+        for (const auto section : { Encoder::Section::Hot, Encoder::Section::Text, Encoder::Section::Unlikely,
+                                    Encoder::Section::Data }) {
+            const auto start = _start(section, index);
+
+            for (const auto& [field, symbol, type, addend] : _modules[index]->section(section).relocations) {
+                // The encoder only emits PC-relative references, calls don't need a PLT inside of one mapping.
+                if (type != R_X86_64_PC32 && type != R_X86_64_PLT32) {
+                    throw std::invalid_argument("The relocation type " + std::to_string(type) + " is not supported.");
+                }
+
+                const auto target = static_cast<int64_t>(_address(index, symbol));
+                const auto place = reinterpret_cast<int64_t>(_memory + start + field);
+                const auto value = target + addend - place;
+                if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+                    const auto& name = _modules[index]->symbols()[symbol].name;
+                    throw std::invalid_argument("The relocation against " + name + " is out of range.");
+                }
+
+                const auto displacement = static_cast<int32_t>(value);
+                std::memcpy(_memory + start + field, &displacement, sizeof(displacement));
+            }
+        }
+    }
+
+    if (text_size != 0 && mprotect(_memory, text_size, PROT_READ | PROT_EXEC) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to make the program executable");
+    }
+}
+
+Jit::Entry Jit::entry(const std::string& name) const {
+    const auto found = _globals.find(name);
+    if (found == _globals.end()) throw std::invalid_argument("The symbol " + name + " is not defined by any module.");
+
+    return reinterpret_cast<Entry>(found->second);
+}
+
+uintptr_t Jit::_address(const size_t module, const size_t symbol) const {
+    const auto& target = _modules[module]->symbols()[symbol];
+    if (!target.section) {
+        const auto found = _globals.find(target.name);
+        if (found == _globals.end()) {
+            throw std::invalid_argument("The symbol " + target.name + " is not defined by any module.");
+        }
+
+        return found->second;
+    }
+
+    return reinterpret_cast<uintptr_t>(_memory + _start(*target.section, module) + target.offset);
+}
+
+size_t Jit::_start(const Encoder::Section section, const size_t module) const {
+    switch (section) {
+        case Encoder::Section::Text: return _text_offsets[module];
+        case Encoder::Section::Data: return _data_offsets[module];
+        case Encoder::Section::Bss: return _bss_offsets[module];
+        case Encoder::Section::Literal4: return _literal4_offsets[module];
+        case Encoder::Section::Literal8: return _literal8_offsets[module];
+        case Encoder::Section::Hot: return _hot_offsets[module];
+        case Encoder::Section::Unlikely: return _unlikely_offsets[module];
+    }
+
+    std::unreachable();
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
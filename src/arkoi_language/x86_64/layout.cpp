@@ -0,0 +1,174 @@
+#include "arkoi_language/x86_64/layout.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+#include <utility>
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+BlockLayout::BlockLayout(il::Function& function) :
+    _loops(function) {
+    std::unordered_set<il::BasicBlock*> placed;
+    std::deque<il::BasicBlock*> hot{ function.entry() }, cold;
+
+    while (!hot.empty() || !cold.empty()) {
+        auto& queue = hot.empty() ? cold : hot;
+        auto* current = queue.front();
+        queue.pop_front();
+
+        // Extend the chain with the most likely successor until it reaches an already placed block.
+        while (current && !placed.contains(current)) {
+            placed.insert(current);
+            _blocks.push_back(current);
+
+            il::BasicBlock* likely = nullptr;
+            for (auto* successor : { current->next(), current->branch() }) {
+                if (!successor || placed.contains(successor)) continue;
+
+                // On a tie the next block is preferred, which keeps the order of the source.
+                if (!likely || probability(current, successor) > probability(current, likely)) {
+                    std::swap(likely, successor);
+                }
+
+                if (!successor) continue;
+
+                const auto is_cold = probability(current, successor) < COLD_PROBABILITY;
+                (is_cold ? cold : hot).push_back(successor);
+            }
+
+            current = likely;
+        }
+    }
+
+    _place(function);
+}
+
+std::string BlockLayout::directive(const Section section) {
+    switch (section) {
+        case Section::Text: return ".section .text";
+        case Section::Hot: return ".section .text.hot,\"ax\",@progbits";
+        case Section::Unlikely: return ".section .text.unlikely,\"ax\",@progbits";
+    }
+
+    std::unreachable();
+}
+
+void BlockLayout::_place(il::Function& function) {
+    _split = _blocks.size();
+
+    const auto& entry_count = function.entry()->count();
+    if (entry_count && *entry_count == 0) {
+        _section = Section::Unlikely;
+        return;
+    }
+
+    if (function.name() == "main" || !_loops.loops().empty()) _section = Section::Hot;
+
+    // Without a measured entry there is no evidence that any block is never executed.
+    if (!entry_count) return;
+
+    // A block reached by falling through has to stay behind its predecessor.
+    const auto is_terminated = [&](il::BasicBlock* block) {
+        if (block == function.exit()) return true;
+        if (block->instructions().empty()) return false;
+
+        const auto& last = block->instructions().back();
+        return std::holds_alternative<il::Goto>(last) || std::holds_alternative<il::If>(last)
+               || std::holds_alternative<il::Return>(last);
+    };
+    if (!std::ranges::all_of(_blocks, is_terminated)) return;
+
+    const auto is_hot = [](const il::BasicBlock* block) { return !block->count() || *block->count() != 0; };
+    const auto cold = std::ranges::stable_partition(_blocks, is_hot);
+    _split = static_cast<size_t>(cold.begin() - _blocks.begin());
+}
+
+bool BlockLayout::is_loop_header(const il::BasicBlock* block) const {
+    return std::ranges::any_of(_loops.loops(), [&](const auto& loop) { return loop->header == block; });
+}
+
+double BlockLayout::probability(il::BasicBlock* from, const il::BasicBlock* to) const {
+    if (!from->branch()) return from->next() == to ? 1.0 : 0.0;
+
+    const auto taken = _branch_probability(from);
+    if (from->branch() == to) return taken;
+    if (from->next() == to) return 1.0 - taken;
+
+    return 0.0;
+}
+
+double BlockLayout::_branch_probability(il::BasicBlock* block) const {
+    // Measured counts of both successors replace the estimate, unless neither of them was ever executed.
+    const auto& branch_count = block->branch()->count();
+    const auto& next_count = block->next()->count();
+    if (branch_count && next_count && *branch_count + *next_count != 0) {
+        return static_cast<double>(*branch_count) / static_cast<double>(*branch_count + *next_count);
+    }
+
+    auto taken = 0.5;
+
+    // Loop branch heuristic: the edge staying inside the loop is likely, as there is only one iteration leaving it.
+    if (const auto* loop = _loops.loop(block)) {
+        const auto branch_stays = loop->contains(block->branch());
+        const auto next_stays = loop->contains(block->next());
+        if (branch_stays != next_stays) {
+            taken = _combine(taken, branch_stays ? LOOP_PROBABILITY : 1.0 - LOOP_PROBABILITY);
+        }
+    }
+
+    auto& instructions = block->instructions();
+    auto* branch = instructions.empty() ? nullptr : std::get_if<il::If>(&instructions.back());
+    if (!branch) return taken;
+
+    // Opcode heuristic: values are rarely equal to the one they are compared against.
+    for (auto& instruction : instructions) {
+        const auto* binary = std::get_if<il::Binary>(&instruction);
+        if (!binary || branch->condition() != il::Operand(binary->result())) continue;
+
+        if (binary->op() == il::Binary::Operator::Equal) {
+            taken = _combine(taken, 1.0 - OPCODE_PROBABILITY);
+        } else if (binary->op() == il::Binary::Operator::NotEqual) {
+            taken = _combine(taken, OPCODE_PROBABILITY);
+        }
+    }
+
+    return taken;
+}
+
+double BlockLayout::_combine(const double first, const double second) {
+    const auto agree = first * second;
+    return agree / (agree + (1.0 - first) * (1.0 - second));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
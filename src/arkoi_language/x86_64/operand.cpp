@@ -23,7 +23,7 @@ bool Memory::operator!=(const Memory& other) const {
     return !(other == *this);
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Register& reg) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Register& reg) {
     if (reg.base() >= Register::Base::R8 && reg.base() <= Register::Base::R15) {
         switch (reg.size()) {
             case Size::BYTE: return os << reg.base() << "b";
@@ -58,7 +58,7 @@ std::ostream& x86_64::operator<<(std::ostream& os, const Register& reg) {
     throw std::invalid_argument("This register is not implemented.");
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Register::Base& base) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Register::Base& base) {
     switch (base) {
         case Register::Base::A: return os << "a";
         case Register::Base::C: return os << "c";
@@ -98,17 +98,17 @@ std::ostream& x86_64::operator<<(std::ostream& os, const Register::Base& base) {
     std::unreachable();
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Memory& memory) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Memory& memory) {
     os << memory.size() << " PTR ";
 
-    os << "[" << memory.address();
+    // Labels are addressed relative to the instruction pointer, just like the integrated assembler encodes them.
+    os << "[";
+    if (std::holds_alternative<std::string>(memory.address())) os << "rip + ";
+    os << memory.address();
 
-    if (memory.index() != 1) {
-        os << " + " << memory.index();
-    }
-
-    if (memory.scale() != 1) {
-        os << " * " << memory.scale();
+    if (memory.index()) {
+        os << " + " << *memory.index();
+        if (memory.scale() != 1) os << " * " << memory.scale();
     }
 
     if (memory.displacement() < 0) {
@@ -121,21 +121,45 @@ std::ostream& x86_64::operator<<(std::ostream& os, const Memory& memory) {
     return os;
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Memory::Address& address) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Memory::Address& address) {
     std::visit([&os](const auto& value) { os << value; }, address);
     return os;
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Immediate& immediate) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Immediate& immediate) {
     std::visit([&](const auto& value) { os << value; }, immediate);
     return os;
 }
 
-std::ostream& x86_64::operator<<(std::ostream& os, const Operand& operand) {
+utils::OutputBuffer& x86_64::operator<<(utils::OutputBuffer& os, const Operand& operand) {
     std::visit([&](const auto& value) { os << value; }, operand);
     return os;
 }
 
+std::ostream& x86_64::operator<<(std::ostream& os, const Register& reg) {
+    return utils::OutputBuffer::format(os, reg);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Register::Base& base) {
+    return utils::OutputBuffer::format(os, base);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Memory& memory) {
+    return utils::OutputBuffer::format(os, memory);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Memory::Address& address) {
+    return utils::OutputBuffer::format(os, address);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Immediate& immediate) {
+    return utils::OutputBuffer::format(os, immediate);
+}
+
+std::ostream& x86_64::operator<<(std::ostream& os, const Operand& operand) {
+    return utils::OutputBuffer::format(os, operand);
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
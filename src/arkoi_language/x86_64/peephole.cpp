@@ -0,0 +1,277 @@
+#include "arkoi_language/x86_64/peephole.hpp"
+
+#include <algorithm>
+#include <optional>
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+/**
+ * @brief Returns the index of the item following @p index, skipping comments, debug lines and alignment.
+ */
+static size_t next_item(const std::vector<AssemblyItem>& items, size_t index) {
+    for (index++; index < items.size(); index++) {
+        const auto* directive = std::get_if<Directive>(&items[index]);
+        if (!directive) return index;
+
+        const auto& text = directive->text();
+        if (!text.starts_with("\t#") && !text.starts_with("\t.loc") && !text.starts_with("\t.p2align")) return index;
+    }
+
+    return items.size();
+}
+
+static const Instruction* instruction_at(const std::vector<AssemblyItem>& items, const size_t index) {
+    if (index >= items.size()) return nullptr;
+    return std::get_if<Instruction>(&items[index]);
+}
+
+static bool is_move(const Instruction::Opcode opcode) {
+    return opcode == Instruction::Opcode::MOV || opcode == Instruction::Opcode::MOVSD
+           || opcode == Instruction::Opcode::MOVSS;
+}
+
+/**
+ * @brief Checks if writing @p operand does more than storing the value, which makes the write observable.
+ *
+ * A write to a 32-bit register also clears the upper half of the 64-bit register.
+ */
+static bool clears_upper_half(const Operand& operand) {
+    const auto* reg = std::get_if<Register>(&operand);
+    return reg && reg->size() == Size::DWORD;
+}
+
+/**
+ * @brief Checks if the address of the memory @p operand is computed from the register @p operand.
+ *
+ * The register may either be the base or the index of the address.
+ */
+static bool is_addressed_by(const Operand& memory, const Operand& operand) {
+    const auto* location = std::get_if<Memory>(&memory);
+    const auto* reg = std::get_if<Register>(&operand);
+    if (!location || !reg) return false;
+
+    const auto* address = std::get_if<Register>(&location->address());
+    if (address && address->base() == reg->base()) return true;
+
+    return location->index() && location->index()->base() == reg->base();
+}
+
+static std::optional<std::string> jump_target(const Instruction& instruction) {
+    if (instruction.operands().size() != 1) return std::nullopt;
+
+    const auto* immediate = std::get_if<Immediate>(&instruction.operands().front());
+    if (!immediate) return std::nullopt;
+
+    const auto* name = std::get_if<std::string>(immediate);
+    if (!name) return std::nullopt;
+
+    return *name;
+}
+
+static std::optional<Instruction::Opcode> branch_of(const Instruction::Opcode opcode) {
+    switch (opcode) {
+        case Instruction::Opcode::SETA: return Instruction::Opcode::JA;
+        case Instruction::Opcode::SETAE: return Instruction::Opcode::JAE;
+        case Instruction::Opcode::SETB: return Instruction::Opcode::JB;
+        case Instruction::Opcode::SETBE: return Instruction::Opcode::JBE;
+        case Instruction::Opcode::SETG: return Instruction::Opcode::JG;
+        case Instruction::Opcode::SETGE: return Instruction::Opcode::JGE;
+        case Instruction::Opcode::SETL: return Instruction::Opcode::JL;
+        case Instruction::Opcode::SETLE: return Instruction::Opcode::JLE;
+        case Instruction::Opcode::SETE: return Instruction::Opcode::JE;
+        case Instruction::Opcode::SETNE: return Instruction::Opcode::JNE;
+        case Instruction::Opcode::SETP: return Instruction::Opcode::JP;
+        default: return std::nullopt;
+    }
+}
+
+static std::optional<Instruction::Opcode> inverse_of(const Instruction::Opcode opcode) {
+    switch (opcode) {
+        case Instruction::Opcode::JNZ: return Instruction::Opcode::JZ;
+        case Instruction::Opcode::JZ: return Instruction::Opcode::JNZ;
+        case Instruction::Opcode::JA: return Instruction::Opcode::JBE;
+        case Instruction::Opcode::JBE: return Instruction::Opcode::JA;
+        case Instruction::Opcode::JAE: return Instruction::Opcode::JB;
+        case Instruction::Opcode::JB: return Instruction::Opcode::JAE;
+        case Instruction::Opcode::JG: return Instruction::Opcode::JLE;
+        case Instruction::Opcode::JLE: return Instruction::Opcode::JG;
+        case Instruction::Opcode::JGE: return Instruction::Opcode::JL;
+        case Instruction::Opcode::JL: return Instruction::Opcode::JGE;
+        case Instruction::Opcode::JE: return Instruction::Opcode::JNE;
+        case Instruction::Opcode::JNE: return Instruction::Opcode::JE;
+        case Instruction::Opcode::JP: return Instruction::Opcode::JNP;
+        case Instruction::Opcode::JNP: return Instruction::Opcode::JP;
+        default: return std::nullopt;
+    }
+}
+
+void PeepholeOptimizer::run(std::vector<AssemblyItem>& items) {
+    auto changed = true;
+    while (changed) {
+        changed = false;
+
+        for (size_t index = 0; index < items.size(); index++) {
+            if (!std::holds_alternative<Instruction>(items[index])) continue;
+
+            for (size_t rule = 0; rule < RULES.size(); rule++) {
+                if (_disabled[rule] || !RULES[rule].apply(items, index)) continue;
+
+                // The item at the index was rewritten, thus it is revisited in the next round.
+                _hits[rule]++;
+                changed = true;
+                break;
+            }
+        }
+    }
+}
+
+bool PeepholeOptimizer::disable(const std::string_view name) {
+    const auto rule = std::ranges::find(RULES, name, &Rule::name);
+    if (rule == RULES.end()) return false;
+
+    _disabled[std::distance(RULES.begin(), rule)] = true;
+    return true;
+}
+
+size_t PeepholeOptimizer::hits(const std::string_view name) const {
+    const auto rule = std::ranges::find(RULES, name, &Rule::name);
+    if (rule == RULES.end()) return 0;
+
+    return _hits[std::distance(RULES.begin(), rule)];
+}
+
+bool PeepholeOptimizer::_self_move(std::vector<AssemblyItem>& items, const size_t index) {
+    const auto& move = std::get<Instruction>(items[index]);
+    if (!is_move(move.opcode())) return false;
+
+    const auto& operands = move.operands();
+    if (operands[0] != operands[1] || clears_upper_half(operands[0])) return false;
+
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(index));
+    return true;
+}
+
+bool PeepholeOptimizer::_reverse_move(std::vector<AssemblyItem>& items, const size_t index) {
+    const auto& first = std::get<Instruction>(items[index]);
+    if (!is_move(first.opcode())) return false;
+
+    const auto next = next_item(items, index);
+    const auto* second = instruction_at(items, next);
+    if (!second || second->opcode() != first.opcode()) return false;
+
+    // The second move copies the value back to where it came from.
+    const auto& destination = first.operands()[0];
+    const auto& source = first.operands()[1];
+    if (second->operands()[0] != source || second->operands()[1] != destination) return false;
+    if (is_addressed_by(source, destination) || clears_upper_half(source)) return false;
+
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(next));
+    return true;
+}
+
+bool PeepholeOptimizer::_store_load(std::vector<AssemblyItem>& items, const size_t index) {
+    const auto& store = std::get<Instruction>(items[index]);
+    if (!is_move(store.opcode())) return false;
+
+    const auto& slot = store.operands()[0];
+    const auto& value = store.operands()[1];
+    if (!std::holds_alternative<Memory>(slot) || !std::holds_alternative<Register>(value)) return false;
+
+    const auto next = next_item(items, index);
+    const auto* load = instruction_at(items, next);
+    if (!load || load->opcode() != store.opcode()) return false;
+
+    const auto& destination = load->operands()[0];
+    if (load->operands()[1] != slot || !std::holds_alternative<Register>(destination)) return false;
+
+    // The value is still in the register it was stored from, the case of the same register is `reverse-move`.
+    if (destination == value) return false;
+
+    items[next] = Instruction(store.opcode(), { destination, value });
+    return true;
+}
+
+bool PeepholeOptimizer::_compare_and_branch(std::vector<AssemblyItem>& items, const size_t index) {
+    const auto& set = std::get<Instruction>(items[index]);
+    const auto branch = branch_of(set.opcode());
+    if (!branch) return false;
+
+    const auto test_index = next_item(items, index);
+    const auto* test = instruction_at(items, test_index);
+    if (!test || test->opcode() != Instruction::Opcode::TEST) return false;
+
+    const auto& flag = set.operands()[0];
+    if (test->operands()[0] != flag || test->operands()[1] != flag) return false;
+
+    const auto jump_index = next_item(items, test_index);
+    const auto* jump = instruction_at(items, jump_index);
+    if (!jump || jump->opcode() != Instruction::Opcode::JNZ) return false;
+
+    // The flags of the comparison are still intact, as setcc does not modify them. The byte itself is kept, it might
+    // still be used somewhere else.
+    items[jump_index] = Instruction(*branch, jump->operands());
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(test_index));
+    return true;
+}
+
+bool PeepholeOptimizer::_branch_over_jump(std::vector<AssemblyItem>& items, const size_t index) {
+    const auto& branch = std::get<Instruction>(items[index]);
+    const auto inverse = inverse_of(branch.opcode());
+    if (!inverse) return false;
+
+    const auto jump_index = next_item(items, index);
+    const auto* jump = instruction_at(items, jump_index);
+    if (!jump || jump->opcode() != Instruction::Opcode::JMP) return false;
+
+    const auto label_index = next_item(items, jump_index);
+    const auto* label = label_index < items.size() ? std::get_if<Label>(&items[label_index]) : nullptr;
+    if (!label || jump_target(branch) != label->name()) return false;
+
+    items[index] = Instruction(*inverse, jump->operands());
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(jump_index));
+    return true;
+}
+
+bool PeepholeOptimizer::_jump_to_next(std::vector<AssemblyItem>& items, const size_t index) {
+    const auto& jump = std::get<Instruction>(items[index]);
+    if (jump.opcode() != Instruction::Opcode::JMP) return false;
+
+    const auto label_index = next_item(items, index);
+    const auto* label = label_index < items.size() ? std::get_if<Label>(&items[label_index]) : nullptr;
+    if (!label || jump_target(jump) != label->name()) return false;
+
+    items.erase(items.begin() + static_cast<std::ptrdiff_t>(index));
+    return true;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -1,5 +1,7 @@
 #include "arkoi_language/x86_64/resolver.hpp"
 
+#include <algorithm>
+
 #include "arkoi_language/il/cfg.hpp"
 #include "arkoi_language/utils/utils.hpp"
 #include "arkoi_language/x86_64/allocator.hpp"
@@ -7,7 +9,12 @@
 using namespace arkoi::x86_64;
 using namespace arkoi;
 
-void Resolver::run(il::Function& function, const Mapping& mapping) {
+void Resolver::run(
+    il::Function& function, const Mapping& mapping, const SpillSlots& slots, const bool omit_frame_pointer
+) {
+    _omit_frame_pointer = omit_frame_pointer;
+    _slots = slots;
+
     for (auto& [variable, reg_base] : mapping) {
         auto reg = Register(reg_base, variable.type().size());
         _mappings.insert_or_assign(variable, reg);
@@ -33,17 +40,6 @@ Operand Resolver::operator[](const il::Operand& operand) const {
     );
 }
 
-size_t Resolver::stack_size() const {
-    size_t stack_size = 0;
-
-    for (const auto& local : _locals) {
-        const auto size = size_to_bytes(local.type().size());
-        stack_size += size;
-    }
-
-    return align_size(stack_size);
-}
-
 size_t Resolver::align_size(const size_t input) {
     static constexpr size_t STACK_ALIGNMENT = 16;
     return (input + (STACK_ALIGNMENT - 1)) & ~(STACK_ALIGNMENT - 1);
@@ -62,14 +58,25 @@ void Resolver::visit(il::Function& function) {
         block.accept(*this);
     }
 
-    // --- Phase 2: Use the redzone for the remaining memory operands if applicable ---
+    // --- Phase 2: Pack the locals into as few stack slots as possible ---
+
+    const auto offsets = _pack();
 
-    const auto use_redzone = function.is_leaf() && this->stack_size() <= 128;
-    const auto stack_reg = use_redzone ? RSP : RBP;
+    // --- Phase 3: Use the redzone for the remaining memory operands if applicable ---
 
-    if (use_redzone) {
-        // If we can use the redzone, overwrite all the stack-allocated memory operands
-        // to use RSP instead of RBP.
+    const auto stack_size = static_cast<int64_t>(_stack_size);
+    if (function.is_leaf() && stack_size <= 128) {
+        _frame = Frame::RedZone;
+    } else {
+        _frame = _omit_frame_pointer ? Frame::StackPointer : Frame::FramePointer;
+    }
+
+    const auto stack_reg = _frame == Frame::FramePointer ? RBP : RSP;
+    // Without a frame pointer the slots lie right above the stack pointer, which is lowered by the whole frame.
+    const auto frame_offset = _frame == Frame::StackPointer ? stack_size : 0;
+
+    if (_frame != Frame::FramePointer) {
+        // Without a frame pointer, overwrite all the stack-allocated memory operands to use RSP instead of RBP.
         for (auto& [source, target] : _mappings) {
             auto* variable = std::get_if<il::Variable>(&source);
             if (!variable) continue;
@@ -80,18 +87,16 @@ void Resolver::visit(il::Function& function) {
             auto* reg = std::get_if<Register>(&memory->address());
             if (!reg || *reg != RBP) continue;
 
-            memory->set_address(stack_reg);
+            const auto displacement = frame_offset + memory->displacement();
+            *memory = Memory(memory->size(), stack_reg, memory->index(), memory->scale(), displacement);
         }
     }
 
     // --- Phase 4: Transform the remaining locals to be stored on the stack ---
 
-    int64_t local_offset = 0;
-    for (auto& local : _locals) {
-        auto size = local.type().size();
-        local_offset -= static_cast<int64_t>(size_to_bytes(size));
-
-        _mappings.insert_or_assign(local, Memory(size, stack_reg, local_offset));
+    for (const auto& local : _locals) {
+        const auto size = local.type().size();
+        _mappings.insert_or_assign(local, Memory(size, stack_reg, frame_offset + offsets.at(local)));
     }
 }
 
@@ -120,12 +125,12 @@ void Resolver::visit(il::Argument& argument) {
     const auto& result = argument.result();
     const auto& type = result.type();
 
-    if (std::holds_alternative<sem::Integral>(type) || std::holds_alternative<sem::Boolean>(type)) {
+    if (type.is_integral() || type.is_boolean()) {
         if (integer.size() < INTEGER_ARGUMENT_REGISTERS.size()) {
             integer.push_back(&argument);
             return;
         }
-    } else if (std::holds_alternative<sem::Floating>(type)) {
+    } else if (type.is_floating()) {
         if (floating.size() < SSE_ARGUMENT_REGISTERS.size()) {
             floating.push_back(&argument);
             return;
@@ -138,6 +143,9 @@ void Resolver::visit(il::Argument& argument) {
 }
 
 void Resolver::visit(il::Call& instruction) {
+    // The result is only stored in memory if the register allocation spilled it.
+    _add_local(instruction.result());
+
     // Add the current call frame to the container.
     _call_frames[&instruction] = _current_call_frame;
     // Reset the current call frame to be empty.
@@ -160,6 +168,10 @@ void Resolver::visit(il::Assign& instruction) {
     _add_local(instruction.result());
 }
 
+void Resolver::visit(il::Select& instruction) {
+    _add_local(instruction.result());
+}
+
 void Resolver::_add_local(const il::Operand& operand) {
     if (_mappings.contains(operand)) return;
 
@@ -173,6 +185,52 @@ void Resolver::_add_memory(const il::Variable& variable, const Memory& memory) {
     _locals.erase(variable);
 }
 
+std::unordered_map<il::Operand, int64_t> Resolver::_pack() {
+    // Every shared slot is as large as its largest member, all the other locals get a slot of their own.
+    std::vector<std::pair<size_t, std::vector<il::Operand>>> slots;
+    std::unordered_map<size_t, size_t> shared;
+    for (const auto& local : _locals) {
+        const auto bytes = size_to_bytes(local.type().size());
+
+        const auto slot = _slot(local);
+        if (slot) {
+            const auto [found, inserted] = shared.emplace(*slot, slots.size());
+            if (!inserted) {
+                auto& [slot_bytes, members] = slots[found->second];
+                slot_bytes = std::max(slot_bytes, bytes);
+                members.push_back(local);
+                continue;
+            }
+        }
+
+        slots.emplace_back(bytes, std::vector{ local });
+    }
+
+    // The sizes are powers of two, thus placing the larger slots first keeps every slot naturally aligned without
+    // any padding in between.
+    std::ranges::stable_sort(slots, std::ranges::greater{ }, [](const auto& slot) { return slot.first; });
+
+    int64_t offset = 0;
+    std::unordered_map<il::Operand, int64_t> offsets;
+    for (const auto& [bytes, members] : slots) {
+        offset -= static_cast<int64_t>(bytes);
+        for (const auto& member : members) offsets.emplace(member, offset);
+    }
+
+    _stack_size = align_size(static_cast<size_t>(-offset));
+    return offsets;
+}
+
+std::optional<size_t> Resolver::_slot(const il::Operand& operand) const {
+    const auto* variable = std::get_if<il::Variable>(&operand);
+    if (!variable) return std::nullopt;
+
+    const auto found = _slots.find(*variable);
+    if (found == _slots.end()) return std::nullopt;
+
+    return found->second;
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
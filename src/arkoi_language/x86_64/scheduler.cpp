@@ -0,0 +1,289 @@
+#include "arkoi_language/x86_64/scheduler.hpp"
+
+#include <algorithm>
+
+#include "arkoi_language/x86_64/selector.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+Scheduler::Scheduler(il::Function& function) {
+    for (auto& block : function) {
+        for (const auto& instruction : block.instructions()) {
+            for (const auto& use : instruction.uses()) _uses[use]++;
+        }
+    }
+
+    for (auto& block : function) _schedule(block);
+}
+
+size_t Scheduler::latency(const il::Instruction& instruction) {
+    if (const auto* binary = std::get_if<il::Binary>(&instruction)) {
+        const auto type = binary->op_type();
+        const auto is_wide = type.size() == Size::QWORD;
+
+        if (type.is_floating()) {
+            switch (binary->op()) {
+                case il::Binary::Operator::Add:
+                case il::Binary::Operator::Sub:
+                case il::Binary::Operator::Mul: return 4;
+                case il::Binary::Operator::Div: return is_wide ? 14 : 11;
+                default: return 3;
+            }
+        }
+
+        switch (binary->op()) {
+            case il::Binary::Operator::Mul: return 3;
+            case il::Binary::Operator::Div: return is_wide ? 40 : 26;
+            default: return 1;
+        }
+    }
+
+    if (const auto* cast = std::get_if<il::Cast>(&instruction)) {
+        // Conversions between integers and floating point values go through the other execution unit.
+        const auto from = cast->from().is_floating();
+        const auto to = cast->result().type().is_floating();
+        if (from != to) return 6;
+        return from ? 4 : 1;
+    }
+
+    if (std::holds_alternative<il::Load>(instruction)) return 5;
+    if (std::holds_alternative<il::Select>(instruction)) return 2;
+
+    return 1;
+}
+
+void Scheduler::_schedule(il::BasicBlock& block) {
+    auto& instructions = block.instructions();
+
+    size_t begin = 0;
+    for (size_t index = 0; index <= instructions.size(); index++) {
+        if (index != instructions.size() && !_is_barrier(instructions[index])) continue;
+
+        // A comparison consumed by the following branch stays in front of it.
+        auto end = index;
+        if (end > begin && end < instructions.size() && _is_glued(instructions[end - 1], instructions[end])) end--;
+
+        if (end - begin > 1) _schedule(block, begin, end);
+        begin = index + 1;
+    }
+}
+
+void Scheduler::_schedule(il::BasicBlock& block, const size_t begin, const size_t end) {
+    auto& instructions = block.instructions();
+
+    std::vector<Unit> units;
+    for (auto index = begin; index < end;) {
+        const auto size = _unit(instructions, index, end);
+        units.push_back(Unit{ index - begin, size });
+        index += size;
+    }
+
+    if (units.size() < 2) return;
+
+    // Every unit depends on the last definition of its uses, and has to stay behind the earlier uses of its
+    // definitions, thus memory operands are kept in order just like variables.
+    std::unordered_map<il::Operand, size_t> definitions;
+    std::unordered_map<il::Operand, std::vector<size_t>> readers;
+    for (size_t current = 0; current < units.size(); current++) {
+        auto& unit = units[current];
+        for (auto index = begin + unit.first; index < begin + unit.first + unit.size; index++) {
+            const auto& instruction = instructions[index];
+
+            for (const auto& use : instruction.uses()) {
+                const auto found = definitions.find(use);
+                if (found != definitions.end() && found->second != current) {
+                    const auto& producer = units[found->second];
+                    const auto& last = instructions[begin + producer.first + producer.size - 1];
+                    unit.predecessors.emplace_back(found->second, latency(last));
+                }
+
+                readers[use].push_back(current);
+            }
+
+            for (const auto& def : instruction.defs()) {
+                if (const auto found = definitions.find(def); found != definitions.end()) {
+                    if (found->second != current) unit.predecessors.emplace_back(found->second, 1);
+                }
+
+                for (const auto reader : readers[def]) {
+                    if (reader != current) unit.predecessors.emplace_back(reader, 0);
+                }
+
+                definitions[def] = current;
+                readers[def].clear();
+            }
+        }
+    }
+
+    // The predecessors always come first, thus the priorities are propagated backwards.
+    std::vector<std::vector<std::pair<size_t, size_t>>> successors(units.size());
+    for (size_t current = units.size(); current-- > 0;) {
+        auto& unit = units[current];
+
+        unit.priority = unit.size;
+        for (const auto& [successor, delay] : successors[current]) {
+            unit.priority = std::max(unit.priority, delay + units[successor].priority);
+        }
+
+        for (const auto& [predecessor, delay] : unit.predecessors) {
+            successors[predecessor].emplace_back(current, delay);
+        }
+    }
+
+    std::vector<size_t> waiting(units.size()), ready_at(units.size());
+    for (size_t current = 0; current < units.size(); current++) waiting[current] = units[current].predecessors.size();
+
+    std::vector<size_t> order;
+    std::vector<bool> scheduled(units.size());
+    size_t cycle = 0;
+    while (order.size() < units.size()) {
+        // Out of the units without pending predecessors the one ready first wins, then the most critical one.
+        std::optional<size_t> best;
+        for (size_t current = 0; current < units.size(); current++) {
+            if (scheduled[current] || waiting[current] != 0) continue;
+            if (!best) {
+                best = current;
+                continue;
+            }
+
+            const auto start = std::max(cycle, ready_at[current]);
+            const auto best_start = std::max(cycle, ready_at[*best]);
+            if (start < best_start || (start == best_start && units[current].priority > units[*best].priority)) {
+                best = current;
+            }
+        }
+
+        const auto current = *best;
+        scheduled[current] = true;
+        order.push_back(current);
+
+        cycle = std::max(cycle, ready_at[current]) + units[current].size;
+        for (const auto& [successor, delay] : successors[current]) {
+            ready_at[successor] = std::max(ready_at[successor], cycle - units[current].size + delay);
+            waiting[successor]--;
+        }
+    }
+
+    std::vector<il::Instruction> scheduled_instructions;
+    scheduled_instructions.reserve(end - begin);
+    for (const auto current : order) {
+        const auto& unit = units[current];
+        for (auto index = begin + unit.first; index < begin + unit.first + unit.size; index++) {
+            if (scheduled_instructions.size() != index - begin) _moved++;
+            scheduled_instructions.push_back(std::move(instructions[index]));
+        }
+    }
+
+    std::ranges::move(scheduled_instructions, instructions.begin() + static_cast<std::ptrdiff_t>(begin));
+}
+
+size_t Scheduler::_unit(il::BasicBlock::Instructions& instructions, const size_t index, const size_t end) {
+    const auto binary = [&](const size_t at) -> il::Binary* {
+        return at < end ? std::get_if<il::Binary>(&instructions[at]) : nullptr;
+    };
+
+    // The lanes of a packed chain follow each other pair by pair.
+    auto* lower = binary(index);
+    auto* upper = binary(index + 1);
+    if (lower && upper && PackedPattern::is_isomorphic(*lower, *upper)) {
+        std::array previous{ lower, upper };
+
+        size_t size = 2;
+        while (_uses[previous[0]->result()] == 1 && _uses[previous[1]->result()] == 1) {
+            auto* next_lower = binary(index + size);
+            auto* next_upper = binary(index + size + 1);
+            if (!next_lower || !next_upper || !PackedPattern::is_isomorphic(*next_lower, *next_upper)) break;
+
+            const std::array next{ next_lower, next_upper };
+            if (!PackedPattern::is_continued(previous, next)) break;
+
+            previous = next;
+            size += 2;
+        }
+
+        return size;
+    }
+
+    size_t size = 1;
+    while (index + size < end && _is_glued(instructions[index + size - 1], instructions[index + size])) size++;
+    return size;
+}
+
+bool Scheduler::_is_glued(il::Instruction& first, il::Instruction& second) {
+    auto* producer = std::get_if<il::Binary>(&first);
+    if (!producer) return false;
+
+    const il::Operand result(producer->result());
+    if (_uses[result] != 1) return false;
+
+    const auto uses = second.uses();
+    if (std::ranges::find(uses, result) == uses.end()) return false;
+
+    const auto type = producer->op_type();
+    const auto op = producer->op();
+
+    // The flags of a comparison are consumed by the branch or select directly.
+    if (std::holds_alternative<il::If>(second) || std::holds_alternative<il::Select>(second)) {
+        switch (op) {
+            case il::Binary::Operator::GreaterThan:
+            case il::Binary::Operator::LessThan:
+            case il::Binary::Operator::GreaterEqual:
+            case il::Binary::Operator::LessEqual:
+            case il::Binary::Operator::Equal:
+            case il::Binary::Operator::NotEqual: return true;
+            default: return false;
+        }
+    }
+
+    auto* consumer = std::get_if<il::Binary>(&second);
+    if (!consumer || consumer->op_type() != type) return false;
+
+    // The product of a multiply-add.
+    if (type.is_floating()) {
+        return op == il::Binary::Operator::Mul
+            && (consumer->op() == il::Binary::Operator::Add || consumer->op() == il::Binary::Operator::Sub);
+    }
+
+    // The address arithmetic folded into a single lea.
+    return op == il::Binary::Operator::Add || op == il::Binary::Operator::Sub || op == il::Binary::Operator::Mul
+        || op == il::Binary::Operator::Shl;
+}
+
+bool Scheduler::_is_barrier(const il::Instruction& instruction) {
+    return std::holds_alternative<il::Call>(instruction) || std::holds_alternative<il::Phi>(instruction)
+        || std::holds_alternative<il::Argument>(instruction) || std::holds_alternative<il::Alloca>(instruction)
+        || std::holds_alternative<il::Goto>(instruction) || std::holds_alternative<il::If>(instruction)
+        || std::holds_alternative<il::Return>(instruction);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,440 @@
+#include "arkoi_language/x86_64/selector.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+/**
+ * @brief Returns the value of an integral immediate, which is std::nullopt for any other operand.
+ */
+static std::optional<int64_t> integral_value(const il::Operand& operand) {
+    const auto* immediate = std::get_if<il::Immediate>(&operand);
+    if (!immediate) return std::nullopt;
+
+    return std::visit(
+        match{
+            [](const uint64_t value) -> std::optional<int64_t> { return static_cast<int64_t>(value); },
+            [](const int64_t value) -> std::optional<int64_t> { return value; },
+            [](const uint32_t value) -> std::optional<int64_t> { return value; },
+            [](const int32_t value) -> std::optional<int64_t> { return value; },
+            [](const auto&) -> std::optional<int64_t> { return std::nullopt; },
+        },
+        *immediate
+    );
+}
+
+/**
+ * @brief Turns @p value into a displacement of an operation of @p size.
+ *
+ * Only the lower half of a 32-bit result is used, thus its displacement just wraps around. A 64-bit
+ * one is sign-extended from 32 bits and needs to fit exactly.
+ */
+static std::optional<int64_t> displacement(const int64_t value, const Size size) {
+    if (size == Size::DWORD) return static_cast<int32_t>(static_cast<uint32_t>(value));
+
+    if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) return std::nullopt;
+    return value;
+}
+
+bool PackedPattern::is_isomorphic(il::Binary& lower, il::Binary& upper) {
+    const auto type = lower.op_type();
+    if (!type.is_floating() || type.size() != Size::QWORD || upper.op_type() != type) return false;
+    if (lower.op() != upper.op()) return false;
+
+    switch (lower.op()) {
+        case il::Binary::Operator::Add:
+        case il::Binary::Operator::Sub:
+        case il::Binary::Operator::Mul:
+        case il::Binary::Operator::Div: break;
+        default: return false;
+    }
+
+    // Both lanes are computed at once, thus the upper one can't depend on the lower one.
+    const auto result = il::Operand(lower.result());
+    return upper.left() != result && upper.right() != result;
+}
+
+bool PackedPattern::is_continued(
+    const std::array<il::Binary*, 2>& previous, const std::array<il::Binary*, 2>& next
+) {
+    const auto uses = [](il::Binary& instruction, const il::Variable& operand) {
+        return instruction.left() == il::Operand(operand) || instruction.right() == il::Operand(operand);
+    };
+
+    // Returns if the operand is the left one, or std::nullopt if it isn't exactly one of both.
+    const auto side = [](il::Binary& instruction, const il::Variable& operand) -> std::optional<bool> {
+        const auto left = instruction.left() == il::Operand(operand);
+        const auto right = instruction.right() == il::Operand(operand);
+        if (left == right) return std::nullopt;
+        return left;
+    };
+
+    // The other operand is packed on its own, thus it can't be the result of the other lane.
+    if (uses(*next[0], previous[1]->result()) || uses(*next[1], previous[0]->result())) return false;
+
+    const auto lower = side(*next[0], previous[0]->result());
+    return lower && lower == side(*next[1], previous[1]->result());
+}
+
+bool PackedPattern::is_profitable() const {
+    // The upper lane of the result is extracted by a shuffle at the end.
+    size_t operations = 0, shuffles = 1;
+    for (size_t index = 0; index < steps.size(); index++) {
+        const auto& [lower, upper] = steps[index];
+        operations += lower->op() == il::Binary::Operator::Div ? DIVISION_COST : 1;
+
+        // The first step packs both of its operands unless they are the same, the others only the new one.
+        const auto is_square = lower->left() == lower->right() && upper->left() == upper->right();
+        shuffles += (index == 0 && !is_square) ? 2 : 1;
+    }
+
+    return 2 * operations > operations + shuffles;
+}
+
+InstructionSelector::InstructionSelector(il::Function& function, const Resolver& resolver, const bool contract) :
+    _resolver(resolver) {
+    for (auto& block : function) {
+        for (const auto& instruction : block.instructions()) {
+            for (const auto& use : instruction.uses()) _uses[use]++;
+        }
+    }
+
+    for (auto& block : function) {
+        auto& instructions = block.instructions();
+
+        std::unordered_map<size_t, Sum> sums;
+        for (size_t index = 0; index < instructions.size(); index++) {
+            if (auto sum = _match(block, index, sums)) sums.emplace(index, std::move(*sum));
+        }
+
+        // The last instruction of a tree is its root, thus the trees are selected from the end of the block.
+        for (size_t index = instructions.size(); index-- > 0;) {
+            const auto found = sums.find(index);
+            if (found == sums.end()) continue;
+
+            auto& binary = std::get<il::Binary>(instructions[index]);
+            const auto& sum = found->second;
+
+            const auto address = _address(sum);
+            if (!address) continue;
+
+            // Without folding anything a move has to be saved, which an instruction working on its left operand
+            // in place doesn't need.
+            if (sum.first == index && binary.op() != il::Binary::Operator::Mul) {
+                if (_resolver[binary.result()] == _resolver[binary.left()]) continue;
+            }
+
+            _addresses.emplace(&binary, *address);
+
+            for (auto folded = sum.first; folded < index; folded++) {
+                _folded.insert(&std::get<il::Binary>(instructions[folded]));
+            }
+
+            // The folded instructions are no roots on their own.
+            index = sum.first;
+        }
+
+        for (size_t index = 1; contract && index < instructions.size(); index++) {
+            auto pattern = _fuse(block, index);
+            if (!pattern) continue;
+
+            _fused.emplace(&std::get<il::Binary>(instructions[index]), std::move(*pattern));
+            _folded.insert(&std::get<il::Binary>(instructions[index - 1]));
+
+            // The fused instruction can't be the product of the next one anymore.
+            index++;
+        }
+
+        for (size_t index = 0; index + 1 < instructions.size(); index++) {
+            auto pattern = _pack(block, index);
+            if (!pattern) continue;
+
+            // Everything is generated by the upper lane of the last step.
+            const auto* last = pattern->steps.back()[1];
+            for (const auto& [lower, upper] : pattern->steps) {
+                _folded.insert(lower);
+                if (upper != last) _folded.insert(upper);
+            }
+
+            index += 2 * pattern->steps.size() - 1;
+            _packed.emplace(last, std::move(*pattern));
+        }
+    }
+}
+
+const AddressPattern* InstructionSelector::address(const il::Binary& instruction) const {
+    const auto found = _addresses.find(&instruction);
+    if (found == _addresses.end()) return nullptr;
+
+    return &found->second;
+}
+
+const FusedPattern* InstructionSelector::fused(const il::Binary& instruction) const {
+    const auto found = _fused.find(&instruction);
+    if (found == _fused.end()) return nullptr;
+
+    return &found->second;
+}
+
+const PackedPattern* InstructionSelector::packed(const il::Binary& instruction) const {
+    const auto found = _packed.find(&instruction);
+    if (found == _packed.end()) return nullptr;
+
+    return &found->second;
+}
+
+bool InstructionSelector::is_folded(const il::Binary& instruction) const {
+    return _folded.contains(&instruction);
+}
+
+std::optional<InstructionSelector::Sum> InstructionSelector::_match(
+    il::BasicBlock& block, const size_t index, const std::unordered_map<size_t, Sum>& sums
+) {
+    auto& instructions = block.instructions();
+
+    auto* binary = std::get_if<il::Binary>(&instructions[index]);
+    if (!binary) return std::nullopt;
+
+    const auto type = binary->op_type();
+    if (!type.is_integral() || (type.size() != Size::DWORD && type.size() != Size::QWORD)) return std::nullopt;
+    if (!_in_register(binary->result())) return std::nullopt;
+
+    const auto size = type.size();
+    auto match_with = [&](const bool fold) -> std::optional<Sum> {
+        auto first = index;
+
+        // The operand is folded if its definition is directly in front of the instructions folded so far.
+        auto operand_sum = [&](const il::Operand& operand) -> std::optional<Sum> {
+            const auto* variable = std::get_if<il::Variable>(&operand);
+            if (!variable || !_in_register(*variable)) return std::nullopt;
+
+            const auto found = first > 0 ? sums.find(first - 1) : sums.end();
+            if (fold && found != sums.end() && _uses[operand] == 1) {
+                const auto& definition = std::get<il::Binary>(instructions[first - 1]);
+                if (definition.result() == *variable && definition.op_type() == type) {
+                    first = found->second.first;
+                    return found->second;
+                }
+            }
+
+            return Sum{ { { *variable, 1 } }, 0, index };
+        };
+
+        auto add = [&](Sum left, const Sum& right) -> std::optional<Sum> {
+            for (const auto& [variable, scale] : right.terms) {
+                auto term = std::ranges::find(left.terms, variable, &std::pair<il::Variable, int64_t>::first);
+                if (term == left.terms.end()) {
+                    left.terms.emplace_back(variable, scale);
+                } else {
+                    term->second += scale;
+                }
+            }
+
+            const auto combined = displacement(left.displacement + right.displacement, size);
+            if (!combined) return std::nullopt;
+
+            left.displacement = *combined;
+            return left;
+        };
+
+        auto offset = [&](std::optional<Sum> sum, const int64_t value) -> std::optional<Sum> {
+            if (!sum) return std::nullopt;
+            return add(std::move(*sum), Sum{ { }, value, index });
+        };
+
+        auto multiply = [&](std::optional<Sum> sum, const int64_t factor) -> std::optional<Sum> {
+            // No larger factor is ever encodable, which also keeps the displacement from overflowing.
+            if (!sum || factor < 1 || factor > 9) return std::nullopt;
+
+            for (auto& scale : sum->terms | std::views::values) scale *= factor;
+
+            const auto scaled = displacement(sum->displacement * factor, size);
+            if (!scaled) return std::nullopt;
+
+            sum->displacement = *scaled;
+            return sum;
+        };
+
+        const auto& left = binary->left();
+        const auto& right = binary->right();
+        const auto left_value = integral_value(left), right_value = integral_value(right);
+
+        std::optional<Sum> sum;
+        switch (binary->op()) {
+            case il::Binary::Operator::Add: {
+                if (right_value) {
+                    sum = offset(operand_sum(left), *right_value);
+                } else if (left_value) {
+                    sum = offset(operand_sum(right), *left_value);
+                } else {
+                    // The right operand is usually computed last, thus it's the one directly in front.
+                    const auto right_sum = operand_sum(right);
+                    const auto left_sum = operand_sum(left);
+                    if (left_sum && right_sum) sum = add(*left_sum, *right_sum);
+                }
+                break;
+            }
+            case il::Binary::Operator::Sub: {
+                if (right_value) sum = offset(operand_sum(left), -*right_value);
+                break;
+            }
+            case il::Binary::Operator::Mul: {
+                if (right_value) {
+                    sum = multiply(operand_sum(left), *right_value);
+                } else if (left_value) {
+                    sum = multiply(operand_sum(right), *left_value);
+                }
+                break;
+            }
+            case il::Binary::Operator::Shl: {
+                if (right_value && *right_value >= 0 && *right_value <= 3) {
+                    sum = multiply(operand_sum(left), int64_t{ 1 } << *right_value);
+                }
+                break;
+            }
+            default: break;
+        }
+
+        if (sum) sum->first = first;
+        return sum;
+    };
+
+    // Folding may lead to an address that isn't encodable anymore, which still is fine without it. A sum that
+    // isn't encodable on its own is kept anyway, a later instruction might still fold it.
+    auto sum = match_with(true);
+    if (sum && sum->first != index && !_address(*sum)) sum = match_with(false);
+
+    return sum;
+}
+
+std::optional<AddressPattern> InstructionSelector::_address(const Sum& sum) {
+    const auto is_scale = [](const int64_t scale) { return scale == 1 || scale == 2 || scale == 4 || scale == 8; };
+
+    if (sum.terms.size() == 1) {
+        const auto& [variable, scale] = sum.terms.front();
+        if (scale == 1) return AddressPattern{ variable, std::nullopt, 1, sum.displacement };
+
+        // Scales of 2, 3, 5 and 9 use the variable as both the base and the index.
+        if (!is_scale(scale - 1)) return std::nullopt;
+        return AddressPattern{ variable, variable, scale - 1, sum.displacement };
+    }
+
+    if (sum.terms.size() == 2) {
+        auto [base, index] = std::pair(sum.terms[0], sum.terms[1]);
+        if (base.second != 1) std::swap(base, index);
+        if (base.second != 1 || !is_scale(index.second)) return std::nullopt;
+
+        return AddressPattern{ base.first, index.first, index.second, sum.displacement };
+    }
+
+    return std::nullopt;
+}
+
+std::optional<FusedPattern> InstructionSelector::_fuse(il::BasicBlock& block, const size_t index) {
+    auto& instructions = block.instructions();
+
+    auto* binary = std::get_if<il::Binary>(&instructions[index]);
+    auto* product = std::get_if<il::Binary>(&instructions[index - 1]);
+    if (!binary || !product || product->op() != il::Binary::Operator::Mul) return std::nullopt;
+
+    const auto type = binary->op_type();
+    if (!type.is_floating() || product->op_type() != type) return std::nullopt;
+
+    // The product is only computed as part of the multiply-add, thus it can't be used anywhere else.
+    if (_uses[product->result()] != 1) return std::nullopt;
+
+    const auto is_product = [&](const il::Operand& operand) { return operand == il::Operand(product->result()); };
+    const auto& left = binary->left();
+    const auto& right = binary->right();
+
+    // The same product on both sides is used twice, which was already ruled out.
+    std::optional<std::pair<il::Operand, FusedPattern::Kind>> addend;
+    if (binary->op() == il::Binary::Operator::Add) {
+        if (is_product(left)) addend.emplace(right, FusedPattern::Kind::Add);
+        if (is_product(right)) addend.emplace(left, FusedPattern::Kind::Add);
+    } else if (binary->op() == il::Binary::Operator::Sub) {
+        if (is_product(left)) addend.emplace(right, FusedPattern::Kind::Subtract);
+        if (is_product(right)) addend.emplace(left, FusedPattern::Kind::NegatedAdd);
+    }
+
+    if (!addend) return std::nullopt;
+    return FusedPattern{ product->left(), product->right(), addend->first, addend->second };
+}
+
+std::optional<PackedPattern> InstructionSelector::_pack(il::BasicBlock& block, const size_t index) {
+    auto& instructions = block.instructions();
+
+    const auto lanes = [&](const size_t lower) -> std::optional<std::array<il::Binary*, 2>> {
+        if (lower + 1 >= instructions.size()) return std::nullopt;
+
+        auto* first = std::get_if<il::Binary>(&instructions[lower]);
+        auto* second = std::get_if<il::Binary>(&instructions[lower + 1]);
+        if (!first || !second || !PackedPattern::is_isomorphic(*first, *second)) return std::nullopt;
+
+        // Instructions that are already part of a multiply-add are left to it.
+        const auto is_taken = [&](il::Binary* binary) {
+            return _folded.contains(binary) || _fused.contains(binary);
+        };
+        if (is_taken(first) || is_taken(second)) return std::nullopt;
+
+        return std::array{ first, second };
+    };
+
+    const auto first = lanes(index);
+    if (!first) return std::nullopt;
+
+    PackedPattern pattern{ { *first } };
+    for (auto next = index + 2;; next += 2) {
+        const auto& previous = pattern.steps.back();
+        if (_uses[previous[0]->result()] != 1 || _uses[previous[1]->result()] != 1) break;
+
+        const auto step = lanes(next);
+        if (!step || !PackedPattern::is_continued(previous, *step)) break;
+
+        pattern.steps.push_back(*step);
+    }
+
+    if (!pattern.is_profitable()) return std::nullopt;
+    return pattern;
+}
+
+bool InstructionSelector::_in_register(const il::Operand& operand) const {
+    if (!std::holds_alternative<il::Variable>(operand)) return false;
+    return std::holds_alternative<Register>(_resolver[operand]);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,127 @@
+#include "arkoi_language/x86_64/target.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+/**
+ * @brief The extensions by their attribute name, in the order `describe` lists them.
+ */
+static constexpr std::array<std::pair<std::string_view, bool Target::*>, 5> EXTENSIONS{ {
+    { "avx", &Target::avx },
+    { "fma", &Target::fma },
+    { "bmi", &Target::bmi },
+    { "bmi2", &Target::bmi2 },
+    { "lzcnt", &Target::lzcnt },
+} };
+
+/**
+ * @brief The processors that have all extensions of the x86-64-v3 level, which is everything the generator uses.
+ */
+static constexpr std::array<std::string_view, 14> V3_PROCESSORS{
+    "x86-64-v3", "x86-64-v4", "haswell", "broadwell", "skylake", "skylake-avx512", "icelake-client",
+    "icelake-server", "alderlake", "sapphirerapids", "znver1", "znver2", "znver3", "znver4",
+};
+
+static std::string_view trim(std::string_view text) {
+    const auto start = text.find_first_not_of(" \t");
+    if (start == std::string_view::npos) return { };
+
+    const auto end = text.find_last_not_of(" \t");
+    return text.substr(start, end - start + 1);
+}
+
+static Target processor(const std::string_view cpu) {
+    if (cpu == "x86-64" || cpu == "x86-64-v2") return { };
+
+    if (std::ranges::find(V3_PROCESSORS, cpu) != V3_PROCESSORS.end()) return { true, true, true, true, true };
+
+    if (cpu == "native") {
+        __builtin_cpu_init();
+
+        Target target;
+        target.avx = __builtin_cpu_supports("avx");
+        target.fma = __builtin_cpu_supports("fma");
+        target.bmi = __builtin_cpu_supports("bmi");
+        target.bmi2 = __builtin_cpu_supports("bmi2");
+        target.lzcnt = __builtin_cpu_supports("abm");
+        return target;
+    }
+
+    throw std::invalid_argument("The processor \"" + std::string(cpu) + "\" is unknown.");
+}
+
+Target Target::parse(const std::string_view cpu, const std::string_view attributes) {
+    auto target = processor(trim(cpu));
+    if (trim(attributes).empty()) return target;
+
+    size_t start = 0;
+    while (true) {
+        const auto end = attributes.find(',', start);
+        const auto attribute = trim(attributes.substr(start, end == std::string_view::npos ? end : end - start));
+
+        if (attribute.size() < 2 || (attribute.front() != '+' && attribute.front() != '-')) {
+            throw std::invalid_argument("The attribute \"" + std::string(attribute) + "\" needs to start with + or -.");
+        }
+
+        const auto name = attribute.substr(1);
+        const auto extension = std::ranges::find(EXTENSIONS, name, [](const auto& entry) { return entry.first; });
+        if (extension == EXTENSIONS.end()) {
+            throw std::invalid_argument("The extension \"" + std::string(name) + "\" is unknown.");
+        }
+
+        target.*extension->second = attribute.front() == '+';
+
+        if (end == std::string_view::npos) break;
+        start = end + 1;
+    }
+
+    return target;
+}
+
+std::string Target::describe() const {
+    std::string description;
+    for (const auto& [name, extension] : EXTENSIONS) {
+        if (!(this->*extension)) continue;
+
+        if (!description.empty()) description += ',';
+        description += '+';
+        description += name;
+    }
+
+    return description;
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
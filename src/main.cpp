@@ -1,16 +1,121 @@
+#include <algorithm>
+#include <atomic>
 #include <complex>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <thread>
 
 #include "argparse/argparse.hpp"
 
+#include "arkoi_language/il/profile.hpp"
+#include "arkoi_language/opt/pipeline.hpp"
+#include "arkoi_language/utils/cache.hpp"
 #include "arkoi_language/utils/driver.hpp"
+#include "arkoi_language/utils/server.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+#include "arkoi_language/utils/thread_pool.hpp"
+#include "arkoi_language/utils/time_report.hpp"
 #include "arkoi_language/utils/utils.hpp"
 
 using namespace arkoi;
 
-int main(const int argc, const char* argv[]) {
+namespace {
+/**
+ * @brief The state kept alive between the command lines executed by a single process.
+ *
+ * A plain invocation executes a single command line. A server executes one per request, thus the
+ * opened caches and the threads of the pools stay warm for the following requests. A server executes
+ * several command lines at once, whose sources are compiled concurrently as well, thus all of it is
+ * guarded by a mutex.
+ */
+class Session {
+public:
+    /**
+     * @brief Constructs a session.
+     *
+     * @param server Whether the command lines are executed by a server, which never runs programs itself.
+     */
+    explicit Session(const bool server) :
+        _server(server) { }
+
+    /**
+     * @brief Returns the cache in @p directory, which is opened by the first command line using it.
+     *
+     * @param directory The directory of the cache, relative paths are resolved against the current working directory.
+     * @param limit The maximum amount of bytes all entries together may occupy.
+     * @return The opened cache.
+     */
+    utils::Cache& cache(const std::string& directory, const size_t limit) {
+        // The requests of a server come from different directories, thus the cache is opened by its absolute path.
+        const auto absolute = std::filesystem::absolute(directory);
+
+        const std::lock_guard lock(_mutex);
+        auto& cache = _caches[{ absolute.string(), limit }];
+        if (!cache) cache = std::make_unique<utils::Cache>(absolute, limit);
+        return *cache;
+    }
+
+    /**
+     * @brief Returns the pool the sources are compiled on, with the given amount of jobs.
+     */
+    utils::ThreadPool& source_pool(const size_t jobs) {
+        const std::lock_guard lock(_mutex);
+        return _pool(_source_pools, jobs);
+    }
+
+    /**
+     * @brief Returns the pool the functions of a source are compiled on, with the given amount of jobs.
+     *
+     * It's kept apart from the pool of the sources, which wait for the tasks of their functions.
+     */
+    utils::ThreadPool& function_pool(const size_t jobs) {
+        const std::lock_guard lock(_mutex);
+        return _pool(_function_pools, jobs);
+    }
+
+    /**
+     * @brief Checks if the command lines are executed by a server, see `Session::Session`.
+     */
+    [[nodiscard]] bool server() const { return _server; }
+
+private:
+    using Pools = std::map<size_t, std::unique_ptr<utils::ThreadPool>>;
+
+    static utils::ThreadPool& _pool(Pools& pools, const size_t jobs) {
+        auto& pool = pools[jobs];
+        if (!pool) pool = std::make_unique<utils::ThreadPool>(jobs);
+        return *pool;
+    }
+
+private:
+    std::map<std::pair<std::string, size_t>, std::unique_ptr<utils::Cache>> _caches{ };
+    Pools _source_pools{ }, _function_pools{ };
+    std::mutex _mutex{ };
+    bool _server;
+};
+
+/**
+ * @brief Executes a single command line, whose first argument is the name of the executable.
+ *
+ * @param arguments The arguments of the command line.
+ * @param session The state shared with the other command lines executed by this process.
+ * @param invocation The streams and the working directory of the command line, which are those of the client if
+ *                   it's executed by a server.
+ * @return The exit code of the command line.
+ */
+int32_t run(std::vector<std::string> arguments, Session& session, const utils::Invocation& invocation) {
+    auto& stdout_ostream = *invocation.output;
+    auto& stderr_ostream = *invocation.error;
+
+    // The paths of the arguments are relative to the working directory of the command line, not of this process.
+    const auto resolve = [&](const std::string& path) { return (invocation.directory / path).string(); };
+
     argparse::ArgumentParser argument_parser(PROJECT_NAME, PROJECT_VERSION, argparse::default_arguments::none);
 
     argument_parser.add_description(
@@ -20,11 +125,13 @@ int main(const int argc, const char* argv[]) {
         "new language features, compiler techniques, and language design concepts."
     );
 
+    // A server executes many command lines, thus printing the help or the version must not exit the process.
+    bool informed = false;
     argument_parser.add_argument("-h", "--help")
                    .action(
                         [&](const auto&) {
-                            std::cout << argument_parser.help().str();
-                            std::exit(0);
+                            stdout_ostream << argument_parser.help().str();
+                            informed = true;
                         }
                     )
                    .help("Shows the help message and exits")
@@ -32,8 +139,8 @@ int main(const int argc, const char* argv[]) {
     argument_parser.add_argument("--version")
                    .action(
                         [&](const auto&) {
-                            std::cout << PROJECT_VERSION << std::endl;
-                            std::exit(0);
+                            stdout_ostream << PROJECT_VERSION << std::endl;
+                            informed = true;
                         }
                     )
                    .help("Prints version information and exits")
@@ -41,7 +148,8 @@ int main(const int argc, const char* argv[]) {
 
     argument_parser.add_group("Input and output control");
     argument_parser.add_argument("inputs")
-                   .help("All input files that should be compiled\n\b")
+                   .help("All input files that should be compiled.\n"
+                         "Files ending in \".il\" contain printed IL, which skips the frontend\n\b")
                    .nargs(argparse::nargs_pattern::at_least_one);
     argument_parser.add_argument("-o", "--output")
                    .help("The output file name of the compiled files\n\b")
@@ -58,8 +166,68 @@ int main(const int argc, const char* argv[]) {
                    .help("Only compile and assemble, but do not link.\nFor each source an object file \".o\" is generated")
                    .flag();
     argument_parser.add_argument("-r")
-                   .help("Compile, assemble, link and run the program afterwards")
+                   .help("Compile, assemble, link and run the program afterwards.\nWith the integrated assembler the program is run in-process without linking")
                    .flag();
+    argument_parser.add_argument("-j")
+                   .help("The amount of threads used to compile the sources and their functions.\n0 uses one thread per hardware core")
+                   .default_value(size_t{ 1 })
+                   .scan<'u', size_t>();
+    argument_parser.add_argument("-regalloc")
+                   .help("The register allocator used for every function.\n\"graph\" colors an interference graph, \"linear\" is a faster linear scan")
+                   .default_value(std::string("graph"))
+                   .choices("graph", "linear");
+    argument_parser.add_argument("-assembler")
+                   .help("The assembler used to create the object files.\n\"integrated\" encodes them in-process, \"as\" invokes the external GNU assembler")
+                   .default_value(std::string("integrated"))
+                   .choices("integrated", "as");
+
+    argument_parser.add_group("Optimization control");
+    argument_parser.add_argument("-O")
+                   .help("The optimization level, written like \"-O2\". \"0\" runs no passes and uses the linear scan\nallocator unless another one is chosen, every higher level adds the more expensive passes")
+                   .default_value(std::string("3"))
+                   .choices("0", "1", "2", "3");
+    argument_parser.add_argument("-passes")
+                   .help("A comma separated list of the passes run on every function, which replaces the ones of the\noptimization level, e.g. \"-passes=sccp,gvn,dead-code-elimination,inliner\"");
+    argument_parser.add_argument("-fmemoize")
+                   .help("Cache the results of recursive functions without side effects by their integer argument,\nwhich adds a table of 16 KiB per function. Equal to appending \"memoize\" to the passes")
+                   .flag();
+    argument_parser.add_argument("-fprofile-generate")
+                   .help("Instrument the program to count how often every block is executed, which is written to the\ngiven file once \"main\" returned. The program is always linked, even with \"-r\"");
+    argument_parser.add_argument("-fprofile-use")
+                   .help("Guide the block layout, register allocation, inlining and unrolling with the counts of the\ngiven profile, which was written by a program compiled with \"-fprofile-generate\"");
+    argument_parser.add_argument("-fomit-frame-pointer")
+                   .help("Address the stack slots relative to RSP instead of setting up RBP as the frame pointer,\nwhich shortens the prologue and epilogue of every function that needs a stack frame")
+                   .flag();
+    argument_parser.add_argument("-march")
+                   .help("The processor the code is generated for, e.g. \"x86-64-v3\", \"haswell\" or \"native\". The\ngenerated code may use every extension of that processor and might not run on older ones")
+                   .default_value(std::string("x86-64"));
+    argument_parser.add_argument("-mattr")
+                   .help("A comma separated list of extensions enabled with \"+\" or disabled with \"-\" on top of the\nprocessor, e.g. \"-mattr=+avx,+fma,-bmi2\". Known are avx, fma, bmi, bmi2 and lzcnt")
+                   .default_value(std::string(""));
+    argument_parser.add_argument("-fschedule-insns")
+                   .help("Reorder the instructions of every block before the register allocation, so that independent\nwork hides the latency of divisions, conversions and loads")
+                   .flag();
+    argument_parser.add_argument("-ffp-contract")
+                   .help("Whether a floating point multiplication followed by an addition may be computed by a single\nFMA instruction, which skips the rounding of the product. Only has an effect if FMA is available")
+                   .default_value(std::string("off"))
+                   .choices("off", "fast");
+
+    argument_parser.add_argument("-g")
+                   .help("The amount of debug information, written like \"-g1\". \"0\" emits none, \"1\" only a line table with\na single entry per line change and \"2\", which is the same as \"-g\", an entry per block and call as well")
+                   .default_value(std::string("2"))
+                   .choices("0", "1", "2");
+
+    argument_parser.add_group("Compiler server");
+    argument_parser.add_argument("-server")
+                   .help("Run as a server on the given Unix socket, which must be the only argument. It executes the\ncommand lines of the invocations that find the socket in the environment variable ARKOI_SERVER\nand keeps its caches and threads warm in between. Without a reachable server they compile by themselves");
+
+    argument_parser.add_group("Compilation cache");
+    argument_parser.add_argument("-cache-dir")
+                   .help("The directory the results of compiling sources and single functions are cached in, which\nskips compiling unchanged sources and only recompiles the changed functions of a source.\nWithout a directory nothing is cached, the JIT only reuses the cached functions");
+    argument_parser.add_argument("-cache-size")
+                   .help("The maximum size of the cache in MiB, the least recently used entries are evicted first")
+                   .default_value(size_t{ 512 })
+                   .scan<'u', size_t>();
 
     argument_parser.add_group("Output control of compilation stages");
     argument_parser.add_argument("-print-asm")
@@ -69,19 +237,72 @@ int main(const int argc, const char* argv[]) {
                    .help("Print the Control-Flow-Graph of each source to a file ending in \".dot\"")
                    .flag();
     argument_parser.add_argument("-print-il")
-                   .help("Print the Intermediate Language of each source to a file ending in \".il\"")
+                   .help("Print the Intermediate Language of each source to a file ending in \".il\",\n"
+                         "or \".opt.il\" for sources that already are IL")
+                   .flag();
+    argument_parser.add_argument("-time-report")
+                   .help("Print (on the standard error output) the wall time, CPU time and peak memory growth\nof every compilation stage summed over all sources")
                    .flag();
+    argument_parser.add_argument("-time-report-format")
+                   .help("The format of the time report.\n\"text\" prints a table, \"json\" a single object meant for other tools")
+                   .default_value(std::string("text"))
+                   .choices("text", "json");
+    argument_parser.add_argument("-stats")
+                   .help("Print (on the standard error output) how often every optimization pass and backend stage\nchanged something, e.g. the folded instructions or the spilled variables, summed over all sources")
+                   .flag();
+
+    // Options with a value can also be written like "-regalloc=linear", which argparse only splits for "--" options.
+    // The optimization level is always attached to its option, e.g. "-O2", which is split into "-O" and "2".
+    // The same goes for the debug level, e.g. "-g1", where a plain "-g" selects the full debug information.
+    for (size_t index = 1; index < arguments.size(); index++) {
+        const auto& argument = arguments[index];
+        if (!argument.starts_with("-") || argument.starts_with("--")) continue;
+
+        if (argument == "-g") {
+            arguments.insert(arguments.begin() + static_cast<std::ptrdiff_t>(index) + 1, "2");
+            index++;
+            continue;
+        }
+
+        if (argument.size() == 3 && (argument[1] == 'O' || argument[1] == 'g')) {
+            auto level = argument.substr(2);
+            arguments[index] = argument.substr(0, 2);
+            arguments.insert(arguments.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(level));
+            index++;
+            continue;
+        }
+
+        const auto assign = argument.find('=');
+        if (assign == std::string::npos) continue;
+
+        auto value = argument.substr(assign + 1);
+        arguments[index] = argument.substr(0, assign);
+        arguments.insert(arguments.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(value));
+        index++;
+    }
 
     try {
-        argument_parser.parse_args(argc, argv);
+        argument_parser.parse_args(arguments);
     } catch (const std::exception& error) {
-        std::cerr << error.what() << std::endl;
-        std::cerr << argument_parser;
+        // Only asking for the help or the version doesn't need any inputs.
+        if (informed) return 0;
+
+        stderr_ostream << error.what() << std::endl;
+        stderr_ostream << argument_parser;
+        return 1;
+    }
+
+    if (informed) return 0;
+
+    if (argument_parser.is_used("-server")) {
+        stderr_ostream << "A server is started with \"-server <socket>\" as the only argument." << std::endl;
         return 1;
     }
 
-    const auto input_paths = argument_parser.get<std::vector<std::string>>("inputs");
-    const auto output_path = argument_parser.get<std::string>("output");
+    auto input_paths = argument_parser.get<std::vector<std::string>>("inputs");
+    for (auto& input_path : input_paths) input_path = resolve(input_path);
+
+    const auto output_path = resolve(argument_parser.get<std::string>("output"));
     const auto verbose = argument_parser.get<bool>("-v");
 
     const auto mode_S = argument_parser.get<bool>("-S");
@@ -89,64 +310,365 @@ int main(const int argc, const char* argv[]) {
     const auto mode_r = argument_parser.get<bool>("-r");
     const bool mode_full = !mode_S && !mode_c && !mode_r;
 
+    auto jobs = argument_parser.get<size_t>("-j");
+    if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+
+    const auto level = static_cast<uint8_t>(std::stoi(argument_parser.get<std::string>("-O")));
+
+    opt::Pipeline pipeline;
+    try {
+        const auto passes = argument_parser.present<std::string>("-passes");
+        pipeline = passes ? opt::Pipeline::parse(*passes) : opt::Pipeline::level(level);
+        if (argument_parser.get<bool>("-fmemoize")) pipeline.append("memoize");
+    } catch (const std::invalid_argument& error) {
+        stderr_ostream << error.what() << std::endl;
+        return 1;
+    }
+
+    // The profile is checked before anything is compiled, a missing one is most likely a typo in the path.
+    utils::ProfileOptions profile_options;
+    if (const auto path = argument_parser.present<std::string>("-fprofile-generate")) {
+        profile_options.generate = std::filesystem::absolute(resolve(*path)).string();
+    }
+
+    std::optional<il::Profile> profile;
+    if (const auto path = argument_parser.present<std::string>("-fprofile-use")) {
+        profile = il::Profile::load(resolve(*path));
+        if (!profile) {
+            stderr_ostream << "The profile " << std::quoted(*path) << " could not be read." << std::endl;
+            return 1;
+        }
+
+        profile_options.use = &*profile;
+    }
+
+    // Without optimizations the compilation should be as fast as possible, thus the faster allocator is preferred.
+    auto allocator_name = argument_parser.get<std::string>("-regalloc");
+    if (level == 0 && !argument_parser.is_used("-regalloc")) allocator_name = "linear";
+
+    const auto allocator = allocator_name == "linear"
+        ? x86_64::AllocatorKind::LinearScan
+        : x86_64::AllocatorKind::GraphColoring;
+
+    const auto integrated = argument_parser.get<std::string>("-assembler") == "integrated";
+
+    utils::CodegenOptions codegen_options;
+    codegen_options.omit_frame_pointer = argument_parser.get<bool>("-fomit-frame-pointer");
+    codegen_options.contract = argument_parser.get<std::string>("-ffp-contract") == "fast";
+    codegen_options.schedule = argument_parser.get<bool>("-fschedule-insns");
+
+    const auto debug_level = argument_parser.get<std::string>("-g");
+    codegen_options.debug_info = debug_level == "0" ? x86_64::DebugInfo::None
+        : debug_level == "1" ? x86_64::DebugInfo::Lines
+        : x86_64::DebugInfo::Full;
+    try {
+        const auto cpu = argument_parser.get<std::string>("-march");
+        codegen_options.target = x86_64::Target::parse(cpu, argument_parser.get<std::string>("-mattr"));
+    } catch (const std::invalid_argument& error) {
+        stderr_ostream << error.what() << std::endl;
+        return 1;
+    }
+
     const auto print_cfg = argument_parser.get<bool>("-print-cfg");
-    const auto print_asm = argument_parser.get<bool>("-print-asm");
+    // Only compiling without assembling is pointless without the assembly, thus "-S" always writes it.
+    const auto print_asm = argument_parser.get<bool>("-print-asm") || mode_S;
     const auto print_il = argument_parser.get<bool>("-print-il");
 
+    std::optional<utils::TimeReport> time_report;
+    if (argument_parser.get<bool>("-time-report")) time_report.emplace();
+    auto* const report = time_report ? &*time_report : nullptr;
+
+    std::optional<utils::Statistics> statistics;
+    if (argument_parser.get<bool>("-stats")) statistics.emplace();
+
+    // The reports are printed once compiling, assembling and linking succeeded, running the program isn't measured.
+    const auto print_reports = [&] {
+        if (statistics) statistics->print(stderr_ostream);
+        if (!time_report) return;
+
+        if (argument_parser.get<std::string>("-time-report-format") == "json") time_report->print_json(stderr_ostream);
+        else time_report->print(stderr_ostream);
+    };
+
+    utils::Cache* cache = nullptr;
+    if (const auto directory = argument_parser.present<std::string>("-cache-dir")) {
+        cache = &session.cache(resolve(*directory), argument_parser.get<size_t>("-cache-size") * 1024 * 1024);
+    }
+
     const bool should_assemble = !mode_S;
-    const bool should_link = mode_full || mode_r;
     const bool should_run = mode_r;
+    // The profile is written by "_start", which the JIT doesn't run, thus instrumented programs are always linked.
+    // A server never runs a program itself, as a crashing one would take down the server with it.
+    const bool should_jit = should_run && integrated && !profile_options.generate && !session.server();
+    const bool should_link = mode_full || (should_run && !should_jit);
 
-    std::vector<std::string> object_files;
-    for (const auto& input_path : input_paths) {
+    // The external assembler reads the assembly from memory, thus the file is only written if it was requested.
+    const bool assemble_external = should_assemble && !integrated;
+    const bool write_obj = should_assemble && integrated && !should_jit;
+
+    // Multiple sources are distributed over the jobs first, the remaining jobs are used per source.
+    const auto source_jobs = std::min(jobs, input_paths.size());
+    const auto function_jobs = std::max<size_t>(1, jobs / source_jobs);
+
+    // The amount of jobs doesn't change the output, thus it's not part of the configuration of cache entries.
+    const auto cache_configuration = std::string(PROJECT_VERSION)
+        + ";" + allocator_name
+        + ";" + argument_parser.get<std::string>("-assembler")
+        + ";" + pipeline.describe()
+        + ";" + (profile_options.generate ? "generate=" + *profile_options.generate : "")
+        + ";" + (profile ? "use=" + std::to_string(profile->checksum()) : "")
+        + ";" + (codegen_options.omit_frame_pointer ? "omit-frame-pointer" : "")
+        + ";" + codegen_options.target.describe()
+        + ";" + (codegen_options.contract ? "fp-contract" : "")
+        + ";" + (codegen_options.schedule ? "schedule-insns" : "")
+        + ";g" + debug_level;
+
+    // Sources after the first failing one are not compiled anymore, just like a sequential build would stop.
+    std::atomic failed_index = input_paths.size();
+
+    struct UnitResult {
+        std::string diagnostics;
+        std::string obj_path;
+        int32_t exit_code;
+        x86_64::Encoder encoder;
+
+        // Units compiled for the external assembler carry their listing, which is assembled after all units are
+        // compiled, and store their cache entry once the object exists.
+        std::optional<std::string> listing = { };
+        std::optional<std::string> cache_key = { };
+        std::vector<utils::Cache::Artifact> artifacts = { };
+    };
+
+    // The units are compiled concurrently, thus each of the lines they print is written at once.
+    std::mutex verbose_mutex;
+
+    // All units share the pool of their functions, thus it's opened before the first unit is compiled.
+    auto* const function_pool = function_jobs > 1 ? &session.function_pool(function_jobs) : nullptr;
+
+    const auto compile_unit = [&](const size_t index) -> UnitResult {
+        if (index > failed_index.load()) return { };
+
+        const auto& input_path = input_paths[index];
         const auto source = std::make_shared<pretty_diagnostics::FileSource>(input_path);
+        if (!invocation.directory.empty()) source->set_working_path(invocation.directory);
         const auto base_path = get_base_path(input_path);
 
-        const auto il_path = base_path + ".il";
+        // The printed IL of an IL input would otherwise overwrite the input itself.
+        const auto is_il = std::filesystem::path(input_path).extension() == ".il";
+        const auto il_path = base_path + (is_il ? ".opt.il" : ".il");
         const auto cfg_path = base_path + ".dot";
         const auto asm_path = base_path + ".s";
         const auto obj_path = base_path + ".o";
 
+        const auto fail = [&](const int32_t exit_code, std::string diagnostics) -> UnitResult {
+            auto expected = failed_index.load();
+            while (index < expected && !failed_index.compare_exchange_weak(expected, index)) { }
+            return { std::move(diagnostics), obj_path, exit_code, { } };
+        };
+
+        // The JIT needs the encoded machine code itself, which isn't stored in the cache. Only its functions are reused.
+        std::vector<utils::Cache::Artifact> artifacts;
+        if (print_il) artifacts.push_back({ "il", il_path });
+        if (print_cfg) artifacts.push_back({ "dot", cfg_path });
+        if (print_asm) artifacts.push_back({ "s", asm_path });
+        if (should_assemble) artifacts.push_back({ "o", obj_path });
+
+        std::optional<std::string> cache_key;
+        if (cache && !should_jit) {
+            auto configuration = cache_configuration;
+            for (const auto& artifact : artifacts) configuration += ";" + artifact.name;
+
+            cache_key = cache->key(source->contents(), configuration);
+            if (auto cached = cache->restore(*cache_key, artifacts)) {
+                if (verbose) {
+                    const std::lock_guard lock(verbose_mutex);
+                    stderr_ostream << "STAGE=CACHED: " << std::quoted(input_path) << std::endl;
+                }
+                return { std::move(*cached), obj_path, 0, { } };
+            }
+        }
+
+        std::ostringstream diagnostics;
+        std::ostringstream listing;
+        x86_64::Encoder encoder;
         { // This block has to exist, as the files get closed automatically because of RAII,
             // which is necessary so the files get written before commands are executed with it.
-            auto il_ostream = std::ofstream(il_path);
-            auto cfg_ostream = std::ofstream(cfg_path);
-            auto asm_ostream = std::ofstream(asm_path);
+            auto il_ostream = print_il ? std::ofstream(il_path) : std::ofstream();
+            auto cfg_ostream = print_cfg ? std::ofstream(cfg_path) : std::ofstream();
+            auto asm_ostream = print_asm ? std::ofstream(asm_path) : std::ofstream();
+            auto obj_ostream = write_obj ? std::ofstream(obj_path, std::ios::binary) : std::ofstream();
+            if (write_obj && verbose) {
+                const std::lock_guard lock(verbose_mutex);
+                stderr_ostream << "STAGE=ASSEMBLING: integrated " << std::quoted(obj_path) << std::endl;
+            }
+
+            std::ostream* asm_target = nullptr;
+            if (assemble_external) asm_target = &listing;
+            else if (print_asm) asm_target = &asm_ostream;
 
             const auto compile_exit = utils::compile(
                 source,
                 print_il ? &il_ostream : nullptr,
                 print_cfg ? &cfg_ostream : nullptr,
-                print_asm ? &asm_ostream : nullptr
+                asm_target,
+                write_obj ? &obj_ostream : nullptr,
+                should_jit ? &encoder : nullptr,
+                function_jobs,
+                allocator,
+                diagnostics,
+                cache,
+                cache_configuration,
+                report,
+                pipeline,
+                statistics ? &*statistics : nullptr,
+                profile_options,
+                codegen_options,
+                function_pool
             );
-            if (compile_exit != 0) return compile_exit;
+            if (compile_exit != 0) return fail(compile_exit, diagnostics.str());
+
+            if (assemble_external && print_asm) asm_ostream << listing.view();
+        }
+
+        if (assemble_external) {
+            return { diagnostics.str(), obj_path, 0, { }, std::move(listing).str(), cache_key, std::move(artifacts) };
+        }
+
+        if (cache_key) cache->store(*cache_key, artifacts, diagnostics.str());
+
+        return { diagnostics.str(), obj_path, 0, std::move(encoder) };
+    };
+
+    std::vector<std::string> object_files;
+    std::vector<x86_64::Encoder> modules;
+    {
+        auto& pool = session.source_pool(source_jobs);
+
+        std::vector<std::future<UnitResult>> units;
+        for (size_t index = 0; index < input_paths.size(); index++) {
+            units.push_back(pool.submit([&, index] { return compile_unit(index); }));
         }
 
-        if (!should_assemble) continue;
+        // The pool outlives this function, thus every unit has to be done before anything is returned.
+        for (const auto& unit : units) unit.wait();
 
-        auto obj_ostream = std::ofstream(obj_path);
-        auto assemble_exit = utils::assemble(asm_path, obj_ostream, verbose);
-        if (assemble_exit != 0) return assemble_exit;
+        // The results are reported in input order, thus the diagnostics don't depend on the scheduling.
+        std::vector<UnitResult> pending;
+        for (auto& unit : units) {
+            auto result = unit.get();
+            stderr_ostream << result.diagnostics;
+            if (result.exit_code != 0) return result.exit_code;
 
-        object_files.push_back(obj_path);
+            if (should_jit) modules.push_back(std::move(result.encoder));
+            else if (should_assemble) object_files.push_back(result.obj_path);
+
+            if (result.listing) pending.push_back(std::move(result));
+        }
+
+        // The external assembler is started once for every compiled unit, all of them running at the same time.
+        if (!pending.empty()) {
+            std::vector<std::string_view> listings;
+            std::vector<std::ofstream> obj_ostreams;
+            std::vector<std::ostream*> outputs;
+            for (const auto& result : pending) {
+                listings.push_back(*result.listing);
+                obj_ostreams.emplace_back(result.obj_path, std::ios::binary);
+            }
+            for (auto& obj_ostream : obj_ostreams) outputs.push_back(&obj_ostream);
+
+            {
+                const utils::TimeReport::Timer timer(report, "assemble");
+                const auto assemble_exit = utils::assemble_listings(listings, outputs, verbose, invocation);
+                if (assemble_exit != 0) return assemble_exit;
+            }
+
+            // The objects have to be written before the cache copies them into its entries.
+            for (auto& obj_ostream : obj_ostreams) obj_ostream.close();
+            for (const auto& result : pending) {
+                if (result.cache_key) cache->store(*result.cache_key, result.artifacts, result.diagnostics);
+            }
+        }
     }
 
-    if (!should_link || object_files.empty()) return 0;
+    if (should_jit) {
+        print_reports();
+
+        if (verbose) stderr_ostream << "STAGE=RUNNING: jit main" << std::endl;
+        return utils::run_jit(modules, invocation);
+    }
+
+    if (!should_link || object_files.empty()) {
+        print_reports();
+        return 0;
+    }
 
     { // The same RAII logic applies here.
         auto output_ostream = std::ofstream(output_path);
-        auto link_exit = utils::link(object_files, output_ostream, verbose);
+
+        const utils::TimeReport::Timer timer(report, "link");
+        auto link_exit = utils::link(object_files, output_ostream, verbose, invocation);
         if (link_exit != 0) return link_exit;
     }
 
+    print_reports();
+
     if (!should_run || object_files.empty()) return 0;
 
-    const int32_t run_exit = utils::run_binary(output_path);
+    const int32_t run_exit = utils::run_binary(output_path, nullptr, invocation);
     std::remove(output_path.c_str());
 
     return run_exit;
 }
 
+/**
+ * @brief Executes the command lines of the clients connecting to @p socket, until the process is terminated.
+ *
+ * @param socket The path of the Unix socket the server listens on.
+ * @return The exit code of the server, which only returns if it couldn't be started.
+ */
+int32_t serve(const std::string& socket) {
+    Session session(true);
+
+    try {
+        utils::Server server(socket);
+        server.serve([&](const utils::Request& request, const utils::Streams& streams) {
+            // The names of a request aren't needed by the following ones, which keeps the intern table bounded.
+            const utils::InternScope scope;
+
+            std::vector<std::string> arguments{ PROJECT_NAME };
+            arguments.insert(arguments.end(), request.arguments.begin(), request.arguments.end());
+
+            const utils::Invocation invocation{
+                streams.descriptors, request.directory, &streams.output, &streams.error
+            };
+            return run(std::move(arguments), session, invocation);
+        });
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+}
+} // namespace
+
+int main(const int argc, const char* argv[]) {
+    std::vector<std::string> arguments(argv, argv + argc);
+    if (arguments.size() == 3 && arguments[1] == "-server") return serve(arguments[2]);
+
+    // A running server executes the command line instead, whose state is still warm from the earlier ones.
+    if (const auto* socket = std::getenv("ARKOI_SERVER"); socket && *socket) {
+        std::error_code error;
+        const auto directory = std::filesystem::current_path(error);
+
+        if (!error) {
+            const utils::Request request{ directory, { arguments.begin() + 1, arguments.end() } };
+            if (const auto exit_code = utils::forward(socket, request)) return *exit_code;
+        }
+    }
+
+    Session session(false);
+    return run(std::move(arguments), session, { });
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
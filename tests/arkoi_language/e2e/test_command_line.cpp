@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <csignal>
+#include <optional>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "arkoi_language/utils/driver.hpp"
+
+using namespace arkoi;
+
+// The command line is only tested if the compiler executable is built alongside the tests.
+#ifdef ARKOI_EXECUTABLE
+static const std::string PROGRAM_FILES = TEST_PATH "/arkoi_language/e2e/programs/";
+
+/**
+ * @brief Runs the compiler executable with @p arguments, which is killed if it didn't exit after @p timeout.
+ *
+ * @return The exit code of the compiler, or std::nullopt if it was killed.
+ */
+static std::optional<int32_t> run_compiler(
+    const std::vector<std::string>& arguments, const std::chrono::seconds timeout
+) {
+    std::vector<char*> argv{ const_cast<char*>(ARKOI_EXECUTABLE) };
+    for (const auto& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+
+    const pid_t pid = fork();
+    if (pid == -1) return std::nullopt;
+
+    if (pid == 0) {
+        execv(ARKOI_EXECUTABLE, argv.data());
+        _exit(127);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    int status;
+    while (waitpid(pid, &status, WNOHANG) == 0) {
+        if (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        return std::nullopt;
+    }
+
+    if (!WIFEXITED(status)) return std::nullopt;
+    return WEXITSTATUS(status);
+}
+
+TEST(CommandLine, CompilesSourcesWithMoreJobsThanSources) {
+    const auto directory = utils::generate_temp_path();
+    std::filesystem::create_directories(directory);
+
+    // The objects are written next to the sources, thus they are compiled from a directory of their own.
+    std::vector<std::string> sources;
+    for (const auto* name : { "simple.ark", "fibonacci.ark" }) {
+        std::filesystem::copy_file(PROGRAM_FILES + name, directory / name);
+        sources.push_back((directory / name).string());
+    }
+
+    // Both sources compile their functions on the same pool of the session, which used to be created by each of
+    // them at once. Once in a while one of them destroyed the pool the other one was still waiting for.
+    for (size_t run = 0; run < 50; run++) {
+        const auto exit_code = run_compiler({ "-j", "4", sources[0], sources[1], "-c" }, std::chrono::seconds(30));
+        ASSERT_EQ(exit_code, 0) << "The compiler hung or failed in run " << run;
+    }
+
+    EXPECT_TRUE(std::filesystem::exists(directory / "simple.o"));
+    EXPECT_TRUE(std::filesystem::exists(directory / "fibonacci.o"));
+
+    std::filesystem::remove_all(directory);
+}
+#endif
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -10,28 +10,47 @@ using namespace arkoi;
 
 static const std::string PROGRAM_FILES = TEST_PATH "/arkoi_language/e2e/programs/";
 
-TEST(EndToEnd, AllPrograms) {
+static void run_all_programs(
+    const x86_64::AllocatorKind allocator, const bool integrated = false, const uint8_t level = opt::Pipeline::DEFAULT_LEVEL,
+    const bool memoize = false, const bool omit_frame_pointer = false
+) {
+    auto pipeline = opt::Pipeline::level(level);
+    if (memoize) pipeline.append("memoize");
+
     for (const auto& entry : std::filesystem::directory_iterator(PROGRAM_FILES)) {
         if (!entry.is_regular_file()) continue;
         if (entry.path().extension() != ".ark") continue;
+        // Its recursion is too deep for the stack, thus it only terminates once it's turned into a loop
+        if (entry.path().filename() == "tail_call.ark" && level < 2) continue;
 
         const auto file_path = entry.path().string();
-        const auto base_path = get_base_path(file_path);
+        // Keep the artifacts apart, so both allocators can be tested in parallel
+        auto suffix = std::string(allocator == x86_64::AllocatorKind::LinearScan ? ".linear" : ".graph");
+        if (integrated) suffix += ".integrated";
+        suffix += ".O" + std::to_string(level);
+        if (memoize) suffix += ".memoized";
+        if (omit_frame_pointer) suffix += ".omitted";
+        const auto base_path = get_base_path(file_path) + suffix;
 
         const auto source = std::make_shared<pretty_diagnostics::FileSource>(file_path);
 
         const auto asm_path = base_path + ".s";
-        { // Compile the source to assembly
+        const auto obj_path = base_path + ".o";
+        { // Compile the source to assembly, or directly to an object with the integrated assembler
             std::ofstream asm_ostream(asm_path);
+            std::ofstream obj_ostream;
+            if (integrated) obj_ostream.open(obj_path, std::ios::binary);
 
-            const int32_t compiler_exit = utils::compile(source, nullptr, nullptr, &asm_ostream);
+            const int32_t compiler_exit = utils::compile(
+                source, nullptr, nullptr, &asm_ostream, integrated ? &obj_ostream : nullptr, nullptr, 1, allocator,
+                std::cerr, nullptr, { }, nullptr, pipeline, nullptr, { }, { omit_frame_pointer }
+            );
             if (compiler_exit != 0) std::remove(asm_path.c_str());
 
             ASSERT_EQ(0, compiler_exit);
         }
 
-        const auto obj_path = base_path + ".o";
-        { // Assemble the compiled source
+        if (!integrated) { // Assemble the compiled source
             std::ofstream obj_ostream(obj_path);
 
             const auto assemble_exit = utils::assemble(asm_path, obj_ostream);
@@ -51,7 +70,12 @@ TEST(EndToEnd, AllPrograms) {
         }
 
         // Run the resulting binary
-        EXPECT_EQ(0, utils::run_binary(bin_path));
+        utils::RunStatistics statistics;
+        EXPECT_EQ(0, utils::run_binary(bin_path, &statistics)) << file_path;
+        EXPECT_GT(statistics.wall.count(), 0) << file_path;
+        if (statistics.cycles) {
+            EXPECT_GT(*statistics.cycles, 0u) << file_path;
+        }
 
         // Clean up the temporary file artifacts
         std::remove(asm_path.c_str());
@@ -59,3 +83,111 @@ TEST(EndToEnd, AllPrograms) {
         std::remove(bin_path.c_str());
     }
 }
+
+TEST(EndToEnd, AllPrograms) {
+    run_all_programs(x86_64::AllocatorKind::GraphColoring);
+}
+
+TEST(EndToEnd, AllProgramsLinearScan) {
+    run_all_programs(x86_64::AllocatorKind::LinearScan);
+}
+
+TEST(EndToEnd, AllProgramsIntegratedAssembler) {
+    run_all_programs(x86_64::AllocatorKind::GraphColoring, true);
+}
+
+TEST(EndToEnd, AllProgramsUnoptimized) {
+    run_all_programs(x86_64::AllocatorKind::LinearScan, true, 0);
+}
+
+TEST(EndToEnd, AllProgramsLocalOptimizations) {
+    run_all_programs(x86_64::AllocatorKind::GraphColoring, true, 1);
+}
+
+TEST(EndToEnd, AllProgramsMemoized) {
+    run_all_programs(x86_64::AllocatorKind::GraphColoring, false, opt::Pipeline::DEFAULT_LEVEL, true);
+    run_all_programs(x86_64::AllocatorKind::LinearScan, true, 0, true);
+}
+
+TEST(EndToEnd, AllProgramsOmitFramePointer) {
+    // The unoptimized code spills the most, which has the most stack slots addressed relative to RSP.
+    run_all_programs(x86_64::AllocatorKind::GraphColoring, true, opt::Pipeline::DEFAULT_LEVEL, false, true);
+    run_all_programs(x86_64::AllocatorKind::LinearScan, false, 0, false, true);
+}
+
+/**
+ * @brief Compiles the source with the integrated assembler and links it to @p bin_path.
+ */
+static void build_binary(
+    const std::shared_ptr<pretty_diagnostics::FileSource>& source, const std::string& bin_path,
+    const utils::ProfileOptions& profile
+) {
+    const auto obj_path = bin_path + ".o";
+    {
+        std::ofstream obj_ostream(obj_path, std::ios::binary);
+        ASSERT_EQ(0, utils::compile(
+            source, nullptr, nullptr, nullptr, &obj_ostream, nullptr, 1, x86_64::AllocatorKind::GraphColoring,
+            std::cerr, nullptr, { }, nullptr, opt::Pipeline::level(opt::Pipeline::DEFAULT_LEVEL), nullptr, profile
+        ));
+    }
+
+    std::ofstream bin_ostream(bin_path);
+    const auto link_exit = utils::link({ obj_path }, bin_ostream);
+    std::remove(obj_path.c_str());
+
+    ASSERT_EQ(0, link_exit);
+}
+
+TEST(EndToEnd, AllProgramsProfileGuided) {
+    for (const auto& entry : std::filesystem::directory_iterator(PROGRAM_FILES)) {
+        if (!entry.is_regular_file()) continue;
+        if (entry.path().extension() != ".ark") continue;
+
+        const auto file_path = entry.path().string();
+        const auto base_path = get_base_path(file_path) + ".profiled";
+        const auto profile_path = base_path + ".profile";
+        const auto bin_path = base_path + ".out";
+
+        const auto source = std::make_shared<pretty_diagnostics::FileSource>(file_path);
+
+        // The instrumented binary writes the profile on exit, which then guides the second compilation.
+        build_binary(source, bin_path, { profile_path, nullptr });
+        EXPECT_EQ(0, utils::run_binary(bin_path)) << file_path;
+
+        const auto profile = il::Profile::load(profile_path);
+        ASSERT_TRUE(profile.has_value()) << file_path;
+        EXPECT_GT(profile->size(), 0) << file_path;
+
+        build_binary(source, bin_path, { std::nullopt, &*profile });
+        EXPECT_EQ(0, utils::run_binary(bin_path)) << file_path;
+
+        std::remove(profile_path.c_str());
+        std::remove(bin_path.c_str());
+    }
+}
+
+TEST(EndToEnd, AllProgramsJit) {
+    for (const auto& entry : std::filesystem::directory_iterator(PROGRAM_FILES)) {
+        if (!entry.is_regular_file()) continue;
+        if (entry.path().extension() != ".ark") continue;
+
+        const auto source = std::make_shared<pretty_diagnostics::FileSource>(entry.path().string());
+
+        std::vector<x86_64::Encoder> modules(1);
+        ASSERT_EQ(0, utils::compile(source, nullptr, nullptr, nullptr, nullptr, &modules.front()));
+
+        EXPECT_EQ(0, utils::run_jit(modules)) << entry.path();
+
+        // The caches of memoized functions are placed in the bss section, which the JIT maps as well.
+        auto pipeline = opt::Pipeline::level(opt::Pipeline::DEFAULT_LEVEL);
+        pipeline.append("memoize");
+
+        std::vector<x86_64::Encoder> memoized(1);
+        ASSERT_EQ(0, utils::compile(
+            source, nullptr, nullptr, nullptr, nullptr, &memoized.front(), 1, x86_64::AllocatorKind::GraphColoring,
+            std::cerr, nullptr, { }, nullptr, pipeline
+        ));
+
+        EXPECT_EQ(0, utils::run_jit(memoized)) << entry.path();
+    }
+}
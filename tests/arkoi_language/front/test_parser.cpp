@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "arkoi_language/front/parser.hpp"
+#include "arkoi_language/front/scanner.hpp"
+
+using namespace arkoi;
+
+namespace {
+/**
+ * @brief The codes of all reports and the functions that were recovered from a source.
+ */
+struct Outcome {
+    std::vector<std::string> codes;
+    std::vector<std::string> functions;
+    std::vector<size_t> parameters;
+};
+
+/**
+ * @brief Parses @p contents, either from all tokens at once or streamed from the scanner.
+ */
+Outcome parse(const std::string& name, const std::string& contents, const bool streaming) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path) << contents;
+
+    const auto source = std::make_shared<pretty_diagnostics::FileSource>(path);
+    auto diagnostics = utils::Diagnostics();
+    auto scanner = front::Scanner(source, diagnostics);
+    auto parser = streaming
+        ? front::Parser(source, scanner, diagnostics)
+        : front::Parser(source, scanner.tokenize(), diagnostics);
+    const auto program = parser.parse_program();
+
+    Outcome parsed;
+    for (const auto& report : diagnostics.reports()) {
+        parsed.codes.push_back(report.code());
+    }
+
+    for (const auto& statement : program.statements()) {
+        auto& function = dynamic_cast<ast::Function&>(*statement);
+        parsed.functions.push_back(function.name().value().atom().str());
+        parsed.parameters.push_back(function.parameters().size());
+    }
+
+    return parsed;
+}
+} // namespace
+
+TEST(Parser, RecoversAtTheNextFunctionAfterABadFun) {
+    for (const auto streaming : { false, true }) {
+        const auto contents = "fun 42() @u32:\n    return 1\n\nfun ok() @u32:\n    return 2\n";
+        const auto parsed = parse("arkoi_parser_fun.ark", contents, streaming);
+
+        EXPECT_EQ(parsed.codes, std::vector<std::string>{ "E2001" }) << streaming;
+        EXPECT_EQ(parsed.functions, std::vector<std::string>{ "ok" }) << streaming;
+    }
+}
+
+TEST(Parser, RecoversAtTheNextParameterAfterABadOne) {
+    for (const auto streaming : { false, true }) {
+        const auto contents = "fun add(a @u32, 7, b @foo) @u32:\n    return a\n\nfun ok() @u32:\n    return 2\n";
+        const auto parsed = parse("arkoi_parser_parameters.ark", contents, streaming);
+
+        // The number isn't a parameter and "foo" isn't a type, both are skipped until the next comma or parenthesis.
+        EXPECT_EQ(parsed.codes, (std::vector<std::string>{ "E2001", "E2001" })) << streaming;
+        EXPECT_EQ(parsed.functions, (std::vector<std::string>{ "add", "ok" })) << streaming;
+        EXPECT_EQ(parsed.parameters, (std::vector<size_t>{ 1, 0 })) << streaming;
+    }
+}
+
+TEST(Parser, KeepsTheFunctionsBeforeATruncatedOne) {
+    for (const auto streaming : { false, true }) {
+        const auto contents = "fun ok() @u32:\n    return 2\n\nfun cut(a @u32";
+        const auto parsed = parse("arkoi_parser_truncated.ark", contents, streaming);
+
+        // The line still ends before the missing parenthesis, the end of the tokens has no report of its own.
+        EXPECT_EQ(parsed.codes, std::vector<std::string>{ "E2001" }) << streaming;
+        EXPECT_EQ(parsed.functions, std::vector<std::string>{ "ok" }) << streaming;
+    }
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
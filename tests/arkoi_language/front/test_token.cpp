@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/front/token.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::front;
+using namespace arkoi;
+
+using Type = Token::Type;
+
+TEST(Token, LooksUpEveryKeyword) {
+    for (const auto type : {
+             Type::If, Type::Else, Type::Fun, Type::Return, Type::U8, Type::S8, Type::U16, Type::S16, Type::U32,
+             Type::S32, Type::U64, Type::S64, Type::USize, Type::SSize, Type::F32, Type::F64, Type::Bool,
+             Type::True, Type::False, Type::While,
+         }) {
+        // Keywords are printed as their spelling.
+        EXPECT_EQ(Token::lookup_keyword(to_string(type)), type) << type;
+    }
+
+    for (const auto identifier : { "", "i", "iff", "u", "u128", "s9", "function", "returns", "While", "_if" }) {
+        EXPECT_EQ(Token::lookup_keyword(identifier), std::nullopt) << identifier;
+    }
+}
+
+TEST(Token, LooksUpEverySpecial) {
+    const std::vector<std::pair<std::string_view, Type>> specials = {
+        { "&&", Type::And }, { "||", Type::Or }, { "!=", Type::NotEqual }, { "==", Type::Equal },
+        { ">=", Type::GreaterEqual }, { "<=", Type::LessEqual }, { "(", Type::LParent }, { ")", Type::RParent },
+        { "@", Type::At }, { ",", Type::Comma }, { "+", Type::Plus }, { "-", Type::Minus }, { "/", Type::Slash },
+        { "*", Type::Asterisk }, { ">", Type::GreaterThan }, { "<", Type::LessThan }, { "=", Type::EqualSign },
+        { ":", Type::Colon },
+    };
+    for (const auto& [text, type] : specials) {
+        EXPECT_EQ(Token::lookup_special(text), type) << text;
+    }
+
+    for (const auto text : { "", "!", "&", "|", "=>", "+=", "&|", "===", "." }) {
+        EXPECT_EQ(Token::lookup_special(text), std::nullopt) << text;
+    }
+}
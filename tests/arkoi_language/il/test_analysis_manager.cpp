@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/il/analysis_manager.hpp"
+
+using namespace arkoi;
+
+/**
+ * main() @u32:
+ *     [ entry ] -> [ exit ]
+ */
+static il::Function create_straight_cfg() {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable result("x", type);
+
+    il::Function function("main", std::vector<il::Variable>(), type);
+
+    function.entry()->emplace_back<il::Assign>(result, il::Immediate(1u), std::nullopt);
+    function.entry()->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    function.entry()->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Return>(result, std::nullopt);
+
+    return function;
+}
+
+TEST(AnalysisManager, CachesUntilInvalidated) {
+    auto function = create_straight_cfg();
+
+    il::AnalysisManager analyses;
+    EXPECT_FALSE(analyses.cached<il::UseAnalysis>(function));
+
+    auto& uses = analyses.get<il::UseAnalysis>(function);
+    EXPECT_TRUE(analyses.cached<il::UseAnalysis>(function));
+    EXPECT_EQ(&uses, &analyses.get<il::UseAnalysis>(function));
+
+    const il::Operand result = il::Variable("x", sem::Integral(Size::DWORD, false));
+    EXPECT_TRUE(uses.is_used(result));
+
+    analyses.invalidate(function);
+    EXPECT_FALSE(analyses.cached<il::UseAnalysis>(function));
+}
+
+TEST(AnalysisManager, PreservesControlFlowAnalyses) {
+    auto function = create_straight_cfg();
+
+    il::AnalysisManager analyses;
+    const auto& dominance = analyses.get<il::DominanceAnalysis>(function);
+    std::ignore = analyses.get<il::UseAnalysis>(function);
+
+    EXPECT_EQ(dominance.immediates().at(function.exit()), function.entry());
+    EXPECT_EQ(dominance.children(function.entry()).size(), 1);
+
+    analyses.invalidate(function, il::AnalysisManager::Preserved::ControlFlow);
+    EXPECT_TRUE(analyses.cached<il::DominanceAnalysis>(function));
+    EXPECT_FALSE(analyses.cached<il::UseAnalysis>(function));
+
+    analyses.invalidate(function, il::AnalysisManager::Preserved::Nothing);
+    EXPECT_FALSE(analyses.cached<il::DominanceAnalysis>(function));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
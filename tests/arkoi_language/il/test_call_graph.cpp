@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "arkoi_language/il/call_graph.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * name() @u32:
+ *     [ entry: x0 = call callees[0], ..., ret 0 ]
+ */
+static void emplace_caller(il::Module& module, const std::string& name, const std::vector<std::string>& callees) {
+    auto& function = module.emplace_back(name, std::vector<il::Variable>{ }, TYPE);
+    function.set_exit(function.entry());
+
+    for (size_t index = 0; index < callees.size(); index++) {
+        const il::Variable result("x" + std::to_string(index), TYPE);
+        function.entry()->emplace_back<il::Call>(result, callees[index], std::vector<il::Operand>{ }, std::nullopt);
+    }
+
+    function.entry()->emplace_back<il::Return>(il::Immediate(0u), std::nullopt);
+}
+
+/**
+ * main -> a -> b, a -> b, c -> c, d
+ */
+static il::Module emplace_module() {
+    il::Module module;
+    emplace_caller(module, "main", { "a" });
+    emplace_caller(module, "a", { "b", "b" });
+    emplace_caller(module, "b", { });
+    emplace_caller(module, "c", { "c" });
+    emplace_caller(module, "d", { });
+    return module;
+}
+
+TEST(CallGraph, CollectsCallSites) {
+    auto module = emplace_module();
+    const il::CallGraph graph(module);
+
+    EXPECT_EQ(graph.callees("a"), (std::vector<std::string>{ "b", "b" }));
+    EXPECT_TRUE(graph.callees("d").empty());
+    EXPECT_TRUE(graph.callees("unknown").empty());
+
+    const auto& sites = graph.sites("b");
+    ASSERT_EQ(sites.size(), 2);
+    EXPECT_EQ(sites.front().caller, graph.function("a"));
+    EXPECT_EQ(sites.front().block, graph.function("a")->entry());
+
+    EXPECT_TRUE(graph.sites("main").empty());
+    EXPECT_EQ(graph.function("unknown"), nullptr);
+}
+
+TEST(CallGraph, FindsReachableAndRecursiveFunctions) {
+    auto module = emplace_module();
+    const il::CallGraph graph(module);
+
+    EXPECT_EQ(graph.reachable({ "main" }), (std::unordered_set<std::string>{ "main", "a", "b" }));
+    EXPECT_EQ(graph.reachable({ "c" }), (std::unordered_set<std::string>{ "c" }));
+
+    EXPECT_TRUE(graph.is_recursive("c"));
+    EXPECT_FALSE(graph.is_recursive("a"));
+    EXPECT_FALSE(graph.is_recursive("d"));
+}
+
+TEST(CallGraph, OrdersCalleesBeforeCallers) {
+    auto module = emplace_module();
+    const il::CallGraph graph(module);
+
+    const auto order = graph.bottom_up();
+    ASSERT_EQ(order.size(), 5);
+
+    const auto position = [&](const std::string& name) {
+        return std::ranges::find(order, graph.function(name)) - order.begin();
+    };
+
+    EXPECT_LT(position("b"), position("a"));
+    EXPECT_LT(position("a"), position("main"));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
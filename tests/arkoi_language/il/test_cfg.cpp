@@ -168,6 +168,63 @@ TEST(DominatorTree, FrontierDominators) {
     EXPECT_THAT(get_frontier("main_exit"), ElementsAre());
 }
 
+TEST(DominatorTree, DominatesQueries) {
+    auto function = create_example_cfg();
+    auto& blocks = function.block_pool();
+
+    const il::DominatorTree tree(function);
+
+    EXPECT_TRUE(tree.dominates(function.entry(), function.exit()));
+    EXPECT_TRUE(tree.dominates(blocks["next_1"].get(), blocks["branch_2"].get()));
+    EXPECT_TRUE(tree.dominates(blocks["next_2"].get(), blocks["next_2"].get()));
+    EXPECT_FALSE(tree.dominates(blocks["next_1"].get(), function.exit()));
+    EXPECT_FALSE(tree.dominates(blocks["branch_2"].get(), blocks["next_1"].get()));
+
+    EXPECT_EQ(tree.immediate(blocks["branch_2"].get()), blocks["next_1"].get());
+    EXPECT_EQ(tree.immediate(function.entry()), nullptr);
+}
+
+TEST(DominatorTree, SemiNCAMatchesIterative) {
+    il::Function function("main", std::vector<il::Variable>(), sem::Boolean());
+
+    // A chain with back edges and skips, which is large enough to be built with Semi-NCA by default.
+    std::vector<il::BasicBlock*> blocks{ function.entry() };
+    for (size_t index = 1; index < il::DominatorTree::SEMI_NCA_THRESHOLD + 64; index++) {
+        blocks.push_back(function.emplace_back("block_" + std::to_string(index)));
+    }
+    blocks.push_back(function.exit());
+
+    for (size_t index = 0; index + 1 < blocks.size(); index++) {
+        blocks[index]->set_next(blocks[index + 1]);
+
+        if (index % 3 == 0 && index > 0) blocks[index]->set_branch(blocks[index / 2]);
+        else if (index % 5 == 0 && index + 7 < blocks.size()) blocks[index]->set_branch(blocks[index + 7]);
+    }
+
+    const il::DominatorTree iterative(function, il::DominatorTree::Algorithm::Iterative);
+    const il::DominatorTree semi_nca(function, il::DominatorTree::Algorithm::SemiNCA);
+    const il::DominatorTree automatic(function);
+
+    EXPECT_EQ(iterative.immediates(), semi_nca.immediates());
+    EXPECT_EQ(iterative.immediates(), automatic.immediates());
+
+    for (const auto* dominator : { blocks[0], blocks[5], blocks[12], blocks[300] }) {
+        for (const auto* block : { blocks[6], blocks[12], blocks[13], blocks[301], function.exit() }) {
+            EXPECT_EQ(iterative.dominates(dominator, block), semi_nca.dominates(dominator, block));
+        }
+    }
+}
+
+TEST(ControlFlowGraph, BlocksUseFunctionArena) {
+    auto function = create_example_cfg();
+    ASSERT_NE(function.arena(), nullptr);
+
+    for (auto& block : function) {
+        EXPECT_EQ(block.instructions().get_allocator().resource(), function.arena());
+        EXPECT_EQ(block.predecessors().get_allocator().resource(), function.arena());
+    }
+}
+
 //==============================================================================
 // BSD 3-Clause License
 //
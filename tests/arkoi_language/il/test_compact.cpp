@@ -0,0 +1,79 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/compact.hpp"
+
+using testing::ElementsAre;
+using namespace arkoi;
+
+/**
+ * main($p.0 @u32) @u32:
+ *     [ entry: x = p, y = x + 1, goto exit ] -> [ exit: ret y ]
+ */
+TEST(CompactFunction, ParallelArrays) {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable parameter("p", type), x("x", type), y("y", type);
+
+    il::Function function("main", { parameter }, type);
+
+    function.entry()->emplace_back<il::Assign>(x, parameter, std::nullopt);
+    function.entry()->emplace_back<il::Binary>(
+        y, x, il::Binary::Operator::Add, il::Immediate(1u), type, std::nullopt
+    );
+    function.entry()->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    function.entry()->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Return>(y, std::nullopt);
+
+    const il::CompactFunction compact(function);
+    constexpr auto NONE = il::CompactFunction::NONE;
+
+    EXPECT_THAT(compact.variables(), ElementsAre(x, parameter, y));
+    EXPECT_EQ(compact.id(y), 2u);
+    EXPECT_EQ(compact.id(il::Variable("w", type)), NONE);
+    EXPECT_EQ(compact.instructions(), 4u);
+
+    ASSERT_EQ(compact.blocks().size(), 2u);
+    const auto& entry = compact.blocks()[0];
+    EXPECT_EQ(entry.source, function.entry());
+    EXPECT_THAT(entry.opcodes, ElementsAre(il::Opcode::Assign, il::Opcode::Binary, il::Opcode::Goto));
+    EXPECT_THAT(entry.results, ElementsAre(0u, 2u, NONE));
+    EXPECT_THAT(entry.uses(0), ElementsAre(1u));
+    EXPECT_THAT(entry.uses(1), ElementsAre(0u, NONE));
+    EXPECT_TRUE(entry.uses(2).empty());
+
+    const auto& exit = compact.blocks()[1];
+    EXPECT_THAT(exit.opcodes, ElementsAre(il::Opcode::Return));
+    EXPECT_THAT(exit.uses(0), ElementsAre(2u));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
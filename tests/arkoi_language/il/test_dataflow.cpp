@@ -0,0 +1,129 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/analyses.hpp"
+
+using testing::UnorderedElementsAre;
+using namespace arkoi;
+
+/**
+ * main() @u32:
+ *     [ entry ] -> [ header ] <-> [ body ]
+ *                      |
+ *                  [  exit  ]
+ */
+il::Function create_loop_cfg() {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable counter("i", type);
+    const il::Variable condition("c", sem::Boolean());
+
+    il::Function function("main", std::vector<il::Variable>(), type);
+
+    auto* header_block = function.emplace_back("header");
+    auto* body_block = function.emplace_back("body");
+
+    function.entry()->emplace_back<il::Assign>(counter, il::Immediate(0u), std::nullopt);
+    function.entry()->emplace_back<il::Goto>("header", std::nullopt);
+    function.entry()->set_next(header_block);
+
+    header_block->emplace_back<il::Binary>(
+        condition, counter, il::Binary::Operator::LessThan, il::Immediate(10u), type, std::nullopt
+    );
+    header_block->emplace_back<il::If>(condition, function.exit()->label(), "body", std::nullopt);
+    header_block->set_next(function.exit());
+    header_block->set_branch(body_block);
+
+    body_block->emplace_back<il::Binary>(
+        counter, counter, il::Binary::Operator::Add, il::Immediate(1u), type, std::nullopt
+    );
+    body_block->emplace_back<il::Goto>("header", std::nullopt);
+    body_block->set_next(header_block);
+
+    function.exit()->emplace_back<il::Return>(counter, std::nullopt);
+
+    return function;
+}
+
+TEST(DataflowAnalysis, BlockLivenessAcrossLoop) {
+    auto function = create_loop_cfg();
+
+    il::DataflowAnalysis<il::BlockLivenessAnalysis> analysis;
+    analysis.run(function);
+
+    const il::Operand counter = il::Variable("i", sem::Integral(Size::DWORD, false));
+
+    auto* header_block = function.entry()->next();
+    auto* body_block = header_block->branch();
+
+    EXPECT_TRUE(analysis.in().at(function.entry()).empty());
+    EXPECT_THAT(analysis.out().at(function.entry()), UnorderedElementsAre(counter));
+    EXPECT_THAT(analysis.in().at(header_block), UnorderedElementsAre(counter));
+    EXPECT_THAT(analysis.in().at(body_block), UnorderedElementsAre(counter));
+    EXPECT_THAT(analysis.in().at(function.exit()), UnorderedElementsAre(counter));
+}
+
+TEST(DataflowAnalysis, WorklistDeduplicatesBlocks) {
+    auto function = create_loop_cfg();
+
+    il::DataflowAnalysis<il::BlockLivenessAnalysis> analysis;
+    analysis.run(function);
+
+    // Every block is visited once initially, only the loop has to be revisited once to reach the fixed point.
+    EXPECT_LE(analysis.iterations(), 6);
+}
+
+TEST(DataflowAnalysis, SparseLivenessMatchesInstructionLiveness) {
+    auto function = create_loop_cfg();
+
+    il::DataflowAnalysis<il::InstructionLivenessAnalysis> dense;
+    dense.run(function);
+
+    il::SparseLivenessAnalysis sparse;
+    sparse.run(function);
+
+    size_t visited = 0;
+    for (auto& block : function) {
+        sparse.for_each_live_out(
+            block,
+            [&](il::Instruction& instruction, const il::SparseLivenessAnalysis::State& live) {
+                const std::vector expected(dense.out().at(&instruction).begin(), dense.out().at(&instruction).end());
+                const std::vector actual(live.begin(), live.end());
+                EXPECT_EQ(expected, actual);
+                visited++;
+            }
+        );
+    }
+
+    EXPECT_EQ(visited, dense.out().size());
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,97 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/analyses.hpp"
+
+using testing::ElementsAre;
+using namespace arkoi;
+
+/**
+ * main($p.0 @u32) @u32:
+ *     [ entry: x = p, y = x + 1 ] -> [ exit: z = phi [ entry: x ], ret y ]
+ */
+static il::Function create_copy_cfg() {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable parameter("p", type), x("x", type), y("y", type), z("z", type);
+
+    il::Function function("main", { parameter }, type);
+
+    function.entry()->emplace_back<il::Assign>(x, parameter, std::nullopt);
+    function.entry()->emplace_back<il::Binary>(
+        y, x, il::Binary::Operator::Add, il::Immediate(1u), type, std::nullopt
+    );
+    function.entry()->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    function.entry()->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Phi>(z, il::Phi::Incoming{ { function.entry(), x } }, std::nullopt);
+    function.exit()->emplace_back<il::Return>(y, std::nullopt);
+
+    return function;
+}
+
+TEST(DefUseChains, DefinitionsAndUses) {
+    auto function = create_copy_cfg();
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+
+    il::DefUseChains chains(function);
+
+    auto& entry = function.entry()->instructions();
+    auto& exit = function.exit()->instructions();
+
+    EXPECT_EQ(chains.definition(il::Variable("x", type)), &entry[0]);
+    EXPECT_EQ(chains.definition(il::Variable("p", type)), nullptr);
+    EXPECT_TRUE(chains.is_single_assignment(il::Variable("p", type)));
+    EXPECT_FALSE(chains.is_single_assignment(il::Variable("w", type)));
+
+    EXPECT_THAT(chains.uses(il::Variable("x", type)), ElementsAre(&entry[1], &exit[0]));
+    EXPECT_EQ(chains.block(&exit[1]), function.exit());
+}
+
+TEST(DefUseChains, ReplaceAllUsesKeepsChains) {
+    auto function = create_copy_cfg();
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable parameter("p", type), x("x", type);
+
+    il::DefUseChains chains(function);
+
+    auto& entry = function.entry()->instructions();
+    auto& exit = function.exit()->instructions();
+
+    EXPECT_THAT(chains.replace_all_uses(x, parameter), ElementsAre(&entry[1]));
+    EXPECT_EQ(std::get<il::Binary>(entry[1]).left(), il::Operand(parameter));
+
+    // The phi still reads the copy, while the binary now reads the parameter.
+    EXPECT_THAT(chains.uses(x), ElementsAre(&exit[0]));
+    EXPECT_THAT(chains.uses(parameter), ElementsAre(&entry[0], &entry[1]));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
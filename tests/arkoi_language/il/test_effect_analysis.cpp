@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/effect_analysis.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * name($p.0 @u32) @u32:
+ *     [ entry: r = p op divisor, arg r, x0 = call callees[0], ..., ret r ]
+ */
+static il::Function& emplace_function(
+    il::Module& module, const std::string& name, const std::vector<std::string>& callees,
+    const il::Binary::Operator op = il::Binary::Operator::Add, const il::Operand& divisor = il::Immediate(1u)
+) {
+    const il::Variable parameter("p", TYPE), result("r", TYPE);
+
+    auto& function = module.emplace_back(name, std::vector{ parameter }, TYPE);
+    function.set_exit(function.entry());
+    function.entry()->emplace_back<il::Binary>(result, parameter, op, divisor, TYPE, std::nullopt);
+
+    for (size_t index = 0; index < callees.size(); index++) {
+        const il::Variable argument("a" + std::to_string(index), TYPE), value("x" + std::to_string(index), TYPE);
+        function.entry()->emplace_back<il::Argument>(argument, result, std::nullopt);
+        function.entry()->emplace_back<il::Call>(
+            value, callees[index], std::vector<il::Operand>{ argument }, std::nullopt
+        );
+    }
+
+    function.entry()->emplace_back<il::Return>(result, std::nullopt);
+    return function;
+}
+
+TEST(EffectAnalysis, ClassifiesFunctions) {
+    il::Module module;
+    emplace_function(module, "leaf", { });
+    emplace_function(module, "caller", { "leaf", "leaf" });
+    emplace_function(module, "divide", { }, il::Binary::Operator::Div, il::Variable("p", TYPE));
+    emplace_function(module, "constant_divide", { }, il::Binary::Operator::Div, il::Immediate(2u));
+    emplace_function(module, "recursive", { "leaf", "recursive" });
+    emplace_function(module, "external", { "leaf", "unknown" });
+    emplace_function(module, "indirect", { "divide", "external" });
+
+    auto& looping = emplace_function(module, "looping", { });
+    auto* body = looping.emplace_back("body");
+    looping.entry()->instructions().pop_back();
+    looping.entry()->emplace_back<il::Goto>(body->label(), std::nullopt);
+    looping.entry()->set_next(body);
+    body->emplace_back<il::Goto>(body->label(), std::nullopt);
+    body->set_next(body);
+    looping.set_exit(body);
+
+    const il::EffectAnalysis analysis(module);
+    EXPECT_EQ(analysis.effects("leaf"), il::Call::Effects::Speculatable);
+    EXPECT_EQ(analysis.effects("caller"), il::Call::Effects::Speculatable);
+    EXPECT_EQ(analysis.effects("constant_divide"), il::Call::Effects::Speculatable);
+
+    // Each of them may trap or never return, but none has side effects.
+    EXPECT_EQ(analysis.effects("divide"), il::Call::Effects::ReadNone);
+    EXPECT_EQ(analysis.effects("recursive"), il::Call::Effects::ReadNone);
+    EXPECT_EQ(analysis.effects("looping"), il::Call::Effects::ReadNone);
+
+    // The code of functions outside of the module is unknown, which also holds for their callers.
+    EXPECT_EQ(analysis.effects("unknown"), il::Call::Effects::Unknown);
+    EXPECT_EQ(analysis.effects("external"), il::Call::Effects::Unknown);
+    EXPECT_EQ(analysis.effects("indirect"), il::Call::Effects::Unknown);
+}
+
+TEST(EffectAnalysis, AnnotatesCalls) {
+    il::Module module;
+    emplace_function(module, "leaf", { });
+    auto& caller = emplace_function(module, "caller", { "leaf", "unknown" });
+
+    const il::EffectAnalysis analysis(module);
+    EXPECT_EQ(analysis.annotate(module), 1);
+    EXPECT_EQ(analysis.annotate(module), 0);
+
+    std::vector<il::Call::Effects> effects;
+    for (auto& instruction : *caller.entry()) {
+        if (const auto* call = std::get_if<il::Call>(&instruction)) effects.push_back(call->effects());
+    }
+
+    EXPECT_EQ(effects, (std::vector{ il::Call::Effects::Speculatable, il::Call::Effects::Unknown }));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,129 @@
+#include <filesystem>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/front/parser.hpp"
+#include "arkoi_language/front/scanner.hpp"
+#include "arkoi_language/il/generator.hpp"
+#include "arkoi_language/il/interpreter.hpp"
+#include "arkoi_language/sem/name_resolver.hpp"
+#include "arkoi_language/sem/type_resolver.hpp"
+
+using namespace arkoi;
+
+static const std::string PROGRAM = R"(fun main() @u32:
+    return 0
+
+fun collatz(n @u32) @u32:
+    steps @u32 = 0
+    while n != 1:
+        if n / 2 * 2 == n:
+            n = n / 2
+        else:
+            n = n * 3 + 1
+        steps = steps + 1
+    return steps
+
+fun swap(n @u32) @u32:
+    a @u32 = 1
+    b @u32 = 2
+    while n > 0 && a < 100:
+        t @u32 = a
+        a = b
+        b = t
+        n = n - 1
+    return a * 10 + b
+)";
+
+static il::Module generate(const il::Generator::Form form) {
+    const auto path = std::filesystem::temp_directory_path() / "arkoi_generator.ark";
+    std::ofstream(path) << PROGRAM;
+    const auto source = std::make_shared<pretty_diagnostics::FileSource>(path);
+
+    auto diagnostics = utils::Diagnostics();
+    auto scanner = front::Scanner(source, diagnostics);
+    auto program = front::Parser(source, scanner, diagnostics).parse_program();
+    sem::NameResolver(diagnostics).visit(program);
+    sem::TypeResolver(diagnostics).visit(program);
+    EXPECT_FALSE(diagnostics.has_errors());
+
+    auto generator = il::Generator(form);
+    generator.visit(program);
+    return std::move(generator.module());
+}
+
+static size_t count_phis(il::Function& function) {
+    size_t phis = 0;
+    for (auto& block : function) {
+        for (auto& instruction : block) {
+            EXPECT_FALSE(std::holds_alternative<il::Alloca>(instruction));
+            EXPECT_FALSE(std::holds_alternative<il::Store>(instruction));
+            EXPECT_FALSE(std::holds_alternative<il::Load>(instruction));
+
+            if (std::holds_alternative<il::Phi>(instruction)) phis++;
+        }
+    }
+
+    return phis;
+}
+
+TEST(Generator, SSAFormMatchesMemoryForm) {
+    auto memory = generate(il::Generator::Form::Memory);
+    auto ssa = generate(il::Generator::Form::SSA);
+
+    il::Interpreter memory_interpreter(memory), ssa_interpreter(ssa);
+    for (const auto& function : { "collatz", "swap" }) {
+        for (const uint32_t argument : { 1u, 2u, 7u, 27u }) {
+            const std::vector<il::Immediate> arguments{ argument };
+
+            const auto expected = memory_interpreter.call(function, arguments);
+            ASSERT_TRUE(expected.has_value());
+            EXPECT_EQ(ssa_interpreter.call(function, arguments), expected) << function << "(" << argument << ")";
+        }
+    }
+}
+
+TEST(Generator, SSAFormRemovesTrivialPhis) {
+    auto module = generate(il::Generator::Form::SSA);
+
+    std::unordered_map<std::string, size_t> phis;
+    for (auto& function : module) phis[function.name()] = count_phis(function);
+
+    // The loop of collatz merges n and steps in its condition and n after the if, the loop of swap merges
+    // n, a and b in its condition, and the result of the && after it. A function without any branch needs none.
+    EXPECT_EQ(phis.at("collatz"), 3u);
+    EXPECT_EQ(phis.at("swap"), 4u);
+    EXPECT_EQ(phis.at("main"), 0u);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "arkoi_language/il/il_parser.hpp"
+#include "arkoi_language/il/il_printer.hpp"
+
+using namespace arkoi;
+
+static std::shared_ptr<pretty_diagnostics::Source> write_source(const std::string& name, const std::string& contents) {
+    const auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path) << contents;
+    return std::make_shared<pretty_diagnostics::FileSource>(path);
+}
+
+static std::string print(il::Module& module) {
+    std::stringstream output;
+    il::ILPrinter(output).visit(module);
+    return output.str();
+}
+
+static const std::string PROGRAM = R"(fun select($p.0 @u32) @u32:
+L0:
+  $c.0 @bool = equ @u32 $p.0, 1
+  if $c.0 then L1 else L2
+L2:
+  $b.0 @u32 = select $c.0, 1, $p.0
+  goto L3
+L3:
+  $r.0 @u32 = phi [ L1: $a.0, L2: $b.0 ]
+  ret $r.0
+L1:
+  $a.0 @u32 = cast @s64 $p.0
+  goto L3
+
+fun main() @s32:
+L0:
+  %slot @u32 = alloca
+  %slot @u32 = store 7
+  $v.0 @u32 = load %slot
+  $f.0 @f64 = -0.25
+  $g.0 @f32 = 1.5
+  $t.0 @bool = 1
+  $u.0 @u64 = 18446744073709551615
+L1:
+  arg @u32 $v.0
+  $x.0 @u32 = call speculatable select, 1
+  ret -1
+
+)";
+
+TEST(ILParser, ParsesItsPrintedOutput) {
+    utils::Diagnostics diagnostics;
+    auto module = il::ILParser(write_source("arkoi_il_parser.il", PROGRAM), diagnostics).parse();
+    ASSERT_FALSE(diagnostics.has_errors());
+
+    EXPECT_EQ(print(module), PROGRAM);
+
+    auto& select = *module.begin();
+    EXPECT_EQ(select.exit()->label(), "L3");
+    EXPECT_EQ(select.exit()->predecessors().size(), 2);
+
+    // The first block of main has no terminator, thus it falls through to the following one.
+    auto& main = *std::next(module.begin());
+    EXPECT_EQ(main.entry()->next()->label(), "L1");
+    EXPECT_EQ(main.exit(), main.entry()->next());
+
+    auto& call = std::get<il::Call>(main.exit()->instructions()[1]);
+    EXPECT_EQ(call.effects(), il::Call::Effects::Speculatable);
+    EXPECT_EQ(call.arguments().size(), 1);
+}
+
+TEST(ILParser, ReportsMalformedLines) {
+    const std::vector<std::string> programs{
+        "fun main() @u32:\nL0:\n  goto L1\n\n",
+        "fun main() @u32:\nL0:\n  $a.0 @u32 = add @u32 $b.0, 1\n  ret $a.0\n\n",
+        "fun main() @u32:\nL0:\n  $a.0 @u32 = frobnicate 1\n  ret $a.0\n\n",
+        "fun main() @u32:\nL0:\n  $a.0 @u32 = 1\n\n",
+        "fun main( @u32:\nL0:\n  ret 1\n\n",
+    };
+
+    for (const auto& program : programs) {
+        utils::Diagnostics diagnostics;
+        std::ignore = il::ILParser(write_source("arkoi_il_parser_malformed.il", program), diagnostics).parse();
+
+        ASSERT_TRUE(diagnostics.has_errors()) << program;
+        EXPECT_EQ(diagnostics.reports().front().code(), "E4000") << program;
+    }
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
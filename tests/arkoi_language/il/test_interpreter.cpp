@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/interpreter.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * diamond($p.0 @u32) @u32:
+ *     [ entry: c = p == 1, if c ] -> [ then: a = 10 ] -> [ exit: r = phi [ then: a, else: b ], ret r ]
+ *                                 -> [ else: b = p ] ->
+ */
+static void emplace_diamond(il::Module& module) {
+    const il::Variable parameter("p", TYPE), a("a", TYPE), b("b", TYPE), r("r", TYPE), c("c", sem::Boolean());
+
+    auto& function = module.emplace_back("diamond", std::vector{ parameter }, TYPE);
+    auto* then_block = function.emplace_back("then");
+    auto* else_block = function.emplace_back("else");
+
+    function.entry()->emplace_back<il::Binary>(
+        c, parameter, il::Binary::Operator::Equal, il::Immediate(1u), TYPE, std::nullopt
+    );
+    function.entry()->emplace_back<il::If>(c, else_block->label(), then_block->label(), std::nullopt);
+    function.entry()->set_next(else_block);
+    function.entry()->set_branch(then_block);
+
+    then_block->emplace_back<il::Assign>(a, il::Immediate(10u), std::nullopt);
+    then_block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    then_block->set_next(function.exit());
+
+    else_block->emplace_back<il::Assign>(b, parameter, std::nullopt);
+    else_block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    else_block->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Phi>(
+        r, il::Phi::Incoming{ { then_block, a }, { else_block, b } }, std::nullopt
+    );
+    function.exit()->emplace_back<il::Return>(r, std::nullopt);
+}
+
+/**
+ * name($p.0 @u32) @u32:
+ *     [ entry: slot = alloca, store slot p, v = load slot, r = v op right, arg r, x = call callee, ret x ]
+ */
+static void emplace_caller(
+    il::Module& module, const std::string& name, const std::string& callee,
+    const il::Binary::Operator op = il::Binary::Operator::Mul, const il::Operand& right = il::Immediate(2u)
+) {
+    const il::Variable parameter("p", TYPE), v("v", TYPE), r("r", TYPE), a("a", TYPE), x("x", TYPE);
+    const il::Memory slot("slot", TYPE);
+
+    auto& function = module.emplace_back(name, std::vector{ parameter }, TYPE);
+    function.set_exit(function.entry());
+
+    auto* entry = function.entry();
+    entry->emplace_back<il::Alloca>(slot, std::nullopt);
+    entry->emplace_back<il::Store>(slot, parameter, std::nullopt);
+    entry->emplace_back<il::Load>(v, slot, std::nullopt);
+    entry->emplace_back<il::Binary>(r, v, op, right, TYPE, std::nullopt);
+    entry->emplace_back<il::Argument>(a, r, std::nullopt);
+    entry->emplace_back<il::Call>(x, callee, std::vector<il::Operand>{ a }, std::nullopt);
+    entry->emplace_back<il::Return>(x, std::nullopt);
+}
+
+TEST(Interpreter, ExecutesBranchesAndPhis) {
+    il::Module module;
+    emplace_diamond(module);
+
+    il::Interpreter interpreter(module);
+    EXPECT_EQ(interpreter.call("diamond", { il::Immediate(1u) }), il::Immediate(10u));
+    EXPECT_EQ(interpreter.call("diamond", { il::Immediate(7u) }), il::Immediate(7u));
+
+    // The arguments are converted to the type of the parameters.
+    EXPECT_EQ(interpreter.call("diamond", { il::Immediate(int64_t{ 7 }) }), il::Immediate(7u));
+}
+
+TEST(Interpreter, ExecutesCallsAndMemory) {
+    il::Module module;
+    emplace_diamond(module);
+    emplace_caller(module, "twice", "diamond");
+
+    il::Interpreter interpreter(module);
+    EXPECT_EQ(interpreter.call("twice", { il::Immediate(4u) }), il::Immediate(8u));
+    EXPECT_GT(interpreter.steps(), 0);
+
+    // The arithmetic wraps around like on the target.
+    EXPECT_EQ(interpreter.call("twice", { il::Immediate(0x80000001u) }), il::Immediate(2u));
+}
+
+TEST(Interpreter, AbortsWhatCantBeEvaluated) {
+    il::Module module;
+    emplace_diamond(module);
+    emplace_caller(module, "divide", "diamond", il::Binary::Operator::Div, il::Variable("v", TYPE));
+    emplace_caller(module, "external", "unknown");
+    emplace_caller(module, "recursive", "recursive");
+
+    il::Interpreter interpreter(module, 100);
+    EXPECT_EQ(interpreter.call("divide", { il::Immediate(0u) }), std::nullopt);
+    EXPECT_EQ(interpreter.call("external", { il::Immediate(1u) }), std::nullopt);
+    EXPECT_EQ(interpreter.call("missing", { }), std::nullopt);
+    EXPECT_EQ(interpreter.call("diamond", { }), std::nullopt);
+
+    // The recursion never ends, thus the fuel runs out.
+    EXPECT_EQ(interpreter.call("recursive", { il::Immediate(1u) }), std::nullopt);
+    EXPECT_EQ(interpreter.steps(), 101);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
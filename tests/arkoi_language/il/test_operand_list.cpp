@@ -0,0 +1,58 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/instruction.hpp"
+
+using testing::ElementsAre;
+using namespace arkoi;
+
+TEST(OperandList, InlineAndHeapStorage) {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable a("a", type), b("b", type), c("c", type), d("d", type), result("r", type);
+    const il::Operand first(a), second(b), third(c), fourth(d), immediate(il::Immediate(1u));
+
+    const il::Select select(result, a, b, il::Immediate(1u), std::nullopt);
+    EXPECT_THAT(select.uses(), ElementsAre(first, second, immediate));
+    EXPECT_THAT(select.defs(), ElementsAre(il::Operand(result)));
+
+    const il::Call call(result, "callee", { a, b, c, d }, std::nullopt);
+    const auto uses = call.uses();
+    EXPECT_EQ(uses.size(), 4u);
+    EXPECT_EQ(uses.front(), first);
+    EXPECT_EQ(uses[3], fourth);
+
+    const il::OperandList copy = uses;
+    EXPECT_THAT(copy, ElementsAre(first, second, third, fourth));
+    EXPECT_TRUE(il::OperandList().empty());
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+
+#include "arkoi_language/il/profile.hpp"
+#include "arkoi_language/utils/driver.hpp"
+
+using namespace arkoi;
+
+/**
+ * @brief Writes the counters like the "_start" routine of an instrumented program does.
+ */
+static std::string write_profile(const std::vector<std::array<uint64_t, 2>>& counters, const size_t truncate = 0) {
+    const auto path = utils::generate_temp_path().string() + ".profile";
+
+    std::ofstream output(path, std::ios::binary);
+    output.write(reinterpret_cast<const char*>(counters.data()),
+                 static_cast<std::streamsize>(counters.size() * sizeof(counters[0]) - truncate));
+
+    return path;
+}
+
+TEST(Profile, KeysTellFunctionsAndLabelsApart) {
+    EXPECT_EQ(il::Profile::key("main", "L1"), il::Profile::key("main", "L1"));
+    EXPECT_NE(il::Profile::key("main", "L1"), il::Profile::key("main", "L2"));
+    EXPECT_NE(il::Profile::key("main", "L1"), il::Profile::key("other", "L1"));
+}
+
+TEST(Profile, LoadsAndSumsCounters) {
+    const auto main_key = il::Profile::key("main", "L0");
+    const auto path = write_profile({ { main_key, 3 }, { il::Profile::key("main", "L1"), 0 }, { main_key, 2 } });
+
+    const auto profile = il::Profile::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_TRUE(profile.has_value());
+    EXPECT_EQ(profile->size(), 2);
+    EXPECT_EQ(profile->count("main", "L0"), 5);
+    EXPECT_EQ(profile->count("main", "L1"), 0);
+    EXPECT_FALSE(profile->count("main", "L2").has_value());
+}
+
+TEST(Profile, RejectsTruncatedProfiles) {
+    const auto path = write_profile({ { il::Profile::key("main", "L0"), 1 } }, 4);
+
+    EXPECT_FALSE(il::Profile::load(path).has_value());
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(il::Profile::load(path).has_value());
+}
+
+TEST(Profile, AnnotatesKnownBlocks) {
+    il::Function function("main", { }, sem::Boolean());
+    auto* hot = function.emplace_back("hot");
+    auto* unknown = function.emplace_back("unknown");
+    function.entry()->set_next(hot);
+    hot->set_next(unknown);
+    unknown->set_next(function.exit());
+
+    il::Profile profile;
+    profile.add(il::Profile::key("main", hot->label()), 42);
+    profile.add(il::Profile::key("other", unknown->label()), 7);
+    profile.annotate(function);
+
+    EXPECT_EQ(hot->count(), 42);
+    EXPECT_FALSE(unknown->count().has_value());
+}
+
+TEST(Profile, ChecksumIgnoresTheOrderOfCounters) {
+    il::Profile first, second, third;
+    first.add(1, 10);
+    first.add(2, 20);
+    second.add(2, 20);
+    second.add(1, 10);
+    third.add(1, 20);
+    third.add(2, 10);
+
+    EXPECT_EQ(first.checksum(), second.checksum());
+    EXPECT_NE(first.checksum(), third.checksum());
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
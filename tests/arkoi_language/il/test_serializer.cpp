@@ -0,0 +1,210 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "arkoi_language/il/cfg_printer.hpp"
+#include "arkoi_language/il/il_printer.hpp"
+#include "arkoi_language/il/serializer.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * select($p.0 @u32) @u32:
+ *     [ entry: c = p == 1, if c ] -> [ then: a = cast p ] -> [ exit: r = phi [ then: a, else: b ], ret r ]
+ *                                 -> [ else: b = select c, 1, p ] ->
+ */
+static void emplace_diamond(il::Module& module, const std::optional<pretty_diagnostics::Span>& span) {
+    const il::Variable parameter("p", TYPE), a("a", TYPE), b("b", TYPE), r("r", TYPE, 3), c("c", sem::Boolean());
+
+    auto& function = module.emplace_back("select", std::vector{ parameter }, TYPE);
+    auto* then_block = function.emplace_back("then");
+    auto* else_block = function.emplace_back("else");
+
+    function.entry()->emplace_back<il::Binary>(c, parameter, il::Binary::Operator::Equal, il::Immediate(1u), TYPE, span);
+    function.entry()->emplace_back<il::If>(c, else_block->label(), then_block->label(), span);
+    function.entry()->set_next(else_block);
+    function.entry()->set_branch(then_block);
+    function.entry()->set_count(42);
+
+    then_block->emplace_back<il::Cast>(a, parameter, sem::Integral(Size::QWORD, true), std::nullopt);
+    then_block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    then_block->set_next(function.exit());
+
+    else_block->emplace_back<il::Select>(b, c, il::Immediate(1u), parameter, std::nullopt);
+    else_block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    else_block->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Phi>(r, il::Phi::Incoming{ { then_block, a }, { else_block, b } }, span);
+    function.exit()->emplace_back<il::Return>(r, std::nullopt);
+}
+
+/**
+ * main() @s32:
+ *     [ entry: slot = alloca, store slot 7, v = load slot, arg v, x = call select, ..., ret -1 ]
+ */
+static void emplace_main(il::Module& module) {
+    const sem::Type type = sem::Integral(Size::DWORD, true);
+    const il::Variable v("v", TYPE), a("a", TYPE), x("x", TYPE), f("f", sem::Floating(Size::QWORD));
+    const il::Memory slot("slot", TYPE);
+
+    auto& function = module.emplace_back("main", std::vector<il::Variable>{ }, type);
+    function.set_exit(function.entry());
+    function.set_memoized(true);
+
+    auto* entry = function.entry();
+    entry->emplace_back<il::Alloca>(slot, std::nullopt);
+    entry->emplace_back<il::Store>(slot, il::Immediate(7u), std::nullopt);
+    entry->emplace_back<il::Load>(v, slot, std::nullopt);
+    entry->emplace_back<il::Argument>(a, v, std::nullopt);
+    entry->emplace_back<il::Call>(
+        x, "select", std::vector<il::Operand>{ a }, std::nullopt, il::Call::Effects::Speculatable
+    );
+
+    const std::vector<il::Immediate> immediates{
+        il::Immediate(UINT64_MAX), il::Immediate(INT64_MIN), il::Immediate(UINT32_MAX), il::Immediate(int32_t{ -5 }),
+        il::Immediate(-0.25), il::Immediate(1.5f), il::Immediate(true),
+    };
+    for (const auto& immediate : immediates) {
+        entry->emplace_back<il::Assign>(il::Variable("i", immediate.type()), immediate, std::nullopt);
+    }
+
+    entry->emplace_back<il::Return>(il::Immediate(int32_t{ -1 }), std::nullopt);
+}
+
+static std::string print(il::Module& module) {
+    std::stringstream output;
+    il::ILPrinter(output).visit(module);
+    il::CFGPrinter(output).visit(module);
+    return output.str();
+}
+
+static std::string serialize(il::Module& module) {
+    std::stringstream output;
+    il::Serializer::write(module, output);
+    return output.str();
+}
+
+TEST(Serializer, RoundTripsThroughItsSerialization) {
+    il::Module module;
+    emplace_diamond(module, std::nullopt);
+    emplace_main(module);
+
+    const auto bytes = serialize(module);
+
+    auto read = il::Serializer::read(bytes);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(print(*read), print(module));
+
+    auto& select = *read->begin();
+    EXPECT_EQ(select.entry()->count(), 42);
+    EXPECT_FALSE(select.is_memoized());
+    EXPECT_EQ(select.exit()->predecessors().size(), 2);
+
+    auto& main = *std::next(read->begin());
+    EXPECT_TRUE(main.is_memoized());
+    EXPECT_EQ(main.entry(), main.exit());
+
+    auto& call = std::get<il::Call>(main.entry()->instructions()[4]);
+    EXPECT_EQ(call.effects(), il::Call::Effects::Speculatable);
+
+    // Writing the read module again results in the same bytes.
+    EXPECT_EQ(serialize(*read), bytes);
+}
+
+TEST(Serializer, RestoresSpansWithTheSource) {
+    const auto path = std::filesystem::temp_directory_path() / "arkoi_serializer.ark";
+    std::ofstream(path) << "fun select(p @u32) @u32:\n    return p\n";
+    const auto source = std::make_shared<pretty_diagnostics::FileSource>(path);
+
+    il::Module module;
+    emplace_diamond(module, pretty_diagnostics::Span(source, 29, 37));
+
+    const auto bytes = serialize(module);
+
+    auto with_source = il::Serializer::read(bytes, source);
+    ASSERT_TRUE(with_source.has_value());
+
+    const auto& binary = with_source->begin()->entry()->instructions().front();
+    ASSERT_TRUE(binary.span().has_value());
+    EXPECT_EQ(binary.span()->substr(), "return p");
+    EXPECT_EQ(binary.span()->start().row(), 1);
+
+    // Without the source the spans are dropped.
+    auto without_source = il::Serializer::read(bytes);
+    ASSERT_TRUE(without_source.has_value());
+    EXPECT_FALSE(without_source->begin()->entry()->instructions().front().span().has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(Serializer, LoadsMappedFiles) {
+    il::Module module;
+    emplace_main(module);
+
+    const auto path = std::filesystem::temp_directory_path() / "arkoi_serializer.il";
+    std::ofstream(path, std::ios::binary) << serialize(module);
+
+    auto loaded = il::Serializer::load(path);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(print(*loaded), print(module));
+
+    std::filesystem::remove(path);
+    EXPECT_FALSE(il::Serializer::load(path).has_value());
+}
+
+TEST(Serializer, RejectsMalformedInput) {
+    il::Module module;
+    emplace_diamond(module, std::nullopt);
+    emplace_main(module);
+
+    const auto bytes = serialize(module);
+
+    // Every truncation is detected, unless it ends right before one of the functions.
+    size_t accepted = 0;
+    for (size_t size = 0; size < bytes.size(); size++) {
+        const auto read = il::Serializer::read(std::string_view(bytes).substr(0, size));
+        accepted += read.has_value();
+    }
+    EXPECT_EQ(accepted, 2);
+
+    auto corrupted = bytes;
+    corrupted[5] = static_cast<char>(il::Serializer::VERSION + 1);
+    EXPECT_FALSE(il::Serializer::read(corrupted).has_value());
+
+    EXPECT_FALSE(il::Serializer::read("ARKOI").has_value());
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,139 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/ssa.hpp"
+
+using namespace arkoi;
+
+/**
+ * main($c.0 @bool) @u32:
+ *     [ entry: alloca x, alloca y, store x 1, store y 1 ]
+ *         -> [ loop: store x 2, a = load x, b = load y, store y a, if c then loop else exit ]
+ *         -> [ exit: ret b ]
+ */
+TEST(SSAPromoter, PrunedPhiPlacement) {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable condition("c", sem::Boolean()), a("a", type), b("b", type);
+    const il::Memory x("x", type), y("y", type);
+
+    il::Function function("main", { condition }, type);
+    auto* loop = function.emplace_back("loop");
+
+    auto* entry = function.entry();
+    entry->emplace_back<il::Alloca>(x, std::nullopt);
+    entry->emplace_back<il::Alloca>(y, std::nullopt);
+    entry->emplace_back<il::Store>(x, il::Immediate(1u), std::nullopt);
+    entry->emplace_back<il::Store>(y, il::Immediate(1u), std::nullopt);
+    entry->emplace_back<il::Goto>(loop->label(), std::nullopt);
+    entry->set_next(loop);
+
+    loop->emplace_back<il::Store>(x, il::Immediate(2u), std::nullopt);
+    loop->emplace_back<il::Load>(a, x, std::nullopt);
+    loop->emplace_back<il::Load>(b, y, std::nullopt);
+    loop->emplace_back<il::Store>(y, a, std::nullopt);
+    loop->emplace_back<il::If>(condition, function.exit()->label(), loop->label(), std::nullopt);
+    loop->set_next(function.exit());
+    loop->set_branch(loop);
+
+    function.exit()->emplace_back<il::Return>(b, std::nullopt);
+
+    il::AnalysisManager analyses;
+    il::SSAPromoter promoter(function, analyses);
+    promoter.promote();
+
+    // The loop header is in the frontier of both definitions, but only y is live there.
+    EXPECT_EQ(promoter.inserted_phis(), 1u);
+
+    auto* phi = std::get_if<il::Phi>(&loop->instructions().front());
+    ASSERT_NE(phi, nullptr);
+    EXPECT_EQ(phi->result().symbol(), y.symbol());
+}
+
+/**
+ * main($c.0 @bool, $p.0 @u32, $q.0 @u32) @u32:
+ *     [ entry ] -> [ loop: x.1 = phi(entry: p, loop: y.1), y.1 = phi(entry: q, loop: x.1), if c then loop else exit ]
+ *               -> [ exit: ret x.1 ]
+ */
+TEST(PhiLowerer, SwapOnCriticalEdge) {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable condition("c", sem::Boolean()), p("p", type), q("q", type), x("x", type, 1), y("y", type, 1);
+
+    il::Function function("main", { condition, p, q }, type);
+    auto* loop = function.emplace_back("loop");
+
+    auto* entry = function.entry();
+    entry->emplace_back<il::Goto>(loop->label(), std::nullopt);
+    entry->set_next(loop);
+
+    loop->emplace_back<il::Phi>(x, il::Phi::Incoming{ { entry, p }, { loop, y } }, std::nullopt);
+    loop->emplace_back<il::Phi>(y, il::Phi::Incoming{ { entry, q }, { loop, x } }, std::nullopt);
+    loop->emplace_back<il::If>(condition, loop->label(), function.exit()->label(), std::nullopt);
+    loop->set_next(loop);
+    loop->set_branch(function.exit());
+
+    function.exit()->emplace_back<il::Return>(x, std::nullopt);
+
+    il::PhiLowerer lowerer(function);
+    lowerer.lower();
+
+    // The back edge leaves a block with two successors, thus the swap runs in a block of its own.
+    EXPECT_EQ(lowerer.split_edges(), 1u);
+    ASSERT_NE(loop->next(), loop);
+    auto* split = loop->next();
+    EXPECT_EQ(split->next(), loop);
+    EXPECT_TRUE(loop->predecessors().contains(split));
+    EXPECT_FALSE(loop->predecessors().contains(loop));
+
+    // Two copies on the entry edge and three on the back edge, as the cycle needs a temporary.
+    EXPECT_EQ(lowerer.copies(), 5u);
+
+    auto& instructions = split->instructions();
+    ASSERT_EQ(instructions.size(), 4u);
+    auto* save = std::get_if<il::Assign>(&instructions[0]);
+    auto* first = std::get_if<il::Assign>(&instructions[1]);
+    auto* second = std::get_if<il::Assign>(&instructions[2]);
+    ASSERT_TRUE(save && first && second);
+
+    // Simulating the copies in order has to swap the values of x and y.
+    std::unordered_map<il::Variable, char> values{ { x, 'x' }, { y, 'y' } };
+    for (auto* copy : { save, first, second }) {
+        values[copy->result()] = values.at(std::get<il::Variable>(copy->value()));
+    }
+    EXPECT_EQ(values.at(x), 'y');
+    EXPECT_EQ(values.at(y), 'x');
+
+    EXPECT_TRUE(std::ranges::none_of(loop->instructions(), [](const il::Instruction& instruction) {
+        return std::holds_alternative<il::Phi>(instruction);
+    }));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
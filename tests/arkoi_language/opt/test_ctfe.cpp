@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/ctfe.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * name($p.0 @u32, $q.0 @u32) @u32:
+ *     [ entry: r = p op q, ret r ]
+ */
+static void emplace_binary(il::Module& module, const std::string& name, const il::Binary::Operator op) {
+    const il::Variable first("p", TYPE), second("q", TYPE), result("r", TYPE);
+
+    auto& function = module.emplace_back(name, std::vector{ first, second }, TYPE);
+    function.set_exit(function.entry());
+    function.entry()->emplace_back<il::Binary>(result, first, op, second, TYPE, std::nullopt);
+    function.entry()->emplace_back<il::Return>(result, std::nullopt);
+}
+
+/**
+ * main() @u32:
+ *     [ entry: arg first[0], arg second[0], x0 = call name[0], ..., ret 0 ]
+ */
+static il::Function& emplace_main(
+    il::Module& module, const std::vector<std::tuple<std::string, uint32_t, il::Operand>>& calls
+) {
+    auto& function = module.emplace_back("main", std::vector<il::Variable>{ }, TYPE);
+    function.set_exit(function.entry());
+
+    for (size_t index = 0; index < calls.size(); index++) {
+        const auto& [name, first_value, second_value] = calls[index];
+
+        const auto suffix = std::to_string(index);
+        const il::Variable first("a" + suffix, TYPE), second("b" + suffix, TYPE), result("x" + suffix, TYPE);
+
+        function.entry()->emplace_back<il::Argument>(first, il::Immediate(first_value), std::nullopt);
+        function.entry()->emplace_back<il::Argument>(second, second_value, std::nullopt);
+        function.entry()->emplace_back<il::Call>(
+            result, name, std::vector<il::Operand>{ first, second }, std::nullopt
+        );
+    }
+
+    function.entry()->emplace_back<il::Return>(il::Immediate(0u), std::nullopt);
+    return function;
+}
+
+TEST(CTFE, EvaluatesCallsWithConstantArguments) {
+    il::Module module;
+    emplace_binary(module, "add", il::Binary::Operator::Add);
+    auto& main = emplace_main(module, { { "add", 7, il::Immediate(3u) }, { "add", 7, il::Immediate(3u) } });
+
+    opt::PassManager manager;
+    manager.add<opt::CTFE>();
+    manager.run(module);
+
+    size_t assigned = 0;
+    for (auto& instruction : *main.entry()) {
+        EXPECT_FALSE(std::holds_alternative<il::Call>(instruction));
+
+        auto* assign = std::get_if<il::Assign>(&instruction);
+        if (!assign) continue;
+
+        EXPECT_EQ(assign->value(), il::Operand(il::Immediate(10u)));
+        assigned++;
+    }
+    EXPECT_EQ(assigned, 2);
+}
+
+TEST(CTFE, KeepsCallsThatCantBeEvaluated) {
+    const il::Variable unknown("u", TYPE);
+
+    il::Module module;
+    emplace_binary(module, "add", il::Binary::Operator::Add);
+    emplace_binary(module, "divide", il::Binary::Operator::Div);
+    auto& main = emplace_main(module, {
+        { "add", 7, unknown },
+        { "divide", 7, il::Immediate(0u) },
+        { "external", 7, il::Immediate(3u) },
+    });
+
+    opt::PassManager manager;
+    manager.add<opt::CTFE>();
+    manager.run(module);
+
+    size_t calls = 0;
+    for (const auto& instruction : *main.entry()) {
+        EXPECT_FALSE(std::holds_alternative<il::Assign>(instruction));
+        calls += std::holds_alternative<il::Call>(instruction);
+    }
+    EXPECT_EQ(calls, 3);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
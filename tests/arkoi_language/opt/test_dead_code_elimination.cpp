@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/dead_code_elimination.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * main($a.0 @u32) @u32:
+ *     [ entry: arg a, x = call f, ret a ]
+ */
+static il::Function create_unused_call(const il::Call::Effects effects) {
+    const il::Variable a("a", TYPE), argument("p", TYPE), x("x", TYPE);
+
+    il::Function function("main", { a }, TYPE);
+    function.set_exit(function.entry());
+    function.entry()->emplace_back<il::Argument>(argument, a, std::nullopt);
+    function.entry()->emplace_back<il::Call>(x, "f", std::vector<il::Operand>{ argument }, std::nullopt, effects);
+    function.entry()->emplace_back<il::Return>(a, std::nullopt);
+
+    return function;
+}
+
+TEST(DeadCodeElimination, RemovesUnusedSpeculatableCalls) {
+    auto function = create_unused_call(il::Call::Effects::Speculatable);
+
+    opt::PassManager manager;
+    manager.add<opt::DeadCodeElimination>();
+    manager.run(function);
+
+    // The argument is only unused once the call is gone.
+    ASSERT_EQ(function.entry()->instructions().size(), 1);
+    EXPECT_TRUE(std::holds_alternative<il::Return>(function.entry()->instructions().front()));
+}
+
+TEST(DeadCodeElimination, KeepsCallsThatMayNotReturn) {
+    for (const auto effects : { il::Call::Effects::Unknown, il::Call::Effects::ReadNone }) {
+        auto function = create_unused_call(effects);
+
+        opt::PassManager manager;
+        manager.add<opt::DeadCodeElimination>();
+        manager.run(function);
+
+        EXPECT_EQ(function.entry()->instructions().size(), 3);
+    }
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "arkoi_language/opt/dead_function_elimination.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * name() @u32:
+ *     [ entry: x = call callee, ret 0 ]
+ */
+static void emplace_caller(il::Module& module, const std::string& name, const std::optional<std::string>& callee) {
+    auto& function = module.emplace_back(name, std::vector<il::Variable>{ }, TYPE);
+    function.set_exit(function.entry());
+
+    if (callee) {
+        const il::Variable result("x", TYPE);
+        function.entry()->emplace_back<il::Call>(result, *callee, std::vector<il::Operand>{ }, std::nullopt);
+    }
+
+    function.entry()->emplace_back<il::Return>(il::Immediate(0u), std::nullopt);
+}
+
+static std::vector<std::string> names(il::Module& module) {
+    std::vector<std::string> names;
+    for (auto& function : module) names.push_back(function.name());
+    std::ranges::sort(names);
+    return names;
+}
+
+TEST(DeadFunctionElimination, RemovesUnreachableFunctions) {
+    // The cycle of "b" and "c" is never entered from "main", thus both are dead even though they are called.
+    il::Module module;
+    emplace_caller(module, "main", "a");
+    emplace_caller(module, "a", std::nullopt);
+    emplace_caller(module, "b", "c");
+    emplace_caller(module, "c", "b");
+
+    opt::PassManager manager;
+    manager.add<opt::DeadFunctionElimination>();
+    manager.run(module);
+
+    EXPECT_EQ(names(module), (std::vector<std::string>{ "a", "main" }));
+}
+
+TEST(DeadFunctionElimination, KeepsExternallyCalledFunctions) {
+    il::Module module;
+    emplace_caller(module, "main", std::nullopt);
+    emplace_caller(module, "a", "b");
+    emplace_caller(module, "b", std::nullopt);
+    emplace_caller(module, "c", std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::DeadFunctionElimination>(std::unordered_map<std::string, size_t>{ { "a", 1 }, { "c", 0 } });
+    manager.run(module);
+
+    EXPECT_EQ(names(module), (std::vector<std::string>{ "a", "b", "main" }));
+}
+
+TEST(DeadFunctionElimination, KeepsModulesWithoutMain) {
+    il::Module module;
+    emplace_caller(module, "a", std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::DeadFunctionElimination>();
+    manager.run(module);
+
+    EXPECT_EQ(names(module), (std::vector<std::string>{ "a" }));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,221 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/dead_code_elimination.hpp"
+#include "arkoi_language/opt/gvn.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+static size_t count_binaries(il::Function& function) {
+    size_t count = 0;
+    for (auto& block : function) {
+        for (auto& instruction : block) count += std::holds_alternative<il::Binary>(instruction);
+    }
+
+    return count;
+}
+
+/**
+ * main($a.0 @u32, $b.0 @u32) @u32:
+ *     [ entry: x = a * b, c = x == 0, if c ] -> [ left: y = b * a ]  -> [ exit: r = phi [ ... ], s = a * b, ret ... ]
+ *                                            -> [ right: z = a - b ] ->
+ */
+static il::Function create_diamond() {
+    const il::Variable a("a", TYPE), b("b", TYPE), x("x", TYPE), y("y", TYPE), z("z", TYPE), w("w", TYPE),
+            r("r", TYPE), s("s", TYPE), t("t", TYPE), c("c", sem::Boolean());
+
+    il::Function function("main", { a, b }, TYPE);
+    auto* left = function.emplace_back("left");
+    auto* right = function.emplace_back("right");
+    auto* exit = function.exit();
+
+    auto* entry = function.entry();
+    entry->emplace_back<il::Binary>(x, a, il::Binary::Operator::Mul, b, TYPE, std::nullopt);
+    entry->emplace_back<il::Binary>(c, x, il::Binary::Operator::Equal, il::Immediate(0u), TYPE, std::nullopt);
+    entry->emplace_back<il::If>(c, right->label(), left->label(), std::nullopt);
+    entry->set_next(right);
+    entry->set_branch(left);
+
+    // Redundant because of the commuted multiplication in the dominating entry.
+    left->emplace_back<il::Binary>(y, b, il::Binary::Operator::Mul, a, TYPE, std::nullopt);
+    left->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    left->set_next(exit);
+
+    // Subtraction isn't commutative, and the result doesn't leave the block.
+    right->emplace_back<il::Binary>(z, a, il::Binary::Operator::Sub, b, TYPE, std::nullopt);
+    right->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    right->set_next(exit);
+
+    exit->emplace_back<il::Phi>(r, il::Phi::Incoming{ { left, y }, { right, z } }, std::nullopt);
+    exit->emplace_back<il::Binary>(w, b, il::Binary::Operator::Sub, a, TYPE, std::nullopt);
+    exit->emplace_back<il::Binary>(s, y, il::Binary::Operator::Add, w, TYPE, std::nullopt);
+    exit->emplace_back<il::Binary>(t, s, il::Binary::Operator::Add, r, TYPE, std::nullopt);
+    exit->emplace_back<il::Return>(t, std::nullopt);
+
+    return function;
+}
+
+TEST(GVN, ReplacesDominatedDuplicates) {
+    auto function = create_diamond();
+
+    opt::PassManager manager;
+    manager.add<opt::GVN>();
+    manager.run(function);
+
+    auto& left = *function.entry()->branch();
+    const auto& redundant = std::get<il::Binary>(left.instructions().front());
+    EXPECT_EQ(redundant.result(), il::Variable("y", TYPE));
+
+    // Only real uses are replaced, the phi keeps reading the duplicate.
+    auto& instructions = function.exit()->instructions();
+    auto& sum = std::get<il::Binary>(instructions[2]);
+    EXPECT_EQ(sum.left(), il::Operand(il::Variable("x", TYPE)));
+
+    auto& difference = std::get<il::Binary>(instructions[1]);
+    EXPECT_EQ(difference.right(), il::Operand(il::Variable("a", TYPE)));
+}
+
+TEST(GVN, KeepsExpressionsOfSiblings) {
+    const il::Variable a("a", TYPE), x("x", TYPE), y("y", TYPE), c("c", sem::Boolean());
+
+    // [ entry: if c ] -> [ left: x = a + 1 ] -> [ exit: ret a ], [ right: y = a + 1 ] -> [ exit ]
+    il::Function function("main", { a, c }, TYPE);
+    auto* left = function.emplace_back("left");
+    auto* right = function.emplace_back("right");
+
+    function.entry()->emplace_back<il::If>(c, right->label(), left->label(), std::nullopt);
+    function.entry()->set_next(right);
+    function.entry()->set_branch(left);
+
+    for (auto [block, result] : { std::pair{ left, x }, std::pair{ right, y } }) {
+        block->emplace_back<il::Binary>(result, a, il::Binary::Operator::Add, il::Immediate(1u), TYPE, std::nullopt);
+        block->emplace_back<il::Argument>(il::Variable("arg", TYPE, result.version()), result, std::nullopt);
+        block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+        block->set_next(function.exit());
+    }
+
+    function.exit()->emplace_back<il::Return>(a, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::GVN>();
+    manager.run(function);
+
+    // Neither block dominates the other, so both computations are needed.
+    auto& argument = std::get<il::Argument>(right->instructions()[1]);
+    EXPECT_EQ(argument.source(), il::Operand(y));
+}
+
+TEST(GVN, LeavesDuplicatesToDeadCodeElimination) {
+    const il::Variable a("a", TYPE), b("b", TYPE), x("x", TYPE), y("y", TYPE), z("z", TYPE), s("s", TYPE);
+
+    // [ entry: x = a * b, y = x, z = b * y, s = a * b + z ] -> [ exit: ret s ]
+    il::Function function("main", { a, b }, TYPE);
+    auto* entry = function.entry();
+    entry->emplace_back<il::Binary>(x, a, il::Binary::Operator::Mul, b, TYPE, std::nullopt);
+    entry->emplace_back<il::Assign>(y, b, std::nullopt);
+    entry->emplace_back<il::Binary>(z, y, il::Binary::Operator::Mul, a, TYPE, std::nullopt);
+    entry->emplace_back<il::Binary>(s, x, il::Binary::Operator::Add, z, TYPE, std::nullopt);
+    entry->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    entry->set_next(function.exit());
+    function.exit()->emplace_back<il::Return>(s, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::GVN>();
+    manager.add<opt::DeadCodeElimination>();
+    manager.run(function);
+
+    // The copy of b gives the second multiplication the same value number as the first one.
+    EXPECT_EQ(count_binaries(function), 2);
+
+    auto& sum = std::get<il::Binary>(entry->instructions()[1]);
+    EXPECT_EQ(sum.left(), il::Operand(x));
+    EXPECT_EQ(sum.right(), il::Operand(x));
+}
+
+/**
+ * main($a.0 @u32) @u32:
+ *     [ entry: arg a, x = call f, arg a, y = call f, s = x + y, ret s ]
+ */
+static il::Function create_repeated_call(const il::Call::Effects effects) {
+    const il::Variable a("a", TYPE), p("p", TYPE), q("q", TYPE), x("x", TYPE), y("y", TYPE), s("s", TYPE);
+
+    il::Function function("main", { a }, TYPE);
+    function.set_exit(function.entry());
+
+    auto* entry = function.entry();
+    entry->emplace_back<il::Argument>(p, a, std::nullopt);
+    entry->emplace_back<il::Call>(x, "f", std::vector<il::Operand>{ p }, std::nullopt, effects);
+    entry->emplace_back<il::Argument>(q, a, std::nullopt);
+    entry->emplace_back<il::Call>(y, "f", std::vector<il::Operand>{ q }, std::nullopt, effects);
+    entry->emplace_back<il::Binary>(s, x, il::Binary::Operator::Add, y, TYPE, std::nullopt);
+    entry->emplace_back<il::Return>(s, std::nullopt);
+
+    return function;
+}
+
+static size_t count_calls(il::Function& function) {
+    size_t count = 0;
+    for (auto& block : function) {
+        for (auto& instruction : block) count += std::holds_alternative<il::Call>(instruction);
+    }
+    return count;
+}
+
+TEST(GVN, MergesCallsWithoutSideEffects) {
+    auto function = create_repeated_call(il::Call::Effects::ReadNone);
+
+    opt::PassManager manager;
+    manager.add<opt::GVN>();
+    manager.add<opt::DeadCodeElimination>();
+    manager.run(function);
+
+    // The first call returned, thus the second one is removed even though the callee may not return.
+    EXPECT_EQ(count_calls(function), 1);
+
+    auto& sum = std::get<il::Binary>(function.entry()->instructions()[2]);
+    EXPECT_EQ(sum.left(), il::Operand(il::Variable("x", TYPE)));
+    EXPECT_EQ(sum.right(), il::Operand(il::Variable("x", TYPE)));
+}
+
+TEST(GVN, KeepsCallsWithSideEffects) {
+    auto function = create_repeated_call(il::Call::Effects::Unknown);
+
+    opt::PassManager manager;
+    manager.add<opt::GVN>();
+    manager.add<opt::DeadCodeElimination>();
+    manager.run(function);
+
+    EXPECT_EQ(count_calls(function), 2);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
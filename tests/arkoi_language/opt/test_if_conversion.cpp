@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/if_conversion.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, true);
+
+/**
+ * pick($a.0 @s32, $b.0 @s32) @s32:
+ *     [ entry: c = a > b, if c ] -> [ then: d = a - b ] -> [ exit: x = phi [ then: d, else: b ], ret x ]
+ *                                -> [ else: e = b ]  ----^
+ */
+static il::Function create_diamond(const bool call) {
+    const il::Variable a("a", TYPE), b("b", TYPE), c("c", sem::Boolean()), d("d", TYPE), e("e", TYPE), x("x", TYPE);
+
+    il::Function function("pick", { a, b }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* then = function.emplace_back("then");
+    auto* otherwise = function.emplace_back("else");
+
+    entry->emplace_back<il::Binary>(c, a, il::Binary::Operator::GreaterThan, b, TYPE, std::nullopt);
+    entry->emplace_back<il::If>(c, otherwise->label(), then->label(), std::nullopt);
+    entry->set_next(otherwise);
+    entry->set_branch(then);
+
+    if (call) {
+        then->emplace_back<il::Call>(d, "pick", std::vector<il::Operand>{ }, std::nullopt);
+    } else {
+        then->emplace_back<il::Binary>(d, a, il::Binary::Operator::Sub, b, TYPE, std::nullopt);
+    }
+    then->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    then->set_next(exit);
+
+    otherwise->emplace_back<il::Assign>(e, b, std::nullopt);
+    otherwise->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    otherwise->set_next(exit);
+
+    exit->emplace_back<il::Phi>(x, il::Phi::Incoming{ { then, d }, { otherwise, e } }, std::nullopt);
+    exit->emplace_back<il::Return>(x, std::nullopt);
+
+    return function;
+}
+
+TEST(IfConversion, ConvertsDiamond) {
+    auto function = create_diamond(false);
+
+    opt::PassManager manager;
+    manager.add<opt::IfConversion>();
+    manager.run(function);
+
+    // Both arms are hoisted into the entry, which now jumps to the join unconditionally.
+    auto* entry = function.entry();
+    EXPECT_EQ(entry->branch(), nullptr);
+    EXPECT_EQ(entry->next(), function.exit());
+    EXPECT_EQ(entry->instructions().size(), 4);
+    EXPECT_TRUE(std::holds_alternative<il::Goto>(entry->instructions().back()));
+
+    auto* select = std::get_if<il::Select>(&function.exit()->instructions().front());
+    ASSERT_NE(select, nullptr);
+    EXPECT_EQ(select->condition(), il::Operand(il::Variable("c", sem::Boolean())));
+    EXPECT_EQ(select->true_value(), il::Operand(il::Variable("d", TYPE)));
+    EXPECT_EQ(select->false_value(), il::Operand(il::Variable("e", TYPE)));
+}
+
+TEST(IfConversion, ConvertsTriangle) {
+    const il::Variable a("a", TYPE), b("b", TYPE), c("c", sem::Boolean()), r("r", TYPE), x("x", TYPE);
+
+    il::Function function("maximum", { a, b }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* then = function.emplace_back("then");
+
+    // The join is reached directly if the condition is false.
+    entry->emplace_back<il::Binary>(c, b, il::Binary::Operator::GreaterThan, a, TYPE, std::nullopt);
+    entry->emplace_back<il::If>(c, exit->label(), then->label(), std::nullopt);
+    entry->set_next(exit);
+    entry->set_branch(then);
+
+    then->emplace_back<il::Assign>(r, b, std::nullopt);
+    then->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    then->set_next(exit);
+
+    exit->emplace_back<il::Phi>(x, il::Phi::Incoming{ { entry, a }, { then, r } }, std::nullopt);
+    exit->emplace_back<il::Return>(x, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::IfConversion>();
+    manager.run(function);
+
+    EXPECT_EQ(exit->predecessors().size(), 1);
+
+    auto* select = std::get_if<il::Select>(&exit->instructions().front());
+    ASSERT_NE(select, nullptr);
+    EXPECT_EQ(select->true_value(), il::Operand(r));
+    EXPECT_EQ(select->false_value(), il::Operand(a));
+}
+
+TEST(IfConversion, KeepsBranchesWithSideEffects) {
+    auto function = create_diamond(true);
+
+    opt::PassManager manager;
+    manager.add<opt::IfConversion>();
+    manager.run(function);
+
+    EXPECT_TRUE(std::holds_alternative<il::If>(function.entry()->instructions().back()));
+    EXPECT_TRUE(std::holds_alternative<il::Phi>(function.exit()->instructions().front()));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
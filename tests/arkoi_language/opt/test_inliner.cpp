@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "arkoi_language/opt/inliner.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * add_one($p.0 @u32) @u32:
+ *     [ entry: r = p + 1, goto exit ] -> [ exit: ret r ]
+ */
+static void emplace_add_one(il::Module& module) {
+    const il::Variable parameter("p", TYPE), result("r", TYPE);
+
+    auto& function = module.emplace_back("add_one", std::vector{ parameter }, TYPE);
+    function.entry()->emplace_back<il::Binary>(
+        result, parameter, il::Binary::Operator::Add, il::Immediate(1u), TYPE, std::nullopt
+    );
+    function.entry()->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    function.entry()->set_next(function.exit());
+    function.exit()->emplace_back<il::Return>(result, std::nullopt);
+}
+
+/**
+ * main() @u32:
+ *     [ entry: arg 41, x = call callee, ret x ]
+ */
+static void emplace_main(il::Module& module, const std::string& callee) {
+    const il::Variable argument("a", TYPE), result("x", TYPE);
+
+    auto& function = module.emplace_back("main", std::vector<il::Variable>{ }, TYPE);
+    function.set_exit(function.entry());
+    function.entry()->emplace_back<il::Argument>(argument, il::Immediate(41u), std::nullopt);
+    function.entry()->emplace_back<il::Call>(result, callee, std::vector<il::Operand>{ argument }, std::nullopt);
+    function.entry()->emplace_back<il::Return>(result, std::nullopt);
+}
+
+static il::Function* find(il::Module& module, const std::string& name) {
+    const auto found = std::ranges::find_if(module, [&](const auto& function) { return function.name() == name; });
+    return found == module.end() ? nullptr : &*found;
+}
+
+TEST(Inliner, InlinesSmallCallees) {
+    il::Module module;
+    emplace_add_one(module);
+    emplace_main(module, "add_one");
+
+    opt::PassManager manager;
+    manager.add<opt::Inliner>();
+    manager.run(module);
+
+    EXPECT_EQ(find(module, "add_one"), nullptr);
+
+    auto* main = find(module, "main");
+    ASSERT_NE(main, nullptr);
+    EXPECT_TRUE(main->is_leaf());
+
+    // The result of the call is assigned in the copy of the callee's exit block, which continues after the call.
+    auto* entry = main->entry();
+    ASSERT_TRUE(std::holds_alternative<il::Goto>(entry->instructions().back()));
+    ASSERT_NE(entry->next(), nullptr);
+
+    auto* exit = entry->next()->next();
+    ASSERT_NE(exit, nullptr);
+    auto& result = std::get<il::Assign>(exit->instructions().front());
+    EXPECT_EQ(result.result(), il::Variable("x", TYPE));
+
+    ASSERT_NE(exit->next(), nullptr);
+    EXPECT_EQ(exit->next(), main->exit());
+    EXPECT_TRUE(std::holds_alternative<il::Return>(main->exit()->instructions().back()));
+}
+
+TEST(Inliner, RenamesLabelsSharedWithTheCaller) {
+    // Both functions number their labels the same, like the IL generator does for every function.
+    const il::Variable parameter("p", TYPE), result("r", TYPE);
+    const il::Variable input("n", TYPE), argument("a", TYPE), call_result("x", TYPE);
+
+    il::Module module;
+    auto& callee = module.emplace_back("add_one", std::vector{ parameter }, TYPE, "L0", "L1");
+    callee.entry()->emplace_back<il::Binary>(
+        result, parameter, il::Binary::Operator::Add, il::Immediate(1u), TYPE, std::nullopt
+    );
+    callee.entry()->emplace_back<il::Goto>(callee.exit()->label(), std::nullopt);
+    callee.entry()->set_next(callee.exit());
+    callee.exit()->emplace_back<il::Return>(result, std::nullopt);
+
+    auto& caller = module.emplace_back("main", std::vector{ input }, TYPE, "L0", "L1");
+    caller.entry()->emplace_back<il::Argument>(argument, input, std::nullopt);
+    caller.entry()->emplace_back<il::Call>(call_result, "add_one", std::vector<il::Operand>{ argument }, std::nullopt);
+    caller.entry()->emplace_back<il::Goto>(caller.exit()->label(), std::nullopt);
+    caller.entry()->set_next(caller.exit());
+    caller.exit()->emplace_back<il::Return>(call_result, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::Inliner>();
+    manager.run(module);
+
+    auto* main = find(module, "main");
+    ASSERT_NE(main, nullptr);
+    EXPECT_TRUE(main->is_leaf());
+
+    // The entry, the exit, the copies of both blocks of the callee and the continuation after the call.
+    EXPECT_EQ(main->block_pool().size(), 5);
+
+    auto* copy = main->entry()->next();
+    ASSERT_NE(copy, nullptr);
+    ASSERT_FALSE(copy->instructions().empty());
+    EXPECT_TRUE(std::holds_alternative<il::Binary>(copy->instructions().front()));
+
+    auto* copied_exit = copy->next();
+    ASSERT_NE(copied_exit, nullptr);
+    EXPECT_EQ(std::get<il::Assign>(copied_exit->instructions().front()).result(), call_result);
+
+    auto* continuation = copied_exit->next();
+    ASSERT_NE(continuation, nullptr);
+    EXPECT_NE(continuation, main->entry());
+    EXPECT_EQ(continuation->next(), main->exit());
+    EXPECT_EQ(std::get<il::Goto>(copied_exit->instructions().back()).label(), continuation->label());
+}
+
+TEST(Inliner, KeepsExpensiveCallees) {
+    il::Module module;
+    emplace_add_one(module);
+    emplace_main(module, "add_one");
+
+    opt::PassManager manager;
+    manager.add<opt::Inliner>(0, 0);
+    manager.run(module);
+
+    EXPECT_NE(find(module, "add_one"), nullptr);
+    EXPECT_FALSE(find(module, "main")->is_leaf());
+}
+
+TEST(Inliner, CountsExternalCalls) {
+    il::Module module;
+    emplace_add_one(module);
+    emplace_main(module, "add_one");
+
+    // The call of main would be the only one, but another one outside of the module rules out the single call case.
+    const std::unordered_map<std::string, size_t> external{ { "add_one", 1 } };
+
+    opt::PassManager manager;
+    manager.add<opt::Inliner>(0, opt::Inliner::DEFAULT_SINGLE_CALL_THRESHOLD, external);
+    manager.run(module);
+
+    EXPECT_NE(find(module, "add_one"), nullptr);
+    EXPECT_FALSE(find(module, "main")->is_leaf());
+}
+
+TEST(Inliner, KeepsExternallyCalledFunctions) {
+    il::Module module;
+    emplace_add_one(module);
+
+    const std::unordered_map<std::string, size_t> external{ { "add_one", 1 } };
+
+    opt::PassManager manager;
+    manager.add<opt::Inliner>(opt::Inliner::DEFAULT_THRESHOLD, opt::Inliner::DEFAULT_SINGLE_CALL_THRESHOLD, external);
+    manager.run(module);
+
+    EXPECT_NE(find(module, "add_one"), nullptr);
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
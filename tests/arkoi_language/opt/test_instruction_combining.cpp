@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "arkoi_language/opt/instruction_combining.hpp"
+
+using namespace arkoi;
+
+static const sem::Type UNSIGNED = sem::Integral(Size::DWORD, false);
+static const sem::Type SIGNED = sem::Integral(Size::DWORD, true);
+
+/**
+ * Runs the pass over a function with a single binary operation `$r = $x <op> right` and returns the entry block.
+ */
+static il::BasicBlock::Instructions combine(const il::Binary::Operator op, const il::Operand& right, const sem::Type& type) {
+    const il::Variable x("x", type), r("r", type);
+
+    il::Function function("main", { x }, type);
+    auto* entry = function.entry();
+    entry->emplace_back<il::Binary>(r, x, op, right, type, std::nullopt);
+    entry->emplace_back<il::Return>(r, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::InstructionCombining>();
+    manager.run(function);
+
+    return entry->instructions();
+}
+
+static std::ptrdiff_t count_divisions(const il::BasicBlock::Instructions& instructions) {
+    return std::ranges::count_if(instructions, [](const auto& instruction) {
+        const auto* binary = std::get_if<il::Binary>(&instruction);
+        return binary && binary->op() == il::Binary::Operator::Div;
+    });
+}
+
+TEST(InstructionCombining, AppliesIdentities) {
+    const il::Variable x("x", UNSIGNED);
+
+    auto instructions = combine(il::Binary::Operator::Mul, il::Immediate(1u), UNSIGNED);
+    EXPECT_EQ(std::get<il::Assign>(instructions.front()).value(), il::Operand(x));
+
+    instructions = combine(il::Binary::Operator::Mul, il::Immediate(0u), UNSIGNED);
+    EXPECT_EQ(std::get<il::Assign>(instructions.front()).value(), il::Operand(il::Immediate(0u)));
+
+    instructions = combine(il::Binary::Operator::Sub, x, UNSIGNED);
+    EXPECT_EQ(std::get<il::Assign>(instructions.front()).value(), il::Operand(il::Immediate(0u)));
+}
+
+TEST(InstructionCombining, KeepsFloatingSelfSubtraction) {
+    const sem::Type type = sem::Floating(Size::QWORD);
+
+    auto instructions = combine(il::Binary::Operator::Sub, il::Variable("x", type), type);
+    EXPECT_TRUE(std::holds_alternative<il::Binary>(instructions.front()));
+}
+
+TEST(InstructionCombining, ShiftsPowersOfTwo) {
+    auto instructions = combine(il::Binary::Operator::Mul, il::Immediate(8u), UNSIGNED);
+    auto& multiply = std::get<il::Binary>(instructions.front());
+    EXPECT_EQ(multiply.op(), il::Binary::Operator::Shl);
+    EXPECT_EQ(multiply.right(), il::Operand(il::Immediate(3u)));
+
+    instructions = combine(il::Binary::Operator::Div, il::Immediate(16u), UNSIGNED);
+    auto& divide = std::get<il::Binary>(instructions.front());
+    EXPECT_EQ(divide.op(), il::Binary::Operator::Shr);
+    EXPECT_EQ(divide.right(), il::Operand(il::Immediate(4u)));
+}
+
+TEST(InstructionCombining, RoundsSignedDivisionsTowardsZero) {
+    const auto instructions = combine(il::Binary::Operator::Div, il::Immediate(4), SIGNED);
+    EXPECT_EQ(count_divisions(instructions), 0);
+
+    // The last shift before the return must produce the original result.
+    const auto& shift = std::get<il::Binary>(instructions[instructions.size() - 2]);
+    EXPECT_EQ(shift.op(), il::Binary::Operator::Shr);
+    EXPECT_EQ(shift.result(), il::Variable("r", SIGNED));
+    EXPECT_EQ(shift.op_type(), SIGNED);
+}
+
+TEST(InstructionCombining, MultipliesWithMagicNumber) {
+    auto instructions = combine(il::Binary::Operator::Div, il::Immediate(10u), UNSIGNED);
+    EXPECT_EQ(count_divisions(instructions), 0);
+    EXPECT_EQ(std::get<il::Cast>(instructions[instructions.size() - 2]).result(), il::Variable("r", UNSIGNED));
+
+    // Signed divisions by other constants are left to the backend.
+    instructions = combine(il::Binary::Operator::Div, il::Immediate(10), SIGNED);
+    EXPECT_EQ(count_divisions(instructions), 1);
+}
+
+TEST(InstructionCombining, LooksThroughBooleanCasts) {
+    const il::Variable b("b", sem::Boolean()), i("i", SIGNED), c("c", sem::Boolean()), n("n", sem::Boolean());
+    const il::Variable w("w", sem::Integral(Size::QWORD, true)), s("s", SIGNED), x("x", SIGNED);
+
+    // main(b @bool, x @s32) @bool: [ entry: i = cast b, c = cast i, n = i == 0, w = cast x, s = cast w, ret c ]
+    il::Function function("main", { b, x }, sem::Boolean());
+    auto* entry = function.entry();
+    entry->emplace_back<il::Cast>(i, b, sem::Boolean(), std::nullopt);
+    entry->emplace_back<il::Cast>(c, i, SIGNED, std::nullopt);
+    entry->emplace_back<il::Binary>(n, i, il::Binary::Operator::Equal, il::Immediate(0), SIGNED, std::nullopt);
+    entry->emplace_back<il::Cast>(w, x, SIGNED, std::nullopt);
+    entry->emplace_back<il::Cast>(s, w, w.type(), std::nullopt);
+    entry->emplace_back<il::Return>(c, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::InstructionCombining>();
+    manager.run(function);
+
+    // The round trip through the integer is a copy, its comparison with zero inverts the boolean itself.
+    auto& instructions = entry->instructions();
+    EXPECT_EQ(std::get<il::Assign>(instructions[1]).value(), il::Operand(b));
+
+    auto& inverted = std::get<il::Binary>(instructions[2]);
+    EXPECT_EQ(inverted.left(), il::Operand(b));
+    EXPECT_EQ(inverted.right(), il::Operand(il::Immediate(false)));
+    EXPECT_TRUE(inverted.op_type().is_boolean());
+
+    // Narrowing back after widening restores the integer.
+    EXPECT_EQ(std::get<il::Assign>(instructions[4]).value(), il::Operand(x));
+}
+
+TEST(InstructionCombining, KeepsLossyCasts) {
+    const sem::Type DOUBLE = sem::Floating(Size::QWORD);
+    const il::Variable x("x", DOUBLE), f("f", sem::Floating(Size::DWORD)), r("r", DOUBLE);
+
+    // Rounding to single precision loses bits, which converting back doesn't restore.
+    il::Function function("main", { x }, DOUBLE);
+    auto* entry = function.entry();
+    entry->emplace_back<il::Cast>(f, x, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Cast>(r, f, f.type(), std::nullopt);
+    entry->emplace_back<il::Return>(r, std::nullopt);
+
+    opt::PassManager manager;
+    manager.add<opt::InstructionCombining>();
+    manager.run(function);
+
+    EXPECT_TRUE(std::holds_alternative<il::Cast>(entry->instructions()[1]));
+}
+
+TEST(InstructionCombining, SimplifiesBooleanComparisons) {
+    const il::Variable x("x", sem::Boolean());
+
+    auto instructions = combine(il::Binary::Operator::Equal, il::Immediate(true), sem::Boolean());
+    EXPECT_EQ(std::get<il::Assign>(instructions.front()).value(), il::Operand(x));
+
+    instructions = combine(il::Binary::Operator::NotEqual, il::Immediate(true), sem::Boolean());
+    auto& inverted = std::get<il::Binary>(instructions.front());
+    EXPECT_EQ(inverted.op(), il::Binary::Operator::Equal);
+    EXPECT_EQ(inverted.right(), il::Operand(il::Immediate(false)));
+
+    // The comparison with false is the canonical form and stays.
+    instructions = combine(il::Binary::Operator::Equal, il::Immediate(false), sem::Boolean());
+    EXPECT_TRUE(std::holds_alternative<il::Binary>(instructions.front()));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
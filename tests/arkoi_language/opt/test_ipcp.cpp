@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "arkoi_language/opt/ipcp.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * add($p.0 @u32, $q.0 @u32) @u32:
+ *     [ entry: r = p + q, ret r ]
+ */
+static void emplace_add(il::Module& module) {
+    const il::Variable first("p", TYPE), second("q", TYPE), result("r", TYPE);
+
+    auto& function = module.emplace_back("add", std::vector{ first, second }, TYPE);
+    function.set_exit(function.entry());
+    function.entry()->emplace_back<il::Binary>(
+        result, first, il::Binary::Operator::Add, second, TYPE, std::nullopt
+    );
+    function.entry()->emplace_back<il::Return>(result, std::nullopt);
+}
+
+/**
+ * main() @u32:
+ *     [ entry: arg first[0], arg second[0], x0 = call add, ..., ret 0 ]
+ */
+static void emplace_main(il::Module& module, const std::vector<std::pair<uint32_t, il::Operand>>& calls) {
+    auto& function = module.emplace_back("main", std::vector<il::Variable>{ }, TYPE);
+    function.set_exit(function.entry());
+
+    for (size_t index = 0; index < calls.size(); index++) {
+        const auto suffix = std::to_string(index);
+        const il::Variable first("a" + suffix, TYPE), second("b" + suffix, TYPE), result("x" + suffix, TYPE);
+
+        function.entry()->emplace_back<il::Argument>(first, il::Immediate(calls[index].first), std::nullopt);
+        function.entry()->emplace_back<il::Argument>(second, calls[index].second, std::nullopt);
+        function.entry()->emplace_back<il::Call>(
+            result, "add", std::vector<il::Operand>{ first, second }, std::nullopt
+        );
+    }
+
+    function.entry()->emplace_back<il::Return>(il::Immediate(0u), std::nullopt);
+}
+
+static il::Function* find(il::Module& module, const std::string& name) {
+    const auto found = std::ranges::find_if(module, [&](const auto& function) { return function.name() == name; });
+    return found == module.end() ? nullptr : &*found;
+}
+
+static std::vector<il::Call> calls(il::Function& function) {
+    std::vector<il::Call> calls;
+    for (const auto& instruction : *function.entry()) {
+        if (const auto* call = std::get_if<il::Call>(&instruction)) calls.push_back(*call);
+    }
+    return calls;
+}
+
+TEST(IPCP, PropagatesArgumentsEqualAtAllCalls) {
+    const il::Variable unknown("u", TYPE);
+
+    il::Module module;
+    emplace_add(module);
+    emplace_main(module, { { 7, unknown }, { 7, il::Immediate(3u) } });
+
+    opt::PassManager manager;
+    manager.add<opt::IPCP>();
+    manager.run(module);
+
+    auto* add = find(module, "add");
+    ASSERT_NE(add, nullptr);
+    ASSERT_EQ(add->parameters().size(), 1);
+    EXPECT_EQ(add->parameters().front(), il::Variable("q", TYPE));
+
+    auto& assign = std::get<il::Assign>(add->entry()->instructions().front());
+    EXPECT_EQ(assign.result(), il::Variable("p", TYPE));
+    EXPECT_EQ(assign.value(), il::Operand(il::Immediate(7u)));
+
+    // Only the arguments which are still passed are left in front of the calls.
+    auto* main = find(module, "main");
+    for (auto& call : calls(*main)) EXPECT_EQ(call.arguments().size(), 1);
+    EXPECT_EQ(std::ranges::count_if(*main->entry(), [](const auto& instruction) {
+        return std::holds_alternative<il::Argument>(instruction);
+    }), 2);
+}
+
+TEST(IPCP, SpecializesCommonArguments) {
+    const il::Variable unknown("u", TYPE);
+
+    il::Module module;
+    emplace_add(module);
+    emplace_main(module, { { 1, unknown }, { 2, unknown }, { 1, unknown } });
+
+    opt::PassManager manager;
+    manager.add<opt::IPCP>();
+    manager.run(module);
+
+    // The two calls passing 1 are redirected to the copy, which leaves the remaining call to propagate its 2.
+    auto* specialized = find(module, "add.specialized0");
+    ASSERT_NE(specialized, nullptr);
+    ASSERT_EQ(specialized->parameters().size(), 1);
+    EXPECT_EQ(std::get<il::Assign>(specialized->entry()->instructions().front()).value(), il::Operand(il::Immediate(1u)));
+
+    auto* add = find(module, "add");
+    ASSERT_NE(add, nullptr);
+    ASSERT_EQ(add->parameters().size(), 1);
+    EXPECT_EQ(std::get<il::Assign>(add->entry()->instructions().front()).value(), il::Operand(il::Immediate(2u)));
+
+    std::vector<std::string> callees;
+    for (auto& call : calls(*find(module, "main"))) callees.push_back(call.name());
+    EXPECT_EQ(callees, (std::vector<std::string>{ "add.specialized0", "add", "add.specialized0" }));
+}
+
+TEST(IPCP, KeepsExternallyCalledFunctions) {
+    il::Module module;
+    emplace_add(module);
+    emplace_main(module, { { 7, il::Immediate(3u) } });
+
+    opt::PassManager manager;
+    manager.add<opt::IPCP>(std::unordered_map<std::string, size_t>{ { "add", 1 } });
+    manager.run(module);
+
+    EXPECT_EQ(find(module, "add")->parameters().size(), 2);
+    EXPECT_EQ(calls(*find(module, "main")).front().arguments().size(), 2);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/licm.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * nested($n.0 @u32, $a.0 @u32, $b.0 @u32) @u32:
+ *     [ entry: if n != 0 ] -> [ outer: i = phi [ ... ] ] -> [ inner: m = a * b, d = n / a, if j != 0 ] -> [ latch ]
+ *                          -> [ exit: ret n ]                 ^---------------------------------------'
+ */
+static il::Function create_nested() {
+    const il::Variable n("n", TYPE), a("a", TYPE), b("b", TYPE), i("i", TYPE), i2("i2", TYPE), j("j", TYPE),
+            j2("j2", TYPE), m("m", TYPE), d("d", TYPE), c0("c0", sem::Boolean()), c1("c1", sem::Boolean()),
+            c2("c2", sem::Boolean());
+
+    il::Function function("nested", { n, a, b }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* outer = function.emplace_back("outer");
+    auto* inner = function.emplace_back("inner");
+    auto* latch = function.emplace_back("latch");
+
+    entry->emplace_back<il::Binary>(c0, n, il::Binary::Operator::NotEqual, il::Immediate(0u), TYPE, std::nullopt);
+    entry->emplace_back<il::If>(c0, exit->label(), outer->label(), std::nullopt);
+    entry->set_next(exit);
+    entry->set_branch(outer);
+
+    outer->emplace_back<il::Phi>(i, il::Phi::Incoming{ { entry, n }, { latch, i2 } }, std::nullopt);
+    outer->emplace_back<il::Goto>(inner->label(), std::nullopt);
+    outer->set_next(inner);
+
+    inner->emplace_back<il::Phi>(j, il::Phi::Incoming{ { outer, i }, { inner, j2 } }, std::nullopt);
+    inner->emplace_back<il::Binary>(m, a, il::Binary::Operator::Mul, b, TYPE, std::nullopt);
+    inner->emplace_back<il::Binary>(d, n, il::Binary::Operator::Div, a, TYPE, std::nullopt);
+    inner->emplace_back<il::Binary>(j2, j, il::Binary::Operator::Sub, il::Immediate(1u), TYPE, std::nullopt);
+    inner->emplace_back<il::Binary>(c1, j2, il::Binary::Operator::NotEqual, il::Immediate(0u), TYPE, std::nullopt);
+    inner->emplace_back<il::If>(c1, latch->label(), inner->label(), std::nullopt);
+    inner->set_next(latch);
+    inner->set_branch(inner);
+
+    latch->emplace_back<il::Binary>(i2, i, il::Binary::Operator::Sub, il::Immediate(1u), TYPE, std::nullopt);
+    latch->emplace_back<il::Binary>(c2, i2, il::Binary::Operator::NotEqual, il::Immediate(0u), TYPE, std::nullopt);
+    latch->emplace_back<il::If>(c2, exit->label(), outer->label(), std::nullopt);
+    latch->set_next(exit);
+    latch->set_branch(outer);
+
+    exit->emplace_back<il::Return>(n, std::nullopt);
+
+    return function;
+}
+
+static il::BasicBlock* find_block(il::Function& function, const std::string& label) {
+    for (auto& block : function) {
+        if (block.label() == label) return &block;
+    }
+
+    return nullptr;
+}
+
+static bool contains_mul(il::BasicBlock& block) {
+    for (auto& instruction : block) {
+        const auto* binary = std::get_if<il::Binary>(&instruction);
+        if (binary && binary->op() == il::Binary::Operator::Mul) return true;
+    }
+
+    return false;
+}
+
+TEST(LoopAnalysis, FindsNestedLoops) {
+    auto function = create_nested();
+    auto* outer = find_block(function, "outer");
+    auto* inner = find_block(function, "inner");
+    auto* latch = find_block(function, "latch");
+
+    const il::LoopAnalysis analysis(function);
+    ASSERT_EQ(analysis.loops().size(), 2);
+
+    // Inner loops come first.
+    auto& inner_loop = *analysis.loops()[0];
+    EXPECT_EQ(inner_loop.header, inner);
+    EXPECT_EQ(inner_loop.latches, std::vector{ inner });
+    EXPECT_EQ(inner_loop.depth, 2);
+
+    auto& outer_loop = *analysis.loops()[1];
+    EXPECT_EQ(outer_loop.header, outer);
+    EXPECT_EQ(outer_loop.latches, std::vector{ latch });
+    EXPECT_EQ(outer_loop.blocks.size(), 3);
+    EXPECT_EQ(outer_loop.parent, nullptr);
+    EXPECT_EQ(outer_loop.depth, 1);
+    EXPECT_EQ(inner_loop.parent, &outer_loop);
+
+    EXPECT_EQ(analysis.loop(inner), &inner_loop);
+    EXPECT_EQ(analysis.loop(latch), &outer_loop);
+    EXPECT_EQ(analysis.loop(function.entry()), nullptr);
+    EXPECT_EQ(analysis.depth(function.exit()), 0);
+}
+
+TEST(LICM, HoistsOutOfAllLoops) {
+    auto function = create_nested();
+
+    opt::PassManager manager;
+    manager.add<opt::LICM>();
+    manager.run(function);
+
+    // The entry also leaves to the exit, so a preheader is inserted in front of the outer loop.
+    auto* preheader = find_block(function, "outer.pre");
+    ASSERT_NE(preheader, nullptr);
+    EXPECT_EQ(function.entry()->branch(), preheader);
+    EXPECT_EQ(preheader->next(), find_block(function, "outer"));
+    EXPECT_TRUE(std::holds_alternative<il::Goto>(preheader->instructions().back()));
+
+    auto& phi = std::get<il::Phi>(find_block(function, "outer")->instructions().front());
+    EXPECT_NE(phi.incoming_from(preheader), nullptr);
+    EXPECT_EQ(phi.incoming_from(function.entry()), nullptr);
+
+    EXPECT_TRUE(contains_mul(*preheader));
+    EXPECT_FALSE(contains_mul(*find_block(function, "outer")));
+    EXPECT_FALSE(contains_mul(*find_block(function, "inner")));
+}
+
+TEST(LICM, KeepsTrappingDivisions) {
+    auto function = create_nested();
+
+    opt::PassManager manager;
+    manager.add<opt::LICM>();
+    manager.run(function);
+
+    // The divisor could be zero, which must only trap if the loop body is actually executed.
+    auto* inner = find_block(function, "inner");
+    const auto is_div = [](auto& instruction) {
+        const auto* binary = std::get_if<il::Binary>(&instruction);
+        return binary && binary->op() == il::Binary::Operator::Div;
+    };
+    EXPECT_TRUE(std::ranges::any_of(inner->instructions(), is_div));
+}
+
+TEST(LICM, HoistsSpeculatableCalls) {
+    for (const auto effects : { il::Call::Effects::Speculatable, il::Call::Effects::ReadNone }) {
+        auto function = create_nested();
+        const il::Variable a("a", TYPE), p("p", TYPE), x("x", TYPE);
+
+        // inner: [ j = phi, arg a, x = call f, ... ]
+        auto& instructions = find_block(function, "inner")->instructions();
+        instructions.insert(instructions.begin() + 1, il::Argument(p, a, std::nullopt));
+        instructions.insert(
+            instructions.begin() + 2, il::Call(x, "f", std::vector<il::Operand>{ p }, std::nullopt, effects)
+        );
+
+        opt::PassManager manager;
+        manager.add<opt::LICM>();
+        manager.run(function);
+
+        const auto is_call = [](auto& instruction) { return std::holds_alternative<il::Call>(instruction); };
+        auto& preheader = find_block(function, "outer.pre")->instructions();
+        auto& inner = find_block(function, "inner")->instructions();
+
+        // A call that may not return must only run if the loop body does.
+        if (effects == il::Call::Effects::ReadNone) {
+            EXPECT_TRUE(std::ranges::any_of(inner, is_call));
+            continue;
+        }
+
+        EXPECT_FALSE(std::ranges::any_of(inner, is_call));
+
+        // The argument is still passed right in front of the call.
+        const auto call = std::ranges::find_if(preheader, is_call);
+        ASSERT_NE(call, preheader.end());
+        ASSERT_NE(call, preheader.begin());
+        EXPECT_TRUE(std::holds_alternative<il::Argument>(*std::prev(call)));
+    }
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/loop_strength_reduction.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+struct Exit {
+    il::Binary::Operator comparison;
+    il::Operand bound;
+    bool swapped;
+    bool on_true;
+};
+
+/**
+ * counter($n.0 @u32) @u32:
+ *     [ entry: i0 = 0 ] -> [ header: i = phi [ ... ], c = i < bound, if c ] -> [ body: m = i * 12, s = i << 2, ... ]
+ *                          -> [ exit: ret i ]                         ^---------------------------------------'
+ */
+static il::Function create_counter(const Exit& exit_condition, const uint32_t step) {
+    const il::Variable n("n", TYPE), i0("i0", TYPE), i("i", TYPE), i1("i1", TYPE), i2("i2", TYPE), m("m", TYPE),
+            s("s", TYPE), t("t", TYPE), c("c", sem::Boolean());
+
+    il::Function function("counter", { n }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* header = function.emplace_back("header");
+    auto* body = function.emplace_back("body");
+
+    entry->emplace_back<il::Assign>(i0, il::Immediate(0u), std::nullopt);
+    entry->emplace_back<il::Goto>(header->label(), std::nullopt);
+    entry->set_next(header);
+
+    const auto& [comparison, bound, swapped, on_true] = exit_condition;
+    header->emplace_back<il::Phi>(i, il::Phi::Incoming{ { entry, i0 }, { body, i2 } }, std::nullopt);
+    if (swapped) {
+        header->emplace_back<il::Binary>(c, bound, comparison, i, TYPE, std::nullopt);
+    } else {
+        header->emplace_back<il::Binary>(c, i, comparison, bound, TYPE, std::nullopt);
+    }
+
+    if (on_true) {
+        header->emplace_back<il::If>(c, body->label(), exit->label(), std::nullopt);
+        header->set_next(body);
+        header->set_branch(exit);
+    } else {
+        header->emplace_back<il::If>(c, exit->label(), body->label(), std::nullopt);
+        header->set_next(exit);
+        header->set_branch(body);
+    }
+
+    body->emplace_back<il::Binary>(m, i, il::Binary::Operator::Mul, il::Immediate(12u), TYPE, std::nullopt);
+    body->emplace_back<il::Binary>(s, i, il::Binary::Operator::Shl, il::Immediate(2u), TYPE, std::nullopt);
+    body->emplace_back<il::Binary>(t, m, il::Binary::Operator::Add, s, TYPE, std::nullopt);
+    body->emplace_back<il::Binary>(i1, i, il::Binary::Operator::Add, il::Immediate(step), TYPE, std::nullopt);
+    body->emplace_back<il::Assign>(i2, i1, std::nullopt);
+    body->emplace_back<il::Goto>(header->label(), std::nullopt);
+    body->set_next(header);
+
+    exit->emplace_back<il::Return>(t, std::nullopt);
+
+    return function;
+}
+
+TEST(InductionAnalysis, FindsCountedLoop) {
+    auto function = create_counter({ il::Binary::Operator::LessThan, il::Immediate(10u), false, false }, 3);
+
+    const il::InductionAnalysis analysis(function);
+    ASSERT_EQ(analysis.loops().loops().size(), 1);
+    const auto& loop = *analysis.loops().loops().front();
+
+    // The copy of the increment is looked through.
+    ASSERT_EQ(analysis.inductions(loop).size(), 1);
+    const auto& induction = analysis.inductions(loop).front();
+    EXPECT_EQ(induction.variable, il::Variable("i", TYPE));
+    EXPECT_EQ(induction.update, il::Variable("i1", TYPE));
+    EXPECT_EQ(induction.initial, il::Operand(il::Immediate(0u)));
+    EXPECT_EQ(induction.step, 3);
+
+    const auto* counted = analysis.counted(loop);
+    ASSERT_NE(counted, nullptr);
+    EXPECT_EQ(counted->comparison, il::Binary::Operator::LessThan);
+    EXPECT_EQ(counted->trip_count, 4);
+}
+
+TEST(InductionAnalysis, NormalizesExitCondition) {
+    // Leaving once 10 <= i holds is the same as staying while i < 10.
+    auto function = create_counter({ il::Binary::Operator::LessEqual, il::Immediate(10u), true, true }, 1);
+
+    const il::InductionAnalysis analysis(function);
+    const auto* counted = analysis.counted(*analysis.loops().loops().front());
+    ASSERT_NE(counted, nullptr);
+    EXPECT_EQ(counted->comparison, il::Binary::Operator::LessThan);
+    EXPECT_EQ(counted->bound, il::Operand(il::Immediate(10u)));
+    EXPECT_EQ(counted->trip_count, 10);
+}
+
+TEST(InductionAnalysis, RejectsUnknownTripCounts) {
+    auto unbounded = create_counter({ il::Binary::Operator::LessThan, il::Variable("n", TYPE), false, false }, 1);
+
+    const il::InductionAnalysis variable(unbounded);
+    const auto* counted = variable.counted(*variable.loops().loops().front());
+    ASSERT_NE(counted, nullptr);
+    EXPECT_EQ(counted->trip_count, std::nullopt);
+
+    // The induction variable wraps around before it could exceed the maximum.
+    auto overflowing = create_counter({ il::Binary::Operator::LessEqual, il::Immediate(4294967295u), false, false }, 1);
+
+    const il::InductionAnalysis wrapping(overflowing);
+    counted = wrapping.counted(*wrapping.loops().loops().front());
+    ASSERT_NE(counted, nullptr);
+    EXPECT_EQ(counted->trip_count, std::nullopt);
+}
+
+TEST(LoopStrengthReduction, ReplacesMultiplications) {
+    auto function = create_counter({ il::Binary::Operator::LessThan, il::Variable("n", TYPE), false, false }, 3);
+
+    opt::PassManager manager;
+    manager.add<opt::LoopStrengthReduction>();
+    manager.run(function);
+
+    auto& header = *function.entry()->next();
+    auto& body = *header.branch();
+
+    // Both the multiplication and the shift become copies of new induction variables.
+    EXPECT_TRUE(std::holds_alternative<il::Assign>(body.instructions()[0]));
+    EXPECT_TRUE(std::holds_alternative<il::Assign>(body.instructions()[1]));
+
+    size_t phis = 0;
+    for (auto& instruction : header) phis += std::holds_alternative<il::Phi>(instruction);
+    EXPECT_EQ(phis, 3);
+
+    // The product is incremented by step * factor right after the original increment.
+    auto& increment = std::get<il::Binary>(body.instructions()[4]);
+    EXPECT_EQ(increment.op(), il::Binary::Operator::Add);
+    EXPECT_TRUE(increment.right() == il::Operand(il::Immediate(12u)) || increment.right() == il::Operand(il::Immediate(36u)));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,138 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "arkoi_language/il/analyses.hpp"
+#include "arkoi_language/opt/loop_unroll.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * sum($n.0 @u32) @u32:
+ *     [ entry: i0 = 0, s0 = 0 ] -> [ header: i, s = phi [ ... ], c = i < bound, if c ] -> [ body: s1 = s + i, i1 = i + 1 ]
+ *                                  -> [ exit: ret s ]                                ^----------------------------------'
+ */
+static il::Function create_sum(const il::Operand& bound) {
+    const il::Variable n("n", TYPE), i0("i0", TYPE), i("i", TYPE), i1("i1", TYPE), s0("s0", TYPE), s("s", TYPE),
+            s1("s1", TYPE), c("c", sem::Boolean());
+
+    il::Function function("sum", { n }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* header = function.emplace_back("header");
+    auto* body = function.emplace_back("body");
+
+    entry->emplace_back<il::Assign>(i0, il::Immediate(0u), std::nullopt);
+    entry->emplace_back<il::Assign>(s0, il::Immediate(0u), std::nullopt);
+    entry->emplace_back<il::Goto>(header->label(), std::nullopt);
+    entry->set_next(header);
+
+    header->emplace_back<il::Phi>(i, il::Phi::Incoming{ { entry, i0 }, { body, i1 } }, std::nullopt);
+    header->emplace_back<il::Phi>(s, il::Phi::Incoming{ { entry, s0 }, { body, s1 } }, std::nullopt);
+    header->emplace_back<il::Binary>(c, i, il::Binary::Operator::LessThan, bound, TYPE, std::nullopt);
+    header->emplace_back<il::If>(c, exit->label(), body->label(), std::nullopt);
+    header->set_next(exit);
+    header->set_branch(body);
+
+    body->emplace_back<il::Binary>(s1, s, il::Binary::Operator::Add, i, TYPE, std::nullopt);
+    body->emplace_back<il::Binary>(i1, i, il::Binary::Operator::Add, il::Immediate(1u), TYPE, std::nullopt);
+    body->emplace_back<il::Goto>(header->label(), std::nullopt);
+    body->set_next(header);
+
+    exit->emplace_back<il::Return>(s, std::nullopt);
+
+    return function;
+}
+
+static size_t count_blocks(il::Function& function) {
+    size_t blocks = 0;
+    for ([[maybe_unused]] auto& block : function) blocks++;
+    return blocks;
+}
+
+TEST(LoopUnroll, UnrollsTinyLoopsFully) {
+    auto function = create_sum(il::Immediate(4u));
+
+    opt::PassManager manager;
+    manager.add<opt::LoopUnroll>();
+    manager.run(function);
+
+    const il::LoopAnalysis loops(function);
+    EXPECT_TRUE(loops.loops().empty());
+
+    // The header only remains to leave the loop, its phis are now copies of the last iteration.
+    auto& header = *function.entry()->next();
+    for (auto& instruction : header) {
+        EXPECT_FALSE(std::holds_alternative<il::Phi>(instruction));
+    }
+
+    // One copy of the header and the body for each of the four iterations.
+    EXPECT_EQ(count_blocks(function), 3 + 4 * 2);
+}
+
+TEST(LoopUnroll, UnrollsLargerLoopsPartially) {
+    auto function = create_sum(il::Immediate(64u));
+
+    opt::PassManager manager;
+    manager.add<opt::LoopUnroll>();
+    manager.run(function);
+
+    const il::LoopAnalysis loops(function);
+    ASSERT_EQ(loops.loops().size(), 1);
+
+    // The body is copied three times, each copy with the header test that precedes it.
+    const auto& loop = *loops.loops().front();
+    EXPECT_EQ(loop.blocks.size(), 2 + 3 * 2);
+
+    // The back edge now starts at the last copy of the latch.
+    auto& header = *function.entry()->next();
+    auto& phi = std::get<il::Phi>(header.instructions().front());
+    const auto& incoming = phi.incoming();
+    ASSERT_EQ(incoming.size(), 2);
+    EXPECT_TRUE(std::ranges::any_of(incoming, [](const auto& entry) {
+        return entry.first->label().find(".u2") != std::string::npos;
+    }));
+}
+
+TEST(LoopUnroll, KeepsLoopsWithUnknownTripCounts) {
+    auto function = create_sum(il::Variable("n", TYPE));
+
+    opt::PassManager manager;
+    manager.add<opt::LoopUnroll>();
+    manager.run(function);
+
+    EXPECT_EQ(count_blocks(function), 4);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
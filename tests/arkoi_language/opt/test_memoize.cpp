@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/memoize.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * name($p.0 @type, ...) @u32:
+ *     [ entry: arg 1, x0 = call callees[0], ..., ret 1 ]
+ */
+static void emplace_function(
+    il::Module& module, const std::string& name, const std::vector<std::string>& callees,
+    const std::vector<il::Variable>& parameters = { il::Variable("p", TYPE) }
+) {
+    auto& function = module.emplace_back(name, parameters, TYPE);
+    function.set_exit(function.entry());
+
+    for (size_t index = 0; index < callees.size(); index++) {
+        const il::Variable argument("a" + std::to_string(index), TYPE), result("x" + std::to_string(index), TYPE);
+        function.entry()->emplace_back<il::Argument>(argument, il::Immediate(1u), std::nullopt);
+        function.entry()->emplace_back<il::Call>(
+            result, callees[index], std::vector<il::Operand>{ argument }, std::nullopt
+        );
+    }
+
+    function.entry()->emplace_back<il::Return>(il::Immediate(1u), std::nullopt);
+}
+
+static std::vector<std::string> memoized(il::Module& module) {
+    std::vector<std::string> names;
+    for (auto& function : module) {
+        if (function.is_memoized()) names.push_back(function.name());
+    }
+    return names;
+}
+
+TEST(Memoize, MarksPureRecursiveFunctions) {
+    il::Module module;
+    emplace_function(module, "main", { "recursive", "leaf" }, { });
+    emplace_function(module, "recursive", { "recursive" });
+    emplace_function(module, "even", { "odd" });
+    emplace_function(module, "odd", { "even" });
+    emplace_function(module, "leaf", { });
+
+    opt::PassManager manager;
+    manager.add<opt::Memoize>();
+    manager.run(module);
+
+    // Calls to "leaf" are never repeated by the function itself, thus a cache wouldn't pay off.
+    EXPECT_EQ(memoized(module), (std::vector<std::string>{ "recursive", "even", "odd" }));
+}
+
+TEST(Memoize, SkipsFunctionsThatCantBeCached) {
+    const sem::Type floating = sem::Floating(Size::QWORD);
+
+    il::Module module;
+    emplace_function(module, "external", { "external", "unknown" });
+    emplace_function(module, "floating", { "floating" }, { il::Variable("p", floating) });
+    emplace_function(module, "pair", { "pair" }, { il::Variable("p", TYPE), il::Variable("q", TYPE) });
+    emplace_function(module, "none", { "none" }, { });
+
+    opt::PassManager manager;
+    manager.add<opt::Memoize>();
+    manager.run(module);
+
+    EXPECT_TRUE(memoized(module).empty());
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
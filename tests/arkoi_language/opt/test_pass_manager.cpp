@@ -0,0 +1,137 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/pass.hpp"
+
+using namespace arkoi;
+
+/**
+ * @brief Test pass that reports a change for its first few runs and counts how often it was run.
+ */
+class CountingPass final : public opt::Pass {
+public:
+    CountingPass(size_t& runs, size_t changes, Effects effects, Effects triggers) :
+        _runs(runs), _changes(changes), _effects(effects), _triggers(triggers) { }
+
+    [[nodiscard]] std::string_view name() const override { return "counting"; }
+
+    [[nodiscard]] Effects effects() const override { return _effects; }
+
+    [[nodiscard]] Effects triggers() const override { return _triggers; }
+
+    bool enter_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    bool exit_module([[maybe_unused]] il::Module& module) override { return false; }
+
+    bool enter_function([[maybe_unused]] il::Function& function) override {
+        _runs++;
+        if (_changes == 0) return false;
+
+        _changes--;
+        count("changes");
+        return true;
+    }
+
+    bool exit_function([[maybe_unused]] il::Function& function) override { return false; }
+
+    bool on_block([[maybe_unused]] il::BasicBlock& block) override { return false; }
+
+private:
+    size_t& _runs;
+    size_t _changes;
+    Effects _effects, _triggers;
+};
+
+TEST(PassManager, SkipsPassesNotTriggered) {
+    il::Function function("main", { }, sem::Integral(Size::DWORD, false));
+
+    size_t folding_runs = 0, cleanup_runs = 0;
+
+    opt::PassManager manager;
+    manager.add<CountingPass>(folding_runs, 3, opt::Pass::FOLDED_CONSTANTS, opt::Pass::FOLDED_CONSTANTS);
+    manager.add<CountingPass>(cleanup_runs, 0, opt::Pass::REMOVED_INSTRUCTIONS, opt::Pass::CHANGED_BLOCKS);
+    manager.run(function);
+
+    // Three changing runs and a final one that converges.
+    EXPECT_EQ(folding_runs, 4);
+    // Never triggered by folding, so only the initial run.
+    EXPECT_EQ(cleanup_runs, 1);
+}
+
+TEST(PassManager, CountsStatistics) {
+    il::Function function("main", { }, sem::Integral(Size::DWORD, false));
+
+    size_t runs = 0;
+    utils::Statistics statistics;
+
+    opt::PassManager manager;
+    manager.add<CountingPass>(runs, 2, opt::Pass::FOLDED_CONSTANTS, opt::Pass::FOLDED_CONSTANTS);
+    manager.set_statistics(&statistics);
+    manager.run(function);
+
+    // The counters of the pass are grouped under its name, the manager counts every round it took.
+    EXPECT_EQ(statistics.value("counting", "changes"), 2);
+    EXPECT_EQ(statistics.value("pass-manager", "functions"), 1);
+    EXPECT_EQ(statistics.value("pass-manager", "rounds"), 3);
+    EXPECT_EQ(statistics.value("pass-manager", "pass-runs"), 3);
+}
+
+TEST(PassManager, RerunsTriggeredPasses) {
+    il::Function function("main", { }, sem::Integral(Size::DWORD, false));
+
+    size_t folding_runs = 0, cleanup_runs = 0;
+
+    opt::PassManager manager;
+    manager.add<CountingPass>(folding_runs, 2, opt::Pass::FOLDED_CONSTANTS, opt::Pass::REMOVED_INSTRUCTIONS);
+    manager.add<CountingPass>(cleanup_runs, 1, opt::Pass::REMOVED_INSTRUCTIONS, opt::Pass::FOLDED_CONSTANTS);
+    manager.run(function);
+
+    // Each change of one pass triggers exactly one more run of the other.
+    EXPECT_EQ(folding_runs, 2);
+    EXPECT_EQ(cleanup_runs, 2);
+}
+
+TEST(PassManager, ConvergesPerFunction) {
+    il::Module module;
+    module.emplace_back("hot", std::vector<il::Variable>(), sem::Integral(Size::DWORD, false));
+    module.emplace_back("cold", std::vector<il::Variable>(), sem::Integral(Size::DWORD, false));
+
+    size_t runs = 0;
+
+    opt::PassManager manager;
+    manager.add<CountingPass>(runs, 3, opt::Pass::ALL_EFFECTS, opt::Pass::ALL_EFFECTS);
+    manager.run(module);
+
+    // The hot function takes four runs, the cold one converges after its first run.
+    EXPECT_EQ(runs, 5);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "arkoi_language/opt/pipeline.hpp"
+
+using namespace arkoi;
+
+TEST(Pipeline, LevelsAddPasses) {
+    EXPECT_TRUE(opt::Pipeline::level(0).passes().empty());
+
+    for (uint8_t level = 1; level <= opt::Pipeline::MAX_LEVEL; level++) {
+        const auto lower = opt::Pipeline::level(level - 1);
+        const auto higher = opt::Pipeline::level(level);
+        EXPECT_GT(higher.passes().size(), lower.passes().size());
+
+        for (const auto& name : lower.passes()) {
+            EXPECT_NE(std::ranges::find(higher.passes(), name), higher.passes().end()) << name;
+        }
+    }
+
+    EXPECT_FALSE(opt::Pipeline::level(1).has_module_passes());
+    EXPECT_TRUE(opt::Pipeline::level(2).has_module_passes());
+    EXPECT_EQ(opt::Pipeline::level(9).describe(), opt::Pipeline::level(opt::Pipeline::MAX_LEVEL).describe());
+}
+
+TEST(Pipeline, MaxLevelRunsEveryPassButTheOptInOnes) {
+    auto pipeline = opt::Pipeline::level(opt::Pipeline::MAX_LEVEL);
+    pipeline.append("memoize");
+
+    const auto available = opt::Pipeline::available();
+    EXPECT_EQ(std::vector(available.begin(), available.end()), std::vector<std::string_view>(
+        pipeline.passes().begin(), pipeline.passes().end()
+    ));
+}
+
+TEST(Pipeline, ParsesDescription) {
+    const auto pipeline = opt::Pipeline::parse(" gvn, dead-code-elimination ,inliner,gvn");
+
+    const std::vector<std::string> expected{ "gvn", "dead-code-elimination", "inliner", "gvn" };
+    EXPECT_EQ(pipeline.passes(), expected);
+    EXPECT_TRUE(pipeline.has_module_passes());
+    EXPECT_EQ(pipeline.describe(), "gvn,dead-code-elimination,inliner,gvn");
+
+    EXPECT_EQ(opt::Pipeline::parse(pipeline.describe()).passes(), expected);
+    EXPECT_TRUE(opt::Pipeline::parse("").passes().empty());
+}
+
+TEST(Pipeline, RejectsUnknownPasses) {
+    EXPECT_THROW(std::ignore = opt::Pipeline::parse("gvn,vectorize"), std::invalid_argument);
+    EXPECT_THROW(std::ignore = opt::Pipeline::parse("gvn,,sccp"), std::invalid_argument);
+}
+
+TEST(Pipeline, AppendsPasses) {
+    auto pipeline = opt::Pipeline::parse("gvn");
+    pipeline.append("memoize");
+
+    EXPECT_EQ(pipeline.describe(), "gvn,memoize");
+    EXPECT_TRUE(pipeline.has_module_passes());
+    EXPECT_THROW(pipeline.append("vectorize"), std::invalid_argument);
+}
+
+TEST(Pipeline, AddsFunctionPasses) {
+    opt::PassManager manager;
+    opt::Pipeline::parse("sccp,inliner,gvn").add_function_passes(manager);
+
+    std::vector<std::string_view> names;
+    for (const auto& pass : manager.passes()) names.push_back(pass->name());
+
+    EXPECT_EQ(names, (std::vector<std::string_view>{ "sccp", "gvn" }));
+}
+
+TEST(Pipeline, NamesMatchPasses) {
+    const auto pipeline = opt::Pipeline::level(opt::Pipeline::MAX_LEVEL);
+
+    opt::PassManager function_passes, module_passes;
+    pipeline.add_function_passes(function_passes);
+    pipeline.add_module_passes(module_passes);
+
+    std::vector<std::string_view> names;
+    for (const auto& pass : function_passes.passes()) names.push_back(pass->name());
+    for (const auto& pass : module_passes.passes()) names.push_back(pass->name());
+
+    EXPECT_EQ(std::vector<std::string_view>(pipeline.passes().begin(), pipeline.passes().end()), names);
+}
+
+TEST(Pipeline, LeavesOutSignatureChangesOfPartialModules) {
+    const auto pipeline = opt::Pipeline::parse("ipcp,inliner,dead-function-elimination");
+
+    opt::PassManager manager;
+    pipeline.add_module_passes(manager, { }, false);
+
+    std::vector<std::string_view> names;
+    for (const auto& pass : manager.passes()) names.push_back(pass->name());
+
+    EXPECT_EQ(names, (std::vector<std::string_view>{ "inliner", "dead-function-elimination" }));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/pass.hpp"
+#include "arkoi_language/opt/sccp.hpp"
+
+using namespace arkoi;
+
+/**
+ * main($p.0 @u32) @u32:
+ *     [ entry: c = lhs == 1, if c ] -> [ then: a = 1 ] -> [ exit: r = phi [ then: a, else: b ], ret r ]
+ *                                   -> [ else: b = p ] ->
+ */
+static il::Function create_diamond_cfg(const il::Operand& lhs) {
+    const sem::Type type = sem::Integral(Size::DWORD, false);
+    const il::Variable parameter("p", type), a("a", type), b("b", type), r("r", type), c("c", sem::Boolean());
+
+    il::Function function("main", { parameter }, type);
+    auto* then_block = function.emplace_back("then");
+    auto* else_block = function.emplace_back("else");
+
+    function.entry()->emplace_back<il::Binary>(
+        c, lhs, il::Binary::Operator::Equal, il::Immediate(1u), type, std::nullopt
+    );
+    function.entry()->emplace_back<il::If>(c, else_block->label(), then_block->label(), std::nullopt);
+    function.entry()->set_next(else_block);
+    function.entry()->set_branch(then_block);
+
+    then_block->emplace_back<il::Assign>(a, il::Immediate(1u), std::nullopt);
+    then_block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    then_block->set_next(function.exit());
+
+    else_block->emplace_back<il::Assign>(b, parameter, std::nullopt);
+    else_block->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    else_block->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Phi>(
+        r, il::Phi::Incoming{ { then_block, a }, { else_block, b } }, std::nullopt
+    );
+    function.exit()->emplace_back<il::Return>(r, std::nullopt);
+
+    return function;
+}
+
+TEST(SCCP, FoldsConstantBranches) {
+    auto function = create_diamond_cfg(il::Immediate(1u));
+
+    opt::PassManager manager;
+    manager.add<opt::SCCP>();
+    manager.run(function);
+
+    auto* entry = function.entry();
+    ASSERT_TRUE(std::holds_alternative<il::Goto>(entry->instructions().back()));
+    EXPECT_EQ(entry->branch(), nullptr);
+    ASSERT_NE(entry->next(), nullptr);
+    EXPECT_EQ(entry->next()->label(), "then");
+
+    auto& exit = function.exit()->instructions();
+    EXPECT_EQ(function.exit()->predecessors().size(), 1);
+
+    auto* result = std::get_if<il::Assign>(&exit.front());
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->value(), il::Operand(il::Immediate(1u)));
+}
+
+TEST(SCCP, KeepsUnknownBranches) {
+    const il::Variable parameter("p", sem::Integral(Size::DWORD, false));
+    auto function = create_diamond_cfg(parameter);
+
+    opt::PassManager manager;
+    manager.add<opt::SCCP>();
+    manager.run(function);
+
+    auto* entry = function.entry();
+    EXPECT_TRUE(std::holds_alternative<il::If>(entry->instructions().back()));
+    EXPECT_NE(entry->next(), nullptr);
+    EXPECT_NE(entry->branch(), nullptr);
+
+    EXPECT_TRUE(std::holds_alternative<il::Phi>(function.exit()->instructions().front()));
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
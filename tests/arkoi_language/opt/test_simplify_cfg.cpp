@@ -0,0 +1,210 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/simplify_cfg.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, true);
+
+static const il::Variable A("a", TYPE), B("b", TYPE), C("c", sem::Boolean()), D("d", sem::Boolean()),
+        T("t", sem::Boolean()), F("f", sem::Boolean()), X("x", sem::Boolean()), U("u", TYPE), V("v", TYPE),
+        W("w", TYPE), R("r", TYPE);
+
+static void branch(il::BasicBlock* block, const il::Operand& condition, il::BasicBlock* then, il::BasicBlock* otherwise) {
+    block->emplace_back<il::If>(condition, otherwise->label(), then->label(), std::nullopt);
+    block->set_next(otherwise);
+    block->set_branch(then);
+}
+
+static void jump(il::BasicBlock* block, il::BasicBlock* target) {
+    block->emplace_back<il::Goto>(target->label(), std::nullopt);
+    block->set_next(target);
+}
+
+static bool contains(il::Function& function, const std::string& label) {
+    for (auto& block : function) {
+        if (block.label() == label) return true;
+    }
+
+    return false;
+}
+
+static size_t run(il::Function& function, utils::Statistics& statistics) {
+    opt::PassManager manager;
+    manager.add<opt::SimplifyCFG>();
+    manager.set_statistics(&statistics);
+    manager.run(function);
+
+    size_t blocks = 0;
+    for ([[maybe_unused]] auto& block : function) blocks++;
+    return blocks;
+}
+
+/**
+ * pick($a.0 @s32, $b.0 @s32) @s32:
+ *     [ entry: if true ] -> [ then: u = a ] -> [ exit: r = phi [ then: u, else: v ], ret r ]
+ *                        -> [ else: v = b ] ----^
+ */
+TEST(SimplifyCFG, FoldsConstantBranches) {
+    il::Function function("pick", { A, B }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* then = function.emplace_back("then");
+    auto* otherwise = function.emplace_back("else");
+
+    branch(entry, il::Immediate(true), then, otherwise);
+    then->emplace_back<il::Assign>(U, A, std::nullopt);
+    jump(then, exit);
+    otherwise->emplace_back<il::Assign>(V, B, std::nullopt);
+    jump(otherwise, exit);
+    exit->emplace_back<il::Phi>(R, il::Phi::Incoming{ { then, U }, { otherwise, V } }, std::nullopt);
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    utils::Statistics statistics;
+    EXPECT_EQ(run(function, statistics), 1);
+    EXPECT_EQ(statistics.value("simplify-cfg", "folded-branches"), 1);
+    EXPECT_EQ(statistics.value("simplify-cfg", "unreachable-blocks"), 1);
+
+    // Only the taken path is left, thus the phi became a copy of its value.
+    auto& instructions = function.entry()->instructions();
+    ASSERT_EQ(instructions.size(), 3);
+    EXPECT_EQ(std::get<il::Assign>(instructions[1]).value(), il::Operand(U));
+}
+
+/**
+ * pick($a.0 @s32, $b.0 @s32) @s32:
+ *     [ entry: c = a > b, if c ] -> [ left: t = true ]  -> [ join: x = phi [ left: t, right: f ], if x ] -> [ yes ]
+ *                                -> [ right: f = false ] ----^                                         -> [ no ]
+ *     [ yes: u = a ] -> [ exit: r = phi [ yes: u, no: v ], ret r ]
+ *     [ no: v = b ] ----^
+ */
+static il::Function create_forwarded_phi() {
+    il::Function function("pick", { A, B }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* left = function.emplace_back("left");
+    auto* right = function.emplace_back("right");
+    auto* join = function.emplace_back("join");
+    auto* yes = function.emplace_back("yes");
+    auto* no = function.emplace_back("no");
+
+    entry->emplace_back<il::Binary>(C, A, il::Binary::Operator::GreaterThan, B, TYPE, std::nullopt);
+    branch(entry, C, left, right);
+    left->emplace_back<il::Assign>(T, il::Immediate(true), std::nullopt);
+    jump(left, join);
+    right->emplace_back<il::Assign>(F, il::Immediate(false), std::nullopt);
+    jump(right, join);
+    join->emplace_back<il::Phi>(X, il::Phi::Incoming{ { left, T }, { right, F } }, std::nullopt);
+    branch(join, X, yes, no);
+    yes->emplace_back<il::Assign>(U, A, std::nullopt);
+    jump(yes, exit);
+    no->emplace_back<il::Assign>(V, B, std::nullopt);
+    jump(no, exit);
+    exit->emplace_back<il::Phi>(R, il::Phi::Incoming{ { yes, U }, { no, V } }, std::nullopt);
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    return function;
+}
+
+TEST(SimplifyCFG, ThreadsForwardedPhis) {
+    auto function = create_forwarded_phi();
+
+    utils::Statistics statistics;
+    run(function, statistics);
+
+    // Both predecessors know the branch of the join, which isn't reachable anymore afterward.
+    EXPECT_EQ(statistics.value("simplify-cfg", "threaded-jumps"), 2);
+    EXPECT_FALSE(contains(function, "join"));
+
+    // The branch of the entry is the only one left.
+    EXPECT_EQ(function.entry()->branch()->next(), function.exit());
+    EXPECT_EQ(function.entry()->next()->next(), function.exit());
+}
+
+TEST(SimplifyCFG, KeepsBlocksWithEscapingResults) {
+    auto function = create_forwarded_phi();
+
+    // The join defines a value used by the exit, which would be undefined on a threaded edge.
+    function.exit()->instructions().insert(
+        function.exit()->instructions().begin() + 1, il::Cast(W, X, sem::Boolean(), std::nullopt)
+    );
+
+    utils::Statistics statistics;
+    run(function, statistics);
+
+    EXPECT_EQ(statistics.value("simplify-cfg", "threaded-jumps"), 0);
+    EXPECT_TRUE(contains(function, "join"));
+}
+
+/**
+ * pick($a.0 @s32, $b.0 @s32) @s32:
+ *     [ entry: c = a > b, if c ] -> [ then: u = a ] ------------------------> [ exit: r = phi [ .. ], ret r ]
+ *                                -> [ test: d = a <= b, if d ] -> [ other: v = b ] ---^
+ *                                                              -> [ rest: w = a + b ] ---^
+ */
+TEST(SimplifyCFG, ThreadsRepeatedComparisons) {
+    il::Function function("pick", { A, B }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* then = function.emplace_back("then");
+    auto* test = function.emplace_back("test");
+    auto* other = function.emplace_back("other");
+    auto* rest = function.emplace_back("rest");
+
+    entry->emplace_back<il::Binary>(C, A, il::Binary::Operator::GreaterThan, B, TYPE, std::nullopt);
+    branch(entry, C, then, test);
+    then->emplace_back<il::Assign>(U, A, std::nullopt);
+    jump(then, exit);
+    test->emplace_back<il::Binary>(D, A, il::Binary::Operator::LessEqual, B, TYPE, std::nullopt);
+    branch(test, D, other, rest);
+    other->emplace_back<il::Assign>(V, B, std::nullopt);
+    jump(other, exit);
+    rest->emplace_back<il::Binary>(W, A, il::Binary::Operator::Add, B, TYPE, std::nullopt);
+    jump(rest, exit);
+    exit->emplace_back<il::Phi>(R, il::Phi::Incoming{ { then, U }, { other, V }, { rest, W } }, std::nullopt);
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    utils::Statistics statistics;
+    run(function, statistics);
+
+    // The entry knows `a <= b` on its false edge, the test and the path it never takes are gone.
+    EXPECT_EQ(statistics.value("simplify-cfg", "threaded-jumps"), 1);
+    EXPECT_EQ(statistics.value("simplify-cfg", "unreachable-blocks"), 2);
+    EXPECT_FALSE(contains(function, "test"));
+    EXPECT_FALSE(contains(function, "rest"));
+
+    auto& phi = std::get<il::Phi>(function.exit()->instructions().front());
+    EXPECT_EQ(phi.incoming().size(), 2);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/slp_vectorizer.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+
+using namespace arkoi;
+
+static const sem::Type DOUBLE = sem::Floating(Size::QWORD);
+
+static const il::Variable A("a", DOUBLE), B("b", DOUBLE), C("c", DOUBLE), D("d", DOUBLE), P("p", DOUBLE),
+        Q("q", DOUBLE), S("s", DOUBLE), T("t", DOUBLE), U("u", DOUBLE), V("v", DOUBLE), R("r", DOUBLE);
+
+/**
+ * ratios($a.0 @f64, $b.0 @f64, $c.0 @f64, $d.0 @f64) @f64:
+ *     [ entry: p = a op b, s = p * a, q = c op d, t = q * c, u = s - t, v = ..., r = u + v ] -> [ exit: ret r ]
+ */
+static il::Function create_ratios(const il::Binary::Operator op) {
+    il::Function function("ratios", { A, B, C, D }, DOUBLE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Binary>(P, A, op, B, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(S, P, il::Binary::Operator::Mul, A, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(Q, C, op, D, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(T, Q, il::Binary::Operator::Mul, C, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(U, S, il::Binary::Operator::Sub, T, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(V, S, il::Binary::Operator::Add, T, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(R, U, il::Binary::Operator::Mul, V, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    return function;
+}
+
+static il::Operand result_at(il::BasicBlock* block, const size_t index) {
+    return std::get<il::Binary>(block->instructions()[index]).result();
+}
+
+TEST(SLPVectorizer, GroupsDivisionPairs) {
+    auto function = create_ratios(il::Binary::Operator::Div);
+
+    utils::Statistics statistics;
+    opt::PassManager manager;
+    manager.add<opt::SLPVectorizer>();
+    manager.set_statistics(&statistics);
+    manager.run(function);
+
+    // Both lanes of every step follow each other, the users of the chain come behind it.
+    auto* entry = function.entry();
+    EXPECT_EQ(result_at(entry, 0), il::Operand(P));
+    EXPECT_EQ(result_at(entry, 1), il::Operand(Q));
+    EXPECT_EQ(result_at(entry, 2), il::Operand(S));
+    EXPECT_EQ(result_at(entry, 3), il::Operand(T));
+    EXPECT_EQ(result_at(entry, 4), il::Operand(U));
+    EXPECT_EQ(statistics.value("slp-vectorizer", "grouped-pairs"), 2);
+
+    // The grouped chain is found again, but isn't counted twice.
+    manager.run(function);
+    EXPECT_EQ(statistics.value("slp-vectorizer", "grouped-pairs"), 2);
+}
+
+TEST(SLPVectorizer, KeepsCheapPairsApart) {
+    auto function = create_ratios(il::Binary::Operator::Add);
+
+    opt::PassManager manager;
+    manager.add<opt::SLPVectorizer>();
+    manager.run(function);
+
+    // Without a division the shuffles into and out of the packed register cost more than they save.
+    auto* entry = function.entry();
+    EXPECT_EQ(result_at(entry, 0), il::Operand(P));
+    EXPECT_EQ(result_at(entry, 1), il::Operand(S));
+    EXPECT_EQ(result_at(entry, 2), il::Operand(Q));
+}
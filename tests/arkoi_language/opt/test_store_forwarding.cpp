@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/store_forwarding.hpp"
+#include "arkoi_language/utils/statistics.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+static const il::Memory SLOT("a", TYPE);
+static const il::Variable X("x", TYPE), Y("y", TYPE), Z("z", TYPE), V("v", TYPE), W("w", TYPE), R("r", TYPE);
+
+static il::Function create_function() {
+    il::Function function("main", { X, Y }, TYPE);
+    function.entry()->set_next(function.exit());
+    return function;
+}
+
+static il::Assign& assign_at(il::BasicBlock* block, const size_t index) {
+    return std::get<il::Assign>(block->instructions()[index]);
+}
+
+/**
+ * main($x.0 @u32, $y.0 @u32) @u32:
+ *     [ entry: a = store x, z = load a, a = store z, goto ] -> [ exit: v = load a, w = load a, r = v + w, ret r ]
+ */
+TEST(StoreForwarding, ForwardsKnownValues) {
+    auto function = create_function();
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Store>(SLOT, X, std::nullopt);
+    entry->emplace_back<il::Load>(Z, SLOT, std::nullopt);
+    entry->emplace_back<il::Store>(SLOT, Z, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+
+    exit->emplace_back<il::Load>(V, SLOT, std::nullopt);
+    exit->emplace_back<il::Load>(W, SLOT, std::nullopt);
+    exit->emplace_back<il::Binary>(R, V, il::Binary::Operator::Add, W, TYPE, std::nullopt);
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    utils::Statistics statistics;
+    opt::PassManager manager;
+    manager.add<opt::StoreForwarding>();
+    manager.set_statistics(&statistics);
+    manager.run(function);
+
+    // The slot still holds `x` after storing the loaded value back, thus that store is gone.
+    ASSERT_EQ(entry->instructions().size(), 3);
+    EXPECT_TRUE(std::holds_alternative<il::Store>(entry->instructions()[0]));
+    EXPECT_EQ(assign_at(entry, 1).value(), il::Operand(X));
+
+    // The store reaching the exit is unknown there, but the second load reuses the first one.
+    EXPECT_TRUE(std::holds_alternative<il::Load>(exit->instructions()[0]));
+    EXPECT_EQ(assign_at(exit, 1).value(), il::Operand(V));
+
+    EXPECT_EQ(statistics.value("store-forwarding", "forwarded-loads"), 2);
+    EXPECT_EQ(statistics.value("store-forwarding", "redundant-stores"), 1);
+}
+
+/**
+ * main($x.0 @u32, $y.0 @u32) @u32:
+ *     [ entry: a = store x, z = load a, a = store y, goto ] -> [ exit: v = load a, r = v + z, ret r ]
+ */
+TEST(StoreForwarding, RemovesOverwrittenStores) {
+    auto function = create_function();
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Store>(SLOT, X, std::nullopt);
+    entry->emplace_back<il::Load>(Z, SLOT, std::nullopt);
+    entry->emplace_back<il::Store>(SLOT, Y, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+
+    exit->emplace_back<il::Load>(V, SLOT, std::nullopt);
+    exit->emplace_back<il::Binary>(R, V, il::Binary::Operator::Add, Z, TYPE, std::nullopt);
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    utils::Statistics statistics;
+    opt::PassManager manager;
+    manager.add<opt::StoreForwarding>();
+    manager.set_statistics(&statistics);
+    manager.run(function);
+
+    // The load doesn't read the first store anymore once it is forwarded, the last store is read by the exit.
+    ASSERT_EQ(entry->instructions().size(), 3);
+    EXPECT_EQ(assign_at(entry, 0).value(), il::Operand(X));
+    EXPECT_EQ(std::get<il::Store>(entry->instructions()[1]).source(), il::Operand(Y));
+    EXPECT_TRUE(std::holds_alternative<il::Load>(exit->instructions()[0]));
+
+    EXPECT_EQ(statistics.value("store-forwarding", "overwritten-stores"), 1);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
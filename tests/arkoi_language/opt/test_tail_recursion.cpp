@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/opt/tail_recursion.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::DWORD, false);
+
+/**
+ * count($n.0 @u32) @u32:
+ *     [ entry: c = n == 0, if c ] -> [ done: z = 0 ]                         -> [ exit: v = phi [ ... ], ret v ]
+ *                                 -> [ recurse: m = n - 1, arg a = m, r = call count ] ->
+ */
+static il::Function create_count(const bool tail) {
+    const il::Variable n("n", TYPE), z("z", TYPE), m("m", TYPE), a("a", TYPE), r("r", TYPE), s("s", TYPE),
+            v("v", TYPE), c("c", sem::Boolean());
+
+    il::Function function("count", { n }, TYPE);
+    auto* done = function.emplace_back("done");
+    auto* recurse = function.emplace_back("recurse");
+
+    function.entry()->emplace_back<il::Binary>(
+        c, n, il::Binary::Operator::Equal, il::Immediate(0u), TYPE, std::nullopt
+    );
+    function.entry()->emplace_back<il::If>(c, recurse->label(), done->label(), std::nullopt);
+    function.entry()->set_next(recurse);
+    function.entry()->set_branch(done);
+
+    done->emplace_back<il::Assign>(z, il::Immediate(0u), std::nullopt);
+    done->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    done->set_next(function.exit());
+
+    recurse->emplace_back<il::Binary>(m, n, il::Binary::Operator::Sub, il::Immediate(1u), TYPE, std::nullopt);
+    recurse->emplace_back<il::Argument>(a, m, std::nullopt);
+    recurse->emplace_back<il::Call>(r, "count", std::vector<il::Operand>{ a }, std::nullopt);
+
+    // Adding one to the result of the call means it's not a tail call anymore.
+    auto result = r;
+    if (!tail) {
+        recurse->emplace_back<il::Binary>(s, r, il::Binary::Operator::Add, il::Immediate(1u), TYPE, std::nullopt);
+        result = s;
+    }
+
+    recurse->emplace_back<il::Goto>(function.exit()->label(), std::nullopt);
+    recurse->set_next(function.exit());
+
+    function.exit()->emplace_back<il::Phi>(v, il::Phi::Incoming{ { done, z }, { recurse, result } }, std::nullopt);
+    function.exit()->emplace_back<il::Return>(v, std::nullopt);
+
+    return function;
+}
+
+TEST(TailRecursion, TurnsTailCallsIntoLoops) {
+    auto function = create_count(true);
+
+    opt::PassManager manager;
+    manager.add<opt::TailRecursion>();
+    manager.run(function);
+
+    EXPECT_TRUE(function.is_leaf());
+
+    // The entry block only jumps to the header, which receives the parameter through a phi.
+    auto* entry = function.entry();
+    ASSERT_EQ(entry->instructions().size(), 1);
+    ASSERT_NE(entry->next(), nullptr);
+
+    auto* header = entry->next();
+    auto& phi = std::get<il::Phi>(header->instructions().front());
+    EXPECT_EQ(*phi.incoming_from(entry), il::Variable("n", TYPE));
+    EXPECT_EQ(header->predecessors().size(), 2);
+
+    auto* recurse = header->next();
+    ASSERT_NE(recurse, nullptr);
+    EXPECT_EQ(recurse->next(), header);
+    EXPECT_EQ(*phi.incoming_from(recurse), il::Variable("a", TYPE));
+
+    // The exit is only reached through the base case of the recursion anymore.
+    auto& result = std::get<il::Phi>(function.exit()->instructions().front());
+    EXPECT_EQ(result.incoming().size(), 1);
+    EXPECT_EQ(function.exit()->predecessors().size(), 1);
+}
+
+TEST(TailRecursion, KeepsOtherCalls) {
+    auto function = create_count(false);
+
+    opt::PassManager manager;
+    manager.add<opt::TailRecursion>();
+    manager.run(function);
+
+    EXPECT_FALSE(function.is_leaf());
+    EXPECT_TRUE(std::holds_alternative<il::Binary>(function.entry()->instructions().front()));
+}
+
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
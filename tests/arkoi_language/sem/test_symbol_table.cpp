@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "arkoi_language/front/scanner.hpp"
+#include "arkoi_language/sem/symbol_table.hpp"
+
+using namespace arkoi::sem;
+using namespace arkoi;
+
+namespace {
+/**
+ * @brief Scans the identifiers "x y x", thus the first and last token share the same name.
+ */
+std::vector<front::Token> scan_identifiers() {
+    const auto path = std::filesystem::temp_directory_path() / "arkoi_symbol_table.ark";
+    std::ofstream(path) << "x y x";
+
+    const auto source = std::make_shared<pretty_diagnostics::FileSource>(path);
+    auto diagnostics = utils::Diagnostics();
+    auto tokens = front::Scanner(source, diagnostics).tokenize();
+
+    std::erase_if(tokens, [](const auto& token) { return token.type() != front::Token::Type::Identifier; });
+    return tokens;
+}
+} // namespace
+
+TEST(SymbolTable, InternsEqualNamesToTheSameAtom) {
+    const auto tokens = scan_identifiers();
+    ASSERT_EQ(tokens.size(), 3);
+
+    EXPECT_EQ(tokens[0].atom(), tokens[2].atom());
+    EXPECT_NE(tokens[0].atom(), tokens[1].atom());
+}
+
+TEST(SymbolTable, ShadowsOuterScopesUntilTheyAreExited) {
+    const auto tokens = scan_identifiers();
+
+    SymbolTable table;
+    table.enter_scope();
+    const auto outer = table.insert<Variable>(tokens[0]);
+
+    table.enter_scope();
+    const auto inner = table.insert<Variable>(tokens[2]);
+    EXPECT_EQ(table.lookup<Variable>(tokens[0]), inner);
+
+    table.exit_scope();
+    EXPECT_EQ(table.lookup<Variable>(tokens[0]), outer);
+    EXPECT_THROW(std::ignore = table.lookup<Variable>(tokens[1]), IdentifierNotFound);
+
+    table.exit_scope();
+    EXPECT_THROW(std::ignore = table.lookup<Variable>(tokens[0]), IdentifierNotFound);
+    EXPECT_THROW(table.exit_scope(), std::logic_error);
+}
+
+TEST(SymbolTable, RejectsRedefinitionsInTheSameScope) {
+    const auto tokens = scan_identifiers();
+
+    SymbolTable table;
+    table.enter_scope();
+    std::ignore = table.insert<Variable>(tokens[0]);
+
+    EXPECT_THROW(std::ignore = table.insert<Function>(tokens[2]), IdentifierAlreadyTaken);
+    EXPECT_NO_THROW(std::ignore = table.insert<Function>(tokens[1]));
+}
+
+TEST(SymbolTable, SkipsBindingsOfOtherKinds) {
+    const auto tokens = scan_identifiers();
+
+    SymbolTable table;
+    table.enter_scope();
+    const auto function = table.insert<Function>(tokens[0]);
+
+    table.enter_scope();
+    const auto variable = table.insert<Variable>(tokens[2]);
+
+    EXPECT_EQ(table.lookup<Function>(tokens[2]), function);
+    EXPECT_EQ((table.lookup<Function, Variable>(tokens[2])), variable);
+}
+
+TEST(SymbolTable, FallsBackToTheEnclosingTable) {
+    const auto tokens = scan_identifiers();
+
+    SymbolTable globals;
+    globals.enter_scope();
+    const auto function = globals.insert<Function>(tokens[0]);
+    const auto parameter = globals.insert<Variable>(tokens[1]);
+
+    SymbolTable table(&globals, std::pmr::get_default_resource());
+    table.enter_scope();
+    table.bind(parameter);
+
+    // The enclosing table is only searched if none of the own bindings matches.
+    EXPECT_EQ(table.lookup<Variable>(tokens[1]), parameter);
+    EXPECT_EQ(table.lookup<Function>(tokens[2]), function);
+    EXPECT_THROW(std::ignore = table.lookup<Variable>(tokens[2]), IdentifierNotFound);
+
+    const auto local = table.insert<Variable>(tokens[2]);
+    EXPECT_EQ(table.lookup<Variable>(tokens[0]), local);
+    EXPECT_EQ(table.lookup<Function>(tokens[0]), function);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "arkoi_language/sem/type.hpp"
+#include "arkoi_language/utils/utils.hpp"
+
+using namespace arkoi::sem;
+using namespace arkoi;
+
+static_assert(sizeof(Type) == 3);
+static_assert(Type(Integral(Size::WORD, true)).is_integral());
+static_assert(Type(Floating(Size::QWORD)).size() == Size::QWORD);
+static_assert(Type(Boolean()).size() == Size::BYTE);
+static_assert(Type(Integral(Size::DWORD, true)) != Type(Integral(Size::DWORD, false)));
+static_assert(Type(Integral(Size::QWORD, false)) != Type(Floating(Size::QWORD)));
+
+TEST(Type, RecoversTheConcreteType) {
+    const Type integral = Integral(Size::WORD, true);
+    EXPECT_EQ(integral.integral(), Integral(Size::WORD, true));
+    EXPECT_EQ(integral.floating(), std::nullopt);
+
+    const Type floating = Floating(Size::DWORD);
+    EXPECT_EQ(floating.floating(), Floating(Size::DWORD));
+    EXPECT_EQ(floating.integral(), std::nullopt);
+
+    const Type boolean = Boolean();
+    EXPECT_TRUE(boolean.is_boolean());
+    EXPECT_FALSE(boolean.sign());
+}
+
+TEST(Type, VisitsTheConcreteTypes) {
+    const auto describe = match{
+        [](const Integral&, const Floating&) { return "integral to floating"; },
+        [](const auto&, const auto&) { return "other"; },
+    };
+
+    EXPECT_STREQ(visit(describe, Integral(Size::BYTE, false), Floating(Size::QWORD)), "integral to floating");
+    EXPECT_STREQ(visit(describe, Floating(Size::QWORD), Integral(Size::BYTE, false)), "other");
+
+    std::stringstream output;
+    output << Type(Integral(Size::QWORD, true)) << " " << Type(Floating(Size::DWORD)) << " " << Type(Boolean());
+    EXPECT_EQ(output.str(), "s64 f32 bool");
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -39,7 +39,7 @@ TEST(Snapshot, Scanner) {
 
 static const std::string PARSER_FILES = TEST_PATH "/arkoi_language/snapshot/parser/";
 
-TEST(Snapshot, Parser) {
+static void run_parser_snapshots(const bool streaming) {
     for (const auto& entry : std::filesystem::directory_iterator(PARSER_FILES)) {
         if (!entry.is_regular_file()) continue;
         if (entry.path().extension() != ".ark") continue;
@@ -52,7 +52,9 @@ TEST(Snapshot, Parser) {
 
         auto diagnostics = arkoi::utils::Diagnostics();
         auto scanner = arkoi::front::Scanner(source, diagnostics);
-        auto parser = arkoi::front::Parser(source, scanner.tokenize(), diagnostics);
+        auto parser = streaming
+            ? arkoi::front::Parser(source, scanner, diagnostics)
+            : arkoi::front::Parser(source, scanner.tokenize(), diagnostics);
         auto program = parser.parse_program();
 
         EXPECT_FALSE(diagnostics.has_errors());
@@ -63,3 +65,11 @@ TEST(Snapshot, Parser) {
         EXPECT_SNAPSHOT_EQ(file_name, snapshot_path.string(), ast_printer.str());
     }
 }
+
+TEST(Snapshot, Parser) {
+    run_parser_snapshots(false);
+}
+
+TEST(Snapshot, StreamingParser) {
+    run_parser_snapshots(true);
+}
@@ -0,0 +1,102 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "arkoi_language/utils/bit_vector.hpp"
+
+using testing::ElementsAre;
+using namespace arkoi;
+
+TEST(BitVectorTest, SetResetAndTest) {
+    utils::BitVector bits(10);
+
+    EXPECT_TRUE(bits.set(3));
+    EXPECT_FALSE(bits.set(3));
+    EXPECT_TRUE(bits.set(130));
+
+    EXPECT_TRUE(bits.test(3));
+    EXPECT_TRUE(bits.test(130));
+    EXPECT_FALSE(bits.test(4));
+    EXPECT_FALSE(bits.test(1000));
+    EXPECT_EQ(bits.count(), 2);
+
+    EXPECT_TRUE(bits.reset(3));
+    EXPECT_FALSE(bits.reset(3));
+    EXPECT_FALSE(bits.test(3));
+}
+
+TEST(BitVectorTest, IteratesSetBitsInOrder) {
+    utils::BitVector bits;
+    bits.set(70);
+    bits.set(0);
+    bits.set(63);
+    bits.set(64);
+
+    std::vector<size_t> indices(bits.begin(), bits.end());
+    EXPECT_THAT(indices, ElementsAre(0, 63, 64, 70));
+
+    EXPECT_EQ(utils::BitVector(256).begin(), utils::BitVector(256).end());
+}
+
+TEST(BitVectorTest, SetOperations) {
+    utils::BitVector first, second;
+    first.set(1);
+    first.set(2);
+    second.set(2);
+    second.set(200);
+
+    auto united = first;
+    united |= second;
+    EXPECT_THAT(std::vector<size_t>(united.begin(), united.end()), ElementsAre(1, 2, 200));
+
+    auto intersected = first;
+    intersected &= second;
+    EXPECT_THAT(std::vector<size_t>(intersected.begin(), intersected.end()), ElementsAre(2));
+
+    auto difference = united;
+    difference -= first;
+    EXPECT_THAT(std::vector<size_t>(difference.begin(), difference.end()), ElementsAre(200));
+}
+
+TEST(BitVectorTest, EqualityIgnoresSize) {
+    utils::BitVector small(1), large(512);
+    EXPECT_EQ(small, large);
+
+    large.set(300);
+    EXPECT_NE(small, large);
+
+    large.reset(300);
+    small.set(5);
+    large.set(5);
+    EXPECT_EQ(small, large);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
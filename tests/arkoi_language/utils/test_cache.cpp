@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "arkoi_language/utils/cache.hpp"
+#include "arkoi_language/utils/driver.hpp"
+
+using namespace arkoi::utils;
+using namespace arkoi;
+
+namespace {
+void write_file(const std::filesystem::path& path, const std::string& contents) {
+    std::ofstream(path, std::ios::binary) << contents;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ostringstream contents;
+    contents << std::ifstream(path, std::ios::binary).rdbuf();
+    return contents.str();
+}
+
+/**
+ * @brief Provides an empty cache directory and a directory for the artifacts, which are removed afterward.
+ */
+class CacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::create_directories(_outputs);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(_directory);
+        std::filesystem::remove_all(_outputs);
+    }
+
+    std::filesystem::path _directory = generate_temp_path();
+    std::filesystem::path _outputs = generate_temp_path();
+};
+} // namespace
+
+TEST_F(CacheTest, RestoresStoredArtifactsAndDiagnostics) {
+    const Cache cache(_directory, 1024 * 1024);
+    const auto key = cache.key("fun main() @u32:\n    return 0", "graph");
+
+    const std::vector<Cache::Artifact> artifacts = { { "s", _outputs / "main.s" }, { "o", _outputs / "main.o" } };
+    EXPECT_EQ(cache.restore(key, artifacts), std::nullopt);
+
+    write_file(_outputs / "main.s", "assembly");
+    write_file(_outputs / "main.o", std::string("\0object", 7));
+    cache.store(key, artifacts, "warning");
+
+    std::filesystem::remove(_outputs / "main.s");
+    std::filesystem::remove(_outputs / "main.o");
+
+    EXPECT_EQ(cache.restore(key, artifacts), "warning");
+    EXPECT_EQ(read_file(_outputs / "main.s"), "assembly");
+    EXPECT_EQ(read_file(_outputs / "main.o"), std::string("\0object", 7));
+
+    // An entry without the requested artifact is a miss.
+    EXPECT_EQ(cache.restore(key, { { "il", _outputs / "main.il" } }), std::nullopt);
+}
+
+TEST_F(CacheTest, KeysDependOnContentsAndConfiguration) {
+    const Cache cache(_directory, 1024 * 1024);
+
+    const auto key = cache.key("source", "graph");
+    EXPECT_EQ(key, cache.key("source", "graph"));
+    EXPECT_EQ(key.size(), 32);
+
+    EXPECT_NE(key, cache.key("source", "linear"));
+    EXPECT_NE(key, cache.key("sourc", "egraph"));
+    EXPECT_NE(key, cache.key("", ""));
+}
+
+TEST_F(CacheTest, EvictsLeastRecentlyUsedEntries) {
+    // Every entry occupies a bit more than 600 bytes, thus only a single one fits.
+    const Cache cache(_directory, 1000);
+    const std::vector<Cache::Artifact> artifacts = { { "o", _outputs / "main.o" } };
+    write_file(_outputs / "main.o", std::string(600, 'x'));
+
+    const auto first = cache.key("first", "");
+    cache.store(first, artifacts, "");
+
+    // Make sure the entries are ordered by time, even with a coarse clock of the filesystem.
+    std::filesystem::last_write_time(_directory / first, std::filesystem::file_time_type::clock::now() - std::chrono::hours(1));
+
+    const auto second = cache.key("second", "");
+    cache.store(second, artifacts, "");
+
+    EXPECT_EQ(cache.restore(first, artifacts), std::nullopt);
+    EXPECT_EQ(cache.restore(second, artifacts), "");
+}
+
+TEST_F(CacheTest, EvictsOnceTheStoredEntriesExceedTheLimit) {
+    const Cache cache(_directory, 1000);
+    const auto blobs = std::vector<Cache::Blob>{ { "fragment", std::string(300, 'x') } };
+
+    // The sizes of the entries are added up after the first one, which scanned the cache.
+    std::vector<std::string> keys;
+    for (const auto* name : { "first", "second", "third" }) {
+        keys.push_back(cache.key(name, ""));
+        cache.save(keys.back(), blobs);
+
+        const auto age = std::chrono::hours(4 - keys.size());
+        std::filesystem::last_write_time(_directory / keys.back(), std::filesystem::file_time_type::clock::now() - age);
+    }
+
+    // Loading would mark the entries as recently used, thus only check that they are still present.
+    for (const auto& key : keys) EXPECT_TRUE(std::filesystem::exists(_directory / key));
+
+    keys.push_back(cache.key("fourth", ""));
+    cache.save(keys.back(), blobs);
+
+    EXPECT_EQ(cache.load(keys[0], { "fragment" }), std::nullopt);
+    EXPECT_TRUE(cache.load(keys[3], { "fragment" }).has_value());
+}
+
+TEST_F(CacheTest, LoadsSavedBlobs) {
+    const Cache cache(_directory, 1024 * 1024);
+    const auto key = cache.key("fun main() @u32:\n    return 0", "function");
+
+    EXPECT_EQ(cache.load(key, { "il", "fragment" }), std::nullopt);
+
+    cache.save(key, { { "il", "fun main() @u32:" }, { "fragment", std::string("\0code", 5) } });
+
+    const auto blobs = cache.load(key, { "fragment", "il" });
+    ASSERT_TRUE(blobs.has_value());
+    EXPECT_EQ((*blobs)[0], std::string("\0code", 5));
+    EXPECT_EQ((*blobs)[1], "fun main() @u32:");
+
+    // An entry without the requested blob is a miss.
+    EXPECT_EQ(cache.load(key, { "dot" }), std::nullopt);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
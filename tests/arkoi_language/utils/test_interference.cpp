@@ -46,6 +46,44 @@ TEST(InterferenceGraphTest, IsolatedNodeHasNoNeighbors) {
     EXPECT_TRUE(interferences.empty());
 }
 
+TEST(InterferenceGraphTest, DenseNodesUseTheBitMatrix) {
+    utils::InterferenceGraph<size_t> graph(4);
+
+    graph.add_edge(0, 1);
+    graph.add_edge(3, 0);
+    graph.add_edge(1, 0);
+    graph.add_edge(2, 2);
+
+    EXPECT_TRUE(graph.is_interfering(0, 1));
+    EXPECT_TRUE(graph.is_interfering(1, 0));
+    EXPECT_TRUE(graph.is_interfering(0, 3));
+    EXPECT_FALSE(graph.is_interfering(1, 3));
+    EXPECT_FALSE(graph.is_interfering(2, 2));
+
+    EXPECT_THAT(graph.interferences(0), UnorderedElementsAre(1, 3));
+    EXPECT_THAT(graph.interferences(1), UnorderedElementsAre(0));
+    EXPECT_TRUE(graph.interferences(2).empty());
+}
+
+TEST(InterferenceGraphTest, DenseNodesGrowAndRemove) {
+    utils::InterferenceGraph<size_t> graph;
+
+    graph.add_edge(0, 100);
+    graph.add_edge(5, 100);
+    graph.add_node(7);
+
+    EXPECT_TRUE(graph.is_interfering(100, 5));
+    EXPECT_EQ(graph.nodes().count(), 4);
+
+    graph.remove_node(100);
+
+    EXPECT_FALSE(graph.is_interfering(0, 100));
+    EXPECT_FALSE(graph.is_interfering(5, 100));
+    EXPECT_TRUE(graph.interferences(0).empty());
+    EXPECT_TRUE(graph.interferences(100).empty());
+    EXPECT_EQ(graph.nodes().count(), 3);
+}
+
 // BSD 3-Clause License
 //
 // Copyright (c) 2025, Timo Behrend
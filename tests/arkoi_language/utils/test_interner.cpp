@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/utils/interner.hpp"
+
+using namespace arkoi;
+
+TEST(InternerTest, EqualStringsShareId) {
+    const utils::Interned first("variable");
+    const utils::Interned second(std::string("vari") + "able");
+    const utils::Interned other("other");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.id(), second.id());
+    EXPECT_NE(first, other);
+    EXPECT_EQ(first.str(), "variable");
+}
+
+TEST(InternerTest, HashAndOrderFollowCharacters) {
+    const utils::Interned later("b");
+    const utils::Interned earlier("a");
+
+    EXPECT_EQ(earlier.hash(), std::hash<std::string>{ }("a"));
+    EXPECT_TRUE(earlier < later);
+    EXPECT_FALSE(later < earlier);
+    EXPECT_FALSE(earlier < earlier);
+}
+
+TEST(InternerTest, KeepsStringsOfEndedScopesBelowTheLimit) {
+    uint32_t id;
+    {
+        const utils::InternScope scope;
+        id = utils::Interned("scoped").id();
+    }
+
+    EXPECT_EQ(utils::Interned("scoped").id(), id);
+}
+
+TEST(InternerTest, DropsStringsOnceTheLastScopeEnds) {
+    // Dropping the strings would invalidate the handles of the other tests, thus it's done in a child process.
+    EXPECT_EXIT({
+        const auto dropped = [] {
+            uint32_t id;
+            {
+                const utils::InternScope outer;
+                {
+                    const utils::InternScope inner;
+                    id = utils::Interned("first").id();
+                    for (size_t index = 0; index < utils::InternScope::LIMIT; index++) {
+                        [[maybe_unused]] const utils::Interned name(std::to_string(index));
+                    }
+                }
+
+                // The outer scope is still running and may use its handles.
+                if (utils::Interned("first").id() != id) return false;
+            }
+
+            return utils::Interned("second").id() == 0;
+        };
+
+        std::exit(dropped() ? 0 : 1);
+    }, testing::ExitedWithCode(0), "");
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "arkoi_language/utils/output_buffer.hpp"
+
+using namespace arkoi;
+
+TEST(OutputBufferTest, FormatsLikeAStream) {
+    std::ostringstream expected;
+    expected << "text" << ' ' << true << false << int32_t{ -5 } << INT64_MIN << UINT64_MAX << 2.01 << 0.1f << 1e20;
+
+    std::ostringstream output;
+    {
+        utils::OutputBuffer buffer(output);
+        buffer << "text" << ' ' << true << false << int32_t{ -5 } << INT64_MIN << UINT64_MAX << 2.01 << 0.1f << 1e20;
+    }
+
+    EXPECT_EQ(output.str(), expected.str());
+}
+
+TEST(OutputBufferTest, WritesOnlyOnceFullOrFlushed) {
+    std::ostringstream output;
+    utils::OutputBuffer buffer(output, 8);
+
+    buffer << "1234";
+    EXPECT_EQ(output.str(), "");
+
+    buffer << "5678" << '9';
+    EXPECT_EQ(output.str(), "12345678");
+
+    // Text larger than the whole buffer is still written in order.
+    buffer << "abcdefghijklmnop";
+    EXPECT_EQ(output.str(), "123456789");
+
+    buffer.flush();
+    EXPECT_EQ(output.str(), "123456789abcdefghijklmnop");
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "arkoi_language/utils/driver.hpp"
+#include "arkoi_language/utils/server.hpp"
+
+using namespace arkoi::utils;
+using namespace arkoi;
+
+TEST(Server, ExecutesRequestsInTheDirectoryOfTheClient) {
+    const auto socket = generate_temp_path();
+    const auto directory = generate_temp_path();
+    std::filesystem::create_directories(directory);
+
+    Server server(socket);
+
+    std::vector<std::string> arguments;
+    bool served = false;
+    std::thread thread([&] {
+        served = server.serve_one([&](const Request& request, const Streams&) {
+            arguments = request.arguments;
+            std::ofstream(request.directory / "output") << "compiled";
+            return 7;
+        });
+    });
+
+    const auto previous = std::filesystem::current_path();
+    EXPECT_EQ(forward(socket, { directory, { "-S", "main.ark" } }), 7);
+    thread.join();
+
+    // The working directory is passed to the handler, the one of the server is left alone.
+    EXPECT_TRUE(served);
+    EXPECT_EQ(std::filesystem::current_path(), previous);
+    EXPECT_EQ(arguments, (std::vector<std::string>{ "-S", "main.ark" }));
+    EXPECT_TRUE(std::filesystem::exists(directory / "output"));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(Server, ExecutesRequestsConcurrently) {
+    const auto socket = generate_temp_path();
+    Server server(socket);
+
+    // Every request waits until the other one is executed as well, which never happens if they are queued.
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t running = 0;
+    const auto handler = [&](const Request&, const Streams&) {
+        std::unique_lock lock(mutex);
+        running++;
+        condition.notify_all();
+
+        return condition.wait_for(lock, std::chrono::seconds(10), [&] { return running == 2; }) ? 0 : 1;
+    };
+
+    std::thread first([&] { server.serve_one(handler); });
+    std::thread second([&] { server.serve_one(handler); });
+
+    std::optional<int32_t> first_exit, second_exit;
+    std::thread client([&] { first_exit = forward(socket, { std::filesystem::current_path(), { "first.ark" } }); });
+    second_exit = forward(socket, { std::filesystem::current_path(), { "second.ark" } });
+
+    client.join();
+    first.join();
+    second.join();
+
+    EXPECT_EQ(first_exit, 0);
+    EXPECT_EQ(second_exit, 0);
+}
+
+TEST(Server, OnlyLetsItsOwnerConnect) {
+    const auto socket = generate_temp_path();
+    const Server server(socket);
+
+    const auto permissions = std::filesystem::symlink_status(socket).permissions();
+    EXPECT_EQ(permissions, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+}
+
+TEST(Server, KeepsFilesThatAreNoSocket) {
+    const auto path = generate_temp_path();
+    std::ofstream(path) << "source";
+
+    EXPECT_THROW(Server server(path), std::system_error);
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    std::filesystem::remove(path);
+}
+
+TEST(Server, LeavesRequestsToTheClientWithoutServer) {
+    const auto socket = generate_temp_path();
+    EXPECT_EQ(forward(socket, { std::filesystem::current_path(), { "main.ark" } }), std::nullopt);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
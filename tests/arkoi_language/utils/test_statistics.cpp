@@ -0,0 +1,78 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "arkoi_language/utils/statistics.hpp"
+
+using namespace arkoi::utils;
+
+TEST(Statistics, AccumulatesCounters) {
+    Statistics statistics;
+    statistics.add("sccp", "folded-instructions", 2);
+    statistics.add("dead-code-elimination", "removed-instructions");
+    statistics.add("sccp", "folded-instructions", 3);
+
+    EXPECT_EQ(statistics.value("sccp", "folded-instructions"), 5);
+    EXPECT_EQ(statistics.value("dead-code-elimination", "removed-instructions"), 1);
+    EXPECT_EQ(statistics.value("sccp", "folded-branches"), 0);
+}
+
+TEST(Statistics, SortsCounters) {
+    Statistics statistics;
+    statistics.add("sccp", "folded-instructions");
+    statistics.add("gvn", "replaced-uses");
+    statistics.add("sccp", "folded-branches");
+
+    const auto counters = statistics.counters();
+    ASSERT_EQ(counters.size(), 3);
+
+    // The order of first use depends on the scheduling, thus they are sorted by group and name instead.
+    EXPECT_EQ(counters[0].group, "gvn");
+    EXPECT_EQ(counters[1].name, "folded-branches");
+    EXPECT_EQ(counters[2].name, "folded-instructions");
+}
+
+TEST(Statistics, PrintsOnlyCountersWithValues) {
+    Statistics statistics;
+    statistics.add("graph-coloring", "spilled-variables", 0);
+    statistics.add("peephole", "self-move", 4);
+
+    std::ostringstream output;
+    statistics.print(output);
+
+    const auto text = output.str();
+    EXPECT_NE(text.find("===== Statistics ====="), std::string::npos);
+    EXPECT_NE(text.find("self-move"), std::string::npos);
+    EXPECT_EQ(text.find("spilled-variables"), std::string::npos);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,80 @@
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+#include "arkoi_language/utils/thread_pool.hpp"
+
+using testing::Each;
+using namespace arkoi;
+
+TEST(ThreadPoolTest, InlineWithoutWorkers) {
+    utils::ThreadPool pool(1);
+    EXPECT_EQ(pool.workers(), 0);
+
+    const auto caller = std::this_thread::get_id();
+    auto future = pool.submit([] { return std::this_thread::get_id(); });
+
+    EXPECT_EQ(future.get(), caller);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    utils::ThreadPool pool(4);
+    EXPECT_EQ(pool.workers(), 4);
+
+    std::vector<std::atomic<size_t>> visits(1000);
+    pool.parallel_for(visits.size(), [&](const size_t index) { visits[index]++; });
+
+    std::vector<size_t> counts;
+    for (const auto& visit : visits) counts.push_back(visit.load());
+    EXPECT_THAT(counts, Each(1));
+}
+
+TEST(ThreadPoolTest, ParallelForRethrowsException) {
+    utils::ThreadPool pool(4);
+
+    std::atomic<size_t> finished = 0;
+    EXPECT_THROW(
+        pool.parallel_for(
+            100,
+            [&](const size_t index) {
+                if (index == 42) throw std::runtime_error("failure");
+                ++finished;
+            }
+        ),
+        std::runtime_error
+    );
+
+    EXPECT_EQ(finished.load(), 99);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "arkoi_language/utils/time_report.hpp"
+
+using namespace arkoi::utils;
+
+using namespace std::chrono_literals;
+
+TEST(TimeReport, AccumulatesRunsOfStages) {
+    TimeReport report;
+    report.record("parser", 2ms, 1ms, 16);
+    report.record("sccp", 1ms, 1ms, 0);
+    report.record("parser", 3ms, 2ms, 4);
+
+    const auto stages = report.stages();
+    ASSERT_EQ(stages.size(), 2);
+
+    // The stages are kept in the order they were first measured.
+    EXPECT_EQ(stages[0].name, "parser");
+    EXPECT_EQ(stages[0].wall, 5ms);
+    EXPECT_EQ(stages[0].cpu, 3ms);
+    EXPECT_EQ(stages[0].rss, 20);
+    EXPECT_EQ(stages[0].runs, 2);
+    EXPECT_EQ(stages[1].name, "sccp");
+}
+
+TEST(TimeReport, CountsWithoutRuns) {
+    TimeReport report;
+    report.count("register-allocation", "spill-rounds", 1);
+    report.count("register-allocation", "spilled", 3);
+    report.count("register-allocation", "spill-rounds", 1);
+
+    const auto stages = report.stages();
+    ASSERT_EQ(stages.size(), 1);
+    EXPECT_EQ(stages[0].runs, 0);
+
+    const std::vector<std::pair<std::string, size_t>> expected{ { "spill-rounds", 2 }, { "spilled", 3 } };
+    EXPECT_EQ(stages[0].counters, expected);
+}
+
+TEST(TimeReport, TimersMeasureUntilTheirDestruction) {
+    TimeReport report;
+    {
+        const TimeReport::Timer timer(&report, "scanner");
+        const TimeReport::Timer ignored(nullptr, "parser");
+    }
+
+    const auto stages = report.stages();
+    ASSERT_EQ(stages.size(), 1);
+    EXPECT_EQ(stages[0].name, "scanner");
+    EXPECT_EQ(stages[0].runs, 1);
+    EXPECT_GE(stages[0].rss, 0);
+}
+
+TEST(TimeReport, PrintsJson) {
+    TimeReport report;
+    report.record("generator", 1500ns, 1000ns, 8);
+    report.count("generator", "fragments", 2);
+    report.record("link", 10ns, 0ns, 0);
+
+    std::ostringstream output;
+    report.print_json(output);
+
+    EXPECT_EQ(output.str(), "{\"stages\":["
+                            "{\"name\":\"generator\",\"wall_ns\":1500,\"cpu_ns\":1000,\"rss_kib\":8,\"runs\":1,"
+                            "\"counters\":{\"fragments\":2}},"
+                            "{\"name\":\"link\",\"wall_ns\":10,\"cpu_ns\":0,\"rss_kib\":0,\"runs\":1,\"counters\":{}}"
+                            "]}\n");
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
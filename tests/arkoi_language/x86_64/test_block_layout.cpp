@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/layout.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::QWORD, true);
+
+/**
+ * layout() @s64:
+ *     [ entry: e = a == 0, if e ] -> [ rare ] -> [ exit ]
+ *          '-> [ header: c = i < n, if c ] -> [ body: i = i + 1 ] -> [ header ]
+ *                   '-> [ done ] -> [ exit ]
+ */
+static il::Function create_layout() {
+    const il::Variable a("a", TYPE), i("i", TYPE), n("n", TYPE);
+    const il::Variable e("e", sem::Boolean()), c("c", sem::Boolean());
+
+    il::Function function("layout", { }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* rare = function.emplace_back("rare");
+    auto* done = function.emplace_back("done");
+    auto* header = function.emplace_back("header");
+    auto* body = function.emplace_back("body");
+
+    entry->emplace_back<il::Binary>(e, a, il::Binary::Operator::Equal, il::Immediate(int64_t(0)), TYPE, std::nullopt);
+    entry->emplace_back<il::If>(e, header->label(), rare->label(), std::nullopt);
+    entry->set_next(header);
+    entry->set_branch(rare);
+
+    rare->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    rare->set_next(exit);
+
+    header->emplace_back<il::Binary>(c, i, il::Binary::Operator::LessThan, n, TYPE, std::nullopt);
+    header->emplace_back<il::If>(c, done->label(), body->label(), std::nullopt);
+    header->set_next(done);
+    header->set_branch(body);
+
+    body->emplace_back<il::Binary>(i, i, il::Binary::Operator::Add, il::Immediate(int64_t(1)), TYPE, std::nullopt);
+    body->emplace_back<il::Goto>(header->label(), std::nullopt);
+    body->set_next(header);
+
+    done->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    done->set_next(exit);
+
+    exit->emplace_back<il::Return>(i, std::nullopt);
+
+    return function;
+}
+
+static std::vector<std::string> labels(const x86_64::BlockLayout& layout) {
+    std::vector<std::string> labels;
+    for (const auto* block : layout.blocks()) labels.push_back(block->label());
+    return labels;
+}
+
+TEST(BlockLayout, EstimatesBranchProbabilities) {
+    auto function = create_layout();
+    const x86_64::BlockLayout layout(function);
+
+    auto* entry = function.entry();
+    auto* header = entry->next();
+    auto* body = header->branch();
+
+    EXPECT_DOUBLE_EQ(layout.probability(entry, entry->branch()), 1.0 - x86_64::BlockLayout::OPCODE_PROBABILITY);
+    EXPECT_DOUBLE_EQ(layout.probability(header, body), x86_64::BlockLayout::LOOP_PROBABILITY);
+    EXPECT_DOUBLE_EQ(layout.probability(body, header), 1.0);
+    EXPECT_DOUBLE_EQ(layout.probability(body, entry), 0.0);
+
+    EXPECT_TRUE(layout.is_loop_header(header));
+    EXPECT_FALSE(layout.is_loop_header(body));
+}
+
+TEST(BlockLayout, ChainsLikelySuccessorsAndMovesColdBlocksLast) {
+    auto function = create_layout();
+    const x86_64::BlockLayout layout(function);
+
+    // The loop body falls through from its header, the unlikely early exit and the loop exit come last.
+    const std::vector<std::string> expected{ function.entry()->label(), "header", "body", "rare",
+                                             function.exit()->label(), "done" };
+    EXPECT_EQ(labels(layout), expected);
+}
+
+TEST(BlockLayout, PrefersMeasuredCounts) {
+    auto function = create_layout();
+
+    // The profile shows the loop is hardly ever entered, while the early exit is taken almost always.
+    auto* entry = function.entry();
+    auto* header = entry->next();
+    auto* rare = entry->branch();
+    header->set_count(1);
+    rare->set_count(99);
+    header->branch()->set_count(0);
+    header->next()->set_count(1);
+
+    const x86_64::BlockLayout layout(function);
+    EXPECT_DOUBLE_EQ(layout.probability(entry, rare), 0.99);
+    EXPECT_DOUBLE_EQ(layout.probability(header, header->branch()), 0.0);
+
+    const std::vector<std::string> expected{ entry->label(), "rare", function.exit()->label(), "header", "done",
+                                             "body" };
+    EXPECT_EQ(labels(layout), expected);
+}
+
+TEST(BlockLayout, IgnoresCountsOfUnexecutedBranches) {
+    auto function = create_layout();
+
+    auto* header = function.entry()->next();
+    header->branch()->set_count(0);
+    header->next()->set_count(0);
+
+    const x86_64::BlockLayout layout(function);
+    EXPECT_DOUBLE_EQ(layout.probability(header, header->branch()), x86_64::BlockLayout::LOOP_PROBABILITY);
+}
+
+TEST(BlockLayout, PlacesFunctionsInTextSections) {
+    auto looping = create_layout();
+    EXPECT_EQ(x86_64::BlockLayout(looping).section(), x86_64::BlockLayout::Section::Hot);
+
+    il::Function straight("straight", { }, TYPE);
+    straight.entry()->emplace_back<il::Goto>(straight.exit()->label(), std::nullopt);
+    straight.entry()->set_next(straight.exit());
+    straight.exit()->emplace_back<il::Return>(il::Immediate(int64_t(0)), std::nullopt);
+    EXPECT_EQ(x86_64::BlockLayout(straight).section(), x86_64::BlockLayout::Section::Text);
+
+    // The profile never saw the function executed, which outweighs its loop.
+    looping.entry()->set_count(0);
+    EXPECT_EQ(x86_64::BlockLayout(looping).section(), x86_64::BlockLayout::Section::Unlikely);
+}
+
+TEST(BlockLayout, SplitsOffUnexecutedBlocks) {
+    auto function = create_layout();
+
+    auto* entry = function.entry();
+    auto* header = entry->next();
+    entry->set_count(1);
+    entry->branch()->set_count(0);
+    header->set_count(6);
+    header->branch()->set_count(5);
+    header->next()->set_count(1);
+    function.exit()->set_count(1);
+
+    const x86_64::BlockLayout layout(function);
+    ASSERT_EQ(layout.split(), layout.blocks().size() - 1);
+    EXPECT_EQ(layout.blocks().back()->label(), "rare");
+
+    // Without a profile no block is known to be unexecuted.
+    auto unmeasured = create_layout();
+    const x86_64::BlockLayout estimated(unmeasured);
+    EXPECT_EQ(estimated.split(), estimated.blocks().size());
+}
@@ -0,0 +1,247 @@
+#include <elf.h>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/encoder.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+using Opcode = Instruction::Opcode;
+
+static std::vector<uint8_t> encode(const Instruction& instruction) {
+    Encoder encoder;
+    encoder.encode({ instruction });
+    encoder.finish();
+    return encoder.section(Encoder::Section::Text).bytes;
+}
+
+TEST(Encoder, EncodesInstructions) {
+    const Register r12d(Register::Base::R12, Size::DWORD), edi(Register::Base::DI, Size::DWORD);
+    const Register ecx(Register::Base::C, Size::DWORD), rdx(Register::Base::D, Size::QWORD);
+    const Register sil(Register::Base::SI, Size::BYTE), al(Register::Base::A, Size::BYTE);
+    const Register xmm8(Register::Base::XMM8, Size::QWORD), xmm9(Register::Base::XMM9, Size::QWORD);
+    const Register r12(Register::Base::R12, Size::QWORD), r13(Register::Base::R13, Size::QWORD);
+
+    // The expected bytes are the output of the GNU assembler for the same instructions.
+    using Bytes = std::vector<uint8_t>;
+    EXPECT_EQ(encode(Instruction(Opcode::MOV, { RDI, RAX })), (Bytes{ 0x48, 0x89, 0xC7 }));
+    EXPECT_EQ(encode(Instruction(Opcode::MOV, { r12d, edi })), (Bytes{ 0x41, 0x89, 0xFC }));
+    EXPECT_EQ(encode(Instruction(Opcode::CMP, { edi, Immediate(1) })), (Bytes{ 0x83, 0xFF, 0x01 }));
+    EXPECT_EQ(encode(Instruction(Opcode::ADD, { Memory(Size::QWORD, RBP, -8), Immediate(1000) })),
+              (Bytes{ 0x48, 0x81, 0x45, 0xF8, 0xE8, 0x03, 0x00, 0x00 }));
+    EXPECT_EQ(encode(Instruction(Opcode::MOV, { sil, Immediate(true) })), (Bytes{ 0x40, 0xB6, 0x01 }));
+    EXPECT_EQ(encode(Instruction(Opcode::MOVSD, { xmm8, Memory(Size::QWORD, RSP) })),
+              (Bytes{ 0xF2, 0x44, 0x0F, 0x10, 0x04, 0x24 }));
+    EXPECT_EQ(encode(Instruction(Opcode::SETNE, { al })), (Bytes{ 0x0F, 0x95, 0xC0 }));
+    EXPECT_EQ(encode(Instruction(Opcode::PUSH, { r12 })), (Bytes{ 0x41, 0x54 }));
+    EXPECT_EQ(encode(Instruction(Opcode::MOV, { RAX, Immediate(60) })),
+              (Bytes{ 0x48, 0xC7, 0xC0, 0x3C, 0x00, 0x00, 0x00 }));
+    EXPECT_EQ(encode(Instruction(Opcode::IMUL, { ecx, Immediate(3) })), (Bytes{ 0x6B, 0xC9, 0x03 }));
+    EXPECT_EQ(encode(Instruction(Opcode::CVTSI2SD, { xmm9, r13 })), (Bytes{ 0xF2, 0x4D, 0x0F, 0x2A, 0xCD }));
+    EXPECT_EQ(encode(Instruction(Opcode::SHL, { rdx, Immediate(4) })), (Bytes{ 0x48, 0xC1, 0xE2, 0x04 }));
+    EXPECT_EQ(encode(Instruction(Opcode::LEA, { RAX, Memory(Size::QWORD, RBP, -8) })),
+              (Bytes{ 0x48, 0x8D, 0x45, 0xF8 }));
+    EXPECT_EQ(encode(Instruction(Opcode::LEA, { RAX, Memory(Size::QWORD, RDI, RSI, 4, 8) })),
+              (Bytes{ 0x48, 0x8D, 0x44, 0xB7, 0x08 }));
+    EXPECT_EQ(encode(Instruction(Opcode::LEA, { ecx, Memory(Size::QWORD, r13, r12, 1, 0) })),
+              (Bytes{ 0x43, 0x8D, 0x4C, 0x25, 0x00 }));
+    EXPECT_EQ(encode(Instruction(Opcode::CMOVL, { edi, ecx })), (Bytes{ 0x0F, 0x4C, 0xF9 }));
+    EXPECT_EQ(encode(Instruction(Opcode::CMOVA, { r12, r13 })), (Bytes{ 0x4D, 0x0F, 0x47, 0xE5 }));
+}
+
+TEST(Encoder, EncodesVexInstructions) {
+    const Register xmm0(Register::Base::XMM0, Size::QWORD), xmm1(Register::Base::XMM1, Size::QWORD);
+    const Register xmm2(Register::Base::XMM2, Size::QWORD), xmm8(Register::Base::XMM8, Size::DWORD);
+    const Register xmm9(Register::Base::XMM9, Size::QWORD), xmm10(Register::Base::XMM10, Size::DWORD);
+    const Register xmm11(Register::Base::XMM11, Size::DWORD), xmm12(Register::Base::XMM12, Size::DWORD);
+    const Register eax(Register::Base::A, Size::DWORD), ecx(Register::Base::C, Size::DWORD);
+    const Register edx(Register::Base::D, Size::DWORD), r12(Register::Base::R12, Size::QWORD);
+    const Register r13(Register::Base::R13, Size::QWORD);
+
+    // The two byte prefix is only used for the 0F map without any of the X, B or W bits.
+    using Bytes = std::vector<uint8_t>;
+    EXPECT_EQ(encode(Instruction(Opcode::VADDSD, { xmm0, xmm1, xmm2 })), (Bytes{ 0xC5, 0xF3, 0x58, 0xC2 }));
+    EXPECT_EQ(encode(Instruction(Opcode::VSUBSS, { xmm8, xmm9, Memory(Size::DWORD, RBP, -8) })),
+              (Bytes{ 0xC5, 0x32, 0x5C, 0x45, 0xF8 }));
+    EXPECT_EQ(encode(Instruction(Opcode::VXORPS, { xmm10, xmm10, xmm10 })), (Bytes{ 0xC4, 0x41, 0x28, 0x57, 0xD2 }));
+    EXPECT_EQ(encode(Instruction(Opcode::VCVTSI2SD, { xmm9, xmm9, r13 })), (Bytes{ 0xC4, 0x41, 0xB3, 0x2A, 0xCD }));
+    EXPECT_EQ(encode(Instruction(Opcode::VFMADD231SD, { xmm0, xmm1, xmm2 })),
+              (Bytes{ 0xC4, 0xE2, 0xF1, 0xB9, 0xC2 }));
+    EXPECT_EQ(encode(Instruction(Opcode::VFNMADD231SS, { xmm10, xmm11, xmm12 })),
+              (Bytes{ 0xC4, 0x42, 0x21, 0xBD, 0xD4 }));
+    EXPECT_EQ(encode(Instruction(Opcode::SHLX, { eax, ecx, edx })), (Bytes{ 0xC4, 0xE2, 0x69, 0xF7, 0xC1 }));
+    EXPECT_EQ(encode(Instruction(Opcode::SARX, { r13, Memory(Size::QWORD, RSP), r12 })),
+              (Bytes{ 0xC4, 0x62, 0x9A, 0xF7, 0x2C, 0x24 }));
+}
+
+TEST(Encoder, EncodesPackedInstructions) {
+    const Register xmm0(Register::Base::XMM0, Size::QWORD), xmm1(Register::Base::XMM1, Size::QWORD);
+    const Register xmm10(Register::Base::XMM10, Size::QWORD), xmm11(Register::Base::XMM11, Size::QWORD);
+
+    using Bytes = std::vector<uint8_t>;
+    EXPECT_EQ(encode(Instruction(Opcode::DIVPD, { xmm0, xmm1 })), (Bytes{ 0x66, 0x0F, 0x5E, 0xC1 }));
+    EXPECT_EQ(encode(Instruction(Opcode::MULPD, { xmm10, xmm11 })), (Bytes{ 0x66, 0x45, 0x0F, 0x59, 0xD3 }));
+    EXPECT_EQ(encode(Instruction(Opcode::UNPCKLPD, { xmm10, xmm1 })), (Bytes{ 0x66, 0x44, 0x0F, 0x14, 0xD1 }));
+    EXPECT_EQ(encode(Instruction(Opcode::UNPCKHPD, { xmm10, xmm10 })), (Bytes{ 0x66, 0x45, 0x0F, 0x15, 0xD2 }));
+    EXPECT_EQ(encode(Instruction(Opcode::MOVHPD, { xmm11, Memory(Size::QWORD, RBP, -8) })),
+              (Bytes{ 0x66, 0x44, 0x0F, 0x16, 0x5D, 0xF8 }));
+}
+
+TEST(Encoder, ResolvesLocalLabelsAndRelocatesOthers) {
+    Encoder encoder;
+    encoder.encode({
+        Directive(".section .text"),
+        Directive(".global main"),
+        Label("main"),
+        Instruction(Opcode::JMP, { Immediate("next") }),
+        Label("next"),
+        Instruction(Opcode::CALL, { Immediate("external") }),
+        Instruction(Opcode::MOVSD, { Register(Register::Base::XMM8, Size::QWORD), Memory(Size::QWORD, "constant") }),
+        Instruction(Opcode::RET, { }),
+        Directive(".size main, .-main"),
+        Directive(".section .data"),
+        Directive("\tconstant: .double\t1.500000"),
+    });
+    encoder.finish();
+
+    // The jump to the following label is resolved right away, its displacement is zero.
+    const auto& text = encoder.section(Encoder::Section::Text);
+    EXPECT_EQ(std::vector<uint8_t>(text.bytes.begin(), text.bytes.begin() + 5),
+              (std::vector<uint8_t>{ 0xE9, 0x00, 0x00, 0x00, 0x00 }));
+
+    ASSERT_EQ(text.relocations.size(), 2);
+    const auto& symbols = encoder.symbols();
+
+    const auto& call = text.relocations[0];
+    EXPECT_EQ(call.offset, 6);
+    EXPECT_EQ(call.type, R_X86_64_PLT32);
+    EXPECT_EQ(symbols[call.symbol].name, "external");
+    EXPECT_FALSE(symbols[call.symbol].section.has_value());
+
+    const auto& load = text.relocations[1];
+    EXPECT_EQ(load.type, R_X86_64_PC32);
+    EXPECT_EQ(load.addend, -4);
+    EXPECT_EQ(symbols[load.symbol].section, Encoder::Section::Data);
+
+    const auto& main = symbols.front();
+    EXPECT_TRUE(main.global);
+    EXPECT_EQ(main.size, text.bytes.size());
+
+    const auto& data = encoder.section(Encoder::Section::Data);
+    EXPECT_EQ(data.bytes.size(), sizeof(double));
+}
+
+TEST(Encoder, PlacesConstantsInMergeableSections) {
+    Encoder encoder;
+    encoder.encode({
+        Directive(".section .text"),
+        Instruction(Opcode::MOVSD, { Register(Register::Base::XMM0, Size::QWORD), Memory(Size::QWORD, ".Lf64.a") }),
+        Instruction(Opcode::MOVSS, { Register(Register::Base::XMM1, Size::DWORD), Memory(Size::DWORD, ".Lf32.b") }),
+        Directive(".section .rodata.cst8,\"aM\",@progbits,8"),
+        Directive("\t.p2align 3"),
+        Directive("\t.Lf64.a: .double\t1.5"),
+        Directive(".section .rodata.cst4,\"aM\",@progbits,4"),
+        Directive("\t.p2align 2"),
+        Directive("\t.Lf32.b: .float\t2"),
+    });
+    encoder.finish();
+
+    const auto& text = encoder.section(Encoder::Section::Text);
+    ASSERT_EQ(text.relocations.size(), 2);
+
+    const auto& symbols = encoder.symbols();
+    EXPECT_EQ(symbols[text.relocations[0].symbol].section, Encoder::Section::Literal8);
+    EXPECT_EQ(symbols[text.relocations[1].symbol].section, Encoder::Section::Literal4);
+
+    EXPECT_EQ(encoder.section(Encoder::Section::Literal8).bytes.size(), sizeof(double));
+    EXPECT_EQ(encoder.section(Encoder::Section::Literal4).bytes.size(), sizeof(float));
+    EXPECT_TRUE(encoder.section(Encoder::Section::Data).bytes.empty());
+}
+
+TEST(Encoder, EncodesProfileCounters) {
+    Encoder encoder;
+    encoder.encode({
+        Directive(".section .text"),
+        Label("_start"),
+        Instruction(Opcode::ADD, { Memory(Size::QWORD, "main.count"), Immediate(1) }),
+        Instruction(Opcode::LEA, { RDI, Memory(Size::QWORD, "path") }),
+        Directive(".section .data"),
+        Directive("\t.quad\t18446744073709551615"),
+        Directive("\tmain.count: .quad\t0"),
+        Directive("\tpath: .asciz\t\"a\\\"b\""),
+    });
+    encoder.finish();
+
+    const auto& text = encoder.section(Encoder::Section::Text);
+    EXPECT_EQ(text.bytes, (std::vector<uint8_t>{ 0x48, 0x83, 0x05, 0, 0, 0, 0, 0x01, 0x48, 0x8D, 0x3D, 0, 0, 0, 0 }));
+
+    // The immediate follows the displacement of the counter, which is thus one byte further away from the RIP.
+    ASSERT_EQ(text.relocations.size(), 2);
+    EXPECT_EQ(text.relocations[0].offset, 3);
+    EXPECT_EQ(text.relocations[0].addend, -5);
+    EXPECT_EQ(text.relocations[1].offset, 11);
+    EXPECT_EQ(text.relocations[1].addend, -4);
+
+    std::vector<uint8_t> expected(8, 0xFF);
+    expected.resize(16, 0);
+    expected.insert(expected.end(), { 'a', '"', 'b', 0 });
+    EXPECT_EQ(encoder.section(Encoder::Section::Data).bytes, expected);
+}
+
+TEST(Encoder, ReservesZeroInitializedMemory) {
+    Encoder encoder;
+    encoder.encode({
+        Directive(".section .text"),
+        Label("main"),
+        Instruction(Opcode::LEA, { RAX, Memory(Size::QWORD, "table") }),
+        Directive(".section .data"),
+        Directive("\tconstant: .quad\t1"),
+        Directive("\t.local small"),
+        Directive("\t.comm small, 3"),
+        Directive("\t.local table"),
+        Directive("\t.comm table, 32, 16"),
+    });
+    encoder.finish();
+
+    // The memory is reserved without leaving the data section, which keeps its own content.
+    EXPECT_EQ(encoder.section(Encoder::Section::Data).bytes.size(), 8);
+    EXPECT_EQ(encoder.section(Encoder::Section::Bss).bytes, std::vector<uint8_t>(48, 0));
+
+    const auto& text = encoder.section(Encoder::Section::Text);
+    ASSERT_EQ(text.relocations.size(), 1);
+
+    const auto& table = encoder.symbols()[text.relocations.front().symbol];
+    EXPECT_EQ(table.section, Encoder::Section::Bss);
+    EXPECT_EQ(table.offset, 16);
+    EXPECT_EQ(table.size, 32);
+}
+
+TEST(Encoder, RelocatesJumpsBetweenTextSections) {
+    Encoder encoder;
+    encoder.encode({
+        Directive(".section .text.hot,\"ax\",@progbits"),
+        Directive(".global main"),
+        Label("main"),
+        Instruction(Opcode::JNZ, { Immediate("main.L1") }),
+        Instruction(Opcode::RET, { }),
+        Directive(".size main, .-main"),
+        Directive(".section .text.unlikely,\"ax\",@progbits"),
+        Label("main.cold"),
+        Label("main.L1"),
+        Instruction(Opcode::JMP, { Immediate("main") }),
+        Directive(".size main.cold, .-main.cold"),
+    });
+    encoder.finish();
+
+    EXPECT_TRUE(encoder.section(Encoder::Section::Text).bytes.empty());
+
+    // Each section is placed on its own by the linker, which has to resolve the jumps between them.
+    const auto& hot = encoder.section(Encoder::Section::Hot);
+    ASSERT_EQ(hot.relocations.size(), 1);
+    EXPECT_EQ(encoder.symbols()[hot.relocations[0].symbol].section, Encoder::Section::Unlikely);
+
+    const auto& unlikely = encoder.section(Encoder::Section::Unlikely);
+    ASSERT_EQ(unlikely.relocations.size(), 1);
+    EXPECT_EQ(encoder.symbols()[unlikely.relocations[0].symbol].section, Encoder::Section::Hot);
+}
@@ -0,0 +1,117 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/fragment.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+using Opcode = Instruction::Opcode;
+
+static std::string print(const std::vector<AssemblyItem>& items) {
+    std::stringstream output;
+    for (const auto& item : items) output << item << "\n";
+    return output.str();
+}
+
+static Fragment emplace_fragment() {
+    const Register xmm0(Register::Base::XMM0, Size::QWORD);
+
+    Fragment fragment;
+    fragment.text = {
+        Directive(".global main"),
+        Label("main"),
+        Instruction(Opcode::MOV, { Memory(Size::QWORD, RBP, -16), Immediate(int64_t{ -1 }) }),
+        Instruction(Opcode::MOVSD, { xmm0, Memory(Size::QWORD, ".Lf64.3ff8000000000000") }),
+        Instruction(Opcode::CALL, { Immediate("add_one") }),
+        Instruction(Opcode::JNZ, { Immediate("main.L1") }),
+        Instruction(Opcode::CALL, { Immediate("add_one") }),
+        Label("main.L1"),
+        Instruction(Opcode::JMP, { Immediate("sub_one") }),
+    };
+    fragment.data = { Directive("\t.local main.table"), Directive("\t.comm main.table, 16384, 16") };
+    fragment.constants = { Directive("\t.Lf64.3ff8000000000000: .double\t1.5") };
+
+    return fragment;
+}
+
+TEST(Fragment, RoundTripsThroughItsSerialization) {
+    const auto fragment = emplace_fragment();
+
+    std::stringstream stream;
+    fragment.write(stream);
+
+    const auto read = Fragment::read(stream);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(print(read->text), print(fragment.text));
+    EXPECT_EQ(print(read->data), print(fragment.data));
+    EXPECT_EQ(print(read->constants), print(fragment.constants));
+}
+
+TEST(Fragment, RejectsTruncatedInput) {
+    std::stringstream stream;
+    emplace_fragment().write(stream);
+
+    auto bytes = stream.str();
+    bytes.resize(bytes.size() / 2);
+
+    std::istringstream truncated(bytes);
+    EXPECT_FALSE(Fragment::read(truncated).has_value());
+}
+
+TEST(Fragment, CollectsCalleesWithoutBlockLabels) {
+    const std::vector<std::string> expected{ "add_one", "sub_one" };
+    EXPECT_EQ(emplace_fragment().callees(), expected);
+}
+
+TEST(Fragment, OrdersFragmentsAlongTheirCalls) {
+    const auto calling = [](const std::vector<std::string>& callees) {
+        Fragment fragment;
+        for (const auto& callee : callees) fragment.text.emplace_back(Instruction(Opcode::CALL, { Immediate(callee) }));
+        return fragment;
+    };
+
+    const auto unused = calling({ "leaf" });
+    const auto leaf = calling({ });
+    const auto helper = calling({ "leaf", "main" });
+    const auto main = calling({ "helper", "leaf", "printf" });
+
+    const auto order = Fragment::call_order({ { "unused", &unused }, { "leaf", &leaf }, { "helper", &helper },
+                                              { "main", &main } });
+
+    // The walk starts at main and follows its first callee, the unused fragment keeps its place after them.
+    const std::vector<const Fragment*> expected{ &main, &helper, &leaf, &unused };
+    EXPECT_EQ(order, expected);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
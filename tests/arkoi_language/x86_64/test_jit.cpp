@@ -0,0 +1,65 @@
+#include <bit>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/jit.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+using Opcode = Instruction::Opcode;
+
+static const Register EAX(Register::Base::A, Size::DWORD);
+
+static Encoder encode(const std::vector<AssemblyItem>& items) {
+    Encoder encoder;
+    encoder.encode(items);
+    encoder.finish();
+    return encoder;
+}
+
+TEST(Jit, ResolvesReferencesBetweenModules) {
+    const auto caller = encode({
+        Directive(".section .text"),
+        Directive(".global main"),
+        Label("main"),
+        Instruction(Opcode::CALL, { Immediate("helper") }),
+        Instruction(Opcode::ADD, { EAX, Immediate(2) }),
+        Instruction(Opcode::RET, { }),
+    });
+    const auto callee = encode({
+        Directive(".section .text"),
+        Directive(".global helper"),
+        Label("helper"),
+        Instruction(Opcode::MOV, { EAX, Memory(Size::DWORD, "constant") }),
+        Instruction(Opcode::RET, { }),
+        Directive(".section .data"),
+        Directive("\tconstant: .float\t1.500000"),
+    });
+
+    Jit jit;
+    jit.add(caller);
+    jit.add(callee);
+    jit.load();
+
+    // The callee returns the bits of the constant, which are loaded from the data section.
+    EXPECT_EQ(jit.entry("main")() & 0xFFFFFFFF, std::bit_cast<uint32_t>(1.5f) + 2);
+}
+
+TEST(Jit, RejectsUnresolvableSymbols) {
+    const auto module = encode({
+        Directive(".section .text"),
+        Directive(".global main"),
+        Label("main"),
+        Instruction(Opcode::JMP, { Immediate("missing") }),
+    });
+
+    Jit undefined;
+    undefined.add(module);
+    EXPECT_THROW(undefined.load(), std::invalid_argument);
+
+    Jit duplicate;
+    duplicate.add(module);
+    duplicate.add(module);
+    EXPECT_THROW(duplicate.load(), std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/allocator.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::QWORD, true);
+
+/**
+ * pressure() @s64:
+ *     [ entry: a0 = 0 ... an = n, s1 = a0 + a1 ... sn = sn-1 + an ] -> [ exit: ret sn ]
+ */
+static il::Function create_pressure(const size_t count) {
+    il::Function function("pressure", { }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    std::vector<il::Variable> values;
+    for (size_t index = 0; index < count; index++) {
+        const il::Variable value("a" + std::to_string(index), TYPE);
+        entry->emplace_back<il::Assign>(value, il::Immediate(static_cast<int64_t>(index)), std::nullopt);
+        values.push_back(value);
+    }
+
+    il::Variable sum = values.front();
+    for (size_t index = 1; index < count; index++) {
+        const il::Variable next("s" + std::to_string(index), TYPE);
+        entry->emplace_back<il::Binary>(next, sum, il::Binary::Operator::Add, values[index], TYPE, std::nullopt);
+        sum = next;
+    }
+
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(sum, std::nullopt);
+
+    return function;
+}
+
+TEST(LinearScanAllocator, AssignsEveryVariableWithoutPressure) {
+    auto function = create_pressure(4);
+
+    x86_64::LinearScanAllocator allocator(function);
+    allocator.run();
+
+    EXPECT_TRUE(allocator.spilled().empty());
+    EXPECT_EQ(allocator.assigned().size(), 4 + 3);
+
+    // All four values are live at the same time
+    std::set<x86_64::Register::Base> registers;
+    for (size_t index = 0; index < 4; index++) {
+        registers.insert(allocator.assigned().at(il::Variable("a" + std::to_string(index), TYPE)));
+    }
+    EXPECT_EQ(registers.size(), 4);
+
+    // The returned value is pre-colored with the return register
+    EXPECT_EQ(allocator.assigned().at(il::Variable("s3", TYPE)), x86_64::Register::Base::A);
+}
+
+TEST(LinearScanAllocator, SpillsUnderPressure) {
+    auto function = create_pressure(15);
+
+    x86_64::LinearScanAllocator allocator(function);
+    allocator.run();
+
+    // Only twelve integer registers are available in total
+    EXPECT_EQ(allocator.spilled().size(), 3);
+
+    std::set<x86_64::Register::Base> registers;
+    for (size_t index = 0; index < 15; index++) {
+        const il::Variable value("a" + std::to_string(index), TYPE);
+        if (allocator.spilled().contains(value)) continue;
+
+        registers.insert(allocator.assigned().at(value));
+    }
+    EXPECT_EQ(registers.size(), 12);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,119 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/peephole.hpp"
+
+using namespace arkoi::x86_64;
+using namespace arkoi;
+
+using Opcode = Instruction::Opcode;
+
+static std::string print(const std::vector<AssemblyItem>& items) {
+    std::stringstream output;
+    for (const auto& item : items) output << item << "\n";
+    return output.str();
+}
+
+TEST(PeepholeOptimizer, RemovesRedundantMoves) {
+    const Register rcx(Register::Base::C, Size::QWORD), eax(Register::Base::A, Size::DWORD);
+    const Memory slot(Size::QWORD, RBP, -8);
+
+    std::vector<AssemblyItem> items{
+        Instruction(Opcode::MOV, { RAX, RAX }),
+        Instruction(Opcode::MOV, { eax, eax }),
+        Instruction(Opcode::MOV, { slot, RAX }),
+        Directive("\t# comment"),
+        Instruction(Opcode::MOV, { RAX, slot }),
+        Instruction(Opcode::MOV, { slot, RAX }),
+        Instruction(Opcode::MOV, { rcx, slot }),
+    };
+
+    PeepholeOptimizer peephole;
+    peephole.run(items);
+
+    // A 32-bit move to itself still clears the upper half of the register.
+    EXPECT_EQ(print(items), "\tmov eax, eax\n"
+                            "\tmov QWORD PTR [rbp - 8], rax\n"
+                            "\t# comment\n"
+                            "\tmov QWORD PTR [rbp - 8], rax\n"
+                            "\tmov rcx, rax\n");
+    EXPECT_EQ(peephole.hits("self-move"), 1);
+    EXPECT_EQ(peephole.hits("reverse-move"), 1);
+    EXPECT_EQ(peephole.hits("store-load"), 1);
+}
+
+TEST(PeepholeOptimizer, FusesCompareAndBranch) {
+    const Register al(Register::Base::A, Size::BYTE);
+
+    std::vector<AssemblyItem> items{
+        Instruction(Opcode::CMP, { RDI, Immediate(1u) }),
+        Instruction(Opcode::SETBE, { al }),
+        Instruction(Opcode::TEST, { al, al }),
+        Instruction(Opcode::JNZ, { Immediate("L1") }),
+        Instruction(Opcode::JMP, { Immediate("L2") }),
+        Label("L1"),
+        Instruction(Opcode::JMP, { Immediate("L2") }),
+        Label("L2"),
+        Instruction(Opcode::RET, { }),
+    };
+
+    PeepholeOptimizer peephole;
+    peephole.run(items);
+
+    EXPECT_EQ(print(items), "\tcmp rdi, 1\n"
+                            "\tsetbe al\n"
+                            "\tja L2\n"
+                            "L1:\n"
+                            "L2:\n"
+                            "\tret\n");
+    EXPECT_EQ(peephole.hits("compare-and-branch"), 1);
+    EXPECT_EQ(peephole.hits("branch-over-jump"), 1);
+    EXPECT_EQ(peephole.hits("jump-to-next"), 1);
+}
+
+TEST(PeepholeOptimizer, SkipsDisabledRules) {
+    std::vector<AssemblyItem> items{
+        Instruction(Opcode::JMP, { Immediate("L1") }),
+        Label("L1"),
+    };
+
+    PeepholeOptimizer peephole;
+    EXPECT_TRUE(peephole.disable("jump-to-next"));
+    EXPECT_FALSE(peephole.disable("unknown"));
+    peephole.run(items);
+
+    EXPECT_EQ(items.size(), 2);
+    EXPECT_EQ(peephole.hits("jump-to-next"), 0);
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <ranges>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/allocator.hpp"
+
+using namespace arkoi;
+
+static const sem::Type TYPE = sem::Integral(Size::QWORD, true);
+
+/**
+ * copy() @s64:
+ *     [ entry: a = 1, b = a, t = b * 2, c = t + a ] -> [ exit: ret c ]
+ */
+static il::Function create_copy() {
+    const il::Variable a("a", TYPE), b("b", TYPE), t("t", TYPE), c("c", TYPE);
+
+    il::Function function("copy", { }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Assign>(a, il::Immediate(int64_t(1)), std::nullopt);
+    entry->emplace_back<il::Assign>(b, a, std::nullopt);
+    entry->emplace_back<il::Binary>(t, b, il::Binary::Operator::Mul, il::Immediate(int64_t(2)), TYPE, std::nullopt);
+    entry->emplace_back<il::Binary>(c, t, il::Binary::Operator::Add, a, TYPE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(c, std::nullopt);
+
+    return function;
+}
+
+TEST(RegisterAllocator, CoalescesMoveWithLiveSource) {
+    auto function = create_copy();
+
+    x86_64::RegisterAllocator allocator(function);
+    allocator.run();
+
+    const auto& assigned = allocator.assigned();
+    EXPECT_TRUE(allocator.spilled().empty());
+    EXPECT_EQ(assigned.at(il::Variable("a", TYPE)), assigned.at(il::Variable("b", TYPE)));
+    EXPECT_EQ(assigned.at(il::Variable("c", TYPE)), x86_64::Register::Base::A);
+}
+
+TEST(RegisterAllocator, KeepsInterferingCopiesApart) {
+    auto function = create_copy();
+
+    // Redefining the source while the copy is still alive makes them interfere.
+    const il::Variable a("a", TYPE), b("b", TYPE);
+    auto& instructions = function.entry()->instructions();
+    instructions.insert(
+        std::next(instructions.begin(), 2),
+        il::Binary(a, a, il::Binary::Operator::Add, il::Immediate(int64_t(1)), TYPE, std::nullopt)
+    );
+
+    x86_64::RegisterAllocator allocator(function);
+    allocator.run();
+
+    const auto& assigned = allocator.assigned();
+    EXPECT_TRUE(allocator.spilled().empty());
+    EXPECT_NE(assigned.at(a), assigned.at(b));
+}
+
+/**
+ * loop() @s64:
+ *     [ entry: a0 = 0 ... a13 = 13 ] -> [ loop: a0 = a0 + 1, c = a0 != 10, if c ] -> [ after: s = a0 + ... + a13 ] -> [ exit ]
+ *                                      ^-------------------------------------'
+ */
+static il::Function create_loop() {
+    il::Function function("loop", { }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* loop = function.emplace_back("loop");
+    auto* after = function.emplace_back("after");
+
+    std::vector<il::Variable> values;
+    for (size_t index = 0; index < 14; index++) {
+        const il::Variable value("a" + std::to_string(index), TYPE);
+        entry->emplace_back<il::Assign>(value, il::Immediate(static_cast<int64_t>(index)), std::nullopt);
+        values.push_back(value);
+    }
+    entry->emplace_back<il::Goto>(loop->label(), std::nullopt);
+    entry->set_next(loop);
+
+    const il::Variable condition("c", sem::Boolean());
+    loop->emplace_back<il::Binary>(values[0], values[0], il::Binary::Operator::Add, il::Immediate(int64_t(1)), TYPE,
+                                   std::nullopt);
+    loop->emplace_back<il::Binary>(condition, values[0], il::Binary::Operator::NotEqual, il::Immediate(int64_t(10)),
+                                   TYPE, std::nullopt);
+    loop->emplace_back<il::If>(condition, after->label(), loop->label(), std::nullopt);
+    loop->set_next(after);
+    loop->set_branch(loop);
+
+    il::Variable sum = values[0];
+    for (size_t index = 1; index < values.size(); index++) {
+        const il::Variable next("s" + std::to_string(index), TYPE);
+        after->emplace_back<il::Binary>(next, sum, il::Binary::Operator::Add, values[index], TYPE, std::nullopt);
+        sum = next;
+    }
+    after->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    after->set_next(exit);
+
+    exit->emplace_back<il::Return>(sum, std::nullopt);
+
+    return function;
+}
+
+TEST(RegisterAllocator, KeepsLoopVariablesInRegisters) {
+    auto function = create_loop();
+
+    x86_64::RegisterAllocator allocator(function);
+    allocator.run();
+
+    // Fifteen values are live in the loop, but only twelve registers are available. The three constants that
+    // don't fit are recomputed after the loop instead of being spilled.
+    EXPECT_TRUE(allocator.spilled().empty());
+    EXPECT_EQ(allocator.rematerialized(), 3);
+    EXPECT_EQ(allocator.rounds(), 1);
+    EXPECT_TRUE(allocator.assigned().contains(il::Variable("a0", TYPE)));
+    EXPECT_TRUE(allocator.assigned().contains(il::Variable("c", sem::Boolean())));
+}
+
+/**
+ * phases($p.0 @s64) @s64:
+ *     [ entry: a0 = p + 0 ... a13 = p + 13, s = a0 + ... + a13, b0 = p + 0 ... t = b0 + ... + b13, r = s + t ] -> [ exit ]
+ */
+static il::Function create_phases() {
+    const il::Variable parameter("p", TYPE);
+
+    il::Function function("phases", { parameter }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    auto add_phase = [&](const std::string& name) {
+        std::vector<il::Variable> values;
+        for (size_t index = 0; index < 14; index++) {
+            // The values aren't constant, thus they can't be recomputed instead of being spilled.
+            const il::Variable value(name + std::to_string(index), TYPE);
+            entry->emplace_back<il::Binary>(
+                value, parameter, il::Binary::Operator::Add, il::Immediate(static_cast<int64_t>(index)), TYPE,
+                std::nullopt
+            );
+            values.push_back(value);
+        }
+
+        il::Variable sum = values[0];
+        for (size_t index = 1; index < values.size(); index++) {
+            const il::Variable next(name + "s" + std::to_string(index), TYPE);
+            entry->emplace_back<il::Binary>(next, sum, il::Binary::Operator::Add, values[index], TYPE, std::nullopt);
+            sum = next;
+        }
+
+        return sum;
+    };
+
+    const auto first = add_phase("a");
+    const auto second = add_phase("b");
+
+    const il::Variable result("r", TYPE);
+    entry->emplace_back<il::Binary>(result, first, il::Binary::Operator::Add, second, TYPE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(result, std::nullopt);
+
+    return function;
+}
+
+TEST(RegisterAllocator, SharesSpillSlots) {
+    auto function = create_phases();
+
+    x86_64::RegisterAllocator allocator(function);
+    allocator.run();
+
+    ASSERT_FALSE(allocator.spilled().empty());
+    ASSERT_EQ(allocator.slots().size(), allocator.spilled().size());
+
+    std::set<size_t> slots;
+    for (const auto& slot : std::views::values(allocator.slots())) slots.insert(slot);
+    EXPECT_LT(slots.size(), allocator.spilled().size());
+}
+
+/**
+ * call() @s64:
+ *     [ entry: f = 1.5, i = 3, r = call other, g = f * 2.0, s = r + i ] -> [ exit: ret s ]
+ */
+static il::Function create_call() {
+    const sem::Type FLOATING = sem::Floating(Size::QWORD);
+    const il::Variable f("f", FLOATING), g("g", FLOATING), i("i", TYPE), r("r", TYPE), sum("s", TYPE);
+
+    il::Function function("call", { }, TYPE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Assign>(f, il::Immediate(1.5), std::nullopt);
+    entry->emplace_back<il::Assign>(i, il::Immediate(int64_t(3)), std::nullopt);
+    entry->emplace_back<il::Call>(r, "other", std::vector<il::Operand>{ }, std::nullopt);
+    entry->emplace_back<il::Binary>(g, f, il::Binary::Operator::Mul, il::Immediate(2.0), FLOATING, std::nullopt);
+    entry->emplace_back<il::Binary>(sum, r, il::Binary::Operator::Add, i, TYPE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(sum, std::nullopt);
+
+    return function;
+}
+
+TEST(RegisterAllocator, KeepsValuesAcrossCallsInCalleeSavedRegisters) {
+    auto function = create_call();
+
+    x86_64::RegisterAllocator allocator(function);
+    allocator.run();
+
+    const auto& callee_saved = x86_64::INTEGER_CALLEE_SAVED;
+    EXPECT_NE(std::ranges::find(callee_saved, allocator.assigned().at(il::Variable("i", TYPE))), callee_saved.end());
+
+    // No XMM register is preserved by a call, thus the constant is recomputed after it instead of being spilled.
+    EXPECT_FALSE(allocator.spilled().contains(il::Variable("f", sem::Floating(Size::QWORD))));
+    EXPECT_EQ(allocator.rematerialized(), 1);
+}
+
+/**
+ * split($p.0 @f64) @f64:
+ *     [ entry: x = p, r = call other, a = x * x, b = a + x ] -> [ exit: ret b ]
+ */
+TEST(RegisterAllocator, SplitsSpilledValuesBetweenCalls) {
+    const sem::Type FLOATING = sem::Floating(Size::QWORD);
+    const il::Variable p("p", FLOATING), x("x", FLOATING), r("r", TYPE), a("a", FLOATING), b("b", FLOATING);
+
+    il::Function function("split", { p }, FLOATING);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Assign>(x, p, std::nullopt);
+    entry->emplace_back<il::Call>(r, "other", std::vector<il::Operand>{ }, std::nullopt);
+    entry->emplace_back<il::Binary>(a, x, il::Binary::Operator::Mul, x, FLOATING, std::nullopt);
+    entry->emplace_back<il::Binary>(b, a, il::Binary::Operator::Add, x, FLOATING, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(b, std::nullopt);
+
+    x86_64::RegisterAllocator allocator(function);
+    allocator.run();
+
+    // The value lives across the call, thus it stays in memory, but its uses after the call share a copy.
+    EXPECT_TRUE(allocator.spilled().contains(x));
+    EXPECT_EQ(allocator.split_ranges(), 1);
+
+    auto& copy = std::get<il::Assign>(entry->instructions()[2]);
+    EXPECT_EQ(std::get<il::Variable>(copy.value()), x);
+    EXPECT_TRUE(allocator.assigned().contains(copy.result()));
+}
+
+//==============================================================================
+// BSD 3-Clause License
+//
+// Copyright (c) 2025, Timo Behrend
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==============================================================================
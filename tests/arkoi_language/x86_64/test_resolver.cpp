@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/resolver.hpp"
+
+using namespace arkoi;
+
+static const sem::Type BOOLEAN = sem::Boolean();
+static const sem::Type DWORD = sem::Integral(Size::DWORD, false);
+static const sem::Type QWORD = sem::Integral(Size::QWORD, true);
+
+/**
+ * mixed() @s64:
+ *     [ entry: a = true, b = 2, c = 3, d = b + 2 ] -> [ exit: ret d ]
+ */
+static il::Function create_mixed() {
+    const il::Variable a("a", BOOLEAN), b("b", QWORD), c("c", DWORD), d("d", QWORD);
+
+    il::Function function("mixed", { }, QWORD);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Assign>(a, il::Immediate(true), std::nullopt);
+    entry->emplace_back<il::Assign>(b, il::Immediate(int64_t(2)), std::nullopt);
+    entry->emplace_back<il::Assign>(c, il::Immediate(uint32_t(3)), std::nullopt);
+    entry->emplace_back<il::Binary>(d, b, il::Binary::Operator::Add, il::Immediate(int64_t(2)), QWORD, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    exit->emplace_back<il::Return>(d, std::nullopt);
+
+    return function;
+}
+
+static x86_64::Memory slot_of(const x86_64::Resolver& resolver, const il::Variable& variable) {
+    const auto operand = resolver[variable];
+    EXPECT_TRUE(std::holds_alternative<x86_64::Memory>(operand));
+    return std::get<x86_64::Memory>(operand);
+}
+
+TEST(Resolver, AlignsPackedSlots) {
+    auto function = create_mixed();
+
+    x86_64::Resolver resolver;
+    resolver.run(function, { });
+
+    // Every local has its own slot, which are ordered by size: 8 + 8 + 4 + 1 bytes.
+    EXPECT_EQ(resolver.stack_size(), 32);
+
+    for (const auto& variable : { il::Variable("a", BOOLEAN), il::Variable("b", QWORD), il::Variable("c", DWORD) }) {
+        const auto bytes = static_cast<int64_t>(size_to_bytes(variable.type().size()));
+        EXPECT_EQ(slot_of(resolver, variable).displacement() % bytes, 0) << variable;
+    }
+}
+
+TEST(Resolver, SharesSlotsOfDifferentSizes) {
+    auto function = create_mixed();
+
+    const il::Variable a("a", BOOLEAN), b("b", QWORD), c("c", DWORD), d("d", QWORD);
+
+    x86_64::Resolver resolver;
+    resolver.run(function, { }, { { a, 0 }, { c, 0 }, { b, 1 }, { d, 1 } });
+
+    // The shared slots are as large as their largest member: 8 + 4 bytes.
+    EXPECT_EQ(resolver.stack_size(), 16);
+    EXPECT_EQ(slot_of(resolver, a).displacement(), slot_of(resolver, c).displacement());
+    EXPECT_EQ(slot_of(resolver, b).displacement(), slot_of(resolver, d).displacement());
+    EXPECT_NE(slot_of(resolver, a).displacement(), slot_of(resolver, b).displacement());
+}
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/scheduler.hpp"
+
+using namespace arkoi;
+
+static const sem::Type DOUBLE = sem::Floating(Size::QWORD);
+
+static const il::Variable A("a", DOUBLE), B("b", DOUBLE), C("c", DOUBLE), D("d", DOUBLE), Q("q", DOUBLE),
+        R("r", DOUBLE), S("s", DOUBLE), T("t", DOUBLE), U("u", DOUBLE);
+
+static il::Operand result_at(il::BasicBlock* block, const size_t index) {
+    return block->instructions()[index].defs().front();
+}
+
+TEST(Scheduler, HidesDivisionLatency) {
+    // latency(a @f64, b @f64, c @f64, d @f64) @f64:
+    //     [ entry: q = a / b, r = q + c, s = c * d, t = s * d, u = r / t ] -> [ exit: ret u ]
+    il::Function function("latency", { A, B, C, D }, DOUBLE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Binary>(Q, A, il::Binary::Operator::Div, B, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(R, Q, il::Binary::Operator::Add, C, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(S, C, il::Binary::Operator::Mul, D, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(T, S, il::Binary::Operator::Mul, D, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(U, R, il::Binary::Operator::Div, T, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+    exit->emplace_back<il::Return>(U, std::nullopt);
+
+    const x86_64::Scheduler scheduler(function);
+    EXPECT_EQ(scheduler.moved(), 3);
+
+    // The independent products are computed while the division is still in flight.
+    EXPECT_EQ(result_at(entry, 0), il::Operand(Q));
+    EXPECT_EQ(result_at(entry, 1), il::Operand(S));
+    EXPECT_EQ(result_at(entry, 2), il::Operand(T));
+    EXPECT_EQ(result_at(entry, 3), il::Operand(R));
+    EXPECT_EQ(result_at(entry, 4), il::Operand(U));
+    EXPECT_TRUE(std::holds_alternative<il::Goto>(entry->instructions().back()));
+}
+
+TEST(Scheduler, KeepsComparisonInFrontOfBranch) {
+    const il::Variable condition("condition", sem::Boolean());
+
+    // compare(a @f64, b @f64) @f64:
+    //     [ entry: q = a / b, r = q + a, condition = a < b, if condition ] -> [ exit: ret r ]
+    il::Function function("compare", { A, B }, DOUBLE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+    auto* then = function.emplace_back("then");
+
+    entry->emplace_back<il::Binary>(Q, A, il::Binary::Operator::Div, B, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(R, Q, il::Binary::Operator::Add, A, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(condition, A, il::Binary::Operator::LessThan, B, DOUBLE, std::nullopt);
+    entry->emplace_back<il::If>(condition, then->label(), exit->label(), std::nullopt);
+    entry->set_next(then);
+    entry->set_branch(exit);
+
+    then->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    then->set_next(exit);
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    // The comparison would fill the latency of the division, but its flags have to survive until the branch.
+    const x86_64::Scheduler scheduler(function);
+    EXPECT_EQ(scheduler.moved(), 0);
+    EXPECT_EQ(result_at(entry, 2), il::Operand(condition));
+}
+
+TEST(Scheduler, EstimatesLatencies) {
+    const sem::Type INTEGER = sem::Integral(Size::QWORD, true);
+    const il::Variable n("n", INTEGER), m("m", INTEGER);
+
+    const il::Instruction division = il::Binary(n, n, il::Binary::Operator::Div, m, INTEGER, std::nullopt);
+    const il::Instruction addition = il::Binary(n, n, il::Binary::Operator::Add, m, INTEGER, std::nullopt);
+    const il::Instruction conversion = il::Cast(Q, n, INTEGER, std::nullopt);
+
+    EXPECT_GT(x86_64::Scheduler::latency(division), x86_64::Scheduler::latency(conversion));
+    EXPECT_GT(x86_64::Scheduler::latency(conversion), x86_64::Scheduler::latency(addition));
+    EXPECT_EQ(x86_64::Scheduler::latency(addition), 1);
+}
@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/selector.hpp"
+
+using namespace arkoi;
+
+static const sem::Type QWORD = sem::Integral(Size::QWORD, true);
+
+static const il::Variable A("a", QWORD), B("b", QWORD), T("t", QWORD), U("u", QWORD), R("r", QWORD);
+
+/**
+ * address(a @s64, b @s64) @s64:
+ *     [ entry: t = b * 4, u = a + t, r = u + 8 ] -> [ exit: ret r ]
+ */
+static il::Function create_address(const bool reuse) {
+    il::Function function("address", { A, B }, QWORD);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Binary>(T, B, il::Binary::Operator::Mul, il::Immediate(int64_t(4)), QWORD, std::nullopt);
+    entry->emplace_back<il::Binary>(U, A, il::Binary::Operator::Add, T, QWORD, std::nullopt);
+    entry->emplace_back<il::Binary>(R, U, il::Binary::Operator::Add, il::Immediate(int64_t(8)), QWORD, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+
+    // Another use keeps the scaled index alive, thus it can't be folded anymore.
+    if (reuse) {
+        exit->emplace_back<il::Binary>(R, R, il::Binary::Operator::Add, T, QWORD, std::nullopt);
+    }
+    exit->emplace_back<il::Return>(R, std::nullopt);
+
+    return function;
+}
+
+static const x86_64::Mapping MAPPING{
+    { A, x86_64::Register::Base::DI },
+    { B, x86_64::Register::Base::SI },
+    { T, x86_64::Register::Base::C },
+    { U, x86_64::Register::Base::D },
+    { R, x86_64::Register::Base::A },
+};
+
+static auto& instruction_at(il::BasicBlock* block, const size_t index) {
+    return std::get<il::Binary>(block->instructions()[index]);
+}
+
+TEST(InstructionSelector, FoldsTreesIntoOneAddress) {
+    auto function = create_address(false);
+
+    x86_64::Resolver resolver;
+    resolver.run(function, MAPPING);
+
+    const x86_64::InstructionSelector selector(function, resolver);
+    EXPECT_EQ(selector.selected(), 1);
+    EXPECT_EQ(selector.folded(), 2);
+
+    auto* entry = function.entry();
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 0)));
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 1)));
+
+    const auto* address = selector.address(instruction_at(entry, 2));
+    ASSERT_NE(address, nullptr);
+    EXPECT_EQ(address->base, A);
+    EXPECT_EQ(address->index, B);
+    EXPECT_EQ(address->scale, 4);
+    EXPECT_EQ(address->displacement, 8);
+}
+
+TEST(InstructionSelector, KeepsOperandsWithOtherUses) {
+    auto function = create_address(true);
+
+    x86_64::Resolver resolver;
+    resolver.run(function, MAPPING);
+
+    const x86_64::InstructionSelector selector(function, resolver);
+
+    // The scaled index is computed on its own, the rest still folds into a single address.
+    auto* entry = function.entry();
+    EXPECT_FALSE(selector.is_folded(instruction_at(entry, 0)));
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 1)));
+
+    const auto* address = selector.address(instruction_at(entry, 2));
+    ASSERT_NE(address, nullptr);
+    EXPECT_EQ(address->base, A);
+    EXPECT_EQ(address->index, T);
+    EXPECT_EQ(address->scale, 1);
+    EXPECT_EQ(address->displacement, 8);
+
+    // The result already shares the register of its left operand, which an addition updates in place.
+    EXPECT_EQ(selector.address(instruction_at(function.exit(), 0)), nullptr);
+}
+
+TEST(InstructionSelector, ContractsMultiplyAdd) {
+    const sem::Type DOUBLE = sem::Floating(Size::QWORD);
+    const il::Variable x("x", DOUBLE), y("y", DOUBLE), z("z", DOUBLE), p("p", DOUBLE), s("s", DOUBLE);
+
+    // contract(x @f64, y @f64, z @f64) @f64: [ entry: p = x * y, s = z - p ] -> [ exit: ret s ]
+    il::Function function("contract", { x, y, z }, DOUBLE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Binary>(p, x, il::Binary::Operator::Mul, y, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(s, z, il::Binary::Operator::Sub, p, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+    exit->emplace_back<il::Return>(s, std::nullopt);
+
+    const x86_64::Mapping mapping{
+        { x, x86_64::Register::Base::XMM0 },
+        { y, x86_64::Register::Base::XMM1 },
+        { z, x86_64::Register::Base::XMM2 },
+        { p, x86_64::Register::Base::XMM3 },
+        { s, x86_64::Register::Base::XMM0 },
+    };
+
+    x86_64::Resolver resolver;
+    resolver.run(function, mapping);
+
+    // Without contraction the product is rounded on its own.
+    const x86_64::InstructionSelector separate(function, resolver);
+    EXPECT_EQ(separate.contracted(), 0);
+    EXPECT_EQ(separate.fused(instruction_at(entry, 1)), nullptr);
+
+    const x86_64::InstructionSelector selector(function, resolver, true);
+    EXPECT_EQ(selector.contracted(), 1);
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 0)));
+
+    const auto* pattern = selector.fused(instruction_at(entry, 1));
+    ASSERT_NE(pattern, nullptr);
+    EXPECT_EQ(pattern->left, il::Operand(x));
+    EXPECT_EQ(pattern->right, il::Operand(y));
+    EXPECT_EQ(pattern->addend, il::Operand(z));
+    EXPECT_EQ(pattern->kind, x86_64::FusedPattern::Kind::NegatedAdd);
+}
+
+TEST(InstructionSelector, PacksDivisionPairs) {
+    const sem::Type DOUBLE = sem::Floating(Size::QWORD);
+    const il::Variable a("a", DOUBLE), b("b", DOUBLE), c("c", DOUBLE), p("p", DOUBLE), q("q", DOUBLE);
+    const il::Variable s("s", DOUBLE), t("t", DOUBLE), r("r", DOUBLE);
+
+    // ratios(a @f64, b @f64, c @f64) @f64: [ entry: p = a / b, q = c / b, s = p * a, t = q * c, r = s + t ] -> ...
+    il::Function function("ratios", { a, b, c }, DOUBLE);
+    auto* entry = function.entry();
+    auto* exit = function.exit();
+
+    entry->emplace_back<il::Binary>(p, a, il::Binary::Operator::Div, b, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(q, c, il::Binary::Operator::Div, b, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(s, p, il::Binary::Operator::Mul, a, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(t, q, il::Binary::Operator::Mul, c, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Binary>(r, s, il::Binary::Operator::Add, t, DOUBLE, std::nullopt);
+    entry->emplace_back<il::Goto>(exit->label(), std::nullopt);
+    entry->set_next(exit);
+    exit->emplace_back<il::Return>(r, std::nullopt);
+
+    const x86_64::Mapping mapping{
+        { a, x86_64::Register::Base::XMM0 },
+        { b, x86_64::Register::Base::XMM1 },
+        { c, x86_64::Register::Base::XMM2 },
+        { p, x86_64::Register::Base::XMM3 },
+        { q, x86_64::Register::Base::XMM4 },
+        { s, x86_64::Register::Base::XMM3 },
+        { t, x86_64::Register::Base::XMM4 },
+        { r, x86_64::Register::Base::XMM0 },
+    };
+
+    x86_64::Resolver resolver;
+    resolver.run(function, mapping);
+
+    const x86_64::InstructionSelector selector(function, resolver);
+    EXPECT_EQ(selector.vectorized(), 1);
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 0)));
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 1)));
+    EXPECT_TRUE(selector.is_folded(instruction_at(entry, 2)));
+    EXPECT_FALSE(selector.is_folded(instruction_at(entry, 4)));
+
+    // The whole chain is generated by the upper lane of its last step.
+    const auto* pattern = selector.packed(instruction_at(entry, 3));
+    ASSERT_NE(pattern, nullptr);
+    ASSERT_EQ(pattern->steps.size(), 2);
+    EXPECT_EQ(pattern->steps[0][0], &instruction_at(entry, 0));
+    EXPECT_EQ(pattern->steps[1][1], &instruction_at(entry, 3));
+    EXPECT_EQ(selector.packed(instruction_at(entry, 4)), nullptr);
+}
@@ -0,0 +1,35 @@
+#include "gtest/gtest.h"
+
+#include "arkoi_language/x86_64/target.hpp"
+
+using namespace arkoi::x86_64;
+
+TEST(Target, DefaultsToBaseline) {
+    EXPECT_EQ(Target::parse("x86-64"), Target{ });
+    EXPECT_EQ(Target::parse("x86-64").describe(), "");
+}
+
+TEST(Target, EnablesExtensionsOfProcessor) {
+    const auto target = Target::parse("x86-64-v3");
+    EXPECT_TRUE(target.avx);
+    EXPECT_TRUE(target.fma);
+    EXPECT_TRUE(target.bmi2);
+    EXPECT_EQ(Target::parse("haswell"), target);
+}
+
+TEST(Target, AppliesAttributesInOrder) {
+    const auto target = Target::parse("x86-64", "+avx, +fma,+bmi2,-fma");
+    EXPECT_TRUE(target.avx);
+    EXPECT_FALSE(target.fma);
+    EXPECT_TRUE(target.bmi2);
+    EXPECT_EQ(target.describe(), "+avx,+bmi2");
+
+    // The description is a valid list of attributes itself.
+    EXPECT_EQ(Target::parse("x86-64", target.describe()), target);
+}
+
+TEST(Target, RejectsUnknownNames) {
+    EXPECT_THROW(static_cast<void>(Target::parse("pentium")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(Target::parse("x86-64", "+sse5")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(Target::parse("x86-64", "avx")), std::invalid_argument);
+}